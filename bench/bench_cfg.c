@@ -0,0 +1,219 @@
+/**
+ * @file bench_cfg.c
+ * @brief Benchmarks for the control flow graph analyses.
+ * 
+ * This file times dominators and the loop-nest forest on deeply nested
+ * loops, the same plus dominance frontiers on a large branching graph, and
+ * incremental edge updates against full recomputation.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/cfg.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief Default number of blocks in each benchmark graph.
+ */
+#define BENCH_DEFAULT_BLOCKS 1000000
+
+/**
+ * @brief Number of edge removals and insertions timed on the large graph.
+ */
+#define BENCH_UPDATES 200
+
+/**
+ * @brief Get the current time.
+ * 
+ * @return The time in milliseconds.
+ */
+static double now_ms(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+}
+
+/**
+ * @brief Get the next pseudo-random number.
+ * 
+ * @param seed The generator state.
+ * @return A 31-bit pseudo-random number.
+ */
+static size_t next_random(uint64_t* seed) {
+  *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (size_t)(*seed >> 33);
+}
+
+/**
+ * @brief Build loops nested as deep as the block count allows.
+ * 
+ * Header i falls into header i + 1; the innermost header falls into its
+ * latch, and latch i branches back to header i or out to latch i - 1.
+ * 
+ * @param blocks The block budget.
+ * @param depth Where to store the nesting depth.
+ * @return The graph, or NULL if memory allocation failed.
+ */
+static cfg_t* build_nested_loops(size_t blocks, size_t* depth) {
+  size_t d = (blocks - 1) / 2;
+  cfg_t* cfg = cfg_create(2 * d + 1);
+  bool success = cfg != NULL;
+  
+  for (size_t i = 0; i < d && success; i++) {
+    size_t header = i;
+    size_t latch = 2 * d - 1 - i;
+    success = cfg_insert_edge(cfg, header, header + 1) &&
+              cfg_insert_edge(cfg, latch, header) &&
+              cfg_insert_edge(cfg, latch, latch + 1);
+  }
+  
+  if (!success) {
+    cfg_destroy(cfg);
+    return NULL;
+  }
+  *depth = d;
+  return cfg;
+}
+
+/**
+ * @brief Build a large graph of forward branches with some loops.
+ * 
+ * Each block falls through to the next and one in four also branches to a
+ * nearby block, one in eight of those backwards.
+ * 
+ * @param blocks The number of blocks.
+ * @param seed The generator state.
+ * @return The graph, or NULL if memory allocation failed.
+ */
+static cfg_t* build_branching(size_t blocks, uint64_t* seed) {
+  cfg_t* cfg = cfg_create(blocks);
+  bool success = cfg != NULL;
+  
+  for (size_t i = 0; i + 1 < blocks && success; i++) {
+    success = cfg_insert_edge(cfg, i, i + 1);
+    size_t r = next_random(seed);
+    if (success && r % 4 == 0) {
+      size_t distance = 2 + (r >> 8) % 64;
+      size_t target = (r >> 4) % 8 == 0 ? (i >= distance ? i - distance : 0) :
+                      (i + distance < blocks ? i + distance : blocks - 1);
+      success = cfg_insert_edge(cfg, i, target);
+    }
+  }
+  
+  if (!success) {
+    cfg_destroy(cfg);
+    return NULL;
+  }
+  return cfg;
+}
+
+/**
+ * @brief Time the full analyses on a graph.
+ * 
+ * @param name The benchmark name.
+ * @param cfg The graph.
+ * @param with_frontiers Whether to compute dominance frontiers, which grow
+ *                       with the square of the nesting depth.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool bench_analyses(const char* name, cfg_t* cfg, bool with_frontiers) {
+  double start = now_ms();
+  bool success = cfg_compute_dominators(cfg);
+  double dominators = now_ms();
+  success = success && (!with_frontiers || cfg_compute_frontiers(cfg));
+  double frontiers = now_ms();
+  success = success && cfg_compute_loops(cfg);
+  double loops = now_ms();
+  
+  if (success) {
+    printf("%s: %zu blocks, %zu loops\n", name, cfg_block_count(cfg), cfg_loop_count(cfg));
+    printf("  dominators %.1f ms, loops %.1f ms", dominators - start, loops - frontiers);
+    if (with_frontiers) {
+      printf(", frontiers %.1f ms", frontiers - dominators);
+    }
+    printf("\n");
+  }
+  return success;
+}
+
+/**
+ * @brief Time incremental edge updates against a full recomputation.
+ * 
+ * Each step removes a branch edge and puts it back, so the graph ends
+ * where it started.
+ * 
+ * @param cfg The graph, with dominators computed.
+ * @param seed The generator state.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool bench_updates(cfg_t* cfg, uint64_t* seed) {
+  size_t count = cfg_block_count(cfg);
+  double start = now_ms();
+  bool success = cfg_compute_dominators(cfg);
+  double full = now_ms() - start;
+  
+  double removals = 0.0;
+  double insertions = 0.0;
+  size_t steps = 0;
+  while (steps < BENCH_UPDATES && success) {
+    size_t block = next_random(seed) % count;
+    if (cfg_successor_count(cfg, block) != 2) {
+      continue;
+    }
+    
+    size_t target = cfg_get_successor(cfg, block, 1);
+    start = now_ms();
+    success = cfg_remove_edge(cfg, block, target);
+    double removed = now_ms();
+    success = success && cfg_insert_edge(cfg, block, target);
+    removals += removed - start;
+    insertions += now_ms() - removed;
+    steps++;
+  }
+  
+  if (success) {
+    printf("updates: %zu of each, removal %.3f ms, insertion %.3f ms, full %.1f ms\n",
+           steps, removals / (double)steps, insertions / (double)steps, full);
+  }
+  return success;
+}
+
+/**
+ * @brief Run the benchmarks.
+ * 
+ * @param argc Argument count.
+ * @param argv Arguments; the optional first one is the block count.
+ * @return 0 on success, 1 on failure.
+ */
+int main(int argc, char** argv) {
+  size_t blocks = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : BENCH_DEFAULT_BLOCKS;
+  if (blocks < 3) {
+    fprintf(stderr, "Block count must be at least 3\n");
+    return 1;
+  }
+  
+  uint64_t seed = 42;
+  size_t depth = 0;
+  cfg_t* nested = build_nested_loops(blocks, &depth);
+  bool success = nested != NULL && bench_analyses("nested loops", nested, false);
+  if (success && cfg_loop_depth(nested, 0) != depth) {
+    fprintf(stderr, "Innermost loop has depth %zu, expected %zu\n",
+            cfg_loop_depth(nested, 0), depth);
+    success = false;
+  }
+  cfg_destroy(nested);
+  
+  cfg_t* branching = success ? build_branching(blocks, &seed) : NULL;
+  success = success && branching != NULL && bench_analyses("branching", branching, true) &&
+            bench_updates(branching, &seed);
+  cfg_destroy(branching);
+  
+  if (!success) {
+    fprintf(stderr, "Benchmark failed\n");
+    return 1;
+  }
+  return 0;
+}
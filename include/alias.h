@@ -0,0 +1,65 @@
+/**
+ * @file alias.h
+ * @brief Alias analysis for the memory accesses of HOIL functions.
+ * 
+ * This header defines the analysis that tells whether two loads or stores
+ * of a function may touch the same memory, from the pointer parameters
+ * their addresses derive from, the restrict and memory space qualifiers of
+ * the pointer types, and the scalar types accessed.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_ALIAS_H
+#define HOILC_ALIAS_H
+
+#include "ast.h"
+#include "symtable.h"
+#include <stdbool.h>
+
+/**
+ * @brief Alias analysis structure.
+ */
+typedef struct alias alias_t;
+
+/**
+ * @brief Analyze the pointers of a function.
+ * 
+ * Every local whose definitions are all LEA, ADD or SUB of one pointer
+ * parameter, or of a local derived from it, with integer offsets, points
+ * into the memory reached through that parameter. The analysis does not
+ * depend on statement positions, so it stays valid while statements move.
+ * 
+ * @param function The function AST node.
+ * @param globals The global symbol table, whose names are not locals.
+ * @return A new analysis or NULL if memory allocation failed.
+ */
+alias_t* alias_analyze(ast_node_t* function, symbol_table_t* globals);
+
+/**
+ * @brief Destroy an alias analysis.
+ * 
+ * @param alias The analysis to destroy.
+ */
+void alias_destroy(alias_t* alias);
+
+/**
+ * @brief Check whether two statements may access the same memory.
+ * 
+ * Only LOAD and STORE statements whose address is a local pointer are
+ * told apart; any other statement may access any memory. Two accesses do
+ * not alias when their pointers name different memory spaces, when they
+ * derive from different parameters of which one is restrict, or when they
+ * access different scalar types. Integers of the same width share a type
+ * whatever their signedness, and 8-bit integers and aggregates may alias
+ * any type.
+ * 
+ * @param alias The analysis.
+ * @param first The first statement.
+ * @param second The second statement.
+ * @return false if the statements never access the same memory.
+ */
+bool alias_may_alias(const alias_t* alias, ast_node_t* first, ast_node_t* second);
+
+#endif /* HOILC_ALIAS_H */
@@ -94,9 +94,11 @@ typedef struct {
  * @brief Target node structure.
  */
 typedef struct {
-  char* device_class;    /**< Device class. */
+  char* name;            /**< Target name. */
+  char* device_class;    /**< Device class (can be NULL). */
   ast_node_list_t required_features; /**< Required features. */
   ast_node_list_t preferred_features; /**< Preferred features. */
+  char* model;           /**< Machine model versions for the target are tuned for (can be NULL). */
 } ast_target_t;
 
 /**
@@ -133,7 +135,11 @@ typedef struct {
   ast_node_list_t parameters; /**< Function parameters. */
   ast_node_t* return_type; /**< Function return type. */
   ast_node_list_t blocks; /**< Function basic blocks. */
-  ast_node_t* target;    /**< Function target (can be NULL). */
+  ast_node_t* target;    /**< Target this version of the function is compiled for (can be NULL). */
+  ast_node_list_t versions; /**< Identifiers of the targets to compile extra versions for. */
+  char* alias;           /**< Function whose code this one shares (can be NULL). */
+  bool is_internal;      /**< Whether the function is only called from within the module. */
+  uint32_t attributes;   /**< Combination of function_attribute_t flags. */
 } ast_function_t;
 
 /**
@@ -144,6 +150,7 @@ typedef struct {
   ast_node_list_t parameters; /**< Function parameters. */
   ast_node_t* return_type; /**< Function return type. */
   bool is_variadic;      /**< Whether the function is variadic. */
+  uint32_t attributes;   /**< Combination of function_attribute_t flags. */
 } ast_extern_function_t;
 
 /**
@@ -167,6 +174,7 @@ typedef struct {
 typedef struct {
   ast_node_t* element_type; /**< Element type. */
   char* memory_space;    /**< Memory space (can be NULL). */
+  bool is_restrict;      /**< Whether the pointer is the only way to reach its memory. */
 } ast_type_ptr_t;
 
 /**
@@ -241,6 +249,8 @@ typedef struct {
 typedef struct {
   ast_node_t* object;    /**< Object expression. */
   char* field;           /**< Field name. */
+  uint32_t index;        /**< Field position, set by the type checker. */
+  bool is_address;       /**< Whether the object is a pointer and the access yields the field's address. */
 } ast_expr_field_t;
 
 /**
@@ -249,6 +259,7 @@ typedef struct {
 typedef struct {
   ast_node_t* array;     /**< Array expression. */
   ast_node_t* index;     /**< Index expression. */
+  bool is_address;       /**< Whether the array is a pointer and the access yields the element's address. */
 } ast_expr_index_t;
 
 /**
@@ -273,6 +284,7 @@ typedef struct {
 typedef struct {
   char* target;          /**< Assignment target. */
   ast_node_t* value;     /**< Assignment value. */
+  ast_node_t* target_type; /**< Target type set by the type checker (not owned). */
 } ast_stmt_assign_t;
 
 /**
@@ -281,6 +293,8 @@ typedef struct {
 typedef struct {
   char* opcode;          /**< Instruction opcode. */
   ast_node_list_t operands; /**< Instruction operands. */
+  uint8_t flags;         /**< COIL instruction flags: memory ordering, atomic operation or access hints. */
+  uint32_t alignment;    /**< Alignment asserted by an align= modifier, or 0. */
 } ast_stmt_instruction_t;
 
 /**
@@ -290,6 +304,8 @@ typedef struct {
   ast_node_t* condition; /**< Branch condition (can be NULL for unconditional branches). */
   char* true_target;     /**< Target block for true condition. */
   char* false_target;    /**< Target block for false condition (can be NULL). */
+  uint32_t true_weight;  /**< Relative likelihood of the true target, 0 without a hint. */
+  uint32_t false_weight; /**< Relative likelihood of the false target, 0 without a hint. */
 } ast_stmt_branch_t;
 
 /**
@@ -476,6 +492,16 @@ ast_node_t* ast_create_float(double value);
  */
 ast_node_t* ast_create_string(const char* value);
 
+/**
+ * @brief Create a deep copy of an AST node.
+ * 
+ * Resolved types referenced by assignments are shared, not copied.
+ * 
+ * @param node The node to copy.
+ * @return A new AST node or NULL if memory allocation failed.
+ */
+ast_node_t* ast_clone_node(const ast_node_t* node);
+
 /**
  * @brief Copy a source location to a node.
  * 
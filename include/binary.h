@@ -43,8 +43,8 @@ typedef enum {
   TYPE_BOOLEAN = 0x01, /**< Boolean type. */
   TYPE_INTEGER = 0x02, /**< Integer type. */
   TYPE_FLOAT = 0x03,   /**< Floating point type. */
-  TYPE_POINTER = 0x04, /**< Pointer type. */
-  TYPE_VECTOR = 0x05,  /**< Vector type. */
+  TYPE_POINTER = 0x04, /**< Pointer type; attributes are the memory space plus one, 0 for a generic pointer. */
+  TYPE_VECTOR = 0x05,  /**< Vector type; width is the element width, attributes the element category and lane count. */
   TYPE_ARRAY = 0x06,   /**< Array type. */
   TYPE_STRUCTURE = 0x07, /**< Structure type. */
   TYPE_FUNCTION = 0x08, /**< Function type. */
@@ -83,6 +83,104 @@ typedef enum {
   ORDER_SEQ_CST,     /**< Sequentially consistent ordering. */
 } memory_order_t;
 
+/**
+ * @brief Operations of the ATOMIC_RMW instruction.
+ */
+typedef enum {
+  ATOMIC_RMW_ADD,    /**< Add the value. */
+  ATOMIC_RMW_AND,    /**< Bitwise and with the value. */
+  ATOMIC_RMW_OR,     /**< Bitwise or with the value. */
+  ATOMIC_RMW_XOR,    /**< Bitwise xor with the value. */
+  ATOMIC_RMW_XCHG,   /**< Replace with the value. */
+  ATOMIC_RMW_MIN,    /**< Keep the minimum. */
+  ATOMIC_RMW_MAX,    /**< Keep the maximum. */
+} atomic_rmw_op_t;
+
+/**
+ * @brief Layout of the flags byte of atomic instructions and fences.
+ * 
+ * The low bits hold the memory_order_t of the access and, for ATOMIC_RMW,
+ * the bits above them the atomic_rmw_op_t.
+ */
+#define INSTRUCTION_ORDER_MASK 0x07
+#define INSTRUCTION_RMW_SHIFT 3
+
+/**
+ * @brief Layout of the flags byte of LOAD, STORE and PREFETCH.
+ * 
+ * The low bits of LOAD and STORE hold the base-2 logarithm of the asserted
+ * alignment plus one, or zero for the natural alignment of the accessed
+ * type, and INSTRUCTION_NONTEMPORAL marks accesses that should bypass the
+ * cache. PREFETCH sets INSTRUCTION_PREFETCH_WRITE when the memory is about
+ * to be written rather than read.
+ */
+#define INSTRUCTION_ALIGN_MASK 0x0F
+#define INSTRUCTION_ALIGN_MAX 16384
+#define INSTRUCTION_NONTEMPORAL 0x10
+#define INSTRUCTION_PREFETCH_WRITE 0x01
+
+/**
+ * @brief Scale of the probability held in the flags byte of BR_COND.
+ * 
+ * Zero means the branch has no hint. Otherwise the flags are one plus the
+ * probability of taking the true target in units of 1/254, so 1 marks a
+ * branch that is almost never taken and 255 one that almost always is.
+ */
+#define BRANCH_PROBABILITY_SCALE 254
+
+/**
+ * @brief Function entry flags.
+ */
+typedef enum {
+  FUNCTION_FLAG_EXTERNAL = 0x01, /**< Defined outside the module. */
+  FUNCTION_FLAG_ALIAS = 0x02,    /**< Shares the code of another function, whose index follows. */
+  FUNCTION_FLAG_DISPATCH = 0x04, /**< Has no code; runs one of its versions, chosen at load time. */
+} function_flag_t;
+
+/**
+ * @brief Function attribute flags.
+ */
+typedef enum {
+  FUNCTION_ATTRIBUTE_HOT = 0x01,      /**< Frequently executed; its code is placed first. */
+  FUNCTION_ATTRIBUTE_COLD = 0x02,     /**< Rarely executed; its code is placed last. */
+  FUNCTION_ATTRIBUTE_INLINE = 0x04,   /**< Should always be inlined into its callers. */
+  FUNCTION_ATTRIBUTE_NOINLINE = 0x08, /**< Should never be inlined or cloned for its callers. */
+  FUNCTION_ATTRIBUTE_PURE = 0x10,     /**< Neither reads nor writes memory (readnone). */
+} function_attribute_t;
+
+/**
+ * @brief Metadata record tags.
+ * 
+ * Each metadata record starts with its tag, followed by the fields of the
+ * record as 32-bit integers. Strings are a 32-bit length followed by their
+ * bytes, and lists a 32-bit count followed by their elements.
+ * 
+ * A loader binds each dispatch function to the version whose target has
+ * all its required features and the most preferred features present, and
+ * to the baseline version when no target is supported.
+ */
+typedef enum {
+  METADATA_FUNCTION_EFFECTS = 0x01, /**< Function index, then its function_effect_t. */
+  METADATA_TARGET = 0x02,           /**< Target index, device class, required and preferred feature lists. */
+  METADATA_FUNCTION_VERSION = 0x03, /**< Dispatch function index, version index, target index or COIL_NO_TARGET. */
+  METADATA_FUNCTION_ATTRIBUTES = 0x04, /**< Function index, then its function_attribute_t flags. */
+} metadata_tag_t;
+
+/**
+ * @brief Target index of the baseline version of a dispatch function.
+ */
+#define COIL_NO_TARGET 0xFFFFFFFFu
+
+/**
+ * @brief Memory effects of a function, from the most to the least precise.
+ */
+typedef enum {
+  FUNCTION_EFFECT_READNONE,  /**< Does not access memory. */
+  FUNCTION_EFFECT_READONLY,  /**< May read memory but never writes it. */
+  FUNCTION_EFFECT_ARGMEM,    /**< Only accesses memory reached through its pointer arguments. */
+  FUNCTION_EFFECT_ANY,       /**< May read and write any memory. */
+} function_effect_t;
+
 /**
  * @brief COIL file header.
  */
@@ -111,6 +209,9 @@ typedef uint32_t type_encoding_t;
 
 /**
  * @brief Instruction format.
+ * 
+ * Branch operands are block indices within the function. A block that does
+ * not end with a terminator continues with the next block.
  */
 typedef struct {
   uint8_t opcode;          /**< Instruction opcode. */
@@ -185,6 +286,87 @@ int32_t coil_builder_add_function(coil_builder_t* builder, const char* name,
                                  int32_t return_type, int32_t* param_types, 
                                  uint32_t param_count, bool is_external);
 
+/**
+ * @brief Add a function that shares the code of another function.
+ * 
+ * The alias gets its own index and name but no code of its own; its
+ * signature is copied from the target.
+ * 
+ * @param builder The builder.
+ * @param name The alias name.
+ * @param target The index of the function whose code is shared.
+ * @return The function index or -1 on failure.
+ */
+int32_t coil_builder_add_function_alias(coil_builder_t* builder, const char* name, 
+                                        int32_t target);
+
+/**
+ * @brief Add a function whose versions are chosen at load time.
+ * 
+ * The dispatch function has no code of its own; calls to it run the
+ * version the loader binds it to, as recorded by
+ * coil_builder_add_function_version.
+ * 
+ * @param builder The builder.
+ * @param name The function name.
+ * @param return_type The return type index.
+ * @param param_types Array of parameter type indices.
+ * @param param_count Number of parameters.
+ * @return The function index or -1 on failure.
+ */
+int32_t coil_builder_add_function_dispatch(coil_builder_t* builder, const char* name, 
+                                           int32_t return_type, int32_t* param_types, 
+                                           uint32_t param_count);
+
+/**
+ * @brief Record a target in the metadata section.
+ * 
+ * @param builder The builder.
+ * @param device_class The device class (can be NULL for any device).
+ * @param required Features a device must have to run code for the target.
+ * @param required_count Number of required features.
+ * @param preferred Features that make code for the target faster.
+ * @param preferred_count Number of preferred features.
+ * @return The target index or -1 on failure.
+ */
+int32_t coil_builder_add_target(coil_builder_t* builder, const char* device_class,
+                                const char* const* required, uint32_t required_count,
+                                const char* const* preferred, uint32_t preferred_count);
+
+/**
+ * @brief Record a version of a dispatch function in the metadata section.
+ * 
+ * @param builder The builder.
+ * @param dispatch The index of the dispatch function.
+ * @param version The index of the function implementing the version.
+ * @param target The target index of the version, or -1 for the baseline.
+ * @return true on success, false on failure.
+ */
+bool coil_builder_add_function_version(coil_builder_t* builder, int32_t dispatch,
+                                       int32_t version, int32_t target);
+
+/**
+ * @brief Record the memory effects of a function in the metadata section.
+ * 
+ * @param builder The builder.
+ * @param function The function index.
+ * @param effect The memory effects of the function.
+ * @return true on success, false on failure.
+ */
+bool coil_builder_add_function_effects(coil_builder_t* builder, int32_t function,
+                                       function_effect_t effect);
+
+/**
+ * @brief Record the attributes of a function in the metadata section.
+ * 
+ * @param builder The builder.
+ * @param function The function index.
+ * @param attributes A combination of function_attribute_t flags.
+ * @return true on success, false on failure.
+ */
+bool coil_builder_add_function_attributes(coil_builder_t* builder, int32_t function,
+                                          uint32_t attributes);
+
 /**
  * @brief Add a global variable.
  * 
@@ -232,9 +414,27 @@ bool coil_builder_add_instruction(coil_builder_t* builder, uint8_t opcode,
                                   uint8_t flags, uint8_t destination, 
                                   uint8_t* operands, uint8_t operand_count);
 
+/**
+ * @brief Enable or disable the peephole rules on function code.
+ * 
+ * When enabled, each function's encoded instructions are rewritten by a
+ * table of peephole rules as its code is ended: instructions after a
+ * terminator are dropped, a conditional branch with equal targets becomes
+ * a branch, a branch to the next block is dropped in favor of falling
+ * through, and constants or addresses computed into registers that no
+ * instruction reads are removed. The rules are disabled by default.
+ * 
+ * @param builder The builder.
+ * @param enabled Whether the rules run.
+ * @return true on success, false if memory allocation failed.
+ */
+bool coil_builder_set_peephole(coil_builder_t* builder, bool enabled);
+
 /**
  * @brief End adding code to the current function.
  * 
+ * Runs the peephole rules over the function's blocks if they are enabled.
+ * 
  * @param builder The builder.
  * @return true on success, false on failure.
  */
@@ -270,6 +470,22 @@ type_encoding_t coil_create_type_encoding(type_category_t category, uint8_t widt
  */
 type_encoding_t coil_get_predefined_type(int type);
 
+/**
+ * @brief Look up a memory space by its HOIL name.
+ * 
+ * @param name The memory space name, such as "global" or "shared".
+ * @return The memory space, or -1 if the name is unknown.
+ */
+int32_t coil_lookup_memory_space(const char* name);
+
+/**
+ * @brief Look up a function attribute by its HOIL name.
+ * 
+ * @param name The attribute name, such as "hot" or "noinline".
+ * @return The function_attribute_t flag, or 0 if the name is unknown.
+ */
+uint32_t coil_lookup_function_attribute(const char* name);
+
 /**
  * @brief Predefined type constants.
  */
@@ -307,6 +523,11 @@ enum {
   OPCODE_MIN = 0x08,  /**< Minimum. */
   OPCODE_MAX = 0x09,  /**< Maximum. */
   OPCODE_FMA = 0x0A,  /**< Fused multiply-add. */
+  OPCODE_MULH = 0x0B,     /**< High half of the double-width product. */
+  OPCODE_ADD_WIDE = 0x0C, /**< Addition into twice the operand width. */
+  OPCODE_MUL_WIDE = 0x0D, /**< Multiplication into twice the operand width. */
+  OPCODE_ADD_SAT = 0x0E,  /**< Addition clamped to the range of the type. */
+  OPCODE_SUB_SAT = 0x0F,  /**< Subtraction clamped to the range of the type. */
   
   /* Logical instructions */
   OPCODE_AND = 0x10,  /**< Bitwise AND. */
@@ -315,6 +536,12 @@ enum {
   OPCODE_NOT = 0x13,  /**< Bitwise NOT. */
   OPCODE_SHL = 0x14,  /**< Shift left. */
   OPCODE_SHR = 0x15,  /**< Shift right. */
+  OPCODE_POPCNT = 0x16, /**< Number of set bits. */
+  OPCODE_CLZ = 0x17,    /**< Leading zero bits; the width for zero. */
+  OPCODE_CTZ = 0x18,    /**< Trailing zero bits; the width for zero. */
+  OPCODE_BSWAP = 0x19,  /**< Reverse the byte order. */
+  OPCODE_ROTL = 0x1A,   /**< Rotate left by an amount taken modulo the width. */
+  OPCODE_ROTR = 0x1B,   /**< Rotate right by an amount taken modulo the width. */
   
   /* Comparison instructions */
   OPCODE_CMP_EQ = 0x20, /**< Equal. */
@@ -329,6 +556,20 @@ enum {
   OPCODE_STORE = 0x31, /**< Store to memory. */
   OPCODE_LEA = 0x32,   /**< Load effective address. */
   OPCODE_FENCE = 0x33, /**< Memory fence. */
+  OPCODE_ATOMIC_LOAD = 0x34,  /**< Atomic load: pointer. */
+  OPCODE_ATOMIC_STORE = 0x35, /**< Atomic store: pointer, value. */
+  OPCODE_ATOMIC_RMW = 0x36,   /**< Atomic read-modify-write returning the old value: pointer, value. */
+  OPCODE_CMPXCHG = 0x37,      /**< Compare and exchange returning the old value: pointer, expected, desired. */
+  OPCODE_PREFETCH = 0x38,     /**< Prefetch hint: pointer, locality from 0 (none) to 3 (high). */
+  
+  /* Vector instructions; lane and mask operands are immediates */
+  OPCODE_SPLAT = 0x50,      /**< Broadcast a scalar: value, lane count. */
+  OPCODE_EXTRACT = 0x51,    /**< Read a lane: vector, lane. */
+  OPCODE_INSERT = 0x52,     /**< Replace a lane: vector, value, lane. */
+  OPCODE_SHUFFLE = 0x53,    /**< Permute two vectors: first, second, one mask lane per result lane. */
+  OPCODE_REDUCE_ADD = 0x54, /**< Sum of the lanes. */
+  OPCODE_REDUCE_MIN = 0x55, /**< Minimum of the lanes. */
+  OPCODE_REDUCE_MAX = 0x56, /**< Maximum of the lanes. */
   
   /* Control flow instructions */
   OPCODE_BR = 0x40,     /**< Branch. */
@@ -0,0 +1,223 @@
+/**
+ * @file callgraph.h
+ * @brief Call graph for HOIL modules.
+ * 
+ * This header defines the call graph built over the functions of a module,
+ * its strongly connected components in bottom-up and top-down order, and
+ * the waves of components that do not depend on each other, which
+ * interprocedural analyses may process concurrently.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_CALLGRAPH_H
+#define HOILC_CALLGRAPH_H
+
+#include "ast.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Call graph structure.
+ */
+typedef struct callgraph callgraph_t;
+
+/**
+ * @brief Build the call graph of a module.
+ * 
+ * Functions and external functions are numbered in declaration order, which
+ * is their COIL function index. A call is direct when its callee is the
+ * name of a function that no parameter or local of the caller hides; an
+ * alias calls the function whose code it shares.
+ * 
+ * @param module The module AST node.
+ * @return A new call graph or NULL if memory allocation failed.
+ */
+callgraph_t* callgraph_build(ast_node_t* module);
+
+/**
+ * @brief Destroy a call graph.
+ * 
+ * @param cg The call graph to destroy.
+ */
+void callgraph_destroy(callgraph_t* cg);
+
+/**
+ * @brief Get the number of functions.
+ * 
+ * @param cg The call graph.
+ * @return The number of functions and external functions.
+ */
+size_t callgraph_function_count(const callgraph_t* cg);
+
+/**
+ * @brief Get a function node.
+ * 
+ * @param cg The call graph.
+ * @param function The function number.
+ * @return The function or external function AST node.
+ */
+ast_node_t* callgraph_get_function(const callgraph_t* cg, size_t function);
+
+/**
+ * @brief Find a function by name.
+ * 
+ * @param cg The call graph.
+ * @param name The function name.
+ * @return The function number, or -1 if no function has the name.
+ */
+int32_t callgraph_find(const callgraph_t* cg, const char* name);
+
+/**
+ * @brief Get the number of distinct functions a function calls directly.
+ * 
+ * @param cg The call graph.
+ * @param function The function number.
+ * @return The number of callees.
+ */
+size_t callgraph_callee_count(const callgraph_t* cg, size_t function);
+
+/**
+ * @brief Get a function called directly by a function.
+ * 
+ * @param cg The call graph.
+ * @param function The function number.
+ * @param index The callee index.
+ * @return The callee function number.
+ */
+size_t callgraph_get_callee(const callgraph_t* cg, size_t function, size_t index);
+
+/**
+ * @brief Get the number of distinct functions calling a function directly.
+ * 
+ * @param cg The call graph.
+ * @param function The function number.
+ * @return The number of callers.
+ */
+size_t callgraph_caller_count(const callgraph_t* cg, size_t function);
+
+/**
+ * @brief Get a function calling a function directly.
+ * 
+ * @param cg The call graph.
+ * @param function The function number.
+ * @param index The caller index.
+ * @return The caller function number.
+ */
+size_t callgraph_get_caller(const callgraph_t* cg, size_t function, size_t index);
+
+/**
+ * @brief Check whether a function makes calls the graph cannot resolve.
+ * 
+ * @param cg The call graph.
+ * @param function The function number.
+ * @return true if some call goes through a value rather than a function name.
+ */
+bool callgraph_has_indirect_calls(const callgraph_t* cg, size_t function);
+
+/**
+ * @brief Check whether a function's name is used other than as a direct callee.
+ * 
+ * Such functions may be called through a pointer, or from an initializer
+ * evaluated outside any function, so the graph does not list all callers.
+ * 
+ * @param cg The call graph.
+ * @param function The function number.
+ * @return true if the function's address is taken.
+ */
+bool callgraph_address_taken(const callgraph_t* cg, size_t function);
+
+/**
+ * @brief Get the number of strongly connected components.
+ * 
+ * Components are numbered bottom-up: a component calls only components
+ * with smaller numbers besides itself. Visiting them from the highest
+ * number down is a top-down order.
+ * 
+ * @param cg The call graph.
+ * @return The number of components.
+ */
+size_t callgraph_scc_count(const callgraph_t* cg);
+
+/**
+ * @brief Get the component of a function.
+ * 
+ * @param cg The call graph.
+ * @param function The function number.
+ * @return The component number.
+ */
+size_t callgraph_function_scc(const callgraph_t* cg, size_t function);
+
+/**
+ * @brief Get the number of functions in a component.
+ * 
+ * @param cg The call graph.
+ * @param scc The component number.
+ * @return The number of functions.
+ */
+size_t callgraph_scc_size(const callgraph_t* cg, size_t scc);
+
+/**
+ * @brief Get a function of a component.
+ * 
+ * @param cg The call graph.
+ * @param scc The component number.
+ * @param index The index within the component.
+ * @return The function number.
+ */
+size_t callgraph_get_scc_function(const callgraph_t* cg, size_t scc, size_t index);
+
+/**
+ * @brief Check whether a component is recursive.
+ * 
+ * @param cg The call graph.
+ * @param scc The component number.
+ * @return true if the component has several functions or one calling itself.
+ */
+bool callgraph_scc_is_recursive(const callgraph_t* cg, size_t scc);
+
+/**
+ * @brief Get the number of waves.
+ * 
+ * Wave 0 holds the components that call no other component, and each
+ * further wave the components whose callees are all in earlier waves. No
+ * two components of a wave depend on each other, so the components of a
+ * wave may be processed concurrently once the earlier waves are done, or
+ * the later ones for a top-down traversal.
+ * 
+ * @param cg The call graph.
+ * @return The number of waves.
+ */
+size_t callgraph_wave_count(const callgraph_t* cg);
+
+/**
+ * @brief Get the number of components in a wave.
+ * 
+ * @param cg The call graph.
+ * @param wave The wave number.
+ * @return The number of components.
+ */
+size_t callgraph_wave_size(const callgraph_t* cg, size_t wave);
+
+/**
+ * @brief Get a component of a wave.
+ * 
+ * @param cg The call graph.
+ * @param wave The wave number.
+ * @param index The index within the wave.
+ * @return The component number.
+ */
+size_t callgraph_get_wave_scc(const callgraph_t* cg, size_t wave, size_t index);
+
+/**
+ * @brief Get the wave of a component.
+ * 
+ * @param cg The call graph.
+ * @param scc The component number.
+ * @return The wave number.
+ */
+size_t callgraph_scc_wave(const callgraph_t* cg, size_t scc);
+
+#endif /* HOILC_CALLGRAPH_H */
@@ -0,0 +1,366 @@
+/**
+ * @file cfg.h
+ * @brief Control flow graph for HOIL functions.
+ * 
+ * This header defines the control flow graph built over the basic blocks of
+ * a function, together with live variable analysis, the dominator tree with
+ * incremental edge updates, dominance frontiers and the loop-nest forest.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_CFG_H
+#define HOILC_CFG_H
+
+#include "ast.h"
+#include "ir.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Control flow graph structure.
+ */
+typedef struct cfg cfg_t;
+
+/**
+ * @brief Build the control flow graph of a function.
+ * 
+ * Blocks are numbered in declaration order. A block without a terminator
+ * falls through to the next block.
+ * 
+ * @param function The function AST node.
+ * @return A new control flow graph or NULL if memory allocation failed.
+ */
+cfg_t* cfg_build(ast_node_t* function);
+
+/**
+ * @brief Create a control flow graph without a function.
+ * 
+ * The blocks have no statements and no edges; edges are added with
+ * cfg_insert_edge. Block nodes, labels and liveness are unavailable.
+ * 
+ * @param block_count The number of blocks.
+ * @return A new control flow graph or NULL if memory allocation failed.
+ */
+cfg_t* cfg_create(size_t block_count);
+
+/**
+ * @brief Destroy a control flow graph.
+ * 
+ * @param cfg The control flow graph to destroy.
+ */
+void cfg_destroy(cfg_t* cfg);
+
+/**
+ * @brief Get the number of blocks.
+ * 
+ * @param cfg The control flow graph.
+ * @return The number of blocks.
+ */
+size_t cfg_block_count(const cfg_t* cfg);
+
+/**
+ * @brief Get a block node.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @return The block AST node.
+ */
+ast_node_t* cfg_get_block(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Find a block by label.
+ * 
+ * @param cfg The control flow graph.
+ * @param label The block label.
+ * @return The block number, or -1 if no block has the label.
+ */
+int32_t cfg_find_block(const cfg_t* cfg, const char* label);
+
+/**
+ * @brief Get the number of statements of a block that execute.
+ * 
+ * Statements after the first terminator are unreachable and not counted.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @return The number of statements up to and including the terminator.
+ */
+size_t cfg_statement_count(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Get the number of successors of a block.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @return The number of successors.
+ */
+size_t cfg_successor_count(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Get a successor of a block.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @param index The successor index.
+ * @return The successor block number.
+ */
+size_t cfg_get_successor(const cfg_t* cfg, size_t block, size_t index);
+
+/**
+ * @brief Get the number of predecessors of a block.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @return The number of predecessors.
+ */
+size_t cfg_predecessor_count(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Get a predecessor of a block.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @param index The predecessor index.
+ * @return The predecessor block number.
+ */
+size_t cfg_get_predecessor(const cfg_t* cfg, size_t block, size_t index);
+
+/**
+ * @brief Compute the variables live on entry to and exit from each block.
+ * 
+ * Every variable defined or used in the function is interned in the table,
+ * and the live sets are indexed by variable number.
+ * 
+ * @param cfg The control flow graph.
+ * @param vars The variable numbering table.
+ * @return true on success, false if memory allocation failed.
+ */
+bool cfg_compute_liveness(cfg_t* cfg, ir_var_table_t* vars);
+
+/**
+ * @brief Get the variables live on entry to a block.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_liveness.
+ * @param block The block number.
+ * @return The live set.
+ */
+const ir_bitset_t* cfg_live_in(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Get the variables live on exit from a block.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_liveness.
+ * @param block The block number.
+ * @return The live set.
+ */
+const ir_bitset_t* cfg_live_out(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Compute the immediate dominator of each block.
+ * 
+ * The entry block dominates every reachable block; blocks unreachable from
+ * it have no dominator and dominate nothing. The tree is built with the
+ * Semi-NCA algorithm in near-linear time and without recursion.
+ * 
+ * @param cfg The control flow graph.
+ * @return true on success, false if memory allocation failed.
+ */
+bool cfg_compute_dominators(cfg_t* cfg);
+
+/**
+ * @brief Check whether a block is reachable from the entry block.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @param block The block number.
+ * @return true if the block is reachable, false otherwise.
+ */
+bool cfg_is_reachable(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Get the immediate dominator of a block.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @param block The block number.
+ * @return The immediate dominator, or -1 for the entry block and unreachable blocks.
+ */
+int32_t cfg_immediate_dominator(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Check whether a block dominates another.
+ * 
+ * Every reachable block dominates itself.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @param a The dominating block.
+ * @param b The dominated block.
+ * @return true if every path from the entry block to b passes through a.
+ */
+bool cfg_dominates(const cfg_t* cfg, size_t a, size_t b);
+
+/**
+ * @brief Get the depth of a block in the dominator tree.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @param block The block number, which must be reachable.
+ * @return The number of strict dominators of the block.
+ */
+size_t cfg_dominator_depth(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Get the first block immediately dominated by a block.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @param block The block number.
+ * @return The first child in the dominator tree, or -1 if there is none.
+ */
+int32_t cfg_dominator_child(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Get the next block with the same immediate dominator.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @param block The block number.
+ * @return The next sibling in the dominator tree, or -1 if there is none.
+ */
+int32_t cfg_dominator_sibling(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Find the nearest block that dominates two blocks.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @param a The first block, which must be reachable.
+ * @param b The second block, which must be reachable.
+ * @return The nearest common dominator.
+ */
+size_t cfg_common_dominator(const cfg_t* cfg, size_t a, size_t b);
+
+/**
+ * @brief Add an edge to the graph.
+ * 
+ * The caller changes the branch that the edge stands for. When dominators
+ * have been computed the tree is updated in place; only edges that make new
+ * blocks reachable recompute it. Frontiers and loops must be recomputed.
+ * 
+ * @param cfg The control flow graph.
+ * @param from The source block, which has fewer than two successors.
+ * @param to The target block, which is not already a successor.
+ * @return true on success, false if memory allocation failed.
+ */
+bool cfg_insert_edge(cfg_t* cfg, size_t from, size_t to);
+
+/**
+ * @brief Remove an edge from the graph.
+ * 
+ * The caller changes the branch that the edge stands for. When dominators
+ * have been computed only the subtree below the nearest common dominator of
+ * the edge is rebuilt; removals that leave blocks unreachable recompute the
+ * tree. Frontiers and loops must be recomputed.
+ * 
+ * @param cfg The control flow graph.
+ * @param from The source block.
+ * @param to The target block, which must be a successor.
+ * @return true on success, false if memory allocation failed.
+ */
+bool cfg_remove_edge(cfg_t* cfg, size_t from, size_t to);
+
+/**
+ * @brief Compute the dominance frontier of each block.
+ * 
+ * The frontier of a block holds the blocks where its dominance ends: those
+ * with a predecessor it dominates that it does not strictly dominate.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @return true on success, false if memory allocation failed.
+ */
+bool cfg_compute_frontiers(cfg_t* cfg);
+
+/**
+ * @brief Get the number of blocks in the dominance frontier of a block.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_frontiers.
+ * @param block The block number.
+ * @return The frontier size.
+ */
+size_t cfg_frontier_count(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Get a block in the dominance frontier of a block.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_frontiers.
+ * @param block The block number.
+ * @param index The frontier index.
+ * @return The frontier block number.
+ */
+size_t cfg_get_frontier(const cfg_t* cfg, size_t block, size_t index);
+
+/**
+ * @brief Compute the loop-nest forest.
+ * 
+ * Each block that dominates one of its predecessors heads a natural loop
+ * made of the blocks that reach those back edges without passing through
+ * it. Loops are numbered innermost first, so a loop's number is smaller
+ * than its parent's. Irreducible cycles have no header and form no loop.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @return true on success, false if memory allocation failed.
+ */
+bool cfg_compute_loops(cfg_t* cfg);
+
+/**
+ * @brief Get the number of loops.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_loops.
+ * @return The number of loops.
+ */
+size_t cfg_loop_count(const cfg_t* cfg);
+
+/**
+ * @brief Get the header of a loop.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_loops.
+ * @param loop The loop number.
+ * @return The header block number.
+ */
+size_t cfg_loop_header(const cfg_t* cfg, size_t loop);
+
+/**
+ * @brief Get the loop that immediately encloses a loop.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_loops.
+ * @param loop The loop number.
+ * @return The parent loop number, or -1 for an outermost loop.
+ */
+int32_t cfg_loop_parent(const cfg_t* cfg, size_t loop);
+
+/**
+ * @brief Get the nesting depth of a loop.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_loops.
+ * @param loop The loop number.
+ * @return 1 for an outermost loop, one more for each enclosing loop.
+ */
+size_t cfg_loop_depth(const cfg_t* cfg, size_t loop);
+
+/**
+ * @brief Get the innermost loop containing a block.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_loops.
+ * @param block The block number.
+ * @return The loop number, or -1 if the block is in no loop.
+ */
+int32_t cfg_block_loop(const cfg_t* cfg, size_t block);
+
+/**
+ * @brief Check whether a loop contains a block, directly or in a nested loop.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_loops.
+ * @param loop The loop number.
+ * @param block The block number.
+ * @return true if the block is in the loop.
+ */
+bool cfg_loop_contains(const cfg_t* cfg, size_t loop, size_t block);
+
+#endif /* HOILC_CFG_H */
@@ -77,6 +77,17 @@ int32_t codegen_map_type(codegen_context_t* context, ast_node_t* type_node);
  */
 uint8_t codegen_map_instruction(codegen_context_t* context, const char* instruction);
 
+/**
+ * @brief Look up the COIL opcode for a HOIL instruction name.
+ * 
+ * Unlike codegen_map_instruction, this does not report unknown names, so it
+ * can be used by passes that run before code generation.
+ * 
+ * @param instruction The instruction name.
+ * @return The COIL opcode or 0 if the instruction is not recognized.
+ */
+uint8_t codegen_lookup_opcode(const char* instruction);
+
 /**
  * @brief Generate code for a constant value.
  * 
@@ -0,0 +1,79 @@
+/**
+ * @file effects.h
+ * @brief Interprocedural memory effects analysis for HOIL modules.
+ * 
+ * This header defines the analysis that classifies each function of a
+ * module by the memory it may access, and the query that lets the
+ * intra-procedural passes treat calls to such functions as weaker barriers
+ * than arbitrary calls.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_EFFECTS_H
+#define HOILC_EFFECTS_H
+
+#include "ast.h"
+#include "binary.h"
+#include "callgraph.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Memory effects analysis structure.
+ */
+typedef struct effects effects_t;
+
+/**
+ * @brief Analyze the memory effects of the functions of a module.
+ * 
+ * Functions are visited bottom-up over the components of the call graph,
+ * so each call sees the effects of its callee; recursive components are
+ * iterated to a fixpoint. Functions with a body are classified by what the
+ * body does, whatever their attributes say. Functions without one access no
+ * memory if they have the pure attribute, which means readnone like GCC's
+ * const rather than readonly like GCC's pure; other external functions and
+ * calls the graph cannot resolve may access any memory. Accesses through a pointer parameter, or
+ * through a value computed from one by LEA, ADD or SUB, are argument
+ * memory; reading or assigning a global is not.
+ * 
+ * @param module The module AST node.
+ * @param cg The call graph of the module, which must outlive the analysis.
+ * @return A new analysis or NULL if memory allocation failed.
+ */
+effects_t* effects_analyze(ast_node_t* module, const callgraph_t* cg);
+
+/**
+ * @brief Destroy a memory effects analysis.
+ * 
+ * @param effects The analysis to destroy.
+ */
+void effects_destroy(effects_t* effects);
+
+/**
+ * @brief Get the memory effects of a function.
+ * 
+ * @param effects The analysis.
+ * @param function The function number in the call graph.
+ * @return The memory effects of the function.
+ */
+function_effect_t effects_get(const effects_t* effects, size_t function);
+
+/**
+ * @brief Get the property flags of a statement, refined by the effects of its callee.
+ * 
+ * Calls to functions that do not access memory lose their memory flags and
+ * calls to read-only functions lose the write flag; both keep
+ * IR_FLAG_CALL and gain IR_FLAG_MAY_TRAP, since the callee may still trap
+ * or not return. Other statements get their ir_get_flags value.
+ * 
+ * @param effects The analysis.
+ * @param function The function containing the statement.
+ * @param stmt The statement.
+ * @return A combination of ir_flag_t values.
+ */
+uint32_t effects_get_flags(effects_t* effects, ast_node_t* function, ast_node_t* stmt);
+
+#endif /* HOILC_EFFECTS_H */
@@ -0,0 +1,108 @@
+/**
+ * @file eval.h
+ * @brief Compile-time evaluator for HOIL.
+ * 
+ * This header defines a sandboxed interpreter that runs provably pure
+ * functions on constant arguments and evaluates constant initializers.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_EVAL_H
+#define HOILC_EVAL_H
+
+#include "ast.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Default number of statements one evaluation may execute.
+ */
+#define EVAL_DEFAULT_MAX_STEPS 100000
+
+/**
+ * @brief Default number of bytes of frames one evaluation may hold.
+ */
+#define EVAL_DEFAULT_MAX_MEMORY (1024 * 1024)
+
+/**
+ * @brief Evaluation result codes.
+ */
+typedef enum {
+  EVAL_OK = 0,               /**< The value was computed. */
+  EVAL_NOT_CONSTANT,         /**< The expression does not have a compile-time value. */
+  EVAL_TRAP,                 /**< Evaluation reached a trapping operation. */
+  EVAL_STEP_LIMIT,           /**< Evaluation exceeded the step limit. */
+  EVAL_MEMORY_LIMIT,         /**< Evaluation exceeded the memory limit. */
+  EVAL_NO_MEMORY             /**< The compiler ran out of memory. */
+} eval_status_t;
+
+/**
+ * @brief Evaluator context structure.
+ */
+typedef struct eval_context eval_context_t;
+
+/**
+ * @brief Create an evaluator for a module.
+ * 
+ * Finds the functions that are provably pure: they take and return integers,
+ * read only their locals, constants and literals, and call only other pure
+ * functions.
+ * 
+ * @param module The type-checked module AST node.
+ * @return A new evaluator or NULL if memory allocation failed.
+ */
+eval_context_t* eval_create_context(ast_node_t* module);
+
+/**
+ * @brief Destroy an evaluator and free all associated resources.
+ * 
+ * @param context The evaluator to destroy.
+ */
+void eval_destroy_context(eval_context_t* context);
+
+/**
+ * @brief Set the limits applied to each evaluation.
+ * 
+ * @param context The evaluator.
+ * @param max_steps The number of statements one evaluation may execute.
+ * @param max_memory The number of bytes of frames one evaluation may hold.
+ */
+void eval_set_limits(eval_context_t* context, size_t max_steps, size_t max_memory);
+
+/**
+ * @brief Check whether a function is provably pure.
+ * 
+ * @param context The evaluator.
+ * @param name The function name.
+ * @return true if calls to the function can be evaluated, false otherwise.
+ */
+bool eval_is_pure(const eval_context_t* context, const char* name);
+
+/**
+ * @brief Evaluate an expression outside any function.
+ * 
+ * Literals, integer constants and calls to pure functions whose arguments
+ * are themselves such expressions can be evaluated.
+ * 
+ * @param context The evaluator.
+ * @param expr The expression.
+ * @param result Where to store the value.
+ * @return EVAL_OK on success, or the reason the expression has no value.
+ */
+eval_status_t eval_expression(eval_context_t* context, const ast_node_t* expr,
+                              int64_t* result);
+
+/**
+ * @brief Evaluate the initializer of a constant declaration.
+ * 
+ * @param context The evaluator.
+ * @param name The constant name.
+ * @param result Where to store the value, wrapped to the constant's type.
+ * @return EVAL_OK on success, or the reason the constant has no value.
+ */
+eval_status_t eval_constant(eval_context_t* context, const char* name, int64_t* result);
+
+#endif /* HOILC_EVAL_H */
@@ -28,6 +28,50 @@ typedef enum {
   HOILC_ERROR_MEMORY     /**< Memory allocation error. */
 } hoilc_result_t;
 
+/**
+ * @brief Optimization level.
+ */
+typedef enum {
+  HOILC_OPT_NONE = 0,    /**< No optimization (-O0). */
+  HOILC_OPT_BASIC,       /**< Basic optimization (-O1). */
+  HOILC_OPT_FULL,        /**< Full optimization for speed (-O2). */
+  HOILC_OPT_SIZE,        /**< Optimization for code size (-Os). */
+  
+  HOILC_OPT_COUNT        /**< Number of optimization levels. */
+} hoilc_opt_level_t;
+
+/**
+ * @brief Kind of optimization remark.
+ */
+typedef enum {
+  HOILC_REMARK_PASSED = 0, /**< An optimization was applied (-Rpass). */
+  HOILC_REMARK_MISSED,     /**< An optimization was not applied, with the reason (-Rpass-missed). */
+  HOILC_REMARK_ANALYSIS,   /**< A fact found by an analysis (-Rpass-analysis). */
+  
+  HOILC_REMARK_COUNT       /**< Number of kinds of remarks. */
+} hoilc_remark_kind_t;
+
+/**
+ * @brief Default instruction limit of superlinear passes on one function.
+ */
+#define HOILC_DEFAULT_MAX_INSTRUCTIONS 100000
+
+/**
+ * @brief Default block limit of superlinear passes on one function.
+ */
+#define HOILC_DEFAULT_MAX_BLOCKS 20000
+
+/**
+ * @brief Per-function limits on the optimizer's superlinear passes.
+ * 
+ * A limit of zero disables that check.
+ */
+typedef struct {
+  size_t max_instructions;   /**< Most statements a function may have. */
+  size_t max_blocks;         /**< Most blocks a function may have. */
+  uint32_t max_milliseconds; /**< Most processor time spent optimizing one function. */
+} hoilc_budget_t;
+
 /**
  * @brief Compiler context structure.
  */
@@ -109,6 +153,56 @@ hoilc_result_t hoilc_get_error_location(hoilc_context_t* context, int* line, int
  */
 void hoilc_set_verbose(hoilc_context_t* context, bool verbose);
 
+/**
+ * @brief Set the optimization level.
+ * 
+ * @param context The compiler context.
+ * @param level The optimization level.
+ */
+void hoilc_set_optimization_level(hoilc_context_t* context, hoilc_opt_level_t level);
+
+/**
+ * @brief Set the limits on the optimizer's superlinear passes.
+ * 
+ * Functions above a limit are left to the linear passes, and each pass
+ * skipped or degraded this way is reported as a note.
+ * 
+ * @param context The compiler context.
+ * @param budget The limits.
+ */
+void hoilc_set_optimization_budget(hoilc_context_t* context, const hoilc_budget_t* budget);
+
+/**
+ * @brief Print the remarks of a kind from the passes matching a pattern.
+ * 
+ * Remarks are printed to stderr as diagnostics after optimization.
+ * 
+ * @param context The compiler context.
+ * @param kind The kind of remarks.
+ * @param pattern A POSIX extended regular expression matched against pass names.
+ * @return HOILC_SUCCESS on success, or an error code if the pattern is invalid.
+ */
+hoilc_result_t hoilc_set_remark_filter(hoilc_context_t* context, hoilc_remark_kind_t kind,
+                                       const char* pattern);
+
+/**
+ * @brief Save every optimization remark as JSON.
+ * 
+ * @param context The compiler context.
+ * @param filename The record file path, or NULL to disable the record.
+ * @return HOILC_SUCCESS on success, or an error code on failure.
+ */
+hoilc_result_t hoilc_set_optimization_record(hoilc_context_t* context, const char* filename);
+
+/**
+ * @brief Select the machine model used by target-aware optimizations.
+ * 
+ * @param context The compiler context.
+ * @param model The machine model name (e.g. "generic").
+ * @return HOILC_SUCCESS on success, HOILC_ERROR_SEMANTIC if the model is unknown.
+ */
+hoilc_result_t hoilc_set_machine_model(hoilc_context_t* context, const char* model);
+
 /**
  * @brief Get the HOILC library version.
  * 
@@ -0,0 +1,343 @@
+/**
+ * @file ir.h
+ * @brief Helpers for treating the AST as an optimizer IR.
+ * 
+ * This header defines instruction properties, def/use queries, constant
+ * folding, variable numbering, bit sets and canonical keys shared by the
+ * optimization passes.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_IR_H
+#define HOILC_IR_H
+
+#include "ast.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Instruction property flags.
+ */
+typedef enum {
+  IR_FLAG_NONE = 0x00,          /**< No properties. */
+  IR_FLAG_PURE = 0x01,          /**< No side effects; result depends only on operands. */
+  IR_FLAG_READS_MEMORY = 0x02,  /**< Reads memory. */
+  IR_FLAG_WRITES_MEMORY = 0x04, /**< Writes memory. */
+  IR_FLAG_CALL = 0x08,          /**< Calls another function. */
+  IR_FLAG_MAY_TRAP = 0x10,      /**< May trap for some operand values. */
+  IR_FLAG_COMMUTATIVE = 0x20,   /**< Operands may be swapped. */
+  IR_FLAG_TERMINATOR = 0x40,    /**< Ends a basic block. */
+} ir_flag_t;
+
+/**
+ * @brief Visitor called for each variable use of a statement.
+ * 
+ * @param use Slot holding the identifier expression; may be replaced.
+ * @param data User data.
+ */
+typedef void (*ir_use_visitor_t)(ast_node_t** use, void* data);
+
+/**
+ * @brief Variable numbering table.
+ */
+typedef struct ir_var_table ir_var_table_t;
+
+/**
+ * @brief Growable string holding the canonical form of a code fragment.
+ */
+typedef struct {
+  char* data;            /**< Characters, NUL terminated (NULL while empty). */
+  size_t length;         /**< String length. */
+  size_t capacity;       /**< Buffer capacity. */
+  bool failed;           /**< Whether memory allocation failed. */
+} ir_key_t;
+
+/**
+ * @brief Fixed-size bit set, typically indexed by variable number.
+ */
+typedef struct {
+  uint64_t* words;       /**< Bit storage. */
+  size_t size;           /**< Number of bits. */
+} ir_bitset_t;
+
+/**
+ * @brief Get the property flags of an opcode.
+ * 
+ * @param opcode The COIL opcode.
+ * @return A combination of ir_flag_t values.
+ */
+uint32_t ir_opcode_flags(uint8_t opcode);
+
+/**
+ * @brief Check whether an opcode is an integer comparison.
+ * 
+ * @param opcode The COIL opcode.
+ * @return true for CMP_EQ, CMP_NE, CMP_LT, CMP_LE, CMP_GT and CMP_GE.
+ */
+bool ir_is_comparison(uint8_t opcode);
+
+/**
+ * @brief Get the instruction node of a statement.
+ * 
+ * @param stmt An assignment or instruction statement.
+ * @return The instruction node, or NULL for other statements.
+ */
+ast_node_t* ir_get_instruction(ast_node_t* stmt);
+
+/**
+ * @brief Get the COIL opcode of a statement.
+ * 
+ * Branches map to BR or BR_COND and returns map to RET.
+ * 
+ * @param stmt The statement.
+ * @return The opcode, or 0 if the statement has no known opcode.
+ */
+uint8_t ir_get_opcode(ast_node_t* stmt);
+
+/**
+ * @brief Get the property flags of a statement.
+ * 
+ * @param stmt The statement.
+ * @return A combination of ir_flag_t values.
+ */
+uint32_t ir_get_flags(ast_node_t* stmt);
+
+/**
+ * @brief Get the variable defined by a statement.
+ * 
+ * @param stmt The statement.
+ * @return The defined variable name, or NULL if the statement defines none.
+ */
+const char* ir_get_def(const ast_node_t* stmt);
+
+/**
+ * @brief Visit every variable use of a statement.
+ * 
+ * Uses are identifier expressions, including those nested in calls, field
+ * accesses and index expressions.
+ * 
+ * @param stmt The statement.
+ * @param visitor The visitor function.
+ * @param data User data passed to the visitor.
+ */
+void ir_visit_uses(ast_node_t* stmt, ir_use_visitor_t visitor, void* data);
+
+/**
+ * @brief Get the width and signedness of an integer or boolean type.
+ * 
+ * @param type The type node (can be NULL).
+ * @param bits Where to store the number of bits.
+ * @param is_signed Where to store whether the type is signed.
+ * @return true for integer and boolean types, false otherwise.
+ */
+bool ir_integer_type(const ast_node_t* type, uint8_t* bits, bool* is_signed);
+
+/**
+ * @brief Convert a value to an integer or boolean type.
+ * 
+ * @param type The type node (can be NULL).
+ * @param value The value.
+ * @param result Where to store the value wrapped to the width of the type.
+ * @return true on success, false if the type is not an integer or boolean type.
+ */
+bool ir_convert_integer(const ast_node_t* type, int64_t value, int64_t* result);
+
+/**
+ * @brief Convert a value to an integer or boolean type for use as a literal.
+ * 
+ * Literals hold signed 64-bit values, so unsigned 64-bit values above
+ * INT64_MAX cannot be written as one.
+ * 
+ * @param type The type node (can be NULL).
+ * @param value The value.
+ * @param result Where to store the converted value.
+ * @return true if a literal holds the converted value, false otherwise.
+ */
+bool ir_integer_literal(const ast_node_t* type, int64_t value, int64_t* result);
+
+/**
+ * @brief Evaluate a pure integer instruction on constant operands.
+ * 
+ * Arithmetic wraps to the width of the result type, and saturating
+ * arithmetic clamps to its range. Widening operations are evaluated in
+ * their result type, twice as wide as the operands. Bit counts, byte swaps
+ * and rotations see the operand as an unsigned value of that width, and
+ * rotations take their amount modulo the width. Comparisons produce 0 or 1
+ * and take the type of their operands instead of the result type; with a
+ * NULL type they compare the signed 64-bit values of literals.
+ * 
+ * @param opcode The COIL opcode.
+ * @param type The result type, or the operand type of a comparison.
+ * @param operands The operand values.
+ * @param count The number of operands.
+ * @param result Where to store the result.
+ * @return true if the instruction was evaluated, false for unsupported
+ *         opcodes or types and for operations that would trap.
+ */
+bool ir_fold_integer(uint8_t opcode, const ast_node_t* type, const int64_t* operands,
+                     size_t count, int64_t* result);
+
+/**
+ * @brief Create a variable numbering table.
+ * 
+ * @return A new table or NULL if memory allocation failed.
+ */
+ir_var_table_t* ir_var_table_create(void);
+
+/**
+ * @brief Destroy a variable numbering table.
+ * 
+ * @param table The table to destroy.
+ */
+void ir_var_table_destroy(ir_var_table_t* table);
+
+/**
+ * @brief Get the number of a variable, assigning a new one if needed.
+ * 
+ * @param table The table.
+ * @param name The variable name.
+ * @return The dense variable number, or -1 if memory allocation failed.
+ */
+int32_t ir_var_table_intern(ir_var_table_t* table, const char* name);
+
+/**
+ * @brief Get the number of a variable.
+ * 
+ * @param table The table.
+ * @param name The variable name.
+ * @return The variable number, or -1 if the variable is unknown.
+ */
+int32_t ir_var_table_find(const ir_var_table_t* table, const char* name);
+
+/**
+ * @brief Get the number of variables in a table.
+ * 
+ * @param table The table.
+ * @return The number of variables.
+ */
+size_t ir_var_table_count(const ir_var_table_t* table);
+
+/**
+ * @brief Get the name of a numbered variable.
+ * 
+ * @param table The table.
+ * @param id The variable number.
+ * @return The variable name.
+ */
+const char* ir_var_table_name(const ir_var_table_t* table, int32_t id);
+
+/**
+ * @brief Initialize an empty bit set.
+ * 
+ * @param set The bit set.
+ * @param size The number of bits.
+ * @return true on success, false if memory allocation failed.
+ */
+bool ir_bitset_init(ir_bitset_t* set, size_t size);
+
+/**
+ * @brief Release the storage of a bit set.
+ * 
+ * @param set The bit set.
+ */
+void ir_bitset_free(ir_bitset_t* set);
+
+/**
+ * @brief Set a bit.
+ * 
+ * @param set The bit set.
+ * @param bit The bit index.
+ */
+void ir_bitset_set(ir_bitset_t* set, size_t bit);
+
+/**
+ * @brief Clear a bit.
+ * 
+ * @param set The bit set.
+ * @param bit The bit index.
+ */
+void ir_bitset_clear(ir_bitset_t* set, size_t bit);
+
+/**
+ * @brief Test a bit.
+ * 
+ * @param set The bit set.
+ * @param bit The bit index.
+ * @return true if the bit is set, false otherwise.
+ */
+bool ir_bitset_test(const ir_bitset_t* set, size_t bit);
+
+/**
+ * @brief Copy a bit set into another of the same size.
+ * 
+ * @param dest The destination set.
+ * @param src The source set.
+ */
+void ir_bitset_copy(ir_bitset_t* dest, const ir_bitset_t* src);
+
+/**
+ * @brief Add the bits of a set to another of the same size.
+ * 
+ * @param dest The destination set.
+ * @param src The source set.
+ * @return true if the destination changed, false otherwise.
+ */
+bool ir_bitset_union(ir_bitset_t* dest, const ir_bitset_t* src);
+
+/**
+ * @brief Empty a key, keeping its buffer.
+ * 
+ * @param key The key.
+ */
+void ir_key_reset(ir_key_t* key);
+
+/**
+ * @brief Release the buffer of a key.
+ * 
+ * @param key The key.
+ */
+void ir_key_free(ir_key_t* key);
+
+/**
+ * @brief Append formatted text to a key.
+ * 
+ * On allocation failure the key is marked as failed and left unchanged.
+ * 
+ * @param key The key.
+ * @param format The printf-style format.
+ * @param ... Format arguments.
+ */
+void ir_key_append(ir_key_t* key, const char* format, ...);
+
+/**
+ * @brief Append the canonical form of a type to a key.
+ * 
+ * Structurally equal scalar, pointer, vector and array types produce equal
+ * text; other types are only equal to themselves.
+ * 
+ * @param key The key.
+ * @param type The type node (can be NULL).
+ */
+void ir_key_append_type(ir_key_t* key, const ast_node_t* type);
+
+/**
+ * @brief Hash a key (64-bit FNV-1a).
+ * 
+ * @param key The key.
+ * @return The hash value.
+ */
+uint64_t ir_key_hash(const ir_key_t* key);
+
+/**
+ * @brief Compare two keys.
+ * 
+ * @param a The first key.
+ * @param b The second key.
+ * @return true if the keys hold the same text, false otherwise.
+ */
+bool ir_key_equal(const ir_key_t* a, const ir_key_t* b);
+
+#endif /* HOILC_IR_H */
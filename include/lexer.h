@@ -38,6 +38,7 @@ typedef enum {
   TOKEN_EQUAL,        /**< Equal '='. */
   TOKEN_LESS,         /**< Less than '<'. */
   TOKEN_GREATER,      /**< Greater than '>'. */
+  TOKEN_BANG,         /**< Exclamation mark '!'. */
   
   /* Keywords */
   TOKEN_MODULE,       /**< 'MODULE' keyword. */
@@ -46,6 +47,7 @@ typedef enum {
   TOKEN_CONSTANT,     /**< 'CONSTANT' keyword. */
   TOKEN_GLOBAL,       /**< 'GLOBAL' keyword. */
   TOKEN_EXTERN,       /**< 'EXTERN' keyword. */
+  TOKEN_INTERNAL,     /**< 'INTERNAL' keyword. */
   TOKEN_FUNCTION,     /**< 'FUNCTION' keyword. */
   TOKEN_ENTRY,        /**< 'ENTRY' keyword. */
   
@@ -80,12 +82,23 @@ typedef enum {
   TOKEN_DIV,          /**< 'DIV' instruction. */
   TOKEN_REM,          /**< 'REM' instruction. */
   TOKEN_NEG,          /**< 'NEG' instruction. */
+  TOKEN_MULH,         /**< 'MULH' instruction. */
+  TOKEN_ADD_WIDE,     /**< 'ADD_WIDE' instruction. */
+  TOKEN_MUL_WIDE,     /**< 'MUL_WIDE' instruction. */
+  TOKEN_ADD_SAT,      /**< 'ADD_SAT' instruction. */
+  TOKEN_SUB_SAT,      /**< 'SUB_SAT' instruction. */
   TOKEN_AND,          /**< 'AND' instruction. */
   TOKEN_OR,           /**< 'OR' instruction. */
   TOKEN_XOR,          /**< 'XOR' instruction. */
   TOKEN_NOT,          /**< 'NOT' instruction. */
   TOKEN_SHL,          /**< 'SHL' instruction. */
   TOKEN_SHR,          /**< 'SHR' instruction. */
+  TOKEN_POPCNT,       /**< 'POPCNT' instruction. */
+  TOKEN_CLZ,          /**< 'CLZ' instruction. */
+  TOKEN_CTZ,          /**< 'CTZ' instruction. */
+  TOKEN_BSWAP,        /**< 'BSWAP' instruction. */
+  TOKEN_ROTL,         /**< 'ROTL' instruction. */
+  TOKEN_ROTR,         /**< 'ROTR' instruction. */
   TOKEN_CMP_EQ,       /**< 'CMP_EQ' instruction. */
   TOKEN_CMP_NE,       /**< 'CMP_NE' instruction. */
   TOKEN_CMP_LT,       /**< 'CMP_LT' instruction. */
@@ -95,6 +108,19 @@ typedef enum {
   TOKEN_LOAD,         /**< 'LOAD' instruction. */
   TOKEN_STORE,        /**< 'STORE' instruction. */
   TOKEN_LEA,          /**< 'LEA' instruction. */
+  TOKEN_SPLAT,        /**< 'SPLAT' instruction. */
+  TOKEN_EXTRACT,      /**< 'EXTRACT' instruction. */
+  TOKEN_INSERT,       /**< 'INSERT' instruction. */
+  TOKEN_SHUFFLE,      /**< 'SHUFFLE' instruction. */
+  TOKEN_REDUCE_ADD,   /**< 'REDUCE_ADD' instruction. */
+  TOKEN_REDUCE_MIN,   /**< 'REDUCE_MIN' instruction. */
+  TOKEN_REDUCE_MAX,   /**< 'REDUCE_MAX' instruction. */
+  TOKEN_ATOMIC_LOAD,  /**< 'ATOMIC_LOAD' instruction. */
+  TOKEN_ATOMIC_STORE, /**< 'ATOMIC_STORE' instruction. */
+  TOKEN_ATOMIC_RMW,   /**< 'ATOMIC_RMW' instruction. */
+  TOKEN_CMPXCHG,      /**< 'CMPXCHG' instruction. */
+  TOKEN_PREFETCH,     /**< 'PREFETCH' instruction. */
+  TOKEN_FENCE,        /**< 'FENCE' instruction. */
   TOKEN_BR,           /**< 'BR' instruction. */
   TOKEN_CALL,         /**< 'CALL' instruction. */
   TOKEN_RET,          /**< 'RET' instruction. */
@@ -0,0 +1,60 @@
+/**
+ * @file machine.h
+ * @brief Target machine models for optimization.
+ * 
+ * This header defines the machine models used by target-aware optimizations.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_MACHINE_H
+#define HOILC_MACHINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Per-opcode latency entry.
+ */
+typedef struct {
+  uint8_t opcode;          /**< COIL opcode. */
+  uint8_t latency;         /**< Cycles until the result is available. */
+} machine_latency_t;
+
+/**
+ * @brief Machine model description.
+ */
+typedef struct {
+  const char* name;                    /**< Model name. */
+  const machine_latency_t* latencies;  /**< Latency table, terminated by opcode 0. */
+  uint8_t default_latency;             /**< Latency of opcodes missing from the table. */
+  uint8_t issue_width;                 /**< Instructions issued per cycle. */
+  uint8_t register_count;              /**< Registers available before spilling. */
+} machine_model_t;
+
+/**
+ * @brief Find a machine model by name.
+ * 
+ * @param name The model name.
+ * @return The machine model, or NULL if no model has that name.
+ */
+const machine_model_t* machine_find_model(const char* name);
+
+/**
+ * @brief Get the default machine model.
+ * 
+ * @return The default machine model.
+ */
+const machine_model_t* machine_default_model(void);
+
+/**
+ * @brief Get the result latency of an opcode.
+ * 
+ * @param model The machine model.
+ * @param opcode The COIL opcode.
+ * @return The latency in cycles.
+ */
+uint32_t machine_latency(const machine_model_t* model, uint8_t opcode);
+
+#endif /* HOILC_MACHINE_H */
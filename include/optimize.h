@@ -0,0 +1,208 @@
+/**
+ * @file optimize.h
+ * @brief Optimization pass manager for HOIL.
+ * 
+ * This header defines the interface for running optimization passes over a
+ * type-checked AST before code generation.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_OPTIMIZE_H
+#define HOILC_OPTIMIZE_H
+
+#include "ast.h"
+#include "symtable.h"
+#include "error.h"
+#include "machine.h"
+#include "effects.h"
+#include "remark.h"
+#include "hoilc.h"
+#include <stdbool.h>
+
+/**
+ * @brief Optimizer context structure.
+ */
+typedef struct optimize_context optimize_context_t;
+
+/**
+ * @brief Create a new optimizer context.
+ * 
+ * @param error_ctx The error context.
+ * @param symbol_table The global symbol table produced by the type checker.
+ * @return A new optimizer context or NULL if memory allocation failed.
+ */
+optimize_context_t* optimize_create_context(error_context_t* error_ctx,
+                                           symbol_table_t* symbol_table);
+
+/**
+ * @brief Destroy an optimizer context and free all associated resources.
+ * 
+ * @param context The context to destroy.
+ */
+void optimize_destroy_context(optimize_context_t* context);
+
+/**
+ * @brief Set the optimization level.
+ * 
+ * @param context The optimizer context.
+ * @param level The optimization level.
+ */
+void optimize_set_level(optimize_context_t* context, hoilc_opt_level_t level);
+
+/**
+ * @brief Get the optimization level.
+ * 
+ * @param context The optimizer context.
+ * @return The optimization level.
+ */
+hoilc_opt_level_t optimize_get_level(const optimize_context_t* context);
+
+/**
+ * @brief Set the machine model used by target-aware passes.
+ * 
+ * @param context The optimizer context.
+ * @param model The machine model.
+ */
+void optimize_set_machine_model(optimize_context_t* context, const machine_model_t* model);
+
+/**
+ * @brief Get the machine model used by target-aware passes.
+ * 
+ * @param context The optimizer context.
+ * @return The machine model.
+ */
+const machine_model_t* optimize_get_machine_model(const optimize_context_t* context);
+
+/**
+ * @brief Get the error context.
+ * 
+ * @param context The optimizer context.
+ * @return The error context.
+ */
+error_context_t* optimize_get_error_context(optimize_context_t* context);
+
+/**
+ * @brief Get the global symbol table.
+ * 
+ * @param context The optimizer context.
+ * @return The global symbol table.
+ */
+symbol_table_t* optimize_get_symbol_table(optimize_context_t* context);
+
+/**
+ * @brief Set the limits on superlinear passes.
+ * 
+ * @param context The optimizer context.
+ * @param budget The limits.
+ */
+void optimize_set_budget(optimize_context_t* context, const hoilc_budget_t* budget);
+
+/**
+ * @brief Check whether the running pass should use its cheaper mode.
+ * 
+ * Superlinear passes that have a cheaper mode run in it, instead of being
+ * skipped, on functions over the budget.
+ * 
+ * @param context The optimizer context.
+ * @return true if the running pass is degraded.
+ */
+bool optimize_is_degraded(const optimize_context_t* context);
+
+/**
+ * @brief Check whether a superlinear module pass may process a function.
+ * 
+ * The pass manager applies the budget to function passes itself; module
+ * passes with superlinear work per function call this for each function
+ * and leave it alone when it returns false. The skip is logged.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true if the function is within the budget.
+ */
+bool optimize_within_budget(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Get the number of passes skipped or degraded for the budget.
+ * 
+ * @param context The optimizer context.
+ * @return The number of logged skips.
+ */
+size_t optimize_get_skip_count(const optimize_context_t* context);
+
+/**
+ * @brief Get a logged skip.
+ * 
+ * @param context The optimizer context.
+ * @param index The skip index.
+ * @return A message naming the pass, the function and the exceeded limit.
+ */
+const char* optimize_get_skip(const optimize_context_t* context, size_t index);
+
+/**
+ * @brief Set the log receiving optimization remarks.
+ * 
+ * Without a log, remarks are discarded.
+ * 
+ * @param context The optimizer context.
+ * @param log The remark log, or NULL.
+ */
+void optimize_set_remarks(optimize_context_t* context, remark_log_t* log);
+
+/**
+ * @brief Check whether optimization remarks are recorded.
+ * 
+ * Passes may use this to skip work done only to explain a remark.
+ * 
+ * @param context The optimizer context.
+ * @return true if a remark log is set.
+ */
+bool optimize_wants_remarks(const optimize_context_t* context);
+
+/**
+ * @brief Emit an optimization remark from the running pass.
+ * 
+ * A remark that cannot be recorded for lack of memory is dropped.
+ * 
+ * @param context The optimizer context.
+ * @param kind The kind of remark.
+ * @param function The function the remark concerns, or NULL for the module.
+ * @param node The node whose source location the remark carries, or NULL.
+ * @param name The identifier of the remark within the pass.
+ * @param format The message format.
+ * @param ... The format arguments.
+ */
+void optimize_remark(optimize_context_t* context, hoilc_remark_kind_t kind,
+                     const ast_node_t* function, const ast_node_t* node, const char* name,
+                     const char* format, ...);
+
+/**
+ * @brief Get the memory effects of the functions of the module being optimized.
+ * 
+ * The analysis is computed on first use and kept until a module pass
+ * returns or optimize_invalidate_effects is called. Function passes never
+ * add calls or memory accesses, so they leave it valid.
+ * 
+ * @param context The optimizer context.
+ * @return The analysis, or NULL if memory allocation failed.
+ */
+effects_t* optimize_get_effects(optimize_context_t* context);
+
+/**
+ * @brief Drop the memory effects analysis after the module changed.
+ * 
+ * @param context The optimizer context.
+ */
+void optimize_invalidate_effects(optimize_context_t* context);
+
+/**
+ * @brief Run the passes enabled at the current level over a module.
+ * 
+ * @param context The optimizer context.
+ * @param module The type-checked module AST node.
+ * @return true on success, false on failure.
+ */
+bool optimize_module(optimize_context_t* context, ast_node_t* module);
+
+#endif /* HOILC_OPTIMIZE_H */
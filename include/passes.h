@@ -0,0 +1,191 @@
+/**
+ * @file passes.h
+ * @brief Optimization passes for HOIL.
+ * 
+ * This header declares the entry points of the individual optimization
+ * passes run by the pass manager.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_PASSES_H
+#define HOILC_PASSES_H
+
+#include "optimize.h"
+#include <stdbool.h>
+
+/**
+ * @brief Reorder the instructions of each basic block to hide latencies.
+ * 
+ * Performs latency-aware list scheduling over the dependency graph of each
+ * block, keeping terminators in place and preserving memory ordering.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_schedule(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Move instruction sequences repeated across the module into functions.
+ * 
+ * Finds equal sequences by hashing a canonical form of each window, creates
+ * one function per profitable sequence and replaces each occurrence with a
+ * call when the byte-level cost model predicts a smaller module.
+ * 
+ * @param context The optimizer context.
+ * @param module The module AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_outline(optimize_context_t* context, ast_node_t* module);
+
+/**
+ * @brief Fold functions with identical bodies into aliases.
+ * 
+ * Hashes the signature and canonicalized body of each function, confirms
+ * equality and turns every later copy into an alias of the first one, so
+ * only one body is emitted.
+ * 
+ * @param context The optimizer context.
+ * @param module The module AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_icf(optimize_context_t* context, ast_node_t* module);
+
+/**
+ * @brief Replace calls to pure functions on constant arguments by their results.
+ * 
+ * Runs each such call in the sandboxed evaluator and, when it finishes
+ * within the step and memory limits, replaces it with the value. Constant
+ * initializers written as expressions are folded the same way.
+ * 
+ * @param context The optimizer context.
+ * @param module The module AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_evaluate(optimize_context_t* context, ast_node_t* module);
+
+/**
+ * @brief Clone functions for constant arguments shared by several calls.
+ * 
+ * Groups calls by callee and constant argument tuple, clones the callee for
+ * the most common tuples within a code growth budget, propagates the
+ * constants through each clone and redirects the calls to it.
+ * 
+ * @param context The optimizer context.
+ * @param module The module AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_specialize(optimize_context_t* context, ast_node_t* module);
+
+/**
+ * @brief Fold comparisons and branches decided by dominating conditions.
+ * 
+ * Walks the dominator tree collecting the comparisons that hold, from the
+ * branch conditions on dominating edges and from the intervals of defined
+ * values, folds the comparisons they decide and turns branches on them
+ * into unconditional branches.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_range(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Strength-reduce the induction variables of each loop.
+ * 
+ * Replaces multiples of basic induction variables with additive
+ * recurrences set up in the loop preheader, rewrites exit tests onto the
+ * reduced variables when no value can wrap, and removes the basic
+ * variables that are left dead.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_induction(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Remove redundant loads and dead stores within each basic block.
+ * 
+ * A load from a local address that was just loaded from or stored to
+ * becomes a move of the known value, and a store overwritten through the
+ * same address before any access that may read it is removed. Accesses the
+ * alias analysis tells apart do not disturb each other.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_memory(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Move pure instructions down the dominator tree towards their uses.
+ * 
+ * Each movable definition goes to the block dominating all of its uses, or
+ * to the dominator of that block with the lowest loop depth, so it is only
+ * evaluated on the paths that need it. Definitions never move into a loop.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_sink(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Move the blocks reached only through unlikely branches out of line.
+ * 
+ * Blocks that every path from the entry reaches through an edge its
+ * branch hint makes rarely taken move to the end of the function, in
+ * their original order. Fall-throughs the move breaks become branches.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_layout(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Replace bit manipulation idioms with their instructions.
+ * 
+ * An OR of a left and a right shift of the same unsigned local by
+ * constants adding up to its width becomes ROTL or ROTR; shifts left
+ * without readers are removed.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_idiom(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Split aggregate locals into one scalar local per element.
+ * 
+ * Structure and fixed-size array locals that are only loaded whole, read
+ * one element at a time at constant positions, and stored whole become
+ * element locals, and their loads and stores are narrowed to the elements
+ * used. Nested aggregates are split level by level.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_sroa(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Remove unused parameters and results and promote pointer arguments.
+ * 
+ * Rewrites the INTERNAL functions that are only called directly: parameters
+ * the body never reads and results no caller uses are dropped, and pointers
+ * to integers that are only loaded from are replaced by the loaded value,
+ * with every call site rewritten to match.
+ * 
+ * @param context The optimizer context.
+ * @param module The module AST node.
+ * @return true on success, false on failure.
+ */
+bool pass_arguments(optimize_context_t* context, ast_node_t* module);
+
+#endif /* HOILC_PASSES_H */
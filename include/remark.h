@@ -0,0 +1,124 @@
+/**
+ * @file remark.h
+ * @brief Optimization remarks for HOIL.
+ * 
+ * This header defines the log in which optimization passes record what they
+ * applied, what they missed and why, and what their analyses found, each
+ * at a HOIL source location, and its output as diagnostics or as a
+ * machine-readable JSON record.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#ifndef HOILC_REMARK_H
+#define HOILC_REMARK_H
+
+#include "ast.h"
+#include "hoilc.h"
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Remark log structure.
+ */
+typedef struct remark_log remark_log_t;
+
+/**
+ * @brief Optimization remark.
+ */
+typedef struct {
+  hoilc_remark_kind_t kind;    /**< Kind of remark. */
+  char* pass;                  /**< Name of the pass that emitted it. */
+  char* name;                  /**< Stable identifier of the remark within the pass. */
+  char* function;              /**< Function it concerns, or NULL for the module. */
+  char* filename;               /**< HOIL source file, or NULL. */
+  int line;                    /**< Source line (1-based), or 0 if unknown. */
+  int column;                  /**< Source column (1-based). */
+  char* message;               /**< Human-readable message. */
+} remark_t;
+
+/**
+ * @brief Create an empty remark log.
+ * 
+ * @return A new remark log or NULL if memory allocation failed.
+ */
+remark_log_t* remark_create_log(void);
+
+/**
+ * @brief Destroy a remark log.
+ * 
+ * @param log The log to destroy.
+ */
+void remark_destroy_log(remark_log_t* log);
+
+/**
+ * @brief Record a remark.
+ * 
+ * All strings are copied, so the AST may be released before the log is
+ * written.
+ * 
+ * @param log The remark log.
+ * @param kind The kind of remark.
+ * @param pass The name of the pass.
+ * @param name The identifier of the remark within the pass.
+ * @param function The function name, or NULL.
+ * @param location The source location, or NULL if unknown.
+ * @param message The message.
+ * @return true on success, false if memory allocation failed.
+ */
+bool remark_add(remark_log_t* log, hoilc_remark_kind_t kind, const char* pass,
+                const char* name, const char* function, const source_location_t* location,
+                const char* message);
+
+/**
+ * @brief Get the number of recorded remarks.
+ * 
+ * @param log The remark log.
+ * @return The number of remarks.
+ */
+size_t remark_count(const remark_log_t* log);
+
+/**
+ * @brief Get a recorded remark.
+ * 
+ * @param log The remark log.
+ * @param index The remark index, in emission order.
+ * @return The remark.
+ */
+const remark_t* remark_get(const remark_log_t* log, size_t index);
+
+/**
+ * @brief Get the name of a kind of remark.
+ * 
+ * @param kind The kind of remark.
+ * @return "passed", "missed" or "analysis".
+ */
+const char* remark_kind_name(hoilc_remark_kind_t kind);
+
+/**
+ * @brief Print a remark as a diagnostic.
+ * 
+ * The format is "file:line:column: remark: message [-Rpass=pass]", with
+ * the option naming the kind of remark.
+ * 
+ * @param remark The remark.
+ * @param file The stream to print to.
+ */
+void remark_print(const remark_t* remark, FILE* file);
+
+/**
+ * @brief Write all remarks as a JSON array.
+ * 
+ * Each element is an object with the members "kind", "pass", "name",
+ * "function" (null for module-level remarks), "location" (an object with
+ * "file", "line" and "column", or null) and "message".
+ * 
+ * @param log The remark log.
+ * @param file The stream to write to.
+ * @return true on success, false if writing failed.
+ */
+bool remark_write_json(const remark_log_t* log, FILE* file);
+
+#endif /* HOILC_REMARK_H */
@@ -0,0 +1,313 @@
+/**
+ * @file alias.c
+ * @brief Implementation of the alias analysis.
+ * 
+ * This file contains the propagation of pointer parameters to the locals
+ * derived from them and the alias query combining bases, restrict, memory
+ * spaces and accessed types.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/alias.h"
+#include "../include/binary.h"
+#include "../include/ir.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Base of a local with no definition seen yet.
+ */
+#define ALIAS_BASE_UNSET (-2)
+
+/**
+ * @brief Base of a local that may point anywhere.
+ */
+#define ALIAS_BASE_UNKNOWN (-1)
+
+/**
+ * @brief Alias analysis structure.
+ */
+struct alias {
+  ir_var_table_t* vars;      /**< Parameters and locals, parameters first. */
+  ast_node_t** types;        /**< Type of each variable, or NULL if unknown. */
+  int32_t* bases;            /**< Parameter each variable derives from, or a base constant. */
+};
+
+/**
+ * @brief Memory access described for an alias query.
+ */
+typedef struct {
+  int32_t base;              /**< Parameter the address derives from, or a base constant. */
+  const ast_node_t* pointer; /**< Pointer type of the address. */
+} alias_access_t;
+
+/**
+ * @brief Collect the parameters and locals of a function with their types.
+ * 
+ * @param alias The analysis.
+ * @param function The function AST node.
+ * @param globals The global symbol table.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool collect_vars(alias_t* alias, ast_node_t* function, symbol_table_t* globals) {
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (ir_var_table_intern(alias->vars, param->data.parameter.name) < 0) {
+      return false;
+    }
+  }
+  size_t param_count = ir_var_table_count(alias->vars);
+  
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      if (def != NULL && ir_var_table_find(alias->vars, def) < 0 &&
+          symtable_lookup(globals, def, false) == NULL &&
+          ir_var_table_intern(alias->vars, def) < 0) {
+        return false;
+      }
+    }
+  }
+  
+  size_t count = ir_var_table_count(alias->vars);
+  alias->types = (ast_node_t**)calloc(count + 1, sizeof(ast_node_t*));
+  alias->bases = (int32_t*)malloc((count + 1) * sizeof(int32_t));
+  if (alias->types == NULL || alias->bases == NULL) {
+    return false;
+  }
+  
+  for (size_t v = 0; v < count; v++) {
+    alias->bases[v] = v < param_count ? (int32_t)v : ALIAS_BASE_UNSET;
+  }
+  for (size_t i = 0; i < param_count; i++) {
+    alias->types[i] = function->data.function.parameters.nodes[i]->data.parameter.type;
+  }
+  
+  /* Locals take the type the type checker gave their first definition */
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      const char* def = ir_get_def(stmt);
+      int32_t id = def != NULL ? ir_var_table_find(alias->vars, def) : -1;
+      if (id >= (int32_t)param_count && alias->types[id] == NULL) {
+        alias->types[id] = stmt->data.stmt_assign.target_type;
+      }
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Get the variable number of an identifier expression.
+ * 
+ * @param alias The analysis.
+ * @param expr The expression.
+ * @return The variable number, or -1 if the expression is not a local.
+ */
+static int32_t local_id(const alias_t* alias, const ast_node_t* expr) {
+  if (expr->type != AST_EXPR_IDENTIFIER) {
+    return -1;
+  }
+  return ir_var_table_find(alias->vars, expr->data.expr_identifier.name);
+}
+
+/**
+ * @brief Get the base a definition gives its variable.
+ * 
+ * LEA, ADD and SUB keep the base of their first operand when every other
+ * operand is an integer literal or an integer local, so no second pointer
+ * can move the result into another object.
+ * 
+ * @param alias The analysis.
+ * @param stmt The defining statement.
+ * @return The base, ALIAS_BASE_UNSET if the operand has none yet.
+ */
+static int32_t definition_base(const alias_t* alias, ast_node_t* stmt) {
+  uint8_t opcode = ir_get_opcode(stmt);
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  if ((opcode != OPCODE_LEA && opcode != OPCODE_ADD && opcode != OPCODE_SUB) ||
+      instruction->data.stmt_instruction.operands.count == 0) {
+    return ALIAS_BASE_UNKNOWN;
+  }
+  
+  ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+  int32_t source = local_id(alias, operands->nodes[0]);
+  if (source < 0) {
+    return ALIAS_BASE_UNKNOWN;
+  }
+  
+  for (size_t i = 1; i < operands->count; i++) {
+    int32_t offset = local_id(alias, operands->nodes[i]);
+    bool integer = operands->nodes[i]->type == AST_EXPR_INTEGER ||
+                   (offset >= 0 && alias->types[offset] != NULL &&
+                    alias->types[offset]->type == AST_TYPE_INT);
+    if (!integer) {
+      return ALIAS_BASE_UNKNOWN;
+    }
+  }
+  
+  return alias->bases[source];
+}
+
+/**
+ * @brief Propagate the parameter bases to the locals until nothing changes.
+ * 
+ * @param alias The analysis.
+ * @param function The function AST node.
+ */
+static void propagate_bases(alias_t* alias, ast_node_t* function) {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+      ast_node_t* block = function->data.function.blocks.nodes[i];
+      for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+        ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+        const char* def = ir_get_def(stmt);
+        int32_t id = def != NULL ? ir_var_table_find(alias->vars, def) : -1;
+        if (id < 0 || alias->bases[id] == ALIAS_BASE_UNKNOWN) {
+          continue;
+        }
+        
+        int32_t base = definition_base(alias, stmt);
+        if (base == ALIAS_BASE_UNSET || base == alias->bases[id]) {
+          continue;
+        }
+        alias->bases[id] = alias->bases[id] == ALIAS_BASE_UNSET ? base : ALIAS_BASE_UNKNOWN;
+        changed = true;
+      }
+    }
+  }
+}
+
+alias_t* alias_analyze(ast_node_t* function, symbol_table_t* globals) {
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  assert(globals != NULL);
+  
+  alias_t* alias = (alias_t*)calloc(1, sizeof(alias_t));
+  if (alias == NULL) {
+    return NULL;
+  }
+  
+  alias->vars = ir_var_table_create();
+  if (alias->vars == NULL || !collect_vars(alias, function, globals)) {
+    alias_destroy(alias);
+    return NULL;
+  }
+  
+  propagate_bases(alias, function);
+  return alias;
+}
+
+void alias_destroy(alias_t* alias) {
+  if (alias == NULL) {
+    return;
+  }
+  
+  ir_var_table_destroy(alias->vars);
+  free(alias->types);
+  free(alias->bases);
+  free(alias);
+}
+
+/**
+ * @brief Describe the memory a statement accesses.
+ * 
+ * @param alias The analysis.
+ * @param stmt The statement.
+ * @param access Where to store the description.
+ * @return true for a LOAD or STORE through a local pointer, false otherwise.
+ */
+static bool describe_access(const alias_t* alias, ast_node_t* stmt, alias_access_t* access) {
+  uint8_t opcode = ir_get_opcode(stmt);
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  if ((opcode != OPCODE_LOAD && opcode != OPCODE_STORE) ||
+      instruction->data.stmt_instruction.operands.count == 0) {
+    return false;
+  }
+  
+  int32_t id = local_id(alias, instruction->data.stmt_instruction.operands.nodes[0]);
+  if (id < 0 || alias->types[id] == NULL || alias->types[id]->type != AST_TYPE_PTR) {
+    return false;
+  }
+  
+  access->base = alias->bases[id];
+  access->pointer = alias->types[id];
+  return true;
+}
+
+/**
+ * @brief Get the class of an accessed type for type-based disambiguation.
+ * 
+ * @param type The accessed type (can be NULL).
+ * @return A class shared only by types that may overlap, or -1 for types
+ *         that may overlap anything.
+ */
+static int32_t type_class(const ast_node_t* type) {
+  if (type == NULL) {
+    return -1;
+  }
+  
+  switch (type->type) {
+    case AST_TYPE_BOOL:
+      return 1;
+    
+    case AST_TYPE_PTR:
+      return 2;
+    
+    case AST_TYPE_INT:
+      /* Bytes may be used to copy or inspect any type */
+      return type->data.type_int.bits <= 8 ? -1 : 0x100 | type->data.type_int.bits;
+    
+    case AST_TYPE_FLOAT:
+      return 0x200 | type->data.type_float.bits;
+    
+    default:
+      return -1;
+  }
+}
+
+/**
+ * @brief Check whether a variable is a restrict-qualified pointer parameter.
+ * 
+ * @param alias The analysis.
+ * @param base The base of an access.
+ * @return true if the base is a restrict parameter.
+ */
+static bool is_restrict_base(const alias_t* alias, int32_t base) {
+  return base >= 0 && alias->types[base] != NULL && alias->types[base]->type == AST_TYPE_PTR &&
+         alias->types[base]->data.type_ptr.is_restrict;
+}
+
+bool alias_may_alias(const alias_t* alias, ast_node_t* first, ast_node_t* second) {
+  assert(alias != NULL);
+  assert(first != NULL && second != NULL);
+  
+  alias_access_t a;
+  alias_access_t b;
+  if (!describe_access(alias, first, &a) || !describe_access(alias, second, &b)) {
+    return true;
+  }
+  
+  const char* space_a = a.pointer->data.type_ptr.memory_space;
+  const char* space_b = b.pointer->data.type_ptr.memory_space;
+  if (space_a != NULL && space_b != NULL && strcmp(space_a, space_b) != 0) {
+    return false;
+  }
+  
+  if (a.base >= 0 && b.base >= 0 && a.base != b.base &&
+      (is_restrict_base(alias, a.base) || is_restrict_base(alias, b.base))) {
+    return false;
+  }
+  
+  int32_t class_a = type_class(a.pointer->data.type_ptr.element_type);
+  int32_t class_b = type_class(b.pointer->data.type_ptr.element_type);
+  return class_a < 0 || class_b < 0 || class_a == class_b;
+}
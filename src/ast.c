@@ -62,9 +62,11 @@ void ast_destroy_node(ast_node_t* node) {
       break;
       
     case AST_TARGET:
+      free(node->data.target.name);
       free(node->data.target.device_class);
       ast_destroy_node_list(&node->data.target.required_features);
       ast_destroy_node_list(&node->data.target.preferred_features);
+      free(node->data.target.model);
       break;
       
     case AST_TYPE_DEF:
@@ -94,6 +96,8 @@ void ast_destroy_node(ast_node_t* node) {
       if (node->data.function.target) {
         ast_destroy_node(node->data.function.target);
       }
+      ast_destroy_node_list(&node->data.function.versions);
+      free(node->data.function.alias);
       break;
       
     case AST_EXTERN_FUNCTION:
@@ -423,6 +427,254 @@ ast_node_t* ast_create_string(const char* value) {
   return node;
 }
 
+/**
+ * @brief Duplicate an optional string into a node field.
+ * 
+ * @param dest Pointer to the field to set.
+ * @param src The string to duplicate (can be NULL).
+ * @return true on success, false on allocation failure.
+ */
+static bool clone_string(char** dest, const char* src) {
+  *dest = safe_strdup(src);
+  return src == NULL || *dest != NULL;
+}
+
+/**
+ * @brief Copy an optional child node into a node field.
+ * 
+ * @param dest Pointer to the field to set.
+ * @param src The child to copy (can be NULL).
+ * @return true on success, false on allocation failure.
+ */
+static bool clone_child(ast_node_t** dest, const ast_node_t* src) {
+  *dest = src != NULL ? ast_clone_node(src) : NULL;
+  return src == NULL || *dest != NULL;
+}
+
+/**
+ * @brief Copy every node of a list into an empty list.
+ * 
+ * @param dest The list to fill.
+ * @param src The list to copy.
+ * @return true on success, false on allocation failure.
+ */
+static bool clone_list(ast_node_list_t* dest, const ast_node_list_t* src) {
+  for (size_t i = 0; i < src->count; i++) {
+    ast_node_t* copy = ast_clone_node(src->nodes[i]);
+    if (copy == NULL || !ast_add_node(dest, copy)) {
+      ast_destroy_node(copy);
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+ast_node_t* ast_clone_node(const ast_node_t* node) {
+  assert(node != NULL);
+  
+  ast_node_t* copy = ast_create_node(node->type);
+  if (copy == NULL) {
+    return NULL;
+  }
+  
+  copy->location = node->location;
+  
+  /* Copy the node data; a partially copied node is safe to destroy */
+  bool success = true;
+  switch (node->type) {
+    case AST_MODULE:
+      success = clone_string(&copy->data.module.name, node->data.module.name) &&
+                clone_list(&copy->data.module.declarations, &node->data.module.declarations);
+      break;
+      
+    case AST_TARGET:
+      success = clone_string(&copy->data.target.name, node->data.target.name) &&
+                clone_string(&copy->data.target.device_class, node->data.target.device_class) &&
+                clone_list(&copy->data.target.required_features, 
+                           &node->data.target.required_features) &&
+                clone_list(&copy->data.target.preferred_features, 
+                           &node->data.target.preferred_features) &&
+                clone_string(&copy->data.target.model, node->data.target.model);
+      break;
+      
+    case AST_TYPE_DEF:
+      success = clone_string(&copy->data.type_def.name, node->data.type_def.name) &&
+                clone_list(&copy->data.type_def.fields, &node->data.type_def.fields);
+      break;
+      
+    case AST_CONSTANT:
+      success = clone_string(&copy->data.constant.name, node->data.constant.name) &&
+                clone_child(&copy->data.constant.type, node->data.constant.type) &&
+                clone_child(&copy->data.constant.value, node->data.constant.value);
+      break;
+      
+    case AST_GLOBAL:
+      success = clone_string(&copy->data.global.name, node->data.global.name) &&
+                clone_child(&copy->data.global.type, node->data.global.type) &&
+                clone_child(&copy->data.global.initializer, node->data.global.initializer);
+      break;
+      
+    case AST_FUNCTION:
+      copy->data.function.is_internal = node->data.function.is_internal;
+      copy->data.function.attributes = node->data.function.attributes;
+      success = clone_string(&copy->data.function.name, node->data.function.name) &&
+                clone_list(&copy->data.function.parameters, &node->data.function.parameters) &&
+                clone_child(&copy->data.function.return_type, node->data.function.return_type) &&
+                clone_list(&copy->data.function.blocks, &node->data.function.blocks) &&
+                clone_child(&copy->data.function.target, node->data.function.target) &&
+                clone_list(&copy->data.function.versions, &node->data.function.versions) &&
+                clone_string(&copy->data.function.alias, node->data.function.alias);
+      break;
+      
+    case AST_EXTERN_FUNCTION:
+      copy->data.extern_function.is_variadic = node->data.extern_function.is_variadic;
+      copy->data.extern_function.attributes = node->data.extern_function.attributes;
+      success = clone_string(&copy->data.extern_function.name, 
+                             node->data.extern_function.name) &&
+                clone_list(&copy->data.extern_function.parameters, 
+                           &node->data.extern_function.parameters) &&
+                clone_child(&copy->data.extern_function.return_type, 
+                            node->data.extern_function.return_type);
+      break;
+      
+    case AST_TYPE_VOID:
+    case AST_TYPE_BOOL:
+      break;
+      
+    case AST_TYPE_INT:
+      copy->data.type_int = node->data.type_int;
+      break;
+      
+    case AST_TYPE_FLOAT:
+      copy->data.type_float = node->data.type_float;
+      break;
+      
+    case AST_TYPE_PTR:
+      copy->data.type_ptr.is_restrict = node->data.type_ptr.is_restrict;
+      success = clone_child(&copy->data.type_ptr.element_type, 
+                            node->data.type_ptr.element_type) &&
+                clone_string(&copy->data.type_ptr.memory_space, 
+                             node->data.type_ptr.memory_space);
+      break;
+      
+    case AST_TYPE_VEC:
+      copy->data.type_vec.size = node->data.type_vec.size;
+      success = clone_child(&copy->data.type_vec.element_type, 
+                            node->data.type_vec.element_type);
+      break;
+      
+    case AST_TYPE_ARRAY:
+      copy->data.type_array.size = node->data.type_array.size;
+      success = clone_child(&copy->data.type_array.element_type, 
+                            node->data.type_array.element_type);
+      break;
+      
+    case AST_TYPE_STRUCT:
+      success = clone_list(&copy->data.type_struct.fields, &node->data.type_struct.fields);
+      break;
+      
+    case AST_TYPE_FUNCTION:
+      success = clone_list(&copy->data.type_function.parameter_types, 
+                           &node->data.type_function.parameter_types) &&
+                clone_child(&copy->data.type_function.return_type, 
+                            node->data.type_function.return_type);
+      break;
+      
+    case AST_TYPE_NAME:
+      success = clone_string(&copy->data.type_name.name, node->data.type_name.name);
+      break;
+      
+    case AST_EXPR_INTEGER:
+      copy->data.expr_integer = node->data.expr_integer;
+      break;
+      
+    case AST_EXPR_FLOAT:
+      copy->data.expr_float = node->data.expr_float;
+      break;
+      
+    case AST_EXPR_STRING:
+      success = clone_string(&copy->data.expr_string.value, node->data.expr_string.value);
+      break;
+      
+    case AST_EXPR_IDENTIFIER:
+      success = clone_string(&copy->data.expr_identifier.name, 
+                             node->data.expr_identifier.name);
+      break;
+      
+    case AST_EXPR_FIELD:
+      copy->data.expr_field.index = node->data.expr_field.index;
+      copy->data.expr_field.is_address = node->data.expr_field.is_address;
+      success = clone_child(&copy->data.expr_field.object, node->data.expr_field.object) &&
+                clone_string(&copy->data.expr_field.field, node->data.expr_field.field);
+      break;
+      
+    case AST_EXPR_INDEX:
+      copy->data.expr_index.is_address = node->data.expr_index.is_address;
+      success = clone_child(&copy->data.expr_index.array, node->data.expr_index.array) &&
+                clone_child(&copy->data.expr_index.index, node->data.expr_index.index);
+      break;
+      
+    case AST_EXPR_CALL:
+      success = clone_child(&copy->data.expr_call.function, node->data.expr_call.function) &&
+                clone_list(&copy->data.expr_call.arguments, &node->data.expr_call.arguments);
+      break;
+      
+    case AST_STMT_BLOCK:
+      success = clone_string(&copy->data.stmt_block.label, node->data.stmt_block.label) &&
+                clone_list(&copy->data.stmt_block.statements, 
+                           &node->data.stmt_block.statements);
+      break;
+      
+    case AST_STMT_ASSIGN:
+      copy->data.stmt_assign.target_type = node->data.stmt_assign.target_type;
+      success = clone_string(&copy->data.stmt_assign.target, node->data.stmt_assign.target) &&
+                clone_child(&copy->data.stmt_assign.value, node->data.stmt_assign.value);
+      break;
+      
+    case AST_STMT_INSTRUCTION:
+      copy->data.stmt_instruction.flags = node->data.stmt_instruction.flags;
+      copy->data.stmt_instruction.alignment = node->data.stmt_instruction.alignment;
+      success = clone_string(&copy->data.stmt_instruction.opcode, 
+                             node->data.stmt_instruction.opcode) &&
+                clone_list(&copy->data.stmt_instruction.operands, 
+                           &node->data.stmt_instruction.operands);
+      break;
+      
+    case AST_STMT_BRANCH:
+      copy->data.stmt_branch.true_weight = node->data.stmt_branch.true_weight;
+      copy->data.stmt_branch.false_weight = node->data.stmt_branch.false_weight;
+      success = clone_child(&copy->data.stmt_branch.condition, 
+                            node->data.stmt_branch.condition) &&
+                clone_string(&copy->data.stmt_branch.true_target, 
+                             node->data.stmt_branch.true_target) &&
+                clone_string(&copy->data.stmt_branch.false_target, 
+                             node->data.stmt_branch.false_target);
+      break;
+      
+    case AST_STMT_RETURN:
+      success = clone_child(&copy->data.stmt_return.value, node->data.stmt_return.value);
+      break;
+      
+    case AST_PARAMETER:
+      success = clone_string(&copy->data.parameter.name, node->data.parameter.name) &&
+                clone_child(&copy->data.parameter.type, node->data.parameter.type);
+      break;
+      
+    case AST_FIELD:
+      success = clone_string(&copy->data.field.name, node->data.field.name) &&
+                clone_child(&copy->data.field.type, node->data.field.type);
+      break;
+  }
+  
+  if (!success) {
+    ast_destroy_node(copy);
+    return NULL;
+  }
+  
+  return copy;
+}
+
 void ast_set_location(ast_node_t* node, int line, int column, const char* filename) {
   assert(node != NULL);
   
@@ -41,6 +41,7 @@ typedef struct {
   int32_t* param_types;    /**< Parameter type indices. */
   uint32_t param_count;    /**< Number of parameters. */
   bool is_external;        /**< Whether the function is external. */
+  int32_t alias;           /**< Function whose code is shared, or -1. */
 } function_entry_t;
 
 /**
@@ -74,6 +75,11 @@ typedef struct {
   int32_t current_block;   /**< Current block index. */
 } function_code_t;
 
+/**
+ * @brief Node of the decision tree compiled from the peephole rules.
+ */
+typedef struct peephole_node peephole_node_t;
+
 /**
  * @brief COIL binary builder structure.
  */
@@ -90,6 +96,11 @@ struct coil_builder {
   size_t global_capacity;              /**< Capacity of globals array. */
   function_code_t* current_function;   /**< Current function code. */
   char* module_name;                   /**< Module name. */
+  size_t target_count;                 /**< Number of targets recorded in the metadata. */
+  bool peephole;                       /**< Whether the peephole rules run on function code. */
+  peephole_node_t* peephole_nodes;     /**< Decision tree of the peephole rules; node 0 is the root. */
+  size_t peephole_node_count;          /**< Number of decision tree nodes. */
+  size_t peephole_node_capacity;       /**< Capacity of decision tree nodes array. */
 };
 
 /**
@@ -306,6 +317,520 @@ static int32_t find_block_by_name(function_code_t* function_code, const char* na
   return -1;
 }
 
+/**
+ * @brief Maximum number of decision tree paths one peephole pattern expands to.
+ */
+#define PEEPHOLE_MAX_PATHS 16
+
+/**
+ * @brief Opcodes the peephole patterns may name.
+ */
+static const struct {
+  const char* name;  /**< Opcode name. */
+  uint8_t opcode;    /**< Opcode value. */
+} peephole_opcodes[] = {
+  { "LOAD", OPCODE_LOAD },
+  { "LEA", OPCODE_LEA },
+  { "BR", OPCODE_BR },
+  { "BR_COND", OPCODE_BR_COND },
+  { "SWITCH", OPCODE_SWITCH },
+  { "RET", OPCODE_RET },
+};
+
+/**
+ * @brief Decoded instruction a peephole rule works on.
+ */
+typedef struct {
+  uint8_t opcode;           /**< Instruction opcode. */
+  uint8_t flags;            /**< Instruction flags. */
+  uint8_t operand_count;    /**< Number of operands. */
+  uint8_t destination;      /**< Destination register. */
+  const uint8_t* operands;  /**< Operands, within the block code. */
+} peephole_insn_t;
+
+/**
+ * @brief What a peephole rule knows about the function around its window.
+ */
+typedef struct {
+  size_t block;             /**< Index of the block being rewritten. */
+  bool read[256];           /**< Registers some operand of the function may read. */
+} peephole_scope_t;
+
+/**
+ * @brief Rewrite of a peephole rule.
+ * 
+ * Checks the constraints of the rule that the pattern cannot express and,
+ * if they hold, rewrites the window. Every rewrite shrinks the code, so
+ * applying rules until none matches terminates.
+ * 
+ * @param scope The function around the window.
+ * @param insns The instructions of the block.
+ * @param count Pointer to the number of instructions, updated by deletions.
+ * @param at The position of the window.
+ * @return true if the window was rewritten.
+ */
+typedef bool (*peephole_rewrite_t)(const peephole_scope_t* scope, peephole_insn_t* insns,
+                                   size_t* count, size_t at);
+
+/**
+ * @brief Peephole rule.
+ * 
+ * The pattern lists the instructions of the window separated by spaces.
+ * Each is an opcode name, several alternatives joined by '|', or '*' for
+ * any instruction; '$' requires the window to end the block.
+ */
+typedef struct {
+  const char* name;            /**< Rule name. */
+  const char* pattern;         /**< Instructions the window must match. */
+  peephole_rewrite_t rewrite;  /**< Constraints and rewrite of the window. */
+} peephole_rule_t;
+
+/**
+ * @brief Kind of a decision tree edge.
+ */
+typedef enum {
+  PEEPHOLE_EDGE_OPCODE,  /**< The next instruction has the edge's opcode. */
+  PEEPHOLE_EDGE_ANY,     /**< There is a next instruction. */
+  PEEPHOLE_EDGE_END,     /**< The block ends here. */
+} peephole_edge_kind_t;
+
+/**
+ * @brief Decision tree edge.
+ */
+typedef struct {
+  peephole_edge_kind_t kind;  /**< Edge kind. */
+  uint8_t opcode;             /**< Opcode of PEEPHOLE_EDGE_OPCODE edges. */
+  size_t child;               /**< Node the edge leads to. */
+} peephole_edge_t;
+
+/**
+ * @brief Decision tree node.
+ */
+struct peephole_node {
+  peephole_edge_t* edges;   /**< Edges to the child nodes. */
+  size_t edge_count;        /**< Number of edges. */
+  size_t edge_capacity;     /**< Capacity of edges array. */
+  uint32_t rules;           /**< Rules whose pattern is complete at this node, one bit each. */
+};
+
+/**
+ * @brief Remove an instruction from a block.
+ * 
+ * @param insns The instructions of the block.
+ * @param count Pointer to the number of instructions.
+ * @param index The instruction to remove.
+ */
+static void peephole_delete(peephole_insn_t* insns, size_t* count, size_t index) {
+  assert(index < *count);
+  
+  memmove(&insns[index], &insns[index + 1], (*count - index - 1) * sizeof(peephole_insn_t));
+  (*count)--;
+}
+
+/**
+ * @brief Drop an instruction that follows a terminator.
+ * 
+ * @param scope The function around the window.
+ * @param insns The instructions of the block.
+ * @param count Pointer to the number of instructions.
+ * @param at The position of the window.
+ * @return true if the window was rewritten.
+ */
+static bool rewrite_unreachable(const peephole_scope_t* scope, peephole_insn_t* insns,
+                                size_t* count, size_t at) {
+  (void)scope;
+  peephole_delete(insns, count, at + 1);
+  return true;
+}
+
+/**
+ * @brief Turn a conditional branch with equal targets into a branch.
+ * 
+ * @param scope The function around the window.
+ * @param insns The instructions of the block.
+ * @param count Pointer to the number of instructions.
+ * @param at The position of the window.
+ * @return true if the window was rewritten.
+ */
+static bool rewrite_same_target(const peephole_scope_t* scope, peephole_insn_t* insns,
+                                size_t* count, size_t at) {
+  (void)scope;
+  (void)count;
+  peephole_insn_t* insn = &insns[at];
+  if (insn->operand_count != 3 || insn->operands[1] != insn->operands[2]) {
+    return false;
+  }
+  
+  insn->opcode = OPCODE_BR;
+  insn->flags = 0;
+  insn->operands++;
+  insn->operand_count = 1;
+  return true;
+}
+
+/**
+ * @brief Drop a branch to the next block, which the block falls through to.
+ * 
+ * @param scope The function around the window.
+ * @param insns The instructions of the block.
+ * @param count Pointer to the number of instructions.
+ * @param at The position of the window.
+ * @return true if the window was rewritten.
+ */
+static bool rewrite_next_block(const peephole_scope_t* scope, peephole_insn_t* insns,
+                               size_t* count, size_t at) {
+  if (insns[at].operand_count != 1 || (size_t)insns[at].operands[0] != scope->block + 1) {
+    return false;
+  }
+  
+  peephole_delete(insns, count, at);
+  return true;
+}
+
+/**
+ * @brief Drop a constant or address computed into a register nothing reads.
+ * 
+ * A LOAD without operands materializes a literal and LEA only computes an
+ * address, so neither accesses memory or traps.
+ * 
+ * @param scope The function around the window.
+ * @param insns The instructions of the block.
+ * @param count Pointer to the number of instructions.
+ * @param at The position of the window.
+ * @return true if the window was rewritten.
+ */
+static bool rewrite_dead_value(const peephole_scope_t* scope, peephole_insn_t* insns,
+                               size_t* count, size_t at) {
+  const peephole_insn_t* insn = &insns[at];
+  if ((insn->opcode == OPCODE_LOAD && insn->operand_count != 0) ||
+      insn->destination == 0xFF || scope->read[insn->destination]) {
+    return false;
+  }
+  
+  peephole_delete(insns, count, at);
+  return true;
+}
+
+/**
+ * @brief Peephole rules, tried in order at each position.
+ */
+static const peephole_rule_t peephole_rules[] = {
+  { "unreachable", "BR|BR_COND|SWITCH|RET *", rewrite_unreachable },
+  { "same-target", "BR_COND", rewrite_same_target },
+  { "next-block", "BR $", rewrite_next_block },
+  { "dead-value", "LOAD|LEA", rewrite_dead_value },
+};
+
+/**
+ * @brief Number of peephole rules.
+ */
+#define PEEPHOLE_RULE_COUNT (sizeof(peephole_rules) / sizeof(peephole_rules[0]))
+
+/**
+ * @brief Add a node to the peephole decision tree.
+ * 
+ * @param builder The builder.
+ * @return The node index, or -1 if memory allocation failed.
+ */
+static int32_t peephole_add_node(coil_builder_t* builder) {
+  if (builder->peephole_node_count >= builder->peephole_node_capacity) {
+    size_t new_capacity = builder->peephole_node_capacity == 0 ? 16 :
+                          builder->peephole_node_capacity * 2;
+    peephole_node_t* new_nodes = (peephole_node_t*)realloc(
+      builder->peephole_nodes, new_capacity * sizeof(peephole_node_t)
+    );
+    
+    if (new_nodes == NULL) {
+      return -1;
+    }
+    
+    builder->peephole_nodes = new_nodes;
+    builder->peephole_node_capacity = new_capacity;
+  }
+  
+  peephole_node_t* node = &builder->peephole_nodes[builder->peephole_node_count];
+  node->edges = NULL;
+  node->edge_count = 0;
+  node->edge_capacity = 0;
+  node->rules = 0;
+  
+  return (int32_t)builder->peephole_node_count++;
+}
+
+/**
+ * @brief Get the child of a decision tree node along an edge, adding it if needed.
+ * 
+ * @param builder The builder.
+ * @param parent The parent node index.
+ * @param kind The edge kind.
+ * @param opcode The opcode of PEEPHOLE_EDGE_OPCODE edges.
+ * @return The child node index, or -1 if memory allocation failed.
+ */
+static int32_t peephole_add_child(coil_builder_t* builder, size_t parent,
+                                  peephole_edge_kind_t kind, uint8_t opcode) {
+  peephole_node_t* node = &builder->peephole_nodes[parent];
+  for (size_t i = 0; i < node->edge_count; i++) {
+    if (node->edges[i].kind == kind && 
+        (kind != PEEPHOLE_EDGE_OPCODE || node->edges[i].opcode == opcode)) {
+      return (int32_t)node->edges[i].child;
+    }
+  }
+  
+  int32_t child = peephole_add_node(builder);
+  if (child < 0) {
+    return -1;
+  }
+  
+  /* Adding the child may have moved the nodes */
+  node = &builder->peephole_nodes[parent];
+  if (node->edge_count >= node->edge_capacity) {
+    size_t new_capacity = node->edge_capacity == 0 ? 4 : node->edge_capacity * 2;
+    peephole_edge_t* new_edges = (peephole_edge_t*)realloc(
+      node->edges, new_capacity * sizeof(peephole_edge_t)
+    );
+    
+    if (new_edges == NULL) {
+      return -1;
+    }
+    
+    node->edges = new_edges;
+    node->edge_capacity = new_capacity;
+  }
+  
+  node->edges[node->edge_count].kind = kind;
+  node->edges[node->edge_count].opcode = opcode;
+  node->edges[node->edge_count].child = (size_t)child;
+  node->edge_count++;
+  
+  return child;
+}
+
+/**
+ * @brief Free the peephole decision tree.
+ * 
+ * @param builder The builder.
+ */
+static void peephole_free(coil_builder_t* builder) {
+  for (size_t i = 0; i < builder->peephole_node_count; i++) {
+    free(builder->peephole_nodes[i].edges);
+  }
+  
+  free(builder->peephole_nodes);
+  builder->peephole_nodes = NULL;
+  builder->peephole_node_count = 0;
+  builder->peephole_node_capacity = 0;
+}
+
+/**
+ * @brief Compile the peephole rules into a decision tree.
+ * 
+ * Each pattern is inserted along every path its alternatives allow, so
+ * patterns sharing a prefix share the nodes that test it.
+ * 
+ * @param builder The builder.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool peephole_compile(coil_builder_t* builder) {
+  assert(PEEPHOLE_RULE_COUNT <= 32);
+  
+  if (peephole_add_node(builder) < 0) {
+    return false;
+  }
+  
+  for (size_t r = 0; r < PEEPHOLE_RULE_COUNT; r++) {
+    size_t paths[PEEPHOLE_MAX_PATHS];
+    size_t path_count = 1;
+    paths[0] = 0;
+    
+    const char* p = peephole_rules[r].pattern;
+    while (*p != '\0') {
+      /* Extend every path by each alternative of the next instruction */
+      size_t next[PEEPHOLE_MAX_PATHS];
+      size_t next_count = 0;
+      
+      while (*p != '\0' && *p != ' ') {
+        size_t length = strcspn(p, "| ");
+        peephole_edge_kind_t kind = PEEPHOLE_EDGE_OPCODE;
+        uint8_t opcode = 0;
+        
+        if (length == 1 && *p == '*') {
+          kind = PEEPHOLE_EDGE_ANY;
+        } else if (length == 1 && *p == '$') {
+          kind = PEEPHOLE_EDGE_END;
+        } else {
+          size_t i = 0;
+          while (i < sizeof(peephole_opcodes) / sizeof(peephole_opcodes[0]) &&
+                 (strlen(peephole_opcodes[i].name) != length ||
+                  strncmp(peephole_opcodes[i].name, p, length) != 0)) {
+            i++;
+          }
+          assert(i < sizeof(peephole_opcodes) / sizeof(peephole_opcodes[0]));
+          opcode = peephole_opcodes[i].opcode;
+        }
+        
+        for (size_t i = 0; i < path_count; i++) {
+          assert(next_count < PEEPHOLE_MAX_PATHS);
+          int32_t child = peephole_add_child(builder, paths[i], kind, opcode);
+          if (child < 0) {
+            return false;
+          }
+          next[next_count++] = (size_t)child;
+        }
+        
+        p += length;
+        if (*p == '|') {
+          p++;
+        }
+      }
+      
+      memcpy(paths, next, next_count * sizeof(size_t));
+      path_count = next_count;
+      while (*p == ' ') {
+        p++;
+      }
+    }
+    
+    for (size_t i = 0; i < path_count; i++) {
+      builder->peephole_nodes[paths[i]].rules |= (uint32_t)1 << r;
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Find the rules whose pattern matches a window.
+ * 
+ * @param builder The builder.
+ * @param node The decision tree node reached so far.
+ * @param insns The instructions of the block.
+ * @param count The number of instructions.
+ * @param at The next instruction to test.
+ * @return The matching rules, one bit each.
+ */
+static uint32_t peephole_match(const coil_builder_t* builder, size_t node,
+                               const peephole_insn_t* insns, size_t count, size_t at) {
+  const peephole_node_t* current = &builder->peephole_nodes[node];
+  uint32_t rules = current->rules;
+  
+  for (size_t i = 0; i < current->edge_count; i++) {
+    const peephole_edge_t* edge = &current->edges[i];
+    bool taken = false;
+    
+    switch (edge->kind) {
+      case PEEPHOLE_EDGE_OPCODE:
+        taken = at < count && insns[at].opcode == edge->opcode;
+        break;
+        
+      case PEEPHOLE_EDGE_ANY:
+        taken = at < count;
+        break;
+        
+      case PEEPHOLE_EDGE_END:
+        taken = at == count;
+        break;
+    }
+    
+    /* The end of the block is tested without consuming an instruction */
+    if (taken) {
+      rules |= peephole_match(builder, edge->child, insns, count,
+                              edge->kind == PEEPHOLE_EDGE_END ? at : at + 1);
+    }
+  }
+  
+  return rules;
+}
+
+/**
+ * @brief Run the peephole rules over the blocks of a function.
+ * 
+ * Each block is decoded in place, rewritten by applying the first rule
+ * that matches at each position until none does, and encoded back. The
+ * code only shrinks, so it is encoded over its own bytes.
+ * 
+ * @param builder The builder.
+ * @param function_code The function code.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool peephole_function(coil_builder_t* builder, function_code_t* function_code) {
+  peephole_scope_t scope;
+  memset(scope.read, 0, sizeof(scope.read));
+  
+  /* Any operand may name a register, so reads are over-approximated */
+  for (size_t b = 0; b < function_code->block_count; b++) {
+    basic_block_t* block = function_code->blocks[b];
+    for (size_t offset = 0; offset < block->code_size; offset += 4 + block->code[offset + 2]) {
+      for (uint8_t i = 0; i < block->code[offset + 2]; i++) {
+        scope.read[block->code[offset + 4 + i]] = true;
+      }
+    }
+  }
+  
+  for (size_t b = 0; b < function_code->block_count; b++) {
+    basic_block_t* block = function_code->blocks[b];
+    if (block->code_size == 0) {
+      continue;
+    }
+    
+    /* Decode the block; every instruction takes at least four bytes */
+    peephole_insn_t* insns = (peephole_insn_t*)malloc(
+      (block->code_size / 4) * sizeof(peephole_insn_t)
+    );
+    if (insns == NULL) {
+      return false;
+    }
+    
+    size_t count = 0;
+    size_t offset = 0;
+    while (offset < block->code_size) {
+      assert(offset + 4 + block->code[offset + 2] <= block->code_size);
+      insns[count].opcode = block->code[offset];
+      insns[count].flags = block->code[offset + 1];
+      insns[count].operand_count = block->code[offset + 2];
+      insns[count].destination = block->code[offset + 3];
+      insns[count].operands = &block->code[offset + 4];
+      offset += 4 + insns[count].operand_count;
+      count++;
+    }
+    
+    /* After a rewrite, the previous position may start a new match */
+    scope.block = b;
+    size_t at = 0;
+    while (at < count) {
+      uint32_t rules = peephole_match(builder, 0, insns, count, at);
+      bool rewritten = false;
+      
+      for (size_t r = 0; r < PEEPHOLE_RULE_COUNT && !rewritten; r++) {
+        if ((rules & ((uint32_t)1 << r)) != 0) {
+          rewritten = peephole_rules[r].rewrite(&scope, insns, &count, at);
+        }
+      }
+      
+      if (rewritten) {
+        at = at > 0 ? at - 1 : 0;
+      } else {
+        at++;
+      }
+    }
+    
+    /* Each instruction moves to an offset no later than its own */
+    size_t size = 0;
+    for (size_t i = 0; i < count; i++) {
+      memmove(&block->code[size + 4], insns[i].operands, insns[i].operand_count);
+      block->code[size] = insns[i].opcode;
+      block->code[size + 1] = insns[i].flags;
+      block->code[size + 2] = insns[i].operand_count;
+      block->code[size + 3] = insns[i].destination;
+      size += 4 + insns[i].operand_count;
+    }
+    block->code_size = size;
+    
+    free(insns);
+  }
+  
+  return true;
+}
+
 coil_builder_t* coil_builder_create(void) {
   coil_builder_t* builder = (coil_builder_t*)malloc(sizeof(coil_builder_t));
   if (builder == NULL) {
@@ -340,6 +865,12 @@ coil_builder_t* coil_builder_create(void) {
   
   builder->current_function = NULL;
   builder->module_name = NULL;
+  builder->target_count = 0;
+  
+  builder->peephole = false;
+  builder->peephole_nodes = NULL;
+  builder->peephole_node_count = 0;
+  builder->peephole_node_capacity = 0;
   
   /* Add predefined types */
   for (int i = 0; i < PREDEFINED_COUNT; i++) {
@@ -390,6 +921,9 @@ void coil_builder_destroy(coil_builder_t* builder) {
   /* Free module name */
   free(builder->module_name);
   
+  /* Free the peephole decision tree */
+  peephole_free(builder);
+  
   free(builder);
 }
 
@@ -478,9 +1012,21 @@ int32_t coil_builder_add_struct_type(coil_builder_t* builder, int32_t* field_typ
   return type_index;
 }
 
-int32_t coil_builder_add_function(coil_builder_t* builder, const char* name, 
-                                 int32_t return_type, int32_t* param_types, 
-                                 uint32_t param_count, bool is_external) {
+/**
+ * @brief Add a function entry to the builder and the Function section.
+ * 
+ * @param builder The builder.
+ * @param name The function name.
+ * @param return_type The return type index.
+ * @param param_types Array of parameter type indices.
+ * @param param_count Number of parameters.
+ * @param flags Function entry flags.
+ * @param alias The index of the function whose code is shared, or -1.
+ * @return The function index or -1 on failure.
+ */
+static int32_t add_function_entry(coil_builder_t* builder, const char* name, 
+                                  int32_t return_type, const int32_t* param_types, 
+                                  uint32_t param_count, uint32_t flags, int32_t alias) {
   assert(builder != NULL);
   assert(name != NULL);
   assert(param_types != NULL || param_count == 0);
@@ -508,7 +1054,8 @@ int32_t coil_builder_add_function(coil_builder_t* builder, const char* name,
   }
   
   builder->functions[function_index].return_type = return_type;
-  builder->functions[function_index].is_external = is_external;
+  builder->functions[function_index].is_external = (flags & FUNCTION_FLAG_EXTERNAL) != 0;
+  builder->functions[function_index].alias = alias;
   
   if (param_count > 0) {
     builder->functions[function_index].param_types = (int32_t*)malloc(param_count * sizeof(int32_t));
@@ -557,14 +1104,129 @@ int32_t coil_builder_add_function(coil_builder_t* builder, const char* name,
     }
   }
   
-  /* Append is_external flag */
-  if (!append_uint32(function_section, is_external ? 1 : 0)) {
+  /* Append the flags */
+  if (!append_uint32(function_section, flags)) {
+    return -1;
+  }
+  
+  /* Aliases name the function whose code they share */
+  if ((flags & FUNCTION_FLAG_ALIAS) != 0 && 
+      !append_uint32(function_section, (uint32_t)alias)) {
     return -1;
   }
   
   return function_index;
 }
 
+int32_t coil_builder_add_function(coil_builder_t* builder, const char* name, 
+                                 int32_t return_type, int32_t* param_types, 
+                                 uint32_t param_count, bool is_external) {
+  return add_function_entry(builder, name, return_type, param_types, param_count,
+                            is_external ? FUNCTION_FLAG_EXTERNAL : 0, -1);
+}
+
+int32_t coil_builder_add_function_alias(coil_builder_t* builder, const char* name, 
+                                        int32_t target) {
+  assert(builder != NULL);
+  assert(target >= 0 && target < (int32_t)builder->function_count);
+  
+  /* Aliases of aliases share the final target's code */
+  const function_entry_t* entry = &builder->functions[target];
+  if (entry->alias >= 0) {
+    target = entry->alias;
+    entry = &builder->functions[target];
+  }
+  
+  return add_function_entry(builder, name, entry->return_type, entry->param_types,
+                            entry->param_count, FUNCTION_FLAG_ALIAS, target);
+}
+
+int32_t coil_builder_add_function_dispatch(coil_builder_t* builder, const char* name, 
+                                           int32_t return_type, int32_t* param_types, 
+                                           uint32_t param_count) {
+  return add_function_entry(builder, name, return_type, param_types, param_count,
+                            FUNCTION_FLAG_DISPATCH, -1);
+}
+
+/**
+ * @brief Append a list of strings to a section.
+ * 
+ * @param section The section.
+ * @param strings The strings.
+ * @param count Number of strings.
+ * @return true on success, false on failure.
+ */
+static bool append_string_list(section_t* section, const char* const* strings, uint32_t count) {
+  if (!append_uint32(section, count)) {
+    return false;
+  }
+  
+  for (uint32_t i = 0; i < count; i++) {
+    if (!append_string(section, strings[i])) {
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+int32_t coil_builder_add_target(coil_builder_t* builder, const char* device_class,
+                                const char* const* required, uint32_t required_count,
+                                const char* const* preferred, uint32_t preferred_count) {
+  assert(builder != NULL);
+  assert(required != NULL || required_count == 0);
+  assert(preferred != NULL || preferred_count == 0);
+  
+  int32_t target_index = (int32_t)builder->target_count;
+  section_t* metadata_section = &builder->sections[SECTION_METADATA];
+  if (!append_uint32(metadata_section, METADATA_TARGET) ||
+      !append_uint32(metadata_section, (uint32_t)target_index) ||
+      !append_string(metadata_section, device_class != NULL ? device_class : "") ||
+      !append_string_list(metadata_section, required, required_count) ||
+      !append_string_list(metadata_section, preferred, preferred_count)) {
+    return -1;
+  }
+  
+  builder->target_count++;
+  return target_index;
+}
+
+bool coil_builder_add_function_version(coil_builder_t* builder, int32_t dispatch,
+                                       int32_t version, int32_t target) {
+  assert(builder != NULL);
+  assert(dispatch >= 0 && dispatch < (int32_t)builder->function_count);
+  assert(version >= 0 && version < (int32_t)builder->function_count);
+  assert(target >= -1 && target < (int32_t)builder->target_count);
+  
+  section_t* metadata_section = &builder->sections[SECTION_METADATA];
+  return append_uint32(metadata_section, METADATA_FUNCTION_VERSION) &&
+         append_uint32(metadata_section, (uint32_t)dispatch) &&
+         append_uint32(metadata_section, (uint32_t)version) &&
+         append_uint32(metadata_section, target < 0 ? COIL_NO_TARGET : (uint32_t)target);
+}
+
+bool coil_builder_add_function_effects(coil_builder_t* builder, int32_t function,
+                                       function_effect_t effect) {
+  assert(builder != NULL);
+  assert(function >= 0 && function < (int32_t)builder->function_count);
+  
+  section_t* metadata_section = &builder->sections[SECTION_METADATA];
+  return append_uint32(metadata_section, METADATA_FUNCTION_EFFECTS) &&
+         append_uint32(metadata_section, (uint32_t)function) &&
+         append_uint32(metadata_section, (uint32_t)effect);
+}
+
+bool coil_builder_add_function_attributes(coil_builder_t* builder, int32_t function,
+                                          uint32_t attributes) {
+  assert(builder != NULL);
+  assert(function >= 0 && function < (int32_t)builder->function_count);
+  
+  section_t* metadata_section = &builder->sections[SECTION_METADATA];
+  return append_uint32(metadata_section, METADATA_FUNCTION_ATTRIBUTES) &&
+         append_uint32(metadata_section, (uint32_t)function) &&
+         append_uint32(metadata_section, attributes);
+}
+
 int32_t coil_builder_add_global(coil_builder_t* builder, const char* name, 
                                int32_t type, const void* initializer, 
                                size_t initializer_size) {
@@ -763,12 +1425,30 @@ bool coil_builder_add_instruction(coil_builder_t* builder, uint8_t opcode,
   return true;
 }
 
+bool coil_builder_set_peephole(coil_builder_t* builder, bool enabled) {
+  assert(builder != NULL);
+  
+  /* The rules are compiled the first time they are enabled */
+  if (enabled && builder->peephole_node_count == 0 && !peephole_compile(builder)) {
+    peephole_free(builder);
+    return false;
+  }
+  
+  builder->peephole = enabled;
+  return true;
+}
+
 bool coil_builder_end_function_code(coil_builder_t* builder) {
   assert(builder != NULL);
   assert(builder->current_function != NULL);
   
   function_code_t* func_code = builder->current_function;
   
+  /* Rewrite the encoded instructions */
+  if (builder->peephole && !peephole_function(builder, func_code)) {
+    return false;
+  }
+  
   /* Add the function code to the code section */
   section_t* code_section = &builder->sections[SECTION_CODE];
   
@@ -880,4 +1560,41 @@ type_encoding_t coil_get_predefined_type(int type) {
   assert(type >= 0 && type < PREDEFINED_COUNT);
   
   return predefined_types[type];
-}
\ No newline at end of file
+}
+
+int32_t coil_lookup_memory_space(const char* name) {
+  static const char* const names[] = {
+    "global", "local", "shared", "constant", "private"
+  };
+  
+  assert(name != NULL);
+  
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    if (strcmp(name, names[i]) == 0) {
+      return (int32_t)i;
+    }
+  }
+  return -1;
+}
+
+uint32_t coil_lookup_function_attribute(const char* name) {
+  static const struct {
+    const char* name;
+    uint32_t flag;
+  } attributes[] = {
+    { "hot", FUNCTION_ATTRIBUTE_HOT },
+    { "cold", FUNCTION_ATTRIBUTE_COLD },
+    { "inline", FUNCTION_ATTRIBUTE_INLINE },
+    { "noinline", FUNCTION_ATTRIBUTE_NOINLINE },
+    { "pure", FUNCTION_ATTRIBUTE_PURE },
+  };
+  
+  assert(name != NULL);
+  
+  for (size_t i = 0; i < sizeof(attributes) / sizeof(attributes[0]); i++) {
+    if (strcmp(name, attributes[i].name) == 0) {
+      return attributes[i].flag;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,616 @@
+/**
+ * @file callgraph.c
+ * @brief Implementation of the call graph.
+ * 
+ * This file contains call graph construction from the call expressions of
+ * each function, an iterative Tarjan search for the strongly connected
+ * components, and the grouping of components into dependency waves.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/callgraph.h"
+#include "../include/ir.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Call graph structure.
+ */
+struct callgraph {
+  size_t function_count; /**< Number of functions. */
+  ast_node_t** functions; /**< Function and external function nodes. */
+  ir_var_table_t* names; /**< Function names, numbered like the functions. */
+  size_t* callee_start;  /**< Offset of each function's callees, plus an end. */
+  size_t* callees;       /**< Callee function numbers. */
+  size_t* caller_start;  /**< Offset of each function's callers, plus an end. */
+  size_t* callers;       /**< Caller function numbers. */
+  bool* indirect;        /**< Whether each function makes indirect calls. */
+  bool* address_taken;   /**< Whether each function's name escapes. */
+  size_t scc_count;      /**< Number of components. */
+  size_t* function_scc;  /**< Component of each function. */
+  size_t* scc_start;     /**< Offset of each component's functions, plus an end. */
+  size_t* scc_functions; /**< Functions grouped by component. */
+  size_t wave_count;     /**< Number of waves. */
+  size_t* scc_wave;      /**< Wave of each component. */
+  size_t* wave_start;    /**< Offset of each wave's components, plus an end. */
+  size_t* wave_sccs;     /**< Components grouped by wave. */
+};
+
+/**
+ * @brief Growable list of call edges.
+ */
+typedef struct {
+  size_t* from;          /**< Caller of each edge. */
+  size_t* to;            /**< Callee of each edge. */
+  size_t count;          /**< Number of edges. */
+  size_t capacity;       /**< Allocated capacity. */
+} edge_list_t;
+
+/**
+ * @brief Scan state for the calls of one function.
+ */
+typedef struct {
+  callgraph_t* cg;       /**< The call graph. */
+  edge_list_t* edges;    /**< Edges found so far. */
+  size_t* marks;         /**< Last caller, plus one, that recorded each callee. */
+  ir_var_table_t* locals; /**< Parameters and locals hiding function names. */
+  size_t caller;         /**< Caller function number. */
+  bool in_function;      /**< Whether the scan is inside a function body. */
+  bool failed;           /**< Whether memory allocation failed. */
+} call_scan_t;
+
+/**
+ * @brief Marker for unvisited functions in the component search.
+ */
+#define CALLGRAPH_UNVISITED ((size_t)-1)
+
+/**
+ * @brief Record a call edge once per caller and callee.
+ * 
+ * @param scan The scan state.
+ * @param callee The callee function number.
+ */
+static void add_edge(call_scan_t* scan, size_t callee) {
+  if (scan->marks[callee] == scan->caller + 1) {
+    return;
+  }
+  
+  edge_list_t* edges = scan->edges;
+  if (edges->count == edges->capacity) {
+    size_t capacity = edges->capacity == 0 ? 16 : edges->capacity * 2;
+    size_t* from = (size_t*)realloc(edges->from, capacity * sizeof(size_t));
+    if (from != NULL) {
+      edges->from = from;
+    }
+    size_t* to = (size_t*)realloc(edges->to, capacity * sizeof(size_t));
+    if (to != NULL) {
+      edges->to = to;
+    }
+    if (from == NULL || to == NULL) {
+      scan->failed = true;
+      return;
+    }
+    edges->capacity = capacity;
+  }
+  
+  scan->marks[callee] = scan->caller + 1;
+  edges->from[edges->count] = scan->caller;
+  edges->to[edges->count] = callee;
+  edges->count++;
+}
+
+/**
+ * @brief Find the function an identifier names in the scanned scope.
+ * 
+ * @param scan The scan state.
+ * @param expr The expression.
+ * @return The function number, or -1 if the expression names no function.
+ */
+static int32_t named_function(const call_scan_t* scan, const ast_node_t* expr) {
+  if (expr->type != AST_EXPR_IDENTIFIER ||
+      (scan->locals != NULL &&
+       ir_var_table_find(scan->locals, expr->data.expr_identifier.name) >= 0)) {
+    return -1;
+  }
+  
+  return ir_var_table_find(scan->cg->names, expr->data.expr_identifier.name);
+}
+
+/**
+ * @brief Record the calls and function references of an expression.
+ * 
+ * @param scan The scan state.
+ * @param expr The expression (can be NULL).
+ */
+static void scan_expr(call_scan_t* scan, const ast_node_t* expr) {
+  if (expr == NULL) {
+    return;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_IDENTIFIER: {
+      int32_t function = named_function(scan, expr);
+      if (function >= 0) {
+        scan->cg->address_taken[function] = true;
+      }
+      break;
+    }
+    
+    case AST_EXPR_FIELD:
+      scan_expr(scan, expr->data.expr_field.object);
+      break;
+    
+    case AST_EXPR_INDEX:
+      scan_expr(scan, expr->data.expr_index.array);
+      scan_expr(scan, expr->data.expr_index.index);
+      break;
+    
+    case AST_EXPR_CALL: {
+      int32_t callee = named_function(scan, expr->data.expr_call.function);
+      if (callee >= 0 && scan->in_function) {
+        add_edge(scan, (size_t)callee);
+      } else {
+        /* Calls from initializers have no caller in the graph */
+        if (scan->in_function) {
+          scan->cg->indirect[scan->caller] = true;
+        }
+        scan_expr(scan, expr->data.expr_call.function);
+      }
+      
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        scan_expr(scan, expr->data.expr_call.arguments.nodes[i]);
+      }
+      break;
+    }
+    
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Record the calls of a function body.
+ * 
+ * @param scan The scan state.
+ * @param function The function AST node.
+ */
+static void scan_function(call_scan_t* scan, ast_node_t* function) {
+  scan->locals = ir_var_table_create();
+  if (scan->locals == NULL) {
+    scan->failed = true;
+    return;
+  }
+  
+  /* Parameters and locals hide functions of the same name */
+  for (size_t i = 0; i < function->data.function.parameters.count && !scan->failed; i++) {
+    const ast_node_t* param = function->data.function.parameters.nodes[i];
+    scan->failed = ir_var_table_intern(scan->locals, param->data.parameter.name) < 0;
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count && !scan->failed; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count && !scan->failed; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      if (def != NULL) {
+        scan->failed = ir_var_table_intern(scan->locals, def) < 0;
+      }
+    }
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count && !scan->failed; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      if (stmt->type == AST_STMT_BRANCH) {
+        scan_expr(scan, stmt->data.stmt_branch.condition);
+      } else if (stmt->type == AST_STMT_RETURN) {
+        scan_expr(scan, stmt->data.stmt_return.value);
+      } else if (instruction != NULL) {
+        for (size_t k = 0; k < instruction->data.stmt_instruction.operands.count; k++) {
+          scan_expr(scan, instruction->data.stmt_instruction.operands.nodes[k]);
+        }
+      }
+    }
+  }
+  
+  ir_var_table_destroy(scan->locals);
+  scan->locals = NULL;
+}
+
+/**
+ * @brief Pack a list of edges into per-node offset arrays.
+ * 
+ * @param n The number of nodes.
+ * @param keys The node each edge is listed under.
+ * @param values The node each edge points to.
+ * @param count The number of edges.
+ * @param start Where to store the offsets, n + 1 entries.
+ * @param items Where to store the packed edge targets.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool pack_edges(size_t n, const size_t* keys, const size_t* values, size_t count,
+                       size_t** start, size_t** items) {
+  *start = (size_t*)calloc(n + 2, sizeof(size_t));
+  *items = (size_t*)malloc((count + 1) * sizeof(size_t));
+  if (*start == NULL || *items == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < count; i++) {
+    (*start)[keys[i] + 2]++;
+  }
+  for (size_t i = 2; i < n + 2; i++) {
+    (*start)[i] += (*start)[i - 1];
+  }
+  
+  /* Entry key + 1 serves as the insertion cursor and ends up as the offset */
+  for (size_t i = 0; i < count; i++) {
+    (*items)[(*start)[keys[i] + 1]++] = values[i];
+  }
+  return true;
+}
+
+/**
+ * @brief Find the strongly connected components with Tarjan's algorithm.
+ * 
+ * The search is iterative. Components are completed callees first, which
+ * numbers them bottom-up.
+ * 
+ * @param cg The call graph, with edges.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool find_components(callgraph_t* cg) {
+  size_t n = cg->function_count;
+  size_t* index = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* low = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* cursor = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* frames = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* stack = (size_t*)malloc((n + 1) * sizeof(size_t));
+  bool* on_stack = (bool*)calloc(n + 1, sizeof(bool));
+  cg->function_scc = (size_t*)malloc((n + 1) * sizeof(size_t));
+  cg->scc_start = (size_t*)malloc((n + 2) * sizeof(size_t));
+  cg->scc_functions = (size_t*)malloc((n + 1) * sizeof(size_t));
+  bool success = index != NULL && low != NULL && cursor != NULL && frames != NULL &&
+                 stack != NULL && on_stack != NULL && cg->function_scc != NULL &&
+                 cg->scc_start != NULL && cg->scc_functions != NULL;
+  
+  size_t next_index = 0;
+  size_t top = 0;
+  size_t placed = 0;
+  for (size_t i = 0; i < n && success; i++) {
+    index[i] = CALLGRAPH_UNVISITED;
+  }
+  
+  for (size_t root = 0; root < n && success; root++) {
+    if (index[root] != CALLGRAPH_UNVISITED) {
+      continue;
+    }
+    
+    size_t depth = 0;
+    frames[depth++] = root;
+    index[root] = low[root] = next_index++;
+    cursor[root] = cg->callee_start[root];
+    stack[top++] = root;
+    on_stack[root] = true;
+    
+    while (depth > 0) {
+      size_t v = frames[depth - 1];
+      if (cursor[v] < cg->callee_start[v + 1]) {
+        size_t w = cg->callees[cursor[v]++];
+        if (index[w] == CALLGRAPH_UNVISITED) {
+          index[w] = low[w] = next_index++;
+          cursor[w] = cg->callee_start[w];
+          stack[top++] = w;
+          on_stack[w] = true;
+          frames[depth++] = w;
+        } else if (on_stack[w] && index[w] < low[v]) {
+          low[v] = index[w];
+        }
+        continue;
+      }
+      
+      depth--;
+      if (depth > 0 && low[v] < low[frames[depth - 1]]) {
+        low[frames[depth - 1]] = low[v];
+      }
+      if (low[v] != index[v]) {
+        continue;
+      }
+      
+      /* v roots a component made of the functions above it on the stack */
+      cg->scc_start[cg->scc_count] = placed;
+      size_t w;
+      do {
+        w = stack[--top];
+        on_stack[w] = false;
+        cg->function_scc[w] = cg->scc_count;
+        cg->scc_functions[placed++] = w;
+      } while (w != v);
+      cg->scc_count++;
+    }
+  }
+  
+  if (success) {
+    cg->scc_start[cg->scc_count] = placed;
+  }
+  
+  free(index);
+  free(low);
+  free(cursor);
+  free(frames);
+  free(stack);
+  free(on_stack);
+  return success;
+}
+
+/**
+ * @brief Group the components into waves of independent components.
+ * 
+ * @param cg The call graph, with components.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool find_waves(callgraph_t* cg) {
+  size_t count = cg->scc_count;
+  cg->scc_wave = (size_t*)calloc(count + 1, sizeof(size_t));
+  if (cg->scc_wave == NULL) {
+    return false;
+  }
+  
+  /* Callees have smaller component numbers, so their waves are known */
+  for (size_t scc = 0; scc < count; scc++) {
+    for (size_t i = cg->scc_start[scc]; i < cg->scc_start[scc + 1]; i++) {
+      size_t f = cg->scc_functions[i];
+      for (size_t e = cg->callee_start[f]; e < cg->callee_start[f + 1]; e++) {
+        size_t callee_scc = cg->function_scc[cg->callees[e]];
+        if (callee_scc != scc && cg->scc_wave[callee_scc] + 1 > cg->scc_wave[scc]) {
+          cg->scc_wave[scc] = cg->scc_wave[callee_scc] + 1;
+        }
+      }
+    }
+    if (cg->scc_wave[scc] + 1 > cg->wave_count) {
+      cg->wave_count = cg->scc_wave[scc] + 1;
+    }
+  }
+  
+  size_t* sccs = (size_t*)malloc((count + 1) * sizeof(size_t));
+  if (sccs == NULL) {
+    return false;
+  }
+  for (size_t scc = 0; scc < count; scc++) {
+    sccs[scc] = scc;
+  }
+  
+  bool success = pack_edges(cg->wave_count, cg->scc_wave, sccs, count,
+                            &cg->wave_start, &cg->wave_sccs);
+  free(sccs);
+  return success;
+}
+
+/**
+ * @brief Number the functions and record their calls.
+ * 
+ * @param cg The call graph.
+ * @param module The module AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool find_calls(callgraph_t* cg, ast_node_t* module) {
+  ast_node_list_t* declarations = &module->data.module.declarations;
+  for (size_t i = 0; i < declarations->count; i++) {
+    ast_node_t* decl = declarations->nodes[i];
+    const char* name = decl->type == AST_FUNCTION ? decl->data.function.name :
+                       decl->type == AST_EXTERN_FUNCTION ? decl->data.extern_function.name :
+                       NULL;
+    if (name == NULL) {
+      continue;
+    }
+    
+    if (ir_var_table_intern(cg->names, name) < 0) {
+      return false;
+    }
+    cg->functions[cg->function_count++] = decl;
+  }
+  
+  size_t n = cg->function_count;
+  edge_list_t edges = { NULL, NULL, 0, 0 };
+  call_scan_t scan = { cg, &edges, NULL, NULL, 0, false, false };
+  scan.marks = (size_t*)calloc(n + 1, sizeof(size_t));
+  cg->indirect = (bool*)calloc(n + 1, sizeof(bool));
+  cg->address_taken = (bool*)calloc(n + 1, sizeof(bool));
+  scan.failed = scan.marks == NULL || cg->indirect == NULL || cg->address_taken == NULL;
+  
+  for (size_t i = 0; i < declarations->count && !scan.failed; i++) {
+    ast_node_t* decl = declarations->nodes[i];
+    scan.in_function = false;
+    if (decl->type == AST_CONSTANT) {
+      scan_expr(&scan, decl->data.constant.value);
+    } else if (decl->type == AST_GLOBAL) {
+      scan_expr(&scan, decl->data.global.initializer);
+    } else if (decl->type == AST_FUNCTION) {
+      scan.caller = (size_t)ir_var_table_find(cg->names, decl->data.function.name);
+      scan.in_function = true;
+      if (decl->data.function.alias != NULL) {
+        int32_t target = ir_var_table_find(cg->names, decl->data.function.alias);
+        if (target >= 0) {
+          add_edge(&scan, (size_t)target);
+        }
+      } else {
+        scan_function(&scan, decl);
+      }
+    }
+  }
+  
+  bool success = !scan.failed &&
+                 pack_edges(n, edges.from, edges.to, edges.count,
+                            &cg->callee_start, &cg->callees) &&
+                 pack_edges(n, edges.to, edges.from, edges.count,
+                            &cg->caller_start, &cg->callers);
+  
+  free(scan.marks);
+  free(edges.from);
+  free(edges.to);
+  return success;
+}
+
+callgraph_t* callgraph_build(ast_node_t* module) {
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  
+  callgraph_t* cg = (callgraph_t*)calloc(1, sizeof(callgraph_t));
+  if (cg == NULL) {
+    return NULL;
+  }
+  
+  cg->functions = (ast_node_t**)malloc((module->data.module.declarations.count + 1) *
+                                       sizeof(ast_node_t*));
+  cg->names = ir_var_table_create();
+  if (cg->functions == NULL || cg->names == NULL || !find_calls(cg, module) ||
+      !find_components(cg) || !find_waves(cg)) {
+    callgraph_destroy(cg);
+    return NULL;
+  }
+  
+  return cg;
+}
+
+void callgraph_destroy(callgraph_t* cg) {
+  if (cg == NULL) {
+    return;
+  }
+  
+  free(cg->functions);
+  ir_var_table_destroy(cg->names);
+  free(cg->callee_start);
+  free(cg->callees);
+  free(cg->caller_start);
+  free(cg->callers);
+  free(cg->indirect);
+  free(cg->address_taken);
+  free(cg->function_scc);
+  free(cg->scc_start);
+  free(cg->scc_functions);
+  free(cg->scc_wave);
+  free(cg->wave_start);
+  free(cg->wave_sccs);
+  free(cg);
+}
+
+size_t callgraph_function_count(const callgraph_t* cg) {
+  assert(cg != NULL);
+  
+  return cg->function_count;
+}
+
+ast_node_t* callgraph_get_function(const callgraph_t* cg, size_t function) {
+  assert(cg != NULL && function < cg->function_count);
+  
+  return cg->functions[function];
+}
+
+int32_t callgraph_find(const callgraph_t* cg, const char* name) {
+  assert(cg != NULL);
+  assert(name != NULL);
+  
+  return ir_var_table_find(cg->names, name);
+}
+
+size_t callgraph_callee_count(const callgraph_t* cg, size_t function) {
+  assert(cg != NULL && function < cg->function_count);
+  
+  return cg->callee_start[function + 1] - cg->callee_start[function];
+}
+
+size_t callgraph_get_callee(const callgraph_t* cg, size_t function, size_t index) {
+  assert(index < callgraph_callee_count(cg, function));
+  
+  return cg->callees[cg->callee_start[function] + index];
+}
+
+size_t callgraph_caller_count(const callgraph_t* cg, size_t function) {
+  assert(cg != NULL && function < cg->function_count);
+  
+  return cg->caller_start[function + 1] - cg->caller_start[function];
+}
+
+size_t callgraph_get_caller(const callgraph_t* cg, size_t function, size_t index) {
+  assert(index < callgraph_caller_count(cg, function));
+  
+  return cg->callers[cg->caller_start[function] + index];
+}
+
+bool callgraph_has_indirect_calls(const callgraph_t* cg, size_t function) {
+  assert(cg != NULL && function < cg->function_count);
+  
+  return cg->indirect[function];
+}
+
+bool callgraph_address_taken(const callgraph_t* cg, size_t function) {
+  assert(cg != NULL && function < cg->function_count);
+  
+  return cg->address_taken[function];
+}
+
+size_t callgraph_scc_count(const callgraph_t* cg) {
+  assert(cg != NULL);
+  
+  return cg->scc_count;
+}
+
+size_t callgraph_function_scc(const callgraph_t* cg, size_t function) {
+  assert(cg != NULL && function < cg->function_count);
+  
+  return cg->function_scc[function];
+}
+
+size_t callgraph_scc_size(const callgraph_t* cg, size_t scc) {
+  assert(cg != NULL && scc < cg->scc_count);
+  
+  return cg->scc_start[scc + 1] - cg->scc_start[scc];
+}
+
+size_t callgraph_get_scc_function(const callgraph_t* cg, size_t scc, size_t index) {
+  assert(index < callgraph_scc_size(cg, scc));
+  
+  return cg->scc_functions[cg->scc_start[scc] + index];
+}
+
+bool callgraph_scc_is_recursive(const callgraph_t* cg, size_t scc) {
+  if (callgraph_scc_size(cg, scc) > 1) {
+    return true;
+  }
+  
+  size_t function = callgraph_get_scc_function(cg, scc, 0);
+  for (size_t i = 0; i < callgraph_callee_count(cg, function); i++) {
+    if (callgraph_get_callee(cg, function, i) == function) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t callgraph_wave_count(const callgraph_t* cg) {
+  assert(cg != NULL);
+  
+  return cg->wave_count;
+}
+
+size_t callgraph_wave_size(const callgraph_t* cg, size_t wave) {
+  assert(cg != NULL && wave < cg->wave_count);
+  
+  return cg->wave_start[wave + 1] - cg->wave_start[wave];
+}
+
+size_t callgraph_get_wave_scc(const callgraph_t* cg, size_t wave, size_t index) {
+  assert(index < callgraph_wave_size(cg, wave));
+  
+  return cg->wave_sccs[cg->wave_start[wave] + index];
+}
+
+size_t callgraph_scc_wave(const callgraph_t* cg, size_t scc) {
+  assert(cg != NULL && scc < cg->scc_count);
+  
+  return cg->scc_wave[scc];
+}
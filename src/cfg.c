@@ -0,0 +1,1333 @@
+/**
+ * @file cfg.c
+ * @brief Implementation of the control flow graph.
+ * 
+ * This file contains CFG construction from branch targets, an iterative
+ * live variable analysis, a Semi-NCA dominator tree with incremental edge
+ * updates, dominance frontiers and the loop-nest forest.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/cfg.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Control flow graph structure.
+ */
+struct cfg {
+  ast_node_t* function;  /**< Function AST node, NULL for detached graphs. */
+  size_t block_count;    /**< Number of blocks. */
+  ir_var_table_t* labels; /**< Block labels, numbered like the blocks. */
+  size_t* lengths;       /**< Executed statement count of each block. */
+  size_t* succs;         /**< Successor block numbers, two slots per block. */
+  size_t* succ_counts;   /**< Successor count of each block. */
+  size_t* pred_start;    /**< Offset of each block's predecessors in the pool. */
+  size_t* pred_counts;   /**< Predecessor count of each block. */
+  size_t* pred_caps;     /**< Pool slots reserved for each block. */
+  size_t* preds;         /**< Predecessor pool. */
+  size_t pred_used;      /**< Number of pool slots handed out. */
+  size_t pred_capacity;  /**< Number of pool slots allocated. */
+  ir_bitset_t* live_in;  /**< Live-in sets, NULL until computed. */
+  ir_bitset_t* live_out; /**< Live-out sets, NULL until computed. */
+  size_t* idom;          /**< Immediate dominators, NULL until computed. */
+  size_t* depth;         /**< Depth of each block in the dominator tree. */
+  size_t* first_child;   /**< First dominator tree child of each block. */
+  size_t* next_sibling;  /**< Next dominator tree sibling of each block. */
+  size_t* prev_sibling;  /**< Previous dominator tree sibling of each block. */
+  size_t* dfs_number;    /**< Search numbers, CFG_NO_BLOCK outside a search. */
+  size_t* frontier_start; /**< Frontier offsets, NULL until computed. */
+  size_t* frontiers;     /**< Dominance frontier block numbers. */
+  size_t loop_count;     /**< Number of loops. */
+  size_t* loop_headers;  /**< Header of each loop, NULL until computed. */
+  size_t* loop_parents;  /**< Enclosing loop of each loop. */
+  size_t* loop_depths;   /**< Nesting depth of each loop. */
+  size_t* block_loops;   /**< Innermost loop of each block. */
+};
+
+/**
+ * @brief Marker for missing blocks and loops.
+ */
+#define CFG_NO_BLOCK ((size_t)-1)
+
+/**
+ * @brief Liveness scan state for one block.
+ */
+typedef struct {
+  ir_var_table_t* vars;  /**< Variable numbering table. */
+  ir_bitset_t* gen;      /**< Variables used before any definition. */
+  ir_bitset_t* kill;     /**< Variables defined in the block. */
+  bool failed;           /**< Whether memory allocation failed. */
+} live_scan_t;
+
+/**
+ * @brief Semi-NCA search state, indexed by search number.
+ */
+typedef struct {
+  size_t* vertex;        /**< Block of each search number. */
+  size_t* parent;        /**< Search tree parent. */
+  size_t* semi;          /**< Semidominator. */
+  size_t* label;         /**< Smallest semidominator on the compressed path. */
+  size_t* ancestor;      /**< Link-eval forest parent, then immediate dominator. */
+  size_t* stack;         /**< Search and path compression stack. */
+  size_t* cursor;        /**< Next successor to visit. */
+} dom_search_t;
+
+/**
+ * @brief Growable list of blocks.
+ */
+typedef struct {
+  size_t* items;         /**< Block numbers. */
+  size_t count;          /**< Number of blocks. */
+  size_t capacity;       /**< Allocated capacity. */
+} block_list_t;
+
+/**
+ * @brief Find the successors of a block.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @param targets Array of two entries to store the successors.
+ * @return The number of successors.
+ */
+static size_t block_successors(const cfg_t* cfg, size_t block, size_t targets[2]) {
+  ast_node_t* node = cfg->function->data.function.blocks.nodes[block];
+  size_t length = cfg->lengths[block];
+  
+  /* Fall through when the block has no terminator */
+  if (length == 0 ||
+      (ir_get_flags(node->data.stmt_block.statements.nodes[length - 1]) &
+       IR_FLAG_TERMINATOR) == 0) {
+    if (block + 1 < cfg->block_count) {
+      targets[0] = block + 1;
+      return 1;
+    }
+    return 0;
+  }
+  
+  ast_node_t* terminator = node->data.stmt_block.statements.nodes[length - 1];
+  if (terminator->type != AST_STMT_BRANCH) {
+    return 0;
+  }
+  
+  size_t count = 0;
+  const char* labels[2] = {
+    terminator->data.stmt_branch.true_target,
+    terminator->data.stmt_branch.false_target
+  };
+  for (int i = 0; i < 2; i++) {
+    if (labels[i] == NULL) {
+      continue;
+    }
+    
+    int32_t target = ir_var_table_find(cfg->labels, labels[i]);
+    if (target >= 0 && (count == 0 || targets[0] != (size_t)target)) {
+      targets[count++] = (size_t)target;
+    }
+  }
+  
+  return count;
+}
+
+/**
+ * @brief Allocate the edge storage of a graph.
+ * 
+ * @param n The number of blocks.
+ * @return A new graph without edges, or NULL if memory allocation failed.
+ */
+static cfg_t* create_graph(size_t n) {
+  cfg_t* cfg = (cfg_t*)calloc(1, sizeof(cfg_t));
+  if (cfg == NULL) {
+    return NULL;
+  }
+  
+  cfg->block_count = n;
+  cfg->lengths = (size_t*)calloc(n + 1, sizeof(size_t));
+  cfg->succs = (size_t*)malloc((2 * n + 1) * sizeof(size_t));
+  cfg->succ_counts = (size_t*)calloc(n + 1, sizeof(size_t));
+  cfg->pred_start = (size_t*)calloc(n + 1, sizeof(size_t));
+  cfg->pred_counts = (size_t*)calloc(n + 1, sizeof(size_t));
+  cfg->pred_caps = (size_t*)calloc(n + 1, sizeof(size_t));
+  
+  if (cfg->lengths == NULL || cfg->succs == NULL || cfg->succ_counts == NULL ||
+      cfg->pred_start == NULL || cfg->pred_counts == NULL || cfg->pred_caps == NULL) {
+    cfg_destroy(cfg);
+    return NULL;
+  }
+  
+  return cfg;
+}
+
+cfg_t* cfg_build(ast_node_t* function) {
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  size_t n = function->data.function.blocks.count;
+  cfg_t* cfg = create_graph(n);
+  if (cfg == NULL) {
+    return NULL;
+  }
+  
+  cfg->function = function;
+  cfg->labels = ir_var_table_create();
+  if (cfg->labels == NULL) {
+    cfg_destroy(cfg);
+    return NULL;
+  }
+  
+  /* Number the labels and find the executed prefix of each block */
+  for (size_t i = 0; i < n; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    if (ir_var_table_intern(cfg->labels, block->data.stmt_block.label) < 0) {
+      cfg_destroy(cfg);
+      return NULL;
+    }
+    
+    const ast_node_list_t* statements = &block->data.stmt_block.statements;
+    size_t length = 0;
+    while (length < statements->count) {
+      if (ir_get_flags(statements->nodes[length++]) & IR_FLAG_TERMINATOR) {
+        break;
+      }
+    }
+    cfg->lengths[i] = length;
+  }
+  
+  /* Successor lists */
+  size_t edge_count = 0;
+  for (size_t i = 0; i < n; i++) {
+    cfg->succ_counts[i] = block_successors(cfg, i, &cfg->succs[2 * i]);
+    for (size_t j = 0; j < cfg->succ_counts[i]; j++) {
+      cfg->pred_caps[cfg->succs[2 * i + j]]++;
+    }
+    edge_count += cfg->succ_counts[i];
+  }
+  
+  /* Predecessor lists, packed in the pool in block order */
+  cfg->preds = (size_t*)malloc((edge_count + 1) * sizeof(size_t));
+  if (cfg->preds == NULL) {
+    cfg_destroy(cfg);
+    return NULL;
+  }
+  cfg->pred_capacity = edge_count + 1;
+  
+  for (size_t i = 0; i < n; i++) {
+    cfg->pred_start[i] = cfg->pred_used;
+    cfg->pred_used += cfg->pred_caps[i];
+  }
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < cfg->succ_counts[i]; j++) {
+      size_t succ = cfg->succs[2 * i + j];
+      cfg->preds[cfg->pred_start[succ] + cfg->pred_counts[succ]++] = i;
+    }
+  }
+  
+  return cfg;
+}
+
+cfg_t* cfg_create(size_t block_count) {
+  cfg_t* cfg = create_graph(block_count);
+  if (cfg == NULL) {
+    return NULL;
+  }
+  
+  cfg->preds = (size_t*)malloc(16 * sizeof(size_t));
+  if (cfg->preds == NULL) {
+    cfg_destroy(cfg);
+    return NULL;
+  }
+  cfg->pred_capacity = 16;
+  
+  return cfg;
+}
+
+/**
+ * @brief Free an array of bit sets.
+ * 
+ * @param sets The bit sets (can be NULL).
+ * @param count The number of sets.
+ */
+static void free_bitsets(ir_bitset_t* sets, size_t count) {
+  if (sets == NULL) {
+    return;
+  }
+  
+  for (size_t i = 0; i < count; i++) {
+    ir_bitset_free(&sets[i]);
+  }
+  free(sets);
+}
+
+/**
+ * @brief Free the dominance frontiers and the loop forest.
+ * 
+ * Both are derived from the dominator tree and go stale when it changes.
+ * 
+ * @param cfg The control flow graph.
+ */
+static void free_derived(cfg_t* cfg) {
+  free(cfg->frontier_start);
+  free(cfg->frontiers);
+  free(cfg->loop_headers);
+  free(cfg->loop_parents);
+  free(cfg->loop_depths);
+  free(cfg->block_loops);
+  
+  cfg->frontier_start = NULL;
+  cfg->frontiers = NULL;
+  cfg->loop_count = 0;
+  cfg->loop_headers = NULL;
+  cfg->loop_parents = NULL;
+  cfg->loop_depths = NULL;
+  cfg->block_loops = NULL;
+}
+
+/**
+ * @brief Free the dominator tree.
+ * 
+ * @param cfg The control flow graph.
+ */
+static void free_dominators(cfg_t* cfg) {
+  free_derived(cfg);
+  free(cfg->idom);
+  free(cfg->depth);
+  free(cfg->first_child);
+  free(cfg->next_sibling);
+  free(cfg->prev_sibling);
+  free(cfg->dfs_number);
+  
+  cfg->idom = NULL;
+  cfg->depth = NULL;
+  cfg->first_child = NULL;
+  cfg->next_sibling = NULL;
+  cfg->prev_sibling = NULL;
+  cfg->dfs_number = NULL;
+}
+
+void cfg_destroy(cfg_t* cfg) {
+  if (cfg == NULL) {
+    return;
+  }
+  
+  ir_var_table_destroy(cfg->labels);
+  free(cfg->lengths);
+  free(cfg->succs);
+  free(cfg->succ_counts);
+  free(cfg->pred_start);
+  free(cfg->pred_counts);
+  free(cfg->pred_caps);
+  free(cfg->preds);
+  free_bitsets(cfg->live_in, cfg->block_count);
+  free_bitsets(cfg->live_out, cfg->block_count);
+  free_dominators(cfg);
+  free(cfg);
+}
+
+size_t cfg_block_count(const cfg_t* cfg) {
+  assert(cfg != NULL);
+  
+  return cfg->block_count;
+}
+
+ast_node_t* cfg_get_block(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->function != NULL && block < cfg->block_count);
+  
+  return cfg->function->data.function.blocks.nodes[block];
+}
+
+int32_t cfg_find_block(const cfg_t* cfg, const char* label) {
+  assert(cfg != NULL && cfg->labels != NULL);
+  assert(label != NULL);
+  
+  return ir_var_table_find(cfg->labels, label);
+}
+
+size_t cfg_statement_count(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && block < cfg->block_count);
+  
+  return cfg->lengths[block];
+}
+
+size_t cfg_successor_count(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && block < cfg->block_count);
+  
+  return cfg->succ_counts[block];
+}
+
+size_t cfg_get_successor(const cfg_t* cfg, size_t block, size_t index) {
+  assert(index < cfg_successor_count(cfg, block));
+  
+  return cfg->succs[2 * block + index];
+}
+
+size_t cfg_predecessor_count(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && block < cfg->block_count);
+  
+  return cfg->pred_counts[block];
+}
+
+size_t cfg_get_predecessor(const cfg_t* cfg, size_t block, size_t index) {
+  assert(index < cfg_predecessor_count(cfg, block));
+  
+  return cfg->preds[cfg->pred_start[block] + index];
+}
+
+/**
+ * @brief Use visitor that interns the used variable.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The liveness scan state.
+ */
+static void intern_use(ast_node_t** use, void* data) {
+  live_scan_t* scan = (live_scan_t*)data;
+  if (ir_var_table_intern(scan->vars, (*use)->data.expr_identifier.name) < 0) {
+    scan->failed = true;
+  }
+}
+
+/**
+ * @brief Use visitor that adds upward-exposed uses to the gen set.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The liveness scan state.
+ */
+static void record_gen(ast_node_t** use, void* data) {
+  live_scan_t* scan = (live_scan_t*)data;
+  int32_t id = ir_var_table_find(scan->vars, (*use)->data.expr_identifier.name);
+  if (!ir_bitset_test(scan->kill, (size_t)id)) {
+    ir_bitset_set(scan->gen, (size_t)id);
+  }
+}
+
+bool cfg_compute_liveness(cfg_t* cfg, ir_var_table_t* vars) {
+  assert(cfg != NULL && cfg->function != NULL);
+  assert(vars != NULL);
+  
+  size_t n = cfg->block_count;
+  
+  /* Number every variable first so the sets have a fixed size */
+  live_scan_t scan = { vars, NULL, NULL, false };
+  for (size_t i = 0; i < n && !scan.failed; i++) {
+    ast_node_t* block = cfg_get_block(cfg, i);
+    for (size_t j = 0; j < cfg->lengths[i] && !scan.failed; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      const char* def = ir_get_def(stmt);
+      
+      ir_visit_uses(stmt, intern_use, &scan);
+      if (def != NULL && ir_var_table_intern(vars, def) < 0) {
+        scan.failed = true;
+      }
+    }
+  }
+  if (scan.failed) {
+    return false;
+  }
+  
+  size_t var_count = ir_var_table_count(vars);
+  free_bitsets(cfg->live_in, n);
+  free_bitsets(cfg->live_out, n);
+  cfg->live_in = (ir_bitset_t*)calloc(n + 1, sizeof(ir_bitset_t));
+  cfg->live_out = (ir_bitset_t*)calloc(n + 1, sizeof(ir_bitset_t));
+  ir_bitset_t* gen = (ir_bitset_t*)calloc(n + 1, sizeof(ir_bitset_t));
+  ir_bitset_t* kill = (ir_bitset_t*)calloc(n + 1, sizeof(ir_bitset_t));
+  ir_bitset_t scratch = { NULL, 0 };
+  
+  bool success = cfg->live_in != NULL && cfg->live_out != NULL &&
+                 gen != NULL && kill != NULL && ir_bitset_init(&scratch, var_count);
+  for (size_t i = 0; i < n && success; i++) {
+    success = ir_bitset_init(&cfg->live_in[i], var_count) &&
+              ir_bitset_init(&cfg->live_out[i], var_count) &&
+              ir_bitset_init(&gen[i], var_count) &&
+              ir_bitset_init(&kill[i], var_count);
+  }
+  
+  /* Local gen and kill sets */
+  for (size_t i = 0; i < n && success; i++) {
+    ast_node_t* block = cfg_get_block(cfg, i);
+    scan.gen = &gen[i];
+    scan.kill = &kill[i];
+    
+    for (size_t j = 0; j < cfg->lengths[i]; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      const char* def = ir_get_def(stmt);
+      
+      ir_visit_uses(stmt, record_gen, &scan);
+      if (def != NULL) {
+        ir_bitset_set(&kill[i], (size_t)ir_var_table_find(vars, def));
+      }
+    }
+    ir_bitset_copy(&cfg->live_in[i], &gen[i]);
+  }
+  
+  /* Iterate in reverse block order until the sets are stable */
+  size_t words = (var_count + 63) / 64;
+  bool changed = success;
+  while (changed) {
+    changed = false;
+    for (size_t i = n; i-- > 0;) {
+      for (size_t s = 0; s < cfg_successor_count(cfg, i); s++) {
+        ir_bitset_union(&cfg->live_out[i], &cfg->live_in[cfg_get_successor(cfg, i, s)]);
+      }
+      
+      /* live_in = gen | (live_out & ~kill) */
+      for (size_t w = 0; w < words; w++) {
+        scratch.words[w] = gen[i].words[w] |
+                           (cfg->live_out[i].words[w] & ~kill[i].words[w]);
+      }
+      changed |= ir_bitset_union(&cfg->live_in[i], &scratch);
+    }
+  }
+  
+  free_bitsets(gen, n);
+  free_bitsets(kill, n);
+  ir_bitset_free(&scratch);
+  
+  if (!success) {
+    free_bitsets(cfg->live_in, n);
+    free_bitsets(cfg->live_out, n);
+    cfg->live_in = NULL;
+    cfg->live_out = NULL;
+  }
+  
+  return success;
+}
+
+const ir_bitset_t* cfg_live_in(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->live_in != NULL && block < cfg->block_count);
+  
+  return &cfg->live_in[block];
+}
+
+const ir_bitset_t* cfg_live_out(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->live_out != NULL && block < cfg->block_count);
+  
+  return &cfg->live_out[block];
+}
+
+/**
+ * @brief Add a block to a growable list.
+ * 
+ * @param list The list.
+ * @param block The block number.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool push_block(block_list_t* list, size_t block) {
+  if (list->count == list->capacity) {
+    size_t capacity = list->capacity == 0 ? 16 : list->capacity * 2;
+    size_t* items = (size_t*)realloc(list->items, capacity * sizeof(size_t));
+    if (items == NULL) {
+      return false;
+    }
+    list->items = items;
+    list->capacity = capacity;
+  }
+  
+  list->items[list->count++] = block;
+  return true;
+}
+
+/**
+ * @brief Get the block after another in a preorder walk of a dominator subtree.
+ * 
+ * @param cfg The control flow graph, with the dominator tree.
+ * @param root The root of the subtree.
+ * @param block The current block.
+ * @return The next block, or CFG_NO_BLOCK when the walk is done.
+ */
+static size_t next_in_subtree(const cfg_t* cfg, size_t root, size_t block) {
+  if (cfg->first_child[block] != CFG_NO_BLOCK) {
+    return cfg->first_child[block];
+  }
+  while (block != root && cfg->next_sibling[block] == CFG_NO_BLOCK) {
+    block = cfg->idom[block];
+  }
+  return block == root ? CFG_NO_BLOCK : cfg->next_sibling[block];
+}
+
+/**
+ * @brief Recompute the depths of the blocks below a dominator tree node.
+ * 
+ * @param cfg The control flow graph, with the dominator tree.
+ * @param root The root of the subtree, whose depth is correct.
+ */
+static void update_depths(cfg_t* cfg, size_t root) {
+  for (size_t block = next_in_subtree(cfg, root, root); block != CFG_NO_BLOCK;
+       block = next_in_subtree(cfg, root, block)) {
+    cfg->depth[block] = cfg->depth[cfg->idom[block]] + 1;
+  }
+}
+
+/**
+ * @brief Move a block under a new immediate dominator.
+ * 
+ * @param cfg The control flow graph, with the dominator tree.
+ * @param block The block, which is not the entry block.
+ * @param idom The new immediate dominator.
+ */
+static void set_idom(cfg_t* cfg, size_t block, size_t idom) {
+  if (cfg->idom[block] == idom) {
+    return;
+  }
+  
+  /* Unlink from the old parent's children */
+  if (cfg->idom[block] != CFG_NO_BLOCK) {
+    size_t prev = cfg->prev_sibling[block];
+    size_t next = cfg->next_sibling[block];
+    if (prev != CFG_NO_BLOCK) {
+      cfg->next_sibling[prev] = next;
+    } else {
+      cfg->first_child[cfg->idom[block]] = next;
+    }
+    if (next != CFG_NO_BLOCK) {
+      cfg->prev_sibling[next] = prev;
+    }
+  }
+  
+  cfg->idom[block] = idom;
+  cfg->prev_sibling[block] = CFG_NO_BLOCK;
+  cfg->next_sibling[block] = cfg->first_child[idom];
+  if (cfg->first_child[idom] != CFG_NO_BLOCK) {
+    cfg->prev_sibling[cfg->first_child[idom]] = block;
+  }
+  cfg->first_child[idom] = block;
+}
+
+/**
+ * @brief Find the smallest semidominator on the forest path above a vertex.
+ * 
+ * Compresses the path so later queries are nearly constant time.
+ * 
+ * @param search The search state.
+ * @param v The search number of the vertex.
+ * @return The search number of the vertex with the smallest semidominator.
+ */
+static size_t eval_path(dom_search_t* search, size_t v) {
+  if (search->ancestor[v] == CFG_NO_BLOCK) {
+    return v;
+  }
+  
+  size_t top = 0;
+  size_t u = v;
+  while (search->ancestor[search->ancestor[u]] != CFG_NO_BLOCK) {
+    search->stack[top++] = u;
+    u = search->ancestor[u];
+  }
+  
+  /* Compress from the top of the path down */
+  while (top > 0) {
+    u = search->stack[--top];
+    size_t a = search->ancestor[u];
+    if (search->semi[search->label[a]] < search->semi[search->label[u]]) {
+      search->label[u] = search->label[a];
+    }
+    search->ancestor[u] = search->ancestor[a];
+  }
+  
+  return search->label[v];
+}
+
+/**
+ * @brief Free the search state.
+ * 
+ * @param search The search state.
+ */
+static void free_search(dom_search_t* search) {
+  free(search->vertex);
+  free(search->parent);
+  free(search->semi);
+  free(search->label);
+  free(search->ancestor);
+  free(search->stack);
+  free(search->cursor);
+}
+
+/**
+ * @brief Compute the dominator tree below a block with Semi-NCA.
+ * 
+ * Searches the graph from the root, entering only blocks that are already
+ * in the root's subtree when restricted, then computes semidominators with
+ * path compression and takes each immediate dominator as the nearest common
+ * ancestor of the search tree parent and the semidominator. Every block
+ * reached is linked under its immediate dominator.
+ * 
+ * @param cfg The control flow graph, with the root placed in the tree.
+ * @param root The root block.
+ * @param limit The most blocks the search can reach.
+ * @param restricted Whether to stay inside the root's current subtree.
+ * @param reached Where to store the number of blocks reached.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool semi_nca(cfg_t* cfg, size_t root, size_t limit, bool restricted, size_t* reached) {
+  dom_search_t search;
+  search.vertex = (size_t*)malloc((limit + 1) * sizeof(size_t));
+  search.parent = (size_t*)malloc((limit + 1) * sizeof(size_t));
+  search.semi = (size_t*)malloc((limit + 1) * sizeof(size_t));
+  search.label = (size_t*)malloc((limit + 1) * sizeof(size_t));
+  search.ancestor = (size_t*)malloc((limit + 1) * sizeof(size_t));
+  search.stack = (size_t*)malloc((limit + 1) * sizeof(size_t));
+  search.cursor = (size_t*)malloc((limit + 1) * sizeof(size_t));
+  
+  if (search.vertex == NULL || search.parent == NULL || search.semi == NULL ||
+      search.label == NULL || search.ancestor == NULL || search.stack == NULL ||
+      search.cursor == NULL) {
+    free_search(&search);
+    return false;
+  }
+  
+  /* Preorder numbering from the root */
+  size_t level = cfg->depth[root];
+  size_t count = 1;
+  size_t top = 1;
+  cfg->dfs_number[root] = 0;
+  search.vertex[0] = root;
+  search.parent[0] = CFG_NO_BLOCK;
+  search.cursor[0] = 0;
+  search.stack[0] = 0;
+  
+  while (top > 0) {
+    size_t v = search.stack[top - 1];
+    size_t block = search.vertex[v];
+    if (search.cursor[v] == cfg->succ_counts[block]) {
+      top--;
+      continue;
+    }
+    
+    size_t succ = cfg->succs[2 * block + search.cursor[v]++];
+    if (cfg->dfs_number[succ] != CFG_NO_BLOCK ||
+        (restricted && (cfg->idom[succ] == CFG_NO_BLOCK || cfg->depth[succ] <= level))) {
+      continue;
+    }
+    
+    assert(count < limit);
+    cfg->dfs_number[succ] = count;
+    search.vertex[count] = succ;
+    search.parent[count] = v;
+    search.cursor[count] = 0;
+    search.stack[top++] = count++;
+  }
+  
+  /* Semidominators, in reverse preorder */
+  for (size_t v = 0; v < count; v++) {
+    search.semi[v] = v;
+    search.label[v] = v;
+    search.ancestor[v] = CFG_NO_BLOCK;
+  }
+  for (size_t w = count; w-- > 1;) {
+    size_t block = search.vertex[w];
+    for (size_t p = 0; p < cfg->pred_counts[block]; p++) {
+      size_t v = cfg->dfs_number[cfg->preds[cfg->pred_start[block] + p]];
+      if (v == CFG_NO_BLOCK) {
+        continue;
+      }
+      
+      size_t u = eval_path(&search, v);
+      if (search.semi[u] < search.semi[w]) {
+        search.semi[w] = search.semi[u];
+      }
+    }
+    search.ancestor[w] = search.parent[w];
+  }
+  
+  /* Immediate dominators: the nearest ancestor at or above the semidominator */
+  search.ancestor[0] = 0;
+  for (size_t w = 1; w < count; w++) {
+    size_t x = search.parent[w];
+    while (x > search.semi[w]) {
+      x = search.ancestor[x];
+    }
+    search.ancestor[w] = x;
+  }
+  
+  for (size_t w = 1; w < count; w++) {
+    set_idom(cfg, search.vertex[w], search.vertex[search.ancestor[w]]);
+  }
+  for (size_t w = 0; w < count; w++) {
+    cfg->dfs_number[search.vertex[w]] = CFG_NO_BLOCK;
+  }
+  update_depths(cfg, root);
+  
+  free_search(&search);
+  *reached = count;
+  return true;
+}
+
+bool cfg_compute_dominators(cfg_t* cfg) {
+  assert(cfg != NULL);
+  
+  size_t n = cfg->block_count;
+  free_derived(cfg);
+  if (cfg->idom == NULL) {
+    cfg->idom = (size_t*)malloc((n + 1) * sizeof(size_t));
+    cfg->depth = (size_t*)malloc((n + 1) * sizeof(size_t));
+    cfg->first_child = (size_t*)malloc((n + 1) * sizeof(size_t));
+    cfg->next_sibling = (size_t*)malloc((n + 1) * sizeof(size_t));
+    cfg->prev_sibling = (size_t*)malloc((n + 1) * sizeof(size_t));
+    cfg->dfs_number = (size_t*)malloc((n + 1) * sizeof(size_t));
+    
+    if (cfg->idom == NULL || cfg->depth == NULL || cfg->first_child == NULL ||
+        cfg->next_sibling == NULL || cfg->prev_sibling == NULL || cfg->dfs_number == NULL) {
+      free_dominators(cfg);
+      return false;
+    }
+  }
+  
+  for (size_t i = 0; i < n; i++) {
+    cfg->idom[i] = CFG_NO_BLOCK;
+    cfg->depth[i] = CFG_NO_BLOCK;
+    cfg->first_child[i] = CFG_NO_BLOCK;
+    cfg->next_sibling[i] = CFG_NO_BLOCK;
+    cfg->prev_sibling[i] = CFG_NO_BLOCK;
+    cfg->dfs_number[i] = CFG_NO_BLOCK;
+  }
+  if (n == 0) {
+    return true;
+  }
+  
+  cfg->idom[0] = 0;
+  cfg->depth[0] = 0;
+  size_t reached;
+  if (!semi_nca(cfg, 0, n, false, &reached)) {
+    free_dominators(cfg);
+    return false;
+  }
+  return true;
+}
+
+bool cfg_is_reachable(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->idom != NULL && block < cfg->block_count);
+  
+  return cfg->idom[block] != CFG_NO_BLOCK;
+}
+
+int32_t cfg_immediate_dominator(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->idom != NULL && block < cfg->block_count);
+  
+  if (block == 0 || cfg->idom[block] == CFG_NO_BLOCK) {
+    return -1;
+  }
+  return (int32_t)cfg->idom[block];
+}
+
+bool cfg_dominates(const cfg_t* cfg, size_t a, size_t b) {
+  assert(cfg != NULL && cfg->idom != NULL);
+  assert(a < cfg->block_count && b < cfg->block_count);
+  
+  if (cfg->idom[a] == CFG_NO_BLOCK || cfg->idom[b] == CFG_NO_BLOCK) {
+    return false;
+  }
+  
+  while (cfg->depth[b] > cfg->depth[a]) {
+    b = cfg->idom[b];
+  }
+  return a == b;
+}
+
+size_t cfg_dominator_depth(const cfg_t* cfg, size_t block) {
+  assert(cfg_is_reachable(cfg, block));
+  
+  return cfg->depth[block];
+}
+
+int32_t cfg_dominator_child(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->idom != NULL && block < cfg->block_count);
+  
+  return cfg->first_child[block] == CFG_NO_BLOCK ? -1 : (int32_t)cfg->first_child[block];
+}
+
+int32_t cfg_dominator_sibling(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->idom != NULL && block < cfg->block_count);
+  
+  return cfg->next_sibling[block] == CFG_NO_BLOCK ? -1 : (int32_t)cfg->next_sibling[block];
+}
+
+size_t cfg_common_dominator(const cfg_t* cfg, size_t a, size_t b) {
+  assert(cfg_is_reachable(cfg, a) && cfg_is_reachable(cfg, b));
+  
+  while (cfg->depth[a] > cfg->depth[b]) {
+    a = cfg->idom[a];
+  }
+  while (cfg->depth[b] > cfg->depth[a]) {
+    b = cfg->idom[b];
+  }
+  while (a != b) {
+    a = cfg->idom[a];
+    b = cfg->idom[b];
+  }
+  return a;
+}
+
+/**
+ * @brief Update the dominator tree after an edge between reachable blocks was added.
+ * 
+ * A block is affected when it lies deeper than one level below the nearest
+ * common dominator of the edge and a path from the target reaches it
+ * without passing anything shallower than itself. Affected blocks are
+ * found deepest first with a bucket search and all move directly under
+ * the common dominator.
+ * 
+ * @param cfg The control flow graph, with the dominator tree.
+ * @param to The target of the new edge.
+ * @param nca The nearest common dominator of the edge's blocks.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool insert_reachable(cfg_t* cfg, size_t to, size_t nca) {
+  size_t level = cfg->depth[nca] + 1;
+  block_list_t heap = { NULL, 0, 0 };
+  block_list_t affected = { NULL, 0, 0 };
+  block_list_t pending = { NULL, 0, 0 };
+  block_list_t visited = { NULL, 0, 0 };
+  
+  bool success = push_block(&heap, to) && push_block(&visited, to);
+  cfg->dfs_number[to] = 0;
+  
+  while (success && heap.count > 0) {
+    /* Pop the deepest block */
+    size_t block = heap.items[0];
+    size_t last = heap.items[--heap.count];
+    size_t hole = 0;
+    while (2 * hole + 1 < heap.count) {
+      size_t child = 2 * hole + 1;
+      if (child + 1 < heap.count &&
+          cfg->depth[heap.items[child + 1]] > cfg->depth[heap.items[child]]) {
+        child++;
+      }
+      if (cfg->depth[heap.items[child]] <= cfg->depth[last]) {
+        break;
+      }
+      heap.items[hole] = heap.items[child];
+      hole = child;
+    }
+    if (heap.count > 0) {
+      heap.items[hole] = last;
+    }
+    
+    success = push_block(&affected, block);
+    size_t current = cfg->depth[block];
+    
+    /* Blocks deeper than the current one are searched through, not affected */
+    while (success) {
+      for (size_t s = 0; s < cfg->succ_counts[block] && success; s++) {
+        size_t succ = cfg->succs[2 * block + s];
+        if (cfg->depth[succ] <= level || cfg->dfs_number[succ] != CFG_NO_BLOCK) {
+          continue;
+        }
+        
+        cfg->dfs_number[succ] = 0;
+        success = push_block(&visited, succ);
+        if (success && cfg->depth[succ] > current) {
+          success = push_block(&pending, succ);
+        } else if (success) {
+          /* Sift up */
+          success = push_block(&heap, succ);
+          size_t i = heap.count - 1;
+          while (success && i > 0 &&
+                 cfg->depth[heap.items[(i - 1) / 2]] < cfg->depth[succ]) {
+            heap.items[i] = heap.items[(i - 1) / 2];
+            i = (i - 1) / 2;
+          }
+          if (success) {
+            heap.items[i] = succ;
+          }
+        }
+      }
+      
+      if (pending.count == 0) {
+        break;
+      }
+      block = pending.items[--pending.count];
+    }
+  }
+  
+  for (size_t i = 0; i < visited.count; i++) {
+    cfg->dfs_number[visited.items[i]] = CFG_NO_BLOCK;
+  }
+  
+  if (success) {
+    for (size_t i = 0; i < affected.count; i++) {
+      set_idom(cfg, affected.items[i], nca);
+    }
+    for (size_t i = 0; i < affected.count; i++) {
+      cfg->depth[affected.items[i]] = level;
+      update_depths(cfg, affected.items[i]);
+    }
+  }
+  
+  free(heap.items);
+  free(affected.items);
+  free(pending.items);
+  free(visited.items);
+  return success;
+}
+
+/**
+ * @brief Update the dominator tree after an edge between reachable blocks was removed.
+ * 
+ * Only blocks below the nearest common dominator of the edge can change,
+ * so that subtree is rebuilt on its own. When a block of it became
+ * unreachable the whole tree is recomputed.
+ * 
+ * @param cfg The control flow graph, with the dominator tree from before the removal.
+ * @param nca The nearest common dominator of the edge's blocks.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool remove_reachable(cfg_t* cfg, size_t nca) {
+  size_t size = 0;
+  for (size_t block = nca; block != CFG_NO_BLOCK; block = next_in_subtree(cfg, nca, block)) {
+    size++;
+  }
+  
+  size_t reached = 0;
+  if (!semi_nca(cfg, nca, size, true, &reached)) {
+    free_dominators(cfg);
+    return false;
+  }
+  
+  return reached == size || cfg_compute_dominators(cfg);
+}
+
+bool cfg_insert_edge(cfg_t* cfg, size_t from, size_t to) {
+  assert(cfg != NULL && from < cfg->block_count && to < cfg->block_count);
+  assert(cfg->succ_counts[from] < 2);
+  assert(cfg->succ_counts[from] == 0 || cfg->succs[2 * from] != to);
+  
+  /* Move the predecessor list to the end of the pool when it is full */
+  if (cfg->pred_counts[to] == cfg->pred_caps[to]) {
+    size_t capacity = cfg->pred_caps[to] == 0 ? 4 : cfg->pred_caps[to] * 2;
+    if (cfg->pred_used + capacity > cfg->pred_capacity) {
+      size_t pool = cfg->pred_capacity * 2;
+      if (pool < cfg->pred_used + capacity) {
+        pool = cfg->pred_used + capacity;
+      }
+      size_t* preds = (size_t*)realloc(cfg->preds, pool * sizeof(size_t));
+      if (preds == NULL) {
+        return false;
+      }
+      cfg->preds = preds;
+      cfg->pred_capacity = pool;
+    }
+    
+    memcpy(&cfg->preds[cfg->pred_used], &cfg->preds[cfg->pred_start[to]],
+           cfg->pred_counts[to] * sizeof(size_t));
+    cfg->pred_start[to] = cfg->pred_used;
+    cfg->pred_caps[to] = capacity;
+    cfg->pred_used += capacity;
+  }
+  
+  cfg->succs[2 * from + cfg->succ_counts[from]++] = to;
+  cfg->preds[cfg->pred_start[to] + cfg->pred_counts[to]++] = from;
+  
+  if (cfg->idom == NULL) {
+    return true;
+  }
+  free_derived(cfg);
+  
+  /* Edges from unreachable blocks change nothing; new reachable blocks need a full pass */
+  if (cfg->idom[from] == CFG_NO_BLOCK) {
+    return true;
+  }
+  if (cfg->idom[to] == CFG_NO_BLOCK) {
+    return cfg_compute_dominators(cfg);
+  }
+  
+  size_t nca = cfg_common_dominator(cfg, from, to);
+  if (nca == to || nca == cfg->idom[to]) {
+    return true;
+  }
+  if (!insert_reachable(cfg, to, nca)) {
+    free_dominators(cfg);
+    return false;
+  }
+  return true;
+}
+
+bool cfg_remove_edge(cfg_t* cfg, size_t from, size_t to) {
+  assert(cfg != NULL && from < cfg->block_count && to < cfg->block_count);
+  
+  size_t s = 0;
+  while (s < cfg->succ_counts[from] && cfg->succs[2 * from + s] != to) {
+    s++;
+  }
+  assert(s < cfg->succ_counts[from]);
+  for (; s + 1 < cfg->succ_counts[from]; s++) {
+    cfg->succs[2 * from + s] = cfg->succs[2 * from + s + 1];
+  }
+  cfg->succ_counts[from]--;
+  
+  size_t* preds = &cfg->preds[cfg->pred_start[to]];
+  size_t p = 0;
+  while (preds[p] != from) {
+    p++;
+  }
+  memmove(&preds[p], &preds[p + 1], (cfg->pred_counts[to] - p - 1) * sizeof(size_t));
+  cfg->pred_counts[to]--;
+  
+  if (cfg->idom == NULL) {
+    return true;
+  }
+  free_derived(cfg);
+  
+  /* Removing an edge from an unreachable block or a back edge changes no dominator */
+  if (cfg->idom[from] == CFG_NO_BLOCK || cfg_dominates(cfg, to, from)) {
+    return true;
+  }
+  return remove_reachable(cfg, cfg_common_dominator(cfg, from, to));
+}
+
+bool cfg_compute_frontiers(cfg_t* cfg) {
+  assert(cfg != NULL && cfg->idom != NULL);
+  
+  size_t n = cfg->block_count;
+  free(cfg->frontier_start);
+  free(cfg->frontiers);
+  cfg->frontier_start = (size_t*)calloc(n + 1, sizeof(size_t));
+  cfg->frontiers = NULL;
+  size_t* mark = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* fill = (size_t*)malloc((n + 1) * sizeof(size_t));
+  
+  bool success = cfg->frontier_start != NULL && mark != NULL && fill != NULL;
+  
+  /*
+   * A join block is in the frontier of every block on the dominator tree
+   * path from each predecessor up to, but excluding, its immediate dominator.
+   * The first pass counts, the second fills.
+   */
+  for (int pass = 0; pass < 2 && success; pass++) {
+    for (size_t i = 0; i < n; i++) {
+      mark[i] = CFG_NO_BLOCK;
+    }
+    
+    for (size_t block = 0; block < n; block++) {
+      if (cfg->idom[block] == CFG_NO_BLOCK || (block != 0 && cfg->pred_counts[block] < 2)) {
+        continue;
+      }
+      
+      /* The entry block has an implicit edge in and no immediate dominator to stop at */
+      size_t stop = block == 0 ? CFG_NO_BLOCK : cfg->idom[block];
+      for (size_t p = 0; p < cfg->pred_counts[block]; p++) {
+        size_t runner = cfg->preds[cfg->pred_start[block] + p];
+        if (cfg->idom[runner] == CFG_NO_BLOCK) {
+          continue;
+        }
+        
+        while (runner != stop && mark[runner] != block) {
+          mark[runner] = block;
+          if (pass == 0) {
+            cfg->frontier_start[runner + 1]++;
+          } else {
+            cfg->frontiers[fill[runner]++] = block;
+          }
+          if (runner == 0) {
+            break;
+          }
+          runner = cfg->idom[runner];
+        }
+      }
+    }
+    
+    if (pass == 0) {
+      for (size_t i = 0; i < n; i++) {
+        cfg->frontier_start[i + 1] += cfg->frontier_start[i];
+      }
+      cfg->frontiers = (size_t*)malloc((cfg->frontier_start[n] + 1) * sizeof(size_t));
+      success = cfg->frontiers != NULL;
+      if (success) {
+        memcpy(fill, cfg->frontier_start, (n + 1) * sizeof(size_t));
+      }
+    }
+  }
+  
+  free(mark);
+  free(fill);
+  
+  if (!success) {
+    free(cfg->frontier_start);
+    free(cfg->frontiers);
+    cfg->frontier_start = NULL;
+    cfg->frontiers = NULL;
+  }
+  
+  return success;
+}
+
+size_t cfg_frontier_count(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->frontier_start != NULL && block < cfg->block_count);
+  
+  return cfg->frontier_start[block + 1] - cfg->frontier_start[block];
+}
+
+size_t cfg_get_frontier(const cfg_t* cfg, size_t block, size_t index) {
+  assert(index < cfg_frontier_count(cfg, block));
+  
+  return cfg->frontiers[cfg->frontier_start[block] + index];
+}
+
+/**
+ * @brief Find the outermost loop discovered so far that contains a loop.
+ * 
+ * @param outer Union-find parents over loop numbers.
+ * @param loop The loop number.
+ * @return The outermost loop number.
+ */
+static size_t find_outer(size_t* outer, size_t loop) {
+  while (outer[loop] != loop) {
+    outer[loop] = outer[outer[loop]];
+    loop = outer[loop];
+  }
+  return loop;
+}
+
+bool cfg_compute_loops(cfg_t* cfg) {
+  assert(cfg != NULL && cfg->idom != NULL);
+  
+  size_t n = cfg->block_count;
+  free(cfg->loop_headers);
+  free(cfg->loop_parents);
+  free(cfg->loop_depths);
+  free(cfg->block_loops);
+  cfg->loop_count = 0;
+  cfg->loop_headers = (size_t*)malloc((n + 1) * sizeof(size_t));
+  cfg->loop_parents = (size_t*)malloc((n + 1) * sizeof(size_t));
+  cfg->loop_depths = (size_t*)malloc((n + 1) * sizeof(size_t));
+  cfg->block_loops = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* outer = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* order = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* pre = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* last = (size_t*)malloc((n + 1) * sizeof(size_t));
+  size_t* stack = (size_t*)malloc((2 * n + cfg->pred_used + 1) * sizeof(size_t));
+  
+  if (cfg->loop_headers == NULL || cfg->loop_parents == NULL || cfg->loop_depths == NULL ||
+      cfg->block_loops == NULL || outer == NULL || order == NULL || pre == NULL ||
+      last == NULL || stack == NULL) {
+    free_derived(cfg);
+    free(outer);
+    free(order);
+    free(pre);
+    free(last);
+    free(stack);
+    return false;
+  }
+  
+  /*
+   * Number the dominator tree in preorder; a block dominates exactly the
+   * blocks numbered from its own number through the last of its subtree.
+   */
+  size_t count = 0;
+  for (size_t i = 0; i < n; i++) {
+    cfg->block_loops[i] = CFG_NO_BLOCK;
+  }
+  for (size_t block = 0; n > 0 && block != CFG_NO_BLOCK; block = next_in_subtree(cfg, 0, block)) {
+    pre[block] = count;
+    last[block] = count;
+    order[count++] = block;
+  }
+  for (size_t k = count; k-- > 1;) {
+    size_t idom = cfg->idom[order[k]];
+    last[idom] = last[order[k]] > last[idom] ? last[order[k]] : last[idom];
+  }
+  
+  /*
+   * A header dominates one of its predecessors. Headers are visited in
+   * reverse preorder, so inner loops come before the loops around them. A
+   * body is found by walking back from the latches; blocks already in an
+   * inner loop stand for the outermost loop around them, which becomes a
+   * child of the new loop.
+   */
+  for (size_t k = count; k-- > 0;) {
+    size_t header = order[k];
+    size_t top = 0;
+    for (size_t p = 0; p < cfg->pred_counts[header]; p++) {
+      size_t pred = cfg->preds[cfg->pred_start[header] + p];
+      if (cfg->idom[pred] != CFG_NO_BLOCK && pre[pred] >= k && pre[pred] <= last[header]) {
+        stack[top++] = pred;
+      }
+    }
+    if (top == 0) {
+      continue;
+    }
+    
+    size_t loop = cfg->loop_count++;
+    cfg->loop_headers[loop] = header;
+    cfg->loop_parents[loop] = CFG_NO_BLOCK;
+    outer[loop] = loop;
+    cfg->block_loops[header] = loop;
+    
+    while (top > 0) {
+      size_t block = stack[--top];
+      if (cfg->block_loops[block] == CFG_NO_BLOCK) {
+        cfg->block_loops[block] = loop;
+      } else {
+        size_t inner = find_outer(outer, cfg->block_loops[block]);
+        if (inner == loop) {
+          continue;
+        }
+        cfg->loop_parents[inner] = loop;
+        outer[inner] = loop;
+        block = cfg->loop_headers[inner];
+      }
+      
+      for (size_t p = 0; p < cfg->pred_counts[block]; p++) {
+        size_t pred = cfg->preds[cfg->pred_start[block] + p];
+        if (cfg->idom[pred] != CFG_NO_BLOCK) {
+          stack[top++] = pred;
+        }
+      }
+    }
+  }
+  
+  /* Parents are numbered after their children */
+  for (size_t loop = cfg->loop_count; loop-- > 0;) {
+    size_t parent = cfg->loop_parents[loop];
+    cfg->loop_depths[loop] = parent == CFG_NO_BLOCK ? 1 : cfg->loop_depths[parent] + 1;
+  }
+  
+  free(outer);
+  free(order);
+  free(pre);
+  free(last);
+  free(stack);
+  return true;
+}
+
+size_t cfg_loop_count(const cfg_t* cfg) {
+  assert(cfg != NULL && cfg->loop_headers != NULL);
+  
+  return cfg->loop_count;
+}
+
+size_t cfg_loop_header(const cfg_t* cfg, size_t loop) {
+  assert(loop < cfg_loop_count(cfg));
+  
+  return cfg->loop_headers[loop];
+}
+
+int32_t cfg_loop_parent(const cfg_t* cfg, size_t loop) {
+  assert(loop < cfg_loop_count(cfg));
+  
+  return cfg->loop_parents[loop] == CFG_NO_BLOCK ? -1 : (int32_t)cfg->loop_parents[loop];
+}
+
+size_t cfg_loop_depth(const cfg_t* cfg, size_t loop) {
+  assert(loop < cfg_loop_count(cfg));
+  
+  return cfg->loop_depths[loop];
+}
+
+int32_t cfg_block_loop(const cfg_t* cfg, size_t block) {
+  assert(cfg != NULL && cfg->block_loops != NULL && block < cfg->block_count);
+  
+  return cfg->block_loops[block] == CFG_NO_BLOCK ? -1 : (int32_t)cfg->block_loops[block];
+}
+
+bool cfg_loop_contains(const cfg_t* cfg, size_t loop, size_t block) {
+  assert(loop < cfg_loop_count(cfg) && block < cfg->block_count);
+  
+  for (size_t l = cfg->block_loops[block]; l != CFG_NO_BLOCK; l = cfg->loop_parents[l]) {
+    if (l == loop) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -9,6 +9,10 @@
  */
 
 #include "../include/codegen.h"
+#include "../include/callgraph.h"
+#include "../include/effects.h"
+#include "../include/eval.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -21,6 +25,14 @@ typedef struct {
   uint8_t opcode;      /**< COIL opcode. */
 } instruction_mapping_t;
 
+/**
+ * @brief Local variable to register mapping.
+ */
+typedef struct {
+  const char* name;    /**< Variable name. */
+  uint8_t reg;         /**< Assigned register. */
+} local_register_t;
+
 /**
  * @brief Code generator context structure.
  */
@@ -28,10 +40,13 @@ struct codegen_context {
   error_context_t* error_ctx;      /**< Error context. */
   symbol_table_t* symbol_table;    /**< Global symbol table. */
   coil_builder_t* builder;         /**< COIL binary builder. */
+  ast_node_t* module;              /**< Module being generated. */
+  callgraph_t* callgraph;          /**< Call graph of the module, numbering its functions. */
   
   /* State tracking */
   symbol_table_t* current_symtable; /**< Current symbol table. */
-  int32_t* local_regs;              /**< Local register mappings. */
+  ast_node_t* current_function;    /**< Function being generated, whose blocks branches index. */
+  local_register_t* local_regs;     /**< Local register mappings. */
   size_t local_reg_count;          /**< Number of local registers. */
   size_t local_reg_capacity;       /**< Capacity of local registers array. */
   uint8_t next_reg;                /**< Next available register number. */
@@ -51,6 +66,11 @@ static const instruction_mapping_t instruction_map[] = {
   { "MIN", OPCODE_MIN },
   { "MAX", OPCODE_MAX },
   { "FMA", OPCODE_FMA },
+  { "MULH", OPCODE_MULH },
+  { "ADD_WIDE", OPCODE_ADD_WIDE },
+  { "MUL_WIDE", OPCODE_MUL_WIDE },
+  { "ADD_SAT", OPCODE_ADD_SAT },
+  { "SUB_SAT", OPCODE_SUB_SAT },
   
   { "AND", OPCODE_AND },
   { "OR",  OPCODE_OR },
@@ -58,6 +78,12 @@ static const instruction_mapping_t instruction_map[] = {
   { "NOT", OPCODE_NOT },
   { "SHL", OPCODE_SHL },
   { "SHR", OPCODE_SHR },
+  { "POPCNT", OPCODE_POPCNT },
+  { "CLZ", OPCODE_CLZ },
+  { "CTZ", OPCODE_CTZ },
+  { "BSWAP", OPCODE_BSWAP },
+  { "ROTL", OPCODE_ROTL },
+  { "ROTR", OPCODE_ROTR },
   
   { "CMP_EQ", OPCODE_CMP_EQ },
   { "CMP_NE", OPCODE_CMP_NE },
@@ -70,6 +96,19 @@ static const instruction_mapping_t instruction_map[] = {
   { "STORE", OPCODE_STORE },
   { "LEA", OPCODE_LEA },
   { "FENCE", OPCODE_FENCE },
+  { "ATOMIC_LOAD", OPCODE_ATOMIC_LOAD },
+  { "ATOMIC_STORE", OPCODE_ATOMIC_STORE },
+  { "ATOMIC_RMW", OPCODE_ATOMIC_RMW },
+  { "CMPXCHG", OPCODE_CMPXCHG },
+  { "PREFETCH", OPCODE_PREFETCH },
+  
+  { "SPLAT", OPCODE_SPLAT },
+  { "EXTRACT", OPCODE_EXTRACT },
+  { "INSERT", OPCODE_INSERT },
+  { "SHUFFLE", OPCODE_SHUFFLE },
+  { "REDUCE_ADD", OPCODE_REDUCE_ADD },
+  { "REDUCE_MIN", OPCODE_REDUCE_MIN },
+  { "REDUCE_MAX", OPCODE_REDUCE_MAX },
   
   { "BR", OPCODE_BR },
   { "BR_COND", OPCODE_BR_COND },
@@ -87,7 +126,12 @@ static bool codegen_module(codegen_context_t* context, ast_node_t* module);
 static bool codegen_type_def(codegen_context_t* context, ast_node_t* type_def);
 static bool codegen_constant(codegen_context_t* context, ast_node_t* constant);
 static bool codegen_global(codegen_context_t* context, ast_node_t* global);
+static bool codegen_target(codegen_context_t* context, ast_node_t* target);
 static bool codegen_function(codegen_context_t* context, ast_node_t* function);
+static int32_t codegen_add_function(codegen_context_t* context, ast_node_t* function, const char* name, bool dispatch);
+static bool codegen_function_body(codegen_context_t* context, ast_node_t* function, int32_t function_index);
+static bool codegen_function_code(codegen_context_t* context, ast_node_t* function, effects_t* effects);
+static bool codegen_versions(codegen_context_t* context, ast_node_t* function, effects_t* effects);
 static bool codegen_extern_function(codegen_context_t* context, ast_node_t* extern_function);
 static bool codegen_block(codegen_context_t* context, ast_node_t* block, int32_t function_index);
 static bool codegen_statement(codegen_context_t* context, ast_node_t* statement, int32_t function_index);
@@ -96,6 +140,7 @@ static bool codegen_instruction(codegen_context_t* context, ast_node_t* instruct
 static bool codegen_branch(codegen_context_t* context, ast_node_t* branch, int32_t function_index);
 static bool codegen_return(codegen_context_t* context, ast_node_t* ret, int32_t function_index);
 static uint8_t codegen_expr(codegen_context_t* context, ast_node_t* expr, int32_t function_index);
+static bool codegen_call(codegen_context_t* context, ast_node_t* call, int32_t function_index, uint8_t destination);
 
 codegen_context_t* codegen_create_context(error_context_t* error_ctx,
                                          symbol_table_t* symbol_table) {
@@ -116,7 +161,10 @@ codegen_context_t* codegen_create_context(error_context_t* error_ctx,
     return NULL;
   }
   
+  context->module = NULL;
+  context->callgraph = NULL;
   context->current_symtable = NULL;
+  context->current_function = NULL;
   context->local_regs = NULL;
   context->local_reg_count = 0;
   context->local_reg_capacity = 0;
@@ -131,6 +179,7 @@ void codegen_destroy_context(codegen_context_t* context) {
   }
   
   coil_builder_destroy(context->builder);
+  callgraph_destroy(context->callgraph);
   free(context->local_regs);
   free(context);
 }
@@ -217,9 +266,21 @@ int32_t codegen_map_type(codegen_context_t* context, ast_node_t* type_node) {
         return -1;
       }
       
+      /* The memory space is stored plus one, leaving 0 for generic pointers */
+      int32_t space = -1;
+      if (type_node->data.type_ptr.memory_space != NULL) {
+        space = coil_lookup_memory_space(type_node->data.type_ptr.memory_space);
+        if (space < 0) {
+          error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, type_node,
+                               "Unknown memory space: %s", type_node->data.type_ptr.memory_space);
+          return -1;
+        }
+      }
+      
       /* Create a pointer type encoding */
       type_encoding_t encoding = coil_create_type_encoding(
-        TYPE_POINTER, 64, 0, 0
+        TYPE_POINTER, 64, type_node->data.type_ptr.is_restrict ? QUALIFIER_RESTRICT : 0,
+        (uint16_t)(space + 1)
       );
       
       /* Add the pointer type */
@@ -240,9 +301,50 @@ int32_t codegen_map_type(codegen_context_t* context, ast_node_t* type_node) {
         return -1;
       }
       
+      /* The element category and lane count share the attributes */
+      ast_node_t* element = type_node->data.type_vec.element_type;
+      type_category_t category;
+      uint8_t width;
+      uint8_t qualifiers = 0;
+      switch (element->type) {
+        case AST_TYPE_BOOL:
+          category = TYPE_BOOLEAN;
+          width = 1;
+          break;
+          
+        case AST_TYPE_INT:
+          category = TYPE_INTEGER;
+          width = (uint8_t)element->data.type_int.bits;
+          qualifiers = element->data.type_int.is_signed ? 0 : QUALIFIER_UNSIGNED;
+          break;
+          
+        case AST_TYPE_FLOAT:
+          category = TYPE_FLOAT;
+          width = (uint8_t)element->data.type_float.bits;
+          break;
+          
+        case AST_TYPE_PTR:
+          category = TYPE_POINTER;
+          width = 64;
+          break;
+          
+        default:
+          error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, type_node,
+                               "Unsupported vector element type");
+          return -1;
+      }
+      
+      if (type_node->data.type_vec.size == 0 || type_node->data.type_vec.size > 0xFF) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, type_node,
+                             "Unsupported vector lane count: %u", 
+                             type_node->data.type_vec.size);
+        return -1;
+      }
+      
       /* Create a vector type encoding */
       type_encoding_t encoding = coil_create_type_encoding(
-        TYPE_VECTOR, 0, 0, (uint16_t)type_node->data.type_vec.size
+        TYPE_VECTOR, width, qualifiers,
+        (uint16_t)(((uint16_t)category << 8) | type_node->data.type_vec.size)
       );
       
       /* Add the vector type */
@@ -416,8 +518,7 @@ int32_t codegen_map_type(codegen_context_t* context, ast_node_t* type_node) {
   }
 }
 
-uint8_t codegen_map_instruction(codegen_context_t* context, const char* instruction) {
-  assert(context != NULL);
+uint8_t codegen_lookup_opcode(const char* instruction) {
   assert(instruction != NULL);
   
   for (int i = 0; instruction_map[i].name != NULL; i++) {
@@ -426,6 +527,18 @@ uint8_t codegen_map_instruction(codegen_context_t* context, const char* instruct
     }
   }
   
+  return 0;
+}
+
+uint8_t codegen_map_instruction(codegen_context_t* context, const char* instruction) {
+  assert(context != NULL);
+  assert(instruction != NULL);
+  
+  uint8_t opcode = codegen_lookup_opcode(instruction);
+  if (opcode != 0) {
+    return opcode;
+  }
+  
   error_report(context->error_ctx, HOILC_ERROR_INTERNAL,
                "Unknown instruction: %s", instruction);
   return 0;
@@ -519,8 +632,8 @@ static uint8_t add_local_register(codegen_context_t* context, const char* name)
   /* Check if we need to resize the local registers array */
   if (context->local_reg_count >= context->local_reg_capacity) {
     size_t new_capacity = context->local_reg_capacity == 0 ? 16 : context->local_reg_capacity * 2;
-    int32_t* new_regs = (int32_t*)realloc(
-      context->local_regs, new_capacity * sizeof(int32_t)
+    local_register_t* new_regs = (local_register_t*)realloc(
+      context->local_regs, new_capacity * sizeof(local_register_t)
     );
     
     if (new_regs == NULL) {
@@ -542,7 +655,7 @@ static uint8_t add_local_register(codegen_context_t* context, const char* name)
     return 0xFF;
   }
   
-  /* Store the register number in the symbol table entry */
+  /* The variable must be declared in the current scope */
   symbol_entry_t* entry = symtable_lookup(context->current_symtable, name, false);
   if (entry == NULL) {
     error_report(context->error_ctx, HOILC_ERROR_INTERNAL,
@@ -550,7 +663,9 @@ static uint8_t add_local_register(codegen_context_t* context, const char* name)
     return 0xFF;
   }
   
-  context->local_regs[context->local_reg_count++] = reg;
+  context->local_regs[context->local_reg_count].name = symtable_get_name(entry);
+  context->local_regs[context->local_reg_count].reg = reg;
+  context->local_reg_count++;
   
   return reg;
 }
@@ -566,12 +681,15 @@ static uint8_t find_local_register(codegen_context_t* context, const char* name)
   assert(context != NULL);
   assert(name != NULL);
   
-  /* Look up the symbol */
+  /* Look up the symbol; locals are declared by their first assignment */
   symbol_entry_t* entry = symtable_lookup(context->current_symtable, name, true);
   if (entry == NULL) {
-    error_report(context->error_ctx, HOILC_ERROR_INTERNAL,
-                 "Symbol not found: %s", name);
-    return 0xFF;
+    entry = symtable_add(context->current_symtable, name, SYMBOL_LOCAL, NULL);
+    if (entry == NULL) {
+      error_report(context->error_ctx, HOILC_ERROR_INTERNAL,
+                   "Symbol not found: %s", name);
+      return 0xFF;
+    }
   }
   
   /* Check if it's a local variable */
@@ -584,12 +702,8 @@ static uint8_t find_local_register(codegen_context_t* context, const char* name)
   
   /* Find the register number */
   for (size_t i = 0; i < context->local_reg_count; i++) {
-    if (context->local_regs[i] != 0xFF) {
-      /* Find the entry in the symbol table */
-      const char* sym_name = symtable_get_name(entry);
-      if (strcmp(sym_name, name) == 0) {
-        return (uint8_t)context->local_regs[i];
-      }
+    if (strcmp(context->local_regs[i].name, name) == 0) {
+      return context->local_regs[i].reg;
     }
   }
   
@@ -597,6 +711,59 @@ static uint8_t find_local_register(codegen_context_t* context, const char* name)
   return add_local_register(context, name);
 }
 
+/**
+ * @brief Find the COIL index of a module-level declaration.
+ * 
+ * Functions and external functions share the function index space, while
+ * constants and globals share the global index space. Indices follow
+ * declaration order, matching the order in which the builder assigns them.
+ * 
+ * @param context The code generator context.
+ * @param name The declaration name.
+ * @param function Whether to search the function index space.
+ * @return The declaration index, or -1 if not found.
+ */
+static int32_t find_declaration_index(codegen_context_t* context, const char* name, 
+                                      bool function) {
+  assert(context != NULL);
+  assert(context->module != NULL);
+  assert(name != NULL);
+  
+  int32_t index = 0;
+  for (size_t i = 0; i < context->module->data.module.declarations.count; i++) {
+    ast_node_t* decl = context->module->data.module.declarations.nodes[i];
+    const char* decl_name = NULL;
+    
+    switch (decl->type) {
+      case AST_FUNCTION:
+        decl_name = function ? decl->data.function.name : NULL;
+        break;
+      case AST_EXTERN_FUNCTION:
+        decl_name = function ? decl->data.extern_function.name : NULL;
+        break;
+      case AST_CONSTANT:
+        decl_name = function ? NULL : decl->data.constant.name;
+        break;
+      case AST_GLOBAL:
+        decl_name = function ? NULL : decl->data.global.name;
+        break;
+      default:
+        break;
+    }
+    
+    if (decl_name == NULL) {
+      continue;
+    }
+    
+    if (strcmp(decl_name, name) == 0) {
+      return index;
+    }
+    index++;
+  }
+  
+  return -1;
+}
+
 /**
  * @brief Generate code for a module.
  * 
@@ -609,6 +776,17 @@ static bool codegen_module(codegen_context_t* context, ast_node_t* module) {
   assert(module != NULL);
   assert(module->type == AST_MODULE);
   
+  context->module = module;
+  
+  /* Function numbers in the call graph are COIL function indices */
+  callgraph_destroy(context->callgraph);
+  context->callgraph = callgraph_build(module);
+  if (context->callgraph == NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, module,
+                         "Memory allocation failed");
+    return false;
+  }
+  
   /* Set the module name */
   if (!coil_builder_set_module_name(context->builder, module->data.module.name)) {
     error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, module,
@@ -642,6 +820,10 @@ static bool codegen_module(codegen_context_t* context, ast_node_t* module) {
         success = codegen_extern_function(context, decl);
         break;
         
+      case AST_TARGET:
+        success = codegen_target(context, decl);
+        break;
+        
       default:
         error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, decl,
                              "Unknown declaration type: %d", decl->type);
@@ -653,7 +835,60 @@ static bool codegen_module(codegen_context_t* context, ast_node_t* module) {
     }
   }
   
-  return true;
+  /* Export the memory effects of every function to the metadata section */
+  effects_t* effects = effects_analyze(module, context->callgraph);
+  if (effects == NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, module,
+                         "Memory allocation failed");
+    return false;
+  }
+  
+  bool success = true;
+  for (size_t i = 0; i < callgraph_function_count(context->callgraph) && success; i++) {
+    success = coil_builder_add_function_effects(context->builder, (int32_t)i,
+                                                effects_get(effects, i));
+  }
+  
+  if (!success) {
+    effects_destroy(effects);
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, module,
+                         "Failed to add function effects");
+    return false;
+  }
+  
+  /* Export the attributes of every function that has some */
+  for (size_t i = 0; i < callgraph_function_count(context->callgraph) && success; i++) {
+    const ast_node_t* decl = callgraph_get_function(context->callgraph, i);
+    uint32_t attributes = decl->type == AST_FUNCTION ? decl->data.function.attributes :
+                          decl->data.extern_function.attributes;
+    success = attributes == 0 ||
+              coil_builder_add_function_attributes(context->builder, (int32_t)i, attributes);
+  }
+  
+  if (!success) {
+    effects_destroy(effects);
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, module,
+                         "Failed to add function attributes");
+    return false;
+  }
+  
+  /* Hot functions lead the code section and cold ones close it */
+  static const uint32_t placements[] = {
+    FUNCTION_ATTRIBUTE_HOT, 0, FUNCTION_ATTRIBUTE_COLD
+  };
+  const uint32_t placement_mask = FUNCTION_ATTRIBUTE_HOT | FUNCTION_ATTRIBUTE_COLD;
+  for (size_t p = 0; p < sizeof(placements) / sizeof(placements[0]) && success; p++) {
+    for (size_t i = 0; i < module->data.module.declarations.count && success; i++) {
+      ast_node_t* decl = module->data.module.declarations.nodes[i];
+      if (decl->type == AST_FUNCTION && decl->data.function.alias == NULL &&
+          (decl->data.function.attributes & placement_mask) == placements[p]) {
+        success = codegen_function_code(context, decl, effects);
+      }
+    }
+  }
+  effects_destroy(effects);
+  
+  return success;
 }
 
 /**
@@ -688,6 +923,64 @@ static bool codegen_type_def(codegen_context_t* context, ast_node_t* type_def) {
   return type_index >= 0;
 }
 
+/**
+ * @brief Evaluate a constant initializer written as an expression.
+ * 
+ * @param context The code generator context.
+ * @param constant The constant declaration AST node.
+ * @return A new integer literal holding the value, or NULL on failure.
+ */
+static ast_node_t* codegen_evaluate_constant(codegen_context_t* context, ast_node_t* constant) {
+  eval_context_t* eval = eval_create_context(context->module);
+  if (eval == NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, constant,
+                         "Memory allocation failed");
+    return NULL;
+  }
+  
+  int64_t value = 0;
+  eval_status_t status = eval_constant(eval, constant->data.constant.name, &value);
+  eval_destroy_context(eval);
+  
+  const char* reason = NULL;
+  switch (status) {
+    case EVAL_OK:
+      break;
+    case EVAL_TRAP:
+      reason = "evaluation traps";
+      break;
+    case EVAL_STEP_LIMIT:
+      reason = "evaluation exceeds the step limit";
+      break;
+    case EVAL_MEMORY_LIMIT:
+      reason = "evaluation exceeds the memory limit";
+      break;
+    case EVAL_NO_MEMORY:
+      error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, constant,
+                           "Memory allocation failed");
+      return NULL;
+    default:
+      reason = "not a compile-time constant";
+      break;
+  }
+  
+  if (reason != NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, constant,
+                         "Initializer of constant %s: %s", constant->data.constant.name, reason);
+    return NULL;
+  }
+  
+  ast_node_t* literal = ast_create_integer(value);
+  if (literal == NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, constant,
+                         "Memory allocation failed");
+    return NULL;
+  }
+  
+  literal->location = constant->data.constant.value->location;
+  return literal;
+}
+
 /**
  * @brief Generate code for a constant declaration.
  * 
@@ -706,12 +999,25 @@ static bool codegen_constant(codegen_context_t* context, ast_node_t* constant) {
     return false;
   }
   
+  /* Initializers written as expressions are evaluated at compile time */
+  ast_node_t* value = constant->data.constant.value;
+  ast_node_t* folded = NULL;
+  if (value->type != AST_EXPR_INTEGER && value->type != AST_EXPR_FLOAT &&
+      value->type != AST_EXPR_STRING) {
+    folded = codegen_evaluate_constant(context, constant);
+    if (folded == NULL) {
+      return false;
+    }
+    value = folded;
+  }
+  
   /* Generate the constant value */
   void* value_data = NULL;
   size_t value_size = 0;
   
-  if (!codegen_generate_constant(context, constant->data.constant.value, 
-                                &value_data, &value_size)) {
+  bool generated = codegen_generate_constant(context, value, &value_data, &value_size);
+  ast_destroy_node(folded);
+  if (!generated) {
     return false;
   }
   
@@ -787,7 +1093,88 @@ static bool codegen_global(codegen_context_t* context, ast_node_t* global) {
 }
 
 /**
- * @brief Generate code for a function declaration.
+ * @brief Collect the names of a target's features.
+ * 
+ * @param features The feature list of the target.
+ * @return A new array of the names, or NULL if memory allocation failed.
+ */
+static const char** collect_features(const ast_node_list_t* features) {
+  const char** names = (const char**)malloc((features->count + 1) * sizeof(const char*));
+  if (names == NULL) {
+    return NULL;
+  }
+  
+  for (size_t i = 0; i < features->count; i++) {
+    assert(features->nodes[i]->type == AST_EXPR_STRING);
+    names[i] = features->nodes[i]->data.expr_string.value;
+  }
+  
+  return names;
+}
+
+/**
+ * @brief Generate the metadata of a target declaration.
+ * 
+ * Targets are numbered in declaration order.
+ * 
+ * @param context The code generator context.
+ * @param target The target AST node.
+ * @return true on success, false on failure.
+ */
+static bool codegen_target(codegen_context_t* context, ast_node_t* target) {
+  assert(context != NULL);
+  assert(target != NULL);
+  assert(target->type == AST_TARGET);
+  
+  const ast_node_list_t* required = &target->data.target.required_features;
+  const ast_node_list_t* preferred = &target->data.target.preferred_features;
+  const char** required_names = collect_features(required);
+  const char** preferred_names = collect_features(preferred);
+  
+  bool success = required_names != NULL && preferred_names != NULL &&
+                 coil_builder_add_target(context->builder, target->data.target.device_class,
+                                         required_names, (uint32_t)required->count,
+                                         preferred_names, (uint32_t)preferred->count) >= 0;
+  free(required_names);
+  free(preferred_names);
+  
+  if (!success) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, target,
+                         "Failed to add target: %s", target->data.target.name);
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Find the metadata index of a target.
+ * 
+ * @param module The module AST node.
+ * @param name The target name.
+ * @return The number of targets declared before it, or -1 if not found.
+ */
+static int32_t find_target_index(ast_node_t* module, const char* name) {
+  int32_t index = 0;
+  for (size_t i = 0; i < module->data.module.declarations.count; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type != AST_TARGET) {
+      continue;
+    }
+    
+    if (strcmp(decl->data.target.name, name) == 0) {
+      return index;
+    }
+    index++;
+  }
+  
+  return -1;
+}
+
+/**
+ * @brief Generate the function entry of a function declaration.
+ * 
+ * The code of the function is generated by codegen_function_code once
+ * every declaration has its entry.
  * 
  * @param context The code generator context.
  * @param function The function declaration AST node.
@@ -798,10 +1185,59 @@ static bool codegen_function(codegen_context_t* context, ast_node_t* function) {
   assert(function != NULL);
   assert(function->type == AST_FUNCTION);
   
+  /* Folded functions share the code of an earlier function */
+  if (function->data.function.alias != NULL) {
+    int32_t target = callgraph_find(context->callgraph, function->data.function.alias);
+    if (target < 0 || 
+        coil_builder_add_function_alias(context->builder, function->data.function.name,
+                                        target) < 0) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, function,
+                           "Failed to add function alias: %s", function->data.function.alias);
+      return false;
+    }
+    return true;
+  }
+  
+  /* Versioned functions dispatch; their baseline gets an entry with its code */
+  bool dispatch = function->data.function.versions.count > 0;
+  return codegen_add_function(context, function, function->data.function.name, 
+                              dispatch) >= 0;
+}
+
+/**
+ * @brief Generate the code of a function declaration with an entry of its own.
+ * 
+ * @param context The code generator context.
+ * @param function The function declaration AST node.
+ * @param effects The memory effects of the module's functions.
+ * @return true on success, false on failure.
+ */
+static bool codegen_function_code(codegen_context_t* context, ast_node_t* function,
+                                  effects_t* effects) {
+  if (function->data.function.versions.count > 0) {
+    return codegen_versions(context, function, effects);
+  }
+  
+  int32_t function_index = callgraph_find(context->callgraph, function->data.function.name);
+  assert(function_index >= 0);
+  return codegen_function_body(context, function, function_index);
+}
+
+/**
+ * @brief Add the entry of a function declaration to the function section.
+ * 
+ * @param context The code generator context.
+ * @param function The function declaration AST node.
+ * @param name The name of the entry.
+ * @param dispatch Whether the entry dispatches to the versions of the function.
+ * @return The function index, or -1 on failure.
+ */
+static int32_t codegen_add_function(codegen_context_t* context, ast_node_t* function,
+                                    const char* name, bool dispatch) {
   /* Map the return type */
   int32_t return_type = codegen_map_type(context, function->data.function.return_type);
   if (return_type < 0) {
-    return false;
+    return -1;
   }
   
   /* Map the parameter types */
@@ -814,7 +1250,7 @@ static bool codegen_function(codegen_context_t* context, ast_node_t* function) {
     if (param_types == NULL) {
       error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, function,
                            "Memory allocation failed");
-      return false;
+      return -1;
     }
   }
   
@@ -825,28 +1261,38 @@ static bool codegen_function(codegen_context_t* context, ast_node_t* function) {
     param_types[i] = codegen_map_type(context, param->data.parameter.type);
     if (param_types[i] < 0) {
       free(param_types);
-      return false;
+      return -1;
     }
   }
   
   /* Add the function to the COIL binary */
-  int32_t function_index = coil_builder_add_function(
-    context->builder,
-    function->data.function.name,
-    return_type,
-    param_types,
-    (uint32_t)function->data.function.parameters.count,
-    false  /* Not external */
-  );
+  uint32_t param_count = (uint32_t)function->data.function.parameters.count;
+  int32_t function_index = dispatch ?
+    coil_builder_add_function_dispatch(context->builder, name, return_type, 
+                                       param_types, param_count) :
+    coil_builder_add_function(context->builder, name, return_type, 
+                              param_types, param_count, false);
   
   free(param_types);
   
   if (function_index < 0) {
     error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, function,
                          "Failed to add function");
-    return false;
   }
   
+  return function_index;
+}
+
+/**
+ * @brief Generate the code of a function declaration.
+ * 
+ * @param context The code generator context.
+ * @param function The function declaration AST node.
+ * @param function_index The index of the function entry receiving the code.
+ * @return true on success, false on failure.
+ */
+static bool codegen_function_body(codegen_context_t* context, ast_node_t* function,
+                                  int32_t function_index) {
   /* Create a local symbol table for the function */
   symbol_table_t* function_table = symtable_create_child(context->symbol_table);
   if (function_table == NULL) {
@@ -910,6 +1356,7 @@ static bool codegen_function(codegen_context_t* context, ast_node_t* function) {
   
   /* Generate code for each basic block */
   bool success = true;
+  context->current_function = function;
   for (size_t i = 0; i < function->data.function.blocks.count; i++) {
     ast_node_t* block = function->data.function.blocks.nodes[i];
     if (!codegen_block(context, block, function_index)) {
@@ -927,6 +1374,7 @@ static bool codegen_function(codegen_context_t* context, ast_node_t* function) {
   
   /* Restore the symbol table */
   context->current_symtable = context->symbol_table;
+  context->current_function = NULL;
   
   /* Free the function table */
   symtable_destroy(function_table);
@@ -934,6 +1382,74 @@ static bool codegen_function(codegen_context_t* context, ast_node_t* function) {
   return success;
 }
 
+/**
+ * @brief Generate the baseline of a versioned function and record its versions.
+ * 
+ * The dispatch entry of the function keeps its call graph number, so the
+ * baseline code is added as function.default after every declaration. The
+ * versions themselves are the function.target declarations the type
+ * checker added.
+ * 
+ * @param context The code generator context.
+ * @param function The versioned function AST node.
+ * @param effects The memory effects of the module's functions.
+ * @return true on success, false on failure.
+ */
+static bool codegen_versions(codegen_context_t* context, ast_node_t* function, 
+                             effects_t* effects) {
+  const char* name = function->data.function.name;
+  int32_t dispatch = callgraph_find(context->callgraph, name);
+  assert(dispatch >= 0);
+  
+  size_t length = strlen(name) + sizeof(".default");
+  char* baseline_name = (char*)malloc(length);
+  if (baseline_name == NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, function,
+                         "Memory allocation failed");
+    return false;
+  }
+  snprintf(baseline_name, length, "%s.default", name);
+  
+  int32_t baseline = codegen_add_function(context, function, baseline_name, false);
+  free(baseline_name);
+  if (baseline < 0 || !codegen_function_body(context, function, baseline)) {
+    return false;
+  }
+  
+  /* The baseline has the effects and attributes of the function it implements */
+  uint32_t attributes = function->data.function.attributes;
+  bool success = coil_builder_add_function_effects(context->builder, baseline,
+                                                   effects_get(effects, (size_t)dispatch)) &&
+                 (attributes == 0 ||
+                  coil_builder_add_function_attributes(context->builder, baseline, attributes)) &&
+                 coil_builder_add_function_version(context->builder, dispatch, baseline, -1);
+  
+  for (size_t i = 0; i < function->data.function.versions.count && success; i++) {
+    const char* target = function->data.function.versions.nodes[i]->data.expr_identifier.name;
+    size_t version_length = strlen(name) + strlen(target) + 2;
+    char* version_name = (char*)malloc(version_length);
+    if (version_name == NULL) {
+      success = false;
+      break;
+    }
+    snprintf(version_name, version_length, "%s.%s", name, target);
+    
+    int32_t version = callgraph_find(context->callgraph, version_name);
+    int32_t target_index = find_target_index(context->module, target);
+    free(version_name);
+    success = version >= 0 && target_index >= 0 &&
+              coil_builder_add_function_version(context->builder, dispatch, version, 
+                                                target_index);
+  }
+  
+  if (!success) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, function,
+                         "Failed to add function versions: %s", name);
+  }
+  
+  return success;
+}
+
 /**
  * @brief Generate code for an external function declaration.
  * 
@@ -1099,6 +1615,32 @@ static bool codegen_assignment(codegen_context_t* context, ast_node_t* assignmen
   }
 }
 
+/**
+ * @brief Check whether an instruction operand is encoded as an immediate.
+ * 
+ * @param opcode The instruction opcode.
+ * @param index The operand index.
+ * @return true for the SPLAT lane count, the EXTRACT and INSERT lanes, the SHUFFLE
+ *         mask and the PREFETCH locality.
+ */
+static bool codegen_is_immediate(uint8_t opcode, size_t index) {
+  switch (opcode) {
+    case OPCODE_SPLAT:
+    case OPCODE_EXTRACT:
+    case OPCODE_PREFETCH:
+      return index == 1;
+      
+    case OPCODE_INSERT:
+      return index == 2;
+      
+    case OPCODE_SHUFFLE:
+      return index >= 2;
+      
+    default:
+      return false;
+  }
+}
+
 /**
  * @brief Generate code for an instruction statement.
  * 
@@ -1120,6 +1662,13 @@ static bool codegen_instruction(codegen_context_t* context, ast_node_t* instruct
     return false;
   }
   
+  /* CALL wraps a single call expression that writes the destination directly */
+  if (opcode == OPCODE_CALL && instruction->data.stmt_instruction.operands.count == 1 &&
+      instruction->data.stmt_instruction.operands.nodes[0]->type == AST_EXPR_CALL) {
+    return codegen_call(context, instruction->data.stmt_instruction.operands.nodes[0],
+                        function_index, destination);
+  }
+  
   /* Generate code for each operand */
   uint8_t* operands = NULL;
   if (instruction->data.stmt_instruction.operands.count > 0) {
@@ -1133,6 +1682,18 @@ static bool codegen_instruction(codegen_context_t* context, ast_node_t* instruct
   
   for (size_t i = 0; i < instruction->data.stmt_instruction.operands.count; i++) {
     ast_node_t* operand = instruction->data.stmt_instruction.operands.nodes[i];
+    if (codegen_is_immediate(opcode, i)) {
+      if (operand->type != AST_EXPR_INTEGER || operand->data.expr_integer.value < 0 ||
+          operand->data.expr_integer.value > 0xFF) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, operand,
+                             "Immediate operand must be an integer from 0 to 255");
+        free(operands);
+        return false;
+      }
+      operands[i] = (uint8_t)operand->data.expr_integer.value;
+      continue;
+    }
+    
     operands[i] = codegen_expr(context, operand, function_index);
     if (operands[i] == 0xFF) {
       free(operands);
@@ -1140,11 +1701,17 @@ static bool codegen_instruction(codegen_context_t* context, ast_node_t* instruct
     }
   }
   
+  /* An asserted alignment is encoded as its logarithm plus one */
+  uint8_t flags = instruction->data.stmt_instruction.flags;
+  for (uint32_t align = instruction->data.stmt_instruction.alignment; align != 0; align >>= 1) {
+    flags++;
+  }
+  
   /* Add the instruction to the COIL binary */
   bool success = coil_builder_add_instruction(
     context->builder,
     opcode,
-    0,  /* No flags */
+    flags,
     destination,
     operands,
     (uint8_t)instruction->data.stmt_instruction.operands.count
@@ -1163,6 +1730,50 @@ static bool codegen_instruction(codegen_context_t* context, ast_node_t* instruct
   return true;
 }
 
+/**
+ * @brief Encode a branch target as the index of its block in the current function.
+ * 
+ * Blocks are added to the builder in declaration order, so a block's
+ * position in the function is its COIL block index.
+ * 
+ * @param context The code generator context.
+ * @param branch The branch statement AST node.
+ * @param label The target block label.
+ * @param operand Pointer to store the block index.
+ * @return true on success, false on failure.
+ */
+static bool codegen_block_target(codegen_context_t* context, ast_node_t* branch,
+                                 const char* label, uint8_t* operand) {
+  assert(context != NULL);
+  assert(context->current_function != NULL);
+  assert(label != NULL);
+  assert(operand != NULL);
+  
+  symbol_entry_t* entry = symtable_lookup(context->current_symtable, label, true);
+  if (entry == NULL || symtable_get_kind(entry) != SYMBOL_BLOCK) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, branch,
+                         "Unknown branch target: %s", label);
+    return false;
+  }
+  
+  ast_node_list_t* blocks = &context->current_function->data.function.blocks;
+  for (size_t i = 0; i < blocks->count; i++) {
+    if (blocks->nodes[i] == symtable_get_node(entry)) {
+      if (i >= 0xFF) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, branch,
+                             "Too many blocks to address: %s", label);
+        return false;
+      }
+      *operand = (uint8_t)i;
+      return true;
+    }
+  }
+  
+  error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, branch,
+                       "Branch target outside the function: %s", label);
+  return false;
+}
+
 /**
  * @brief Generate code for a branch statement.
  * 
@@ -1190,34 +1801,25 @@ static bool codegen_branch(codegen_context_t* context, ast_node_t* branch,
     uint8_t operands[3];
     operands[0] = condition;
     
-    /* Find the true target block */
-    symbol_entry_t* true_entry = symtable_lookup(context->current_symtable, 
-                                              branch->data.stmt_branch.true_target, true);
-    if (true_entry == NULL || symtable_get_kind(true_entry) != SYMBOL_BLOCK) {
-      error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, branch,
-                          "Unknown branch target: %s", branch->data.stmt_branch.true_target);
+    /* Encode the target blocks */
+    if (!codegen_block_target(context, branch, branch->data.stmt_branch.true_target,
+                              &operands[1]) ||
+        !codegen_block_target(context, branch, branch->data.stmt_branch.false_target,
+                              &operands[2])) {
       return false;
     }
     
-    /* Set the target indexes */
-    operands[1] = 1;  /* Block index (simplified) */
-    
-    /* Find the false target block */
-    symbol_entry_t* false_entry = symtable_lookup(context->current_symtable, 
-                                               branch->data.stmt_branch.false_target, true);
-    if (false_entry == NULL || symtable_get_kind(false_entry) != SYMBOL_BLOCK) {
-      error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, branch,
-                          "Unknown branch target: %s", branch->data.stmt_branch.false_target);
-      return false;
-    }
-    
-    operands[2] = 2;  /* Block index (simplified) */
+    /* Encode the probability hint, rounding to the nearest step */
+    uint64_t true_weight = branch->data.stmt_branch.true_weight;
+    uint64_t total = true_weight + branch->data.stmt_branch.false_weight;
+    uint8_t flags = total == 0 ? 0 :
+      (uint8_t)(1 + (true_weight * BRANCH_PROBABILITY_SCALE + total / 2) / total);
     
     /* Add the branch instruction */
     if (!coil_builder_add_instruction(
           context->builder,
           opcode,
-          0,  /* No flags */
+          flags,
           0xFF,  /* No destination */
           operands,
           3
@@ -1232,17 +1834,12 @@ static bool codegen_branch(codegen_context_t* context, ast_node_t* branch,
     uint8_t opcode = OPCODE_BR;
     uint8_t operands[1];
     
-    /* Find the target block */
-    symbol_entry_t* target_entry = symtable_lookup(context->current_symtable, 
-                                               branch->data.stmt_branch.true_target, true);
-    if (target_entry == NULL || symtable_get_kind(target_entry) != SYMBOL_BLOCK) {
-      error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, branch,
-                          "Unknown branch target: %s", branch->data.stmt_branch.true_target);
+    /* Encode the target block */
+    if (!codegen_block_target(context, branch, branch->data.stmt_branch.true_target,
+                              &operands[0])) {
       return false;
     }
     
-    operands[0] = 1;  /* Block index (simplified) */
-    
     /* Add the branch instruction */
     if (!coil_builder_add_instruction(
           context->builder,
@@ -1438,6 +2035,30 @@ static uint8_t codegen_expr(codegen_context_t* context, ast_node_t* expr,
       /* Look up the variable */
       const char* name = expr->data.expr_identifier.name;
       
+      /* Globals and constants are addressed through their global index */
+      symbol_entry_t* entry = symtable_lookup(context->current_symtable, name, true);
+      if (entry != NULL && (symtable_get_kind(entry) == SYMBOL_GLOBAL || 
+                            symtable_get_kind(entry) == SYMBOL_CONSTANT)) {
+        int32_t global_index = find_declaration_index(context, name, false);
+        uint8_t reg = context->next_reg++;
+        
+        if (global_index < 0 || global_index >= 0xFF || reg >= 0xFF) {
+          error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
+                               "Cannot address global: %s", name);
+          return 0xFF;
+        }
+        
+        uint8_t operand = (uint8_t)global_index;
+        if (!coil_builder_add_instruction(context->builder, OPCODE_LEA, 0, reg, 
+                                          &operand, 1)) {
+          error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
+                               "Failed to add address instruction");
+          return 0xFF;
+        }
+        
+        return reg;
+      }
+      
       /* Check if it's a local variable */
       uint8_t reg = find_local_register(context, name);
       if (reg != 0xFF) {
@@ -1451,89 +2072,73 @@ static uint8_t codegen_expr(codegen_context_t* context, ast_node_t* expr,
       return 0xFF;
     }
       
-    case AST_EXPR_FIELD: {
-      /* Field access */
-      /* This is a simplification; in a full implementation, field access would be handled differently */
-      error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
-                           "Field access not implemented");
-      return 0xFF;
-    }
+    case AST_EXPR_FIELD:
+    case AST_EXPR_INDEX: {
+      /* Field and element accesses through a pointer compute an address */
+      bool is_field = expr->type == AST_EXPR_FIELD;
+      bool is_address = is_field ? expr->data.expr_field.is_address : 
+                                   expr->data.expr_index.is_address;
+      if (!is_address) {
+        /* This is a simplification; in a full implementation, aggregate values */
+        /* would be handled differently */
+        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
+                             is_field ? "Field access not implemented" : 
+                                        "Element access not implemented");
+        return 0xFF;
+      }
       
-    case AST_EXPR_CALL: {
-      /* Function call */
-      /* Generate code for the function expression */
-      uint8_t func_reg = codegen_expr(context, expr->data.expr_call.function, function_index);
-      if (func_reg == 0xFF) {
+      /* LEA from the base pointer; the second operand is the field position */
+      /* for fields and the index register for elements */
+      uint8_t operands[2];
+      operands[0] = codegen_expr(context, is_field ? expr->data.expr_field.object : 
+                                                     expr->data.expr_index.array, 
+                                 function_index);
+      if (operands[0] == 0xFF) {
         return 0xFF;
       }
       
-      /* Generate code for each argument */
-      uint8_t* arg_regs = NULL;
-      if (expr->data.expr_call.arguments.count > 0) {
-        arg_regs = (uint8_t*)malloc(expr->data.expr_call.arguments.count);
-        if (arg_regs == NULL) {
+      if (is_field) {
+        if (expr->data.expr_field.index > 0xFF) {
           error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
-                               "Memory allocation failed");
+                               "Too many fields to address: %s", expr->data.expr_field.field);
           return 0xFF;
         }
-      }
-      
-      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
-        ast_node_t* arg = expr->data.expr_call.arguments.nodes[i];
-        arg_regs[i] = codegen_expr(context, arg, function_index);
-        if (arg_regs[i] == 0xFF) {
-          free(arg_regs);
+        operands[1] = (uint8_t)expr->data.expr_field.index;
+      } else {
+        operands[1] = codegen_expr(context, expr->data.expr_index.index, function_index);
+        if (operands[1] == 0xFF) {
           return 0xFF;
         }
       }
       
-      /* Allocate a register for the result */
-      uint8_t result_reg = context->next_reg++;
-      
-      if (result_reg >= 0xFF) {
-        if (arg_regs != NULL) {
-          free(arg_regs);
-        }
+      uint8_t reg = context->next_reg++;
+      if (reg >= 0xFF) {
         error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
                              "Too many temporary registers");
         return 0xFF;
       }
       
-      /* CALL instruction */
-      uint8_t opcode = OPCODE_CALL;
-      uint8_t* operands = (uint8_t*)malloc(1 + expr->data.expr_call.arguments.count);
-      if (operands == NULL) {
-        if (arg_regs != NULL) {
-          free(arg_regs);
-        }
+      if (!coil_builder_add_instruction(context->builder, OPCODE_LEA, 0, reg, operands, 2)) {
         error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
-                             "Memory allocation failed");
+                             "Failed to add address instruction");
         return 0xFF;
       }
       
-      operands[0] = func_reg;
-      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
-        operands[i + 1] = arg_regs[i];
-      }
+      return reg;
+    }
       
-      /* Add the call instruction */
-      bool success = coil_builder_add_instruction(
-        context->builder,
-        opcode,
-        0,  /* No flags */
-        result_reg,
-        operands,
-        (uint8_t)(1 + expr->data.expr_call.arguments.count)
-      );
+    case AST_EXPR_CALL: {
+      /* Function call */
+      /* Allocate a register for the result */
+      uint8_t result_reg = context->next_reg++;
       
-      free(operands);
-      if (arg_regs != NULL) {
-        free(arg_regs);
+      if (result_reg >= 0xFF) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
+                             "Too many temporary registers");
+        return 0xFF;
       }
       
-      if (!success) {
-        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
-                            "Failed to add call instruction");
+      if (!codegen_call(context, expr, function_index, result_reg)) {
         return 0xFF;
       }
       
@@ -1545,4 +2150,87 @@ static uint8_t codegen_expr(codegen_context_t* context, ast_node_t* expr,
                            "Unknown expression type: %d", expr->type);
       return 0xFF;
   }
-}
\ No newline at end of file
+}
+/**
+ * @brief Generate a CALL instruction for a call expression.
+ * 
+ * Direct calls encode the callee's function index as the first operand;
+ * indirect calls encode the register holding the callee.
+ * 
+ * @param context The code generator context.
+ * @param call The call expression AST node.
+ * @param function_index The function index.
+ * @param destination The destination register.
+ * @return true on success, false on failure.
+ */
+static bool codegen_call(codegen_context_t* context, ast_node_t* call, 
+                         int32_t function_index, uint8_t destination) {
+  assert(context != NULL);
+  assert(call != NULL);
+  assert(call->type == AST_EXPR_CALL);
+  
+  /* Resolve the callee */
+  uint8_t callee = 0xFF;
+  ast_node_t* function = call->data.expr_call.function;
+  if (function->type == AST_EXPR_IDENTIFIER) {
+    symbol_entry_t* entry = symtable_lookup(context->current_symtable, 
+                                           function->data.expr_identifier.name, true);
+    if (entry != NULL && symtable_get_kind(entry) == SYMBOL_FUNCTION) {
+      int32_t callee_index = callgraph_find(context->callgraph,
+                                            function->data.expr_identifier.name);
+      if (callee_index < 0 || callee_index >= 0xFF) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, call,
+                             "Cannot encode call target: %s", 
+                             function->data.expr_identifier.name);
+        return false;
+      }
+      callee = (uint8_t)callee_index;
+    }
+  }
+  
+  if (callee == 0xFF) {
+    callee = codegen_expr(context, function, function_index);
+    if (callee == 0xFF) {
+      return false;
+    }
+  }
+  
+  /* CALL instruction: callee followed by the arguments */
+  size_t arg_count = call->data.expr_call.arguments.count;
+  uint8_t* operands = (uint8_t*)malloc(1 + arg_count);
+  if (operands == NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, call,
+                         "Memory allocation failed");
+    return false;
+  }
+  
+  operands[0] = callee;
+  for (size_t i = 0; i < arg_count; i++) {
+    ast_node_t* arg = call->data.expr_call.arguments.nodes[i];
+    operands[i + 1] = codegen_expr(context, arg, function_index);
+    if (operands[i + 1] == 0xFF) {
+      free(operands);
+      return false;
+    }
+  }
+  
+  /* Add the call instruction */
+  bool success = coil_builder_add_instruction(
+    context->builder,
+    OPCODE_CALL,
+    0,  /* No flags */
+    destination,
+    operands,
+    (uint8_t)(1 + arg_count)
+  );
+  
+  free(operands);
+  
+  if (!success) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, call,
+                        "Failed to add call instruction");
+    return false;
+  }
+  
+  return true;
+}
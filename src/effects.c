@@ -0,0 +1,503 @@
+/**
+ * @file effects.c
+ * @brief Implementation of the interprocedural memory effects analysis.
+ * 
+ * This file contains the classification of the memory accesses of each
+ * function, propagated bottom-up over the components of the call graph,
+ * and the refinement of call statement flags used by the passes.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/effects.h"
+#include "../include/ir.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Memory access bits of a function.
+ */
+typedef enum {
+  EFFECT_READS = 0x01,       /**< Reads memory. */
+  EFFECT_WRITES = 0x02,      /**< Writes memory. */
+  EFFECT_OTHER = 0x04,       /**< Accesses memory not reached through pointer arguments. */
+} effect_bit_t;
+
+/**
+ * @brief Every memory access bit.
+ */
+#define EFFECT_ALL (EFFECT_READS | EFFECT_WRITES | EFFECT_OTHER)
+
+/**
+ * @brief Memory effects analysis structure.
+ */
+struct effects {
+  const callgraph_t* cg;     /**< Call graph numbering the functions. */
+  ir_var_table_t* globals;   /**< Names of the global variables. */
+  uint32_t* bits;            /**< Access bits of each function. */
+  ast_node_t* cached_function; /**< Function whose locals are cached. */
+  ir_var_table_t* cached_locals; /**< Parameters and locals of the cached function. */
+};
+
+/**
+ * @brief Scan state for the accesses of one function.
+ */
+typedef struct {
+  effects_t* effects;        /**< The analysis. */
+  ir_var_table_t* locals;    /**< Parameters and locals of the function. */
+  bool* derived;             /**< Whether each local only points into argument memory. */
+  uint32_t bits;             /**< Access bits found so far. */
+} effects_scan_t;
+
+/**
+ * @brief Collect the parameters and locals of a function.
+ * 
+ * Assignments to a global name write the global, so they add no local.
+ * 
+ * @param effects The analysis.
+ * @param function The function AST node.
+ * @return A new variable table, or NULL if memory allocation failed.
+ */
+static ir_var_table_t* collect_locals(const effects_t* effects, ast_node_t* function) {
+  ir_var_table_t* locals = ir_var_table_create();
+  bool success = locals != NULL;
+  
+  for (size_t i = 0; i < function->data.function.parameters.count && success; i++) {
+    const ast_node_t* param = function->data.function.parameters.nodes[i];
+    success = ir_var_table_intern(locals, param->data.parameter.name) >= 0;
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count && success; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      if (def != NULL && ir_var_table_find(effects->globals, def) < 0) {
+        success = ir_var_table_intern(locals, def) >= 0;
+      }
+    }
+  }
+  
+  if (!success) {
+    ir_var_table_destroy(locals);
+    return NULL;
+  }
+  return locals;
+}
+
+/**
+ * @brief Check whether an identifier names a global variable in a scope.
+ * 
+ * @param effects The analysis.
+ * @param locals The parameters and locals of the scope.
+ * @param name The identifier.
+ * @return true if the identifier reads or writes a global variable.
+ */
+static bool is_global(const effects_t* effects, const ir_var_table_t* locals, const char* name) {
+  return ir_var_table_find(locals, name) < 0 && ir_var_table_find(effects->globals, name) >= 0;
+}
+
+/**
+ * @brief Check whether an expression only points into argument memory.
+ * 
+ * @param scan The scan state.
+ * @param expr The expression.
+ * @return true if the expression is a local derived from a pointer parameter.
+ */
+static bool is_derived(const effects_scan_t* scan, const ast_node_t* expr) {
+  if (expr->type != AST_EXPR_IDENTIFIER) {
+    return false;
+  }
+  
+  int32_t id = ir_var_table_find(scan->locals, expr->data.expr_identifier.name);
+  return id >= 0 && scan->derived[id];
+}
+
+/**
+ * @brief Find the locals that only point into argument memory.
+ * 
+ * Starts from every local and removes those with a definition other than
+ * LEA, ADD or SUB of a remaining local, and parameters that are not
+ * pointers, until nothing changes.
+ * 
+ * @param scan The scan state.
+ * @param function The function AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool find_derived(effects_scan_t* scan, ast_node_t* function) {
+  size_t count = ir_var_table_count(scan->locals);
+  scan->derived = (bool*)malloc((count + 1) * sizeof(bool));
+  if (scan->derived == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < count; i++) {
+    scan->derived[i] = true;
+  }
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    const ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (param->data.parameter.type->type != AST_TYPE_PTR) {
+      scan->derived[ir_var_table_find(scan->locals, param->data.parameter.name)] = false;
+    }
+  }
+  
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+      ast_node_t* block = function->data.function.blocks.nodes[i];
+      for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+        ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+        const char* def = ir_get_def(stmt);
+        int32_t id = def != NULL ? ir_var_table_find(scan->locals, def) : -1;
+        if (id < 0 || !scan->derived[id]) {
+          continue;
+        }
+        
+        uint8_t opcode = ir_get_opcode(stmt);
+        ast_node_t* instruction = ir_get_instruction(stmt);
+        if ((opcode != OPCODE_LEA && opcode != OPCODE_ADD && opcode != OPCODE_SUB) ||
+            instruction->data.stmt_instruction.operands.count == 0 ||
+            !is_derived(scan, instruction->data.stmt_instruction.operands.nodes[0])) {
+          scan->derived[id] = false;
+          changed = true;
+        }
+      }
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Get the declaration whose parameters a call binds.
+ * 
+ * @param effects The analysis.
+ * @param function The callee function number.
+ * @return The function AST node, or NULL if it cannot be found.
+ */
+static const ast_node_t* callee_declaration(const effects_t* effects, size_t function) {
+  const ast_node_t* decl = callgraph_get_function(effects->cg, function);
+  if (decl->type == AST_FUNCTION && decl->data.function.alias != NULL) {
+    int32_t target = callgraph_find(effects->cg, decl->data.function.alias);
+    decl = target >= 0 ? callgraph_get_function(effects->cg, (size_t)target) : NULL;
+  }
+  
+  return decl != NULL && decl->type == AST_FUNCTION ? decl : NULL;
+}
+
+static void scan_expr(effects_scan_t* scan, const ast_node_t* expr);
+
+/**
+ * @brief Record the accesses of a call expression.
+ * 
+ * The argument memory of an argmem-only callee is argument memory of the
+ * caller when every pointer passed to it derives from a pointer parameter.
+ * 
+ * @param scan The scan state.
+ * @param call The call expression.
+ */
+static void scan_call(effects_scan_t* scan, const ast_node_t* call) {
+  const ast_node_list_t* arguments = &call->data.expr_call.arguments;
+  for (size_t i = 0; i < arguments->count; i++) {
+    scan_expr(scan, arguments->nodes[i]);
+  }
+  
+  const ast_node_t* callee = call->data.expr_call.function;
+  int32_t function = -1;
+  if (callee->type == AST_EXPR_IDENTIFIER &&
+      ir_var_table_find(scan->locals, callee->data.expr_identifier.name) < 0) {
+    function = callgraph_find(scan->effects->cg, callee->data.expr_identifier.name);
+  }
+  if (function < 0) {
+    scan->bits |= EFFECT_ALL;
+    return;
+  }
+  
+  uint32_t bits = scan->effects->bits[function];
+  scan->bits |= bits;
+  if ((bits & EFFECT_OTHER) != 0 || (bits & (EFFECT_READS | EFFECT_WRITES)) == 0) {
+    return;
+  }
+  
+  const ast_node_t* decl = callee_declaration(scan->effects, (size_t)function);
+  if (decl == NULL || decl->data.function.parameters.count != arguments->count) {
+    scan->bits |= EFFECT_OTHER;
+    return;
+  }
+  for (size_t i = 0; i < arguments->count; i++) {
+    const ast_node_t* param = decl->data.function.parameters.nodes[i];
+    if (param->data.parameter.type->type == AST_TYPE_PTR &&
+        !is_derived(scan, arguments->nodes[i])) {
+      scan->bits |= EFFECT_OTHER;
+    }
+  }
+}
+
+/**
+ * @brief Record the accesses of an expression.
+ * 
+ * @param scan The scan state.
+ * @param expr The expression (can be NULL).
+ */
+static void scan_expr(effects_scan_t* scan, const ast_node_t* expr) {
+  if (expr == NULL) {
+    return;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_IDENTIFIER:
+      if (is_global(scan->effects, scan->locals, expr->data.expr_identifier.name)) {
+        scan->bits |= EFFECT_READS | EFFECT_OTHER;
+      }
+      break;
+    
+    case AST_EXPR_FIELD:
+      scan_expr(scan, expr->data.expr_field.object);
+      scan->bits |= EFFECT_READS | EFFECT_OTHER;
+      break;
+    
+    case AST_EXPR_INDEX:
+      scan_expr(scan, expr->data.expr_index.array);
+      scan_expr(scan, expr->data.expr_index.index);
+      scan->bits |= EFFECT_READS | EFFECT_OTHER;
+      break;
+    
+    case AST_EXPR_CALL:
+      scan_call(scan, expr);
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Record the accesses of a statement.
+ * 
+ * @param scan The scan state.
+ * @param stmt The statement.
+ */
+static void scan_statement(effects_scan_t* scan, ast_node_t* stmt) {
+  if (stmt->type == AST_STMT_BRANCH) {
+    scan_expr(scan, stmt->data.stmt_branch.condition);
+    return;
+  }
+  if (stmt->type == AST_STMT_RETURN) {
+    scan_expr(scan, stmt->data.stmt_return.value);
+    return;
+  }
+  
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  if (instruction == NULL) {
+    return;
+  }
+  
+  const char* def = ir_get_def(stmt);
+  if (def != NULL && is_global(scan->effects, scan->locals, def)) {
+    scan->bits |= EFFECT_WRITES | EFFECT_OTHER;
+  }
+  
+  uint8_t opcode = ir_get_opcode(stmt);
+  const ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+  size_t first = 0;
+  if ((opcode == OPCODE_LOAD || opcode == OPCODE_STORE || opcode == OPCODE_PREFETCH) &&
+      operands->count > 0) {
+    /* The address operand is accounted for by the access itself */
+    const ast_node_t* address = operands->nodes[0];
+    scan->bits |= opcode == OPCODE_STORE ? EFFECT_WRITES : EFFECT_READS;
+    if (!is_derived(scan, address)) {
+      scan->bits |= EFFECT_OTHER;
+    }
+    first = address->type == AST_EXPR_IDENTIFIER ? 1 : 0;
+  } else if (opcode != OPCODE_CALL &&
+             (ir_opcode_flags(opcode) & (IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY)) != 0) {
+    scan->bits |= EFFECT_ALL;
+  }
+  
+  for (size_t i = first; i < operands->count; i++) {
+    scan_expr(scan, operands->nodes[i]);
+  }
+}
+
+/**
+ * @brief Compute the access bits of a function from its body and its callees.
+ * 
+ * @param effects The analysis.
+ * @param function The function number.
+ * @param bits Where to store the access bits.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool function_bits(effects_t* effects, size_t function, uint32_t* bits) {
+  ast_node_t* decl = callgraph_get_function(effects->cg, function);
+  
+  if (decl->type != AST_FUNCTION || decl->data.function.blocks.count == 0) {
+    /* Without a body, pure functions are taken at their word */
+    uint32_t attributes = decl->type == AST_FUNCTION ? decl->data.function.attributes :
+                          decl->data.extern_function.attributes;
+    *bits = (attributes & FUNCTION_ATTRIBUTE_PURE) != 0 ? 0 : EFFECT_ALL;
+    if (decl->type == AST_FUNCTION && decl->data.function.alias != NULL) {
+      /* An alias runs the code of its target, analyzed in an earlier component */
+      int32_t target = callgraph_find(effects->cg, decl->data.function.alias);
+      *bits = target >= 0 ? effects->bits[target] : EFFECT_ALL;
+    }
+    return true;
+  }
+  
+  effects_scan_t scan;
+  scan.effects = effects;
+  scan.locals = collect_locals(effects, decl);
+  scan.derived = NULL;
+  scan.bits = 0;
+  bool success = scan.locals != NULL && find_derived(&scan, decl);
+  
+  for (size_t i = 0; i < decl->data.function.blocks.count && success; i++) {
+    ast_node_t* block = decl->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      scan_statement(&scan, block->data.stmt_block.statements.nodes[j]);
+    }
+  }
+
+  *bits = scan.bits;
+  free(scan.derived);
+  ir_var_table_destroy(scan.locals);
+  return success;
+}
+
+effects_t* effects_analyze(ast_node_t* module, const callgraph_t* cg) {
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  assert(cg != NULL);
+  
+  effects_t* effects = (effects_t*)calloc(1, sizeof(effects_t));
+  if (effects == NULL) {
+    return NULL;
+  }
+  
+  size_t n = callgraph_function_count(cg);
+  effects->cg = cg;
+  effects->globals = ir_var_table_create();
+  effects->bits = (uint32_t*)calloc(n + 1, sizeof(uint32_t));
+  bool success = effects->globals != NULL && effects->bits != NULL;
+  
+  const ast_node_list_t* declarations = &module->data.module.declarations;
+  for (size_t i = 0; i < declarations->count && success; i++) {
+    const ast_node_t* decl = declarations->nodes[i];
+    if (decl->type == AST_GLOBAL) {
+      success = ir_var_table_intern(effects->globals, decl->data.global.name) >= 0;
+    }
+  }
+  
+  /* Callees first; recursive components start from no access and grow to a fixpoint */
+  for (size_t scc = 0; scc < callgraph_scc_count(cg) && success; scc++) {
+    bool changed = true;
+    while (changed && success) {
+      changed = false;
+      for (size_t i = 0; i < callgraph_scc_size(cg, scc) && success; i++) {
+        size_t function = callgraph_get_scc_function(cg, scc, i);
+        uint32_t bits = 0;
+        success = function_bits(effects, function, &bits);
+        bits |= effects->bits[function];
+        if (bits != effects->bits[function]) {
+          effects->bits[function] = bits;
+          changed = true;
+        }
+      }
+      changed = changed && callgraph_scc_is_recursive(cg, scc);
+    }
+  }
+  
+  if (!success) {
+    effects_destroy(effects);
+    return NULL;
+  }
+  return effects;
+}
+
+void effects_destroy(effects_t* effects) {
+  if (effects == NULL) {
+    return;
+  }
+  
+  ir_var_table_destroy(effects->globals);
+  ir_var_table_destroy(effects->cached_locals);
+  free(effects->bits);
+  free(effects);
+}
+
+function_effect_t effects_get(const effects_t* effects, size_t function) {
+  assert(effects != NULL);
+  assert(function < callgraph_function_count(effects->cg));
+  
+  uint32_t bits = effects->bits[function];
+  if (bits == 0) {
+    return FUNCTION_EFFECT_READNONE;
+  }
+  if ((bits & EFFECT_WRITES) == 0) {
+    return FUNCTION_EFFECT_READONLY;
+  }
+  return (bits & EFFECT_OTHER) == 0 ? FUNCTION_EFFECT_ARGMEM : FUNCTION_EFFECT_ANY;
+}
+
+uint32_t effects_get_flags(effects_t* effects, ast_node_t* function, ast_node_t* stmt) {
+  assert(effects != NULL);
+  assert(function != NULL && function->type == AST_FUNCTION);
+  assert(stmt != NULL);
+  
+  uint32_t flags = ir_get_flags(stmt);
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  if (ir_get_opcode(stmt) != OPCODE_CALL ||
+      instruction->data.stmt_instruction.operands.count != 1 ||
+      instruction->data.stmt_instruction.operands.nodes[0]->type != AST_EXPR_CALL) {
+    return flags;
+  }
+  
+  /* Locals are cached per function; passes only add fresh names, which hide nothing */
+  if (effects->cached_function != function) {
+    ir_var_table_destroy(effects->cached_locals);
+    effects->cached_locals = collect_locals(effects, function);
+    effects->cached_function = effects->cached_locals != NULL ? function : NULL;
+    if (effects->cached_locals == NULL) {
+      return flags;
+    }
+  }
+  
+  const ir_var_table_t* locals = effects->cached_locals;
+  const ast_node_t* call = instruction->data.stmt_instruction.operands.nodes[0];
+  const ast_node_t* callee = call->data.expr_call.function;
+  const char* def = ir_get_def(stmt);
+  if (callee->type != AST_EXPR_IDENTIFIER ||
+      ir_var_table_find(locals, callee->data.expr_identifier.name) >= 0 ||
+      (def != NULL && is_global(effects, locals, def))) {
+    return flags;
+  }
+  
+  /* Arguments that read globals or make calls keep the full barrier */
+  for (size_t i = 0; i < call->data.expr_call.arguments.count; i++) {
+    const ast_node_t* argument = call->data.expr_call.arguments.nodes[i];
+    if ((argument->type == AST_EXPR_IDENTIFIER &&
+         is_global(effects, locals, argument->data.expr_identifier.name)) ||
+        argument->type == AST_EXPR_FIELD || argument->type == AST_EXPR_INDEX ||
+        argument->type == AST_EXPR_CALL) {
+      return flags;
+    }
+  }
+  
+  int32_t target = callgraph_find(effects->cg, callee->data.expr_identifier.name);
+  if (target < 0) {
+    return flags;
+  }
+  
+  switch (effects_get(effects, (size_t)target)) {
+    case FUNCTION_EFFECT_READNONE:
+      return (flags & ~(uint32_t)(IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY)) |
+             IR_FLAG_MAY_TRAP;
+    
+    case FUNCTION_EFFECT_READONLY:
+      return (flags & ~(uint32_t)IR_FLAG_WRITES_MEMORY) | IR_FLAG_MAY_TRAP;
+    
+    default:
+      return flags;
+  }
+}
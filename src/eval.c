@@ -0,0 +1,812 @@
+/**
+ * @file eval.c
+ * @brief Implementation of the compile-time evaluator.
+ * 
+ * This file contains the purity analysis and the interpreter that runs pure
+ * functions on constant arguments. The interpreter only reads the AST and
+ * its own frames, and every evaluation is bounded in steps, memory and
+ * call depth.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/eval.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Bytes charged for each frame on top of its variables.
+ */
+#define EVAL_FRAME_OVERHEAD 64
+
+/**
+ * @brief Deepest call nesting, which bounds the host stack used.
+ */
+#define EVAL_MAX_DEPTH 512
+
+/**
+ * @brief Evaluation state of a constant.
+ */
+typedef enum {
+  CONSTANT_UNKNOWN = 0,      /**< Not evaluated yet. */
+  CONSTANT_EVALUATING,       /**< Being evaluated; a reference is a cycle. */
+  CONSTANT_DONE,             /**< Value known. */
+  CONSTANT_FAILED            /**< No compile-time value. */
+} constant_state_t;
+
+/**
+ * @brief Function, constant or global known to the evaluator.
+ * 
+ * Globals are only numbered so that writes to them are not taken for
+ * locals; they never have a value.
+ */
+typedef struct {
+  ast_node_t* decl;          /**< Declaration AST node. */
+  ir_var_table_t* vars;      /**< Parameters then locals of a function. */
+  ir_var_table_t* labels;    /**< Block labels of a function, numbered in order. */
+  const ast_node_t** types;  /**< Type of each variable of a function. */
+  int32_t alias;             /**< Symbol sharing the code of an alias, or -1. */
+  bool is_pure;              /**< Whether calls to the function can be evaluated. */
+  constant_state_t state;    /**< Evaluation state of a constant. */
+  int64_t value;             /**< Value of a constant. */
+} eval_symbol_t;
+
+/**
+ * @brief Variables of a running function.
+ */
+typedef struct {
+  const eval_symbol_t* symbol; /**< Running function. */
+  int64_t* values;           /**< Value of each variable. */
+  bool* defined;             /**< Whether each variable holds a value. */
+} eval_frame_t;
+
+/**
+ * @brief Evaluator context structure.
+ */
+struct eval_context {
+  ir_var_table_t* names;     /**< Names of the functions and constants. */
+  eval_symbol_t* symbols;    /**< Symbol of each name. */
+  size_t max_steps;          /**< Step limit of one evaluation. */
+  size_t max_memory;         /**< Memory limit of one evaluation. */
+  size_t steps;              /**< Steps taken by the current evaluation. */
+  size_t memory;             /**< Frame memory held by the current evaluation. */
+  size_t depth;              /**< Current call depth. */
+};
+
+static eval_status_t eval_expr(eval_context_t* context, const eval_frame_t* frame,
+                               const ast_node_t* expr, int64_t* result);
+
+/**
+ * @brief Find the symbol of a function or constant.
+ * 
+ * @param context The evaluator.
+ * @param name The name.
+ * @return The symbol number, or -1 if the name is unknown.
+ */
+static int32_t find_symbol(const eval_context_t* context, const char* name) {
+  return ir_var_table_find(context->names, name);
+}
+
+/**
+ * @brief Check whether an expression only reads what a pure function may read.
+ * 
+ * Calls are accepted here; whether their callees are pure is settled by the
+ * fixpoint in eval_create_context.
+ * 
+ * @param context The evaluator.
+ * @param symbol The function containing the expression.
+ * @param expr The expression (can be NULL).
+ * @return true if the expression may appear in a pure function.
+ */
+static bool is_pure_expr(const eval_context_t* context, const eval_symbol_t* symbol,
+                         const ast_node_t* expr) {
+  if (expr == NULL) {
+    return true;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_INTEGER:
+      return true;
+    
+    case AST_EXPR_IDENTIFIER: {
+      const char* name = expr->data.expr_identifier.name;
+      if (ir_var_table_find(symbol->vars, name) >= 0) {
+        return true;
+      }
+      int32_t id = find_symbol(context, name);
+      return id >= 0 && context->symbols[id].decl->type == AST_CONSTANT;
+    }
+    
+    case AST_EXPR_CALL: {
+      const ast_node_t* callee = expr->data.expr_call.function;
+      if (callee->type != AST_EXPR_IDENTIFIER ||
+          ir_var_table_find(symbol->vars, callee->data.expr_identifier.name) >= 0) {
+        return false;
+      }
+      
+      int32_t id = find_symbol(context, callee->data.expr_identifier.name);
+      if (id < 0 || context->symbols[id].decl->type != AST_FUNCTION) {
+        return false;
+      }
+      
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        if (!is_pure_expr(context, symbol, expr->data.expr_call.arguments.nodes[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Check whether a statement may appear in a pure function.
+ * 
+ * @param context The evaluator.
+ * @param symbol The function containing the statement.
+ * @param stmt The statement.
+ * @return true if the statement may appear in a pure function.
+ */
+static bool is_pure_statement(const eval_context_t* context, const eval_symbol_t* symbol,
+                              ast_node_t* stmt) {
+  switch (stmt->type) {
+    case AST_STMT_BRANCH:
+      return is_pure_expr(context, symbol, stmt->data.stmt_branch.condition);
+    
+    case AST_STMT_RETURN:
+      return stmt->data.stmt_return.value != NULL &&
+             is_pure_expr(context, symbol, stmt->data.stmt_return.value);
+    
+    case AST_STMT_ASSIGN:
+    case AST_STMT_INSTRUCTION: {
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      if (instruction == NULL) {
+        return false;
+      }
+      
+      uint8_t opcode = ir_get_opcode(stmt);
+      uint8_t bits;
+      bool is_signed;
+      if (stmt->type == AST_STMT_ASSIGN &&
+          !ir_integer_type(stmt->data.stmt_assign.target_type, &bits, &is_signed)) {
+        return false;
+      }
+      
+      /* Writing anything but a local is a side effect */
+      if (stmt->type == AST_STMT_ASSIGN &&
+          ir_var_table_find(symbol->vars, stmt->data.stmt_assign.target) < 0) {
+        return false;
+      }
+      
+      const ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+      if (opcode == OPCODE_CALL) {
+        return operands->count == 1 && operands->nodes[0]->type == AST_EXPR_CALL &&
+               is_pure_expr(context, symbol, operands->nodes[0]);
+      }
+      
+      /* Only opcodes the integer folder implements */
+      if ((ir_opcode_flags(opcode) & IR_FLAG_PURE) == 0 || opcode == OPCODE_LEA ||
+          opcode == OPCODE_FMA || operands->count > 2) {
+        return false;
+      }
+      
+      for (size_t i = 0; i < operands->count; i++) {
+        const ast_node_t* operand = operands->nodes[i];
+        if (operand->type == AST_EXPR_CALL || !is_pure_expr(context, symbol, operand)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Check the body of a function, ignoring the purity of its callees.
+ * 
+ * @param context The evaluator.
+ * @param symbol The function symbol.
+ * @return true if the function may be pure.
+ */
+static bool is_pure_body(const eval_context_t* context, const eval_symbol_t* symbol) {
+  const ast_node_t* function = symbol->decl;
+  uint8_t bits;
+  bool is_signed;
+  
+  if (!ir_integer_type(function->data.function.return_type, &bits, &is_signed) ||
+      function->data.function.blocks.count == 0) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    const ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (!ir_integer_type(param->data.parameter.type, &bits, &is_signed)) {
+      return false;
+    }
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    const ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      if (!is_pure_statement(context, symbol, block->data.stmt_block.statements.nodes[j])) {
+        return false;
+      }
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Check whether an expression calls a function that is not pure.
+ * 
+ * @param context The evaluator.
+ * @param expr The expression (can be NULL).
+ * @return true if some call targets a function that is not pure.
+ */
+static bool calls_impure(const eval_context_t* context, const ast_node_t* expr) {
+  if (expr == NULL || expr->type != AST_EXPR_CALL) {
+    return false;
+  }
+  
+  int32_t id = find_symbol(context, expr->data.expr_call.function->data.expr_identifier.name);
+  if (!context->symbols[id].is_pure) {
+    return true;
+  }
+  
+  for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+    if (calls_impure(context, expr->data.expr_call.arguments.nodes[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Check whether a statement calls a function that is not pure.
+ * 
+ * @param context The evaluator.
+ * @param stmt The statement.
+ * @return true if some call of the statement targets a function that is not pure.
+ */
+static bool statement_calls_impure(const eval_context_t* context, ast_node_t* stmt) {
+  switch (stmt->type) {
+    case AST_STMT_BRANCH:
+      return calls_impure(context, stmt->data.stmt_branch.condition);
+    
+    case AST_STMT_RETURN:
+      return calls_impure(context, stmt->data.stmt_return.value);
+    
+    default: {
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      for (size_t i = 0; instruction != NULL &&
+                         i < instruction->data.stmt_instruction.operands.count; i++) {
+        if (calls_impure(context, instruction->data.stmt_instruction.operands.nodes[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief Number the variables and labels of a function.
+ * 
+ * Assignments to globals do not define locals, so they are not numbered.
+ * A local takes the type of its first definition.
+ * 
+ * @param context The evaluator.
+ * @param symbol The function symbol.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool number_function(const eval_context_t* context, eval_symbol_t* symbol) {
+  const ast_node_t* function = symbol->decl;
+  symbol->vars = ir_var_table_create();
+  symbol->labels = ir_var_table_create();
+  if (symbol->vars == NULL || symbol->labels == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    const ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (ir_var_table_intern(symbol->vars, param->data.parameter.name) < 0) {
+      return false;
+    }
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    const ast_node_t* block = function->data.function.blocks.nodes[i];
+    if (ir_var_table_intern(symbol->labels, block->data.stmt_block.label) < 0) {
+      return false;
+    }
+    
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      int32_t id = def != NULL ? find_symbol(context, def) : -1;
+      if (def != NULL && (id < 0 || context->symbols[id].decl->type != AST_GLOBAL) &&
+          ir_var_table_intern(symbol->vars, def) < 0) {
+        return false;
+      }
+    }
+  }
+  
+  size_t count = ir_var_table_count(symbol->vars);
+  symbol->types = calloc(count > 0 ? count : 1, sizeof(ast_node_t*));
+  if (symbol->types == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    symbol->types[i] = function->data.function.parameters.nodes[i]->data.parameter.type;
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    const ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      const ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      const char* def = ir_get_def(stmt);
+      int32_t var = def != NULL ? ir_var_table_find(symbol->vars, def) : -1;
+      if (var >= 0 && symbol->types[var] == NULL && stmt->type == AST_STMT_ASSIGN) {
+        symbol->types[var] = stmt->data.stmt_assign.target_type;
+      }
+    }
+  }
+  
+  return true;
+}
+
+eval_context_t* eval_create_context(ast_node_t* module) {
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  
+  eval_context_t* context = (eval_context_t*)calloc(1, sizeof(eval_context_t));
+  if (context == NULL) {
+    return NULL;
+  }
+  
+  size_t count = module->data.module.declarations.count;
+  context->names = ir_var_table_create();
+  context->symbols = (eval_symbol_t*)calloc(count + 1, sizeof(eval_symbol_t));
+  context->max_steps = EVAL_DEFAULT_MAX_STEPS;
+  context->max_memory = EVAL_DEFAULT_MAX_MEMORY;
+  bool success = context->names != NULL && context->symbols != NULL;
+  
+  /* Number the functions, constants and globals */
+  for (size_t i = 0; i < count && success; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    const char* name = decl->type == AST_FUNCTION ? decl->data.function.name :
+                       decl->type == AST_CONSTANT ? decl->data.constant.name :
+                       decl->type == AST_GLOBAL ? decl->data.global.name : NULL;
+    if (name == NULL) {
+      continue;
+    }
+    
+    int32_t id = ir_var_table_intern(context->names, name);
+    success = id >= 0;
+    if (success && context->symbols[id].decl == NULL) {
+      context->symbols[id].decl = decl;
+      context->symbols[id].alias = -1;
+    }
+  }
+  
+  size_t symbol_count = success ? ir_var_table_count(context->names) : 0;
+  for (size_t i = 0; i < symbol_count && success; i++) {
+    eval_symbol_t* symbol = &context->symbols[i];
+    if (symbol->decl->type == AST_FUNCTION && symbol->decl->data.function.alias == NULL) {
+      success = number_function(context, symbol);
+    }
+  }
+  
+  /* Assume every function is pure, then drop those that break the rules */
+  for (size_t i = 0; i < symbol_count && success; i++) {
+    eval_symbol_t* symbol = &context->symbols[i];
+    if (symbol->decl->type != AST_FUNCTION) {
+      continue;
+    }
+    
+    if (symbol->decl->data.function.alias != NULL) {
+      symbol->alias = find_symbol(context, symbol->decl->data.function.alias);
+      symbol->is_pure = symbol->alias >= 0;
+    } else {
+      symbol->is_pure = is_pure_body(context, symbol);
+    }
+  }
+  
+  bool changed = success;
+  while (changed) {
+    changed = false;
+    for (size_t i = 0; i < symbol_count; i++) {
+      eval_symbol_t* symbol = &context->symbols[i];
+      if (!symbol->is_pure) {
+        continue;
+      }
+      
+      bool impure = false;
+      if (symbol->alias >= 0) {
+        impure = !context->symbols[symbol->alias].is_pure;
+      }
+      
+      const ast_node_t* function = symbol->decl;
+      for (size_t b = 0; b < function->data.function.blocks.count && !impure; b++) {
+        const ast_node_t* block = function->data.function.blocks.nodes[b];
+        for (size_t s = 0; s < block->data.stmt_block.statements.count && !impure; s++) {
+          impure = statement_calls_impure(context, block->data.stmt_block.statements.nodes[s]);
+        }
+      }
+      
+      if (impure) {
+        symbol->is_pure = false;
+        changed = true;
+      }
+    }
+  }
+  
+  if (!success) {
+    eval_destroy_context(context);
+    return NULL;
+  }
+  
+  return context;
+}
+
+void eval_destroy_context(eval_context_t* context) {
+  if (context == NULL) {
+    return;
+  }
+  
+  if (context->symbols != NULL) {
+    size_t count = context->names != NULL ? ir_var_table_count(context->names) : 0;
+    for (size_t i = 0; i < count; i++) {
+      ir_var_table_destroy(context->symbols[i].vars);
+      ir_var_table_destroy(context->symbols[i].labels);
+      free(context->symbols[i].types);
+    }
+  }
+  
+  ir_var_table_destroy(context->names);
+  free(context->symbols);
+  free(context);
+}
+
+void eval_set_limits(eval_context_t* context, size_t max_steps, size_t max_memory) {
+  assert(context != NULL);
+  
+  context->max_steps = max_steps;
+  context->max_memory = max_memory;
+}
+
+bool eval_is_pure(const eval_context_t* context, const char* name) {
+  assert(context != NULL);
+  assert(name != NULL);
+  
+  int32_t id = find_symbol(context, name);
+  return id >= 0 && context->symbols[id].decl->type == AST_FUNCTION &&
+         context->symbols[id].is_pure;
+}
+
+/**
+ * @brief Evaluate a constant declaration by symbol number.
+ * 
+ * @param context The evaluator.
+ * @param id The constant's symbol number.
+ * @param result Where to store the value.
+ * @return EVAL_OK on success, or the reason the constant has no value.
+ */
+static eval_status_t eval_constant_symbol(eval_context_t* context, int32_t id, int64_t* result) {
+  eval_symbol_t* symbol = &context->symbols[id];
+  
+  switch (symbol->state) {
+    case CONSTANT_DONE:
+      *result = symbol->value;
+      return EVAL_OK;
+    
+    case CONSTANT_EVALUATING:
+    case CONSTANT_FAILED:
+      return EVAL_NOT_CONSTANT;
+    
+    default:
+      break;
+  }
+  
+  symbol->state = CONSTANT_EVALUATING;
+  int64_t value;
+  eval_status_t status = eval_expr(context, NULL, symbol->decl->data.constant.value, &value);
+  if (status == EVAL_OK &&
+      !ir_convert_integer(symbol->decl->data.constant.type, value, &symbol->value)) {
+    status = EVAL_NOT_CONSTANT;
+  }
+  
+  /* Running out of a limit says nothing about the constant itself */
+  if (status == EVAL_OK) {
+    symbol->state = CONSTANT_DONE;
+    *result = symbol->value;
+  } else {
+    symbol->state = status == EVAL_NOT_CONSTANT || status == EVAL_TRAP ?
+                    CONSTANT_FAILED : CONSTANT_UNKNOWN;
+  }
+  
+  return status;
+}
+
+/**
+ * @brief Get the type a comparison compares its operands in.
+ * 
+ * Literals take the type of the other operand, so this is the type of the
+ * first operand naming a variable or a constant.
+ * 
+ * @param context The evaluator.
+ * @param symbol The running function.
+ * @param operands The operands of the comparison.
+ * @return The operand type, or NULL if both operands are literals.
+ */
+static const ast_node_t* comparison_type(const eval_context_t* context,
+                                         const eval_symbol_t* symbol,
+                                         const ast_node_list_t* operands) {
+  for (size_t i = 0; i < operands->count; i++) {
+    const ast_node_t* operand = operands->nodes[i];
+    if (operand->type != AST_EXPR_IDENTIFIER) {
+      continue;
+    }
+    
+    const char* name = operand->data.expr_identifier.name;
+    int32_t var = ir_var_table_find(symbol->vars, name);
+    if (var >= 0) {
+      return symbol->types[var];
+    }
+    
+    int32_t id = find_symbol(context, name);
+    if (id >= 0 && context->symbols[id].decl->type == AST_CONSTANT) {
+      return context->symbols[id].decl->data.constant.type;
+    }
+  }
+  
+  return NULL;
+}
+
+/**
+ * @brief Run a pure function.
+ * 
+ * @param context The evaluator.
+ * @param id The function's symbol number.
+ * @param args The argument values.
+ * @param arg_count The number of arguments.
+ * @param result Where to store the return value.
+ * @return EVAL_OK on success, or the reason the call has no value.
+ */
+static eval_status_t eval_function(eval_context_t* context, int32_t id, const int64_t* args,
+                                   size_t arg_count, int64_t* result) {
+  while (context->symbols[id].alias >= 0) {
+    id = context->symbols[id].alias;
+  }
+  
+  const eval_symbol_t* symbol = &context->symbols[id];
+  const ast_node_t* function = symbol->decl;
+  if (!symbol->is_pure || arg_count != function->data.function.parameters.count) {
+    return EVAL_NOT_CONSTANT;
+  }
+  
+  /* Charge the frame against the limits before allocating it */
+  size_t var_count = ir_var_table_count(symbol->vars);
+  size_t frame_size = EVAL_FRAME_OVERHEAD + var_count * (sizeof(int64_t) + sizeof(bool));
+  if (context->depth >= EVAL_MAX_DEPTH || context->memory + frame_size > context->max_memory) {
+    return EVAL_MEMORY_LIMIT;
+  }
+  
+  eval_frame_t frame = { symbol, NULL, NULL };
+  frame.values = (int64_t*)calloc(var_count + 1, sizeof(int64_t));
+  frame.defined = (bool*)calloc(var_count + 1, sizeof(bool));
+  if (frame.values == NULL || frame.defined == NULL) {
+    free(frame.values);
+    free(frame.defined);
+    return EVAL_NO_MEMORY;
+  }
+  
+  context->memory += frame_size;
+  context->depth++;
+  
+  eval_status_t status = EVAL_OK;
+  for (size_t i = 0; i < arg_count && status == EVAL_OK; i++) {
+    const ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (!ir_convert_integer(param->data.parameter.type, args[i], &frame.values[i])) {
+      status = EVAL_NOT_CONSTANT;
+    }
+    frame.defined[i] = true;
+  }
+  
+  size_t block = 0;
+  bool returned = false;
+  while (status == EVAL_OK && !returned) {
+    if (block >= function->data.function.blocks.count) {
+      /* Fell off the end of the function */
+      status = EVAL_NOT_CONSTANT;
+      break;
+    }
+    
+    const ast_node_list_t* statements =
+      &function->data.function.blocks.nodes[block]->data.stmt_block.statements;
+    size_t next = block + 1;
+    
+    for (size_t i = 0; i < statements->count && status == EVAL_OK; i++) {
+      ast_node_t* stmt = statements->nodes[i];
+      if (++context->steps > context->max_steps) {
+        status = EVAL_STEP_LIMIT;
+        break;
+      }
+      
+      if (stmt->type == AST_STMT_RETURN) {
+        int64_t value;
+        status = eval_expr(context, &frame, stmt->data.stmt_return.value, &value);
+        if (status == EVAL_OK &&
+            !ir_convert_integer(function->data.function.return_type, value, result)) {
+          status = EVAL_NOT_CONSTANT;
+        }
+        returned = true;
+        break;
+      }
+      
+      if (stmt->type == AST_STMT_BRANCH) {
+        const char* target = stmt->data.stmt_branch.true_target;
+        if (stmt->data.stmt_branch.condition != NULL) {
+          int64_t condition;
+          status = eval_expr(context, &frame, stmt->data.stmt_branch.condition, &condition);
+          if (status == EVAL_OK && condition == 0 &&
+              stmt->data.stmt_branch.false_target != NULL) {
+            target = stmt->data.stmt_branch.false_target;
+          }
+        }
+        
+        int32_t label = ir_var_table_find(symbol->labels, target);
+        if (label < 0 && status == EVAL_OK) {
+          status = EVAL_NOT_CONSTANT;
+        }
+        next = (size_t)label;
+        break;
+      }
+      
+      /* Assignments and instructions */
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      const ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+      uint8_t opcode = ir_get_opcode(stmt);
+      int64_t values[2] = { 0, 0 };
+      int64_t value = 0;
+      
+      for (size_t k = 0; k < operands->count && status == EVAL_OK; k++) {
+        status = eval_expr(context, &frame, operands->nodes[k], &values[k]);
+      }
+      if (status != EVAL_OK || stmt->type != AST_STMT_ASSIGN) {
+        continue;
+      }
+      
+      const ast_node_t* type = stmt->data.stmt_assign.target_type;
+      if (opcode == OPCODE_CALL) {
+        if (!ir_convert_integer(type, values[0], &value)) {
+          status = EVAL_NOT_CONSTANT;
+        }
+      } else if (!ir_fold_integer(opcode,
+                                  ir_is_comparison(opcode) ?
+                                      comparison_type(context, symbol, operands) : type,
+                                  values, operands->count, &value)) {
+        status = EVAL_TRAP;
+      }
+      
+      int32_t var = ir_var_table_find(symbol->vars, stmt->data.stmt_assign.target);
+      frame.values[var] = value;
+      frame.defined[var] = true;
+    }
+    
+    block = next;
+  }
+  
+  context->depth--;
+  context->memory -= frame_size;
+  free(frame.values);
+  free(frame.defined);
+  
+  return status;
+}
+
+/**
+ * @brief Evaluate an expression in a frame.
+ * 
+ * @param context The evaluator.
+ * @param frame The running function, or NULL outside any function.
+ * @param expr The expression.
+ * @param result Where to store the value.
+ * @return EVAL_OK on success, or the reason the expression has no value.
+ */
+static eval_status_t eval_expr(eval_context_t* context, const eval_frame_t* frame,
+                               const ast_node_t* expr, int64_t* result) {
+  switch (expr->type) {
+    case AST_EXPR_INTEGER:
+      *result = expr->data.expr_integer.value;
+      return EVAL_OK;
+    
+    case AST_EXPR_IDENTIFIER: {
+      const char* name = expr->data.expr_identifier.name;
+      int32_t var = frame != NULL ? ir_var_table_find(frame->symbol->vars, name) : -1;
+      if (var >= 0) {
+        if (!frame->defined[var]) {
+          return EVAL_NOT_CONSTANT;
+        }
+        *result = frame->values[var];
+        return EVAL_OK;
+      }
+      
+      int32_t id = find_symbol(context, name);
+      if (id < 0 || context->symbols[id].decl->type != AST_CONSTANT) {
+        return EVAL_NOT_CONSTANT;
+      }
+      return eval_constant_symbol(context, id, result);
+    }
+    
+    case AST_EXPR_CALL: {
+      const ast_node_t* callee = expr->data.expr_call.function;
+      int32_t id = callee->type == AST_EXPR_IDENTIFIER ?
+                   find_symbol(context, callee->data.expr_identifier.name) : -1;
+      if (id < 0 || context->symbols[id].decl->type != AST_FUNCTION) {
+        return EVAL_NOT_CONSTANT;
+      }
+      
+      size_t count = expr->data.expr_call.arguments.count;
+      int64_t* args = (int64_t*)malloc((count + 1) * sizeof(int64_t));
+      if (args == NULL) {
+        return EVAL_NO_MEMORY;
+      }
+      
+      eval_status_t status = EVAL_OK;
+      for (size_t i = 0; i < count && status == EVAL_OK; i++) {
+        status = eval_expr(context, frame, expr->data.expr_call.arguments.nodes[i], &args[i]);
+      }
+      if (status == EVAL_OK) {
+        status = eval_function(context, id, args, count, result);
+      }
+      
+      free(args);
+      return status;
+    }
+    
+    default:
+      return EVAL_NOT_CONSTANT;
+  }
+}
+
+eval_status_t eval_expression(eval_context_t* context, const ast_node_t* expr,
+                              int64_t* result) {
+  assert(context != NULL);
+  assert(expr != NULL);
+  assert(result != NULL);
+  
+  context->steps = 0;
+  context->memory = 0;
+  context->depth = 0;
+  
+  return eval_expr(context, NULL, expr, result);
+}
+
+eval_status_t eval_constant(eval_context_t* context, const char* name, int64_t* result) {
+  assert(context != NULL);
+  assert(name != NULL);
+  assert(result != NULL);
+  
+  int32_t id = find_symbol(context, name);
+  if (id < 0 || context->symbols[id].decl->type != AST_CONSTANT) {
+    return EVAL_NOT_CONSTANT;
+  }
+  
+  context->steps = 0;
+  context->memory = 0;
+  context->depth = 0;
+  
+  return eval_constant_symbol(context, id, result);
+}
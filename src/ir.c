@@ -0,0 +1,883 @@
+/**
+ * @file ir.c
+ * @brief Implementation of the optimizer IR helpers.
+ * 
+ * This file contains the instruction property table, def/use queries,
+ * constant folding, the variable numbering table, bit sets and canonical
+ * keys.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include "../include/codegen.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Opcode property mapping structure.
+ */
+typedef struct {
+  uint8_t opcode;      /**< COIL opcode. */
+  uint32_t flags;      /**< Property flags. */
+} opcode_property_t;
+
+/**
+ * @brief Variable numbering table structure.
+ */
+struct ir_var_table {
+  char** names;        /**< Variable names, indexed by number. */
+  size_t count;        /**< Number of variables. */
+  size_t capacity;     /**< Capacity of the names array. */
+  int32_t* buckets;    /**< Open-addressed hash buckets holding numbers, -1 if empty. */
+  size_t bucket_count; /**< Number of buckets (a power of two). */
+};
+
+/**
+ * @brief Opcode property table.
+ */
+static const opcode_property_t opcode_properties[] = {
+  { OPCODE_ADD, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_SUB, IR_FLAG_PURE },
+  { OPCODE_MUL, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_DIV, IR_FLAG_PURE | IR_FLAG_MAY_TRAP },
+  { OPCODE_REM, IR_FLAG_PURE | IR_FLAG_MAY_TRAP },
+  { OPCODE_NEG, IR_FLAG_PURE },
+  { OPCODE_ABS, IR_FLAG_PURE },
+  { OPCODE_MIN, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_MAX, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_FMA, IR_FLAG_PURE },
+  { OPCODE_MULH, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_ADD_WIDE, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_MUL_WIDE, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_ADD_SAT, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_SUB_SAT, IR_FLAG_PURE },
+  
+  { OPCODE_AND, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_OR,  IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_XOR, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_NOT, IR_FLAG_PURE },
+  { OPCODE_SHL, IR_FLAG_PURE },
+  { OPCODE_SHR, IR_FLAG_PURE },
+  { OPCODE_POPCNT, IR_FLAG_PURE },
+  { OPCODE_CLZ, IR_FLAG_PURE },
+  { OPCODE_CTZ, IR_FLAG_PURE },
+  { OPCODE_BSWAP, IR_FLAG_PURE },
+  { OPCODE_ROTL, IR_FLAG_PURE },
+  { OPCODE_ROTR, IR_FLAG_PURE },
+  
+  { OPCODE_CMP_EQ, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_CMP_NE, IR_FLAG_PURE | IR_FLAG_COMMUTATIVE },
+  { OPCODE_CMP_LT, IR_FLAG_PURE },
+  { OPCODE_CMP_LE, IR_FLAG_PURE },
+  { OPCODE_CMP_GT, IR_FLAG_PURE },
+  { OPCODE_CMP_GE, IR_FLAG_PURE },
+  
+  { OPCODE_LOAD, IR_FLAG_READS_MEMORY },
+  { OPCODE_STORE, IR_FLAG_WRITES_MEMORY },
+  { OPCODE_LEA, IR_FLAG_PURE },
+  { OPCODE_FENCE, IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY },
+  { OPCODE_ATOMIC_LOAD, IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY },
+  { OPCODE_ATOMIC_STORE, IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY },
+  { OPCODE_ATOMIC_RMW, IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY },
+  { OPCODE_CMPXCHG, IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY },
+  { OPCODE_PREFETCH, IR_FLAG_READS_MEMORY },
+  
+  { OPCODE_SPLAT, IR_FLAG_PURE },
+  { OPCODE_EXTRACT, IR_FLAG_PURE },
+  { OPCODE_INSERT, IR_FLAG_PURE },
+  { OPCODE_SHUFFLE, IR_FLAG_PURE },
+  { OPCODE_REDUCE_ADD, IR_FLAG_PURE },
+  { OPCODE_REDUCE_MIN, IR_FLAG_PURE },
+  { OPCODE_REDUCE_MAX, IR_FLAG_PURE },
+  
+  { OPCODE_BR, IR_FLAG_TERMINATOR },
+  { OPCODE_BR_COND, IR_FLAG_TERMINATOR },
+  { OPCODE_SWITCH, IR_FLAG_TERMINATOR },
+  { OPCODE_CALL, IR_FLAG_CALL | IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY },
+  { OPCODE_RET, IR_FLAG_TERMINATOR },
+  
+  { 0, 0 }  /* Sentinel */
+};
+
+uint32_t ir_opcode_flags(uint8_t opcode) {
+  for (int i = 0; opcode_properties[i].opcode != 0; i++) {
+    if (opcode_properties[i].opcode == opcode) {
+      return opcode_properties[i].flags;
+    }
+  }
+  
+  /* Unknown opcodes are treated as having every side effect */
+  return IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY | IR_FLAG_MAY_TRAP;
+}
+
+bool ir_is_comparison(uint8_t opcode) {
+  return opcode >= OPCODE_CMP_EQ && opcode <= OPCODE_CMP_GE;
+}
+
+ast_node_t* ir_get_instruction(ast_node_t* stmt) {
+  assert(stmt != NULL);
+  
+  switch (stmt->type) {
+    case AST_STMT_ASSIGN:
+      return stmt->data.stmt_assign.value->type == AST_STMT_INSTRUCTION ?
+             stmt->data.stmt_assign.value : NULL;
+    
+    case AST_STMT_INSTRUCTION:
+      return stmt;
+    
+    default:
+      return NULL;
+  }
+}
+
+uint8_t ir_get_opcode(ast_node_t* stmt) {
+  assert(stmt != NULL);
+  
+  switch (stmt->type) {
+    case AST_STMT_BRANCH:
+      return stmt->data.stmt_branch.condition != NULL ? OPCODE_BR_COND : OPCODE_BR;
+    
+    case AST_STMT_RETURN:
+      return OPCODE_RET;
+    
+    default: {
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      if (instruction == NULL) {
+        return 0;
+      }
+      
+      return codegen_lookup_opcode(instruction->data.stmt_instruction.opcode);
+    }
+  }
+}
+
+uint32_t ir_get_flags(ast_node_t* stmt) {
+  assert(stmt != NULL);
+  
+  return ir_opcode_flags(ir_get_opcode(stmt));
+}
+
+const char* ir_get_def(const ast_node_t* stmt) {
+  assert(stmt != NULL);
+  
+  if (stmt->type == AST_STMT_ASSIGN) {
+    return stmt->data.stmt_assign.target;
+  }
+  
+  return NULL;
+}
+
+/**
+ * @brief Visit the variable uses of an expression.
+ * 
+ * @param slot Slot holding the expression.
+ * @param visitor The visitor function.
+ * @param data User data passed to the visitor.
+ */
+static void visit_expr_uses(ast_node_t** slot, ir_use_visitor_t visitor, void* data) {
+  ast_node_t* expr = *slot;
+  if (expr == NULL) {
+    return;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_IDENTIFIER:
+      visitor(slot, data);
+      break;
+    
+    case AST_EXPR_FIELD:
+      visit_expr_uses(&expr->data.expr_field.object, visitor, data);
+      break;
+    
+    case AST_EXPR_INDEX:
+      visit_expr_uses(&expr->data.expr_index.array, visitor, data);
+      visit_expr_uses(&expr->data.expr_index.index, visitor, data);
+      break;
+    
+    case AST_EXPR_CALL:
+      visit_expr_uses(&expr->data.expr_call.function, visitor, data);
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        visit_expr_uses(&expr->data.expr_call.arguments.nodes[i], visitor, data);
+      }
+      break;
+    
+    default:
+      /* Literals use no variables */
+      break;
+  }
+}
+
+void ir_visit_uses(ast_node_t* stmt, ir_use_visitor_t visitor, void* data) {
+  assert(stmt != NULL);
+  assert(visitor != NULL);
+  
+  switch (stmt->type) {
+    case AST_STMT_BRANCH:
+      visit_expr_uses(&stmt->data.stmt_branch.condition, visitor, data);
+      break;
+    
+    case AST_STMT_RETURN:
+      visit_expr_uses(&stmt->data.stmt_return.value, visitor, data);
+      break;
+    
+    default: {
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      if (instruction == NULL) {
+        return;
+      }
+      
+      ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+      for (size_t i = 0; i < operands->count; i++) {
+        visit_expr_uses(&operands->nodes[i], visitor, data);
+      }
+      break;
+    }
+  }
+}
+
+bool ir_integer_type(const ast_node_t* type, uint8_t* bits, bool* is_signed) {
+  assert(bits != NULL);
+  assert(is_signed != NULL);
+  
+  if (type == NULL) {
+    return false;
+  }
+  
+  switch (type->type) {
+    case AST_TYPE_BOOL:
+      *bits = 1;
+      *is_signed = false;
+      return true;
+    
+    case AST_TYPE_INT:
+      if (type->data.type_int.bits == 0 || type->data.type_int.bits > 64) {
+        return false;
+      }
+      *bits = type->data.type_int.bits;
+      *is_signed = type->data.type_int.is_signed;
+      return true;
+    
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Truncate a value to an integer width and extend it back to 64 bits.
+ * 
+ * @param value The value.
+ * @param bits The integer width.
+ * @param is_signed Whether to sign-extend instead of zero-extend.
+ * @return The wrapped value.
+ */
+static int64_t wrap_integer(uint64_t value, uint8_t bits, bool is_signed) {
+  if (bits >= 64) {
+    return (int64_t)value;
+  }
+  
+  uint64_t mask = (UINT64_C(1) << bits) - 1;
+  value &= mask;
+  if (is_signed && (value >> (bits - 1)) != 0) {
+    value |= ~mask;
+  }
+  
+  return (int64_t)value;
+}
+
+bool ir_convert_integer(const ast_node_t* type, int64_t value, int64_t* result) {
+  assert(result != NULL);
+  
+  uint8_t bits;
+  bool is_signed;
+  if (!ir_integer_type(type, &bits, &is_signed)) {
+    return false;
+  }
+  
+  *result = wrap_integer((uint64_t)value, bits, is_signed);
+  return true;
+}
+
+bool ir_integer_literal(const ast_node_t* type, int64_t value, int64_t* result) {
+  uint8_t bits;
+  bool is_signed;
+  return ir_convert_integer(type, value, result) && ir_integer_type(type, &bits, &is_signed) &&
+         (is_signed || *result >= 0);
+}
+
+/**
+ * @brief Compute the high half of the double-width product of two integers.
+ * 
+ * @param a The first operand, sign- or zero-extended from the width.
+ * @param b The second operand, sign- or zero-extended from the width.
+ * @param bits The integer width.
+ * @param is_signed Whether the operands are signed.
+ * @return The bits of the product from the width up, not yet wrapped.
+ */
+static uint64_t multiply_high(int64_t a, int64_t b, uint8_t bits, bool is_signed) {
+  uint64_t ua = (uint64_t)wrap_integer((uint64_t)a, bits, false);
+  uint64_t ub = (uint64_t)wrap_integer((uint64_t)b, bits, false);
+  
+  /* Unsigned 128-bit product from 32-bit halves */
+  uint64_t low_low = (ua & 0xFFFFFFFF) * (ub & 0xFFFFFFFF);
+  uint64_t high_low = (ua >> 32) * (ub & 0xFFFFFFFF);
+  uint64_t low_high = (ua & 0xFFFFFFFF) * (ub >> 32);
+  uint64_t cross = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+  uint64_t high = (ua >> 32) * (ub >> 32) + (high_low >> 32) + (cross >> 32);
+  uint64_t low = (cross << 32) | (low_low & 0xFFFFFFFF);
+  
+  uint64_t result = bits >= 64 ? high : (low >> bits) | (high << (64 - bits));
+  
+  /* A negative operand contributes its unsigned value minus 2^bits */
+  if (is_signed) {
+    result -= (a < 0 ? ub : 0) + (b < 0 ? ua : 0);
+  }
+  return result;
+}
+
+/**
+ * @brief Add or subtract two integers, clamping to the range of their type.
+ * 
+ * @param add Whether to add instead of subtract.
+ * @param a The first operand, sign- or zero-extended from the width.
+ * @param b The second operand, sign- or zero-extended from the width.
+ * @param bits The integer width.
+ * @param is_signed Whether the operands are signed.
+ * @return The clamped result.
+ */
+static uint64_t saturate(bool add, int64_t a, int64_t b, uint8_t bits, bool is_signed) {
+  if (!is_signed) {
+    uint64_t ua = (uint64_t)a;
+    uint64_t ub = (uint64_t)b;
+    uint64_t max = bits >= 64 ? UINT64_MAX : (UINT64_C(1) << bits) - 1;
+    if (!add) {
+      return ua < ub ? 0 : ua - ub;
+    }
+    return ua + ub < ua || ua + ub > max ? max : ua + ub;
+  }
+  
+  /* The bounds are compared against without overflowing 64 bits */
+  int64_t max = bits >= 64 ? INT64_MAX : (int64_t)((UINT64_C(1) << (bits - 1)) - 1);
+  int64_t min = -max - 1;
+  if (add ? (b > 0 && a > max - b) : (b < 0 && a > max + b)) {
+    return (uint64_t)max;
+  }
+  if (add ? (b < 0 && a < min - b) : (b > 0 && a < min + b)) {
+    return (uint64_t)min;
+  }
+  return add ? (uint64_t)a + (uint64_t)b : (uint64_t)a - (uint64_t)b;
+}
+
+/**
+ * @brief Compare two integers as values of a type.
+ * 
+ * @param opcode The comparison opcode.
+ * @param type The operand type, or NULL for signed 64-bit values.
+ * @param operands The two operand values.
+ * @param result Where to store 0 or 1.
+ * @return true on success, false if the type is not an integer type.
+ */
+static bool compare_integers(uint8_t opcode, const ast_node_t* type, const int64_t* operands,
+                             int64_t* result) {
+  uint8_t bits = 64;
+  bool is_signed = true;
+  if (type != NULL && !ir_integer_type(type, &bits, &is_signed)) {
+    return false;
+  }
+  
+  int64_t a = wrap_integer((uint64_t)operands[0], bits, is_signed);
+  int64_t b = wrap_integer((uint64_t)operands[1], bits, is_signed);
+  bool less = is_signed ? a < b : (uint64_t)a < (uint64_t)b;
+  
+  switch (opcode) {
+    case OPCODE_CMP_EQ: *result = a == b; return true;
+    case OPCODE_CMP_NE: *result = a != b; return true;
+    case OPCODE_CMP_LT: *result = less; return true;
+    case OPCODE_CMP_LE: *result = less || a == b; return true;
+    case OPCODE_CMP_GT: *result = !less && a != b; return true;
+    case OPCODE_CMP_GE: *result = !less; return true;
+    default: return false;
+  }
+}
+
+bool ir_fold_integer(uint8_t opcode, const ast_node_t* type, const int64_t* operands,
+                     size_t count, int64_t* result) {
+  assert(operands != NULL || count == 0);
+  assert(result != NULL);
+  
+  if (ir_is_comparison(opcode)) {
+    return count == 2 && compare_integers(opcode, type, operands, result);
+  }
+  
+  uint8_t bits;
+  bool is_signed;
+  if (!ir_integer_type(type, &bits, &is_signed)) {
+    return false;
+  }
+  
+  bool unary = opcode == OPCODE_NEG || opcode == OPCODE_ABS || opcode == OPCODE_NOT ||
+               opcode == OPCODE_POPCNT || opcode == OPCODE_CLZ || opcode == OPCODE_CTZ ||
+               opcode == OPCODE_BSWAP;
+  size_t arity = unary ? 1 : 2;
+  if (count != arity) {
+    return false;
+  }
+  
+  /* Operands as held in a register of the result type */
+  int64_t a = wrap_integer((uint64_t)operands[0], bits, is_signed);
+  int64_t b = arity > 1 ? wrap_integer((uint64_t)operands[1], bits, is_signed) : 0;
+  uint64_t ua = (uint64_t)wrap_integer((uint64_t)a, bits, false);
+  uint64_t ub = (uint64_t)wrap_integer((uint64_t)b, bits, false);
+  bool less = is_signed ? a < b : ua < ub;
+  uint64_t value;
+  
+  switch (opcode) {
+    case OPCODE_ADD: value = (uint64_t)a + (uint64_t)b; break;
+    case OPCODE_SUB: value = (uint64_t)a - (uint64_t)b; break;
+    case OPCODE_MUL: value = (uint64_t)a * (uint64_t)b; break;
+    case OPCODE_MULH: value = multiply_high(a, b, bits, is_signed); break;
+    case OPCODE_ADD_SAT: value = saturate(true, a, b, bits, is_signed); break;
+    case OPCODE_SUB_SAT: value = saturate(false, a, b, bits, is_signed); break;
+    
+    /* The operands fit the doubled width of the result, so nothing wraps */
+    case OPCODE_ADD_WIDE: value = (uint64_t)a + (uint64_t)b; break;
+    case OPCODE_MUL_WIDE: value = (uint64_t)a * (uint64_t)b; break;
+    case OPCODE_NEG: value = 0 - (uint64_t)a; break;
+    case OPCODE_ABS: value = (is_signed && a < 0) ? 0 - (uint64_t)a : (uint64_t)a; break;
+    case OPCODE_MIN: value = (uint64_t)(less ? a : b); break;
+    case OPCODE_MAX: value = (uint64_t)(less ? b : a); break;
+    case OPCODE_AND: value = (uint64_t)a & (uint64_t)b; break;
+    case OPCODE_OR:  value = (uint64_t)a | (uint64_t)b; break;
+    case OPCODE_XOR: value = (uint64_t)a ^ (uint64_t)b; break;
+    case OPCODE_NOT: value = ~(uint64_t)a; break;
+    
+    case OPCODE_DIV:
+    case OPCODE_REM:
+      if (ub == 0 || (is_signed && a == INT64_MIN && b == -1)) {
+        return false;
+      }
+      if (is_signed) {
+        value = (uint64_t)(opcode == OPCODE_DIV ? a / b : a % b);
+      } else {
+        value = opcode == OPCODE_DIV ? ua / ub : ua % ub;
+      }
+      break;
+    
+    case OPCODE_SHL:
+    case OPCODE_SHR:
+      if (ub >= bits) {
+        return false;
+      }
+      if (opcode == OPCODE_SHL) {
+        value = ua << ub;
+      } else if (is_signed && a < 0) {
+        value = ~(~(uint64_t)a >> ub);
+      } else {
+        value = ua >> ub;
+      }
+      break;
+    
+    case OPCODE_POPCNT:
+      value = 0;
+      for (uint64_t bit = ua; bit != 0; bit &= bit - 1) {
+        value++;
+      }
+      break;
+    
+    case OPCODE_CLZ:
+      value = bits;
+      for (uint64_t rest = ua; rest != 0; rest >>= 1) {
+        value--;
+      }
+      break;
+    
+    case OPCODE_CTZ:
+      value = ua == 0 ? bits : 0;
+      while (ua != 0 && ((ua >> value) & 1) == 0) {
+        value++;
+      }
+      break;
+    
+    case OPCODE_BSWAP:
+      if (bits % 16 != 0) {
+        return false;
+      }
+      value = 0;
+      for (uint8_t shift = 0; shift < bits; shift += 8) {
+        value = (value << 8) | ((ua >> shift) & 0xFF);
+      }
+      break;
+    
+    case OPCODE_ROTL:
+    case OPCODE_ROTR: {
+      uint64_t amount = ub % bits;
+      if (amount == 0) {
+        value = ua;
+      } else if (opcode == OPCODE_ROTL) {
+        value = (ua << amount) | (ua >> (bits - amount));
+      } else {
+        value = (ua >> amount) | (ua << (bits - amount));
+      }
+      break;
+    }
+    
+    default:
+      return false;
+  }
+  
+  *result = wrap_integer(value, bits, is_signed);
+  return true;
+}
+
+/**
+ * @brief Hash a variable name (FNV-1a).
+ * 
+ * @param name The variable name.
+ * @return The hash value.
+ */
+static uint32_t hash_name(const char* name) {
+  uint32_t hash = 2166136261u;
+  for (const char* p = name; *p != '\0'; p++) {
+    hash ^= (uint8_t)*p;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief Find the bucket holding a name, or the empty bucket where it belongs.
+ * 
+ * @param table The table.
+ * @param name The variable name.
+ * @return The bucket index.
+ */
+static size_t find_bucket(const ir_var_table_t* table, const char* name) {
+  size_t mask = table->bucket_count - 1;
+  size_t bucket = hash_name(name) & mask;
+  
+  while (table->buckets[bucket] >= 0 &&
+         strcmp(table->names[table->buckets[bucket]], name) != 0) {
+    bucket = (bucket + 1) & mask;
+  }
+  
+  return bucket;
+}
+
+/**
+ * @brief Grow the hash buckets and rehash all names.
+ * 
+ * @param table The table.
+ * @return true on success, false on allocation failure.
+ */
+static bool grow_buckets(ir_var_table_t* table) {
+  size_t new_count = table->bucket_count == 0 ? 32 : table->bucket_count * 2;
+  int32_t* new_buckets = (int32_t*)malloc(new_count * sizeof(int32_t));
+  if (new_buckets == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < new_count; i++) {
+    new_buckets[i] = -1;
+  }
+  
+  free(table->buckets);
+  table->buckets = new_buckets;
+  table->bucket_count = new_count;
+  
+  for (size_t i = 0; i < table->count; i++) {
+    table->buckets[find_bucket(table, table->names[i])] = (int32_t)i;
+  }
+  
+  return true;
+}
+
+ir_var_table_t* ir_var_table_create(void) {
+  ir_var_table_t* table = (ir_var_table_t*)malloc(sizeof(ir_var_table_t));
+  if (table == NULL) {
+    return NULL;
+  }
+  
+  table->names = NULL;
+  table->count = 0;
+  table->capacity = 0;
+  table->buckets = NULL;
+  table->bucket_count = 0;
+  
+  if (!grow_buckets(table)) {
+    free(table);
+    return NULL;
+  }
+  
+  return table;
+}
+
+void ir_var_table_destroy(ir_var_table_t* table) {
+  if (table == NULL) {
+    return;
+  }
+  
+  for (size_t i = 0; i < table->count; i++) {
+    free(table->names[i]);
+  }
+  free(table->names);
+  free(table->buckets);
+  free(table);
+}
+
+int32_t ir_var_table_intern(ir_var_table_t* table, const char* name) {
+  assert(table != NULL);
+  assert(name != NULL);
+  
+  size_t bucket = find_bucket(table, name);
+  if (table->buckets[bucket] >= 0) {
+    return table->buckets[bucket];
+  }
+  
+  /* Keep the load factor at or below one half */
+  if ((table->count + 1) * 2 > table->bucket_count) {
+    if (!grow_buckets(table)) {
+      return -1;
+    }
+    bucket = find_bucket(table, name);
+  }
+  
+  /* Check if we need to resize the names array */
+  if (table->count >= table->capacity) {
+    size_t new_capacity = table->capacity == 0 ? 16 : table->capacity * 2;
+    char** new_names = (char**)realloc(table->names, new_capacity * sizeof(char*));
+    if (new_names == NULL) {
+      return -1;
+    }
+    
+    table->names = new_names;
+    table->capacity = new_capacity;
+  }
+  
+  char* copy = strdup(name);
+  if (copy == NULL) {
+    return -1;
+  }
+  
+  int32_t id = (int32_t)table->count;
+  table->names[table->count++] = copy;
+  table->buckets[bucket] = id;
+  
+  return id;
+}
+
+int32_t ir_var_table_find(const ir_var_table_t* table, const char* name) {
+  assert(table != NULL);
+  assert(name != NULL);
+  
+  return table->buckets[find_bucket(table, name)];
+}
+
+size_t ir_var_table_count(const ir_var_table_t* table) {
+  assert(table != NULL);
+  
+  return table->count;
+}
+
+const char* ir_var_table_name(const ir_var_table_t* table, int32_t id) {
+  assert(table != NULL);
+  assert(id >= 0 && (size_t)id < table->count);
+  
+  return table->names[id];
+}
+
+/**
+ * @brief Number of 64-bit words needed for a bit count.
+ */
+#define BITSET_WORDS(size) (((size) + 63) / 64)
+
+bool ir_bitset_init(ir_bitset_t* set, size_t size) {
+  assert(set != NULL);
+  
+  set->size = size;
+  set->words = (uint64_t*)calloc(BITSET_WORDS(size) > 0 ? BITSET_WORDS(size) : 1, 
+                                 sizeof(uint64_t));
+  return set->words != NULL;
+}
+
+void ir_bitset_free(ir_bitset_t* set) {
+  if (set == NULL) {
+    return;
+  }
+  
+  free(set->words);
+  set->words = NULL;
+  set->size = 0;
+}
+
+void ir_bitset_set(ir_bitset_t* set, size_t bit) {
+  assert(set != NULL && bit < set->size);
+  
+  set->words[bit / 64] |= (uint64_t)1 << (bit % 64);
+}
+
+void ir_bitset_clear(ir_bitset_t* set, size_t bit) {
+  assert(set != NULL && bit < set->size);
+  
+  set->words[bit / 64] &= ~((uint64_t)1 << (bit % 64));
+}
+
+bool ir_bitset_test(const ir_bitset_t* set, size_t bit) {
+  assert(set != NULL && bit < set->size);
+  
+  return (set->words[bit / 64] >> (bit % 64)) & 1;
+}
+
+void ir_bitset_copy(ir_bitset_t* dest, const ir_bitset_t* src) {
+  assert(dest != NULL && src != NULL && dest->size == src->size);
+  
+  memcpy(dest->words, src->words, BITSET_WORDS(src->size) * sizeof(uint64_t));
+}
+
+bool ir_bitset_union(ir_bitset_t* dest, const ir_bitset_t* src) {
+  assert(dest != NULL && src != NULL && dest->size == src->size);
+  
+  bool changed = false;
+  for (size_t i = 0; i < BITSET_WORDS(src->size); i++) {
+    uint64_t merged = dest->words[i] | src->words[i];
+    changed |= merged != dest->words[i];
+    dest->words[i] = merged;
+  }
+  
+  return changed;
+}
+
+void ir_key_reset(ir_key_t* key) {
+  assert(key != NULL);
+  
+  key->length = 0;
+  if (key->data != NULL) {
+    key->data[0] = '\0';
+  }
+}
+
+void ir_key_free(ir_key_t* key) {
+  if (key == NULL) {
+    return;
+  }
+  
+  free(key->data);
+  key->data = NULL;
+  key->length = 0;
+  key->capacity = 0;
+}
+
+void ir_key_append(ir_key_t* key, const char* format, ...) {
+  assert(key != NULL);
+  assert(format != NULL);
+  
+  while (!key->failed) {
+    size_t room = key->capacity - key->length;
+    va_list args;
+    va_start(args, format);
+    int written = room > 0 ? vsnprintf(key->data + key->length, room, format, args) : 0;
+    va_end(args);
+    
+    if (written < 0) {
+      key->failed = true;
+      return;
+    }
+    if (room > 0 && (size_t)written < room) {
+      key->length += (size_t)written;
+      return;
+    }
+    
+    /* Grow until the formatted text and its terminator fit */
+    size_t new_capacity = key->capacity == 0 ? 256 : key->capacity * 2;
+    while (new_capacity - key->length <= (size_t)written) {
+      new_capacity *= 2;
+    }
+    
+    char* new_data = (char*)realloc(key->data, new_capacity);
+    if (new_data == NULL) {
+      key->failed = true;
+      if (key->data != NULL) {
+        key->data[key->length] = '\0';
+      }
+      return;
+    }
+    
+    key->data = new_data;
+    key->capacity = new_capacity;
+  }
+}
+
+void ir_key_append_type(ir_key_t* key, const ast_node_t* type) {
+  assert(key != NULL);
+  
+  if (type == NULL) {
+    ir_key_append(key, "?");
+    return;
+  }
+  
+  switch (type->type) {
+    case AST_TYPE_VOID:
+      ir_key_append(key, "v");
+      break;
+      
+    case AST_TYPE_BOOL:
+      ir_key_append(key, "b");
+      break;
+      
+    case AST_TYPE_INT:
+      ir_key_append(key, "%c%u", type->data.type_int.is_signed ? 'i' : 'u',
+                    (unsigned)type->data.type_int.bits);
+      break;
+      
+    case AST_TYPE_FLOAT:
+      ir_key_append(key, "f%u", (unsigned)type->data.type_float.bits);
+      break;
+      
+    case AST_TYPE_PTR:
+      ir_key_append(key, "p(");
+      ir_key_append_type(key, type->data.type_ptr.element_type);
+      ir_key_append(key, ",%s%s)", type->data.type_ptr.memory_space ?
+                    type->data.type_ptr.memory_space : "",
+                    type->data.type_ptr.is_restrict ? ",restrict" : "");
+      break;
+      
+    case AST_TYPE_VEC:
+      ir_key_append(key, "x%u(", (unsigned)type->data.type_vec.size);
+      ir_key_append_type(key, type->data.type_vec.element_type);
+      ir_key_append(key, ")");
+      break;
+      
+    case AST_TYPE_ARRAY:
+      ir_key_append(key, "a%u(", (unsigned)type->data.type_array.size);
+      ir_key_append_type(key, type->data.type_array.element_type);
+      ir_key_append(key, ")");
+      break;
+      
+    default:
+      /* Aggregates are only equal to themselves */
+      ir_key_append(key, "t%p", (const void*)type);
+      break;
+  }
+}
+
+uint64_t ir_key_hash(const ir_key_t* key) {
+  assert(key != NULL);
+  
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < key->length; i++) {
+    hash ^= (uint8_t)key->data[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+bool ir_key_equal(const ir_key_t* a, const ir_key_t* b) {
+  assert(a != NULL && b != NULL);
+  
+  return a->length == b->length &&
+         (a->length == 0 || memcmp(a->data, b->data, a->length) == 0);
+}
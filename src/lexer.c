@@ -54,6 +54,7 @@ static const keyword_map_t keywords[] = {
   {"CONSTANT", TOKEN_CONSTANT},
   {"GLOBAL",   TOKEN_GLOBAL},
   {"EXTERN",   TOKEN_EXTERN},
+  {"INTERNAL", TOKEN_INTERNAL},
   {"FUNCTION", TOKEN_FUNCTION},
   // {"ENTRY",    TOKEN_ENTRY},
   {"void",     TOKEN_VOID},
@@ -83,12 +84,23 @@ static const instruction_map_t instructions[] = {
   {"DIV",     TOKEN_DIV},
   {"REM",     TOKEN_REM},
   {"NEG",     TOKEN_NEG},
+  {"MULH",    TOKEN_MULH},
+  {"ADD_WIDE", TOKEN_ADD_WIDE},
+  {"MUL_WIDE", TOKEN_MUL_WIDE},
+  {"ADD_SAT", TOKEN_ADD_SAT},
+  {"SUB_SAT", TOKEN_SUB_SAT},
   {"AND",     TOKEN_AND},
   {"OR",      TOKEN_OR},
   {"XOR",     TOKEN_XOR},
   {"NOT",     TOKEN_NOT},
   {"SHL",     TOKEN_SHL},
   {"SHR",     TOKEN_SHR},
+  {"POPCNT",  TOKEN_POPCNT},
+  {"CLZ",     TOKEN_CLZ},
+  {"CTZ",     TOKEN_CTZ},
+  {"BSWAP",   TOKEN_BSWAP},
+  {"ROTL",    TOKEN_ROTL},
+  {"ROTR",    TOKEN_ROTR},
   {"CMP_EQ",  TOKEN_CMP_EQ},
   {"CMP_NE",  TOKEN_CMP_NE},
   {"CMP_LT",  TOKEN_CMP_LT},
@@ -98,6 +110,19 @@ static const instruction_map_t instructions[] = {
   {"LOAD",    TOKEN_LOAD},
   {"STORE",   TOKEN_STORE},
   {"LEA",     TOKEN_LEA},
+  {"SPLAT",   TOKEN_SPLAT},
+  {"EXTRACT", TOKEN_EXTRACT},
+  {"INSERT",  TOKEN_INSERT},
+  {"SHUFFLE", TOKEN_SHUFFLE},
+  {"REDUCE_ADD", TOKEN_REDUCE_ADD},
+  {"REDUCE_MIN", TOKEN_REDUCE_MIN},
+  {"REDUCE_MAX", TOKEN_REDUCE_MAX},
+  {"ATOMIC_LOAD", TOKEN_ATOMIC_LOAD},
+  {"ATOMIC_STORE", TOKEN_ATOMIC_STORE},
+  {"ATOMIC_RMW", TOKEN_ATOMIC_RMW},
+  {"CMPXCHG", TOKEN_CMPXCHG},
+  {"PREFETCH", TOKEN_PREFETCH},
+  {"FENCE",   TOKEN_FENCE},
   {"BR",      TOKEN_BR},
   {"CALL",    TOKEN_CALL},
   {"RET",     TOKEN_RET},
@@ -122,12 +147,14 @@ static const char* token_names[TOKEN_COUNT] = {
   "=",             /* TOKEN_EQUAL */
   "<",             /* TOKEN_LESS */
   ">",             /* TOKEN_GREATER */
+  "!",             /* TOKEN_BANG */
   "MODULE",        /* TOKEN_MODULE */
   "TARGET",        /* TOKEN_TARGET */
   "TYPE",          /* TOKEN_TYPE */
   "CONSTANT",      /* TOKEN_CONSTANT */
   "GLOBAL",        /* TOKEN_GLOBAL */
   "EXTERN",        /* TOKEN_EXTERN */
+  "INTERNAL",      /* TOKEN_INTERNAL */
   "FUNCTION",      /* TOKEN_FUNCTION */
   "ENTRY",         /* TOKEN_ENTRY */
   "void",          /* TOKEN_VOID */
@@ -156,12 +183,23 @@ static const char* token_names[TOKEN_COUNT] = {
   "DIV",           /* TOKEN_DIV */
   "REM",           /* TOKEN_REM */
   "NEG",           /* TOKEN_NEG */
+  "MULH",          /* TOKEN_MULH */
+  "ADD_WIDE",      /* TOKEN_ADD_WIDE */
+  "MUL_WIDE",      /* TOKEN_MUL_WIDE */
+  "ADD_SAT",       /* TOKEN_ADD_SAT */
+  "SUB_SAT",       /* TOKEN_SUB_SAT */
   "AND",           /* TOKEN_AND */
   "OR",            /* TOKEN_OR */
   "XOR",           /* TOKEN_XOR */
   "NOT",           /* TOKEN_NOT */
   "SHL",           /* TOKEN_SHL */
   "SHR",           /* TOKEN_SHR */
+  "POPCNT",        /* TOKEN_POPCNT */
+  "CLZ",           /* TOKEN_CLZ */
+  "CTZ",           /* TOKEN_CTZ */
+  "BSWAP",         /* TOKEN_BSWAP */
+  "ROTL",          /* TOKEN_ROTL */
+  "ROTR",          /* TOKEN_ROTR */
   "CMP_EQ",        /* TOKEN_CMP_EQ */
   "CMP_NE",        /* TOKEN_CMP_NE */
   "CMP_LT",        /* TOKEN_CMP_LT */
@@ -171,6 +209,19 @@ static const char* token_names[TOKEN_COUNT] = {
   "LOAD",          /* TOKEN_LOAD */
   "STORE",         /* TOKEN_STORE */
   "LEA",           /* TOKEN_LEA */
+  "SPLAT",         /* TOKEN_SPLAT */
+  "EXTRACT",       /* TOKEN_EXTRACT */
+  "INSERT",        /* TOKEN_INSERT */
+  "SHUFFLE",       /* TOKEN_SHUFFLE */
+  "REDUCE_ADD",    /* TOKEN_REDUCE_ADD */
+  "REDUCE_MIN",    /* TOKEN_REDUCE_MIN */
+  "REDUCE_MAX",    /* TOKEN_REDUCE_MAX */
+  "ATOMIC_LOAD",   /* TOKEN_ATOMIC_LOAD */
+  "ATOMIC_STORE",  /* TOKEN_ATOMIC_STORE */
+  "ATOMIC_RMW",    /* TOKEN_ATOMIC_RMW */
+  "CMPXCHG",       /* TOKEN_CMPXCHG */
+  "PREFETCH",      /* TOKEN_PREFETCH */
+  "FENCE",         /* TOKEN_FENCE */
   "BR",            /* TOKEN_BR */
   "CALL",          /* TOKEN_CALL */
   "RET",           /* TOKEN_RET */
@@ -435,10 +486,7 @@ static void scan_number(lexer_t* lexer, token_t* token) {
  * @param token The token to fill.
  */
 static void scan_string(lexer_t* lexer, token_t* token) {
-  /* Skip the opening quote */
-  lexer_advance(lexer);
-  
-  /* Mark the real start after the quote */
+  /* The opening quote was consumed by scan_token; mark the start after it */
   size_t content_start = lexer->position;
   
   /* Scan until closing quote or end of file */
@@ -515,6 +563,7 @@ static void scan_token(lexer_t* lexer, token_t* token) {
     case '=': init_token(lexer, token, TOKEN_EQUAL); break;
     case '<': init_token(lexer, token, TOKEN_LESS); break;
     case '>': init_token(lexer, token, TOKEN_GREATER); break;
+    case '!': init_token(lexer, token, TOKEN_BANG); break;
     
     case '-':
       /* Check for arrow token "->" */
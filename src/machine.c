@@ -0,0 +1,85 @@
+/**
+ * @file machine.c
+ * @brief Implementation of target machine models.
+ * 
+ * This file contains the latency tables and parameters of the machine models.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/machine.h"
+#include "../include/binary.h"
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Latencies of a generic out-of-order core.
+ */
+static const machine_latency_t generic_latencies[] = {
+  { OPCODE_MUL, 3 },
+  { OPCODE_MULH, 3 },
+  { OPCODE_MUL_WIDE, 3 },
+  { OPCODE_DIV, 24 },
+  { OPCODE_REM, 24 },
+  { OPCODE_FMA, 4 },
+  { OPCODE_LOAD, 4 },
+  { OPCODE_CALL, 5 },
+  
+  { 0, 0 }  /* Sentinel */
+};
+
+/**
+ * @brief Latencies of a simple in-order core.
+ */
+static const machine_latency_t inorder_latencies[] = {
+  { OPCODE_MUL, 4 },
+  { OPCODE_MULH, 4 },
+  { OPCODE_MUL_WIDE, 4 },
+  { OPCODE_DIV, 34 },
+  { OPCODE_REM, 34 },
+  { OPCODE_FMA, 5 },
+  { OPCODE_LOAD, 3 },
+  { OPCODE_CALL, 4 },
+  
+  { 0, 0 }  /* Sentinel */
+};
+
+/**
+ * @brief Known machine models. The first entry is the default.
+ */
+static const machine_model_t machine_models[] = {
+  { "generic", generic_latencies, 1, 4, 16 },
+  { "inorder", inorder_latencies, 1, 1, 32 },
+  
+  { NULL, NULL, 0, 0, 0 }  /* Sentinel */
+};
+
+const machine_model_t* machine_find_model(const char* name) {
+  assert(name != NULL);
+  
+  for (int i = 0; machine_models[i].name != NULL; i++) {
+    if (strcmp(machine_models[i].name, name) == 0) {
+      return &machine_models[i];
+    }
+  }
+  
+  return NULL;
+}
+
+const machine_model_t* machine_default_model(void) {
+  return &machine_models[0];
+}
+
+uint32_t machine_latency(const machine_model_t* model, uint8_t opcode) {
+  assert(model != NULL);
+  
+  for (int i = 0; model->latencies[i].opcode != 0; i++) {
+    if (model->latencies[i].opcode == opcode) {
+      return model->latencies[i].latency;
+    }
+  }
+  
+  return model->default_latency;
+}
@@ -13,12 +13,18 @@
 #include "../include/parser.h"
 #include "../include/ast.h"
 #include "../include/typecheck.h"
+#include "../include/optimize.h"
+#include "../include/machine.h"
 #include "../include/codegen.h"
 #include "../include/error.h"
+#include "../include/remark.h"
 #include "../include/util.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <regex.h>
 #include <assert.h>
 
 /**
@@ -32,9 +38,16 @@ static const char* VERSION = "0.1.0";
 struct hoilc_context {
   char* source;                /**< Source code buffer. */
   size_t source_length;        /**< Source code length. */
+  char* source_file;           /**< Source file path, or NULL for a source string. */
   char* output_file;           /**< Output file path. */
   error_context_t* error_ctx;  /**< Error context. */
   bool verbose;                /**< Whether to enable verbose output. */
+  hoilc_opt_level_t opt_level; /**< Optimization level. */
+  const machine_model_t* machine_model; /**< Machine model for target-aware passes. */
+  hoilc_budget_t budget;       /**< Limits on superlinear optimization passes. */
+  regex_t remark_filters[HOILC_REMARK_COUNT]; /**< Pass name patterns of printed remarks. */
+  bool has_remark_filter[HOILC_REMARK_COUNT]; /**< Whether each kind of remark is printed. */
+  char* record_file;           /**< Optimization record path, or NULL. */
 };
 
 hoilc_context_t* hoilc_create_context(void) {
@@ -45,6 +58,7 @@ hoilc_context_t* hoilc_create_context(void) {
   
   context->source = NULL;
   context->source_length = 0;
+  context->source_file = NULL;
   context->output_file = NULL;
   
   context->error_ctx = error_create_context();
@@ -54,6 +68,15 @@ hoilc_context_t* hoilc_create_context(void) {
   }
   
   context->verbose = false;
+  context->opt_level = HOILC_OPT_NONE;
+  context->machine_model = machine_default_model();
+  context->budget.max_instructions = HOILC_DEFAULT_MAX_INSTRUCTIONS;
+  context->budget.max_blocks = HOILC_DEFAULT_MAX_BLOCKS;
+  context->budget.max_milliseconds = 0;
+  for (int kind = 0; kind < HOILC_REMARK_COUNT; kind++) {
+    context->has_remark_filter[kind] = false;
+  }
+  context->record_file = NULL;
   
   return context;
 }
@@ -64,7 +87,14 @@ void hoilc_destroy_context(hoilc_context_t* context) {
   }
   
   free(context->source);
+  free(context->source_file);
   free(context->output_file);
+  free(context->record_file);
+  for (int kind = 0; kind < HOILC_REMARK_COUNT; kind++) {
+    if (context->has_remark_filter[kind]) {
+      regfree(&context->remark_filters[kind]);
+    }
+  }
   error_destroy_context(context->error_ctx);
   
   free(context);
@@ -86,6 +116,15 @@ hoilc_result_t hoilc_set_source_file(hoilc_context_t* context, const char* filen
     return HOILC_ERROR_IO;
   }
   
+  /* Keep the path for source locations */
+  free(context->source_file);
+  context->source_file = util_strdup(filename);
+  if (context->source_file == NULL) {
+    error_report(context->error_ctx, HOILC_ERROR_MEMORY,
+                 "Memory allocation failed");
+    return HOILC_ERROR_MEMORY;
+  }
+  
   return HOILC_SUCCESS;
 }
 
@@ -96,7 +135,9 @@ hoilc_result_t hoilc_set_source_string(hoilc_context_t* context,
   
   /* Clean up previous source */
   free(context->source);
+  free(context->source_file);
   context->source = NULL;
+  context->source_file = NULL;
   context->source_length = 0;
   
   /* Copy the source string */
@@ -134,6 +175,34 @@ hoilc_result_t hoilc_set_output_file(hoilc_context_t* context, const char* filen
   return HOILC_SUCCESS;
 }
 
+/**
+ * @brief Print the remarks selected by the filters and save the record.
+ * 
+ * @param context The compiler context.
+ * @param remarks The remarks of the optimizer.
+ * @return true on success, false if the record could not be written.
+ */
+static bool emit_remarks(hoilc_context_t* context, const remark_log_t* remarks) {
+  for (size_t i = 0; i < remark_count(remarks); i++) {
+    const remark_t* remark = remark_get(remarks, i);
+    if (context->has_remark_filter[remark->kind] &&
+        regexec(&context->remark_filters[remark->kind], remark->pass, 0, NULL, 0) == 0) {
+      remark_print(remark, stderr);
+    }
+  }
+  
+  if (context->record_file == NULL) {
+    return true;
+  }
+  
+  FILE* file = fopen(context->record_file, "w");
+  if (file == NULL) {
+    return false;
+  }
+  bool success = remark_write_json(remarks, file);
+  return fclose(file) == 0 && success;
+}
+
 hoilc_result_t hoilc_compile(hoilc_context_t* context) {
   assert(context != NULL);
   
@@ -160,7 +229,8 @@ hoilc_result_t hoilc_compile(hoilc_context_t* context) {
   }
   
   /* Create parser */
-  parser_t* parser = parser_create(lexer, context->output_file);
+  parser_t* parser = parser_create(lexer, context->source_file != NULL ?
+                                           context->source_file : "<input>");
   if (parser == NULL) {
     lexer_destroy(lexer);
     error_report(context->error_ctx, HOILC_ERROR_MEMORY,
@@ -225,6 +295,70 @@ hoilc_result_t hoilc_compile(hoilc_context_t* context) {
   /* Get the symbol table */
   symbol_table_t* symbol_table = typecheck_get_symbol_table(typecheck_ctx);
   
+  /* Optimize the module */
+  if (context->opt_level != HOILC_OPT_NONE) {
+    if (context->verbose) {
+      printf("Optimizing module...\n");
+    }
+    
+    optimize_context_t* optimize_ctx = optimize_create_context(context->error_ctx, symbol_table);
+    if (optimize_ctx == NULL) {
+      typecheck_destroy_context(typecheck_ctx);
+      ast_destroy_node(module);
+      error_report(context->error_ctx, HOILC_ERROR_MEMORY,
+                   "Failed to create optimizer");
+      return HOILC_ERROR_MEMORY;
+    }
+    
+    optimize_set_level(optimize_ctx, context->opt_level);
+    optimize_set_machine_model(optimize_ctx, context->machine_model);
+    optimize_set_budget(optimize_ctx, &context->budget);
+    
+    /* Remarks are only collected when something consumes them */
+    remark_log_t* remarks = NULL;
+    bool wants_remarks = context->record_file != NULL;
+    for (int kind = 0; kind < HOILC_REMARK_COUNT; kind++) {
+      wants_remarks = wants_remarks || context->has_remark_filter[kind];
+    }
+    if (wants_remarks) {
+      remarks = remark_create_log();
+      if (remarks == NULL) {
+        optimize_destroy_context(optimize_ctx);
+        typecheck_destroy_context(typecheck_ctx);
+        ast_destroy_node(module);
+        error_report(context->error_ctx, HOILC_ERROR_MEMORY,
+                     "Failed to create remark log");
+        return HOILC_ERROR_MEMORY;
+      }
+      optimize_set_remarks(optimize_ctx, remarks);
+    }
+    
+    bool optimized = optimize_module(optimize_ctx, module);
+    for (size_t i = 0; i < optimize_get_skip_count(optimize_ctx); i++) {
+      fprintf(stderr, "note: %s\n", optimize_get_skip(optimize_ctx, i));
+    }
+    optimize_destroy_context(optimize_ctx);
+    
+    bool recorded = remarks == NULL || emit_remarks(context, remarks);
+    remark_destroy_log(remarks);
+    
+    if (optimized && !recorded) {
+      typecheck_destroy_context(typecheck_ctx);
+      ast_destroy_node(module);
+      error_report(context->error_ctx, HOILC_ERROR_IO,
+                   "Failed to write optimization record: %s", context->record_file);
+      return HOILC_ERROR_IO;
+    }
+    
+    if (!optimized) {
+      typecheck_destroy_context(typecheck_ctx);
+      ast_destroy_node(module);
+      
+      /* Error already reported by optimizer */
+      return HOILC_ERROR_INTERNAL;
+    }
+  }
+  
   /* Generate code */
   if (context->verbose) {
     printf("Generating COIL code...\n");
@@ -239,6 +373,17 @@ hoilc_result_t hoilc_compile(hoilc_context_t* context) {
     return HOILC_ERROR_MEMORY;
   }
   
+  /* Lowering leaves patterns only the encoded instructions show */
+  if (context->opt_level != HOILC_OPT_NONE &&
+      !coil_builder_set_peephole(codegen_get_builder(codegen_ctx), true)) {
+    codegen_destroy_context(codegen_ctx);
+    typecheck_destroy_context(typecheck_ctx);
+    ast_destroy_node(module);
+    error_report(context->error_ctx, HOILC_ERROR_MEMORY,
+                 "Failed to create code generator");
+    return HOILC_ERROR_MEMORY;
+  }
+  
   /* Generate COIL binary */
   uint8_t* binary = NULL;
   size_t binary_size = 0;
@@ -308,6 +453,75 @@ void hoilc_set_verbose(hoilc_context_t* context, bool verbose) {
   context->verbose = verbose;
 }
 
+void hoilc_set_optimization_level(hoilc_context_t* context, hoilc_opt_level_t level) {
+  assert(context != NULL);
+  assert(level < HOILC_OPT_COUNT);
+  
+  context->opt_level = level;
+}
+
+void hoilc_set_optimization_budget(hoilc_context_t* context, const hoilc_budget_t* budget) {
+  assert(context != NULL);
+  assert(budget != NULL);
+  
+  context->budget = *budget;
+}
+
+hoilc_result_t hoilc_set_remark_filter(hoilc_context_t* context, hoilc_remark_kind_t kind,
+                                       const char* pattern) {
+  assert(context != NULL);
+  assert(kind < HOILC_REMARK_COUNT);
+  assert(pattern != NULL);
+  
+  regex_t filter;
+  if (regcomp(&filter, pattern, REG_EXTENDED | REG_NOSUB) != 0) {
+    error_report(context->error_ctx, HOILC_ERROR_SEMANTIC,
+                 "Invalid remark pattern: %s", pattern);
+    return HOILC_ERROR_SEMANTIC;
+  }
+  
+  if (context->has_remark_filter[kind]) {
+    regfree(&context->remark_filters[kind]);
+  }
+  context->remark_filters[kind] = filter;
+  context->has_remark_filter[kind] = true;
+  return HOILC_SUCCESS;
+}
+
+hoilc_result_t hoilc_set_optimization_record(hoilc_context_t* context, const char* filename) {
+  assert(context != NULL);
+  
+  free(context->record_file);
+  context->record_file = NULL;
+  if (filename == NULL) {
+    return HOILC_SUCCESS;
+  }
+  
+  context->record_file = util_strdup(filename);
+  if (context->record_file == NULL) {
+    error_report(context->error_ctx, HOILC_ERROR_MEMORY,
+                 "Memory allocation failed");
+    return HOILC_ERROR_MEMORY;
+  }
+  
+  return HOILC_SUCCESS;
+}
+
+hoilc_result_t hoilc_set_machine_model(hoilc_context_t* context, const char* model) {
+  assert(context != NULL);
+  assert(model != NULL);
+  
+  const machine_model_t* machine_model = machine_find_model(model);
+  if (machine_model == NULL) {
+    error_report(context->error_ctx, HOILC_ERROR_SEMANTIC,
+                 "Unknown machine model: %s", model);
+    return HOILC_ERROR_SEMANTIC;
+  }
+  
+  context->machine_model = machine_model;
+  return HOILC_SUCCESS;
+}
+
 const char* hoilc_get_version(void) {
   return VERSION;
 }
@@ -322,11 +536,39 @@ static void print_usage(const char* program_name) {
   fprintf(stderr, "Usage: %s [options] input_file\n", program_name);
   fprintf(stderr, "Options:\n");
   fprintf(stderr, "  -o <file>     Output file (default: input.coil)\n");
+  fprintf(stderr, "  -O<level>     Optimization level: 0, 1, 2 or s (default: 0)\n");
+  fprintf(stderr, "  -mtune=<cpu>  Machine model: generic, inorder (default: generic)\n");
+  fprintf(stderr, "  --max-instructions=<n>  Skip costly passes on larger functions (default: %d)\n",
+          HOILC_DEFAULT_MAX_INSTRUCTIONS);
+  fprintf(stderr, "  --max-blocks=<n>        Skip costly passes on functions with more blocks "
+          "(default: %d)\n", HOILC_DEFAULT_MAX_BLOCKS);
+  fprintf(stderr, "  --max-time=<ms>         Skip costly passes once a function took this long "
+          "(default: off)\n");
+  fprintf(stderr, "  -Rpass=<regex>          Report optimizations applied by matching passes\n");
+  fprintf(stderr, "  -Rpass-missed=<regex>   Report optimizations matching passes missed\n");
+  fprintf(stderr, "  -Rpass-analysis=<regex> Report analysis results of matching passes\n");
+  fprintf(stderr, "  -fsave-optimization-record  Save all remarks as JSON to output.opt.json\n");
+  fprintf(stderr, "  -foptimization-record-file=<file>  Save all remarks as JSON to file\n");
   fprintf(stderr, "  -v            Enable verbose output\n");
   fprintf(stderr, "  -h, --help    Show this help message\n");
   fprintf(stderr, "  --version     Show version information\n");
 }
 
+/**
+ * @brief Parse the value of a budget option.
+ * 
+ * @param text The option value.
+ * @param max The largest accepted value.
+ * @param value Receives the parsed value.
+ * @return true if the text is a number no larger than max.
+ */
+static bool parse_limit(const char* text, unsigned long max, unsigned long* value) {
+  char* end = NULL;
+  errno = 0;
+  *value = strtoul(text, &end, 10);
+  return text[0] >= '0' && text[0] <= '9' && *end == '\0' && errno == 0 && *value <= max;
+}
+
 /**
  * @brief Print version information.
  */
@@ -346,6 +588,13 @@ int main(int argc, char** argv) {
   const char* input_file = NULL;
   const char* output_file = NULL;
   bool verbose = false;
+  hoilc_opt_level_t opt_level = HOILC_OPT_NONE;
+  const char* machine_model = NULL;
+  hoilc_budget_t budget = { HOILC_DEFAULT_MAX_INSTRUCTIONS, HOILC_DEFAULT_MAX_BLOCKS, 0 };
+  unsigned long limit = 0;
+  const char* remark_patterns[HOILC_REMARK_COUNT] = { NULL, NULL, NULL };
+  bool save_record = false;
+  const char* record_file = NULL;
   
   /* Parse command-line arguments */
   for (int i = 1; i < argc; i++) {
@@ -359,6 +608,45 @@ int main(int argc, char** argv) {
       }
     } else if (strcmp(argv[i], "-v") == 0) {
       verbose = true;
+    } else if (strcmp(argv[i], "-O0") == 0) {
+      opt_level = HOILC_OPT_NONE;
+    } else if (strcmp(argv[i], "-O1") == 0) {
+      opt_level = HOILC_OPT_BASIC;
+    } else if (strcmp(argv[i], "-O2") == 0) {
+      opt_level = HOILC_OPT_FULL;
+    } else if (strcmp(argv[i], "-Os") == 0) {
+      opt_level = HOILC_OPT_SIZE;
+    } else if (strncmp(argv[i], "-mtune=", 7) == 0) {
+      machine_model = argv[i] + 7;
+    } else if (strncmp(argv[i], "-Rpass=", 7) == 0) {
+      remark_patterns[HOILC_REMARK_PASSED] = argv[i] + 7;
+    } else if (strncmp(argv[i], "-Rpass-missed=", 14) == 0) {
+      remark_patterns[HOILC_REMARK_MISSED] = argv[i] + 14;
+    } else if (strncmp(argv[i], "-Rpass-analysis=", 16) == 0) {
+      remark_patterns[HOILC_REMARK_ANALYSIS] = argv[i] + 16;
+    } else if (strcmp(argv[i], "-fsave-optimization-record") == 0) {
+      save_record = true;
+    } else if (strncmp(argv[i], "-foptimization-record-file=", 27) == 0) {
+      record_file = argv[i] + 27;
+      save_record = true;
+    } else if (strncmp(argv[i], "--max-instructions=", 19) == 0) {
+      if (!parse_limit(argv[i] + 19, SIZE_MAX, &limit)) {
+        fprintf(stderr, "Error: Invalid instruction limit: %s\n", argv[i] + 19);
+        return 1;
+      }
+      budget.max_instructions = (size_t)limit;
+    } else if (strncmp(argv[i], "--max-blocks=", 13) == 0) {
+      if (!parse_limit(argv[i] + 13, SIZE_MAX, &limit)) {
+        fprintf(stderr, "Error: Invalid block limit: %s\n", argv[i] + 13);
+        return 1;
+      }
+      budget.max_blocks = (size_t)limit;
+    } else if (strncmp(argv[i], "--max-time=", 11) == 0) {
+      if (!parse_limit(argv[i] + 11, UINT32_MAX, &limit)) {
+        fprintf(stderr, "Error: Invalid time limit: %s\n", argv[i] + 11);
+        return 1;
+      }
+      budget.max_milliseconds = (uint32_t)limit;
     } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
       print_usage(argv[0]);
       return 0;
@@ -414,6 +702,20 @@ int main(int argc, char** argv) {
     }
   }
   
+  /* The record goes next to the output unless named */
+  char default_record[FILENAME_MAX];
+  if (save_record && record_file == NULL) {
+    const char* ext = strrchr(output_file, '.');
+    size_t base_len = ext != NULL ? (size_t)(ext - output_file) : strlen(output_file);
+    if (base_len >= FILENAME_MAX - 10) {  /* 10 = length of ".opt.json" + 1 */
+      fprintf(stderr, "Error: Generated record filename is too long\n");
+      return 1;
+    }
+    memcpy(default_record, output_file, base_len);
+    strcpy(default_record + base_len, ".opt.json");
+    record_file = default_record;
+  }
+  
   /* Create compiler context */
   hoilc_context_t* context = hoilc_create_context();
   if (context == NULL) {
@@ -421,8 +723,34 @@ int main(int argc, char** argv) {
     return 1;
   }
   
-  /* Set verbose flag */
+  /* Set verbose flag and optimization options */
   hoilc_set_verbose(context, verbose);
+  hoilc_set_optimization_level(context, opt_level);
+  hoilc_set_optimization_budget(context, &budget);
+  
+  for (int kind = 0; kind < HOILC_REMARK_COUNT; kind++) {
+    if (remark_patterns[kind] != NULL &&
+        hoilc_set_remark_filter(context, (hoilc_remark_kind_t)kind,
+                                remark_patterns[kind]) != HOILC_SUCCESS) {
+      fprintf(stderr, "Error: Invalid remark pattern: %s\n", remark_patterns[kind]);
+      hoilc_destroy_context(context);
+      return 1;
+    }
+  }
+  
+  if (record_file != NULL &&
+      hoilc_set_optimization_record(context, record_file) != HOILC_SUCCESS) {
+    fprintf(stderr, "Error: %s\n", hoilc_get_error_message(context));
+    hoilc_destroy_context(context);
+    return 1;
+  }
+  
+  if (machine_model != NULL &&
+      hoilc_set_machine_model(context, machine_model) != HOILC_SUCCESS) {
+    fprintf(stderr, "Error: Unknown machine model: %s\n", machine_model);
+    hoilc_destroy_context(context);
+    return 1;
+  }
   
   /* Set input and output files */
   hoilc_result_t result = hoilc_set_source_file(context, input_file);
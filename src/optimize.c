@@ -0,0 +1,500 @@
+/**
+ * @file optimize.c
+ * @brief Implementation of the optimization pass manager.
+ * 
+ * This file contains the pass table and the driver that runs the passes
+ * enabled at the selected optimization level, keeping superlinear passes
+ * within the per-function budget and logging what the budget skipped, and
+ * the entry point through which passes emit optimization remarks.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/optimize.h"
+#include "../include/passes.h"
+#include "../include/ir.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+
+/**
+ * @brief Bit for an optimization level in a pass level mask.
+ */
+#define LEVEL_BIT(level) (1u << (level))
+
+/**
+ * @brief Function pass entry point.
+ */
+typedef bool (*function_pass_t)(optimize_context_t* context, ast_node_t* function);
+
+/**
+ * @brief Module pass entry point.
+ */
+typedef bool (*module_pass_t)(optimize_context_t* context, ast_node_t* module);
+
+/**
+ * @brief Complexity class of a pass in the size of a function.
+ */
+typedef enum {
+  PASS_COST_LINEAR,          /**< Linear or bounded; never limited. */
+  PASS_COST_SUPERLINEAR,     /**< Superlinear; skipped on functions over the budget. */
+  PASS_COST_DEGRADABLE,      /**< Superlinear with a linear mode used over the budget. */
+} pass_cost_t;
+
+/**
+ * @brief Pass descriptor structure.
+ */
+typedef struct {
+  const char* name;          /**< Pass name. */
+  function_pass_t run;       /**< Function pass entry point (can be NULL). */
+  module_pass_t run_module;  /**< Module pass entry point (can be NULL). */
+  pass_cost_t cost;          /**< Complexity class. */
+  uint32_t levels;           /**< Mask of levels enabling the pass. */
+} pass_info_t;
+
+/**
+ * @brief Size of the buffer holding one skip or remark message.
+ */
+#define MESSAGE_SIZE 256
+
+/**
+ * @brief Optimizer context structure.
+ */
+struct optimize_context {
+  error_context_t* error_ctx;     /**< Error context. */
+  symbol_table_t* symbol_table;   /**< Global symbol table. */
+  hoilc_opt_level_t level;        /**< Optimization level. */
+  const machine_model_t* model;   /**< Machine model. */
+  ast_node_t* module;             /**< Module being optimized. */
+  callgraph_t* callgraph;         /**< Call graph of the module, or NULL if stale. */
+  effects_t* effects;             /**< Memory effects of its functions, or NULL if stale. */
+  hoilc_budget_t budget;          /**< Limits on superlinear passes. */
+  const pass_info_t* pass;        /**< Running pass. */
+  bool degraded;                  /**< Whether the running pass uses its cheaper mode. */
+  ir_var_table_t* timed;          /**< Names of the functions whose time is tracked. */
+  double* seconds;                /**< Processor time spent on each tracked function. */
+  size_t seconds_capacity;        /**< Capacity of the seconds array. */
+  remark_log_t* remarks;          /**< Log receiving remarks, or NULL. */
+  char** skips;                   /**< Logged skip messages. */
+  size_t skip_count;              /**< Number of logged skips. */
+  size_t skip_capacity;           /**< Capacity of the skips array. */
+};
+
+/**
+ * @brief Pass table, in execution order.
+ */
+static const pass_info_t pass_table[] = {
+  { "sroa", pass_sroa, NULL, PASS_COST_LINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) | LEVEL_BIT(HOILC_OPT_SIZE) },
+  { "evaluate", NULL, pass_evaluate, PASS_COST_LINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) | LEVEL_BIT(HOILC_OPT_SIZE) },
+  { "icf", NULL, pass_icf, PASS_COST_LINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) | LEVEL_BIT(HOILC_OPT_SIZE) },
+  { "specialize", NULL, pass_specialize, PASS_COST_LINEAR, LEVEL_BIT(HOILC_OPT_FULL) },
+  { "arguments", NULL, pass_arguments, PASS_COST_LINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) | LEVEL_BIT(HOILC_OPT_SIZE) },
+  { "idiom", pass_idiom, NULL, PASS_COST_LINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) | LEVEL_BIT(HOILC_OPT_SIZE) },
+  { "memory", pass_memory, NULL, PASS_COST_SUPERLINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) | LEVEL_BIT(HOILC_OPT_SIZE) },
+  { "range", pass_range, NULL, PASS_COST_SUPERLINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) | LEVEL_BIT(HOILC_OPT_SIZE) },
+  { "induction", pass_induction, NULL, PASS_COST_SUPERLINEAR, LEVEL_BIT(HOILC_OPT_FULL) },
+  { "sink", pass_sink, NULL, PASS_COST_SUPERLINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) | LEVEL_BIT(HOILC_OPT_SIZE) },
+  { "schedule", pass_schedule, NULL, PASS_COST_DEGRADABLE, LEVEL_BIT(HOILC_OPT_FULL) },
+  { "layout", pass_layout, NULL, PASS_COST_LINEAR,
+    LEVEL_BIT(HOILC_OPT_BASIC) | LEVEL_BIT(HOILC_OPT_FULL) },
+  { "outline", NULL, pass_outline, PASS_COST_SUPERLINEAR, LEVEL_BIT(HOILC_OPT_SIZE) },
+  
+  { NULL, NULL, NULL, PASS_COST_LINEAR, 0 }  /* Sentinel */
+};
+
+optimize_context_t* optimize_create_context(error_context_t* error_ctx,
+                                           symbol_table_t* symbol_table) {
+  assert(error_ctx != NULL);
+  assert(symbol_table != NULL);
+  
+  optimize_context_t* context = (optimize_context_t*)malloc(sizeof(optimize_context_t));
+  if (context == NULL) {
+    return NULL;
+  }
+  
+  context->error_ctx = error_ctx;
+  context->symbol_table = symbol_table;
+  context->level = HOILC_OPT_NONE;
+  context->model = machine_default_model();
+  context->module = NULL;
+  context->callgraph = NULL;
+  context->effects = NULL;
+  context->budget.max_instructions = HOILC_DEFAULT_MAX_INSTRUCTIONS;
+  context->budget.max_blocks = HOILC_DEFAULT_MAX_BLOCKS;
+  context->budget.max_milliseconds = 0;
+  context->pass = NULL;
+  context->degraded = false;
+  context->timed = NULL;
+  context->seconds = NULL;
+  context->seconds_capacity = 0;
+  context->remarks = NULL;
+  context->skips = NULL;
+  context->skip_count = 0;
+  context->skip_capacity = 0;
+  
+  return context;
+}
+
+void optimize_destroy_context(optimize_context_t* context) {
+  if (context == NULL) {
+    return;
+  }
+  
+  optimize_invalidate_effects(context);
+  ir_var_table_destroy(context->timed);
+  free(context->seconds);
+  for (size_t i = 0; i < context->skip_count; i++) {
+    free(context->skips[i]);
+  }
+  free(context->skips);
+  free(context);
+}
+
+void optimize_set_level(optimize_context_t* context, hoilc_opt_level_t level) {
+  assert(context != NULL);
+  assert(level < HOILC_OPT_COUNT);
+  
+  context->level = level;
+}
+
+hoilc_opt_level_t optimize_get_level(const optimize_context_t* context) {
+  assert(context != NULL);
+  
+  return context->level;
+}
+
+void optimize_set_machine_model(optimize_context_t* context, const machine_model_t* model) {
+  assert(context != NULL);
+  assert(model != NULL);
+  
+  context->model = model;
+}
+
+const machine_model_t* optimize_get_machine_model(const optimize_context_t* context) {
+  assert(context != NULL);
+  
+  return context->model;
+}
+
+error_context_t* optimize_get_error_context(optimize_context_t* context) {
+  assert(context != NULL);
+  
+  return context->error_ctx;
+}
+
+symbol_table_t* optimize_get_symbol_table(optimize_context_t* context) {
+  assert(context != NULL);
+  
+  return context->symbol_table;
+}
+
+void optimize_set_budget(optimize_context_t* context, const hoilc_budget_t* budget) {
+  assert(context != NULL);
+  assert(budget != NULL);
+  
+  context->budget = *budget;
+}
+
+bool optimize_is_degraded(const optimize_context_t* context) {
+  assert(context != NULL);
+  
+  return context->degraded;
+}
+
+void optimize_set_remarks(optimize_context_t* context, remark_log_t* log) {
+  assert(context != NULL);
+  
+  context->remarks = log;
+}
+
+bool optimize_wants_remarks(const optimize_context_t* context) {
+  assert(context != NULL);
+  
+  return context->remarks != NULL;
+}
+
+void optimize_remark(optimize_context_t* context, hoilc_remark_kind_t kind,
+                     const ast_node_t* function, const ast_node_t* node, const char* name,
+                     const char* format, ...) {
+  assert(context != NULL);
+  assert(context->pass != NULL);
+  assert(name != NULL && format != NULL);
+  
+  if (context->remarks == NULL) {
+    return;
+  }
+  
+  char message[MESSAGE_SIZE];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(message, sizeof(message), format, args);
+  va_end(args);
+  
+  if (node == NULL) {
+    node = function;
+  }
+  remark_add(context->remarks, kind, context->pass->name, name,
+             function != NULL ? function->data.function.name : NULL,
+             node != NULL ? &node->location : NULL, message);
+}
+
+/**
+ * @brief Get the processor time slot of a function.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return The slot, or NULL if memory allocation failed.
+ */
+static double* function_seconds(optimize_context_t* context, const ast_node_t* function) {
+  if (context->timed == NULL) {
+    context->timed = ir_var_table_create();
+    if (context->timed == NULL) {
+      return NULL;
+    }
+  }
+  
+  int32_t id = ir_var_table_intern(context->timed, function->data.function.name);
+  if (id < 0) {
+    return NULL;
+  }
+  
+  if ((size_t)id >= context->seconds_capacity) {
+    size_t capacity = context->seconds_capacity == 0 ? 16 : context->seconds_capacity * 2;
+    double* seconds = (double*)realloc(context->seconds, capacity * sizeof(double));
+    if (seconds == NULL) {
+      return NULL;
+    }
+    for (size_t i = context->seconds_capacity; i < capacity; i++) {
+      seconds[i] = 0.0;
+    }
+    context->seconds = seconds;
+    context->seconds_capacity = capacity;
+  }
+  
+  return &context->seconds[id];
+}
+
+/**
+ * @brief Check a function against the budget.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @param reason Buffer receiving the exceeded limit.
+ * @param size The size of the buffer.
+ * @return true if the function is within every limit.
+ */
+static bool check_budget(optimize_context_t* context, ast_node_t* function,
+                         char* reason, size_t size) {
+  const hoilc_budget_t* budget = &context->budget;
+  size_t blocks = function->data.function.blocks.count;
+  size_t instructions = 0;
+  for (size_t i = 0; i < blocks; i++) {
+    instructions += function->data.function.blocks.nodes[i]->data.stmt_block.statements.count;
+  }
+  
+  if (budget->max_instructions > 0 && instructions > budget->max_instructions) {
+    snprintf(reason, size, "%zu instructions exceed the limit of %zu",
+             instructions, budget->max_instructions);
+    return false;
+  }
+  
+  if (budget->max_blocks > 0 && blocks > budget->max_blocks) {
+    snprintf(reason, size, "%zu blocks exceed the limit of %zu", blocks, budget->max_blocks);
+    return false;
+  }
+  
+  if (budget->max_milliseconds > 0) {
+    double* seconds = function_seconds(context, function);
+    double milliseconds = seconds != NULL ? *seconds * 1000.0 : 0.0;
+    if (milliseconds >= budget->max_milliseconds) {
+      snprintf(reason, size, "%.0f ms spent exceed the limit of %u ms",
+               milliseconds, budget->max_milliseconds);
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Log a pass skipped or degraded on a function.
+ * 
+ * A failed allocation loses the message but does not stop optimization.
+ * 
+ * @param context The optimizer context.
+ * @param action What happened to the pass.
+ * @param function The function AST node.
+ * @param reason The exceeded limit.
+ */
+static void log_skip(optimize_context_t* context, const char* action,
+                     const ast_node_t* function, const char* reason) {
+  if (context->skip_count == context->skip_capacity) {
+    size_t capacity = context->skip_capacity == 0 ? 16 : context->skip_capacity * 2;
+    char** skips = (char**)realloc(context->skips, capacity * sizeof(char*));
+    if (skips == NULL) {
+      return;
+    }
+    context->skips = skips;
+    context->skip_capacity = capacity;
+  }
+  
+  char* message = (char*)malloc(MESSAGE_SIZE);
+  if (message == NULL) {
+    return;
+  }
+  snprintf(message, MESSAGE_SIZE, "%s pass '%s' on function '%s': %s",
+           action, context->pass->name, function->data.function.name, reason);
+  context->skips[context->skip_count++] = message;
+  optimize_remark(context, HOILC_REMARK_MISSED, function, NULL, "BudgetExceeded",
+                  "%s on function '%s': %s", action, function->data.function.name, reason);
+}
+
+bool optimize_within_budget(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(context->pass != NULL);
+  assert(function != NULL && function->type == AST_FUNCTION);
+  
+  char reason[MESSAGE_SIZE];
+  if (check_budget(context, function, reason, sizeof(reason))) {
+    return true;
+  }
+  
+  log_skip(context, "skipped", function, reason);
+  return false;
+}
+
+size_t optimize_get_skip_count(const optimize_context_t* context) {
+  assert(context != NULL);
+  
+  return context->skip_count;
+}
+
+const char* optimize_get_skip(const optimize_context_t* context, size_t index) {
+  assert(context != NULL);
+  assert(index < context->skip_count);
+  
+  return context->skips[index];
+}
+
+/**
+ * @brief Run a function pass on one function within the budget.
+ * 
+ * @param context The optimizer context.
+ * @param function The function AST node.
+ * @return true on success, false on failure.
+ */
+static bool run_function_pass(optimize_context_t* context, ast_node_t* function) {
+  const pass_info_t* pass = context->pass;
+  char reason[MESSAGE_SIZE];
+  
+  context->degraded = false;
+  if (pass->cost != PASS_COST_LINEAR && !check_budget(context, function, reason, sizeof(reason))) {
+    if (pass->cost != PASS_COST_DEGRADABLE) {
+      log_skip(context, "skipped", function, reason);
+      return true;
+    }
+    log_skip(context, "degraded", function, reason);
+    context->degraded = true;
+  }
+  
+  /* Processor time is only measured when it is limited */
+  if (context->budget.max_milliseconds == 0) {
+    return pass->run(context, function);
+  }
+  
+  clock_t start = clock();
+  bool success = pass->run(context, function);
+  double* seconds = function_seconds(context, function);
+  if (seconds != NULL) {
+    *seconds += (double)(clock() - start) / CLOCKS_PER_SEC;
+  }
+  return success;
+}
+
+effects_t* optimize_get_effects(optimize_context_t* context) {
+  assert(context != NULL);
+  assert(context->module != NULL);
+  
+  if (context->effects == NULL) {
+    callgraph_destroy(context->callgraph);
+    context->callgraph = callgraph_build(context->module);
+    if (context->callgraph == NULL) {
+      return NULL;
+    }
+    context->effects = effects_analyze(context->module, context->callgraph);
+  }
+  
+  return context->effects;
+}
+
+void optimize_invalidate_effects(optimize_context_t* context) {
+  assert(context != NULL);
+  
+  effects_destroy(context->effects);
+  callgraph_destroy(context->callgraph);
+  context->effects = NULL;
+  context->callgraph = NULL;
+}
+
+bool optimize_module(optimize_context_t* context, ast_node_t* module) {
+  assert(context != NULL);
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  
+  optimize_invalidate_effects(context);
+  context->module = module;
+  
+  for (int i = 0; pass_table[i].name != NULL; i++) {
+    const pass_info_t* pass = &pass_table[i];
+    if ((pass->levels & LEVEL_BIT(context->level)) == 0) {
+      continue;
+    }
+    
+    context->pass = pass;
+    if (pass->run_module != NULL) {
+      bool success = pass->run_module(context, module);
+      optimize_invalidate_effects(context);
+      if (!success) {
+        return false;
+      }
+      continue;
+    }
+    
+    for (size_t j = 0; j < module->data.module.declarations.count; j++) {
+      ast_node_t* decl = module->data.module.declarations.nodes[j];
+      if (decl->type != AST_FUNCTION) {
+        continue;
+      }
+      
+      /* Versions are tuned for the machine model of their target */
+      const machine_model_t* model = context->model;
+      ast_node_t* target = decl->data.function.target;
+      if (target != NULL && target->data.target.model != NULL) {
+        context->model = machine_find_model(target->data.target.model);
+        assert(context->model != NULL);
+      }
+      
+      bool success = run_function_pass(context, decl);
+      context->model = model;
+      if (!success) {
+        optimize_invalidate_effects(context);
+        return false;
+      }
+    }
+  }
+  
+  optimize_invalidate_effects(context);
+  return true;
+}
@@ -11,6 +11,7 @@
 
 #include "../include/parser.h"
 #include "../include/error.h"
+#include "../include/binary.h"
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -22,6 +23,7 @@
 struct parser {
   lexer_t* lexer;                /**< Lexer for reading tokens. */
   token_t current;               /**< Current token. */
+  token_t previous;              /**< Most recently consumed token. */
   bool has_error;                /**< Whether an error has occurred. */
   parser_error_t error;          /**< Last error. */
   const char* filename;          /**< Source filename. */
@@ -53,6 +55,7 @@ static void parser_set_error(parser_t* parser, const char* message) {
 static bool parser_advance(parser_t* parser) {
   assert(parser != NULL);
   
+  parser->previous = parser->current;
   if (!lexer_next_token(parser->lexer, &parser->current)) {
     if (parser->current.type == TOKEN_ERROR) {
       char message[64];
@@ -149,6 +152,7 @@ static ast_node_t* parse_module(parser_t* parser);
 static ast_node_t* parse_type_def(parser_t* parser);
 static ast_node_t* parse_constant(parser_t* parser);
 static ast_node_t* parse_global(parser_t* parser);
+static ast_node_t* parse_target(parser_t* parser);
 static ast_node_t* parse_function(parser_t* parser);
 static ast_node_t* parse_extern_function(parser_t* parser);
 static ast_node_t* parse_type(parser_t* parser);
@@ -175,6 +179,7 @@ parser_t* parser_create(lexer_t* lexer, const char* filename) {
   parser->error.location.column = 0;
   parser->error.location.filename = filename;
   parser->filename = filename;
+  memset(&parser->previous, 0, sizeof(parser->previous));
   
   /* Prime the parser with the first token */
   if (!lexer_next_token(lexer, &parser->current)) {
@@ -235,7 +240,7 @@ static ast_node_t* parse_module(parser_t* parser) {
   }
   
   /* Get the module name */
-  char* module_name = token_to_str(&parser->current);
+  char* module_name = token_to_str(&parser->previous);
   if (module_name == NULL) {
     parser_set_error(parser, strdup("Memory allocation error for module name"));
     return NULL;
@@ -278,10 +283,15 @@ static ast_node_t* parse_module(parser_t* parser) {
         declaration = parse_global(parser);
         break;
         
+      case TOKEN_TARGET:
+        declaration = parse_target(parser);
+        break;
+        
       case TOKEN_EXTERN:
         declaration = parse_extern_function(parser);
         break;
         
+      case TOKEN_INTERNAL:
       case TOKEN_FUNCTION:
         declaration = parse_function(parser);
         break;
@@ -333,7 +343,7 @@ static ast_node_t* parse_type_def(parser_t* parser) {
   }
   
   /* Get the type name */
-  char* type_name = token_to_str(&parser->current);
+  char* type_name = token_to_str(&parser->previous);
   if (type_name == NULL) {
     parser_set_error(parser, strdup("Memory allocation error for type name"));
     return NULL;
@@ -374,7 +384,7 @@ static ast_node_t* parse_type_def(parser_t* parser) {
     }
     
     /* Get the field name */
-    char* field_name = token_to_str(&parser->current);
+    char* field_name = token_to_str(&parser->previous);
     if (field_name == NULL) {
       parser_set_error(parser, strdup("Memory allocation error for field name"));
       ast_destroy_node(type_def);
@@ -564,22 +574,40 @@ static ast_node_t* parse_type(parser_t* parser) {
       /* Set the pointer type properties */
       type->data.type_ptr.element_type = element_type;
       type->data.type_ptr.memory_space = NULL;
+      type->data.type_ptr.is_restrict = false;
       
-      /* Check for optional memory space */
-      if (parser_match(parser, TOKEN_COMMA)) {
-        /* Expect memory space identifier */
-        if (!parser_expect(parser, TOKEN_IDENTIFIER, "Expected memory space identifier")) {
+      /* Check for an optional memory space and restrict, in either order */
+      while (parser_match(parser, TOKEN_COMMA)) {
+        /* Expect memory space identifier or restrict */
+        if (!parser_expect(parser, TOKEN_IDENTIFIER,
+                           "Expected memory space identifier or 'restrict'")) {
           ast_destroy_node(type);
           return NULL;
         }
         
-        /* Get the memory space name */
-        type->data.type_ptr.memory_space = token_to_str(&parser->current);
-        if (type->data.type_ptr.memory_space == NULL) {
+        char* qualifier = token_to_str(&parser->previous);
+        if (qualifier == NULL) {
           ast_destroy_node(type);
           parser_set_error(parser, strdup("Memory allocation error for memory space"));
           return NULL;
         }
+        
+        if (strcmp(qualifier, "restrict") == 0 ? type->data.type_ptr.is_restrict :
+            type->data.type_ptr.memory_space != NULL) {
+          char error[96];
+          snprintf(error, sizeof(error), "Duplicate pointer qualifier '%s'", qualifier);
+          parser_set_error(parser, strdup(error));
+          free(qualifier);
+          ast_destroy_node(type);
+          return NULL;
+        }
+        
+        if (strcmp(qualifier, "restrict") == 0) {
+          type->data.type_ptr.is_restrict = true;
+          free(qualifier);
+        } else {
+          type->data.type_ptr.memory_space = qualifier;
+        }
       }
       
       /* Expect > to close type parameter */
@@ -617,7 +645,7 @@ static ast_node_t* parse_type(parser_t* parser) {
       }
       
       /* Get the vector size */
-      uint32_t vector_size = (uint32_t)parser->current.value.int_value;
+      uint32_t vector_size = (uint32_t)parser->previous.value.int_value;
       
       /* Create the vector type node */
       type = ast_create_node(AST_TYPE_VEC);
@@ -674,7 +702,7 @@ static ast_node_t* parse_type(parser_t* parser) {
         }
         
         /* Get the array size */
-        type->data.type_array.size = (uint32_t)parser->current.value.int_value;
+        type->data.type_array.size = (uint32_t)parser->previous.value.int_value;
       }
       
       /* Expect > to close type parameters */
@@ -803,7 +831,7 @@ static ast_node_t* parse_constant(parser_t* parser) {
   }
   
   /* Get the constant name */
-  char* constant_name = token_to_str(&parser->current);
+  char* constant_name = token_to_str(&parser->previous);
   if (constant_name == NULL) {
     parser_set_error(parser, strdup("Memory allocation error for constant name"));
     return NULL;
@@ -883,7 +911,7 @@ static ast_node_t* parse_global(parser_t* parser) {
   }
   
   /* Get the global variable name */
-  char* global_name = token_to_str(&parser->current);
+  char* global_name = token_to_str(&parser->previous);
   if (global_name == NULL) {
     parser_set_error(parser, strdup("Memory allocation error for global variable name"));
     return NULL;
@@ -942,6 +970,204 @@ static ast_node_t* parse_global(parser_t* parser) {
   return global;
 }
 
+/**
+ * @brief Parse the optional attribute list of a function declaration.
+ * 
+ * @param parser The parser.
+ * @param attributes Where to store the function_attribute_t flags.
+ * @return true on success, false on error.
+ */
+static bool parse_function_attributes(parser_t* parser, uint32_t* attributes) {
+  *attributes = 0;
+  if (!parser_match(parser, TOKEN_LBRACKET)) {
+    return true;
+  }
+  
+  do {
+    if (!parser_expect(parser, TOKEN_IDENTIFIER, "Expected function attribute name")) {
+      return false;
+    }
+    
+    char name[16];
+    size_t length = parser->previous.length < sizeof(name) - 1 ? 
+                    parser->previous.length : sizeof(name) - 1;
+    memcpy(name, parser->previous.start, length);
+    name[length] = '\0';
+    
+    uint32_t attribute = coil_lookup_function_attribute(name);
+    if (attribute == 0 || (*attributes & attribute) != 0) {
+      char error[64];
+      snprintf(error, sizeof(error), "%s function attribute '%s'", 
+               attribute == 0 ? "Unknown" : "Duplicate", name);
+      parser_set_error(parser, strdup(error));
+      return false;
+    }
+    *attributes |= attribute;
+  } while (parser_match(parser, TOKEN_COMMA));
+  
+  return parser_expect(parser, TOKEN_RBRACKET, "Expected ']' after function attributes");
+}
+
+/**
+ * @brief Parse a string property value of a target declaration.
+ * 
+ * @param parser The parser.
+ * @param value Where to store the value; a value already set is a duplicate.
+ * @param key The property name, for error messages.
+ * @return true on success, false on error.
+ */
+static bool parse_target_string(parser_t* parser, char** value, const char* key) {
+  if (*value != NULL) {
+    char error[64];
+    snprintf(error, sizeof(error), "Duplicate target property '%s'", key);
+    parser_set_error(parser, strdup(error));
+    return false;
+  }
+  
+  if (!parser_expect(parser, TOKEN_STRING, "Expected string value for target property")) {
+    return false;
+  }
+  
+  *value = token_to_str(&parser->previous);
+  if (*value == NULL) {
+    parser_set_error(parser, strdup("Memory allocation error for target property"));
+    return false;
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Parse a feature list property of a target declaration.
+ * 
+ * @param parser The parser.
+ * @param features The list to fill; a list already filled is a duplicate.
+ * @param key The property name, for error messages.
+ * @return true on success, false on error.
+ */
+static bool parse_target_features(parser_t* parser, ast_node_list_t* features, const char* key) {
+  if (features->count > 0) {
+    char error[64];
+    snprintf(error, sizeof(error), "Duplicate target property '%s'", key);
+    parser_set_error(parser, strdup(error));
+    return false;
+  }
+  
+  if (!parser_expect(parser, TOKEN_LBRACKET, "Expected '[' to start feature list")) {
+    return false;
+  }
+  
+  do {
+    if (!parser_check(parser, TOKEN_STRING)) {
+      parser_set_error(parser, strdup("Expected feature name string"));
+      return false;
+    }
+    
+    ast_node_t* feature = parse_expression(parser);
+    if (feature == NULL) {
+      return false;
+    }
+    
+    if (!ast_add_node(features, feature)) {
+      ast_destroy_node(feature);
+      parser_set_error(parser, strdup("Memory allocation error adding feature"));
+      return false;
+    }
+  } while (parser_match(parser, TOKEN_COMMA));
+  
+  return parser_expect(parser, TOKEN_RBRACKET, "Expected ']' after feature list");
+}
+
+/**
+ * @brief Parse a target declaration.
+ * 
+ * A target names a device class, the features a device must have to run
+ * code compiled for it, the features that make such code faster, and the
+ * machine model to tune that code for.
+ * 
+ * @param parser The parser.
+ * @return The parsed target AST node, or NULL on error.
+ */
+static ast_node_t* parse_target(parser_t* parser) {
+  /* Expect TARGET keyword */
+  if (!parser_expect(parser, TOKEN_TARGET, "Expected 'TARGET' keyword")) {
+    return NULL;
+  }
+  
+  /* Expect target name identifier */
+  if (!parser_expect(parser, TOKEN_IDENTIFIER, "Expected target name identifier")) {
+    return NULL;
+  }
+  
+  /* Create target node */
+  ast_node_t* target = ast_create_node(AST_TARGET);
+  if (target == NULL) {
+    parser_set_error(parser, strdup("Memory allocation error for target"));
+    return NULL;
+  }
+  
+  ast_set_location(target, parser->previous.line, parser->previous.column, 
+                   parser->filename);
+  
+  target->data.target.name = token_to_str(&parser->previous);
+  if (target->data.target.name == NULL) {
+    ast_destroy_node(target);
+    parser_set_error(parser, strdup("Memory allocation error for target name"));
+    return NULL;
+  }
+  
+  /* Expect opening brace */
+  if (!parser_expect(parser, TOKEN_LBRACE, "Expected '{' to start target properties")) {
+    ast_destroy_node(target);
+    return NULL;
+  }
+  
+  /* Parse properties of the form key = value; */
+  while (!parser_check(parser, TOKEN_RBRACE)) {
+    if (!parser_expect(parser, TOKEN_IDENTIFIER, "Expected target property name")) {
+      ast_destroy_node(target);
+      return NULL;
+    }
+    
+    char key[16];
+    size_t length = parser->previous.length < sizeof(key) - 1 ? 
+                    parser->previous.length : sizeof(key) - 1;
+    memcpy(key, parser->previous.start, length);
+    key[length] = '\0';
+    
+    if (!parser_expect(parser, TOKEN_EQUAL, "Expected '=' after target property name")) {
+      ast_destroy_node(target);
+      return NULL;
+    }
+    
+    bool success = false;
+    if (strcmp(key, "device") == 0) {
+      success = parse_target_string(parser, &target->data.target.device_class, key);
+    } else if (strcmp(key, "required") == 0) {
+      success = parse_target_features(parser, &target->data.target.required_features, key);
+    } else if (strcmp(key, "preferred") == 0) {
+      success = parse_target_features(parser, &target->data.target.preferred_features, key);
+    } else if (strcmp(key, "model") == 0) {
+      success = parse_target_string(parser, &target->data.target.model, key);
+    } else {
+      char error[64];
+      snprintf(error, sizeof(error), "Unknown target property '%s'", key);
+      parser_set_error(parser, strdup(error));
+    }
+    
+    if (!success || 
+        !parser_expect(parser, TOKEN_SEMICOLON, "Expected ';' after target property")) {
+      ast_destroy_node(target);
+      return NULL;
+    }
+  }
+  
+  /* Consume the closing brace */
+  parser_advance(parser);
+  
+  return target;
+}
+
 /**
  * @brief Parse a function declaration.
  * 
@@ -949,6 +1175,9 @@ static ast_node_t* parse_global(parser_t* parser) {
  * @return The parsed function AST node, or NULL on error.
  */
 static ast_node_t* parse_function(parser_t* parser) {
+  /* Functions marked INTERNAL are not called from outside the module */
+  bool is_internal = parser_match(parser, TOKEN_INTERNAL);
+  
   /* Expect FUNCTION keyword */
   if (!parser_expect(parser, TOKEN_FUNCTION, "Expected 'FUNCTION' keyword")) {
     return NULL;
@@ -960,7 +1189,7 @@ static ast_node_t* parse_function(parser_t* parser) {
   }
   
   /* Get the function name */
-  char* function_name = token_to_str(&parser->current);
+  char* function_name = token_to_str(&parser->previous);
   if (function_name == NULL) {
     parser_set_error(parser, strdup("Memory allocation error for function name"));
     return NULL;
@@ -982,6 +1211,7 @@ static ast_node_t* parse_function(parser_t* parser) {
   
   /* Set function name */
   function->data.function.name = function_name;
+  function->data.function.is_internal = is_internal;
   
   /* Initialize parameters list */
   function->data.function.parameters.nodes = NULL;
@@ -1007,7 +1237,7 @@ static ast_node_t* parse_function(parser_t* parser) {
       }
       
       /* Get the parameter name */
-      char* param_name = token_to_str(&parser->current);
+      char* param_name = token_to_str(&parser->previous);
       if (param_name == NULL) {
         ast_destroy_node(function);
         parser_set_error(parser, strdup("Memory allocation error for parameter name"));
@@ -1079,32 +1309,33 @@ static ast_node_t* parse_function(parser_t* parser) {
   /* Set function return type */
   function->data.function.return_type = return_type;
   
-  /* Check for optional target specification */
-  if (parser_check(parser, TOKEN_TARGET)) {
-    /* Parse target specification (simplified for now) */
-    ast_node_t* target = ast_create_node(AST_TARGET);
-    if (target == NULL) {
-      ast_destroy_node(function);
-      parser_set_error(parser, strdup("Memory allocation error for target"));
-      return NULL;
-    }
-    
-    /* For now, skip target specification */
-    /* This should be properly parsed in a full implementation */
-    parser_advance(parser);
-    
-    /* Expect target specifier (string or identifier) */
-    if (parser_check(parser, TOKEN_STRING) || parser_check(parser, TOKEN_IDENTIFIER)) {
-      parser_advance(parser);
-    } else {
-      ast_destroy_node(target);
-      ast_destroy_node(function);
-      parser_set_error(parser, strdup("Expected target specifier"));
-      return NULL;
-    }
-    
-    /* Set function target */
-    function->data.function.target = target;
+  if (!parse_function_attributes(parser, &function->data.function.attributes)) {
+    ast_destroy_node(function);
+    return NULL;
+  }
+  
+  /* Targets to compile extra versions of the function for */
+  if (parser_match(parser, TOKEN_TARGET)) {
+    do {
+      if (!parser_check(parser, TOKEN_IDENTIFIER)) {
+        ast_destroy_node(function);
+        parser_set_error(parser, strdup("Expected target name identifier"));
+        return NULL;
+      }
+      
+      ast_node_t* version = parse_expression(parser);
+      if (version == NULL) {
+        ast_destroy_node(function);
+        return NULL;
+      }
+      
+      if (!ast_add_node(&function->data.function.versions, version)) {
+        ast_destroy_node(version);
+        ast_destroy_node(function);
+        parser_set_error(parser, strdup("Memory allocation error adding target"));
+        return NULL;
+      }
+    } while (parser_match(parser, TOKEN_COMMA));
   }
   
   /* Expect opening brace */
@@ -1163,7 +1394,7 @@ static ast_node_t* parse_extern_function(parser_t* parser) {
   }
   
   /* Get the function name */
-  char* function_name = token_to_str(&parser->current);
+  char* function_name = token_to_str(&parser->previous);
   if (function_name == NULL) {
     parser_set_error(parser, strdup("Memory allocation error for external function name"));
     return NULL;
@@ -1227,7 +1458,7 @@ static ast_node_t* parse_extern_function(parser_t* parser) {
       }
       
       /* Get the parameter name */
-      char* param_name = token_to_str(&parser->current);
+      char* param_name = token_to_str(&parser->previous);
       if (param_name == NULL) {
         ast_destroy_node(extern_function);
         parser_set_error(parser, strdup("Memory allocation error for parameter name"));
@@ -1299,6 +1530,11 @@ static ast_node_t* parse_extern_function(parser_t* parser) {
   /* Set external function return type */
   extern_function->data.extern_function.return_type = return_type;
   
+  if (!parse_function_attributes(parser, &extern_function->data.extern_function.attributes)) {
+    ast_destroy_node(extern_function);
+    return NULL;
+  }
+  
   /* Expect semicolon */
   if (!parser_expect(parser, TOKEN_SEMICOLON, "Expected ';' after external function declaration")) {
     ast_destroy_node(extern_function);
@@ -1321,7 +1557,7 @@ static ast_node_t* parse_block(parser_t* parser) {
   }
   
   /* Get the block label */
-  char* block_label = token_to_str(&parser->current);
+  char* block_label = token_to_str(&parser->previous);
   if (block_label == NULL) {
     parser_set_error(parser, strdup("Memory allocation error for block label"));
     return NULL;
@@ -1432,7 +1668,9 @@ static ast_node_t* parse_assignment(parser_t* parser) {
     return NULL;
   }
   
-  /* Get the target name BEFORE consuming the token */
+  /* Get the target name and location BEFORE consuming the token */
+  int line = parser->current.line;
+  int column = parser->current.column;
   char* target = token_to_str(&parser->current);
   if (target == NULL) {
     parser_set_error(parser, strdup("Memory allocation error for assignment target"));
@@ -1469,12 +1707,187 @@ static ast_node_t* parse_assignment(parser_t* parser) {
   assignment->data.stmt_assign.value = value;
   
   /* Set assignment location */
-  ast_set_location(assignment, parser->current.line, parser->current.column, 
-                  parser->filename);
+  ast_set_location(assignment, line, column, parser->filename);
   
   return assignment;
 }
 
+/**
+ * @brief Names of the memory orderings, indexed by memory_order_t.
+ */
+static const char* const memory_order_names[] = {
+  "relaxed", "acquire", "release", "acq_rel", "seq_cst"
+};
+
+/**
+ * @brief Names of the ATOMIC_RMW operations, indexed by atomic_rmw_op_t.
+ */
+static const char* const atomic_rmw_names[] = {
+  "add", "and", "or", "xor", "xchg", "min", "max"
+};
+
+/**
+ * @brief Look up an identifier operand in a table of names.
+ * 
+ * @param operand The operand.
+ * @param names The names.
+ * @param count The number of names.
+ * @return The index of the name, or -1 if the operand is not one of them.
+ */
+static int lookup_operand_name(const ast_node_t* operand, const char* const* names,
+                               size_t count) {
+  if (operand->type != AST_EXPR_IDENTIFIER) {
+    return -1;
+  }
+  
+  for (size_t i = 0; i < count; i++) {
+    if (strcmp(operand->data.expr_identifier.name, names[i]) == 0) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Move the ordering and operation operands of an atomic instruction into its flags.
+ * 
+ * The last operand of ATOMIC_LOAD, ATOMIC_STORE, ATOMIC_RMW, CMPXCHG and
+ * FENCE names the memory ordering, and the first operand of ATOMIC_RMW the
+ * operation. They are not values, so they are removed from the operands.
+ * 
+ * @param parser The parser.
+ * @param instruction The instruction statement AST node.
+ * @return true on success, false on error.
+ */
+static bool parse_atomic_flags(parser_t* parser, ast_node_t* instruction) {
+  const char* opcode = instruction->data.stmt_instruction.opcode;
+  ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+  bool rmw = strcmp(opcode, "ATOMIC_RMW") == 0;
+  
+  if (!rmw && strcmp(opcode, "ATOMIC_LOAD") != 0 && strcmp(opcode, "ATOMIC_STORE") != 0 &&
+      strcmp(opcode, "CMPXCHG") != 0 && strcmp(opcode, "FENCE") != 0) {
+    return true;
+  }
+  
+  int order = operands->count > 0 ?
+    lookup_operand_name(operands->nodes[operands->count - 1], memory_order_names,
+                        sizeof(memory_order_names) / sizeof(memory_order_names[0])) : -1;
+  if (order < 0) {
+    char error[96];
+    snprintf(error, sizeof(error), "%s requires a memory ordering as its last operand", opcode);
+    parser_set_error(parser, strdup(error));
+    return false;
+  }
+  operands->count--;
+  ast_destroy_node(operands->nodes[operands->count]);
+  instruction->data.stmt_instruction.flags = (uint8_t)order;
+  
+  if (rmw) {
+    int op = operands->count > 0 ?
+      lookup_operand_name(operands->nodes[0], atomic_rmw_names,
+                          sizeof(atomic_rmw_names) / sizeof(atomic_rmw_names[0])) : -1;
+    if (op < 0) {
+      parser_set_error(parser, strdup("ATOMIC_RMW requires an operation as its first operand"));
+      return false;
+    }
+    ast_destroy_node(operands->nodes[0]);
+    memmove(operands->nodes, operands->nodes + 1, (operands->count - 1) * sizeof(ast_node_t*));
+    operands->count--;
+    instruction->data.stmt_instruction.flags |= (uint8_t)(op << INSTRUCTION_RMW_SHIFT);
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Names of the PREFETCH accesses, indexed by whether they write.
+ */
+static const char* const prefetch_access_names[] = {
+  "read", "write"
+};
+
+/**
+ * @brief Move the access operand of a PREFETCH into its flags.
+ * 
+ * The second operand of PREFETCH tells whether the memory is about to be
+ * read or written. It is not a value, so it is removed from the operands.
+ * 
+ * @param parser The parser.
+ * @param instruction The instruction statement AST node.
+ * @return true on success, false on error.
+ */
+static bool parse_prefetch_flags(parser_t* parser, ast_node_t* instruction) {
+  ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+  if (strcmp(instruction->data.stmt_instruction.opcode, "PREFETCH") != 0) {
+    return true;
+  }
+  
+  int access = operands->count > 1 ?
+    lookup_operand_name(operands->nodes[1], prefetch_access_names,
+                        sizeof(prefetch_access_names) / sizeof(prefetch_access_names[0])) : -1;
+  if (access < 0) {
+    parser_set_error(parser, strdup("PREFETCH requires read or write as its second operand"));
+    return false;
+  }
+  ast_destroy_node(operands->nodes[1]);
+  memmove(operands->nodes + 1, operands->nodes + 2, (operands->count - 2) * sizeof(ast_node_t*));
+  operands->count--;
+  instruction->data.stmt_instruction.flags = access ? INSTRUCTION_PREFETCH_WRITE : 0;
+  
+  return true;
+}
+
+/**
+ * @brief Parse an access modifier of a LOAD or STORE.
+ * 
+ * Modifiers follow the operands: align=N asserts that the address is a
+ * multiple of N and nontemporal that the access should bypass the cache.
+ * The type checker validates the alignment.
+ * 
+ * @param parser The parser.
+ * @param instruction The instruction statement AST node.
+ * @param operand The operand just parsed.
+ * @return 1 if the operand is a modifier, 0 if it is a value, -1 on error.
+ */
+static int parse_access_modifier(parser_t* parser, ast_node_t* instruction,
+                                 const ast_node_t* operand) {
+  if (operand->type != AST_EXPR_IDENTIFIER) {
+    return 0;
+  }
+  
+  const char* name = operand->data.expr_identifier.name;
+  bool align = strcmp(name, "align") == 0 && parser_check(parser, TOKEN_EQUAL);
+  if (!align && strcmp(name, "nontemporal") != 0) {
+    return 0;
+  }
+  
+  if ((align && instruction->data.stmt_instruction.alignment != 0) ||
+      (!align && (instruction->data.stmt_instruction.flags & INSTRUCTION_NONTEMPORAL) != 0)) {
+    char error[64];
+    snprintf(error, sizeof(error), "Duplicate access modifier '%s'", name);
+    parser_set_error(parser, strdup(error));
+    return -1;
+  }
+  
+  if (!align) {
+    instruction->data.stmt_instruction.flags |= INSTRUCTION_NONTEMPORAL;
+    return 1;
+  }
+  
+  parser_advance(parser);
+  if (!parser_expect(parser, TOKEN_INTEGER, "Expected alignment after 'align='")) {
+    return -1;
+  }
+  
+  int64_t value = parser->previous.value.int_value;
+  if (value <= 0 || value > UINT32_MAX) {
+    parser_set_error(parser, strdup("Alignment must be a positive integer"));
+    return -1;
+  }
+  instruction->data.stmt_instruction.alignment = (uint32_t)value;
+  return 1;
+}
+
 /**
  * @brief Parse an instruction statement.
  * 
@@ -1521,7 +1934,9 @@ static ast_node_t* parse_instruction(parser_t* parser) {
   /* Advance past the opcode */
   parser_advance(parser);
   
-  /* Parse operands */
+  /* Parse operands, then the access modifiers of LOAD and STORE */
+  bool access = strcmp(opcode, "LOAD") == 0 || strcmp(opcode, "STORE") == 0;
+  bool modifiers = false;
   bool first_operand = true;
   while (!parser_check(parser, TOKEN_SEMICOLON)) {
     /* Expect comma between operands (except for the first one) */
@@ -1538,6 +1953,23 @@ static ast_node_t* parse_instruction(parser_t* parser) {
       ast_destroy_node(instruction);
       return NULL;
     }
+    first_operand = false;
+    
+    int modifier = access ? parse_access_modifier(parser, instruction, operand) : 0;
+    if (modifier != 0 || modifiers) {
+      ast_destroy_node(operand);
+      if (modifier == 0) {
+        char error[64];
+        snprintf(error, sizeof(error), "Operands of %s must precede its modifiers", opcode);
+        parser_set_error(parser, strdup(error));
+      }
+      if (modifier <= 0) {
+        ast_destroy_node(instruction);
+        return NULL;
+      }
+      modifiers = true;
+      continue;
+    }
     
     /* Add operand to instruction */
     if (!ast_add_node(&instruction->data.stmt_instruction.operands, operand)) {
@@ -1546,8 +1978,11 @@ static ast_node_t* parse_instruction(parser_t* parser) {
       parser_set_error(parser, strdup("Memory allocation error adding operand"));
       return NULL;
     }
-    
-    first_operand = false;
+  }
+  
+  if (!parse_atomic_flags(parser, instruction) || !parse_prefetch_flags(parser, instruction)) {
+    ast_destroy_node(instruction);
+    return NULL;
   }
   
   /* Expect semicolon */
@@ -1559,6 +1994,85 @@ static ast_node_t* parse_instruction(parser_t* parser) {
   return instruction;
 }
 
+/**
+ * @brief Weight of the favoured target of a !likely or !unlikely branch.
+ * 
+ * The other target weighs 1.
+ */
+#define BRANCH_HINT_WEIGHT 2000
+
+/**
+ * @brief Parse a weight of a !weights branch hint.
+ * 
+ * @param parser The parser.
+ * @param weight Where to store the weight.
+ * @return true on success, false on error.
+ */
+static bool parse_branch_weight(parser_t* parser, uint32_t* weight) {
+  if (!parser_expect(parser, TOKEN_INTEGER, "Expected branch weight")) {
+    return false;
+  }
+  
+  int64_t value = parser->previous.value.int_value;
+  if (value < 0 || value > UINT32_MAX) {
+    parser_set_error(parser, strdup("Branch weights must be from 0 to 4294967295"));
+    return false;
+  }
+  *weight = (uint32_t)value;
+  return true;
+}
+
+/**
+ * @brief Parse the probability hint of a conditional branch after its '!'.
+ * 
+ * The hint is likely, unlikely, or weights(t, f) giving the relative
+ * likelihood of the true and the false target.
+ * 
+ * @param parser The parser.
+ * @param branch The branch statement AST node.
+ * @return true on success, false on error.
+ */
+static bool parse_branch_hint(parser_t* parser, ast_node_t* branch) {
+  if (!parser_expect(parser, TOKEN_IDENTIFIER, "Expected branch hint after '!'")) {
+    return false;
+  }
+  
+  char name[16];
+  size_t length = parser->previous.length < sizeof(name) - 1 ? 
+                  parser->previous.length : sizeof(name) - 1;
+  memcpy(name, parser->previous.start, length);
+  name[length] = '\0';
+  
+  ast_stmt_branch_t* data = &branch->data.stmt_branch;
+  if (strcmp(name, "likely") == 0 || strcmp(name, "unlikely") == 0) {
+    bool likely = name[0] == 'l';
+    data->true_weight = likely ? BRANCH_HINT_WEIGHT : 1;
+    data->false_weight = likely ? 1 : BRANCH_HINT_WEIGHT;
+    return true;
+  }
+  
+  if (strcmp(name, "weights") != 0) {
+    char error[64];
+    snprintf(error, sizeof(error), "Unknown branch hint '%s'", name);
+    parser_set_error(parser, strdup(error));
+    return false;
+  }
+  
+  if (!parser_expect(parser, TOKEN_LPAREN, "Expected '(' after 'weights'") ||
+      !parse_branch_weight(parser, &data->true_weight) ||
+      !parser_expect(parser, TOKEN_COMMA, "Expected ',' between branch weights") ||
+      !parse_branch_weight(parser, &data->false_weight) ||
+      !parser_expect(parser, TOKEN_RPAREN, "Expected ')' after branch weights")) {
+    return false;
+  }
+  
+  if (data->true_weight == 0 && data->false_weight == 0) {
+    parser_set_error(parser, strdup("Branch weights cannot both be zero"));
+    return false;
+  }
+  return true;
+}
+
 /**
  * @brief Parse a branch statement.
  * 
@@ -1567,6 +2081,8 @@ static ast_node_t* parse_instruction(parser_t* parser) {
  */
 static ast_node_t* parse_branch(parser_t* parser) {
   /* Expect BR keyword */
+  int line = parser->current.line;
+  int column = parser->current.column;
   if (!parser_expect(parser, TOKEN_BR, "Expected 'BR' keyword")) {
     return NULL;
   }
@@ -1584,12 +2100,12 @@ static ast_node_t* parse_branch(parser_t* parser) {
   branch->data.stmt_branch.false_target = NULL;
   
   /* Set branch location */
-  ast_set_location(branch, parser->current.line, parser->current.column, 
-                  parser->filename);
+  ast_set_location(branch, line, column, parser->filename);
   
   /* Check for condition (optional) */
-  if (!parser_check(parser, TOKEN_IDENTIFIER) || parser->current.length == 6) {
-    /* Unconditional branch (condition is "ALWAYS" or similar) */
+  if (!parser_check(parser, TOKEN_IDENTIFIER) ||
+      (parser->current.length == 6 && strncmp(parser->current.start, "ALWAYS", 6) == 0)) {
+    /* Unconditional branch (condition is "ALWAYS") */
     parser_advance(parser);
     
     /* Expect comma */
@@ -1605,7 +2121,7 @@ static ast_node_t* parse_branch(parser_t* parser) {
     }
     
     /* Get the target label */
-    branch->data.stmt_branch.true_target = token_to_str(&parser->current);
+    branch->data.stmt_branch.true_target = token_to_str(&parser->previous);
     if (branch->data.stmt_branch.true_target == NULL) {
       ast_destroy_node(branch);
       parser_set_error(parser, strdup("Memory allocation error for branch target"));
@@ -1635,7 +2151,7 @@ static ast_node_t* parse_branch(parser_t* parser) {
     }
     
     /* Get the true target label */
-    branch->data.stmt_branch.true_target = token_to_str(&parser->current);
+    branch->data.stmt_branch.true_target = token_to_str(&parser->previous);
     if (branch->data.stmt_branch.true_target == NULL) {
       ast_destroy_node(branch);
       parser_set_error(parser, strdup("Memory allocation error for branch true target"));
@@ -1655,7 +2171,7 @@ static ast_node_t* parse_branch(parser_t* parser) {
     }
     
     /* Get the false target label */
-    branch->data.stmt_branch.false_target = token_to_str(&parser->current);
+    branch->data.stmt_branch.false_target = token_to_str(&parser->previous);
     if (branch->data.stmt_branch.false_target == NULL) {
       ast_destroy_node(branch);
       parser_set_error(parser, strdup("Memory allocation error for branch false target"));
@@ -1663,6 +2179,19 @@ static ast_node_t* parse_branch(parser_t* parser) {
     }
   }
   
+  /* Optional probability hint */
+  if (parser_match(parser, TOKEN_BANG)) {
+    if (branch->data.stmt_branch.condition == NULL) {
+      parser_set_error(parser, strdup("Only conditional branches take probability hints"));
+      ast_destroy_node(branch);
+      return NULL;
+    }
+    if (!parse_branch_hint(parser, branch)) {
+      ast_destroy_node(branch);
+      return NULL;
+    }
+  }
+  
   /* Expect semicolon */
   if (!parser_expect(parser, TOKEN_SEMICOLON, "Expected ';' after branch statement")) {
     ast_destroy_node(branch);
@@ -1680,6 +2209,8 @@ static ast_node_t* parse_branch(parser_t* parser) {
  */
 static ast_node_t* parse_return(parser_t* parser) {
   /* Expect RET keyword */
+  int line = parser->current.line;
+  int column = parser->current.column;
   if (!parser_expect(parser, TOKEN_RET, "Expected 'RET' keyword")) {
     return NULL;
   }
@@ -1695,8 +2226,7 @@ static ast_node_t* parse_return(parser_t* parser) {
   ret->data.stmt_return.value = NULL;
   
   /* Set return location */
-  ast_set_location(ret, parser->current.line, parser->current.column, 
-                  parser->filename);
+  ast_set_location(ret, line, column, parser->filename);
   
   /* Check for return value (optional) */
   if (!parser_check(parser, TOKEN_SEMICOLON)) {
@@ -1776,8 +2306,48 @@ static ast_node_t* parse_expression(parser_t* parser) {
       }
       parser_advance(parser);
       
-      /* Check for field access */
-      if (parser_match(parser, TOKEN_DOT)) {
+      /* Field accesses and element indexing, which may be chained */
+      while (expr != NULL && (parser_check(parser, TOKEN_DOT) || 
+                              parser_check(parser, TOKEN_LBRACKET))) {
+        if (parser_match(parser, TOKEN_LBRACKET)) {
+          /* Parse the index expression */
+          ast_node_t* index = parse_expression(parser);
+          if (index == NULL) {
+            ast_destroy_node(expr);
+            return NULL;
+          }
+          
+          /* Expect closing bracket */
+          if (!parser_expect(parser, TOKEN_RBRACKET, "Expected ']' after index")) {
+            ast_destroy_node(index);
+            ast_destroy_node(expr);
+            return NULL;
+          }
+          
+          /* Create element access node */
+          ast_node_t* element_access = ast_create_node(AST_EXPR_INDEX);
+          if (element_access == NULL) {
+            ast_destroy_node(index);
+            ast_destroy_node(expr);
+            parser_set_error(parser, strdup("Memory allocation error for element access"));
+            return NULL;
+          }
+          
+          /* Set element access properties */
+          element_access->data.expr_index.array = expr;
+          element_access->data.expr_index.index = index;
+          
+          /* Set element access location */
+          ast_set_location(element_access, parser->current.line, parser->current.column, 
+                          parser->filename);
+          
+          /* Replace expr with element access */
+          expr = element_access;
+          continue;
+        }
+        
+        parser_advance(parser);
+        
         /* Expect field name identifier */
         if (!parser_expect(parser, TOKEN_IDENTIFIER, "Expected field name identifier")) {
           ast_destroy_node(expr);
@@ -1785,7 +2355,7 @@ static ast_node_t* parse_expression(parser_t* parser) {
         }
         
         /* Get the field name */
-        char* field_name = token_to_str(&parser->current);
+        char* field_name = token_to_str(&parser->previous);
         if (field_name == NULL) {
           ast_destroy_node(expr);
           parser_set_error(parser, strdup("Memory allocation error for field name"));
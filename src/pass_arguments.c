@@ -0,0 +1,821 @@
+/**
+ * @file pass_arguments.c
+ * @brief Dead argument elimination and argument promotion.
+ * 
+ * This file contains an interprocedural pass over the functions marked
+ * INTERNAL whose name is only ever used as the callee of direct calls. It
+ * removes the parameters the body never reads, turns the return type into
+ * void when no caller uses the result, and passes the value behind a
+ * read-only pointer parameter instead of the pointer, rewriting the
+ * signature and every call site together.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Prefix of the variables holding promoted arguments.
+ */
+#define PROMOTED_PREFIX "__hoilc_promoted_"
+
+/**
+ * @brief Most rounds; each round can expose parameters only passed on.
+ */
+#define ARGUMENTS_MAX_ROUNDS 4
+
+/**
+ * @brief Direct call of a function that may be rewritten.
+ */
+typedef struct {
+  ast_node_t* caller;        /**< Function holding the call. */
+  ast_node_t* block;         /**< Block holding the call. */
+  ast_node_t* stmt;          /**< Statement holding the call. */
+  ast_node_t* call;          /**< Call expression. */
+  int32_t callee;            /**< Callee number. */
+} args_site_t;
+
+/**
+ * @brief Function that may be rewritten.
+ */
+typedef struct {
+  ast_node_t* function;      /**< Function AST node. */
+  size_t references;         /**< Number of uses of its name. */
+  size_t calls;              /**< Number of those uses that are direct calls. */
+  bool pinned;               /**< Whether its signature must be kept. */
+} args_function_t;
+
+/**
+ * @brief Changes planned for one function.
+ */
+typedef struct {
+  bool* dead;                /**< Whether each parameter is removed. */
+  bool* promoted;            /**< Whether each parameter is passed by value. */
+  bool drop_return;          /**< Whether the return value is removed. */
+  bool any;                  /**< Whether anything changes. */
+} args_plan_t;
+
+/**
+ * @brief Argument rewriting state.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  effects_t* effects;        /**< Memory effects of the functions this round. */
+  symbol_table_t* globals;   /**< Global symbol table. */
+  ast_node_t* module;        /**< Module AST node. */
+  bool size_only;            /**< Whether rewrites may not add statements. */
+  ir_var_table_t* names;     /**< Names of the functions that may be rewritten. */
+  args_function_t* functions; /**< Function of each name. */
+  ir_var_table_t* vars;      /**< Parameters and locals of every function. */
+  args_site_t* sites;        /**< Direct calls of the functions. */
+  size_t site_count;         /**< Number of calls. */
+  size_t site_capacity;      /**< Capacity of the sites array. */
+  size_t next_id;            /**< Counter for fresh names. */
+  bool failed;               /**< Whether memory allocation failed. */
+} args_t;
+
+/**
+ * @brief Use counting state.
+ */
+typedef struct {
+  const char* name;          /**< Variable name. */
+  size_t count;              /**< Number of uses found. */
+} args_uses_t;
+
+/**
+ * @brief Get the call expression of a statement.
+ * 
+ * @param stmt The statement.
+ * @return The call expression of a CALL instruction, or NULL.
+ */
+static ast_node_t* get_call(ast_node_t* stmt) {
+  if (ir_get_opcode(stmt) != OPCODE_CALL) {
+    return NULL;
+  }
+  
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  if (instruction->data.stmt_instruction.operands.count != 1 ||
+      instruction->data.stmt_instruction.operands.nodes[0]->type != AST_EXPR_CALL) {
+    return NULL;
+  }
+  
+  return instruction->data.stmt_instruction.operands.nodes[0];
+}
+
+/**
+ * @brief Check whether an expression contains a call.
+ * 
+ * @param expr The expression (can be NULL).
+ * @return true if evaluating the expression calls a function.
+ */
+static bool has_call(const ast_node_t* expr) {
+  if (expr == NULL) {
+    return false;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_CALL:
+      return true;
+    
+    case AST_EXPR_FIELD:
+      return has_call(expr->data.expr_field.object);
+    
+    case AST_EXPR_INDEX:
+      return has_call(expr->data.expr_index.array) || has_call(expr->data.expr_index.index);
+    
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Count a use if it names a function that may be rewritten.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The argument rewriting state.
+ */
+static void count_reference(ast_node_t** use, void* data) {
+  args_t* args = (args_t*)data;
+  int32_t id = ir_var_table_find(args->names, (*use)->data.expr_identifier.name);
+  if (id >= 0) {
+    args->functions[id].references++;
+  }
+}
+
+/**
+ * @brief Count the references to functions in an initializer.
+ * 
+ * @param args The argument rewriting state.
+ * @param expr The initializer expression (can be NULL).
+ */
+static void scan_initializer(args_t* args, ast_node_t* expr) {
+  if (expr == NULL) {
+    return;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_IDENTIFIER: {
+      ast_node_t* slot = expr;
+      count_reference(&slot, args);
+      break;
+    }
+    
+    case AST_EXPR_FIELD:
+      scan_initializer(args, expr->data.expr_field.object);
+      break;
+    
+    case AST_EXPR_INDEX:
+      scan_initializer(args, expr->data.expr_index.array);
+      scan_initializer(args, expr->data.expr_index.index);
+      break;
+    
+    case AST_EXPR_CALL:
+      scan_initializer(args, expr->data.expr_call.function);
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        scan_initializer(args, expr->data.expr_call.arguments.nodes[i]);
+      }
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Count a use if it names the variable being counted.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The use counting state.
+ */
+static void count_use(ast_node_t** use, void* data) {
+  args_uses_t* uses = (args_uses_t*)data;
+  if (strcmp((*use)->data.expr_identifier.name, uses->name) == 0) {
+    uses->count++;
+  }
+}
+
+/**
+ * @brief Count the uses of a variable in a function.
+ * 
+ * @param function The function AST node.
+ * @param name The variable name.
+ * @return The number of uses.
+ */
+static size_t count_uses(ast_node_t* function, const char* name) {
+  args_uses_t uses = { name, 0 };
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      ir_visit_uses(block->data.stmt_block.statements.nodes[j], count_use, &uses);
+    }
+  }
+  return uses.count;
+}
+
+/**
+ * @brief Check whether a function assigns a variable.
+ * 
+ * @param function The function AST node.
+ * @param name The variable name.
+ * @return true if some statement assigns the variable.
+ */
+static bool is_assigned(const ast_node_t* function, const char* name) {
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    const ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      if (def != NULL && strcmp(def, name) == 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Check whether a statement loads through a variable.
+ * 
+ * @param stmt The statement.
+ * @param name The pointer variable name.
+ * @return true for an assignment of LOAD without access modifiers whose only
+ *         operand is the variable.
+ */
+static bool is_load_of(ast_node_t* stmt, const char* name) {
+  if (stmt->type != AST_STMT_ASSIGN || ir_get_opcode(stmt) != OPCODE_LOAD) {
+    return false;
+  }
+  
+  /* Modifiers describe the access, which would move into every caller */
+  const ast_node_t* instruction = ir_get_instruction(stmt);
+  if (instruction->data.stmt_instruction.flags != 0 ||
+      instruction->data.stmt_instruction.alignment != 0) {
+    return false;
+  }
+  
+  const ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+  return operands->count == 1 && operands->nodes[0]->type == AST_EXPR_IDENTIFIER &&
+         strcmp(operands->nodes[0]->data.expr_identifier.name, name) == 0;
+}
+
+/**
+ * @brief Record a direct call of a function that may be rewritten.
+ * 
+ * @param args The argument rewriting state.
+ * @param caller The function holding the call.
+ * @param block The block holding the call.
+ * @param stmt The statement holding the call.
+ */
+static void scan_call(args_t* args, ast_node_t* caller, ast_node_t* block, ast_node_t* stmt) {
+  ast_node_t* call = get_call(stmt);
+  if (call == NULL || call->data.expr_call.function->type != AST_EXPR_IDENTIFIER) {
+    return;
+  }
+  
+  int32_t callee = ir_var_table_find(args->names,
+                                     call->data.expr_call.function->data.expr_identifier.name);
+  if (callee < 0) {
+    return;
+  }
+  
+  args_function_t* fn = &args->functions[callee];
+  fn->calls++;
+  if (call->data.expr_call.arguments.count != fn->function->data.function.parameters.count) {
+    fn->pinned = true;
+    return;
+  }
+  
+  if (args->site_count == args->site_capacity) {
+    size_t capacity = args->site_capacity == 0 ? 16 : args->site_capacity * 2;
+    args_site_t* sites = (args_site_t*)realloc(args->sites, capacity * sizeof(args_site_t));
+    if (sites == NULL) {
+      args->failed = true;
+      return;
+    }
+    args->sites = sites;
+    args->site_capacity = capacity;
+  }
+  
+  args_site_t* site = &args->sites[args->site_count++];
+  site->caller = caller;
+  site->block = block;
+  site->stmt = stmt;
+  site->call = call;
+  site->callee = callee;
+}
+
+/**
+ * @brief Number the functions that may be rewritten and find their calls.
+ * 
+ * A function qualifies when it is INTERNAL, owns its code and no alias
+ * shares that code. It is pinned when its name is used anywhere but as
+ * the callee of a direct call.
+ * 
+ * @param args The argument rewriting state.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool collect(args_t* args) {
+  ast_node_list_t* declarations = &args->module->data.module.declarations;
+  args->names = ir_var_table_create();
+  args->vars = ir_var_table_create();
+  args->functions = (args_function_t*)calloc(declarations->count + 1, sizeof(args_function_t));
+  args->failed = args->names == NULL || args->vars == NULL || args->functions == NULL;
+  
+  for (size_t i = 0; i < declarations->count && !args->failed; i++) {
+    ast_node_t* decl = declarations->nodes[i];
+    if (decl->type != AST_FUNCTION || !decl->data.function.is_internal ||
+        decl->data.function.alias != NULL || decl->data.function.target != NULL ||
+        decl->data.function.versions.count > 0 || decl->data.function.blocks.count == 0) {
+      continue;
+    }
+    
+    int32_t id = ir_var_table_intern(args->names, decl->data.function.name);
+    args->failed = id < 0;
+    if (!args->failed) {
+      args->functions[id].function = decl;
+    }
+  }
+  
+  for (size_t i = 0; i < declarations->count && !args->failed; i++) {
+    ast_node_t* decl = declarations->nodes[i];
+    if (decl->type == AST_GLOBAL) {
+      scan_initializer(args, decl->data.global.initializer);
+      continue;
+    }
+    if (decl->type == AST_CONSTANT) {
+      scan_initializer(args, decl->data.constant.value);
+      continue;
+    }
+    if (decl->type != AST_FUNCTION) {
+      continue;
+    }
+    
+    /* Code shared with an alias is reached through a second name */
+    if (decl->data.function.alias != NULL) {
+      int32_t target = ir_var_table_find(args->names, decl->data.function.alias);
+      if (target >= 0) {
+        args->functions[target].pinned = true;
+      }
+      continue;
+    }
+    
+    for (size_t p = 0; p < decl->data.function.parameters.count && !args->failed; p++) {
+      ast_node_t* param = decl->data.function.parameters.nodes[p];
+      args->failed = ir_var_table_intern(args->vars, param->data.parameter.name) < 0;
+    }
+    
+    for (size_t b = 0; b < decl->data.function.blocks.count && !args->failed; b++) {
+      ast_node_t* block = decl->data.function.blocks.nodes[b];
+      for (size_t s = 0; s < block->data.stmt_block.statements.count && !args->failed; s++) {
+        ast_node_t* stmt = block->data.stmt_block.statements.nodes[s];
+        const char* def = ir_get_def(stmt);
+        if (def != NULL) {
+          args->failed = ir_var_table_intern(args->vars, def) < 0;
+        }
+        
+        ir_visit_uses(stmt, count_reference, args);
+        scan_call(args, decl, block, stmt);
+      }
+    }
+  }
+  
+  for (size_t i = 0; i < ir_var_table_count(args->names); i++) {
+    args_function_t* fn = &args->functions[i];
+    fn->pinned = fn->pinned || fn->references != fn->calls;
+  }
+  
+  return !args->failed;
+}
+
+/**
+ * @brief Check whether a parameter can be passed by value instead.
+ * 
+ * The parameter must be a pointer to an integer that the body never
+ * assigns and only loads through, with one load in the entry block so the
+ * pointer is read on every call anyway. The body must not write memory,
+ * directly or through a callee, so every load sees the value read at the
+ * call site.
+ * 
+ * @param args The argument rewriting state.
+ * @param function The function AST node.
+ * @param param The parameter node.
+ * @param uses The number of uses of the parameter.
+ * @return true if the parameter can be promoted.
+ */
+static bool is_promotable(args_t* args, ast_node_t* function, const ast_node_t* param,
+                          size_t uses) {
+  const ast_node_t* type = param->data.parameter.type;
+  uint8_t bits;
+  bool is_signed;
+  if (uses == 0 || type->type != AST_TYPE_PTR ||
+      !ir_integer_type(type->data.type_ptr.element_type, &bits, &is_signed) ||
+      is_assigned(function, param->data.parameter.name)) {
+    return false;
+  }
+  
+  size_t loads = 0;
+  bool entry_load = false;
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      if ((effects_get_flags(args->effects, function, stmt) & IR_FLAG_WRITES_MEMORY) != 0) {
+        return false;
+      }
+      if (is_load_of(stmt, param->data.parameter.name)) {
+        loads++;
+        entry_load = entry_load || i == 0;
+      }
+    }
+  }
+  
+  return loads == uses && entry_load;
+}
+
+/**
+ * @brief Decide what changes in the signature of one function.
+ * 
+ * @param args The argument rewriting state.
+ * @param id The function number.
+ * @param plan The plan to fill, with one entry per parameter.
+ */
+static void plan_function(args_t* args, int32_t id, args_plan_t* plan) {
+  ast_node_t* function = args->functions[id].function;
+  ast_node_list_t* params = &function->data.function.parameters;
+  
+  /* Arguments with calls are evaluated for their effects */
+  bool sites_pure = true;
+  bool results_unused = true;
+  for (size_t s = 0; s < args->site_count; s++) {
+    const args_site_t* site = &args->sites[s];
+    if (site->callee != id) {
+      continue;
+    }
+    
+    for (size_t i = 0; i < params->count; i++) {
+      if (has_call(site->call->data.expr_call.arguments.nodes[i])) {
+        sites_pure = false;
+        plan->dead[i] = false;
+      }
+    }
+    
+    if (site->stmt->type == AST_STMT_ASSIGN &&
+        count_uses(site->caller, site->stmt->data.stmt_assign.target) > 0) {
+      results_unused = false;
+    }
+  }
+  
+  for (size_t i = 0; i < params->count; i++) {
+    ast_node_t* param = params->nodes[i];
+    size_t uses = count_uses(function, param->data.parameter.name);
+    if (uses == 0) {
+      /* A parameter that is assigned keeps its type for the assignments */
+      plan->dead[i] = plan->dead[i] && !is_assigned(function, param->data.parameter.name);
+    } else {
+      plan->dead[i] = false;
+      plan->promoted[i] = !args->size_only && sites_pure &&
+                          is_promotable(args, function, param, uses);
+    }
+    plan->any = plan->any || plan->dead[i] || plan->promoted[i];
+  }
+  
+  /* The returned values are dropped, so they must not call anything */
+  plan->drop_return = results_unused && function->data.function.return_type->type != AST_TYPE_VOID;
+  for (size_t b = 0; b < function->data.function.blocks.count && plan->drop_return; b++) {
+    ast_node_t* block = function->data.function.blocks.nodes[b];
+    for (size_t s = 0; s < block->data.stmt_block.statements.count; s++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[s];
+      if (stmt->type == AST_STMT_RETURN && has_call(stmt->data.stmt_return.value)) {
+        plan->drop_return = false;
+        break;
+      }
+    }
+  }
+  plan->any = plan->any || plan->drop_return;
+}
+
+/**
+ * @brief Find the position of a statement in its block.
+ * 
+ * @param block The block.
+ * @param stmt The statement.
+ * @return The position of the statement.
+ */
+static size_t statement_index(const ast_node_t* block, const ast_node_t* stmt) {
+  size_t index = 0;
+  while (block->data.stmt_block.statements.nodes[index] != stmt) {
+    index++;
+  }
+  return index;
+}
+
+/**
+ * @brief Remove the nodes of a list at the marked positions.
+ * 
+ * @param list The node list.
+ * @param removed Whether each position is removed.
+ */
+static void remove_positions(ast_node_list_t* list, const bool* removed) {
+  size_t kept = 0;
+  for (size_t i = 0; i < list->count; i++) {
+    if (removed[i]) {
+      ast_destroy_node(list->nodes[i]);
+    } else {
+      list->nodes[kept++] = list->nodes[i];
+    }
+  }
+  list->count = kept;
+}
+
+/**
+ * @brief Load a promoted argument in front of its call.
+ * 
+ * @param args The argument rewriting state.
+ * @param site The call site.
+ * @param slot Slot holding the pointer argument, replaced by the loaded value.
+ * @param type The type of the value.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool load_argument(args_t* args, args_site_t* site, ast_node_t** slot, ast_node_t* type) {
+  char buffer[64];
+  do {
+    snprintf(buffer, sizeof(buffer), PROMOTED_PREFIX "%zu", args->next_id++);
+  } while (ir_var_table_find(args->vars, buffer) >= 0 ||
+           symtable_lookup(args->globals, buffer, false) != NULL);
+  
+  ast_node_t* value = ast_create_identifier(buffer);
+  ast_node_t* load = ast_create_instruction("LOAD");
+  ast_node_t* assign = NULL;
+  bool success = value != NULL && load != NULL && ir_var_table_intern(args->vars, buffer) >= 0 &&
+                 ast_add_node(&load->data.stmt_instruction.operands, *slot);
+  if (success) {
+    *slot = value;
+    value = NULL;
+    assign = ast_create_assignment(buffer, load);
+    success = assign != NULL;
+  }
+  if (success) {
+    load = NULL;
+    assign->location = site->stmt->location;
+    assign->data.stmt_assign.target_type = type;
+    success = ast_add_node(&site->block->data.stmt_block.statements, assign);
+  }
+  
+  if (!success) {
+    ast_destroy_node(value);
+    ast_destroy_node(load);
+    ast_destroy_node(assign);
+    return false;
+  }
+  
+  ast_node_list_t* statements = &site->block->data.stmt_block.statements;
+  size_t index = statement_index(site->block, site->stmt);
+  memmove(&statements->nodes[index + 1], &statements->nodes[index],
+          (statements->count - 1 - index) * sizeof(ast_node_t*));
+  statements->nodes[index] = assign;
+  return true;
+}
+
+/**
+ * @brief Rewrite one call site to a new signature.
+ * 
+ * @param args The argument rewriting state.
+ * @param site The call site.
+ * @param plan The plan of the callee.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool rewrite_site(args_t* args, args_site_t* site, const args_plan_t* plan) {
+  const ast_node_list_t* params = &args->functions[site->callee].function->data.function.parameters;
+  ast_node_list_t* arguments = &site->call->data.expr_call.arguments;
+  
+  /* A call whose result is unused becomes a plain CALL instruction */
+  if (plan->drop_return && site->stmt->type == AST_STMT_ASSIGN) {
+    ast_node_t* instruction = site->stmt->data.stmt_assign.value;
+    site->stmt->data.stmt_assign.value = NULL;
+    instruction->location = site->stmt->location;
+    site->block->data.stmt_block.statements.nodes[statement_index(site->block, site->stmt)] =
+      instruction;
+    ast_destroy_node(site->stmt);
+    site->stmt = instruction;
+  }
+  
+  for (size_t i = 0; i < arguments->count; i++) {
+    if (plan->promoted[i] &&
+        !load_argument(args, site, &arguments->nodes[i],
+                       params->nodes[i]->data.parameter.type->data.type_ptr.element_type)) {
+      return false;
+    }
+  }
+  
+  remove_positions(arguments, plan->dead);
+  return true;
+}
+
+/**
+ * @brief Turn the loads through a promoted parameter into moves.
+ * 
+ * @param function The function AST node.
+ * @param name The parameter name.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool promote_loads(ast_node_t* function, const char* name) {
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      if (!is_load_of(stmt, name)) {
+        continue;
+      }
+      
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      char* opcode = strdup("ADD");
+      ast_node_t* zero = ast_create_integer(0);
+      if (opcode == NULL || zero == NULL ||
+          !ast_add_node(&instruction->data.stmt_instruction.operands, zero)) {
+        free(opcode);
+        ast_destroy_node(zero);
+        return false;
+      }
+      
+      zero->location = stmt->location;
+      free(instruction->data.stmt_instruction.opcode);
+      instruction->data.stmt_instruction.opcode = opcode;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Rewrite a function to its new signature.
+ * 
+ * The element type of a promoted pointer moves into the parameter, so
+ * the assignments whose type refers to it stay valid.
+ * 
+ * @param args The argument rewriting state.
+ * @param function The function AST node.
+ * @param plan The plan of the function.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool rewrite_function(args_t* args, ast_node_t* function, const args_plan_t* plan) {
+  ast_node_list_t* params = &function->data.function.parameters;
+  for (size_t i = 0; i < params->count; i++) {
+    ast_node_t* param = params->nodes[i];
+    if (plan->dead[i]) {
+      optimize_remark(args->context, HOILC_REMARK_PASSED, function, param, "DeadArgument",
+                      "removed unused parameter '%s'", param->data.parameter.name);
+    }
+    if (!plan->promoted[i]) {
+      continue;
+    }
+    
+    optimize_remark(args->context, HOILC_REMARK_PASSED, function, param, "PromotedArgument",
+                    "passed parameter '%s' by value", param->data.parameter.name);
+    if (!promote_loads(function, param->data.parameter.name)) {
+      return false;
+    }
+    
+    ast_node_t* pointer = param->data.parameter.type;
+    param->data.parameter.type = pointer->data.type_ptr.element_type;
+    pointer->data.type_ptr.element_type = NULL;
+    ast_destroy_node(pointer);
+  }
+  
+  remove_positions(params, plan->dead);
+  
+  if (plan->drop_return) {
+    optimize_remark(args->context, HOILC_REMARK_PASSED, function, NULL, "DeadReturn",
+                    "removed return value that no caller uses");
+    ast_node_t* type = ast_create_node(AST_TYPE_VOID);
+    if (type == NULL) {
+      return false;
+    }
+    
+    type->location = function->data.function.return_type->location;
+    ast_destroy_node(function->data.function.return_type);
+    function->data.function.return_type = type;
+    symtable_set_type(symtable_lookup(args->globals, function->data.function.name, false), type);
+    
+    for (size_t b = 0; b < function->data.function.blocks.count; b++) {
+      ast_node_t* block = function->data.function.blocks.nodes[b];
+      for (size_t s = 0; s < block->data.stmt_block.statements.count; s++) {
+        ast_node_t* stmt = block->data.stmt_block.statements.nodes[s];
+        if (stmt->type == AST_STMT_RETURN) {
+          ast_destroy_node(stmt->data.stmt_return.value);
+          stmt->data.stmt_return.value = NULL;
+        }
+      }
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Release the per-round state.
+ * 
+ * @param args The argument rewriting state.
+ */
+static void release_round(args_t* args) {
+  ir_var_table_destroy(args->names);
+  ir_var_table_destroy(args->vars);
+  free(args->functions);
+  free(args->sites);
+  args->names = NULL;
+  args->vars = NULL;
+  args->functions = NULL;
+  args->sites = NULL;
+  args->site_count = 0;
+  args->site_capacity = 0;
+}
+
+/**
+ * @brief Plan every function first, then rewrite the call sites and signatures.
+ * 
+ * Plans only remove uses, so planning all functions before rewriting any
+ * of them keeps each plan valid.
+ * 
+ * @param args The argument rewriting state.
+ * @param changed Set to true if a signature changed.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool run_round(args_t* args, bool* changed) {
+  /* The previous round changed signatures and call sites */
+  optimize_invalidate_effects(args->context);
+  args->effects = optimize_get_effects(args->context);
+  if (args->effects == NULL || !collect(args)) {
+    release_round(args);
+    return false;
+  }
+  
+  size_t count = ir_var_table_count(args->names);
+  
+  args_plan_t* plans = (args_plan_t*)calloc(count + 1, sizeof(args_plan_t));
+  bool success = plans != NULL;
+  for (size_t i = 0; i < count && success; i++) {
+    args_function_t* fn = &args->functions[i];
+    size_t params = fn->function->data.function.parameters.count;
+    plans[i].dead = (bool*)malloc((params + 1) * sizeof(bool));
+    plans[i].promoted = (bool*)calloc(params + 1, sizeof(bool));
+    success = plans[i].dead != NULL && plans[i].promoted != NULL;
+    if (success && !fn->pinned) {
+      memset(plans[i].dead, 1, (params + 1) * sizeof(bool));
+      plan_function(args, (int32_t)i, &plans[i]);
+    }
+  }
+  
+  for (size_t s = 0; s < args->site_count && success; s++) {
+    const args_plan_t* plan = &plans[args->sites[s].callee];
+    if (plan->any) {
+      success = rewrite_site(args, &args->sites[s], plan);
+    }
+  }
+  
+  for (size_t i = 0; i < count && success; i++) {
+    if (plans[i].any) {
+      success = rewrite_function(args, args->functions[i].function, &plans[i]);
+      *changed = true;
+    }
+  }
+  
+  for (size_t i = 0; plans != NULL && i < count; i++) {
+    free(plans[i].dead);
+    free(plans[i].promoted);
+  }
+  free(plans);
+  release_round(args);
+  return success;
+}
+
+bool pass_arguments(optimize_context_t* context, ast_node_t* module) {
+  assert(context != NULL);
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  
+  args_t args;
+  memset(&args, 0, sizeof(args));
+  args.context = context;
+  args.globals = optimize_get_symbol_table(context);
+  args.module = module;
+  args.size_only = optimize_get_level(context) == HOILC_OPT_SIZE;
+  
+  bool changed = true;
+  bool success = true;
+  for (size_t round = 0; round < ARGUMENTS_MAX_ROUNDS && changed && success; round++) {
+    changed = false;
+    success = run_round(&args, &changed);
+  }
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL, module,
+                         "Memory allocation failed");
+    return false;
+  }
+  
+  return true;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file pass_evaluate.c
+ * @brief Compile-time evaluation of pure calls.
+ * 
+ * This file contains a pass that runs calls to pure functions with constant
+ * arguments in the evaluator and replaces them with their results, and that
+ * folds constant initializers written as expressions.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/eval.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Check whether every argument of a call is a compile-time constant.
+ * 
+ * Literals and names that are neither parameters nor locals of the calling
+ * function qualify; the evaluator rejects names that are not constants.
+ * 
+ * @param locals The parameters and locals of the calling function.
+ * @param call The call expression.
+ * @return true if the call only takes constants.
+ */
+static bool has_constant_arguments(const ir_var_table_t* locals, const ast_node_t* call) {
+  for (size_t i = 0; i < call->data.expr_call.arguments.count; i++) {
+    const ast_node_t* arg = call->data.expr_call.arguments.nodes[i];
+    if (arg->type == AST_EXPR_INTEGER) {
+      continue;
+    }
+    if (arg->type != AST_EXPR_IDENTIFIER ||
+        ir_var_table_find(locals, arg->data.expr_identifier.name) >= 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Replace the value of an assignment with a move of a constant.
+ * 
+ * @param assign The assignment statement.
+ * @param value The constant.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool assign_constant(ast_node_t* assign, int64_t value) {
+  ast_node_t* instruction = ast_create_instruction("ADD");
+  ast_node_t* lhs = ast_create_integer(value);
+  ast_node_t* rhs = ast_create_integer(0);
+  bool success = instruction != NULL && lhs != NULL && rhs != NULL &&
+                 ast_add_node(&instruction->data.stmt_instruction.operands, lhs);
+  if (!success) {
+    ast_destroy_node(lhs);
+  }
+  success = success && ast_add_node(&instruction->data.stmt_instruction.operands, rhs);
+  if (!success) {
+    ast_destroy_node(rhs);
+    ast_destroy_node(instruction);
+    return false;
+  }
+  
+  instruction->location = assign->data.stmt_assign.value->location;
+  ast_destroy_node(assign->data.stmt_assign.value);
+  assign->data.stmt_assign.value = instruction;
+  return true;
+}
+
+/**
+ * @brief Evaluate the calls of a function that only take constants.
+ * 
+ * @param context The optimizer context.
+ * @param eval The evaluator.
+ * @param function The function AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool evaluate_function(optimize_context_t* context, eval_context_t* eval,
+                              ast_node_t* function) {
+  ir_var_table_t* locals = ir_var_table_create();
+  bool success = locals != NULL;
+  
+  for (size_t i = 0; i < function->data.function.parameters.count && success; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    success = ir_var_table_intern(locals, param->data.parameter.name) >= 0;
+  }
+  for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count && success; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      success = def == NULL || ir_var_table_intern(locals, def) >= 0;
+    }
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+    ast_node_list_t* statements =
+      &function->data.function.blocks.nodes[i]->data.stmt_block.statements;
+    size_t kept = 0;
+    
+    for (size_t j = 0; j < statements->count; j++) {
+      ast_node_t* stmt = statements->nodes[j];
+      statements->nodes[kept++] = stmt;
+      if (!success || ir_get_opcode(stmt) != OPCODE_CALL) {
+        continue;
+      }
+      
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      ast_node_t* call = instruction->data.stmt_instruction.operands.count == 1 ?
+                         instruction->data.stmt_instruction.operands.nodes[0] : NULL;
+      if (call == NULL || call->type != AST_EXPR_CALL ||
+          call->data.expr_call.function->type != AST_EXPR_IDENTIFIER ||
+          !eval_is_pure(eval, call->data.expr_call.function->data.expr_identifier.name) ||
+          !has_constant_arguments(locals, call)) {
+        continue;
+      }
+      
+      /* Calls that trap or exceed a limit are left to run */
+      const char* callee = call->data.expr_call.function->data.expr_identifier.name;
+      int64_t value;
+      eval_status_t status = eval_expression(eval, call, &value);
+      if (status == EVAL_OK) {
+        optimize_remark(context, HOILC_REMARK_PASSED, function, stmt, "Evaluated",
+                        "evaluated call to '%s' at compile time", callee);
+      } else if (status == EVAL_TRAP || status == EVAL_STEP_LIMIT ||
+                 status == EVAL_MEMORY_LIMIT) {
+        optimize_remark(context, HOILC_REMARK_MISSED, function, stmt, "NotEvaluated",
+                        "call to '%s' not evaluated: %s", callee,
+                        status == EVAL_TRAP ? "it traps" :
+                        status == EVAL_STEP_LIMIT ? "it exceeds the step limit" :
+                        "it exceeds the memory limit");
+      }
+      
+      if (status == EVAL_NO_MEMORY) {
+        success = false;
+      } else if (status == EVAL_OK && stmt->type == AST_STMT_ASSIGN) {
+        success = assign_constant(stmt, value);
+      } else if (status == EVAL_OK) {
+        /* A pure call whose result is unused has no effect */
+        ast_destroy_node(stmt);
+        kept--;
+      }
+    }
+    
+    statements->count = kept;
+  }
+  
+  ir_var_table_destroy(locals);
+  return success;
+}
+
+/**
+ * @brief Replace a constant initializer written as an expression with its value.
+ * 
+ * @param eval The evaluator.
+ * @param constant The constant declaration.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool evaluate_constant(eval_context_t* eval, ast_node_t* constant) {
+  ast_node_t* value = constant->data.constant.value;
+  if (value->type == AST_EXPR_INTEGER || value->type == AST_EXPR_FLOAT ||
+      value->type == AST_EXPR_STRING) {
+    return true;
+  }
+  
+  int64_t result;
+  eval_status_t status = eval_constant(eval, constant->data.constant.name, &result);
+  if (status != EVAL_OK) {
+    return status != EVAL_NO_MEMORY;
+  }
+  
+  ast_node_t* literal = ast_create_integer(result);
+  if (literal == NULL) {
+    return false;
+  }
+  
+  literal->location = value->location;
+  ast_destroy_node(value);
+  constant->data.constant.value = literal;
+  return true;
+}
+
+bool pass_evaluate(optimize_context_t* context, ast_node_t* module) {
+  assert(context != NULL);
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  
+  eval_context_t* eval = eval_create_context(module);
+  bool success = eval != NULL;
+  
+  for (size_t i = 0; i < module->data.module.declarations.count && success; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type == AST_CONSTANT) {
+      success = evaluate_constant(eval, decl);
+    } else if (decl->type == AST_FUNCTION) {
+      success = evaluate_function(context, eval, decl);
+    }
+  }
+  
+  eval_destroy_context(eval);
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL, module,
+                         "Memory allocation failed");
+  }
+  
+  return success;
+}
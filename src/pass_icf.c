@@ -0,0 +1,365 @@
+/**
+ * @file pass_icf.c
+ * @brief Identical function folding.
+ * 
+ * This file contains a pass that finds functions whose signatures and
+ * bodies are equal up to the names of locals and blocks, and turns every
+ * duplicate into an alias sharing the code of the first copy.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/ir.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Function considered for folding.
+ */
+typedef struct {
+  ast_node_t* function;      /**< Function AST node. */
+  ir_key_t key;              /**< Canonical signature and body. */
+  uint64_t hash;             /**< Hash of the key. */
+  bool folded;               /**< Whether the function became an alias. */
+} icf_function_t;
+
+/**
+ * @brief Canonicalization state for one function.
+ */
+typedef struct {
+  symbol_table_t* globals;   /**< Global symbol table. */
+  ast_node_t* function;      /**< Function being canonicalized. */
+  ir_var_table_t* locals;    /**< Parameters and locals, numbered in order. */
+  ir_var_table_t* labels;    /**< Block labels, numbered in order. */
+  ir_key_t* key;             /**< Key being built. */
+} icf_canon_t;
+
+/**
+ * @brief Append a variable or symbol reference to a key.
+ * 
+ * @param canon The canonicalization state.
+ * @param name The referenced name.
+ */
+static void append_name(icf_canon_t* canon, const char* name) {
+  int32_t id = ir_var_table_find(canon->locals, name);
+  if (id >= 0) {
+    ir_key_append(canon->key, "%%%d", id);
+  } else if (strcmp(name, canon->function->data.function.name) == 0) {
+    /* Self references stay equal across copies */
+    ir_key_append(canon->key, "@@");
+  } else {
+    ir_key_append(canon->key, "@%zu:%s", strlen(name), name);
+  }
+}
+
+/**
+ * @brief Append a block reference to a key.
+ * 
+ * @param canon The canonicalization state.
+ * @param label The block label (can be NULL).
+ */
+static void append_label(icf_canon_t* canon, const char* label) {
+  if (label == NULL) {
+    ir_key_append(canon->key, "-");
+    return;
+  }
+  
+  int32_t id = ir_var_table_find(canon->labels, label);
+  if (id >= 0) {
+    ir_key_append(canon->key, "L%d", id);
+  } else {
+    ir_key_append(canon->key, "L?%zu:%s", strlen(label), label);
+  }
+}
+
+/**
+ * @brief Append the canonical form of an expression to a key.
+ * 
+ * @param canon The canonicalization state.
+ * @param expr The expression (can be NULL).
+ */
+static void append_expr(icf_canon_t* canon, const ast_node_t* expr) {
+  if (expr == NULL) {
+    ir_key_append(canon->key, "_");
+    return;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_INTEGER:
+      ir_key_append(canon->key, "#%lld", (long long)expr->data.expr_integer.value);
+      break;
+    
+    case AST_EXPR_FLOAT:
+      ir_key_append(canon->key, "#%a", expr->data.expr_float.value);
+      break;
+    
+    case AST_EXPR_STRING:
+      ir_key_append(canon->key, "\"%zu:%s", strlen(expr->data.expr_string.value),
+                    expr->data.expr_string.value);
+      break;
+    
+    case AST_EXPR_IDENTIFIER:
+      append_name(canon, expr->data.expr_identifier.name);
+      break;
+    
+    case AST_EXPR_FIELD:
+      ir_key_append(canon->key, "F(");
+      append_expr(canon, expr->data.expr_field.object);
+      ir_key_append(canon->key, ").%zu:%s", strlen(expr->data.expr_field.field),
+                    expr->data.expr_field.field);
+      break;
+    
+    case AST_EXPR_INDEX:
+      ir_key_append(canon->key, "X(");
+      append_expr(canon, expr->data.expr_index.array);
+      ir_key_append(canon->key, ",");
+      append_expr(canon, expr->data.expr_index.index);
+      ir_key_append(canon->key, ")");
+      break;
+    
+    case AST_EXPR_CALL:
+      ir_key_append(canon->key, "C(");
+      append_expr(canon, expr->data.expr_call.function);
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        ir_key_append(canon->key, ",");
+        append_expr(canon, expr->data.expr_call.arguments.nodes[i]);
+      }
+      ir_key_append(canon->key, ")");
+      break;
+    
+    default:
+      /* Anything else is only equal to itself */
+      ir_key_append(canon->key, "?%p", (const void*)expr);
+      break;
+  }
+}
+
+/**
+ * @brief Append the canonical form of an instruction to a key.
+ * 
+ * @param canon The canonicalization state.
+ * @param instruction The instruction statement.
+ */
+static void append_instruction(icf_canon_t* canon, const ast_node_t* instruction) {
+  ir_key_append(canon->key, "%s:%u:%u(", instruction->data.stmt_instruction.opcode,
+                (unsigned)instruction->data.stmt_instruction.flags,
+                (unsigned)instruction->data.stmt_instruction.alignment);
+  for (size_t i = 0; i < instruction->data.stmt_instruction.operands.count; i++) {
+    if (i > 0) {
+      ir_key_append(canon->key, ",");
+    }
+    append_expr(canon, instruction->data.stmt_instruction.operands.nodes[i]);
+  }
+  ir_key_append(canon->key, ")");
+}
+
+/**
+ * @brief Append the canonical form of a statement to a key.
+ * 
+ * @param canon The canonicalization state.
+ * @param stmt The statement.
+ */
+static void append_statement(icf_canon_t* canon, const ast_node_t* stmt) {
+  switch (stmt->type) {
+    case AST_STMT_ASSIGN: {
+      const ast_node_t* value = stmt->data.stmt_assign.value;
+      if (value->type == AST_STMT_INSTRUCTION) {
+        append_instruction(canon, value);
+      } else {
+        append_expr(canon, value);
+      }
+      ir_key_append(canon->key, "=>");
+      append_name(canon, stmt->data.stmt_assign.target);
+      ir_key_append(canon->key, ":");
+      ir_key_append_type(canon->key, stmt->data.stmt_assign.target_type);
+      break;
+    }
+    
+    case AST_STMT_INSTRUCTION:
+      append_instruction(canon, stmt);
+      break;
+    
+    case AST_STMT_BRANCH:
+      ir_key_append(canon->key, "BR(");
+      append_expr(canon, stmt->data.stmt_branch.condition);
+      ir_key_append(canon->key, ",");
+      append_label(canon, stmt->data.stmt_branch.true_target);
+      ir_key_append(canon->key, ",");
+      append_label(canon, stmt->data.stmt_branch.false_target);
+      ir_key_append(canon->key, ":%u:%u)", (unsigned)stmt->data.stmt_branch.true_weight,
+                    (unsigned)stmt->data.stmt_branch.false_weight);
+      break;
+    
+    case AST_STMT_RETURN:
+      ir_key_append(canon->key, "RET(");
+      append_expr(canon, stmt->data.stmt_return.value);
+      ir_key_append(canon->key, ")");
+      break;
+    
+    default:
+      ir_key_append(canon->key, "?%p", (const void*)stmt);
+      break;
+  }
+  ir_key_append(canon->key, ";");
+}
+
+/**
+ * @brief Build the canonical key of a function.
+ * 
+ * Parameters are numbered by position and locals by their first assignment,
+ * and blocks by position, so copies that differ only in those names get
+ * equal keys. Attributes are part of the signature, so a hot and a cold
+ * copy are kept apart.
+ * 
+ * @param globals The global symbol table.
+ * @param function The function AST node.
+ * @param key The key to fill.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool canonicalize_function(symbol_table_t* globals, ast_node_t* function, ir_key_t* key) {
+  icf_canon_t canon = { globals, function, ir_var_table_create(), ir_var_table_create(), key };
+  bool success = canon.locals != NULL && canon.labels != NULL;
+  
+  /* Signature */
+  ir_key_append(key, "(");
+  for (size_t i = 0; i < function->data.function.parameters.count && success; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    success = ir_var_table_intern(canon.locals, param->data.parameter.name) >= 0;
+    ir_key_append_type(key, param->data.parameter.type);
+    ir_key_append(key, ",");
+  }
+  ir_key_append(key, ")->");
+  ir_key_append_type(key, function->data.function.return_type);
+  ir_key_append(key, "[%x]{", (unsigned)function->data.function.attributes);
+  
+  /* Number blocks and locals before printing any reference to them */
+  for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    success = ir_var_table_intern(canon.labels, block->data.stmt_block.label) >= 0;
+    
+    for (size_t j = 0; j < block->data.stmt_block.statements.count && success; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      if (stmt->type == AST_STMT_ASSIGN &&
+          symtable_lookup(globals, stmt->data.stmt_assign.target, false) == NULL) {
+        success = ir_var_table_intern(canon.locals, stmt->data.stmt_assign.target) >= 0;
+      }
+    }
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    ir_key_append(key, "B:");
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      append_statement(&canon, block->data.stmt_block.statements.nodes[j]);
+    }
+  }
+  ir_key_append(key, "}");
+  
+  ir_var_table_destroy(canon.locals);
+  ir_var_table_destroy(canon.labels);
+  
+  return success && !key->failed;
+}
+
+/**
+ * @brief Compare functions by key hash, then by module order.
+ * 
+ * @param a The first function pointer.
+ * @param b The second function pointer.
+ * @return Negative, zero or positive like strcmp.
+ */
+static int compare_functions(const void* a, const void* b) {
+  const icf_function_t* fa = *(const icf_function_t* const*)a;
+  const icf_function_t* fb = *(const icf_function_t* const*)b;
+  
+  if (fa->hash != fb->hash) {
+    return fa->hash < fb->hash ? -1 : 1;
+  }
+  return fa < fb ? -1 : (fa > fb ? 1 : 0);
+}
+
+/**
+ * @brief Turn a function into an alias of an equal function.
+ * 
+ * @param duplicate The function to fold.
+ * @param original The function whose code is kept.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool fold_function(ast_node_t* duplicate, const ast_node_t* original) {
+  duplicate->data.function.alias = strdup(original->data.function.name);
+  if (duplicate->data.function.alias == NULL) {
+    return false;
+  }
+  
+  ast_destroy_node_list(&duplicate->data.function.blocks);
+  return true;
+}
+
+bool pass_icf(optimize_context_t* context, ast_node_t* module) {
+  assert(context != NULL);
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  
+  symbol_table_t* globals = optimize_get_symbol_table(context);
+  size_t declaration_count = module->data.module.declarations.count;
+  icf_function_t* functions = (icf_function_t*)calloc(declaration_count + 1,
+                                                      sizeof(icf_function_t));
+  icf_function_t** order = (icf_function_t**)malloc((declaration_count + 1) *
+                                                    sizeof(icf_function_t*));
+  bool success = functions != NULL && order != NULL;
+  
+  /* Hash every function that owns its code */
+  size_t count = 0;
+  for (size_t i = 0; i < declaration_count && success; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type != AST_FUNCTION || decl->data.function.alias != NULL ||
+        decl->data.function.target != NULL || decl->data.function.versions.count > 0) {
+      continue;
+    }
+    
+    icf_function_t* fn = &functions[count];
+    fn->function = decl;
+    success = canonicalize_function(globals, decl, &fn->key);
+    fn->hash = ir_key_hash(&fn->key);
+    order[count] = fn;
+    count++;
+  }
+  
+  if (success && count > 1) {
+    qsort(order, count, sizeof(icf_function_t*), compare_functions);
+  }
+  
+  /* Fold each later copy into the first function with an equal key */
+  for (size_t i = 0; i < count && success; i++) {
+    if (order[i]->folded) {
+      continue;
+    }
+    
+    for (size_t j = i + 1; j < count && order[j]->hash == order[i]->hash && success; j++) {
+      if (!order[j]->folded && ir_key_equal(&order[i]->key, &order[j]->key)) {
+        optimize_remark(context, HOILC_REMARK_PASSED, order[j]->function, NULL, "Folded",
+                        "folded '%s' into identical function '%s'",
+                        order[j]->function->data.function.name,
+                        order[i]->function->data.function.name);
+        success = fold_function(order[j]->function, order[i]->function);
+        order[j]->folded = true;
+      }
+    }
+  }
+  
+  for (size_t i = 0; functions != NULL && i < count; i++) {
+    ir_key_free(&functions[i].key);
+  }
+  free(functions);
+  free(order);
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL, module,
+                         "Memory allocation failed");
+  }
+  
+  return success;
+}
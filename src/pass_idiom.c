@@ -0,0 +1,311 @@
+/**
+ * @file pass_idiom.c
+ * @brief Idiom recognition for bit manipulation.
+ * 
+ * This file contains a pass that finds rotates written as two shifts of
+ * the same value joined by OR and replaces them with ROTL or ROTR, removing
+ * the shifts nothing else reads.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/ir.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Idiom recognition state for one function.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  symbol_table_t* globals;  /**< Global symbol table. */
+  ast_node_t* function;     /**< Function AST node. */
+  ir_var_table_t* vars;     /**< Variables defined in the function. */
+  size_t* uses;             /**< Uses of each variable. */
+} idiom_t;
+
+/**
+ * @brief Use visitor that counts the uses of each variable.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The idiom recognition state.
+ */
+static void count_use(ast_node_t** use, void* data) {
+  idiom_t* idiom = (idiom_t*)data;
+  int32_t id = ir_var_table_find(idiom->vars, (*use)->data.expr_identifier.name);
+  if (id >= 0) {
+    idiom->uses[id]++;
+  }
+}
+
+/**
+ * @brief Number the variables of a function and count their uses.
+ * 
+ * @param idiom The idiom recognition state.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool count_uses(idiom_t* idiom) {
+  ast_node_list_t* blocks = &idiom->function->data.function.blocks;
+  size_t statement_count = 0;
+  for (size_t i = 0; i < blocks->count; i++) {
+    ast_node_list_t* statements = &blocks->nodes[i]->data.stmt_block.statements;
+    statement_count += statements->count;
+    for (size_t j = 0; j < statements->count; j++) {
+      const char* def = ir_get_def(statements->nodes[j]);
+      if (def != NULL && ir_var_table_intern(idiom->vars, def) < 0) {
+        return false;
+      }
+    }
+  }
+  
+  idiom->uses = (size_t*)calloc(statement_count + 1, sizeof(size_t));
+  if (idiom->uses == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < blocks->count; i++) {
+    ast_node_list_t* statements = &blocks->nodes[i]->data.stmt_block.statements;
+    for (size_t j = 0; j < statements->count; j++) {
+      ir_visit_uses(statements->nodes[j], count_use, idiom);
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Check whether an operand is a local variable.
+ * 
+ * @param idiom The idiom recognition state.
+ * @param operand The operand.
+ * @return true for an identifier that does not name a global.
+ */
+static bool is_local(const idiom_t* idiom, const ast_node_t* operand) {
+  return operand->type == AST_EXPR_IDENTIFIER &&
+         symtable_lookup(idiom->globals, operand->data.expr_identifier.name, false) == NULL;
+}
+
+/**
+ * @brief Find the last definition of a variable before a statement of a block.
+ * 
+ * @param statements The statements of the block.
+ * @param index The position of the statement.
+ * @param name The variable name.
+ * @return The position of the definition, or index if there is none.
+ */
+static size_t find_definition(ast_node_list_t* statements, size_t index, const char* name) {
+  for (size_t i = index; i > 0; i--) {
+    const char* def = statements->nodes[i - 1] != NULL ? ir_get_def(statements->nodes[i - 1]) : NULL;
+    if (def != NULL && strcmp(def, name) == 0) {
+      return i - 1;
+    }
+  }
+  return index;
+}
+
+/**
+ * @brief Get the width of an unsigned integer type.
+ * 
+ * Right shifts of signed values are arithmetic, so only unsigned shifts
+ * can form a rotate.
+ * 
+ * @param type The type (can be NULL).
+ * @return The number of bits, or 0 for other types.
+ */
+static uint8_t unsigned_width(const ast_node_t* type) {
+  uint8_t bits;
+  bool is_signed;
+  if (type == NULL || type->type != AST_TYPE_INT || !ir_integer_type(type, &bits, &is_signed) ||
+      is_signed) {
+    return 0;
+  }
+  return bits;
+}
+
+/**
+ * @brief Match a shift by a constant of the variable a rotate reads.
+ * 
+ * @param idiom The idiom recognition state.
+ * @param stmt The defining statement.
+ * @param bits The width of the rotate.
+ * @param amount Where to store the shift amount.
+ * @return The shifted variable operand, or NULL if the statement does not match.
+ */
+static ast_node_t* match_shift(const idiom_t* idiom, ast_node_t* stmt, uint8_t bits,
+                               int64_t* amount) {
+  if (stmt->type != AST_STMT_ASSIGN || unsigned_width(stmt->data.stmt_assign.target_type) != bits) {
+    return NULL;
+  }
+  
+  ast_node_list_t* operands = &ir_get_instruction(stmt)->data.stmt_instruction.operands;
+  if (operands->count != 2 || !is_local(idiom, operands->nodes[0]) ||
+      operands->nodes[1]->type != AST_EXPR_INTEGER ||
+      operands->nodes[1]->data.expr_integer.value <= 0 ||
+      operands->nodes[1]->data.expr_integer.value >= bits ||
+      strcmp(operands->nodes[0]->data.expr_identifier.name, stmt->data.stmt_assign.target) == 0) {
+    return NULL;
+  }
+  
+  *amount = operands->nodes[1]->data.expr_integer.value;
+  return operands->nodes[0];
+}
+
+/**
+ * @brief Check that no statement in a range of a block redefines a variable.
+ * 
+ * @param statements The statements of the block.
+ * @param from The first position.
+ * @param to The position after the last.
+ * @param name The variable name.
+ * @return true if the variable keeps its value over the range.
+ */
+static bool is_unchanged(ast_node_list_t* statements, size_t from, size_t to, const char* name) {
+  for (size_t i = from; i < to; i++) {
+    const char* def = statements->nodes[i] != NULL ? ir_get_def(statements->nodes[i]) : NULL;
+    if (def != NULL && strcmp(def, name) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Drop a shift read only by the rotate that replaced it.
+ * 
+ * @param idiom The idiom recognition state.
+ * @param statements The statements of the block.
+ * @param index The position of the shift.
+ */
+static void release_shift(idiom_t* idiom, ast_node_list_t* statements, size_t index) {
+  int32_t id = ir_var_table_find(idiom->vars, ir_get_def(statements->nodes[index]));
+  if (--idiom->uses[id] == 0) {
+    ast_destroy_node(statements->nodes[index]);
+    statements->nodes[index] = NULL;
+  }
+}
+
+/**
+ * @brief Replace an OR of two opposite constant shifts of a variable with a rotate.
+ * 
+ * x << k | x >> (w - k) becomes ROTL x, k, written as ROTR x, w - k when
+ * that amount is smaller.
+ * 
+ * @param idiom The idiom recognition state.
+ * @param statements The statements of the block.
+ * @param index The position of the OR.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool match_rotate(idiom_t* idiom, ast_node_list_t* statements, size_t index) {
+  ast_node_t* stmt = statements->nodes[index];
+  uint8_t bits = stmt->type == AST_STMT_ASSIGN ?
+    unsigned_width(stmt->data.stmt_assign.target_type) : 0;
+  ast_node_list_t* operands = &ir_get_instruction(stmt)->data.stmt_instruction.operands;
+  if (bits == 0 || operands->count != 2 || !is_local(idiom, operands->nodes[0]) ||
+      !is_local(idiom, operands->nodes[1])) {
+    return true;
+  }
+  
+  size_t defs[2];
+  for (size_t i = 0; i < 2; i++) {
+    defs[i] = find_definition(statements, index, operands->nodes[i]->data.expr_identifier.name);
+    if (defs[i] == index) {
+      return true;
+    }
+  }
+  
+  /* One operand shifts left and the other right */
+  uint8_t first = ir_get_opcode(statements->nodes[defs[0]]);
+  uint8_t second = ir_get_opcode(statements->nodes[defs[1]]);
+  size_t left = first == OPCODE_SHL ? defs[0] : defs[1];
+  size_t right = first == OPCODE_SHL ? defs[1] : defs[0];
+  if (!((first == OPCODE_SHL && second == OPCODE_SHR) ||
+        (first == OPCODE_SHR && second == OPCODE_SHL))) {
+    return true;
+  }
+  
+  int64_t left_amount;
+  int64_t right_amount;
+  ast_node_t* left_value = match_shift(idiom, statements->nodes[left], bits, &left_amount);
+  ast_node_t* right_value = match_shift(idiom, statements->nodes[right], bits, &right_amount);
+  if (left_value == NULL || right_value == NULL || left_amount + right_amount != bits) {
+    return true;
+  }
+  
+  const char* name = left_value->data.expr_identifier.name;
+  if (strcmp(name, right_value->data.expr_identifier.name) != 0 ||
+      !is_unchanged(statements, left + 1, index, name) ||
+      !is_unchanged(statements, right + 1, index, name)) {
+    return true;
+  }
+  
+  bool rotate_left = left_amount <= right_amount;
+  ast_node_t* rotate = ast_create_instruction(rotate_left ? "ROTL" : "ROTR");
+  ast_node_t* value = ast_create_identifier(name);
+  ast_node_t* amount = ast_create_integer(rotate_left ? left_amount : right_amount);
+  if (rotate == NULL || value == NULL || amount == NULL ||
+      !ast_add_node(&rotate->data.stmt_instruction.operands, value)) {
+    ast_destroy_node(rotate);
+    ast_destroy_node(value);
+    ast_destroy_node(amount);
+    return false;
+  }
+  if (!ast_add_node(&rotate->data.stmt_instruction.operands, amount)) {
+    ast_destroy_node(rotate);
+    ast_destroy_node(amount);
+    return false;
+  }
+  
+  optimize_remark(idiom->context, HOILC_REMARK_PASSED, idiom->function, stmt, "Rotate",
+                  "recognized %s of '%s' by %lld", rotate_left ? "ROTL" : "ROTR", name,
+                  (long long)(rotate_left ? left_amount : right_amount));
+  
+  rotate->location = stmt->data.stmt_assign.value->location;
+  ast_destroy_node(stmt->data.stmt_assign.value);
+  stmt->data.stmt_assign.value = rotate;
+  
+  release_shift(idiom, statements, left);
+  release_shift(idiom, statements, right);
+  return true;
+}
+
+bool pass_idiom(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  idiom_t idiom = { context, optimize_get_symbol_table(context), function, NULL, NULL };
+  idiom.vars = ir_var_table_create();
+  bool success = idiom.vars != NULL && count_uses(&idiom);
+  
+  ast_node_list_t* blocks = &function->data.function.blocks;
+  for (size_t i = 0; i < blocks->count && success; i++) {
+    ast_node_list_t* statements = &blocks->nodes[i]->data.stmt_block.statements;
+    for (size_t j = 0; j < statements->count && success; j++) {
+      if (statements->nodes[j] != NULL && ir_get_opcode(statements->nodes[j]) == OPCODE_OR) {
+        success = match_rotate(&idiom, statements, j);
+      }
+    }
+    
+    /* Close the gaps left by the removed shifts */
+    size_t kept = 0;
+    for (size_t j = 0; j < statements->count; j++) {
+      if (statements->nodes[j] != NULL) {
+        statements->nodes[kept++] = statements->nodes[j];
+      }
+    }
+    statements->count = kept;
+  }
+  
+  free(idiom.uses);
+  ir_var_table_destroy(idiom.vars);
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL,
+                         function, "Memory allocation failed");
+  }
+  
+  return success;
+}
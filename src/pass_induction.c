@@ -0,0 +1,1331 @@
+/**
+ * @file pass_induction.c
+ * @brief Induction variable strength reduction.
+ * 
+ * This file contains a pass that finds the affine induction variables of
+ * each natural loop, replaces multiples of a basic induction variable with
+ * additive recurrences, rewrites exit tests onto the reduced variables and
+ * removes the basic variables that are left dead.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/cfg.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Name prefix of reduced induction variables.
+ */
+#define INDUCTION_PREFIX "__hoilc_iv_"
+
+/**
+ * @brief Label prefix of created loop preheaders.
+ */
+#define PREHEADER_PREFIX "__hoilc_preheader_"
+
+/**
+ * @brief Magnitude below which the products of exit test rewriting are exact.
+ */
+#define INDUCTION_MAX_MAGNITUDE ((int64_t)1 << 31)
+
+/**
+ * @brief Basic induction variable, incremented by a constant once in the loop.
+ */
+typedef struct {
+  int32_t var;              /**< Variable number. */
+  ast_node_t* increment;    /**< Increment statement. */
+  size_t block;             /**< Block of the increment. */
+  size_t inserted;          /**< Updates inserted after the increment. */
+  int64_t step;             /**< Value added by each increment. */
+  bool has_entry;           /**< Whether the value on loop entry is a known constant. */
+  int64_t entry;            /**< Value on loop entry. */
+} basic_iv_t;
+
+/**
+ * @brief Derived induction variable, an affine function of a basic one.
+ */
+typedef struct {
+  ast_node_t* def;          /**< Single defining statement in the loop. */
+  size_t basic;             /**< Basic induction variable index. */
+  int32_t source;           /**< Derived variable it offsets, or -1 for a multiple. */
+  size_t source_operand;    /**< Operand holding the basic or source variable. */
+  int64_t scale;            /**< Multiple of the basic variable. */
+  int64_t step;             /**< Value added per increment of the basic variable. */
+  bool has_offset;          /**< Whether the offset is a known constant. */
+  int64_t offset;           /**< Constant offset. */
+  char* name;               /**< Reduced variable, NULL until created. */
+  ast_node_t* value;        /**< Original value of the definition, once reduced. */
+} derived_iv_t;
+
+/**
+ * @brief Strength reduction state for one loop.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  symbol_table_t* globals;  /**< Global symbol table. */
+  ast_node_t* function;     /**< Function AST node. */
+  cfg_t* cfg;               /**< Control flow graph with dominators. */
+  size_t loop;              /**< Loop number in the loop-nest forest. */
+  size_t header;            /**< Loop header. */
+  ir_bitset_t body;         /**< Blocks of the loop. */
+  ir_var_table_t* vars;     /**< Parameters and locals of the function. */
+  size_t* def_counts;       /**< Definitions of each variable in the loop. */
+  ast_node_t** defs;        /**< Last definition of each variable in the loop. */
+  size_t* def_blocks;       /**< Block of that definition. */
+  basic_iv_t* basics;       /**< Basic induction variables. */
+  size_t basic_count;       /**< Number of basic induction variables. */
+  derived_iv_t* derived;    /**< Derived induction variables, sources first. */
+  size_t derived_count;     /**< Number of derived induction variables. */
+  size_t* next_id;          /**< Counter for fresh names in the function. */
+  bool failed;              /**< Whether memory allocation failed. */
+} induction_t;
+
+/**
+ * @brief Get the statements of a function block.
+ * 
+ * @param function The function AST node.
+ * @param block The block index.
+ * @return The statement list.
+ */
+static ast_node_list_t* block_statements(ast_node_t* function, size_t block) {
+  return &function->data.function.blocks.nodes[block]->data.stmt_block.statements;
+}
+
+/**
+ * @brief Find the first terminator of a statement list.
+ * 
+ * Unlike the CFG statement counts, this stays valid while statements are
+ * inserted.
+ * 
+ * @param statements The statement list.
+ * @return The index of the terminator, or the statement count if there is none.
+ */
+static size_t find_terminator(ast_node_list_t* statements) {
+  size_t index = 0;
+  while (index < statements->count &&
+         (ir_get_flags(statements->nodes[index]) & IR_FLAG_TERMINATOR) == 0) {
+    index++;
+  }
+  return index;
+}
+
+/**
+ * @brief Check whether a type is an integer type.
+ * 
+ * @param type The type (can be NULL).
+ * @return true for integer and boolean types.
+ */
+static bool is_integer_type(const ast_node_t* type) {
+  uint8_t bits;
+  bool is_signed;
+  return ir_integer_type(type, &bits, &is_signed);
+}
+
+/**
+ * @brief Get the width of a value that can take part in an induction.
+ * 
+ * @param type The value type.
+ * @return The width in bits, or 0 for other types.
+ */
+static uint8_t induction_width(const ast_node_t* type) {
+  uint8_t bits;
+  bool is_signed;
+  if (ir_integer_type(type, &bits, &is_signed)) {
+    return bits;
+  }
+  return type != NULL && type->type == AST_TYPE_PTR ? 64 : 0;
+}
+
+/**
+ * @brief Check whether two integer types have the same width and signedness.
+ * 
+ * @param a The first type.
+ * @param b The second type.
+ * @return true if values wrap the same way in both types.
+ */
+static bool same_integer_type(const ast_node_t* a, const ast_node_t* b) {
+  uint8_t bits_a, bits_b;
+  bool signed_a, signed_b;
+  return ir_integer_type(a, &bits_a, &signed_a) && ir_integer_type(b, &bits_b, &signed_b) &&
+         bits_a == bits_b && signed_a == signed_b;
+}
+
+/**
+ * @brief Check whether a value is representable in an integer type.
+ * 
+ * @param type The type.
+ * @param value The value.
+ * @return true if converting the value to the type leaves it unchanged.
+ */
+static bool fits_type(const ast_node_t* type, int64_t value) {
+  int64_t converted;
+  return ir_convert_integer(type, value, &converted) && converted == value;
+}
+
+/**
+ * @brief Check whether an operand is an identifier with a given name.
+ * 
+ * @param operand The operand expression.
+ * @param name The name.
+ * @return true if the operand names the variable.
+ */
+static bool is_variable(const ast_node_t* operand, const char* name) {
+  return operand->type == AST_EXPR_IDENTIFIER &&
+         strcmp(operand->data.expr_identifier.name, name) == 0;
+}
+
+/**
+ * @brief Check whether a value is small enough for exact exit test products.
+ * 
+ * @param value The value.
+ * @return true if the magnitude is below INDUCTION_MAX_MAGNITUDE.
+ */
+static bool is_small(int64_t value) {
+  return value > -INDUCTION_MAX_MAGNITUDE && value < INDUCTION_MAX_MAGNITUDE;
+}
+
+/**
+ * @brief Check whether an operand is loop invariant.
+ * 
+ * Literals and parameters or locals not assigned in the loop qualify.
+ * Globals do not, since the loop may store to them.
+ * 
+ * @param ind The strength reduction state.
+ * @param operand The operand expression.
+ * @return true if the operand has the same value in every iteration.
+ */
+static bool is_invariant(const induction_t* ind, const ast_node_t* operand) {
+  if (operand->type == AST_EXPR_INTEGER) {
+    return true;
+  }
+  if (operand->type != AST_EXPR_IDENTIFIER) {
+    return false;
+  }
+  
+  int32_t id = ir_var_table_find(ind->vars, operand->data.expr_identifier.name);
+  return id >= 0 && ind->def_counts[id] == 0;
+}
+
+/**
+ * @brief Find the basic induction variable an operand names.
+ * 
+ * @param ind The strength reduction state.
+ * @param operand The operand expression.
+ * @return The basic variable index, or -1 if there is none.
+ */
+static int32_t find_basic(const induction_t* ind, const ast_node_t* operand) {
+  if (operand->type != AST_EXPR_IDENTIFIER) {
+    return -1;
+  }
+  
+  int32_t id = ir_var_table_find(ind->vars, operand->data.expr_identifier.name);
+  for (size_t i = 0; id >= 0 && i < ind->basic_count; i++) {
+    if (ind->basics[i].var == id) {
+      return (int32_t)i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Find the derived induction variable an operand names.
+ * 
+ * @param ind The strength reduction state.
+ * @param operand The operand expression.
+ * @return The derived variable index, or -1 if there is none.
+ */
+static int32_t find_derived(const induction_t* ind, const ast_node_t* operand) {
+  if (operand->type != AST_EXPR_IDENTIFIER) {
+    return -1;
+  }
+  
+  for (size_t i = 0; i < ind->derived_count; i++) {
+    if (strcmp(ind->derived[i].def->data.stmt_assign.target,
+               operand->data.expr_identifier.name) == 0) {
+      return (int32_t)i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Mark the blocks of the loop being reduced, nested loops included.
+ * 
+ * @param ind The strength reduction state, with the loop set.
+ */
+static void collect_body(induction_t* ind) {
+  for (size_t i = 0; i < cfg_block_count(ind->cfg); i++) {
+    if (cfg_loop_contains(ind->cfg, ind->loop, i)) {
+      ir_bitset_set(&ind->body, i);
+    }
+  }
+}
+
+/**
+ * @brief Number the variables of the function and count their loop definitions.
+ * 
+ * @param ind The strength reduction state, with the loop body collected.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool count_definitions(induction_t* ind) {
+  ast_node_t* function = ind->function;
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (ir_var_table_intern(ind->vars, param->data.parameter.name) < 0) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < cfg_block_count(ind->cfg); i++) {
+    ast_node_list_t* statements = block_statements(function, i);
+    for (size_t j = 0; j < statements->count; j++) {
+      const char* def = ir_get_def(statements->nodes[j]);
+      if (def != NULL && ir_var_table_intern(ind->vars, def) < 0) {
+        return false;
+      }
+    }
+  }
+  
+  size_t var_count = ir_var_table_count(ind->vars);
+  ind->def_counts = (size_t*)calloc(var_count + 1, sizeof(size_t));
+  ind->defs = (ast_node_t**)calloc(var_count + 1, sizeof(ast_node_t*));
+  ind->def_blocks = (size_t*)calloc(var_count + 1, sizeof(size_t));
+  ind->basics = (basic_iv_t*)calloc(var_count + 1, sizeof(basic_iv_t));
+  ind->derived = (derived_iv_t*)calloc(var_count + 1, sizeof(derived_iv_t));
+  if (ind->def_counts == NULL || ind->defs == NULL || ind->def_blocks == NULL ||
+      ind->basics == NULL || ind->derived == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < cfg_block_count(ind->cfg); i++) {
+    if (!ir_bitset_test(&ind->body, i)) {
+      continue;
+    }
+    
+    ast_node_list_t* statements = block_statements(function, i);
+    for (size_t j = 0; j < cfg_statement_count(ind->cfg, i); j++) {
+      const char* def = ir_get_def(statements->nodes[j]);
+      if (def != NULL) {
+        int32_t id = ir_var_table_find(ind->vars, def);
+        ind->def_counts[id]++;
+        ind->defs[id] = statements->nodes[j];
+        ind->def_blocks[id] = i;
+      }
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Find the basic induction variables of the loop.
+ * 
+ * A basic variable has a single definition in the loop of the form
+ * i = ADD i, c or i = SUB i, c with a constant c.
+ * 
+ * @param ind The strength reduction state.
+ */
+static void find_basic_variables(induction_t* ind) {
+  for (size_t id = 0; id < ir_var_table_count(ind->vars); id++) {
+    ast_node_t* stmt = ind->defs[id];
+    if (ind->def_counts[id] != 1 || stmt->type != AST_STMT_ASSIGN ||
+        symtable_lookup(ind->globals, stmt->data.stmt_assign.target, false) != NULL ||
+        !is_integer_type(stmt->data.stmt_assign.target_type)) {
+      continue;
+    }
+    
+    ast_node_t* instruction = ir_get_instruction(stmt);
+    uint8_t opcode = ir_get_opcode(stmt);
+    if (instruction == NULL || instruction->data.stmt_instruction.operands.count != 2 ||
+        (opcode != OPCODE_ADD && opcode != OPCODE_SUB)) {
+      continue;
+    }
+    
+    const char* name = stmt->data.stmt_assign.target;
+    ast_node_t** operands = instruction->data.stmt_instruction.operands.nodes;
+    const ast_node_t* step = NULL;
+    if (is_variable(operands[0], name) && operands[1]->type == AST_EXPR_INTEGER) {
+      step = operands[1];
+    } else if (opcode == OPCODE_ADD && is_variable(operands[1], name) &&
+               operands[0]->type == AST_EXPR_INTEGER) {
+      step = operands[0];
+    }
+    if (step == NULL || !is_small(step->data.expr_integer.value) ||
+        step->data.expr_integer.value == 0) {
+      continue;
+    }
+    
+    basic_iv_t* basic = &ind->basics[ind->basic_count++];
+    basic->var = (int32_t)id;
+    basic->increment = stmt;
+    basic->block = ind->def_blocks[id];
+    basic->step = opcode == OPCODE_ADD ? step->data.expr_integer.value :
+                                         -step->data.expr_integer.value;
+  }
+}
+
+/**
+ * @brief Try to describe a loop definition as a derived induction variable.
+ * 
+ * Multiples j = MUL i, k and j = SHL i, k of a basic variable, and sums
+ * j = ADD d, x of a derived variable and an invariant qualify.
+ * 
+ * @param ind The strength reduction state.
+ * @param stmt The defining statement.
+ * @param derived Where to store the description.
+ * @return true if the definition is a derived induction variable.
+ */
+static bool describe_derived(const induction_t* ind, ast_node_t* stmt, derived_iv_t* derived) {
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  ast_node_t* type = stmt->data.stmt_assign.target_type;
+  uint8_t opcode = ir_get_opcode(stmt);
+  if (instruction == NULL || instruction->data.stmt_instruction.operands.count != 2) {
+    return false;
+  }
+  
+  ast_node_t** operands = instruction->data.stmt_instruction.operands.nodes;
+  memset(derived, 0, sizeof(*derived));
+  derived->def = stmt;
+  derived->source = -1;
+  
+  if (opcode == OPCODE_MUL || opcode == OPCODE_SHL) {
+    size_t index = find_basic(ind, operands[0]) >= 0 ? 0 : 1;
+    int32_t basic = find_basic(ind, operands[index]);
+    const ast_node_t* factor = operands[1 - index];
+    uint8_t bits;
+    bool is_signed;
+    if (basic < 0 || factor->type != AST_EXPR_INTEGER ||
+        (opcode == OPCODE_SHL && index != 0) || !ir_integer_type(type, &bits, &is_signed) ||
+        !same_integer_type(type, ind->basics[basic].increment->data.stmt_assign.target_type)) {
+      return false;
+    }
+    
+    int64_t scale = factor->data.expr_integer.value;
+    if (opcode == OPCODE_SHL) {
+      if (scale < 0 || scale >= bits || scale >= 63) {
+        return false;
+      }
+      scale = (int64_t)1 << scale;
+    }
+    
+    int64_t values[2] = { ind->basics[basic].step, scale };
+    derived->basic = (size_t)basic;
+    derived->source_operand = index;
+    derived->scale = scale;
+    derived->has_offset = true;
+    return ir_fold_integer(OPCODE_MUL, type, values, 2, &derived->step);
+  }
+  
+  if (opcode != OPCODE_ADD) {
+    return false;
+  }
+  
+  size_t index = find_derived(ind, operands[0]) >= 0 ? 0 : 1;
+  int32_t source = find_derived(ind, operands[index]);
+  const ast_node_t* addend = operands[1 - index];
+  if (source < 0 || !is_invariant(ind, addend) ||
+      induction_width(type) == 0 ||
+      induction_width(type) != induction_width(ind->derived[source].def->data.stmt_assign.target_type)) {
+    return false;
+  }
+  
+  const derived_iv_t* from = &ind->derived[source];
+  derived->basic = from->basic;
+  derived->source = source;
+  derived->source_operand = index;
+  derived->scale = from->scale;
+  derived->step = from->step;
+  if (is_integer_type(type) && !ir_convert_integer(type, from->step, &derived->step)) {
+    return false;
+  }
+  
+  derived->has_offset = from->has_offset && addend->type == AST_EXPR_INTEGER &&
+                        is_small(from->offset) && is_small(addend->data.expr_integer.value);
+  derived->offset = derived->has_offset ? from->offset + addend->data.expr_integer.value : 0;
+  return true;
+}
+
+/**
+ * @brief Find the derived induction variables of the loop, sources first.
+ * 
+ * @param ind The strength reduction state.
+ */
+static void find_derived_variables(induction_t* ind) {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (size_t id = 0; id < ir_var_table_count(ind->vars); id++) {
+      ast_node_t* stmt = ind->defs[id];
+      if (ind->def_counts[id] != 1 || stmt->type != AST_STMT_ASSIGN ||
+          symtable_lookup(ind->globals, stmt->data.stmt_assign.target, false) != NULL) {
+        continue;
+      }
+      
+      bool known = false;
+      for (size_t i = 0; i < ind->basic_count && !known; i++) {
+        known = ind->basics[i].var == (int32_t)id;
+      }
+      for (size_t i = 0; i < ind->derived_count && !known; i++) {
+        known = ind->derived[i].def == stmt;
+      }
+      
+      if (!known && describe_derived(ind, stmt, &ind->derived[ind->derived_count])) {
+        ind->derived_count++;
+        changed = true;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Find the constant value a variable holds at the end of a block.
+ * 
+ * Follows chains of single predecessors back to the last definition, which
+ * must be an instruction on constants.
+ * 
+ * @param ind The strength reduction state.
+ * @param block The block.
+ * @param name The variable name.
+ * @param value Where to store the value.
+ * @return true if the value is a known constant.
+ */
+static bool find_entry_value(const induction_t* ind, size_t block, const char* name,
+                             int64_t* value) {
+  for (size_t visited = 0; visited < cfg_block_count(ind->cfg); visited++) {
+    ast_node_list_t* statements = block_statements(ind->function, block);
+    for (size_t j = cfg_statement_count(ind->cfg, block); j-- > 0;) {
+      ast_node_t* stmt = statements->nodes[j];
+      const char* def = ir_get_def(stmt);
+      if (def == NULL || strcmp(def, name) != 0) {
+        continue;
+      }
+      
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      if (instruction == NULL || instruction->data.stmt_instruction.operands.count > 2) {
+        return false;
+      }
+      
+      int64_t operands[2];
+      for (size_t k = 0; k < instruction->data.stmt_instruction.operands.count; k++) {
+        const ast_node_t* operand = instruction->data.stmt_instruction.operands.nodes[k];
+        if (operand->type != AST_EXPR_INTEGER) {
+          return false;
+        }
+        operands[k] = operand->data.expr_integer.value;
+      }
+      
+      /* Literals compare by value */
+      uint8_t opcode = ir_get_opcode(stmt);
+      const ast_node_t* type = ir_is_comparison(opcode) ? NULL : stmt->data.stmt_assign.target_type;
+      return ir_fold_integer(opcode, type, operands,
+                             instruction->data.stmt_instruction.operands.count, value);
+    }
+    
+    if (block == 0 || cfg_predecessor_count(ind->cfg, block) != 1) {
+      return false;
+    }
+    block = cfg_get_predecessor(ind->cfg, block, 0);
+  }
+  return false;
+}
+
+/**
+ * @brief Create an unused name with a prefix.
+ * 
+ * @param ind The strength reduction state.
+ * @param prefix The name prefix.
+ * @return The new name, or NULL if memory allocation failed.
+ */
+static char* create_name(induction_t* ind, const char* prefix) {
+  char buffer[64];
+  do {
+    snprintf(buffer, sizeof(buffer), "%s%zu", prefix, (*ind->next_id)++);
+  } while (ir_var_table_find(ind->vars, buffer) >= 0 ||
+           cfg_find_block(ind->cfg, buffer) >= 0 ||
+           symtable_lookup(ind->globals, buffer, false) != NULL);
+  
+  return strdup(buffer);
+}
+
+/**
+ * @brief Create a two-operand instruction.
+ * 
+ * @param opcode The opcode.
+ * @param lhs The first operand (taken over, can be NULL).
+ * @param rhs The second operand (taken over, can be NULL).
+ * @return The instruction, or NULL if memory allocation failed.
+ */
+static ast_node_t* create_instruction(const char* opcode, ast_node_t* lhs, ast_node_t* rhs) {
+  ast_node_t* instruction = ast_create_instruction(opcode);
+  bool success = instruction != NULL && lhs != NULL &&
+                 ast_add_node(&instruction->data.stmt_instruction.operands, lhs);
+  if (!success) {
+    ast_destroy_node(lhs);
+  }
+  success = success && rhs != NULL &&
+            ast_add_node(&instruction->data.stmt_instruction.operands, rhs);
+  if (!success) {
+    ast_destroy_node(rhs);
+    ast_destroy_node(instruction);
+    return NULL;
+  }
+  return instruction;
+}
+
+/**
+ * @brief Insert a statement into a list.
+ * 
+ * @param list The statement list.
+ * @param index The position.
+ * @param stmt The statement.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool insert_statement(ast_node_list_t* list, size_t index, ast_node_t* stmt) {
+  if (!ast_add_node(list, stmt)) {
+    return false;
+  }
+  memmove(&list->nodes[index + 1], &list->nodes[index],
+          (list->count - 1 - index) * sizeof(ast_node_t*));
+  list->nodes[index] = stmt;
+  return true;
+}
+
+/**
+ * @brief Find or create the block that enters the loop.
+ * 
+ * An outside predecessor whose only successor is the header is reused.
+ * Otherwise a block branching to the header is appended to the function
+ * and the outside predecessors are redirected to it.
+ * 
+ * @param ind The strength reduction state.
+ * @return The preheader block node, or NULL if the loop cannot get one.
+ */
+static ast_node_t* get_preheader(induction_t* ind) {
+  const char* header_label = cfg_get_block(ind->cfg, ind->header)->data.stmt_block.label;
+  size_t outside = 0;
+  size_t pred = 0;
+  for (size_t i = 0; i < cfg_predecessor_count(ind->cfg, ind->header); i++) {
+    size_t block = cfg_get_predecessor(ind->cfg, ind->header, i);
+    if (!ir_bitset_test(&ind->body, block)) {
+      pred = block;
+      outside++;
+    }
+  }
+  
+  /* The entry block has an implicit predecessor */
+  if (ind->header == 0 || outside == 0) {
+    return NULL;
+  }
+  if (outside == 1 && cfg_successor_count(ind->cfg, pred) == 1) {
+    return cfg_get_block(ind->cfg, pred);
+  }
+  
+  char* label = create_name(ind, PREHEADER_PREFIX);
+  ast_node_t* block = label != NULL ? ast_create_block(label) : NULL;
+  ast_node_t* branch = ast_create_node(AST_STMT_BRANCH);
+  char* target = strdup(header_label);
+  bool success = block != NULL && branch != NULL && target != NULL;
+  if (success) {
+    branch->data.stmt_branch.true_target = target;
+    target = NULL;
+    success = ast_add_node(&block->data.stmt_block.statements, branch);
+  }
+  if (success) {
+    branch = NULL;
+    block->location = cfg_get_block(ind->cfg, ind->header)->location;
+    success = ast_add_node(&ind->function->data.function.blocks, block);
+  }
+  if (!success) {
+    ast_destroy_node(branch);
+    ast_destroy_node(block);
+    free(target);
+    free(label);
+    ind->failed = true;
+    return NULL;
+  }
+  
+  /* Redirect the edges entering the loop */
+  for (size_t i = 0; i < cfg_predecessor_count(ind->cfg, ind->header) && success; i++) {
+    size_t from = cfg_get_predecessor(ind->cfg, ind->header, i);
+    if (ir_bitset_test(&ind->body, from)) {
+      continue;
+    }
+    
+    ast_node_list_t* statements = block_statements(ind->function, from);
+    size_t length = cfg_statement_count(ind->cfg, from);
+    ast_node_t* last = length > 0 ? statements->nodes[length - 1] : NULL;
+    if (last == NULL || (ir_get_flags(last) & IR_FLAG_TERMINATOR) == 0) {
+      /* Falls through into the header */
+      ast_node_t* jump = ast_create_node(AST_STMT_BRANCH);
+      char* jump_target = strdup(label);
+      success = jump != NULL && jump_target != NULL &&
+                insert_statement(statements, length, jump);
+      if (!success) {
+        ast_destroy_node(jump);
+        free(jump_target);
+        break;
+      }
+      jump->data.stmt_branch.true_target = jump_target;
+      continue;
+    }
+    
+    char** targets[2] = {
+      &last->data.stmt_branch.true_target,
+      &last->data.stmt_branch.false_target
+    };
+    for (int t = 0; t < 2 && success; t++) {
+      if (*targets[t] == NULL || strcmp(*targets[t], header_label) != 0) {
+        continue;
+      }
+      char* renamed = strdup(label);
+      success = renamed != NULL;
+      if (success) {
+        free(*targets[t]);
+        *targets[t] = renamed;
+      }
+    }
+  }
+  
+  free(label);
+  if (!success) {
+    ind->failed = true;
+  }
+  return block;
+}
+
+/**
+ * @brief Compute the constant value of a derived induction variable on loop entry.
+ * 
+ * @param ind The strength reduction state.
+ * @param derived The derived induction variable.
+ * @param start Where to store the value.
+ * @return true if the entry value of the basic variable and the offset are known.
+ */
+static bool constant_entry(const induction_t* ind, const derived_iv_t* derived, int64_t* start) {
+  const basic_iv_t* basic = &ind->basics[derived->basic];
+  const ast_node_t* type = derived->def->data.stmt_assign.target_type;
+  int64_t values[2] = { basic->entry, derived->scale };
+  if (!basic->has_entry || !derived->has_offset ||
+      !ir_fold_integer(OPCODE_MUL, type, values, 2, start)) {
+    return false;
+  }
+  
+  values[0] = *start;
+  values[1] = derived->offset;
+  ir_fold_integer(OPCODE_ADD, type, values, 2, start);
+  return true;
+}
+
+/**
+ * @brief Compute the value of a derived induction variable on loop entry.
+ * 
+ * The value is a constant when the entry value of the basic variable is
+ * known, and otherwise the original definition evaluated before the loop.
+ * An offset of another derived variable takes the entry value of its source
+ * as a literal or computes it into the same variable first, so the reduced
+ * source is not read and is left to die when nothing in the loop needs it.
+ * 
+ * @param ind The strength reduction state.
+ * @param statements The preheader statements to append to.
+ * @param derived The derived induction variable.
+ * @param name The variable receiving the value.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool insert_entry_value(induction_t* ind, ast_node_list_t* statements,
+                               const derived_iv_t* derived, const char* name) {
+  ast_node_t* def = derived->def;
+  ast_node_t* type = def->data.stmt_assign.target_type;
+  
+  ast_node_t* init_value;
+  int64_t start;
+  if (constant_entry(ind, derived, &start)) {
+    init_value = create_instruction("ADD", ast_create_integer(start), ast_create_integer(0));
+  } else {
+    const derived_iv_t* from = derived->source >= 0 ? &ind->derived[derived->source] : NULL;
+    bool literal = from != NULL && constant_entry(ind, from, &start);
+    if (from != NULL && !literal && !insert_entry_value(ind, statements, from, name)) {
+      return false;
+    }
+    
+    init_value = ast_clone_node(derived->value != NULL ? derived->value : ir_get_instruction(def));
+    if (init_value != NULL && from != NULL) {
+      ast_node_t** slot = &init_value->data.stmt_instruction.operands.nodes[derived->source_operand];
+      ast_node_t* source = literal ? ast_create_integer(start) : ast_create_identifier(name);
+      if (source == NULL) {
+        ast_destroy_node(init_value);
+        return false;
+      }
+      ast_destroy_node(*slot);
+      *slot = source;
+    }
+  }
+  
+  ast_node_t* init = init_value != NULL ? ast_create_assignment(name, init_value) : NULL;
+  if (init == NULL) {
+    ast_destroy_node(init_value);
+    return false;
+  }
+  init->location = def->location;
+  init->data.stmt_assign.target_type = type;
+  
+  if (!insert_statement(statements, find_terminator(statements), init)) {
+    ast_destroy_node(init);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Create the reduced variable of a derived induction variable.
+ * 
+ * The variable is initialized in the preheader, advanced right after each
+ * increment of its basic variable, and the original definition becomes a
+ * move from it.
+ * 
+ * @param ind The strength reduction state.
+ * @param preheader The preheader block node.
+ * @param derived The derived induction variable.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool reduce_variable(induction_t* ind, ast_node_t* preheader, derived_iv_t* derived) {
+  basic_iv_t* basic = &ind->basics[derived->basic];
+  ast_node_t* def = derived->def;
+  ast_node_t* type = def->data.stmt_assign.target_type;
+  derived->name = create_name(ind, INDUCTION_PREFIX);
+  if (derived->name == NULL || ir_var_table_intern(ind->vars, derived->name) < 0 ||
+      !insert_entry_value(ind, &preheader->data.stmt_block.statements, derived, derived->name)) {
+    return false;
+  }
+  
+  /* Advance it with the basic variable */
+  ast_node_t* update_value = create_instruction("ADD", ast_create_identifier(derived->name),
+                                                ast_create_integer(derived->step));
+  ast_node_t* update = update_value != NULL ?
+                       ast_create_assignment(derived->name, update_value) : NULL;
+  if (update == NULL) {
+    ast_destroy_node(update_value);
+    return false;
+  }
+  update->location = basic->increment->location;
+  update->data.stmt_assign.target_type = type;
+  
+  ast_node_list_t* statements = block_statements(ind->function, basic->block);
+  size_t index = 0;
+  while (statements->nodes[index] != basic->increment) {
+    index++;
+  }
+  if (!insert_statement(statements, index + 1 + basic->inserted, update)) {
+    ast_destroy_node(update);
+    return false;
+  }
+  basic->inserted++;
+  
+  /* The original definition becomes a move */
+  ast_node_t* move = create_instruction("ADD", ast_create_identifier(derived->name),
+                                        ast_create_integer(0));
+  if (move == NULL) {
+    return false;
+  }
+  move->location = def->data.stmt_assign.value->location;
+  derived->value = def->data.stmt_assign.value;
+  def->data.stmt_assign.value = move;
+  
+  optimize_remark(ind->context, HOILC_REMARK_PASSED, ind->function, def, "Reduced",
+                  "replaced '%s' with an induction variable advanced by %lld",
+                  def->data.stmt_assign.target, (long long)derived->step);
+  return true;
+}
+
+/**
+ * @brief Check whether a loop block lies on a cycle that avoids the header.
+ * 
+ * @param ind The strength reduction state.
+ * @param block The block.
+ * @return true if the block can run more than once per iteration.
+ */
+static bool in_inner_cycle(induction_t* ind, size_t block) {
+  size_t count = cfg_block_count(ind->cfg);
+  size_t* stack = (size_t*)malloc((count + 1) * sizeof(size_t));
+  ir_bitset_t seen = { NULL, 0 };
+  if (stack == NULL || !ir_bitset_init(&seen, count)) {
+    free(stack);
+    ind->failed = true;
+    return true;
+  }
+  
+  size_t top = 0;
+  bool found = false;
+  stack[top++] = block;
+  while (top > 0 && !found) {
+    size_t from = stack[--top];
+    for (size_t i = 0; i < cfg_successor_count(ind->cfg, from); i++) {
+      size_t succ = cfg_get_successor(ind->cfg, from, i);
+      if (succ == block) {
+        found = true;
+      } else if (succ != ind->header && ir_bitset_test(&ind->body, succ) &&
+                 !ir_bitset_test(&seen, succ)) {
+        ir_bitset_set(&seen, succ);
+        stack[top++] = succ;
+      }
+    }
+  }
+  
+  ir_bitset_free(&seen);
+  free(stack);
+  return found && block != ind->header;
+}
+
+/**
+ * @brief Negate a comparison opcode.
+ * 
+ * @param opcode The comparison opcode.
+ * @return The opcode that is true exactly when the comparison is false.
+ */
+static uint8_t negate_comparison(uint8_t opcode) {
+  switch (opcode) {
+    case OPCODE_CMP_EQ: return OPCODE_CMP_NE;
+    case OPCODE_CMP_NE: return OPCODE_CMP_EQ;
+    case OPCODE_CMP_LT: return OPCODE_CMP_GE;
+    case OPCODE_CMP_LE: return OPCODE_CMP_GT;
+    case OPCODE_CMP_GT: return OPCODE_CMP_LE;
+    case OPCODE_CMP_GE: return OPCODE_CMP_LT;
+    default: return 0;
+  }
+}
+
+/**
+ * @brief Bound the values of a basic variable at an exit test.
+ * 
+ * The test runs once per iteration and the variable moves by its step at
+ * most once between two tests, so the values stop at the first one that
+ * leaves the loop.
+ * 
+ * @param basic The basic induction variable.
+ * @param stay The comparison that keeps the loop running.
+ * @param limit The constant compared against.
+ * @param low Where to store the lowest value.
+ * @param high Where to store the highest value.
+ * @return true if the values are bounded.
+ */
+static bool bound_values(const basic_iv_t* basic, uint8_t stay, int64_t limit,
+                         int64_t* low, int64_t* high) {
+  int64_t entry = basic->entry;
+  if (basic->step > 0 && (stay == OPCODE_CMP_LT || stay == OPCODE_CMP_LE)) {
+    int64_t last = stay == OPCODE_CMP_LT ? limit - 1 : limit;
+    *low = entry;
+    *high = (entry > last ? entry : last) + basic->step;
+    return true;
+  }
+  if (basic->step < 0 && (stay == OPCODE_CMP_GT || stay == OPCODE_CMP_GE)) {
+    int64_t last = stay == OPCODE_CMP_GT ? limit + 1 : limit;
+    *low = (entry < last ? entry : last) + basic->step;
+    *high = entry;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Rewrite the exit test of a basic variable onto a reduced variable.
+ * 
+ * A test c = CMP i, n with a constant n that controls an exit is replaced by
+ * c = CMP t, k*n+b when t = k*i+b with k > 0 provably never wraps, so the
+ * basic variable is no longer needed for the test.
+ * 
+ * @param ind The strength reduction state.
+ * @param basic_index The basic variable index.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool rewrite_exit_test(induction_t* ind, size_t basic_index) {
+  const basic_iv_t* basic = &ind->basics[basic_index];
+  const char* name = ir_var_table_name(ind->vars, basic->var);
+  const ast_node_t* basic_type = basic->increment->data.stmt_assign.target_type;
+  
+  /* The cheapest replacement is the last variable derived from it */
+  const derived_iv_t* reduced = NULL;
+  for (size_t i = 0; i < ind->derived_count; i++) {
+    const derived_iv_t* derived = &ind->derived[i];
+    if (derived->basic == basic_index && derived->name != NULL && derived->has_offset &&
+        derived->scale > 0 && is_small(derived->scale) &&
+        is_integer_type(derived->def->data.stmt_assign.target_type)) {
+      reduced = derived;
+    }
+  }
+  if (reduced == NULL || !basic->has_entry || !is_small(basic->entry) ||
+      in_inner_cycle(ind, basic->block)) {
+    return !ind->failed;
+  }
+  
+  for (size_t b = 0; b < cfg_block_count(ind->cfg); b++) {
+    ast_node_list_t* statements = block_statements(ind->function, b);
+    size_t terminator = find_terminator(statements);
+    if (!ir_bitset_test(&ind->body, b) || terminator == statements->count) {
+      continue;
+    }
+    
+    /* An exit branch that runs in every iteration */
+    ast_node_t* branch = statements->nodes[terminator];
+    if (branch->type != AST_STMT_BRANCH || branch->data.stmt_branch.condition == NULL ||
+        branch->data.stmt_branch.condition->type != AST_EXPR_IDENTIFIER ||
+        branch->data.stmt_branch.false_target == NULL) {
+      continue;
+    }
+    
+    int32_t true_block = cfg_find_block(ind->cfg, branch->data.stmt_branch.true_target);
+    int32_t false_block = cfg_find_block(ind->cfg, branch->data.stmt_branch.false_target);
+    if (true_block < 0 || false_block < 0 ||
+        ir_bitset_test(&ind->body, (size_t)true_block) ==
+        ir_bitset_test(&ind->body, (size_t)false_block) ||
+        (!cfg_dominates(ind->cfg, (size_t)basic->block, b) &&
+         !cfg_dominates(ind->cfg, b, (size_t)basic->block))) {
+      continue;
+    }
+    
+    bool every_iteration = true;
+    for (size_t i = 0; i < cfg_predecessor_count(ind->cfg, ind->header); i++) {
+      size_t latch = cfg_get_predecessor(ind->cfg, ind->header, i);
+      if (ir_bitset_test(&ind->body, latch) && !cfg_dominates(ind->cfg, b, latch)) {
+        every_iteration = false;
+      }
+    }
+    
+    /* Its condition: the only loop definition, a comparison in this block */
+    int32_t cond = ir_var_table_find(ind->vars,
+                                     branch->data.stmt_branch.condition->data.expr_identifier.name);
+    ast_node_t* test = cond >= 0 && ind->def_counts[cond] == 1 ? ind->defs[cond] : NULL;
+    if (!every_iteration || test == NULL || ind->def_blocks[cond] != b) {
+      continue;
+    }
+    
+    ast_node_t* instruction = ir_get_instruction(test);
+    uint8_t opcode = ir_get_opcode(test);
+    if (instruction == NULL || negate_comparison(opcode) == 0 ||
+        instruction->data.stmt_instruction.operands.count != 2 ||
+        !is_variable(instruction->data.stmt_instruction.operands.nodes[0], name) ||
+        instruction->data.stmt_instruction.operands.nodes[1]->type != AST_EXPR_INTEGER) {
+      continue;
+    }
+    
+    int64_t limit = instruction->data.stmt_instruction.operands.nodes[1]->data.expr_integer.value;
+    uint8_t stay = ir_bitset_test(&ind->body, (size_t)true_block) ? opcode :
+                                                                    negate_comparison(opcode);
+    int64_t low, high;
+    if (!is_small(limit) || !bound_values(basic, stay, limit, &low, &high) ||
+        !is_small(low) || !is_small(high) ||
+        !fits_type(basic_type, low) || !fits_type(basic_type, high)) {
+      continue;
+    }
+    
+    /* The scaled values must not wrap either */
+    const ast_node_t* type = reduced->def->data.stmt_assign.target_type;
+    int64_t scaled_low = reduced->scale * low + reduced->offset;
+    int64_t scaled_high = reduced->scale * high + reduced->offset;
+    int64_t scaled_limit = reduced->scale * limit + reduced->offset;
+    if (!fits_type(type, scaled_low) || !fits_type(type, scaled_high) ||
+        !fits_type(type, scaled_limit)) {
+      continue;
+    }
+    
+    ast_node_t* lhs = ast_create_identifier(reduced->name);
+    ast_node_t* rhs = ast_create_integer(scaled_limit);
+    if (lhs == NULL || rhs == NULL) {
+      ast_destroy_node(lhs);
+      ast_destroy_node(rhs);
+      return false;
+    }
+    
+    optimize_remark(ind->context, HOILC_REMARK_PASSED, ind->function, test, "ExitTest",
+                    "rewrote exit test '%s' on '%s' to use the reduced variable",
+                    test->data.stmt_assign.target, name);
+    ast_node_t** operands = instruction->data.stmt_instruction.operands.nodes;
+    lhs->location = operands[0]->location;
+    rhs->location = operands[1]->location;
+    ast_destroy_node(operands[0]);
+    ast_destroy_node(operands[1]);
+    operands[0] = lhs;
+    operands[1] = rhs;
+  }
+  
+  return !ind->failed;
+}
+
+/**
+ * @brief Reduce the induction variables of the loop with a given header.
+ * 
+ * @param ind The strength reduction state, with the CFG and header set.
+ * @param changed Set to true if the function was changed.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool reduce_loop(induction_t* ind, bool* changed) {
+  collect_body(ind);
+  if (!count_definitions(ind)) {
+    return false;
+  }
+  
+  find_basic_variables(ind);
+  find_derived_variables(ind);
+  for (size_t i = 0; i < ind->basic_count; i++) {
+    optimize_remark(ind->context, HOILC_REMARK_ANALYSIS, ind->function, ind->basics[i].increment,
+                    "BasicVariable", "'%s' is an induction variable with step %lld",
+                    ir_var_table_name(ind->vars, ind->basics[i].var),
+                    (long long)ind->basics[i].step);
+  }
+  if (ind->derived_count == 0) {
+    return true;
+  }
+  
+  /* Entry values come from the single outside predecessor, if any */
+  int32_t outside = -1;
+  for (size_t i = 0; i < cfg_predecessor_count(ind->cfg, ind->header); i++) {
+    size_t pred = cfg_get_predecessor(ind->cfg, ind->header, i);
+    if (!ir_bitset_test(&ind->body, pred)) {
+      outside = outside == -1 ? (int32_t)pred : -2;
+    }
+  }
+  for (size_t i = 0; i < ind->basic_count && outside >= 0; i++) {
+    basic_iv_t* basic = &ind->basics[i];
+    basic->has_entry = find_entry_value(ind, (size_t)outside,
+                                        ir_var_table_name(ind->vars, basic->var),
+                                        &basic->entry);
+  }
+  
+  ast_node_t* preheader = get_preheader(ind);
+  if (preheader == NULL) {
+    if (!ind->failed) {
+      optimize_remark(ind->context, HOILC_REMARK_MISSED, ind->function,
+                      cfg_get_block(ind->cfg, ind->header), "NoPreheader",
+                      "induction variables of the loop at '%s' not reduced: %s",
+                      cfg_get_block(ind->cfg, ind->header)->data.stmt_block.label,
+                      ind->header == 0 ? "its header is the function entry" :
+                      "it has no entry edge");
+    }
+    return !ind->failed;
+  }
+  *changed = true;
+  
+  for (size_t i = 0; i < ind->derived_count; i++) {
+    if (!reduce_variable(ind, preheader, &ind->derived[i])) {
+      return false;
+    }
+  }
+  
+  for (size_t i = 0; i < ind->basic_count; i++) {
+    if (!rewrite_exit_test(ind, i)) {
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Use counting state.
+ */
+typedef struct {
+  ir_var_table_t* vars;     /**< Variable numbering table. */
+  size_t* uses;             /**< Uses of each variable. */
+  size_t* self_uses;        /**< Uses in a definition of the same variable. */
+  const char* def;          /**< Variable defined by the current statement. */
+  bool failed;              /**< Whether memory allocation failed. */
+} use_count_t;
+
+/**
+ * @brief Use visitor that counts the uses of each variable.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The use counting state.
+ */
+static void count_use(ast_node_t** use, void* data) {
+  use_count_t* count = (use_count_t*)data;
+  const char* name = (*use)->data.expr_identifier.name;
+  int32_t id = ir_var_table_find(count->vars, name);
+  if (id < 0) {
+    return;
+  }
+  
+  count->uses[id]++;
+  if (count->def != NULL && strcmp(count->def, name) == 0) {
+    count->self_uses[id]++;
+  }
+}
+
+/**
+ * @brief Remove the variables that are only read by their own definitions.
+ * 
+ * This drops the basic induction variables whose exit tests were rewritten,
+ * along with the moves left behind by reduced variables nothing reads.
+ * 
+ * @param globals The global symbol table.
+ * @param function The function AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool remove_dead_variables(symbol_table_t* globals, ast_node_t* function) {
+  bool changed = true;
+  bool success = true;
+  
+  while (changed && success) {
+    changed = false;
+    ir_var_table_t* vars = ir_var_table_create();
+    success = vars != NULL;
+    
+    size_t statement_count = 0;
+    for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+      ast_node_list_t* statements = block_statements(function, i);
+      statement_count += statements->count;
+      for (size_t j = 0; j < statements->count && success; j++) {
+        const char* def = ir_get_def(statements->nodes[j]);
+        success = def == NULL || ir_var_table_intern(vars, def) >= 0;
+      }
+    }
+    
+    use_count_t count = { vars, NULL, NULL, NULL, false };
+    bool* removable = NULL;
+    if (success) {
+      count.uses = (size_t*)calloc(statement_count + 1, sizeof(size_t));
+      count.self_uses = (size_t*)calloc(statement_count + 1, sizeof(size_t));
+      removable = (bool*)malloc((statement_count + 1) * sizeof(bool));
+      success = count.uses != NULL && count.self_uses != NULL && removable != NULL;
+    }
+    
+    for (size_t i = 0; i < statement_count && success; i++) {
+      removable[i] = true;
+    }
+    for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+      ast_node_list_t* statements = block_statements(function, i);
+      for (size_t j = 0; j < statements->count; j++) {
+        ast_node_t* stmt = statements->nodes[j];
+        count.def = ir_get_def(stmt);
+        ir_visit_uses(stmt, count_use, &count);
+        
+        /* Globals and definitions with effects stay */
+        uint32_t flags = ir_get_flags(stmt);
+        if (count.def != NULL &&
+            (ir_get_instruction(stmt) == NULL || (flags & IR_FLAG_PURE) == 0 ||
+             (flags & IR_FLAG_MAY_TRAP) != 0 ||
+             symtable_lookup(globals, count.def, false) != NULL)) {
+          removable[ir_var_table_find(vars, count.def)] = false;
+        }
+      }
+    }
+    
+    for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+      ast_node_list_t* statements = block_statements(function, i);
+      size_t kept = 0;
+      for (size_t j = 0; j < statements->count; j++) {
+        ast_node_t* stmt = statements->nodes[j];
+        const char* def = ir_get_def(stmt);
+        int32_t id = def != NULL ? ir_var_table_find(vars, def) : -1;
+        if (id >= 0 && removable[id] && count.uses[id] == count.self_uses[id]) {
+          ast_destroy_node(stmt);
+          changed = true;
+          continue;
+        }
+        statements->nodes[kept++] = stmt;
+      }
+      statements->count = kept;
+    }
+    
+    free(count.uses);
+    free(count.self_uses);
+    free(removable);
+    ir_var_table_destroy(vars);
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Free the per-loop state.
+ * 
+ * @param ind The strength reduction state.
+ */
+static void reset_loop(induction_t* ind) {
+  for (size_t i = 0; ind->derived != NULL && i < ind->derived_count; i++) {
+    free(ind->derived[i].name);
+    ast_destroy_node(ind->derived[i].value);
+  }
+  free(ind->def_counts);
+  free(ind->defs);
+  free(ind->def_blocks);
+  free(ind->basics);
+  free(ind->derived);
+  ir_bitset_free(&ind->body);
+  ir_var_table_destroy(ind->vars);
+  cfg_destroy(ind->cfg);
+  
+  ind->def_counts = NULL;
+  ind->defs = NULL;
+  ind->def_blocks = NULL;
+  ind->basics = NULL;
+  ind->basic_count = 0;
+  ind->derived = NULL;
+  ind->derived_count = 0;
+  ind->vars = NULL;
+  ind->cfg = NULL;
+}
+
+bool pass_induction(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  induction_t ind;
+  memset(&ind, 0, sizeof(ind));
+  ind.context = context;
+  ind.globals = optimize_get_symbol_table(context);
+  ind.function = function;
+  
+  size_t next_id = 0;
+  ind.next_id = &next_id;
+  ir_var_table_t* done = ir_var_table_create();
+  bool success = done != NULL;
+  bool changed = false;
+  
+  /* Reduce one loop at a time, innermost first, rebuilding the CFG in between */
+  bool progress = success;
+  while (progress && success) {
+    progress = false;
+    ind.cfg = cfg_build(function);
+    success = ind.cfg != NULL && cfg_compute_dominators(ind.cfg) && cfg_compute_loops(ind.cfg);
+    
+    /* Loops are numbered innermost first */
+    size_t count = success ? cfg_loop_count(ind.cfg) : 0;
+    size_t best = 0;
+    for (; best < count; best++) {
+      ast_node_t* header = cfg_get_block(ind.cfg, cfg_loop_header(ind.cfg, best));
+      if (ir_var_table_find(done, header->data.stmt_block.label) < 0) {
+        break;
+      }
+    }
+    
+    if (success && best < count) {
+      ind.loop = best;
+      ind.header = cfg_loop_header(ind.cfg, best);
+      ind.vars = ir_var_table_create();
+      success = ind.vars != NULL && ir_bitset_init(&ind.body, cfg_block_count(ind.cfg)) &&
+                ir_var_table_intern(done, cfg_get_block(ind.cfg, ind.header)->data.stmt_block.label) >= 0 &&
+                reduce_loop(&ind, &changed);
+      progress = true;
+    }
+    reset_loop(&ind);
+  }
+  
+  if (success && changed) {
+    success = remove_dead_variables(ind.globals, function);
+  }
+  
+  ir_var_table_destroy(done);
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL,
+                         function, "Memory allocation failed");
+  }
+  
+  return success;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file pass_layout.c
+ * @brief Basic block layout driven by branch probability hints.
+ * 
+ * This file contains a pass that moves the blocks reached only through
+ * branch edges hinted as rarely taken to the end of their function, so
+ * the likely paths stay contiguous and cold code stays out of line.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/cfg.h"
+#include "../include/ir.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Edges taken with a probability below one in this many are cold.
+ */
+#define LAYOUT_COLD_RATIO 16
+
+/**
+ * @brief Get the terminator of a block when it is a conditional branch.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @return The branch statement, or NULL if the block does not end with one.
+ */
+static const ast_node_t* conditional_branch(const cfg_t* cfg, size_t block) {
+  size_t length = cfg_statement_count(cfg, block);
+  if (length == 0) {
+    return NULL;
+  }
+  
+  const ast_node_t* last = cfg_get_block(cfg, block)->data.stmt_block.statements.nodes[length - 1];
+  return last->type == AST_STMT_BRANCH && last->data.stmt_branch.condition != NULL ? last : NULL;
+}
+
+/**
+ * @brief Check whether the hint of a branch makes an edge cold.
+ * 
+ * @param cfg The control flow graph.
+ * @param from The block the edge leaves.
+ * @param to The block the edge enters.
+ * @return true if the edge is taken with a probability below 1/LAYOUT_COLD_RATIO.
+ */
+static bool is_cold_edge(const cfg_t* cfg, size_t from, size_t to) {
+  const ast_node_t* branch = conditional_branch(cfg, from);
+  if (branch == NULL) {
+    return false;
+  }
+  
+  const ast_stmt_branch_t* data = &branch->data.stmt_branch;
+  const char* label = cfg_get_block(cfg, to)->data.stmt_block.label;
+  if (strcmp(data->true_target, data->false_target) == 0) {
+    return false;
+  }
+  
+  uint64_t weight = strcmp(data->true_target, label) == 0 ? data->true_weight : data->false_weight;
+  uint64_t total = (uint64_t)data->true_weight + data->false_weight;
+  return total > 0 && weight * LAYOUT_COLD_RATIO < total;
+}
+
+/**
+ * @brief Check whether a block falls through to the next one.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block number.
+ * @return true if the block ends without a terminator.
+ */
+static bool falls_through(const cfg_t* cfg, size_t block) {
+  size_t length = cfg_statement_count(cfg, block);
+  return length == 0 ||
+         (ir_get_flags(cfg_get_block(cfg, block)->data.stmt_block.statements.nodes[length - 1]) &
+          IR_FLAG_TERMINATOR) == 0;
+}
+
+/**
+ * @brief Check whether a function has a branch probability hint.
+ * 
+ * @param function The function AST node.
+ * @return true if some conditional branch carries weights.
+ */
+static bool has_hints(const ast_node_t* function) {
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    const ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      const ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      if (stmt->type == AST_STMT_BRANCH && stmt->data.stmt_branch.condition != NULL &&
+          (stmt->data.stmt_branch.true_weight != 0 || stmt->data.stmt_branch.false_weight != 0)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Find the cold blocks of a function.
+ * 
+ * Every reachable block but the entry starts cold, and a block warms up
+ * when a warm block reaches it through an edge that is not cold, so a
+ * block is cold when all its paths from the entry take a cold edge.
+ * 
+ * @param cfg The control flow graph, after cfg_compute_dominators.
+ * @param cold Array receiving whether each block is cold.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool find_cold_blocks(const cfg_t* cfg, bool* cold) {
+  size_t count = cfg_block_count(cfg);
+  size_t* worklist = (size_t*)malloc((count + 1) * sizeof(size_t));
+  if (worklist == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < count; i++) {
+    cold[i] = i > 0 && cfg_is_reachable(cfg, i);
+  }
+  
+  size_t pending = 0;
+  worklist[pending++] = 0;
+  while (pending > 0) {
+    size_t block = worklist[--pending];
+    for (size_t i = 0; i < cfg_successor_count(cfg, block); i++) {
+      size_t successor = cfg_get_successor(cfg, block, i);
+      if (cold[successor] && !is_cold_edge(cfg, block, successor)) {
+        cold[successor] = false;
+        worklist[pending++] = successor;
+      }
+    }
+  }
+  
+  free(worklist);
+  return true;
+}
+
+/**
+ * @brief Make a fall-through explicit with an unconditional branch.
+ * 
+ * @param cfg The control flow graph.
+ * @param block The block falling through to the next one.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool add_jump(const cfg_t* cfg, size_t block) {
+  ast_node_t* jump = ast_create_node(AST_STMT_BRANCH);
+  char* target = strdup(cfg_get_block(cfg, block + 1)->data.stmt_block.label);
+  ast_node_t* node = cfg_get_block(cfg, block);
+  if (jump == NULL || target == NULL ||
+      !ast_add_node(&node->data.stmt_block.statements, jump)) {
+    ast_destroy_node(jump);
+    free(target);
+    return false;
+  }
+  
+  jump->data.stmt_branch.true_target = target;
+  jump->location = node->location;
+  return true;
+}
+
+bool pass_layout(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  ast_node_list_t* blocks = &function->data.function.blocks;
+  size_t count = blocks->count;
+  if (count < 2 || !has_hints(function)) {
+    return true;
+  }
+  
+  cfg_t* cfg = cfg_build(function);
+  bool* cold = (bool*)malloc(count * sizeof(bool));
+  ast_node_t** order = (ast_node_t**)malloc(count * sizeof(ast_node_t*));
+  bool success = cfg != NULL && cold != NULL && order != NULL &&
+                 cfg_compute_dominators(cfg) && find_cold_blocks(cfg, cold);
+  
+  /* A last block without terminator ends the function, so nothing may follow it */
+  bool moved = false;
+  if (success && !falls_through(cfg, count - 1)) {
+    size_t placed = 0;
+    for (size_t i = 0; i < count; i++) {
+      if (!cold[i]) {
+        moved = moved || placed != i;
+        order[placed++] = blocks->nodes[i];
+      }
+    }
+    for (size_t i = 0; i < count; i++) {
+      if (cold[i]) {
+        moved = moved || placed != i;
+        order[placed++] = blocks->nodes[i];
+      }
+    }
+  }
+  
+  if (moved) {
+    for (size_t i = 0; i < count && success; i++) {
+      if (cold[i]) {
+        optimize_remark(context, HOILC_REMARK_PASSED, function, blocks->nodes[i], "ColdBlock",
+                        "moved cold block '%s' out of line",
+                        blocks->nodes[i]->data.stmt_block.label);
+      }
+      
+      /* Blocks separated from their fall-through successor branch to it */
+      if (i + 1 < count && cold[i] != cold[i + 1] && falls_through(cfg, i)) {
+        success = add_jump(cfg, i);
+      }
+    }
+  }
+  
+  if (moved && success) {
+    memcpy(blocks->nodes, order, count * sizeof(ast_node_t*));
+  }
+  
+  free(order);
+  free(cold);
+  cfg_destroy(cfg);
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL,
+                         function, "Memory allocation failed");
+  }
+  
+  return success;
+}
@@ -0,0 +1,492 @@
+/**
+ * @file pass_memory.c
+ * @brief Redundant load and dead store elimination.
+ * 
+ * This file contains a pass that walks each basic block keeping the values
+ * known to be in memory and the stores not yet read. A load from an
+ * address whose value is known becomes a move of that value, and a store
+ * overwritten through the same address before anything could read it is
+ * removed. The alias analysis decides which known values and pending
+ * stores survive the accesses in between.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/alias.h"
+#include "../include/ir.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Value known to be in memory.
+ */
+typedef struct {
+  ast_node_t* access;       /**< Load or store the value comes from. */
+  const char* address;      /**< Local holding the address. */
+  const char* value;        /**< Local holding the value. */
+  const ast_node_t* type;   /**< Type of the value. */
+} memory_value_t;
+
+/**
+ * @brief Store whose value nothing has read yet.
+ */
+typedef struct {
+  size_t index;             /**< Position of the store in the block. */
+  const char* address;      /**< Local holding the address. */
+} memory_store_t;
+
+/**
+ * @brief Memory optimization state for one function.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  effects_t* effects;       /**< Memory effects of the module's functions. */
+  alias_t* alias;           /**< Alias analysis of the function. */
+  ast_node_t* function;     /**< Function AST node. */
+  ir_var_table_t* vars;     /**< Parameters and locals. */
+  const ast_node_t** types; /**< Type of each variable, or NULL if unknown. */
+  memory_value_t* values;   /**< Known values. */
+  size_t value_count;       /**< Number of known values. */
+  memory_store_t* stores;   /**< Pending stores. */
+  size_t store_count;       /**< Number of pending stores. */
+  size_t capacity;          /**< Capacity of both arrays. */
+  bool reads_global;        /**< Whether the statement being scanned uses a global. */
+} memory_t;
+
+/**
+ * @brief Use visitor that notes uses of names that are not locals.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The memory optimization state.
+ */
+static void check_global_use(ast_node_t** use, void* data) {
+  memory_t* memory = (memory_t*)data;
+  if (ir_var_table_find(memory->vars, (*use)->data.expr_identifier.name) < 0) {
+    memory->reads_global = true;
+  }
+}
+
+/**
+ * @brief Check whether a statement reads memory through an operand expression.
+ * 
+ * @param instruction The instruction node (can be NULL).
+ * @return true if an operand is a field or element access.
+ */
+static bool has_memory_operand(const ast_node_t* instruction) {
+  if (instruction == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < instruction->data.stmt_instruction.operands.count; i++) {
+    ast_node_type_t type = instruction->data.stmt_instruction.operands.nodes[i]->type;
+    if (type == AST_EXPR_FIELD || type == AST_EXPR_INDEX || type == AST_EXPR_CALL) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Get the local an expression names.
+ * 
+ * @param memory The memory optimization state.
+ * @param expr The expression.
+ * @return The local name, or NULL if the expression is not a local.
+ */
+static const char* local_name(const memory_t* memory, const ast_node_t* expr) {
+  if (expr->type != AST_EXPR_IDENTIFIER ||
+      ir_var_table_find(memory->vars, expr->data.expr_identifier.name) < 0) {
+    return NULL;
+  }
+  return expr->data.expr_identifier.name;
+}
+
+/**
+ * @brief Check whether two types have the same canonical form.
+ * 
+ * @param a The first type (can be NULL).
+ * @param b The second type (can be NULL).
+ * @return true if both types are known and equal.
+ */
+static bool same_type(const ast_node_t* a, const ast_node_t* b) {
+  if (a == NULL || b == NULL) {
+    return false;
+  }
+  
+  ir_key_t key_a;
+  ir_key_t key_b;
+  memset(&key_a, 0, sizeof(key_a));
+  memset(&key_b, 0, sizeof(key_b));
+  ir_key_append_type(&key_a, a);
+  ir_key_append_type(&key_b, b);
+  bool equal = !key_a.failed && !key_b.failed && ir_key_equal(&key_a, &key_b);
+  ir_key_free(&key_a);
+  ir_key_free(&key_b);
+  return equal;
+}
+
+/**
+ * @brief Forget the known values and pending stores involving a redefined local.
+ * 
+ * @param memory The memory optimization state.
+ * @param name The redefined local.
+ */
+static void forget_local(memory_t* memory, const char* name) {
+  size_t kept = 0;
+  for (size_t i = 0; i < memory->value_count; i++) {
+    if (strcmp(memory->values[i].address, name) != 0 &&
+        strcmp(memory->values[i].value, name) != 0) {
+      memory->values[kept++] = memory->values[i];
+    }
+  }
+  memory->value_count = kept;
+  
+  kept = 0;
+  for (size_t i = 0; i < memory->store_count; i++) {
+    if (strcmp(memory->stores[i].address, name) != 0) {
+      memory->stores[kept++] = memory->stores[i];
+    }
+  }
+  memory->store_count = kept;
+}
+
+/**
+ * @brief Forget the pending stores an access may read.
+ * 
+ * @param memory The memory optimization state.
+ * @param statements The block statements.
+ * @param access The reading statement.
+ */
+static void read_stores(memory_t* memory, ast_node_t** statements, ast_node_t* access) {
+  size_t kept = 0;
+  for (size_t i = 0; i < memory->store_count; i++) {
+    if (!alias_may_alias(memory->alias, statements[memory->stores[i].index], access)) {
+      memory->stores[kept++] = memory->stores[i];
+    }
+  }
+  memory->store_count = kept;
+}
+
+/**
+ * @brief Make room for one more known value and pending store.
+ * 
+ * @param memory The memory optimization state.
+ * @return true on success, false on allocation failure.
+ */
+static bool reserve_entry(memory_t* memory) {
+  if (memory->value_count < memory->capacity && memory->store_count < memory->capacity) {
+    return true;
+  }
+  
+  size_t capacity = memory->capacity == 0 ? 16 : memory->capacity * 2;
+  memory_value_t* values = (memory_value_t*)realloc(memory->values,
+                                                    capacity * sizeof(memory_value_t));
+  if (values == NULL) {
+    return false;
+  }
+  memory->values = values;
+  
+  memory_store_t* stores = (memory_store_t*)realloc(memory->stores,
+                                                    capacity * sizeof(memory_store_t));
+  if (stores == NULL) {
+    return false;
+  }
+  memory->stores = stores;
+  memory->capacity = capacity;
+  return true;
+}
+
+/**
+ * @brief Replace a load with a move of a local holding the loaded value.
+ * 
+ * @param load The load assignment.
+ * @param value The local.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool assign_value(ast_node_t* load, const char* value) {
+  ast_node_t* instruction = ast_create_instruction("ADD");
+  ast_node_t* lhs = ast_create_identifier(value);
+  ast_node_t* rhs = ast_create_integer(0);
+  bool success = instruction != NULL && lhs != NULL && rhs != NULL &&
+                 ast_add_node(&instruction->data.stmt_instruction.operands, lhs);
+  if (!success) {
+    ast_destroy_node(lhs);
+  }
+  success = success && ast_add_node(&instruction->data.stmt_instruction.operands, rhs);
+  if (!success) {
+    ast_destroy_node(rhs);
+    ast_destroy_node(instruction);
+    return false;
+  }
+  
+  instruction->location = load->data.stmt_assign.value->location;
+  ast_destroy_node(load->data.stmt_assign.value);
+  load->data.stmt_assign.value = instruction;
+  return true;
+}
+
+/**
+ * @brief Process a load from a local address.
+ * 
+ * @param memory The memory optimization state.
+ * @param statements The block statements.
+ * @param index The position of the load.
+ * @param address The local holding the address.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool process_load(memory_t* memory, ast_node_t** statements, size_t index,
+                         const char* address) {
+  ast_node_t* load = statements[index];
+  const char* target = load->data.stmt_assign.target;
+  const ast_node_t* type = load->data.stmt_assign.target_type;
+  
+  /* Moves are ADD of zero, so only integers and pointers are forwarded */
+  bool movable = type != NULL && (type->type == AST_TYPE_INT || type->type == AST_TYPE_PTR);
+  for (size_t i = 0; movable && i < memory->value_count; i++) {
+    const memory_value_t* known = &memory->values[i];
+    if (strcmp(known->address, address) != 0 || !same_type(known->type, type)) {
+      continue;
+    }
+    
+    optimize_remark(memory->context, HOILC_REMARK_PASSED, memory->function, load, "Forwarded",
+                    "replaced load of '%s' from '%s' with '%s'", target, address, known->value);
+    const char* value = known->value;
+    if (!assign_value(load, value)) {
+      return false;
+    }
+    forget_local(memory, target);
+    return true;
+  }
+  
+  read_stores(memory, statements, load);
+  forget_local(memory, target);
+  if (strcmp(target, address) == 0) {
+    return true;
+  }
+  
+  if (!reserve_entry(memory)) {
+    return false;
+  }
+  memory->values[memory->value_count++] = (memory_value_t){ load, address, target, type };
+  return true;
+}
+
+/**
+ * @brief Process a store to a local address.
+ * 
+ * @param memory The memory optimization state.
+ * @param statements The block statements.
+ * @param index The position of the store.
+ * @param address The local holding the address.
+ * @param dead Flags of the statements to remove, indexed by position.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool process_store(memory_t* memory, ast_node_t** statements, size_t index,
+                          const char* address, bool* dead) {
+  ast_node_t* store = statements[index];
+  
+  /* An unread store through the same address is overwritten */
+  for (size_t i = 0; i < memory->store_count; i++) {
+    if (strcmp(memory->stores[i].address, address) == 0) {
+      optimize_remark(memory->context, HOILC_REMARK_PASSED, memory->function,
+                      statements[memory->stores[i].index], "DeadStore",
+                      "removed store to '%s' overwritten before it is read", address);
+      dead[memory->stores[i].index] = true;
+      memory->stores[i] = memory->stores[--memory->store_count];
+      break;
+    }
+  }
+  
+  /* Known values this store may overwrite are lost */
+  size_t kept = 0;
+  for (size_t i = 0; i < memory->value_count; i++) {
+    if (!alias_may_alias(memory->alias, memory->values[i].access, store)) {
+      memory->values[kept++] = memory->values[i];
+    }
+  }
+  memory->value_count = kept;
+  
+  if (!reserve_entry(memory)) {
+    return false;
+  }
+  memory->stores[memory->store_count++] = (memory_store_t){ index, address };
+  
+  ast_node_t* instruction = ir_get_instruction(store);
+  const char* value = instruction->data.stmt_instruction.operands.count == 2 ?
+    local_name(memory, instruction->data.stmt_instruction.operands.nodes[1]) : NULL;
+  if (value != NULL) {
+    int32_t id = ir_var_table_find(memory->vars, value);
+    memory->values[memory->value_count++] =
+      (memory_value_t){ store, address, value, memory->types[id] };
+  }
+  return true;
+}
+
+/**
+ * @brief Optimize the loads and stores of one block.
+ * 
+ * @param memory The memory optimization state.
+ * @param block The block AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool optimize_block(memory_t* memory, ast_node_t* block) {
+  ast_node_list_t* statements = &block->data.stmt_block.statements;
+  bool* dead = (bool*)calloc(statements->count + 1, sizeof(bool));
+  if (dead == NULL) {
+    return false;
+  }
+  
+  memory->value_count = 0;
+  memory->store_count = 0;
+  
+  bool success = true;
+  for (size_t i = 0; i < statements->count && success; i++) {
+    ast_node_t* stmt = statements->nodes[i];
+    ast_node_t* instruction = ir_get_instruction(stmt);
+    uint8_t opcode = ir_get_opcode(stmt);
+    uint32_t flags = effects_get_flags(memory->effects, memory->function, stmt);
+    const char* def = ir_get_def(stmt);
+    
+    memory->reads_global = false;
+    ir_visit_uses(stmt, check_global_use, memory);
+    
+    /* Globals live in memory, so reading one may read a pending store */
+    if (memory->reads_global || has_memory_operand(instruction)) {
+      memory->store_count = 0;
+    }
+    
+    const char* address = instruction != NULL &&
+                          instruction->data.stmt_instruction.operands.count > 0 ?
+      local_name(memory, instruction->data.stmt_instruction.operands.nodes[0]) : NULL;
+    if (opcode == OPCODE_LOAD && def != NULL && ir_var_table_find(memory->vars, def) >= 0 &&
+        address != NULL && instruction->data.stmt_instruction.operands.count == 1) {
+      success = process_load(memory, statements->nodes, i, address);
+      continue;
+    }
+    if (opcode == OPCODE_STORE && address != NULL) {
+      success = process_store(memory, statements->nodes, i, address, dead);
+      continue;
+    }
+    
+    if ((flags & IR_FLAG_WRITES_MEMORY) != 0 ||
+        (def != NULL && ir_var_table_find(memory->vars, def) < 0)) {
+      memory->value_count = 0;
+      memory->store_count = 0;
+    } else if ((flags & (IR_FLAG_READS_MEMORY | IR_FLAG_MAY_TRAP)) != 0) {
+      memory->store_count = 0;
+    }
+    if (def != NULL) {
+      forget_local(memory, def);
+    }
+  }
+  
+  /* Remove the overwritten stores */
+  size_t kept = 0;
+  for (size_t i = 0; i < statements->count; i++) {
+    if (dead[i]) {
+      ast_destroy_node(statements->nodes[i]);
+    } else {
+      statements->nodes[kept++] = statements->nodes[i];
+    }
+  }
+  statements->count = kept;
+  
+  free(dead);
+  return success;
+}
+
+/**
+ * @brief Number the parameters and locals and record their types.
+ * 
+ * @param memory The memory optimization state.
+ * @param globals The global symbol table.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool index_variables(memory_t* memory, symbol_table_t* globals) {
+  ast_node_t* function = memory->function;
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (ir_var_table_intern(memory->vars, param->data.parameter.name) < 0) {
+      return false;
+    }
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      if (def != NULL && ir_var_table_find(memory->vars, def) < 0 &&
+          symtable_lookup(globals, def, false) == NULL &&
+          ir_var_table_intern(memory->vars, def) < 0) {
+        return false;
+      }
+    }
+  }
+  
+  memory->types = (const ast_node_t**)calloc(ir_var_table_count(memory->vars) + 1,
+                                              sizeof(const ast_node_t*));
+  if (memory->types == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    memory->types[i] = function->data.function.parameters.nodes[i]->data.parameter.type;
+  }
+  
+  /* A local assigned values of different types has no single type */
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      const char* def = ir_get_def(stmt);
+      int32_t id = def != NULL ? ir_var_table_find(memory->vars, def) : -1;
+      if (id < (int32_t)function->data.function.parameters.count) {
+        continue;
+      }
+      if (memory->types[id] == NULL) {
+        memory->types[id] = stmt->data.stmt_assign.target_type;
+      } else if (!same_type(memory->types[id], stmt->data.stmt_assign.target_type)) {
+        memory->types[id] = NULL;
+      }
+    }
+  }
+  
+  return true;
+}
+
+bool pass_memory(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  symbol_table_t* globals = optimize_get_symbol_table(context);
+  memory_t memory;
+  memset(&memory, 0, sizeof(memory));
+  memory.context = context;
+  memory.effects = optimize_get_effects(context);
+  memory.alias = alias_analyze(function, globals);
+  memory.function = function;
+  memory.vars = ir_var_table_create();
+  
+  bool success = memory.effects != NULL && memory.alias != NULL && memory.vars != NULL &&
+                 index_variables(&memory, globals);
+  for (size_t i = 0; success && i < function->data.function.blocks.count; i++) {
+    success = optimize_block(&memory, function->data.function.blocks.nodes[i]);
+  }
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL,
+                         function, "Memory allocation failed");
+  }
+  
+  alias_destroy(memory.alias);
+  ir_var_table_destroy(memory.vars);
+  free(memory.types);
+  free(memory.values);
+  free(memory.stores);
+  
+  return success;
+}
@@ -0,0 +1,1323 @@
+/**
+ * @file pass_outline.c
+ * @brief Instruction sequence outliner.
+ * 
+ * This file contains a size optimization that finds instruction sequences
+ * repeated across the module, moves each into a new function and replaces
+ * the occurrences with calls when the cost model predicts a smaller module.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/cfg.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include "../include/codegen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Longest sequence considered for outlining.
+ */
+#define OUTLINE_MAX_LENGTH 30
+
+/**
+ * @brief Shortest sequence considered for outlining.
+ */
+#define OUTLINE_MIN_LENGTH 2
+
+/**
+ * @brief Encoded size of an instruction header (opcode, flags, count, destination).
+ */
+#define INSTRUCTION_SIZE 4
+
+/**
+ * @brief Fixed size of a Function section entry and its code header.
+ */
+#define FUNCTION_ENTRY_SIZE 16
+
+/**
+ * @brief Per-parameter size of a Function section entry.
+ */
+#define PARAMETER_ENTRY_SIZE 4
+
+/**
+ * @brief Prefix of the names of outlined functions.
+ */
+#define OUTLINED_PREFIX "__hoilc_outlined_"
+
+/**
+ * @brief Function being scanned for repeated sequences.
+ */
+typedef struct {
+  ast_node_t* function;      /**< Function AST node. */
+  cfg_t* cfg;                /**< Control flow graph with liveness. */
+  ir_var_table_t* vars;      /**< Variable numbering table. */
+  ast_node_t** var_types;    /**< Type of each local variable, NULL for other names. */
+  size_t* block_base;        /**< Module-wide number of the first statement of each block. */
+} outline_function_t;
+
+/**
+ * @brief Candidate sequence of a given length.
+ */
+typedef struct {
+  uint64_t hash;             /**< Hash of the canonical key. */
+  size_t function;           /**< Function number. */
+  size_t block;              /**< Block number. */
+  size_t start;              /**< First statement. */
+  size_t sequence;           /**< Discovery order, used as a tie breaker. */
+} outline_window_t;
+
+/**
+ * @brief Planned replacement of a sequence by a call.
+ */
+typedef struct {
+  size_t function;           /**< Function number. */
+  size_t block;              /**< Block number. */
+  size_t start;              /**< First replaced statement. */
+  size_t length;             /**< Number of replaced statements. */
+  ast_node_t* replacement;   /**< Call statement. */
+} outline_site_t;
+
+/**
+ * @brief Local variables of a sequence, numbered by first appearance.
+ */
+typedef struct {
+  int32_t* vars;             /**< Function variable number of each canonical variable. */
+  bool* is_param;            /**< Whether the variable is read before it is written. */
+  bool* is_defined;          /**< Whether the sequence writes the variable. */
+  size_t count;              /**< Number of canonical variables. */
+  size_t capacity;           /**< Capacity of the arrays. */
+} outline_binding_t;
+
+/**
+ * @brief Outliner state.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  symbol_table_t* globals;   /**< Global symbol table. */
+  ast_node_t* module;        /**< Module AST node. */
+  outline_function_t* functions; /**< Scanned functions. */
+  size_t function_count;     /**< Number of scanned functions. */
+  ir_bitset_t eligible;      /**< Statements that may be outlined. */
+  ir_bitset_t consumed;      /**< Statements claimed by an outlined sequence. */
+  ir_bitset_t live;          /**< Scratch live set. */
+  outline_site_t* sites;     /**< Planned replacements. */
+  size_t site_count;         /**< Number of planned replacements. */
+  size_t site_capacity;      /**< Capacity of the sites array. */
+  size_t next_id;            /**< Number of the next outlined function. */
+  bool failed;               /**< Whether memory allocation failed. */
+} outliner_t;
+
+/**
+ * @brief Check whether a type can be passed to and returned from a function.
+ * 
+ * @param type The type node (can be NULL).
+ * @return true for scalar, pointer and vector types.
+ */
+static bool is_value_type(const ast_node_t* type) {
+  if (type == NULL) {
+    return false;
+  }
+  
+  switch (type->type) {
+    case AST_TYPE_BOOL:
+    case AST_TYPE_INT:
+    case AST_TYPE_FLOAT:
+    case AST_TYPE_PTR:
+    case AST_TYPE_VEC:
+      return true;
+    
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Get the kind of a global symbol.
+ * 
+ * @param outliner The outliner state.
+ * @param name The symbol name.
+ * @param kind Pointer to store the symbol kind.
+ * @return true if the name is a global, constant or function.
+ */
+static bool find_global(const outliner_t* outliner, const char* name, symbol_kind_t* kind) {
+  symbol_entry_t* entry = symtable_lookup(outliner->globals, name, false);
+  if (entry == NULL) {
+    return false;
+  }
+
+  *kind = symtable_get_kind(entry);
+  return *kind == SYMBOL_GLOBAL || *kind == SYMBOL_CONSTANT || *kind == SYMBOL_FUNCTION;
+}
+
+/**
+ * @brief Get the type of a local variable.
+ * 
+ * @param fn The function.
+ * @param name The variable name.
+ * @return The variable type, or NULL if the name is not a local variable.
+ */
+static ast_node_t* local_type(const outline_function_t* fn, const char* name) {
+  int32_t id = ir_var_table_find(fn->vars, name);
+  return id >= 0 ? fn->var_types[id] : NULL;
+}
+
+/**
+ * @brief Check whether an operand expression can be moved to another function.
+ * 
+ * @param outliner The outliner state.
+ * @param fn The function holding the expression.
+ * @param expr The expression.
+ * @return true if the expression is outlinable, false otherwise.
+ */
+static bool is_outlinable_expr(const outliner_t* outliner, const outline_function_t* fn,
+                               const ast_node_t* expr) {
+  switch (expr->type) {
+    case AST_EXPR_INTEGER:
+    case AST_EXPR_FLOAT:
+    case AST_EXPR_STRING:
+      return true;
+    
+    case AST_EXPR_IDENTIFIER: {
+      symbol_kind_t kind;
+      const char* name = expr->data.expr_identifier.name;
+      return is_value_type(local_type(fn, name)) ||
+             (local_type(fn, name) == NULL && find_global(outliner, name, &kind));
+    }
+    
+    case AST_EXPR_CALL: {
+      if (!is_outlinable_expr(outliner, fn, expr->data.expr_call.function)) {
+        return false;
+      }
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        if (!is_outlinable_expr(outliner, fn, expr->data.expr_call.arguments.nodes[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    
+    default:
+      /* Field and index expressions are not lowered by the code generator */
+      return false;
+  }
+}
+
+/**
+ * @brief Check whether a statement can be moved to another function.
+ * 
+ * @param outliner The outliner state.
+ * @param fn The function holding the statement.
+ * @param stmt The statement.
+ * @return true if the statement is outlinable, false otherwise.
+ */
+static bool is_outlinable(const outliner_t* outliner, const outline_function_t* fn,
+                          ast_node_t* stmt) {
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  if (instruction == NULL || codegen_lookup_opcode(instruction->data.stmt_instruction.opcode) == 0 ||
+      (ir_get_flags(stmt) & IR_FLAG_TERMINATOR) != 0) {
+    return false;
+  }
+  
+  if (stmt->type == AST_STMT_ASSIGN &&
+      !is_value_type(local_type(fn, stmt->data.stmt_assign.target))) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < instruction->data.stmt_instruction.operands.count; i++) {
+    if (!is_outlinable_expr(outliner, fn, instruction->data.stmt_instruction.operands.nodes[i])) {
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Estimate the encoded size of an operand expression.
+ * 
+ * @param outliner The outliner state.
+ * @param fn The function holding the expression.
+ * @param expr The expression.
+ * @return The size in bytes of the instructions emitted for the operand.
+ */
+static size_t expr_size(const outliner_t* outliner, const outline_function_t* fn,
+                        const ast_node_t* expr) {
+  symbol_kind_t kind;
+  
+  switch (expr->type) {
+    case AST_EXPR_IDENTIFIER:
+      /* Globals and constants are materialized with a LEA */
+      if (local_type(fn, expr->data.expr_identifier.name) == NULL &&
+          find_global(outliner, expr->data.expr_identifier.name, &kind) &&
+          kind != SYMBOL_FUNCTION) {
+        return INSTRUCTION_SIZE + 1;
+      }
+      return 0;
+    
+    case AST_EXPR_CALL: {
+      size_t size = INSTRUCTION_SIZE + 1 + expr->data.expr_call.arguments.count;
+      const ast_node_t* callee = expr->data.expr_call.function;
+      if (callee->type != AST_EXPR_IDENTIFIER ||
+          !find_global(outliner, callee->data.expr_identifier.name, &kind) ||
+          kind != SYMBOL_FUNCTION) {
+        size += expr_size(outliner, fn, callee);
+      }
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        size += expr_size(outliner, fn, expr->data.expr_call.arguments.nodes[i]);
+      }
+      return size;
+    }
+    
+    default:
+      /* Literals are materialized with a LOAD */
+      return INSTRUCTION_SIZE;
+  }
+}
+
+/**
+ * @brief Estimate the encoded size of a statement.
+ * 
+ * @param outliner The outliner state.
+ * @param fn The function holding the statement.
+ * @param stmt The statement.
+ * @return The size in bytes.
+ */
+static size_t stmt_size(const outliner_t* outliner, const outline_function_t* fn,
+                        ast_node_t* stmt) {
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  const ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+  
+  /* A call statement is emitted as the call itself */
+  if (operands->count == 1 && operands->nodes[0]->type == AST_EXPR_CALL &&
+      codegen_lookup_opcode(instruction->data.stmt_instruction.opcode) == OPCODE_CALL) {
+    return expr_size(outliner, fn, operands->nodes[0]);
+  }
+  
+  size_t size = INSTRUCTION_SIZE + operands->count;
+  for (size_t i = 0; i < operands->count; i++) {
+    size += expr_size(outliner, fn, operands->nodes[i]);
+  }
+  
+  return size;
+}
+
+/**
+ * @brief Get the canonical number of a local variable, adding it if needed.
+ * 
+ * @param binding The binding.
+ * @param var The function variable number.
+ * @param is_def Whether the appearance is a definition.
+ * @param added Pointer to store whether the variable was new.
+ * @return The canonical number, or -1 if memory allocation failed.
+ */
+static int32_t bind_var(outline_binding_t* binding, int32_t var, bool is_def, bool* added) {
+  *added = false;
+  for (size_t i = 0; i < binding->count; i++) {
+    if (binding->vars[i] == var) {
+      binding->is_defined[i] |= is_def;
+      return (int32_t)i;
+    }
+  }
+  
+  if (binding->count >= binding->capacity) {
+    size_t new_capacity = binding->capacity == 0 ? 16 : binding->capacity * 2;
+    int32_t* vars = (int32_t*)realloc(binding->vars, new_capacity * sizeof(int32_t));
+    if (vars == NULL) {
+      return -1;
+    }
+    binding->vars = vars;
+    
+    bool* is_param = (bool*)realloc(binding->is_param, new_capacity * sizeof(bool));
+    if (is_param == NULL) {
+      return -1;
+    }
+    binding->is_param = is_param;
+    
+    bool* is_defined = (bool*)realloc(binding->is_defined, new_capacity * sizeof(bool));
+    if (is_defined == NULL) {
+      return -1;
+    }
+    binding->is_defined = is_defined;
+    binding->capacity = new_capacity;
+  }
+  
+  binding->vars[binding->count] = var;
+  binding->is_param[binding->count] = !is_def;
+  binding->is_defined[binding->count] = is_def;
+  *added = true;
+  
+  return (int32_t)binding->count++;
+}
+
+/**
+ * @brief Append a variable reference to a key.
+ * 
+ * @param outliner The outliner state.
+ * @param fn The function.
+ * @param key The key.
+ * @param binding The binding.
+ * @param name The variable name.
+ * @param is_def Whether the reference is a definition.
+ */
+static void append_var(outliner_t* outliner, const outline_function_t* fn, ir_key_t* key,
+                       outline_binding_t* binding, const char* name, bool is_def) {
+  ast_node_t* type = local_type(fn, name);
+  if (type == NULL) {
+    /* Globals and functions keep their identity */
+    ir_key_append(key, "@%zu:%s", strlen(name), name);
+    return;
+  }
+  
+  bool added;
+  int32_t id = bind_var(binding, ir_var_table_find(fn->vars, name), is_def, &added);
+  if (id < 0) {
+    outliner->failed = true;
+    return;
+  }
+  
+  ir_key_append(key, "%%%d", id);
+  if (added) {
+    ir_key_append(key, ":");
+    ir_key_append_type(key, type);
+  }
+}
+
+/**
+ * @brief Append the canonical form of an operand expression to a key.
+ * 
+ * @param outliner The outliner state.
+ * @param fn The function.
+ * @param key The key.
+ * @param binding The binding.
+ * @param expr The expression.
+ */
+static void append_expr(outliner_t* outliner, const outline_function_t* fn, ir_key_t* key,
+                        outline_binding_t* binding, const ast_node_t* expr) {
+  switch (expr->type) {
+    case AST_EXPR_INTEGER:
+      ir_key_append(key, "#%lld", (long long)expr->data.expr_integer.value);
+      break;
+    
+    case AST_EXPR_FLOAT:
+      ir_key_append(key, "#%a", expr->data.expr_float.value);
+      break;
+    
+    case AST_EXPR_STRING:
+      ir_key_append(key, "\"%zu:%s", strlen(expr->data.expr_string.value),
+                 expr->data.expr_string.value);
+      break;
+    
+    case AST_EXPR_IDENTIFIER:
+      append_var(outliner, fn, key, binding, expr->data.expr_identifier.name, false);
+      break;
+    
+    case AST_EXPR_CALL:
+      ir_key_append(key, "C(");
+      append_expr(outliner, fn, key, binding, expr->data.expr_call.function);
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        ir_key_append(key, ",");
+        append_expr(outliner, fn, key, binding, expr->data.expr_call.arguments.nodes[i]);
+      }
+      ir_key_append(key, ")");
+      break;
+    
+    default:
+      assert(false && "non-outlinable expression");
+      break;
+  }
+}
+
+/**
+ * @brief Build the canonical key and binding of a sequence.
+ * 
+ * Local variables are renamed by order of first appearance and tagged with
+ * their type, so equal keys denote sequences that compute the same thing.
+ * 
+ * @param outliner The outliner state.
+ * @param fn_index The function number.
+ * @param block The block number.
+ * @param start The first statement.
+ * @param length The number of statements.
+ * @param key The key to fill (reset first).
+ * @param binding The binding to fill (reset first).
+ * @return true on success, false if memory allocation failed.
+ */
+static bool canonicalize(outliner_t* outliner, size_t fn_index, size_t block, size_t start,
+                         size_t length, ir_key_t* key, outline_binding_t* binding) {
+  const outline_function_t* fn = &outliner->functions[fn_index];
+  ast_node_t* block_node = cfg_get_block(fn->cfg, block);
+  
+  ir_key_reset(key);
+  binding->count = 0;
+  
+  for (size_t i = start; i < start + length; i++) {
+    ast_node_t* stmt = block_node->data.stmt_block.statements.nodes[i];
+    ast_node_t* instruction = ir_get_instruction(stmt);
+    
+    /* Operands are read before the target is written */
+    ir_key_append(key, "%s:%u:%u(", instruction->data.stmt_instruction.opcode,
+                  (unsigned)instruction->data.stmt_instruction.flags,
+                  (unsigned)instruction->data.stmt_instruction.alignment);
+    for (size_t j = 0; j < instruction->data.stmt_instruction.operands.count; j++) {
+      if (j > 0) {
+        ir_key_append(key, ",");
+      }
+      append_expr(outliner, fn, key, binding, instruction->data.stmt_instruction.operands.nodes[j]);
+    }
+    ir_key_append(key, ")");
+    
+    if (stmt->type == AST_STMT_ASSIGN) {
+      ir_key_append(key, "=>");
+      append_var(outliner, fn, key, binding, stmt->data.stmt_assign.target, true);
+    }
+    ir_key_append(key, ";");
+  }
+  
+  if (key->failed) {
+    outliner->failed = true;
+  }
+  
+  return !outliner->failed;
+}
+
+/**
+ * @brief Backward liveness walk state.
+ */
+typedef struct {
+  const outline_function_t* fn; /**< Function being walked. */
+  ir_bitset_t* live;         /**< Variables live at the current point. */
+} live_walk_t;
+
+/**
+ * @brief Use visitor that marks the used variable live.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The walk state.
+ */
+static void mark_live(ast_node_t** use, void* data) {
+  live_walk_t* walk = (live_walk_t*)data;
+  int32_t id = ir_var_table_find(walk->fn->vars, (*use)->data.expr_identifier.name);
+  if (id >= 0 && (size_t)id < walk->live->size) {
+    ir_bitset_set(walk->live, (size_t)id);
+  }
+}
+
+/**
+ * @brief Find the locals written by a sequence that are still needed after it.
+ * 
+ * @param outliner The outliner state.
+ * @param fn_index The function number.
+ * @param block The block number.
+ * @param end The statement after the sequence.
+ * @param binding The binding of the sequence.
+ * @return The canonical number of the single live definition, -1 if there is
+ *         none, or -2 if several definitions are live.
+ */
+static int32_t live_definition(outliner_t* outliner, size_t fn_index, size_t block, size_t end,
+                               const outline_binding_t* binding) {
+  const outline_function_t* fn = &outliner->functions[fn_index];
+  ast_node_t* block_node = cfg_get_block(fn->cfg, block);
+  const ir_bitset_t* live_out = cfg_live_out(fn->cfg, block);
+  
+  /* Walk back from the block exit to the end of the sequence */
+  ir_bitset_t live = { outliner->live.words, live_out->size };
+  ir_bitset_copy(&live, live_out);
+  
+  for (size_t i = cfg_statement_count(fn->cfg, block); i-- > end;) {
+    ast_node_t* stmt = block_node->data.stmt_block.statements.nodes[i];
+    const char* def = ir_get_def(stmt);
+    if (def != NULL) {
+      ir_bitset_clear(&live, (size_t)ir_var_table_find(fn->vars, def));
+    }
+    
+    live_walk_t walk = { fn, &live };
+    ir_visit_uses(stmt, mark_live, &walk);
+  }
+  
+  int32_t result = -1;
+  for (size_t i = 0; i < binding->count; i++) {
+    if (binding->is_defined[i] && ir_bitset_test(&live, (size_t)binding->vars[i])) {
+      if (result >= 0) {
+        return -2;
+      }
+      result = (int32_t)i;
+    }
+  }
+  
+  return result;
+}
+
+/**
+ * @brief Sequence renaming state.
+ */
+typedef struct {
+  const outline_function_t* fn; /**< Function holding the sequence. */
+  const outline_binding_t* binding; /**< Binding of the sequence. */
+  bool failed;               /**< Whether memory allocation failed. */
+} rename_t;
+
+/**
+ * @brief Format the name of a canonical variable in an outlined function.
+ * 
+ * @param buffer The output buffer.
+ * @param size The buffer size.
+ * @param id The canonical variable number.
+ */
+static void canonical_name(char* buffer, size_t size, size_t id) {
+  snprintf(buffer, size, "__v%zu", id);
+}
+
+/**
+ * @brief Rename a local variable to its canonical name.
+ * 
+ * @param rename The renaming state.
+ * @param name Pointer to the owned name string.
+ */
+static void rename_var(rename_t* rename, char** name) {
+  if (local_type(rename->fn, *name) == NULL) {
+    return;
+  }
+  
+  int32_t var = ir_var_table_find(rename->fn->vars, *name);
+  for (size_t i = 0; i < rename->binding->count; i++) {
+    if (rename->binding->vars[i] != var) {
+      continue;
+    }
+    
+    char buffer[32];
+    canonical_name(buffer, sizeof(buffer), i);
+    char* copy = strdup(buffer);
+    if (copy == NULL) {
+      rename->failed = true;
+      return;
+    }
+    
+    free(*name);
+    *name = copy;
+    return;
+  }
+}
+
+/**
+ * @brief Use visitor that renames the used variable.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The renaming state.
+ */
+static void rename_use(ast_node_t** use, void* data) {
+  rename_var((rename_t*)data, &(*use)->data.expr_identifier.name);
+}
+
+/**
+ * @brief Create a function holding a copy of a sequence.
+ * 
+ * @param outliner The outliner state.
+ * @param window The representative sequence.
+ * @param length The number of statements.
+ * @param binding The binding of the sequence.
+ * @param result Canonical number of the returned variable, or -1.
+ * @return The new function, or NULL if it cannot be created.
+ */
+static ast_node_t* create_outlined_function(outliner_t* outliner, const outline_window_t* window,
+                                            size_t length, const outline_binding_t* binding,
+                                            int32_t result) {
+  const outline_function_t* fn = &outliner->functions[window->function];
+  ast_node_t* block_node = cfg_get_block(fn->cfg, window->block);
+  ast_node_t* first = block_node->data.stmt_block.statements.nodes[window->start];
+  symbol_kind_t kind;
+  char buffer[64];
+  
+  /* Canonical names must not hide globals */
+  for (size_t i = 0; i < binding->count; i++) {
+    canonical_name(buffer, sizeof(buffer), i);
+    if (find_global(outliner, buffer, &kind)) {
+      return NULL;
+    }
+  }
+  
+  do {
+    snprintf(buffer, sizeof(buffer), OUTLINED_PREFIX "%zu", outliner->next_id++);
+  } while (symtable_lookup(outliner->globals, buffer, false) != NULL);
+  
+  ast_node_t* return_type = result >= 0 ?
+    ast_clone_node(fn->var_types[binding->vars[result]]) :
+    ast_create_node(AST_TYPE_VOID);
+  if (return_type == NULL) {
+    outliner->failed = true;
+    return NULL;
+  }
+  
+  ast_node_t* function = ast_create_function(buffer, return_type);
+  if (function == NULL) {
+    ast_destroy_node(return_type);
+    outliner->failed = true;
+    return NULL;
+  }
+  function->location = first->location;
+  function->data.function.is_internal = true;
+  
+  /* Variables read before they are written become parameters */
+  bool success = true;
+  for (size_t i = 0; i < binding->count && success; i++) {
+    if (!binding->is_param[i]) {
+      continue;
+    }
+    
+    canonical_name(buffer, sizeof(buffer), i);
+    ast_node_t* param = ast_create_node(AST_PARAMETER);
+    if (param == NULL) {
+      success = false;
+      break;
+    }
+    
+    param->location = first->location;
+    param->data.parameter.name = strdup(buffer);
+    param->data.parameter.type = ast_clone_node(fn->var_types[binding->vars[i]]);
+    success = param->data.parameter.name != NULL && param->data.parameter.type != NULL &&
+              ast_add_node(&function->data.function.parameters, param);
+    if (!success) {
+      ast_destroy_node(param);
+    }
+  }
+  
+  /* A single block with the renamed statements and a return */
+  ast_node_t* entry = success ? ast_create_block("ENTRY") : NULL;
+  success = entry != NULL && ast_add_node(&function->data.function.blocks, entry);
+  if (entry != NULL && !success) {
+    ast_destroy_node(entry);
+  }
+  
+  rename_t rename = { fn, binding, false };
+  for (size_t i = 0; i < length && success; i++) {
+    ast_node_t* stmt = ast_clone_node(
+      block_node->data.stmt_block.statements.nodes[window->start + i]
+    );
+    if (stmt == NULL || !ast_add_node(&entry->data.stmt_block.statements, stmt)) {
+      ast_destroy_node(stmt);
+      success = false;
+      break;
+    }
+    
+    ir_visit_uses(stmt, rename_use, &rename);
+    if (stmt->type == AST_STMT_ASSIGN) {
+      rename_var(&rename, &stmt->data.stmt_assign.target);
+    }
+    success = !rename.failed;
+  }
+  
+  if (success) {
+    ast_node_t* ret = ast_create_node(AST_STMT_RETURN);
+    if (ret != NULL) {
+      ret->location = first->location;
+      if (result >= 0) {
+        canonical_name(buffer, sizeof(buffer), (size_t)result);
+        ret->data.stmt_return.value = ast_create_identifier(buffer);
+      }
+    }
+    
+    success = ret != NULL && (result < 0 || ret->data.stmt_return.value != NULL) &&
+              ast_add_node(&entry->data.stmt_block.statements, ret);
+    if (!success) {
+      ast_destroy_node(ret);
+    }
+  }
+  
+  /* Register the function with the module */
+  symbol_entry_t* symbol = NULL;
+  if (success) {
+    success = ast_add_node(&outliner->module->data.module.declarations, function);
+    if (success) {
+      symbol = symtable_add(outliner->globals, function->data.function.name,
+                            SYMBOL_FUNCTION, function);
+      if (symbol == NULL) {
+        outliner->module->data.module.declarations.count--;
+        success = false;
+      }
+    }
+  }
+  
+  if (!success) {
+    ast_destroy_node(function);
+    outliner->failed = true;
+    return NULL;
+  }
+  
+  symtable_set_type(symbol, function->data.function.return_type);
+  symtable_mark_defined(symbol);
+  
+  return function;
+}
+
+/**
+ * @brief Create the call that replaces one occurrence of a sequence.
+ * 
+ * @param outliner The outliner state.
+ * @param window The occurrence.
+ * @param binding The binding of the occurrence.
+ * @param function The outlined function.
+ * @param result Canonical number of the variable to assign, or -1.
+ * @return The call statement, or NULL if memory allocation failed.
+ */
+static ast_node_t* create_call(outliner_t* outliner, const outline_window_t* window,
+                               const outline_binding_t* binding, ast_node_t* function,
+                               int32_t result) {
+  const outline_function_t* fn = &outliner->functions[window->function];
+  ast_node_t* block_node = cfg_get_block(fn->cfg, window->block);
+  ast_node_t* first = block_node->data.stmt_block.statements.nodes[window->start];
+  
+  ast_node_t* call = ast_create_node(AST_EXPR_CALL);
+  ast_node_t* instruction = ast_create_instruction("CALL");
+  if (call == NULL || instruction == NULL) {
+    ast_destroy_node(call);
+    ast_destroy_node(instruction);
+    return NULL;
+  }
+  
+  call->location = first->location;
+  instruction->location = first->location;
+  if (!ast_add_node(&instruction->data.stmt_instruction.operands, call)) {
+    ast_destroy_node(call);
+    ast_destroy_node(instruction);
+    return NULL;
+  }
+  
+  call->data.expr_call.function = ast_create_identifier(function->data.function.name);
+  bool success = call->data.expr_call.function != NULL;
+  for (size_t i = 0; i < binding->count && success; i++) {
+    if (!binding->is_param[i]) {
+      continue;
+    }
+    
+    ast_node_t* arg = ast_create_identifier(ir_var_table_name(fn->vars, binding->vars[i]));
+    success = arg != NULL && ast_add_node(&call->data.expr_call.arguments, arg);
+    if (!success) {
+      ast_destroy_node(arg);
+    }
+  }
+  
+  if (!success) {
+    ast_destroy_node(instruction);
+    return NULL;
+  }
+  
+  if (result < 0) {
+    return instruction;
+  }
+  
+  int32_t var = binding->vars[result];
+  ast_node_t* assignment = ast_create_assignment(ir_var_table_name(fn->vars, var), instruction);
+  if (assignment == NULL) {
+    ast_destroy_node(instruction);
+    return NULL;
+  }
+  
+  assignment->location = first->location;
+  assignment->data.stmt_assign.target_type = fn->var_types[var];
+  
+  return assignment;
+}
+
+/**
+ * @brief Record a planned replacement and claim its statements.
+ * 
+ * @param outliner The outliner state.
+ * @param window The occurrence.
+ * @param length The number of statements.
+ * @param replacement The call statement.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool add_site(outliner_t* outliner, const outline_window_t* window, size_t length,
+                     ast_node_t* replacement) {
+  if (outliner->site_count >= outliner->site_capacity) {
+    size_t new_capacity = outliner->site_capacity == 0 ? 16 : outliner->site_capacity * 2;
+    outline_site_t* sites = (outline_site_t*)realloc(outliner->sites,
+                                                     new_capacity * sizeof(outline_site_t));
+    if (sites == NULL) {
+      return false;
+    }
+    
+    outliner->sites = sites;
+    outliner->site_capacity = new_capacity;
+  }
+  
+  outline_site_t* site = &outliner->sites[outliner->site_count++];
+  site->function = window->function;
+  site->block = window->block;
+  site->start = window->start;
+  site->length = length;
+  site->replacement = replacement;
+  
+  size_t base = outliner->functions[window->function].block_base[window->block];
+  for (size_t i = window->start; i < window->start + length; i++) {
+    ir_bitset_set(&outliner->consumed, base + i);
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Check whether any statement of a sequence is already claimed.
+ * 
+ * @param outliner The outliner state.
+ * @param window The sequence.
+ * @param length The number of statements.
+ * @return true if the sequence overlaps an outlined sequence.
+ */
+static bool is_consumed(const outliner_t* outliner, const outline_window_t* window,
+                        size_t length) {
+  size_t base = outliner->functions[window->function].block_base[window->block];
+  for (size_t i = window->start; i < window->start + length; i++) {
+    if (ir_bitset_test(&outliner->consumed, base + i)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Outline a group of equal sequences if that saves space.
+ * 
+ * @param outliner The outliner state.
+ * @param windows The candidate occurrences, in module order.
+ * @param count The number of candidates.
+ * @param length The sequence length.
+ * @param key Scratch key.
+ * @param binding Scratch binding.
+ */
+static void outline_group(outliner_t* outliner, outline_window_t** windows, size_t count,
+                          size_t length, ir_key_t* key, outline_binding_t* binding) {
+  /* Pick non-overlapping occurrences that agree on the value they produce */
+  size_t selected = 0;
+  int32_t result = -1;
+  for (size_t i = 0; i < count && !outliner->failed; i++) {
+    outline_window_t* window = windows[i];
+    if (is_consumed(outliner, window, length)) {
+      continue;
+    }
+    
+    bool overlaps = false;
+    for (size_t j = 0; j < selected && !overlaps; j++) {
+      overlaps = windows[j]->function == window->function &&
+                 windows[j]->block == window->block &&
+                 windows[j]->start + length > window->start;
+    }
+    if (overlaps || !canonicalize(outliner, window->function, window->block,
+                                  window->start, length, key, binding)) {
+      continue;
+    }
+    
+    int32_t live = live_definition(outliner, window->function, window->block,
+                                   window->start + length, binding);
+    if (live == -2 || (live >= 0 && result >= 0 && live != result)) {
+      continue;
+    }
+    if (live >= 0) {
+      result = live;
+    }
+    
+    windows[selected++] = window;
+  }
+  
+  if (selected < 2 || outliner->failed) {
+    return;
+  }
+  
+  /* Cost model over encoded bytes */
+  const outline_window_t* first = windows[0];
+  const outline_function_t* fn = &outliner->functions[first->function];
+  ast_node_t* block_node = cfg_get_block(fn->cfg, first->block);
+  if (!canonicalize(outliner, first->function, first->block, first->start, length,
+                    key, binding)) {
+    return;
+  }
+  
+  size_t sequence_size = 0;
+  for (size_t i = 0; i < length; i++) {
+    sequence_size += stmt_size(outliner, fn,
+                               block_node->data.stmt_block.statements.nodes[first->start + i]);
+  }
+  
+  size_t param_count = 0;
+  for (size_t i = 0; i < binding->count; i++) {
+    param_count += binding->is_param[i] ? 1 : 0;
+  }
+  
+  long call_size = INSTRUCTION_SIZE + 1 + (long)param_count;
+  long function_size = FUNCTION_ENTRY_SIZE + PARAMETER_ENTRY_SIZE * (long)param_count +
+                       (long)sizeof(OUTLINED_PREFIX) + 8 + (long)sequence_size +
+                       INSTRUCTION_SIZE + (result >= 0 ? 1 : 0);
+  long benefit = (long)selected * ((long)sequence_size - call_size) - function_size;
+  ast_node_t* first_stmt = block_node->data.stmt_block.statements.nodes[first->start];
+  if (benefit <= 0) {
+    optimize_remark(outliner->context, HOILC_REMARK_MISSED, fn->function, first_stmt,
+                    "NotProfitable", "%zu copies of a %zu-instruction sequence not outlined: "
+                    "outlining would add %ld bytes", selected, length, -benefit);
+    return;
+  }
+  
+  ast_node_t* function = create_outlined_function(outliner, first, length, binding, result);
+  if (function == NULL) {
+    return;
+  }
+  
+  optimize_remark(outliner->context, HOILC_REMARK_PASSED, fn->function, first_stmt, "Outlined",
+                  "outlined %zu copies of a %zu-instruction sequence into '%s', saving %ld bytes",
+                  selected, length, function->data.function.name, benefit);
+  
+  /* Replace every occurrence with a call */
+  for (size_t i = 0; i < selected && !outliner->failed; i++) {
+    outline_window_t* window = windows[i];
+    if (!canonicalize(outliner, window->function, window->block, window->start, length,
+                      key, binding)) {
+      break;
+    }
+    
+    int32_t live = live_definition(outliner, window->function, window->block,
+                                   window->start + length, binding);
+    ast_node_t* replacement = create_call(outliner, window, binding, function,
+                                          live >= 0 ? result : -1);
+    if (replacement == NULL || !add_site(outliner, window, length, replacement)) {
+      ast_destroy_node(replacement);
+      outliner->failed = true;
+    }
+  }
+}
+
+/**
+ * @brief Compare windows by hash, then by discovery order.
+ * 
+ * @param a The first window.
+ * @param b The second window.
+ * @return Negative, zero or positive like strcmp.
+ */
+static int compare_windows(const void* a, const void* b) {
+  const outline_window_t* wa = (const outline_window_t*)a;
+  const outline_window_t* wb = (const outline_window_t*)b;
+  
+  if (wa->hash != wb->hash) {
+    return wa->hash < wb->hash ? -1 : 1;
+  }
+  return wa->sequence < wb->sequence ? -1 : (wa->sequence > wb->sequence ? 1 : 0);
+}
+
+/**
+ * @brief Find and outline repeated sequences of one length.
+ * 
+ * @param outliner The outliner state.
+ * @param length The sequence length.
+ */
+static void outline_length(outliner_t* outliner, size_t length) {
+  ir_key_t key = { NULL, 0, 0, false };
+  ir_key_t other = { NULL, 0, 0, false };
+  outline_binding_t binding = { NULL, NULL, NULL, 0, 0 };
+  outline_window_t* windows = NULL;
+  outline_window_t** group = NULL;
+  size_t count = 0;
+  size_t capacity = 0;
+  
+  /* Hash every unclaimed run of outlinable statements */
+  for (size_t f = 0; f < outliner->function_count && !outliner->failed; f++) {
+    const outline_function_t* fn = &outliner->functions[f];
+    for (size_t b = 0; b < cfg_block_count(fn->cfg) && !outliner->failed; b++) {
+      size_t run = 0;
+      for (size_t s = 0; s < cfg_statement_count(fn->cfg, b); s++) {
+        size_t id = fn->block_base[b] + s;
+        bool usable = ir_bitset_test(&outliner->eligible, id) &&
+                      !ir_bitset_test(&outliner->consumed, id);
+        run = usable ? run + 1 : 0;
+        if (run < length) {
+          continue;
+        }
+        
+        if (count >= capacity) {
+          size_t new_capacity = capacity == 0 ? 16 : capacity * 2;
+          outline_window_t* new_windows = (outline_window_t*)realloc(
+            windows, new_capacity * sizeof(outline_window_t)
+          );
+          if (new_windows == NULL) {
+            outliner->failed = true;
+            break;
+          }
+          windows = new_windows;
+          capacity = new_capacity;
+        }
+        
+        outline_window_t* window = &windows[count];
+        window->function = f;
+        window->block = b;
+        window->start = s + 1 - length;
+        window->sequence = count;
+        if (!canonicalize(outliner, f, b, window->start, length, &key, &binding)) {
+          break;
+        }
+        window->hash = ir_key_hash(&key);
+        count++;
+      }
+    }
+  }
+  
+  if (count > 1 && !outliner->failed) {
+    qsort(windows, count, sizeof(outline_window_t), compare_windows);
+    group = (outline_window_t**)malloc(count * sizeof(outline_window_t*));
+    outliner->failed = group == NULL;
+  }
+  
+  /* Split each run of equal hashes into groups of equal keys */
+  size_t run_start = 0;
+  while (run_start < count && !outliner->failed) {
+    size_t run_end = run_start + 1;
+    while (run_end < count && windows[run_end].hash == windows[run_start].hash) {
+      run_end++;
+    }
+    
+    for (size_t i = run_start; i < run_end && run_end - run_start > 1 && !outliner->failed; i++) {
+      if (windows[i].sequence == SIZE_MAX ||
+          !canonicalize(outliner, windows[i].function, windows[i].block, windows[i].start,
+                        length, &other, &binding)) {
+        continue;
+      }
+      
+      size_t members = 0;
+      group[members++] = &windows[i];
+      for (size_t j = i + 1; j < run_end && !outliner->failed; j++) {
+        if (windows[j].sequence != SIZE_MAX &&
+            canonicalize(outliner, windows[j].function, windows[j].block, windows[j].start,
+                         length, &key, &binding) &&
+            ir_key_equal(&key, &other)) {
+          group[members++] = &windows[j];
+        }
+      }
+      
+      /* Members are handled whether or not they get outlined */
+      for (size_t j = 0; j < members; j++) {
+        group[j]->sequence = SIZE_MAX;
+      }
+      
+      outline_group(outliner, group, members, length, &key, &binding);
+    }
+    
+    run_start = run_end;
+  }
+  
+  free(group);
+  free(windows);
+  ir_key_free(&key);
+  ir_key_free(&other);
+  free(binding.vars);
+  free(binding.is_param);
+  free(binding.is_defined);
+}
+
+/**
+ * @brief Prepare a function for scanning.
+ * 
+ * Computes liveness, the types of local variables and the outlinable
+ * statements of the function.
+ * 
+ * @param outliner The outliner state.
+ * @param fn The function entry to fill.
+ * @param function The function AST node.
+ * @param statement_count Running module-wide statement count.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool scan_function(outliner_t* outliner, outline_function_t* fn, ast_node_t* function,
+                          size_t* statement_count) {
+  fn->function = function;
+  fn->cfg = cfg_build(function);
+  fn->vars = ir_var_table_create();
+  if (fn->cfg == NULL || fn->vars == NULL) {
+    return false;
+  }
+  
+  /* Parameters are numbered first so their types can be recorded */
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (ir_var_table_intern(fn->vars, param->data.parameter.name) < 0) {
+      return false;
+    }
+  }
+  
+  if (!cfg_compute_liveness(fn->cfg, fn->vars)) {
+    return false;
+  }
+  
+  size_t block_count = cfg_block_count(fn->cfg);
+  fn->var_types = (ast_node_t**)calloc(ir_var_table_count(fn->vars) + 1, sizeof(ast_node_t*));
+  fn->block_base = (size_t*)malloc((block_count + 1) * sizeof(size_t));
+  if (fn->var_types == NULL || fn->block_base == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    fn->var_types[ir_var_table_find(fn->vars, param->data.parameter.name)] =
+      param->data.parameter.type;
+  }
+  
+  /* Assignments to names that are not globals declare locals */
+  for (size_t b = 0; b < block_count; b++) {
+    ast_node_t* block = cfg_get_block(fn->cfg, b);
+    fn->block_base[b] = *statement_count;
+    *statement_count += cfg_statement_count(fn->cfg, b);
+    
+    for (size_t s = 0; s < cfg_statement_count(fn->cfg, b); s++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[s];
+      symbol_kind_t kind;
+      if (stmt->type != AST_STMT_ASSIGN ||
+          find_global(outliner, stmt->data.stmt_assign.target, &kind)) {
+        continue;
+      }
+      
+      int32_t id = ir_var_table_find(fn->vars, stmt->data.stmt_assign.target);
+      if (fn->var_types[id] == NULL) {
+        fn->var_types[id] = stmt->data.stmt_assign.target_type;
+      }
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Compare planned replacements so later statements come first.
+ * 
+ * @param a The first site.
+ * @param b The second site.
+ * @return Negative, zero or positive like strcmp.
+ */
+static int compare_sites(const void* a, const void* b) {
+  const outline_site_t* sa = (const outline_site_t*)a;
+  const outline_site_t* sb = (const outline_site_t*)b;
+  
+  if (sa->function != sb->function) {
+    return sa->function < sb->function ? -1 : 1;
+  }
+  if (sa->block != sb->block) {
+    return sa->block < sb->block ? -1 : 1;
+  }
+  return sa->start > sb->start ? -1 : (sa->start < sb->start ? 1 : 0);
+}
+
+/**
+ * @brief Replace the outlined sequences with their calls.
+ * 
+ * @param outliner The outliner state.
+ */
+static void apply_sites(outliner_t* outliner) {
+  if (outliner->site_count == 0) {
+    return;
+  }
+  
+  qsort(outliner->sites, outliner->site_count, sizeof(outline_site_t), compare_sites);
+  
+  for (size_t i = 0; i < outliner->site_count; i++) {
+    outline_site_t* site = &outliner->sites[i];
+    ast_node_t* block = cfg_get_block(outliner->functions[site->function].cfg, site->block);
+    ast_node_list_t* statements = &block->data.stmt_block.statements;
+    
+    for (size_t j = site->start; j < site->start + site->length; j++) {
+      ast_destroy_node(statements->nodes[j]);
+    }
+    
+    statements->nodes[site->start] = site->replacement;
+    memmove(&statements->nodes[site->start + 1],
+            &statements->nodes[site->start + site->length],
+            (statements->count - site->start - site->length) * sizeof(ast_node_t*));
+    statements->count -= site->length - 1;
+    site->replacement = NULL;
+  }
+}
+
+bool pass_outline(optimize_context_t* context, ast_node_t* module) {
+  assert(context != NULL);
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  
+  outliner_t outliner;
+  memset(&outliner, 0, sizeof(outliner));
+  outliner.context = context;
+  outliner.globals = optimize_get_symbol_table(context);
+  outliner.module = module;
+  
+  /* Only the functions present before outlining, and within the budget, are scanned */
+  size_t declaration_count = module->data.module.declarations.count;
+  outliner.functions = (outline_function_t*)calloc(declaration_count + 1,
+                                                   sizeof(outline_function_t));
+  outliner.failed = outliner.functions == NULL;
+  
+  size_t statement_count = 0;
+  size_t max_vars = 0;
+  for (size_t i = 0; i < declaration_count && !outliner.failed; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    
+    /* Hot functions keep their code, since calls to outlined code would slow them down */
+    if (decl->type != AST_FUNCTION || 
+        (decl->data.function.attributes & FUNCTION_ATTRIBUTE_HOT) != 0 ||
+        !optimize_within_budget(context, decl)) {
+      continue;
+    }
+    
+    outline_function_t* fn = &outliner.functions[outliner.function_count++];
+    outliner.failed = !scan_function(&outliner, fn, decl, &statement_count);
+    if (!outliner.failed && ir_var_table_count(fn->vars) > max_vars) {
+      max_vars = ir_var_table_count(fn->vars);
+    }
+  }
+  
+  outliner.failed = outliner.failed ||
+                    !ir_bitset_init(&outliner.eligible, statement_count) ||
+                    !ir_bitset_init(&outliner.consumed, statement_count) ||
+                    !ir_bitset_init(&outliner.live, max_vars);
+  
+  for (size_t f = 0; f < outliner.function_count && !outliner.failed; f++) {
+    outline_function_t* fn = &outliner.functions[f];
+    for (size_t b = 0; b < cfg_block_count(fn->cfg); b++) {
+      ast_node_t* block = cfg_get_block(fn->cfg, b);
+      for (size_t s = 0; s < cfg_statement_count(fn->cfg, b); s++) {
+        if (is_outlinable(&outliner, fn, block->data.stmt_block.statements.nodes[s])) {
+          ir_bitset_set(&outliner.eligible, fn->block_base[b] + s);
+        }
+      }
+    }
+  }
+  
+  /* Longer sequences save more per occurrence, so they are claimed first */
+  for (size_t length = OUTLINE_MAX_LENGTH; length >= OUTLINE_MIN_LENGTH && !outliner.failed;
+       length--) {
+    outline_length(&outliner, length);
+  }
+  
+  if (!outliner.failed) {
+    apply_sites(&outliner);
+  }
+  
+  for (size_t i = 0; i < outliner.site_count; i++) {
+    ast_destroy_node(outliner.sites[i].replacement);
+  }
+  free(outliner.sites);
+  
+  for (size_t i = 0; i < outliner.function_count; i++) {
+    cfg_destroy(outliner.functions[i].cfg);
+    ir_var_table_destroy(outliner.functions[i].vars);
+    free(outliner.functions[i].var_types);
+    free(outliner.functions[i].block_base);
+  }
+  free(outliner.functions);
+  ir_bitset_free(&outliner.eligible);
+  ir_bitset_free(&outliner.consumed);
+  ir_bitset_free(&outliner.live);
+  
+  if (outliner.failed) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL, module,
+                         "Memory allocation failed");
+    return false;
+  }
+  
+  return true;
+}
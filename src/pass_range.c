@@ -0,0 +1,990 @@
+/**
+ * @file pass_range.c
+ * @brief Value range propagation.
+ * 
+ * This file contains a pass that walks the dominator tree of each function
+ * collecting the comparisons known to hold, from branch conditions on the
+ * dominating edges and from the values of definitions, and folds the
+ * comparisons and branches whose outcome they decide.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/cfg.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Maximum number of facts tracked at any program point.
+ */
+#define RANGE_MAX_FACTS 64
+
+/**
+ * @brief Operand of a fact: a variable or a constant.
+ */
+typedef struct {
+  int32_t var;              /**< Variable number, or -1 for a constant. */
+  int64_t value;            /**< Constant value. */
+} range_term_t;
+
+/**
+ * @brief Comparison known to hold: lhs opcode rhs.
+ */
+typedef struct {
+  range_term_t lhs;         /**< Left operand, always a variable. */
+  range_term_t rhs;         /**< Right operand. */
+  uint8_t opcode;           /**< Comparison opcode. */
+} range_fact_t;
+
+/**
+ * @brief Set of facts holding at a program point.
+ */
+typedef struct {
+  range_fact_t facts[RANGE_MAX_FACTS]; /**< The facts, oldest first. */
+  size_t count;             /**< Number of facts. */
+} range_state_t;
+
+/**
+ * @brief Closed interval of values.
+ */
+typedef struct {
+  int64_t low;              /**< Lowest value. */
+  int64_t high;             /**< Highest value. */
+} range_interval_t;
+
+/**
+ * @brief Dominator tree walk frame.
+ */
+typedef struct {
+  size_t block;             /**< Block number. */
+  size_t next_child;        /**< Next child to visit. */
+  range_state_t* state;     /**< Facts holding at the end of the block. */
+} range_frame_t;
+
+/**
+ * @brief Range propagation state for one function.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  symbol_table_t* globals;  /**< Global symbol table. */
+  ast_node_t* function;     /**< Function AST node. */
+  cfg_t* cfg;               /**< Control flow graph with dominators. */
+  ir_var_table_t* vars;     /**< Parameters and locals. */
+  const ast_node_t** types; /**< Type of each variable, or NULL if it is not tracked. */
+  size_t* def_start;        /**< Offsets into def_blocks per variable. */
+  size_t* def_blocks;       /**< Blocks defining each variable. */
+  size_t* child_start;      /**< Offsets into children per block. */
+  size_t* children;         /**< Dominator tree children. */
+  bool folded_branch;       /**< Whether a branch became unconditional. */
+} range_t;
+
+/**
+ * @brief Swap the operands of a comparison opcode.
+ * 
+ * @param opcode The comparison opcode.
+ * @return The opcode comparing the operands in the other order.
+ */
+static uint8_t swap_comparison(uint8_t opcode) {
+  switch (opcode) {
+    case OPCODE_CMP_LT: return OPCODE_CMP_GT;
+    case OPCODE_CMP_LE: return OPCODE_CMP_GE;
+    case OPCODE_CMP_GT: return OPCODE_CMP_LT;
+    case OPCODE_CMP_GE: return OPCODE_CMP_LE;
+    default: return opcode;
+  }
+}
+
+/**
+ * @brief Negate a comparison opcode.
+ * 
+ * @param opcode The comparison opcode.
+ * @return The opcode that is true exactly when the comparison is false.
+ */
+static uint8_t negate_comparison(uint8_t opcode) {
+  switch (opcode) {
+    case OPCODE_CMP_EQ: return OPCODE_CMP_NE;
+    case OPCODE_CMP_NE: return OPCODE_CMP_EQ;
+    case OPCODE_CMP_LT: return OPCODE_CMP_GE;
+    case OPCODE_CMP_LE: return OPCODE_CMP_GT;
+    case OPCODE_CMP_GT: return OPCODE_CMP_LE;
+    case OPCODE_CMP_GE: return OPCODE_CMP_LT;
+    default: return 0;
+  }
+}
+
+/**
+ * @brief Decide a comparison from a known comparison of the same operands.
+ * 
+ * @param known The comparison known to hold.
+ * @param query The comparison to decide.
+ * @param result Where to store the outcome.
+ * @return true if the known comparison decides the query.
+ */
+static bool implies(uint8_t known, uint8_t query, bool* result) {
+  if (known == query) {
+    *result = true;
+    return true;
+  }
+  if (negate_comparison(known) == query) {
+    *result = false;
+    return true;
+  }
+  
+  switch (known) {
+    case OPCODE_CMP_LT:
+    case OPCODE_CMP_GT:
+      /* Strict orders also settle equality and the other non-strict order */
+      if (query == OPCODE_CMP_NE || query == OPCODE_CMP_EQ) {
+        *result = query == OPCODE_CMP_NE;
+        return true;
+      }
+      *result = known == OPCODE_CMP_LT ? query == OPCODE_CMP_LE : query == OPCODE_CMP_GE;
+      return true;
+    
+    case OPCODE_CMP_EQ:
+      *result = query == OPCODE_CMP_LE || query == OPCODE_CMP_GE;
+      return true;
+    
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Check whether two terms denote the same value.
+ * 
+ * @param a The first term.
+ * @param b The second term.
+ * @return true if both name the same variable or the same constant.
+ */
+static bool same_term(const range_term_t* a, const range_term_t* b) {
+  return a->var == b->var && (a->var >= 0 || a->value == b->value);
+}
+
+/**
+ * @brief Check whether the values of a type are ordered as signed 64-bit values.
+ * 
+ * Unsigned 64-bit values above INT64_MAX are held as negative numbers, so
+ * the intervals cannot describe them.
+ * 
+ * @param type The type node (can be NULL).
+ * @return true for integer and boolean types other than unsigned 64-bit.
+ */
+static bool has_signed_order(const ast_node_t* type) {
+  uint8_t bits;
+  bool is_signed;
+  return ir_integer_type(type, &bits, &is_signed) && (is_signed || bits < 64);
+}
+
+/**
+ * @brief Describe an operand as a term.
+ * 
+ * @param rng The range propagation state.
+ * @param operand The operand expression.
+ * @param term Where to store the term.
+ * @return true if the operand is a tracked local variable or an integer literal.
+ */
+static bool get_term(const range_t* rng, const ast_node_t* operand, range_term_t* term) {
+  term->var = -1;
+  term->value = 0;
+  if (operand->type == AST_EXPR_INTEGER) {
+    term->value = operand->data.expr_integer.value;
+    return true;
+  }
+  if (operand->type == AST_EXPR_IDENTIFIER) {
+    term->var = ir_var_table_find(rng->vars, operand->data.expr_identifier.name);
+    return term->var >= 0 && rng->types[term->var] != NULL;
+  }
+  return false;
+}
+
+/**
+ * @brief Describe the operands of a comparison as terms.
+ * 
+ * A literal compared with a variable is converted to the type of the
+ * variable, as the comparison does.
+ * 
+ * @param rng The range propagation state.
+ * @param instruction The comparison instruction.
+ * @param terms Where to store the two terms.
+ * @return true if both operands are tracked variables or integer literals.
+ */
+static bool get_comparison_terms(const range_t* rng, const ast_node_t* instruction,
+                                 range_term_t* terms) {
+  const ast_node_list_t* operands = &instruction->data.stmt_instruction.operands;
+  if (operands->count != 2 || !get_term(rng, operands->nodes[0], &terms[0]) ||
+      !get_term(rng, operands->nodes[1], &terms[1])) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < 2; i++) {
+    const range_term_t* other = &terms[1 - i];
+    if (terms[i].var < 0 && other->var >= 0 &&
+        !ir_integer_literal(rng->types[other->var], terms[i].value, &terms[i].value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Record a fact, dropping the oldest one when the set is full.
+ * 
+ * Facts are kept with a variable on the left.
+ * 
+ * @param state The fact set.
+ * @param lhs The left operand.
+ * @param opcode The comparison opcode.
+ * @param rhs The right operand.
+ */
+static void add_fact(range_state_t* state, range_term_t lhs, uint8_t opcode, range_term_t rhs) {
+  if (lhs.var < 0) {
+    range_term_t swap = lhs;
+    lhs = rhs;
+    rhs = swap;
+    opcode = swap_comparison(opcode);
+  }
+  if (lhs.var < 0) {
+    return;
+  }
+  
+  if (state->count == RANGE_MAX_FACTS) {
+    memmove(&state->facts[0], &state->facts[1], (RANGE_MAX_FACTS - 1) * sizeof(range_fact_t));
+    state->count--;
+  }
+  range_fact_t* fact = &state->facts[state->count++];
+  fact->lhs = lhs;
+  fact->rhs = rhs;
+  fact->opcode = opcode;
+}
+
+/**
+ * @brief Forget the facts that mention a variable.
+ * 
+ * @param state The fact set.
+ * @param var The variable number.
+ */
+static void kill_var(range_state_t* state, int32_t var) {
+  size_t kept = 0;
+  for (size_t i = 0; i < state->count; i++) {
+    if (state->facts[i].lhs.var != var && state->facts[i].rhs.var != var) {
+      state->facts[kept++] = state->facts[i];
+    }
+  }
+  state->count = kept;
+}
+
+/**
+ * @brief Compute the interval of a term from the facts on it.
+ * 
+ * @param state The fact set.
+ * @param term The term.
+ * @return The interval; the full range when nothing is known.
+ */
+static range_interval_t get_interval(const range_state_t* state, const range_term_t* term) {
+  range_interval_t interval = { INT64_MIN, INT64_MAX };
+  if (term->var < 0) {
+    interval.low = term->value;
+    interval.high = term->value;
+    return interval;
+  }
+  
+  for (size_t i = 0; i < state->count; i++) {
+    const range_fact_t* fact = &state->facts[i];
+    if (fact->lhs.var != term->var || fact->rhs.var >= 0) {
+      continue;
+    }
+    
+    int64_t value = fact->rhs.value;
+    switch (fact->opcode) {
+      case OPCODE_CMP_LT:
+        if (value != INT64_MIN && value - 1 < interval.high) {
+          interval.high = value - 1;
+        }
+        break;
+      case OPCODE_CMP_LE:
+        if (value < interval.high) {
+          interval.high = value;
+        }
+        break;
+      case OPCODE_CMP_GT:
+        if (value != INT64_MAX && value + 1 > interval.low) {
+          interval.low = value + 1;
+        }
+        break;
+      case OPCODE_CMP_GE:
+        if (value > interval.low) {
+          interval.low = value;
+        }
+        break;
+      case OPCODE_CMP_EQ:
+        if (value > interval.low) {
+          interval.low = value;
+        }
+        if (value < interval.high) {
+          interval.high = value;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  
+  /* Exclusions at the ends narrow the interval */
+  for (size_t i = 0; i < state->count; i++) {
+    const range_fact_t* fact = &state->facts[i];
+    if (fact->lhs.var == term->var && fact->rhs.var < 0 && fact->opcode == OPCODE_CMP_NE) {
+      if (fact->rhs.value == interval.low && interval.low < interval.high) {
+        interval.low++;
+      } else if (fact->rhs.value == interval.high && interval.low < interval.high) {
+        interval.high--;
+      }
+    }
+  }
+  
+  return interval;
+}
+
+/**
+ * @brief Decide a comparison from intervals.
+ * 
+ * @param opcode The comparison opcode.
+ * @param a The interval of the left operand.
+ * @param b The interval of the right operand.
+ * @param result Where to store the outcome.
+ * @return true if the intervals decide the comparison.
+ */
+static bool compare_intervals(uint8_t opcode, range_interval_t a, range_interval_t b,
+                              bool* result) {
+  switch (opcode) {
+    case OPCODE_CMP_LT:
+      if (a.high < b.low || a.low >= b.high) {
+        *result = a.high < b.low;
+        return true;
+      }
+      return false;
+    
+    case OPCODE_CMP_LE:
+      if (a.high <= b.low || a.low > b.high) {
+        *result = a.high <= b.low;
+        return true;
+      }
+      return false;
+    
+    case OPCODE_CMP_GT:
+    case OPCODE_CMP_GE:
+      return compare_intervals(swap_comparison(opcode), b, a, result);
+    
+    case OPCODE_CMP_EQ:
+    case OPCODE_CMP_NE:
+      if (a.high < b.low || b.high < a.low) {
+        *result = opcode == OPCODE_CMP_NE;
+        return true;
+      }
+      if (a.low == a.high && b.low == b.high) {
+        *result = opcode == OPCODE_CMP_EQ;
+        return true;
+      }
+      return false;
+    
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Decide a comparison from the facts holding at a point.
+ * 
+ * @param state The fact set.
+ * @param lhs The left operand.
+ * @param opcode The comparison opcode.
+ * @param rhs The right operand.
+ * @param result Where to store the outcome.
+ * @return true if the outcome is known.
+ */
+static bool decide(const range_state_t* state, const range_term_t* lhs, uint8_t opcode,
+                   const range_term_t* rhs, bool* result) {
+  if (same_term(lhs, rhs)) {
+    *result = opcode == OPCODE_CMP_EQ || opcode == OPCODE_CMP_LE || opcode == OPCODE_CMP_GE;
+    return true;
+  }
+  
+  /* A fact on the same operands, in either order */
+  for (size_t i = state->count; i-- > 0;) {
+    const range_fact_t* fact = &state->facts[i];
+    if (same_term(&fact->lhs, lhs) && same_term(&fact->rhs, rhs) &&
+        implies(fact->opcode, opcode, result)) {
+      return true;
+    }
+    if (same_term(&fact->lhs, rhs) && same_term(&fact->rhs, lhs) &&
+        implies(swap_comparison(fact->opcode), opcode, result)) {
+      return true;
+    }
+  }
+  
+  return compare_intervals(opcode, get_interval(state, lhs), get_interval(state, rhs), result);
+}
+
+/**
+ * @brief Replace the value of an assignment with a move of a constant.
+ * 
+ * @param assign The assignment statement.
+ * @param value The constant.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool assign_constant(ast_node_t* assign, int64_t value) {
+  ast_node_t* instruction = ast_create_instruction("ADD");
+  ast_node_t* lhs = ast_create_integer(value);
+  ast_node_t* rhs = ast_create_integer(0);
+  bool success = instruction != NULL && lhs != NULL && rhs != NULL &&
+                 ast_add_node(&instruction->data.stmt_instruction.operands, lhs);
+  if (!success) {
+    ast_destroy_node(lhs);
+  }
+  success = success && ast_add_node(&instruction->data.stmt_instruction.operands, rhs);
+  if (!success) {
+    ast_destroy_node(rhs);
+    ast_destroy_node(instruction);
+    return false;
+  }
+  
+  instruction->location = assign->data.stmt_assign.value->location;
+  ast_destroy_node(assign->data.stmt_assign.value);
+  assign->data.stmt_assign.value = instruction;
+  return true;
+}
+
+/**
+ * @brief Add the interval a definition gives its variable.
+ * 
+ * @param state The fact set, with the old facts on the variable removed.
+ * @param var The defined variable.
+ * @param interval The interval of the new value.
+ */
+static void add_interval(range_state_t* state, int32_t var, range_interval_t interval) {
+  range_term_t lhs = { var, 0 };
+  range_term_t low = { -1, interval.low };
+  range_term_t high = { -1, interval.high };
+  if (interval.low == interval.high) {
+    add_fact(state, lhs, OPCODE_CMP_EQ, low);
+    return;
+  }
+  if (interval.low != INT64_MIN) {
+    add_fact(state, lhs, OPCODE_CMP_GE, low);
+  }
+  if (interval.high != INT64_MAX) {
+    add_fact(state, lhs, OPCODE_CMP_LE, high);
+  }
+}
+
+/**
+ * @brief Compute the interval of the value an instruction produces.
+ * 
+ * @param state The facts holding before the instruction.
+ * @param rng The range propagation state.
+ * @param stmt The assignment.
+ * @param interval Where to store the interval.
+ * @return true if something is known about the value.
+ */
+static bool definition_interval(const range_state_t* state, const range_t* rng,
+                                ast_node_t* stmt, range_interval_t* interval) {
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  const ast_node_t* type = stmt->data.stmt_assign.target_type;
+  uint8_t opcode = ir_get_opcode(stmt);
+  if (instruction == NULL || instruction->data.stmt_instruction.operands.count != 2) {
+    return false;
+  }
+  
+  /* Comparisons produce booleans */
+  if (negate_comparison(opcode) != 0) {
+    interval->low = 0;
+    interval->high = 1;
+    return true;
+  }
+  
+  range_term_t terms[2];
+  range_interval_t operands[2];
+  for (size_t i = 0; i < 2; i++) {
+    if (!get_term(rng, instruction->data.stmt_instruction.operands.nodes[i], &terms[i])) {
+      return false;
+    }
+    operands[i] = get_interval(state, &terms[i]);
+  }
+  
+  int64_t low, high;
+  switch (opcode) {
+    case OPCODE_ADD:
+    case OPCODE_SUB:
+      /* Both operands bounded well inside the 64-bit range */
+      for (size_t i = 0; i < 2; i++) {
+        if (operands[i].low < INT64_MIN / 4 || operands[i].high > INT64_MAX / 4) {
+          return false;
+        }
+      }
+      if (opcode == OPCODE_ADD) {
+        low = operands[0].low + operands[1].low;
+        high = operands[0].high + operands[1].high;
+      } else {
+        low = operands[0].low - operands[1].high;
+        high = operands[0].high - operands[1].low;
+      }
+      break;
+    
+    case OPCODE_AND:
+      /* Masking with a non-negative value bounds the result */
+      if (operands[1].low >= 0 && operands[1].low == operands[1].high) {
+        low = 0;
+        high = operands[1].high;
+      } else if (operands[0].low >= 0 && operands[0].low == operands[0].high) {
+        low = 0;
+        high = operands[0].high;
+      } else {
+        return false;
+      }
+      break;
+    
+    case OPCODE_REM:
+      /* The remainder takes the sign of the dividend */
+      if (operands[1].low <= 0 || operands[1].low != operands[1].high ||
+          operands[1].high == INT64_MIN) {
+        return false;
+      }
+      low = operands[0].low >= 0 ? 0 : -(operands[1].high - 1);
+      high = operands[1].high - 1;
+      break;
+    
+    default:
+      return false;
+  }
+  
+  /* The interval holds only if no value wraps in the target type */
+  int64_t converted;
+  if (!ir_convert_integer(type, low, &converted) || converted != low ||
+      !ir_convert_integer(type, high, &converted) || converted != high) {
+    return false;
+  }
+  
+  interval->low = low;
+  interval->high = high;
+  return true;
+}
+
+/**
+ * @brief Fold the comparisons of a block and update the facts through it.
+ * 
+ * @param rng The range propagation state.
+ * @param block The block number.
+ * @param state The facts holding on entry, updated to those at the end.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool visit_block(range_t* rng, size_t block, range_state_t* state) {
+  ast_node_list_t* statements = &cfg_get_block(rng->cfg, block)->data.stmt_block.statements;
+  size_t length = cfg_statement_count(rng->cfg, block);
+  
+  for (size_t i = 0; i < length; i++) {
+    ast_node_t* stmt = statements->nodes[i];
+    const char* def = ir_get_def(stmt);
+    ast_node_t* instruction = ir_get_instruction(stmt);
+    uint8_t opcode = ir_get_opcode(stmt);
+    int32_t var = def != NULL ? ir_var_table_find(rng->vars, def) : -1;
+    
+    /* Comparisons decided by the facts become constants */
+    range_term_t terms[2];
+    bool known = false;
+    bool result = false;
+    if (var >= 0 && instruction != NULL && negate_comparison(opcode) != 0 &&
+        get_comparison_terms(rng, instruction, terms)) {
+      known = decide(state, &terms[0], opcode, &terms[1], &result);
+      if (known) {
+        optimize_remark(rng->context, HOILC_REMARK_PASSED, rng->function, stmt,
+                        "FoldedComparison", "comparison '%s' is always %s", def,
+                        result ? "true" : "false");
+        if (!assign_constant(stmt, result ? 1 : 0)) {
+          return false;
+        }
+      }
+    }
+    
+    if (var < 0 || rng->types[var] == NULL) {
+      continue;
+    }
+    
+    range_interval_t interval = { result ? 1 : 0, result ? 1 : 0 };
+    bool has_interval = known || definition_interval(state, rng, stmt, &interval);
+    if (has_interval && !known && negate_comparison(opcode) == 0) {
+      optimize_remark(rng->context, HOILC_REMARK_ANALYSIS, rng->function, stmt, "Interval",
+                      "'%s' is in [%lld, %lld]", def, (long long)interval.low,
+                      (long long)interval.high);
+    }
+    kill_var(state, var);
+    if (has_interval) {
+      add_interval(state, var, interval);
+    }
+  }
+  
+  /* Branches on decided conditions become unconditional */
+  ast_node_t* branch = length > 0 ? statements->nodes[length - 1] : NULL;
+  range_term_t cond;
+  if (branch == NULL || branch->type != AST_STMT_BRANCH ||
+      branch->data.stmt_branch.condition == NULL ||
+      branch->data.stmt_branch.false_target == NULL ||
+      !get_term(rng, branch->data.stmt_branch.condition, &cond)) {
+    return true;
+  }
+  
+  range_term_t zero = { -1, 0 };
+  bool taken;
+  if (decide(state, &cond, OPCODE_CMP_NE, &zero, &taken)) {
+    optimize_remark(rng->context, HOILC_REMARK_PASSED, rng->function, branch, "FoldedBranch",
+                    "branch always goes to '%s'", taken ? branch->data.stmt_branch.true_target :
+                    branch->data.stmt_branch.false_target);
+    if (taken) {
+      free(branch->data.stmt_branch.false_target);
+    } else {
+      free(branch->data.stmt_branch.true_target);
+      branch->data.stmt_branch.true_target = branch->data.stmt_branch.false_target;
+    }
+    branch->data.stmt_branch.false_target = NULL;
+    ast_destroy_node(branch->data.stmt_branch.condition);
+    branch->data.stmt_branch.condition = NULL;
+    rng->folded_branch = true;
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Add the facts a conditional branch establishes on one of its edges.
+ * 
+ * The condition holds on the true edge and fails on the false edge. When it
+ * was computed by a comparison in the same block whose operands were not
+ * reassigned before the branch, the comparison holds or fails as well.
+ * 
+ * @param rng The range propagation state.
+ * @param block The branching block.
+ * @param taken Whether the edge is the true edge.
+ * @param state The fact set to extend.
+ */
+static void add_edge_facts(const range_t* rng, size_t block, bool taken, range_state_t* state) {
+  ast_node_list_t* statements = &cfg_get_block(rng->cfg, block)->data.stmt_block.statements;
+  size_t length = cfg_statement_count(rng->cfg, block);
+  ast_node_t* branch = statements->nodes[length - 1];
+  
+  range_term_t cond;
+  if (!get_term(rng, branch->data.stmt_branch.condition, &cond) || cond.var < 0) {
+    return;
+  }
+  
+  range_term_t zero = { -1, 0 };
+  add_fact(state, cond, taken ? OPCODE_CMP_NE : OPCODE_CMP_EQ, zero);
+  
+  /* Find the comparison that defined the condition */
+  const char* name = branch->data.stmt_branch.condition->data.expr_identifier.name;
+  for (size_t i = length - 1; i-- > 0;) {
+    ast_node_t* stmt = statements->nodes[i];
+    const char* def = ir_get_def(stmt);
+    if (def == NULL) {
+      continue;
+    }
+    
+    ast_node_t* instruction = ir_get_instruction(stmt);
+    uint8_t opcode = ir_get_opcode(stmt);
+    range_term_t terms[2];
+    if (strcmp(def, name) != 0 || instruction == NULL || negate_comparison(opcode) == 0 ||
+        !get_comparison_terms(rng, instruction, terms) ||
+        terms[0].var == cond.var || terms[1].var == cond.var) {
+      return;
+    }
+    
+    /* The operands must keep their values up to the branch */
+    for (size_t j = i + 1; j < length - 1; j++) {
+      const char* later = ir_get_def(statements->nodes[j]);
+      int32_t id = later != NULL ? ir_var_table_find(rng->vars, later) : -1;
+      if (id >= 0 && (id == terms[0].var || id == terms[1].var)) {
+        return;
+      }
+    }
+    
+    add_fact(state, terms[0], taken ? opcode : negate_comparison(opcode), terms[1]);
+    return;
+  }
+}
+
+/**
+ * @brief Build the entry facts of a dominator tree child.
+ * 
+ * Facts at the end of the parent survive unless a block strictly dominated
+ * by the parent can reassign one of their variables on the way. When the
+ * parent is the only predecessor, its branch adds the facts of the edge.
+ * 
+ * @param rng The range propagation state.
+ * @param parent The parent block.
+ * @param parent_state The facts at the end of the parent.
+ * @param child The child block.
+ * @param state Where to store the entry facts of the child.
+ */
+static void enter_child(const range_t* rng, size_t parent, const range_state_t* parent_state,
+                        size_t child, range_state_t* state) {
+  state->count = 0;
+  for (size_t i = 0; i < parent_state->count; i++) {
+    const range_fact_t* fact = &parent_state->facts[i];
+    bool killed = false;
+    int32_t vars[2] = { fact->lhs.var, fact->rhs.var };
+    for (size_t v = 0; v < 2 && !killed; v++) {
+      if (vars[v] < 0) {
+        continue;
+      }
+      for (size_t d = rng->def_start[vars[v]]; d < rng->def_start[vars[v] + 1] && !killed; d++) {
+        size_t def_block = rng->def_blocks[d];
+        killed = def_block != parent && cfg_dominates(rng->cfg, parent, def_block);
+      }
+    }
+    if (!killed) {
+      state->facts[state->count++] = *fact;
+    }
+  }
+  
+  if (cfg_predecessor_count(rng->cfg, child) != 1 || cfg_successor_count(rng->cfg, parent) != 2) {
+    return;
+  }
+  
+  ast_node_list_t* statements = &cfg_get_block(rng->cfg, parent)->data.stmt_block.statements;
+  ast_node_t* branch = statements->nodes[cfg_statement_count(rng->cfg, parent) - 1];
+  if (branch->type != AST_STMT_BRANCH || branch->data.stmt_branch.condition == NULL) {
+    return;
+  }
+  add_edge_facts(rng, parent, cfg_find_block(rng->cfg, branch->data.stmt_branch.true_target) ==
+                              (int32_t)child, state);
+}
+
+/**
+ * @brief Number the variables and index their defining blocks.
+ * 
+ * A variable takes the type of its parameter or first definition, and is
+ * tracked only if that type is ordered as signed 64-bit values.
+ * 
+ * @param rng The range propagation state.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool index_definitions(range_t* rng) {
+  ast_node_t* function = rng->function;
+  size_t block_count = cfg_block_count(rng->cfg);
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (ir_var_table_intern(rng->vars, param->data.parameter.name) < 0) {
+      return false;
+    }
+  }
+  
+  size_t def_count = 0;
+  for (size_t i = 0; i < block_count; i++) {
+    ast_node_list_t* statements = &cfg_get_block(rng->cfg, i)->data.stmt_block.statements;
+    for (size_t j = 0; j < cfg_statement_count(rng->cfg, i); j++) {
+      const char* def = ir_get_def(statements->nodes[j]);
+      if (def == NULL) {
+        continue;
+      }
+      
+      /* Calls and stores can change globals, so only locals are tracked */
+      if (symtable_lookup(rng->globals, def, false) == NULL &&
+          ir_var_table_intern(rng->vars, def) < 0) {
+        return false;
+      }
+      def_count++;
+    }
+  }
+  
+  size_t var_count = ir_var_table_count(rng->vars);
+  rng->def_start = (size_t*)calloc(var_count + 2, sizeof(size_t));
+  rng->def_blocks = (size_t*)malloc((def_count + 1) * sizeof(size_t));
+  rng->child_start = (size_t*)calloc(block_count + 2, sizeof(size_t));
+  rng->children = (size_t*)malloc((block_count + 1) * sizeof(size_t));
+  rng->types = (const ast_node_t**)calloc(var_count + 1, sizeof(ast_node_t*));
+  size_t* fill = (size_t*)malloc((var_count + block_count + 1) * sizeof(size_t));
+  if (rng->def_start == NULL || rng->def_blocks == NULL || rng->child_start == NULL ||
+      rng->children == NULL || rng->types == NULL || fill == NULL) {
+    free(fill);
+    return false;
+  }
+  
+  /* Types and defining blocks per variable */
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    rng->types[i] = function->data.function.parameters.nodes[i]->data.parameter.type;
+  }
+  for (size_t i = 0; i < block_count; i++) {
+    ast_node_list_t* statements = &cfg_get_block(rng->cfg, i)->data.stmt_block.statements;
+    for (size_t j = 0; j < cfg_statement_count(rng->cfg, i); j++) {
+      ast_node_t* stmt = statements->nodes[j];
+      const char* def = ir_get_def(stmt);
+      int32_t id = def != NULL ? ir_var_table_find(rng->vars, def) : -1;
+      if (id >= 0) {
+        rng->def_start[id + 1]++;
+        if (rng->types[id] == NULL && stmt->type == AST_STMT_ASSIGN) {
+          rng->types[id] = stmt->data.stmt_assign.target_type;
+        }
+      }
+    }
+  }
+  for (size_t v = 0; v < var_count; v++) {
+    if (!has_signed_order(rng->types[v])) {
+      rng->types[v] = NULL;
+    }
+  }
+  for (size_t v = 0; v < var_count; v++) {
+    rng->def_start[v + 1] += rng->def_start[v];
+    fill[v] = rng->def_start[v];
+  }
+  for (size_t i = 0; i < block_count; i++) {
+    ast_node_list_t* statements = &cfg_get_block(rng->cfg, i)->data.stmt_block.statements;
+    for (size_t j = 0; j < cfg_statement_count(rng->cfg, i); j++) {
+      const char* def = ir_get_def(statements->nodes[j]);
+      int32_t id = def != NULL ? ir_var_table_find(rng->vars, def) : -1;
+      if (id >= 0) {
+        rng->def_blocks[fill[id]++] = i;
+      }
+    }
+  }
+  
+  /* Dominator tree children per block */
+  for (size_t i = 0; i < block_count; i++) {
+    int32_t idom = cfg_immediate_dominator(rng->cfg, i);
+    if (idom >= 0) {
+      rng->child_start[idom + 1]++;
+    }
+  }
+  for (size_t i = 0; i < block_count; i++) {
+    rng->child_start[i + 1] += rng->child_start[i];
+    fill[i] = rng->child_start[i];
+  }
+  for (size_t i = 0; i < block_count; i++) {
+    int32_t idom = cfg_immediate_dominator(rng->cfg, i);
+    if (idom >= 0) {
+      rng->children[fill[idom]++] = i;
+    }
+  }
+  
+  free(fill);
+  return true;
+}
+
+/**
+ * @brief Walk the dominator tree, folding comparisons and branches.
+ * 
+ * @param rng The range propagation state.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool walk_dominator_tree(range_t* rng) {
+  size_t block_count = cfg_block_count(rng->cfg);
+  range_frame_t* stack = (range_frame_t*)malloc((block_count + 1) * sizeof(range_frame_t));
+  if (stack == NULL) {
+    return false;
+  }
+  
+  size_t top = 0;
+  bool success = true;
+  if (block_count > 0) {
+    stack[0].block = 0;
+    stack[0].next_child = rng->child_start[0];
+    stack[0].state = (range_state_t*)calloc(1, sizeof(range_state_t));
+    success = stack[0].state != NULL && visit_block(rng, 0, stack[0].state);
+    top = stack[0].state != NULL ? 1 : 0;
+  }
+  
+  while (top > 0 && success) {
+    range_frame_t* frame = &stack[top - 1];
+    if (frame->next_child == rng->child_start[frame->block + 1]) {
+      free(frame->state);
+      top--;
+      continue;
+    }
+    
+    size_t child = rng->children[frame->next_child++];
+    range_state_t* state = (range_state_t*)malloc(sizeof(range_state_t));
+    if (state == NULL) {
+      success = false;
+      break;
+    }
+    
+    enter_child(rng, frame->block, frame->state, child, state);
+    stack[top].block = child;
+    stack[top].next_child = rng->child_start[child];
+    stack[top].state = state;
+    top++;
+    success = visit_block(rng, child, state);
+  }
+  
+  while (top > 0) {
+    free(stack[--top].state);
+  }
+  free(stack);
+  return success;
+}
+
+/**
+ * @brief Remove the blocks that cannot be reached from the entry block.
+ * 
+ * @param function The function AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool remove_unreachable_blocks(ast_node_t* function) {
+  cfg_t* cfg = cfg_build(function);
+  if (cfg == NULL || !cfg_compute_dominators(cfg)) {
+    cfg_destroy(cfg);
+    return false;
+  }
+  
+  ast_node_list_t* blocks = &function->data.function.blocks;
+  size_t kept = 0;
+  for (size_t i = 0; i < blocks->count; i++) {
+    if (cfg_is_reachable(cfg, i)) {
+      blocks->nodes[kept++] = blocks->nodes[i];
+    } else {
+      ast_destroy_node(blocks->nodes[i]);
+    }
+  }
+  blocks->count = kept;
+  
+  cfg_destroy(cfg);
+  return true;
+}
+
+bool pass_range(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  range_t rng;
+  memset(&rng, 0, sizeof(rng));
+  rng.context = context;
+  rng.globals = optimize_get_symbol_table(context);
+  rng.function = function;
+  rng.cfg = cfg_build(function);
+  rng.vars = ir_var_table_create();
+  
+  bool success = rng.cfg != NULL && rng.vars != NULL && cfg_compute_dominators(rng.cfg) &&
+                 index_definitions(&rng) && walk_dominator_tree(&rng);
+  
+  cfg_destroy(rng.cfg);
+  ir_var_table_destroy(rng.vars);
+  free(rng.types);
+  free(rng.def_start);
+  free(rng.def_blocks);
+  free(rng.child_start);
+  free(rng.children);
+  
+  if (success && rng.folded_branch) {
+    success = remove_unreachable_blocks(function);
+  }
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL,
+                         function, "Memory allocation failed");
+  }
+  
+  return success;
+}
@@ -0,0 +1,740 @@
+/**
+ * @file pass_schedule.c
+ * @brief Latency-aware list scheduling of basic blocks.
+ * 
+ * This file contains the instruction scheduler. Each block is turned into a
+ * dependency graph over register (RAW/WAR/WAW) and memory dependences, and
+ * instructions are reordered by latency-weighted critical path so that long
+ * operations such as DIV, REM, LOAD and CALL are separated from their uses.
+ * Calls only order memory accesses as far as the effects of their callee do,
+ * and loads and stores the alias analysis tells apart may pass each other.
+ * Globals may be reached through pointers, so reading or writing one counts
+ * as a memory access.
+ * Functions over the optimization budget are scheduled in fixed windows of
+ * statements, bounding the quadratic graph construction.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/ir.h"
+#include "../include/alias.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Statements scheduled together when the pass is degraded.
+ */
+#define SCHEDULE_DEGRADED_WINDOW 64
+
+/**
+ * @brief Dependency edge.
+ */
+typedef struct {
+  size_t from;             /**< Node that must issue first. */
+  size_t to;               /**< Dependent node. */
+  uint32_t latency;        /**< Minimum cycles between the two issues. */
+  bool is_data;            /**< Whether the edge carries a register value. */
+} sched_edge_t;
+
+/**
+ * @brief Scheduling node, one per instruction of the block.
+ */
+typedef struct {
+  ast_node_t* stmt;        /**< The statement. */
+  uint32_t latency;        /**< Result latency. */
+  uint32_t height;         /**< Latency-weighted path length to the block end. */
+  uint32_t earliest;       /**< Earliest cycle at which the node may issue. */
+  size_t pred_count;       /**< Unscheduled predecessors. */
+  size_t live_uses;        /**< Unscheduled data successors of the node's value. */
+  size_t succ_start;       /**< First successor edge in the sorted edge array. */
+  size_t succ_end;         /**< One past the last successor edge. */
+  size_t pred_start;       /**< First data predecessor in the predecessor array. */
+  size_t pred_end;         /**< One past the last data predecessor. */
+  bool scheduled;          /**< Whether the node has been scheduled. */
+} sched_node_t;
+
+/**
+ * @brief Reader record, chaining the readers of a variable since its last def.
+ */
+typedef struct {
+  size_t node;             /**< Reading node. */
+  int32_t next;            /**< Next (older) reader record, or -1. */
+} sched_reader_t;
+
+/**
+ * @brief Scheduler state for one function.
+ */
+typedef struct {
+  optimize_context_t* context;   /**< Optimizer context. */
+  const machine_model_t* model;  /**< Machine model. */
+  symbol_table_t* globals;       /**< Global symbol table. */
+  effects_t* effects;            /**< Memory effects of the module's functions. */
+  alias_t* alias;                /**< Alias analysis of the function. */
+  ast_node_t* function;          /**< Function being scheduled. */
+  ir_var_table_t* vars;          /**< Variable numbering. */
+  
+  /* Per-variable state, valid when var_epoch matches the block epoch */
+  int32_t* last_def;             /**< Last defining node, or -1. */
+  int32_t* reader_head;          /**< Newest reader record since the last def, or -1. */
+  uint32_t* var_epoch;           /**< Block epoch in which the state was set. */
+  size_t var_capacity;           /**< Capacity of the per-variable arrays. */
+  uint32_t epoch;                /**< Current block epoch. */
+  
+  sched_reader_t* readers;       /**< Reader records. */
+  size_t reader_count;           /**< Number of reader records. */
+  size_t reader_capacity;        /**< Capacity of the reader records. */
+  
+  sched_edge_t* edges;           /**< Dependency edges in creation order. */
+  sched_edge_t* sorted;          /**< Dependency edges grouped by source node. */
+  size_t* preds;                 /**< Data predecessors grouped by target node. */
+  size_t edge_count;             /**< Number of edges. */
+  size_t edge_capacity;          /**< Capacity of the edge arrays. */
+  
+  sched_node_t* nodes;           /**< Scheduling nodes. */
+  size_t* order;                 /**< Schedule being built. */
+  size_t* identity;              /**< Original order. */
+  size_t* mem_readers;           /**< Memory readers since the last memory barrier. */
+  size_t* mem_writers;           /**< Stores since the last memory barrier. */
+  size_t node_capacity;          /**< Capacity of the node arrays. */
+  
+  size_t current;                /**< Node whose uses are being recorded. */
+  bool reads_global;             /**< Whether the current node reads a global. */
+  bool failed;                   /**< Whether an allocation failed. */
+} scheduler_t;
+
+/**
+ * @brief Add a dependency edge.
+ * 
+ * @param s The scheduler.
+ * @param from Node that must issue first.
+ * @param to Dependent node.
+ * @param latency Minimum cycles between the two issues.
+ * @param is_data Whether the edge carries a register value.
+ */
+static void add_edge(scheduler_t* s, size_t from, size_t to, uint32_t latency, bool is_data) {
+  if (s->failed || from == to) {
+    return;
+  }
+  
+  /* Check if we need to resize the edge arrays */
+  if (s->edge_count >= s->edge_capacity) {
+    size_t new_capacity = s->edge_capacity == 0 ? 16 : s->edge_capacity * 2;
+    sched_edge_t* new_edges = (sched_edge_t*)realloc(s->edges,
+                                                    new_capacity * sizeof(sched_edge_t));
+    if (new_edges == NULL) {
+      s->failed = true;
+      return;
+    }
+    s->edges = new_edges;
+    
+    sched_edge_t* new_sorted = (sched_edge_t*)realloc(s->sorted,
+                                                     new_capacity * sizeof(sched_edge_t));
+    if (new_sorted == NULL) {
+      s->failed = true;
+      return;
+    }
+    s->sorted = new_sorted;
+    
+    size_t* new_preds = (size_t*)realloc(s->preds, new_capacity * sizeof(size_t));
+    if (new_preds == NULL) {
+      s->failed = true;
+      return;
+    }
+    s->preds = new_preds;
+    
+    s->edge_capacity = new_capacity;
+  }
+  
+  sched_edge_t* edge = &s->edges[s->edge_count++];
+  edge->from = from;
+  edge->to = to;
+  edge->latency = latency;
+  edge->is_data = is_data;
+}
+
+/**
+ * @brief Get the number of a variable, making its state valid for this block.
+ * 
+ * @param s The scheduler.
+ * @param name The variable name.
+ * @return The variable number, or -1 on allocation failure.
+ */
+static int32_t block_var(scheduler_t* s, const char* name) {
+  int32_t id = ir_var_table_intern(s->vars, name);
+  if (id < 0) {
+    s->failed = true;
+    return -1;
+  }
+  
+  /* Check if we need to resize the per-variable arrays */
+  if ((size_t)id >= s->var_capacity) {
+    size_t new_capacity = s->var_capacity == 0 ? 16 : s->var_capacity * 2;
+    while (new_capacity <= (size_t)id) {
+      new_capacity *= 2;
+    }
+    
+    int32_t* new_defs = (int32_t*)realloc(s->last_def, new_capacity * sizeof(int32_t));
+    if (new_defs == NULL) {
+      s->failed = true;
+      return -1;
+    }
+    s->last_def = new_defs;
+    
+    int32_t* new_heads = (int32_t*)realloc(s->reader_head, new_capacity * sizeof(int32_t));
+    if (new_heads == NULL) {
+      s->failed = true;
+      return -1;
+    }
+    s->reader_head = new_heads;
+    
+    uint32_t* new_epochs = (uint32_t*)realloc(s->var_epoch, new_capacity * sizeof(uint32_t));
+    if (new_epochs == NULL) {
+      s->failed = true;
+      return -1;
+    }
+    s->var_epoch = new_epochs;
+    
+    for (size_t i = s->var_capacity; i < new_capacity; i++) {
+      s->var_epoch[i] = 0;
+    }
+    s->var_capacity = new_capacity;
+  }
+  
+  if (s->var_epoch[id] != s->epoch) {
+    s->var_epoch[id] = s->epoch;
+    s->last_def[id] = -1;
+    s->reader_head[id] = -1;
+  }
+  
+  return id;
+}
+
+/**
+ * @brief Record a variable use of the current node (read-after-write).
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The scheduler.
+ */
+static void record_use(ast_node_t** use, void* data) {
+  scheduler_t* s = (scheduler_t*)data;
+  const char* name = (*use)->data.expr_identifier.name;
+  if (symtable_lookup(s->globals, name, false) != NULL) {
+    s->reads_global = true;
+  }
+  
+  int32_t id = block_var(s, name);
+  if (id < 0) {
+    return;
+  }
+  
+  if (s->last_def[id] >= 0) {
+    size_t def = (size_t)s->last_def[id];
+    add_edge(s, def, s->current, s->nodes[def].latency, true);
+  }
+  
+  /* Check if we need to resize the reader records */
+  if (s->reader_count >= s->reader_capacity) {
+    size_t new_capacity = s->reader_capacity == 0 ? 16 : s->reader_capacity * 2;
+    sched_reader_t* new_readers = (sched_reader_t*)realloc(
+      s->readers, new_capacity * sizeof(sched_reader_t)
+    );
+    if (new_readers == NULL) {
+      s->failed = true;
+      return;
+    }
+    s->readers = new_readers;
+    s->reader_capacity = new_capacity;
+  }
+  
+  s->readers[s->reader_count].node = s->current;
+  s->readers[s->reader_count].next = s->reader_head[id];
+  s->reader_head[id] = (int32_t)s->reader_count;
+  s->reader_count++;
+}
+
+/**
+ * @brief Record the variable defined by a node (write-after-read, write-after-write).
+ * 
+ * @param s The scheduler.
+ * @param index The defining node.
+ * @param name The defined variable name.
+ */
+static void record_def(scheduler_t* s, size_t index, const char* name) {
+  int32_t id = block_var(s, name);
+  if (id < 0) {
+    return;
+  }
+  
+  for (int32_t r = s->reader_head[id]; r >= 0; r = s->readers[r].next) {
+    add_edge(s, s->readers[r].node, index, 0, false);
+  }
+  
+  if (s->last_def[id] >= 0) {
+    add_edge(s, (size_t)s->last_def[id], index, 0, false);
+  }
+  
+  s->last_def[id] = (int32_t)index;
+  s->reader_head[id] = -1;
+}
+
+/**
+ * @brief Make sure the node arrays can hold a block.
+ * 
+ * @param s The scheduler.
+ * @param count The number of nodes.
+ * @return true on success, false on allocation failure.
+ */
+static bool reserve_nodes(scheduler_t* s, size_t count) {
+  if (count <= s->node_capacity) {
+    return true;
+  }
+  
+  size_t new_capacity = s->node_capacity == 0 ? 16 : s->node_capacity;
+  while (new_capacity < count) {
+    new_capacity *= 2;
+  }
+  
+  sched_node_t* new_nodes = (sched_node_t*)realloc(s->nodes, new_capacity * sizeof(sched_node_t));
+  if (new_nodes == NULL) {
+    return false;
+  }
+  s->nodes = new_nodes;
+  
+  size_t** arrays[] = { &s->order, &s->identity, &s->mem_readers, &s->mem_writers };
+  for (size_t i = 0; i < sizeof(arrays) / sizeof(arrays[0]); i++) {
+    size_t* new_array = (size_t*)realloc(*arrays[i], new_capacity * sizeof(size_t));
+    if (new_array == NULL) {
+      return false;
+    }
+    *arrays[i] = new_array;
+  }
+  
+  s->node_capacity = new_capacity;
+  return true;
+}
+
+/**
+ * @brief Build the dependency graph of the first count statements of a block.
+ * 
+ * @param s The scheduler.
+ * @param stmts The block statements.
+ * @param count The number of statements to schedule.
+ */
+static void build_graph(scheduler_t* s, ast_node_t** stmts, size_t count) {
+  s->edge_count = 0;
+  s->reader_count = 0;
+  s->epoch++;
+  
+  int32_t last_barrier = -1;
+  size_t mem_reader_count = 0;
+  size_t mem_writer_count = 0;
+  
+  for (size_t i = 0; i < count && !s->failed; i++) {
+    sched_node_t* node = &s->nodes[i];
+    uint8_t opcode = ir_get_opcode(stmts[i]);
+    uint32_t flags = effects_get_flags(s->effects, s->function, stmts[i]);
+    
+    node->stmt = stmts[i];
+    node->latency = machine_latency(s->model, opcode);
+    s->identity[i] = i;
+    
+    /* Register dependences: uses before the def, so "a = ADD a, 1" works */
+    s->current = i;
+    s->reads_global = false;
+    ir_visit_uses(stmts[i], record_use, s);
+    
+    /* A global's address may have been taken, so accessing one is ordered
+     * like a load or an opaque write */
+    const char* def = ir_get_def(stmts[i]);
+    if (s->reads_global) {
+      flags |= IR_FLAG_READS_MEMORY;
+    }
+    if (def != NULL && symtable_lookup(s->globals, def, false) != NULL) {
+      flags |= IR_FLAG_WRITES_MEMORY;
+    }
+    
+    /* Memory dependences: loads may pass loads, and stores pass the accesses
+     * that cannot alias them. Other writes are barriers ordered with every
+     * access. Trapping instructions are kept on the same side of every side
+     * effect, since the alias analysis never tells them apart. */
+    bool is_store = opcode == OPCODE_STORE;
+    if (flags & IR_FLAG_WRITES_MEMORY) {
+      if (last_barrier >= 0) {
+        add_edge(s, (size_t)last_barrier, i, 0, false);
+      }
+      for (size_t j = 0; j < mem_writer_count; j++) {
+        if (!is_store || alias_may_alias(s->alias, stmts[s->mem_writers[j]], stmts[i])) {
+          add_edge(s, s->mem_writers[j], i, 0, false);
+        }
+      }
+      for (size_t j = 0; j < mem_reader_count; j++) {
+        if (!is_store || alias_may_alias(s->alias, stmts[s->mem_readers[j]], stmts[i])) {
+          add_edge(s, s->mem_readers[j], i, 0, false);
+        }
+      }
+      if (is_store) {
+        s->mem_writers[mem_writer_count++] = i;
+      } else {
+        mem_reader_count = 0;
+        mem_writer_count = 0;
+        last_barrier = (int32_t)i;
+      }
+    } else if (flags & (IR_FLAG_READS_MEMORY | IR_FLAG_MAY_TRAP)) {
+      if (last_barrier >= 0) {
+        add_edge(s, (size_t)last_barrier, i, s->nodes[last_barrier].latency, false);
+      }
+      for (size_t j = 0; j < mem_writer_count; j++) {
+        size_t writer = s->mem_writers[j];
+        if (alias_may_alias(s->alias, stmts[writer], stmts[i])) {
+          add_edge(s, writer, i, s->nodes[writer].latency, false);
+        }
+      }
+      s->mem_readers[mem_reader_count++] = i;
+    }
+    
+    if (def != NULL) {
+      record_def(s, i, def);
+    }
+  }
+  
+  if (s->failed) {
+    return;
+  }
+  
+  /* Group edges by source (successors) and data edges by target (predecessors) */
+  for (size_t i = 0; i < count; i++) {
+    s->nodes[i].succ_start = 0;
+    s->nodes[i].succ_end = 0;
+    s->nodes[i].pred_start = 0;
+    s->nodes[i].pred_end = 0;
+  }
+  
+  for (size_t e = 0; e < s->edge_count; e++) {
+    s->nodes[s->edges[e].from].succ_end++;
+    if (s->edges[e].is_data) {
+      s->nodes[s->edges[e].to].pred_end++;
+    }
+  }
+  
+  size_t succ_offset = 0;
+  size_t pred_offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    sched_node_t* node = &s->nodes[i];
+    size_t succs = node->succ_end;
+    size_t preds = node->pred_end;
+    node->succ_start = node->succ_end = succ_offset;
+    node->pred_start = node->pred_end = pred_offset;
+    succ_offset += succs;
+    pred_offset += preds;
+  }
+  
+  for (size_t e = 0; e < s->edge_count; e++) {
+    sched_edge_t* edge = &s->edges[e];
+    s->sorted[s->nodes[edge->from].succ_end++] = *edge;
+    if (edge->is_data) {
+      s->preds[s->nodes[edge->to].pred_end++] = edge->from;
+    }
+  }
+  
+  /* Heights: edges always point forward, so a reverse walk sees successors first */
+  for (size_t i = count; i-- > 0;) {
+    sched_node_t* node = &s->nodes[i];
+    uint32_t height = node->latency;
+    for (size_t e = node->succ_start; e < node->succ_end; e++) {
+      uint32_t path = s->sorted[e].latency + s->nodes[s->sorted[e].to].height;
+      if (path > height) {
+        height = path;
+      }
+    }
+    node->height = height;
+  }
+}
+
+/**
+ * @brief Estimate the cycles taken by an in-order issue of a schedule.
+ * 
+ * @param s The scheduler.
+ * @param order The schedule.
+ * @param count The number of nodes.
+ * @return The cycle at which the last result becomes available.
+ */
+static uint32_t simulate(scheduler_t* s, const size_t* order, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    s->nodes[i].earliest = 0;
+  }
+  
+  uint32_t cycle = 0;
+  uint32_t issued = 0;
+  uint32_t length = 0;
+  
+  for (size_t k = 0; k < count; k++) {
+    sched_node_t* node = &s->nodes[order[k]];
+    
+    if (issued >= s->model->issue_width) {
+      cycle++;
+      issued = 0;
+    }
+    if (node->earliest > cycle) {
+      cycle = node->earliest;
+      issued = 0;
+    }
+    issued++;
+    
+    if (cycle + node->latency > length) {
+      length = cycle + node->latency;
+    }
+    
+    for (size_t e = node->succ_start; e < node->succ_end; e++) {
+      sched_node_t* succ = &s->nodes[s->sorted[e].to];
+      if (cycle + s->sorted[e].latency > succ->earliest) {
+        succ->earliest = cycle + s->sorted[e].latency;
+      }
+    }
+  }
+  
+  return length;
+}
+
+/**
+ * @brief Net change in live values if a node were scheduled now.
+ * 
+ * @param s The scheduler.
+ * @param index The node.
+ * @return Values defined minus values killed.
+ */
+static int pressure_delta(const scheduler_t* s, size_t index) {
+  const sched_node_t* node = &s->nodes[index];
+  int delta = node->live_uses > 0 ? 1 : 0;
+  
+  for (size_t p = node->pred_start; p < node->pred_end; p++) {
+    if (s->nodes[s->preds[p]].live_uses == 1) {
+      delta--;
+    }
+  }
+  
+  return delta;
+}
+
+/**
+ * @brief Check whether one ready node should be scheduled before another.
+ * 
+ * @param s The scheduler.
+ * @param a The candidate node.
+ * @param b The current best node.
+ * @param high_pressure Whether live values exceed the register count.
+ * @return true if a is preferred over b.
+ */
+static bool is_better(const scheduler_t* s, size_t a, size_t b, bool high_pressure) {
+  if (high_pressure) {
+    int delta_a = pressure_delta(s, a);
+    int delta_b = pressure_delta(s, b);
+    if (delta_a != delta_b) {
+      return delta_a < delta_b;
+    }
+  }
+  
+  if (s->nodes[a].height != s->nodes[b].height) {
+    return s->nodes[a].height > s->nodes[b].height;
+  }
+  
+  /* Keep the original order among equals */
+  return a < b;
+}
+
+/**
+ * @brief Build a list schedule of the current graph into s->order.
+ * 
+ * @param s The scheduler.
+ * @param count The number of nodes.
+ */
+static void list_schedule(scheduler_t* s, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    sched_node_t* node = &s->nodes[i];
+    node->earliest = 0;
+    node->pred_count = 0;
+    node->live_uses = 0;
+    node->scheduled = false;
+  }
+  
+  for (size_t e = 0; e < s->edge_count; e++) {
+    s->nodes[s->sorted[e].to].pred_count++;
+    if (s->sorted[e].is_data) {
+      s->nodes[s->sorted[e].from].live_uses++;
+    }
+  }
+  
+  uint32_t cycle = 0;
+  uint32_t issued = 0;
+  size_t live = 0;
+  size_t done = 0;
+  
+  while (done < count) {
+    bool high_pressure = live >= s->model->register_count;
+    size_t best = count;
+    
+    if (issued < s->model->issue_width) {
+      for (size_t i = 0; i < count; i++) {
+        sched_node_t* node = &s->nodes[i];
+        if (node->scheduled || node->pred_count > 0 || node->earliest > cycle) {
+          continue;
+        }
+        if (best == count || is_better(s, i, best, high_pressure)) {
+          best = i;
+        }
+      }
+    }
+    
+    if (best == count) {
+      cycle++;
+      issued = 0;
+      continue;
+    }
+    
+    sched_node_t* node = &s->nodes[best];
+    node->scheduled = true;
+    s->order[done++] = best;
+    issued++;
+    
+    for (size_t e = node->succ_start; e < node->succ_end; e++) {
+      sched_node_t* succ = &s->nodes[s->sorted[e].to];
+      succ->pred_count--;
+      if (cycle + s->sorted[e].latency > succ->earliest) {
+        succ->earliest = cycle + s->sorted[e].latency;
+      }
+    }
+    
+    /* Track live values for the register pressure heuristic */
+    if (node->live_uses > 0) {
+      live++;
+    }
+    for (size_t p = node->pred_start; p < node->pred_end; p++) {
+      sched_node_t* pred = &s->nodes[s->preds[p]];
+      if (pred->live_uses > 0 && --pred->live_uses == 0 && live > 0) {
+        live--;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Schedule a run of statements without terminators.
+ * 
+ * @param s The scheduler.
+ * @param block The block AST node holding the statements.
+ * @param stmts The statements.
+ * @param count The number of statements.
+ * @return true on success, false on allocation failure.
+ */
+static bool schedule_run(scheduler_t* s, ast_node_t* block, ast_node_t** stmts, size_t count) {
+  if (count < 2) {
+    return true;
+  }
+  
+  if (!reserve_nodes(s, count)) {
+    return false;
+  }
+  
+  build_graph(s, stmts, count);
+  if (s->failed) {
+    return false;
+  }
+  
+  list_schedule(s, count);
+  
+  /* Only reorder when the model predicts a shorter run */
+  uint32_t cycles = simulate(s, s->order, count);
+  uint32_t original = simulate(s, s->identity, count);
+  if (cycles >= original) {
+    optimize_remark(s->context, HOILC_REMARK_ANALYSIS, s->function, stmts[0], "Cycles",
+                    "%zu instructions of '%s' kept in order, taking %u cycles",
+                    count, block->data.stmt_block.label, original);
+    return true;
+  }
+  
+  optimize_remark(s->context, HOILC_REMARK_PASSED, s->function, stmts[0], "Scheduled",
+                  "reordered %zu instructions of '%s' from %u to %u cycles",
+                  count, block->data.stmt_block.label, original, cycles);
+
+  for (size_t k = 0; k < count; k++) {
+    stmts[k] = s->nodes[s->order[k]].stmt;
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Schedule one basic block.
+ * 
+ * A degraded pass schedules each window of SCHEDULE_DEGRADED_WINDOW
+ * statements on its own, so no instruction moves across a window boundary.
+ * 
+ * @param s The scheduler.
+ * @param block The block AST node.
+ * @return true on success, false on allocation failure.
+ */
+static bool schedule_block(scheduler_t* s, ast_node_t* block) {
+  ast_node_list_t* statements = &block->data.stmt_block.statements;
+  
+  /* Terminators and anything after them stay where they are */
+  size_t count = 0;
+  while (count < statements->count &&
+         (ir_get_flags(statements->nodes[count]) & IR_FLAG_TERMINATOR) == 0) {
+    count++;
+  }
+  
+  size_t window = optimize_is_degraded(s->context) ? SCHEDULE_DEGRADED_WINDOW : count;
+  for (size_t start = 0; start < count; start += window) {
+    size_t size = count - start < window ? count - start : window;
+    if (!schedule_run(s, block, statements->nodes + start, size)) {
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+bool pass_schedule(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  scheduler_t s;
+  memset(&s, 0, sizeof(s));
+  s.context = context;
+  s.model = optimize_get_machine_model(context);
+  s.globals = optimize_get_symbol_table(context);
+  s.effects = optimize_get_effects(context);
+  s.function = function;
+  s.vars = ir_var_table_create();
+  s.alias = alias_analyze(function, s.globals);
+  
+  bool success = s.vars != NULL && s.effects != NULL && s.alias != NULL;
+  for (size_t i = 0; success && i < function->data.function.blocks.count; i++) {
+    success = schedule_block(&s, function->data.function.blocks.nodes[i]);
+  }
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL,
+                         function, "Memory allocation failed");
+  }
+  
+  ir_var_table_destroy(s.vars);
+  alias_destroy(s.alias);
+  free(s.last_def);
+  free(s.reader_head);
+  free(s.var_epoch);
+  free(s.readers);
+  free(s.edges);
+  free(s.sorted);
+  free(s.preds);
+  free(s.nodes);
+  free(s.order);
+  free(s.identity);
+  free(s.mem_readers);
+  free(s.mem_writers);
+  
+  return success;
+}
@@ -0,0 +1,358 @@
+/**
+ * @file pass_sink.c
+ * @brief Global code sinking.
+ * 
+ * This file contains a pass that moves pure instructions down the
+ * dominator tree towards their uses, so that values needed on only some
+ * paths are computed only on those paths. Instructions never move into a
+ * loop.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/cfg.h"
+#include "../include/ir.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Blocks using one variable, one entry per use.
+ */
+typedef struct {
+  size_t* blocks;           /**< Using blocks. */
+  size_t count;             /**< Number of uses. */
+  size_t capacity;          /**< Allocated capacity. */
+} sink_uses_t;
+
+/**
+ * @brief Sinking state for one function.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  symbol_table_t* globals;  /**< Global symbol table. */
+  ast_node_t* function;     /**< Function AST node. */
+  cfg_t* cfg;               /**< Control flow graph with dominators and loops. */
+  ir_var_table_t* vars;     /**< Parameters and locals. */
+  size_t* def_counts;       /**< Number of definitions of each variable. */
+  size_t* def_blocks;       /**< Block of the only definition of each variable. */
+  size_t* def_orders;       /**< Position of that definition plus one, 0 for parameters. */
+  sink_uses_t* uses;        /**< Using blocks of each variable. */
+  size_t block;             /**< Block being scanned. */
+  size_t index;             /**< Statement being scanned. */
+  size_t target;            /**< Block the statement moves to. */
+  bool movable;             /**< Whether the operands seen so far allow a move. */
+  bool failed;              /**< Whether memory allocation failed. */
+} sink_t;
+
+/**
+ * @brief Use visitor that records the block of a use.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The sinking state.
+ */
+static void record_use(ast_node_t** use, void* data) {
+  sink_t* sink = (sink_t*)data;
+  int32_t id = ir_var_table_find(sink->vars, (*use)->data.expr_identifier.name);
+  if (id < 0 || sink->failed) {
+    return;
+  }
+  
+  sink_uses_t* uses = &sink->uses[id];
+  if (uses->count == uses->capacity) {
+    size_t capacity = uses->capacity == 0 ? 16 : uses->capacity * 2;
+    size_t* blocks = (size_t*)realloc(uses->blocks, capacity * sizeof(size_t));
+    if (blocks == NULL) {
+      sink->failed = true;
+      return;
+    }
+    uses->blocks = blocks;
+    uses->capacity = capacity;
+  }
+  uses->blocks[uses->count++] = sink->block;
+}
+
+/**
+ * @brief Use visitor that checks an operand has the same value further down.
+ * 
+ * Locals must have a single definition that comes before the statement;
+ * names that are not locals must be constants.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The sinking state, with the statement position set.
+ */
+static void check_operand(ast_node_t** use, void* data) {
+  sink_t* sink = (sink_t*)data;
+  const char* name = (*use)->data.expr_identifier.name;
+  int32_t id = ir_var_table_find(sink->vars, name);
+  
+  if (id < 0) {
+    symbol_entry_t* entry = symtable_lookup(sink->globals, name, false);
+    sink->movable = sink->movable && entry != NULL &&
+                    symtable_get_kind(entry) == SYMBOL_CONSTANT;
+    return;
+  }
+  
+  size_t def_block = sink->def_blocks[id];
+  sink->movable = sink->movable && sink->def_counts[id] == 1 &&
+                  (def_block == sink->block ?
+                   sink->def_orders[id] <= sink->index :
+                   cfg_dominates(sink->cfg, def_block, sink->block));
+}
+
+/**
+ * @brief Use visitor that moves the use of an operand to the sinking target.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The sinking state, with the block and target set.
+ */
+static void move_use(ast_node_t** use, void* data) {
+  sink_t* sink = (sink_t*)data;
+  int32_t id = ir_var_table_find(sink->vars, (*use)->data.expr_identifier.name);
+  if (id < 0) {
+    return;
+  }
+  
+  sink_uses_t* uses = &sink->uses[id];
+  for (size_t i = 0; i < uses->count; i++) {
+    if (uses->blocks[i] == sink->block) {
+      uses->blocks[i] = sink->target;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Get the loop nesting depth of a block.
+ * 
+ * @param cfg The control flow graph, with loops.
+ * @param block The block number.
+ * @return 0 outside loops, else the depth of the innermost loop.
+ */
+static size_t loop_depth(const cfg_t* cfg, size_t block) {
+  int32_t loop = cfg_block_loop(cfg, block);
+  return loop < 0 ? 0 : cfg_loop_depth(cfg, (size_t)loop);
+}
+
+/**
+ * @brief Choose the block to move a definition to.
+ * 
+ * Starts from the nearest common dominator of the uses and walks up the
+ * dominator tree towards the defining block, taking the deepest block with
+ * the lowest loop depth that no loop around the defining block leaves out.
+ * 
+ * @param sink The sinking state.
+ * @param block The defining block.
+ * @param uses The using blocks.
+ * @return The target block, or the defining block if the definition stays.
+ */
+static size_t choose_target(const sink_t* sink, size_t block, const sink_uses_t* uses) {
+  if (uses->count == 0) {
+    return block;
+  }
+  
+  size_t common = uses->blocks[0];
+  for (size_t i = 0; i < uses->count; i++) {
+    if (!cfg_is_reachable(sink->cfg, uses->blocks[i])) {
+      return block;
+    }
+    common = cfg_common_dominator(sink->cfg, common, uses->blocks[i]);
+  }
+  if (common == block || !cfg_dominates(sink->cfg, block, common)) {
+    return block;
+  }
+  
+  size_t best = block;
+  size_t best_depth = loop_depth(sink->cfg, block);
+  for (size_t b = common; b != block; b = (size_t)cfg_immediate_dominator(sink->cfg, b)) {
+    int32_t loop = cfg_block_loop(sink->cfg, b);
+    if (loop >= 0 && !cfg_loop_contains(sink->cfg, (size_t)loop, block)) {
+      continue;
+    }
+    if (best == block ? loop_depth(sink->cfg, b) <= best_depth :
+        loop_depth(sink->cfg, b) < best_depth) {
+      best = b;
+      best_depth = loop_depth(sink->cfg, b);
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief Sink the movable definitions of a block, last first.
+ * 
+ * Later statements go first so that a definition whose users were just
+ * moved can follow them.
+ * 
+ * @param sink The sinking state.
+ * @param block The block number.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool sink_block(sink_t* sink, size_t block) {
+  ast_node_list_t* statements = &cfg_get_block(sink->cfg, block)->data.stmt_block.statements;
+  size_t length = cfg_statement_count(sink->cfg, block);
+  
+  for (size_t j = length; j-- > 0;) {
+    ast_node_t* stmt = statements->nodes[j];
+    const char* def = ir_get_def(stmt);
+    int32_t id = def != NULL ? ir_var_table_find(sink->vars, def) : -1;
+    uint32_t flags = ir_get_flags(stmt);
+    if (id < 0 || sink->def_counts[id] != 1 || sink->def_orders[id] == 0 ||
+        stmt->type != AST_STMT_ASSIGN ||
+        (flags & (IR_FLAG_PURE | IR_FLAG_MAY_TRAP | IR_FLAG_READS_MEMORY)) != IR_FLAG_PURE) {
+      continue;
+    }
+    
+    sink->block = block;
+    sink->index = j;
+    sink->movable = true;
+    ir_visit_uses(stmt, check_operand, sink);
+    size_t target = sink->movable ? choose_target(sink, block, &sink->uses[id]) : block;
+    if (target == block) {
+      continue;
+    }
+    
+    optimize_remark(sink->context, HOILC_REMARK_PASSED, sink->function, stmt, "Sunk",
+                    "moved '%s' from '%s' to '%s'", def,
+                    cfg_get_block(sink->cfg, block)->data.stmt_block.label,
+                    cfg_get_block(sink->cfg, target)->data.stmt_block.label);
+    
+    /* Move to the start of the target, ahead of definitions sunk earlier */
+    ast_node_list_t* dest = &cfg_get_block(sink->cfg, target)->data.stmt_block.statements;
+    if (!ast_add_node(dest, stmt)) {
+      return false;
+    }
+    memmove(&dest->nodes[1], &dest->nodes[0], (dest->count - 1) * sizeof(ast_node_t*));
+    dest->nodes[0] = stmt;
+    memmove(&statements->nodes[j], &statements->nodes[j + 1],
+            (statements->count - j - 1) * sizeof(ast_node_t*));
+    statements->count--;
+    
+    sink->target = target;
+    ir_visit_uses(stmt, move_use, sink);
+    sink->def_blocks[id] = target;
+    sink->def_orders[id] = 1;
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Number the variables and record their definitions and uses.
+ * 
+ * @param sink The sinking state.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool index_variables(sink_t* sink) {
+  ast_node_t* function = sink->function;
+  size_t block_count = cfg_block_count(sink->cfg);
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    if (ir_var_table_intern(sink->vars, param->data.parameter.name) < 0) {
+      return false;
+    }
+  }
+  size_t param_count = ir_var_table_count(sink->vars);
+  
+  /* Globals can change between the two points, so only locals are tracked */
+  for (size_t i = 0; i < block_count; i++) {
+    ast_node_list_t* statements = &cfg_get_block(sink->cfg, i)->data.stmt_block.statements;
+    for (size_t j = 0; j < cfg_statement_count(sink->cfg, i); j++) {
+      const char* def = ir_get_def(statements->nodes[j]);
+      if (def != NULL && symtable_lookup(sink->globals, def, false) == NULL &&
+          ir_var_table_intern(sink->vars, def) < 0) {
+        return false;
+      }
+    }
+  }
+  
+  size_t var_count = ir_var_table_count(sink->vars);
+  sink->def_counts = (size_t*)calloc(var_count + 1, sizeof(size_t));
+  sink->def_blocks = (size_t*)calloc(var_count + 1, sizeof(size_t));
+  sink->def_orders = (size_t*)calloc(var_count + 1, sizeof(size_t));
+  sink->uses = (sink_uses_t*)calloc(var_count + 1, sizeof(sink_uses_t));
+  if (sink->def_counts == NULL || sink->def_blocks == NULL || sink->def_orders == NULL ||
+      sink->uses == NULL) {
+    return false;
+  }
+  
+  /* Parameters are defined on entry */
+  for (size_t v = 0; v < param_count; v++) {
+    sink->def_counts[v] = 1;
+  }
+  
+  for (size_t i = 0; i < block_count && !sink->failed; i++) {
+    ast_node_list_t* statements = &cfg_get_block(sink->cfg, i)->data.stmt_block.statements;
+    sink->block = i;
+    for (size_t j = 0; j < cfg_statement_count(sink->cfg, i); j++) {
+      const char* def = ir_get_def(statements->nodes[j]);
+      int32_t id = def != NULL ? ir_var_table_find(sink->vars, def) : -1;
+      
+      ir_visit_uses(statements->nodes[j], record_use, sink);
+      if (id >= 0) {
+        sink->def_counts[id]++;
+        sink->def_blocks[id] = i;
+        sink->def_orders[id] = j + 1;
+      }
+    }
+  }
+  
+  return !sink->failed;
+}
+
+bool pass_sink(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  sink_t sink;
+  memset(&sink, 0, sizeof(sink));
+  sink.context = context;
+  sink.globals = optimize_get_symbol_table(context);
+  sink.function = function;
+  sink.cfg = cfg_build(function);
+  sink.vars = ir_var_table_create();
+  
+  bool success = sink.cfg != NULL && sink.vars != NULL && cfg_compute_dominators(sink.cfg) &&
+                 cfg_compute_loops(sink.cfg) && index_variables(&sink);
+  
+  /* Visit blocks in reverse dominator tree preorder, so users move before their operands */
+  size_t count = success ? cfg_block_count(sink.cfg) : 0;
+  size_t* order = (size_t*)malloc((count + 1) * sizeof(size_t));
+  success = success && order != NULL;
+  
+  size_t visited = 0;
+  int32_t block = success && count > 0 ? 0 : -1;
+  while (block >= 0) {
+    order[visited++] = (size_t)block;
+    int32_t next = cfg_dominator_child(sink.cfg, (size_t)block);
+    while (next < 0 && block > 0) {
+      next = cfg_dominator_sibling(sink.cfg, (size_t)block);
+      block = next < 0 ? cfg_immediate_dominator(sink.cfg, (size_t)block) : block;
+    }
+    block = next;
+  }
+  for (size_t i = visited; i-- > 0 && success;) {
+    success = sink_block(&sink, order[i]);
+  }
+  
+  for (size_t v = 0; sink.uses != NULL && v < ir_var_table_count(sink.vars); v++) {
+    free(sink.uses[v].blocks);
+  }
+  free(order);
+  free(sink.uses);
+  free(sink.def_counts);
+  free(sink.def_blocks);
+  free(sink.def_orders);
+  ir_var_table_destroy(sink.vars);
+  cfg_destroy(sink.cfg);
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL,
+                         function, "Memory allocation failed");
+  }
+  
+  return success;
+}
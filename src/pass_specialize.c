@@ -0,0 +1,875 @@
+/**
+ * @file pass_specialize.c
+ * @brief Function specialization on constant arguments.
+ * 
+ * This file contains an interprocedural pass that clones a function for
+ * constant argument tuples shared by several call sites, propagates the
+ * constants through the clone and redirects the call sites to it.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/cfg.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Number of call sites that must share a tuple before it is specialized.
+ */
+#define SPECIALIZE_MIN_CALLS 2
+
+/**
+ * @brief Largest function, in statements, that is cloned.
+ */
+#define SPECIALIZE_MAX_STATEMENTS 200
+
+/**
+ * @brief Growth budget as a percentage of the statements in the module.
+ */
+#define SPECIALIZE_GROWTH_PERCENT 20
+
+/**
+ * @brief Growth budget, in statements, for small modules.
+ */
+#define SPECIALIZE_MIN_GROWTH 64
+
+/**
+ * @brief Prefix of the names of specialized functions.
+ */
+#define SPECIALIZED_PREFIX "__hoilc_specialized_"
+
+/**
+ * @brief Call with at least one constant argument.
+ */
+typedef struct {
+  ast_node_t* call;          /**< Call expression. */
+  int32_t callee;            /**< Callee number. */
+  ir_key_t key;              /**< Constant argument tuple. */
+  uint64_t hash;             /**< Hash of the key. */
+  size_t sequence;           /**< Discovery order, used as a tie breaker. */
+} spec_site_t;
+
+/**
+ * @brief Call sites sharing a callee and a constant argument tuple.
+ */
+typedef struct {
+  size_t first;              /**< First site in sorted order. */
+  size_t count;              /**< Number of sites. */
+} spec_group_t;
+
+/**
+ * @brief Constants substituted for variables.
+ */
+typedef struct {
+  const char** names;        /**< Variable names. */
+  const int64_t* values;     /**< Variable values. */
+  size_t count;              /**< Number of variables. */
+  bool failed;               /**< Whether memory allocation failed. */
+} spec_binding_t;
+
+/**
+ * @brief Specializer state.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  symbol_table_t* globals;   /**< Global symbol table. */
+  ast_node_t* module;        /**< Module AST node. */
+  ir_var_table_t* names;     /**< Names of the functions that may be specialized. */
+  ast_node_t** callees;      /**< Function of each name. */
+  spec_site_t* sites;        /**< Call sites with constant arguments. */
+  size_t site_count;         /**< Number of call sites. */
+  size_t site_capacity;      /**< Capacity of the sites array. */
+  size_t next_id;            /**< Number of the next specialized function. */
+  bool failed;               /**< Whether memory allocation failed. */
+} specializer_t;
+
+/**
+ * @brief Count the statements of a function.
+ * 
+ * @param function The function AST node.
+ * @return The number of statements.
+ */
+static size_t function_size(const ast_node_t* function) {
+  size_t size = 0;
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    size += function->data.function.blocks.nodes[i]->data.stmt_block.statements.count;
+  }
+  return size;
+}
+
+/**
+ * @brief Get the constant an argument binds to an integer or boolean parameter.
+ * 
+ * The literal is converted to the parameter type, as the callee sees it.
+ * 
+ * @param param The parameter node.
+ * @param arg The argument expression.
+ * @param value Where to store the converted value.
+ * @return true if the argument is an integer literal and a literal holds
+ *         the converted value.
+ */
+static bool constant_argument(const ast_node_t* param, const ast_node_t* arg, int64_t* value) {
+  return arg->type == AST_EXPR_INTEGER &&
+         ir_integer_literal(param->data.parameter.type, arg->data.expr_integer.value, value);
+}
+
+/**
+ * @brief Check whether a function assigns a variable.
+ * 
+ * @param function The function AST node.
+ * @param name The variable name.
+ * @return true if some statement assigns the variable.
+ */
+static bool is_assigned(const ast_node_t* function, const char* name) {
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    const ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      if (def != NULL && strcmp(def, name) == 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Check whether any branch of a function targets a block.
+ * 
+ * @param function The function AST node.
+ * @param label The block label.
+ * @return true if the block is a branch target.
+ */
+static bool is_branch_target(const ast_node_t* function, const char* label) {
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    const ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      const ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      if (stmt->type != AST_STMT_BRANCH) {
+        continue;
+      }
+      
+      const char* t = stmt->data.stmt_branch.true_target;
+      const char* f = stmt->data.stmt_branch.false_target;
+      if ((t != NULL && strcmp(t, label) == 0) || (f != NULL && strcmp(f, label) == 0)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Get the call expression of a statement.
+ * 
+ * @param stmt The statement.
+ * @return The call expression of a CALL instruction, or NULL.
+ */
+static ast_node_t* get_call(ast_node_t* stmt) {
+  if (ir_get_opcode(stmt) != OPCODE_CALL) {
+    return NULL;
+  }
+  
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  if (instruction->data.stmt_instruction.operands.count != 1 ||
+      instruction->data.stmt_instruction.operands.nodes[0]->type != AST_EXPR_CALL) {
+    return NULL;
+  }
+  
+  return instruction->data.stmt_instruction.operands.nodes[0];
+}
+
+/**
+ * @brief Record a call if it passes constants to a function that may be specialized.
+ * 
+ * @param spec The specializer state.
+ * @param call The call expression.
+ */
+static void scan_call(specializer_t* spec, ast_node_t* call) {
+  const ast_node_t* callee_expr = call->data.expr_call.function;
+  if (callee_expr->type != AST_EXPR_IDENTIFIER) {
+    return;
+  }
+  
+  int32_t callee = ir_var_table_find(spec->names, callee_expr->data.expr_identifier.name);
+  if (callee < 0) {
+    return;
+  }
+  
+  const ast_node_t* function = spec->callees[callee];
+  const ast_node_list_t* args = &call->data.expr_call.arguments;
+  if (args->count != function->data.function.parameters.count) {
+    return;
+  }
+  
+  ir_key_t key = { NULL, 0, 0, false };
+  bool has_constant = false;
+  for (size_t i = 0; i < args->count; i++) {
+    int64_t value;
+    if (constant_argument(function->data.function.parameters.nodes[i], args->nodes[i], &value)) {
+      ir_key_append(&key, "#%lld,", (long long)value);
+      has_constant = true;
+    } else {
+      ir_key_append(&key, "_,");
+    }
+  }
+  
+  if (!has_constant || key.failed) {
+    spec->failed = spec->failed || key.failed;
+    ir_key_free(&key);
+    return;
+  }
+  
+  if (spec->site_count == spec->site_capacity) {
+    size_t capacity = spec->site_capacity == 0 ? 16 : spec->site_capacity * 2;
+    spec_site_t* sites = (spec_site_t*)realloc(spec->sites, capacity * sizeof(spec_site_t));
+    if (sites == NULL) {
+      ir_key_free(&key);
+      spec->failed = true;
+      return;
+    }
+    spec->sites = sites;
+    spec->site_capacity = capacity;
+  }
+  
+  spec_site_t* site = &spec->sites[spec->site_count];
+  site->call = call;
+  site->callee = callee;
+  site->key = key;
+  site->hash = ir_key_hash(&key);
+  site->sequence = spec->site_count;
+  spec->site_count++;
+}
+
+/**
+ * @brief Compare call sites by callee, tuple hash and discovery order.
+ * 
+ * @param a The first site.
+ * @param b The second site.
+ * @return Negative, zero or positive like strcmp.
+ */
+static int compare_sites(const void* a, const void* b) {
+  const spec_site_t* sa = (const spec_site_t*)a;
+  const spec_site_t* sb = (const spec_site_t*)b;
+  
+  if (sa->callee != sb->callee) {
+    return sa->callee < sb->callee ? -1 : 1;
+  }
+  if (sa->hash != sb->hash) {
+    return sa->hash < sb->hash ? -1 : 1;
+  }
+  return sa->sequence < sb->sequence ? -1 : (sa->sequence > sb->sequence ? 1 : 0);
+}
+
+/**
+ * @brief Compare groups by size (largest first), then by discovery order.
+ * 
+ * @param a The first group.
+ * @param b The second group.
+ * @return Negative, zero or positive like strcmp.
+ */
+static int compare_groups(const void* a, const void* b) {
+  const spec_group_t* ga = (const spec_group_t*)a;
+  const spec_group_t* gb = (const spec_group_t*)b;
+  
+  if (ga->count != gb->count) {
+    return ga->count > gb->count ? -1 : 1;
+  }
+  return ga->first < gb->first ? -1 : (ga->first > gb->first ? 1 : 0);
+}
+
+/**
+ * @brief Replace a use by a constant if the binding has one.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The binding.
+ */
+static void bind_use(ast_node_t** use, void* data) {
+  spec_binding_t* binding = (spec_binding_t*)data;
+  
+  for (size_t i = 0; i < binding->count; i++) {
+    if (strcmp((*use)->data.expr_identifier.name, binding->names[i]) != 0) {
+      continue;
+    }
+    
+    ast_node_t* literal = ast_create_integer(binding->values[i]);
+    if (literal == NULL) {
+      binding->failed = true;
+      return;
+    }
+    
+    literal->location = (*use)->location;
+    ast_destroy_node(*use);
+    *use = literal;
+    return;
+  }
+}
+
+/**
+ * @brief Replace the uses of variables by constants in a whole function.
+ * 
+ * @param function The function AST node.
+ * @param binding The constants.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool bind_function(ast_node_t* function, spec_binding_t* binding) {
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      ir_visit_uses(block->data.stmt_block.statements.nodes[j], bind_use, binding);
+    }
+  }
+  return !binding->failed;
+}
+
+/**
+ * @brief Fold instructions whose operands are all constants.
+ * 
+ * Only variables with a single definition are folded; their uses are
+ * replaced by the value and the definition is removed. Values no literal
+ * can hold are left alone.
+ * 
+ * @param function The function AST node.
+ * @param changed Set to true if anything was folded.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool fold_constants(ast_node_t* function, bool* changed) {
+  ir_var_table_t* vars = ir_var_table_create();
+  if (vars == NULL) {
+    return false;
+  }
+  
+  /* Count the definitions of each variable, parameters included */
+  size_t def_count = function->data.function.parameters.count + function_size(function);
+  size_t* defs = (size_t*)calloc(def_count + 1, sizeof(size_t));
+  bool success = defs != NULL;
+  
+  for (size_t i = 0; i < function->data.function.parameters.count && success; i++) {
+    ast_node_t* param = function->data.function.parameters.nodes[i];
+    int32_t id = ir_var_table_intern(vars, param->data.parameter.name);
+    success = id >= 0;
+    if (success) {
+      defs[id]++;
+    }
+  }
+  
+  for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count && success; j++) {
+      const char* def = ir_get_def(block->data.stmt_block.statements.nodes[j]);
+      if (def != NULL) {
+        int32_t id = ir_var_table_intern(vars, def);
+        success = id >= 0;
+        if (success) {
+          defs[id]++;
+        }
+      }
+    }
+  }
+  
+  /* Fold single definitions with constant operands */
+  const char** names = NULL;
+  int64_t* values = NULL;
+  size_t folded = 0;
+  if (success) {
+    names = (const char**)malloc((def_count + 1) * sizeof(const char*));
+    values = (int64_t*)malloc((def_count + 1) * sizeof(int64_t));
+    success = names != NULL && values != NULL;
+  }
+  
+  ast_node_list_t removed = { NULL, 0, 0 };
+  for (size_t i = 0; i < function->data.function.blocks.count && success; i++) {
+    ast_node_list_t* statements =
+      &function->data.function.blocks.nodes[i]->data.stmt_block.statements;
+    size_t kept = 0;
+    for (size_t j = 0; j < statements->count; j++) {
+      ast_node_t* stmt = statements->nodes[j];
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      const char* def = ir_get_def(stmt);
+      bool fold = success && def != NULL && instruction != NULL &&
+                  defs[ir_var_table_find(vars, def)] == 1 &&
+                  instruction->data.stmt_instruction.operands.count <= 2;
+      
+      int64_t operands[2];
+      for (size_t k = 0; fold && k < instruction->data.stmt_instruction.operands.count; k++) {
+        const ast_node_t* operand = instruction->data.stmt_instruction.operands.nodes[k];
+        fold = operand->type == AST_EXPR_INTEGER;
+        operands[k] = fold ? operand->data.expr_integer.value : 0;
+      }
+      
+      /* Literals compare by value */
+      uint8_t opcode = fold ? ir_get_opcode(stmt) : 0;
+      const ast_node_t* type = ir_is_comparison(opcode) ? NULL : stmt->data.stmt_assign.target_type;
+      if (fold && ir_fold_integer(opcode, type, operands,
+                                  instruction->data.stmt_instruction.operands.count,
+                                  &values[folded]) &&
+          ir_integer_literal(stmt->data.stmt_assign.target_type, values[folded],
+                             &values[folded])) {
+        /* The name stays valid until the removed statements are destroyed */
+        names[folded++] = def;
+        success = ast_add_node(&removed, stmt);
+        if (success) {
+          continue;
+        }
+      }
+      
+      statements->nodes[kept++] = stmt;
+    }
+    statements->count = kept;
+  }
+  
+  if (success && folded > 0) {
+    spec_binding_t binding = { names, values, folded, false };
+    success = bind_function(function, &binding);
+    *changed = true;
+  }
+  
+  ast_destroy_node_list(&removed);
+  free(names);
+  free(values);
+  free(defs);
+  ir_var_table_destroy(vars);
+  
+  return success;
+}
+
+/**
+ * @brief Turn branches on constant conditions into unconditional branches.
+ * 
+ * @param function The function AST node.
+ * @param changed Set to true if a branch was changed.
+ */
+static void fold_branches(ast_node_t* function, bool* changed) {
+  for (size_t i = 0; i < function->data.function.blocks.count; i++) {
+    ast_node_t* block = function->data.function.blocks.nodes[i];
+    for (size_t j = 0; j < block->data.stmt_block.statements.count; j++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[j];
+      if (stmt->type != AST_STMT_BRANCH || stmt->data.stmt_branch.condition == NULL ||
+          stmt->data.stmt_branch.condition->type != AST_EXPR_INTEGER ||
+          stmt->data.stmt_branch.false_target == NULL) {
+        continue;
+      }
+      
+      if (stmt->data.stmt_branch.condition->data.expr_integer.value == 0) {
+        free(stmt->data.stmt_branch.true_target);
+        stmt->data.stmt_branch.true_target = stmt->data.stmt_branch.false_target;
+      } else {
+        free(stmt->data.stmt_branch.false_target);
+      }
+      stmt->data.stmt_branch.false_target = NULL;
+      
+      ast_destroy_node(stmt->data.stmt_branch.condition);
+      stmt->data.stmt_branch.condition = NULL;
+      *changed = true;
+    }
+  }
+}
+
+/**
+ * @brief Remove the blocks that cannot be reached from the entry block.
+ * 
+ * @param function The function AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool remove_unreachable_blocks(ast_node_t* function) {
+  cfg_t* cfg = cfg_build(function);
+  if (cfg == NULL) {
+    return false;
+  }
+  
+  size_t count = cfg_block_count(cfg);
+  ir_bitset_t reached;
+  size_t* stack = (size_t*)malloc((count + 1) * sizeof(size_t));
+  if (stack == NULL || !ir_bitset_init(&reached, count)) {
+    free(stack);
+    cfg_destroy(cfg);
+    return false;
+  }
+  
+  size_t top = 0;
+  if (count > 0) {
+    ir_bitset_set(&reached, 0);
+    stack[top++] = 0;
+  }
+  
+  while (top > 0) {
+    size_t block = stack[--top];
+    for (size_t i = 0; i < cfg_successor_count(cfg, block); i++) {
+      size_t succ = cfg_get_successor(cfg, block, i);
+      if (!ir_bitset_test(&reached, succ)) {
+        ir_bitset_set(&reached, succ);
+        stack[top++] = succ;
+      }
+    }
+  }
+  cfg_destroy(cfg);
+  
+  ast_node_list_t* blocks = &function->data.function.blocks;
+  size_t kept = 0;
+  for (size_t i = 0; i < blocks->count; i++) {
+    if (ir_bitset_test(&reached, i)) {
+      blocks->nodes[kept++] = blocks->nodes[i];
+    } else {
+      ast_destroy_node(blocks->nodes[i]);
+    }
+  }
+  blocks->count = kept;
+  
+  ir_bitset_free(&reached);
+  free(stack);
+  return true;
+}
+
+/**
+ * @brief Propagate constants through a function until nothing changes.
+ * 
+ * @param function The function AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool simplify_function(ast_node_t* function) {
+  bool changed = true;
+  bool success = true;
+  
+  while (changed && success) {
+    changed = false;
+    success = fold_constants(function, &changed);
+    fold_branches(function, &changed);
+  }
+  
+  return success && remove_unreachable_blocks(function);
+}
+
+/**
+ * @brief Remove the nodes of a list at the positions that hold constants.
+ * 
+ * @param list The node list.
+ * @param is_constant Whether each position holds a constant.
+ */
+static void remove_constant_positions(ast_node_list_t* list, const bool* is_constant) {
+  size_t kept = 0;
+  for (size_t i = 0; i < list->count; i++) {
+    if (is_constant[i]) {
+      ast_destroy_node(list->nodes[i]);
+    } else {
+      list->nodes[kept++] = list->nodes[i];
+    }
+  }
+  list->count = kept;
+}
+
+/**
+ * @brief Create the clone of a function for one constant argument tuple.
+ * 
+ * Parameters bound to constants are removed. A parameter the body never
+ * assigns is replaced by its value everywhere; one it does assign becomes a
+ * local initialized at the top of the entry block.
+ * 
+ * @param spec The specializer state.
+ * @param callee The function to clone.
+ * @param args The arguments of one call site of the group.
+ * @param is_constant Whether each argument is bound to a constant.
+ * @return The clone, or NULL if the function cannot be specialized.
+ */
+static ast_node_t* create_specialization(specializer_t* spec, const ast_node_t* callee,
+                                         const ast_node_list_t* args, const bool* is_constant) {
+  ast_node_t* entry = callee->data.function.blocks.nodes[0];
+  size_t param_count = callee->data.function.parameters.count;
+  bool entry_is_target = is_branch_target(callee, entry->data.stmt_block.label);
+  
+  /* Initializing an assigned parameter in a loop header would reset it */
+  for (size_t i = 0; i < param_count; i++) {
+    const ast_node_t* param = callee->data.function.parameters.nodes[i];
+    if (is_constant[i] && entry_is_target && is_assigned(callee, param->data.parameter.name)) {
+      return NULL;
+    }
+  }
+  
+  char buffer[64];
+  do {
+    snprintf(buffer, sizeof(buffer), SPECIALIZED_PREFIX "%zu", spec->next_id++);
+  } while (symtable_lookup(spec->globals, buffer, false) != NULL);
+  
+  ast_node_t* clone = ast_clone_node(callee);
+  char* name = strdup(buffer);
+  const char** names = (const char**)malloc((param_count + 1) * sizeof(const char*));
+  int64_t* values = (int64_t*)malloc((param_count + 1) * sizeof(int64_t));
+  bool success = clone != NULL && name != NULL && names != NULL && values != NULL;
+  if (success) {
+    free(clone->data.function.name);
+    clone->data.function.name = name;
+    clone->data.function.is_internal = true;
+    name = NULL;
+  }
+  
+  /* Bind the parameters the body only reads, initialize the others */
+  spec_binding_t binding = { names, values, 0, false };
+  ast_node_list_t* statements =
+    success ? &clone->data.function.blocks.nodes[0]->data.stmt_block.statements : NULL;
+  for (size_t i = 0; i < param_count && success; i++) {
+    if (!is_constant[i]) {
+      continue;
+    }
+    
+    const ast_node_t* param = callee->data.function.parameters.nodes[i];
+    /* Every position bound to a constant holds one */
+    int64_t value = 0;
+    constant_argument(param, args->nodes[i], &value);
+    if (!is_assigned(callee, param->data.parameter.name)) {
+      names[binding.count] = param->data.parameter.name;
+      values[binding.count] = value;
+      binding.count++;
+      continue;
+    }
+    
+    ast_node_t* init = ast_create_instruction("ADD");
+    ast_node_t* lhs = ast_create_integer(value);
+    ast_node_t* rhs = ast_create_integer(0);
+    success = init != NULL && lhs != NULL && rhs != NULL &&
+              ast_add_node(&init->data.stmt_instruction.operands, lhs);
+    if (!success) {
+      ast_destroy_node(lhs);
+    }
+    success = success && ast_add_node(&init->data.stmt_instruction.operands, rhs);
+    if (!success) {
+      ast_destroy_node(rhs);
+      ast_destroy_node(init);
+      break;
+    }
+    
+    ast_node_t* assign = ast_create_assignment(param->data.parameter.name, init);
+    if (assign == NULL) {
+      ast_destroy_node(init);
+      success = false;
+      break;
+    }
+    assign->location = entry->location;
+    assign->data.stmt_assign.target_type = param->data.parameter.type;
+    
+    success = ast_add_node(statements, assign);
+    if (!success) {
+      ast_destroy_node(assign);
+      break;
+    }
+    memmove(&statements->nodes[1], &statements->nodes[0],
+            (statements->count - 1) * sizeof(ast_node_t*));
+    statements->nodes[0] = assign;
+  }
+  
+  if (success) {
+    remove_constant_positions(&clone->data.function.parameters, is_constant);
+    success = bind_function(clone, &binding) && simplify_function(clone);
+  }
+  
+  free(name);
+  free(names);
+  free(values);
+  
+  /* Register the function with the module */
+  symbol_entry_t* symbol = NULL;
+  if (success) {
+    success = ast_add_node(&spec->module->data.module.declarations, clone);
+    if (success) {
+      symbol = symtable_add(spec->globals, clone->data.function.name, SYMBOL_FUNCTION, clone);
+      if (symbol == NULL) {
+        spec->module->data.module.declarations.count--;
+        success = false;
+      }
+    }
+  }
+  
+  if (!success) {
+    ast_destroy_node(clone);
+    spec->failed = true;
+    return NULL;
+  }
+  
+  symtable_set_type(symbol, clone->data.function.return_type);
+  symtable_mark_defined(symbol);
+  
+  return clone;
+}
+
+/**
+ * @brief Specialize the callee of a group and redirect its call sites.
+ * 
+ * @param spec The specializer state.
+ * @param group The group.
+ * @return true if the callee was specialized, false otherwise.
+ */
+static bool specialize_group(specializer_t* spec, const spec_group_t* group) {
+  const spec_site_t* first = &spec->sites[group->first];
+  const ast_node_t* callee = spec->callees[first->callee];
+  const ast_node_list_t* args = &first->call->data.expr_call.arguments;
+  
+  bool* is_constant = (bool*)calloc(args->count + 1, sizeof(bool));
+  if (is_constant == NULL) {
+    spec->failed = true;
+    return false;
+  }
+  
+  for (size_t i = 0; i < args->count; i++) {
+    int64_t value;
+    is_constant[i] = constant_argument(callee->data.function.parameters.nodes[i], args->nodes[i],
+                                       &value);
+  }
+  
+  ast_node_t* clone = create_specialization(spec, callee, args, is_constant);
+  for (size_t i = 0; clone != NULL && i < group->count; i++) {
+    ast_node_t* call = spec->sites[group->first + i].call;
+    ast_node_t* name = ast_create_identifier(clone->data.function.name);
+    if (name == NULL) {
+      spec->failed = true;
+      break;
+    }
+    
+    name->location = call->data.expr_call.function->location;
+    ast_destroy_node(call->data.expr_call.function);
+    call->data.expr_call.function = name;
+    remove_constant_positions(&call->data.expr_call.arguments, is_constant);
+  }
+  
+  if (clone != NULL) {
+    optimize_remark(spec->context, HOILC_REMARK_PASSED, callee, NULL, "Specialized",
+                    "specialized '%s' as '%s' for the constant arguments of %zu calls",
+                    callee->data.function.name, clone->data.function.name, group->count);
+  }
+  
+  free(is_constant);
+  return clone != NULL;
+}
+
+bool pass_specialize(optimize_context_t* context, ast_node_t* module) {
+  assert(context != NULL);
+  assert(module != NULL);
+  assert(module->type == AST_MODULE);
+  
+  specializer_t spec;
+  memset(&spec, 0, sizeof(spec));
+  spec.context = context;
+  spec.globals = optimize_get_symbol_table(context);
+  spec.module = module;
+  spec.names = ir_var_table_create();
+  
+  size_t declaration_count = module->data.module.declarations.count;
+  spec.callees = (ast_node_t**)calloc(declaration_count + 1, sizeof(ast_node_t*));
+  spec.failed = spec.names == NULL || spec.callees == NULL;
+  
+  /* Number the functions that own a body and may be cloned for their callers */
+  size_t module_size = 0;
+  for (size_t i = 0; i < declaration_count && !spec.failed; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type != AST_FUNCTION || decl->data.function.alias != NULL ||
+        decl->data.function.target != NULL || decl->data.function.versions.count > 0 ||
+        (decl->data.function.attributes & FUNCTION_ATTRIBUTE_NOINLINE) != 0 ||
+        decl->data.function.blocks.count == 0) {
+      continue;
+    }
+    
+    int32_t id = ir_var_table_intern(spec.names, decl->data.function.name);
+    spec.failed = id < 0;
+    if (!spec.failed) {
+      spec.callees[id] = decl;
+      module_size += function_size(decl);
+    }
+  }
+  
+  /* Collect the calls passing constants */
+  for (size_t i = 0; i < declaration_count && !spec.failed; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type != AST_FUNCTION) {
+      continue;
+    }
+    
+    for (size_t b = 0; b < decl->data.function.blocks.count; b++) {
+      ast_node_t* block = decl->data.function.blocks.nodes[b];
+      for (size_t s = 0; s < block->data.stmt_block.statements.count; s++) {
+        ast_node_t* call = get_call(block->data.stmt_block.statements.nodes[s]);
+        if (call != NULL) {
+          scan_call(&spec, call);
+        }
+      }
+    }
+  }
+  
+  /* Group the calls sharing a callee and a tuple */
+  spec_group_t* groups = NULL;
+  size_t group_count = 0;
+  if (!spec.failed && spec.site_count > 0) {
+    qsort(spec.sites, spec.site_count, sizeof(spec_site_t), compare_sites);
+    groups = (spec_group_t*)malloc(spec.site_count * sizeof(spec_group_t));
+    spec.failed = groups == NULL;
+  }
+  
+  for (size_t i = 0; i < spec.site_count && !spec.failed; i++) {
+    const spec_site_t* site = &spec.sites[i];
+    spec_group_t* group = group_count > 0 ? &groups[group_count - 1] : NULL;
+    const spec_site_t* head = group != NULL ? &spec.sites[group->first] : NULL;
+    
+    if (head != NULL && head->callee == site->callee && head->hash == site->hash &&
+        ir_key_equal(&head->key, &site->key)) {
+      group->count++;
+    } else {
+      groups[group_count].first = i;
+      groups[group_count].count = 1;
+      group_count++;
+    }
+  }
+  
+  /* The most shared tuples are specialized first, within the growth budget */
+  if (group_count > 0) {
+    qsort(groups, group_count, sizeof(spec_group_t), compare_groups);
+  }
+  
+  size_t budget = module_size * SPECIALIZE_GROWTH_PERCENT / 100;
+  if (budget < SPECIALIZE_MIN_GROWTH) {
+    budget = SPECIALIZE_MIN_GROWTH;
+  }
+  
+  size_t growth = 0;
+  for (size_t i = 0; i < group_count && !spec.failed; i++) {
+    if (groups[i].count < SPECIALIZE_MIN_CALLS) {
+      break;
+    }
+    
+    const ast_node_t* callee = spec.callees[spec.sites[groups[i].first].callee];
+    size_t size = function_size(callee);
+    if (size > SPECIALIZE_MAX_STATEMENTS) {
+      optimize_remark(context, HOILC_REMARK_MISSED, callee, NULL, "TooLarge",
+                      "'%s' not specialized: %zu statements exceed the limit of %d",
+                      callee->data.function.name, size, SPECIALIZE_MAX_STATEMENTS);
+      continue;
+    }
+    if (growth + size > budget) {
+      optimize_remark(context, HOILC_REMARK_MISSED, callee, NULL, "GrowthBudget",
+                      "'%s' not specialized: the module growth budget of %zu statements "
+                      "is spent", callee->data.function.name, budget);
+      continue;
+    }
+    
+    if (specialize_group(&spec, &groups[i])) {
+      growth += size;
+    }
+  }
+  
+  for (size_t i = 0; i < spec.site_count; i++) {
+    ir_key_free(&spec.sites[i].key);
+  }
+  free(spec.sites);
+  free(groups);
+  free(spec.callees);
+  ir_var_table_destroy(spec.names);
+  
+  if (spec.failed) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL, module,
+                         "Memory allocation failed");
+    return false;
+  }
+  
+  return true;
+}
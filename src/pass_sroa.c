@@ -0,0 +1,781 @@
+/**
+ * @file pass_sroa.c
+ * @brief Scalar replacement of aggregates.
+ * 
+ * This file contains a pass that splits structure and fixed-size array
+ * locals into one scalar local per element. An aggregate qualifies when
+ * every definition loads it whole through a pointer and every use either
+ * reads one element at a constant position or stores it whole; the loads
+ * and stores are then narrowed to the elements actually read.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/passes.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Prefix of the element variables.
+ */
+#define SROA_PREFIX "__hoilc_sroa_"
+
+/**
+ * @brief Most elements an aggregate is split into.
+ */
+#define SROA_MAX_ELEMENTS 16
+
+/**
+ * @brief Most rounds, each splitting one more level of nested aggregates.
+ */
+#define SROA_MAX_ROUNDS 4
+
+/**
+ * @brief What is known about one variable.
+ */
+typedef struct {
+  ast_node_t* type;         /**< Aggregate type of its definitions, NULL if not splittable. */
+  ast_node_t* def;          /**< First definition, the whole load that set the type. */
+  size_t element_count;     /**< Number of elements of the type. */
+  size_t defs;              /**< Number of definitions. */
+  size_t stores;            /**< Number of whole stores. */
+  size_t uses;              /**< Number of uses. */
+  size_t accesses;          /**< Uses that are element reads or whole stores. */
+  uint32_t needed;          /**< Mask of the elements read. */
+  bool rejected;            /**< Whether some definition or use rules out splitting. */
+  bool split;               /**< Whether the variable is being split. */
+  char* elements[SROA_MAX_ELEMENTS]; /**< Element variable names, once split. */
+} sroa_var_t;
+
+/**
+ * @brief Scalar replacement state for one function.
+ */
+typedef struct {
+  optimize_context_t* context; /**< Optimizer context. */
+  symbol_table_t* globals;  /**< Global symbol table. */
+  ast_node_t* function;     /**< Function AST node. */
+  bool size_only;           /**< Whether splits may not add statements. */
+  ir_var_table_t* vars;     /**< Parameters, locals and block labels. */
+  sroa_var_t* info;         /**< Facts about each variable. */
+  size_t next_id;           /**< Counter for fresh names in the function. */
+  bool failed;              /**< Whether memory allocation failed. */
+} sroa_t;
+
+/**
+ * @brief Get the fields of a structure type.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param type The type.
+ * @return The fields, or NULL if the type is not a structure.
+ */
+static const ast_node_list_t* struct_fields(const sroa_t* sroa, const ast_node_t* type) {
+  if (type == NULL) {
+    return NULL;
+  }
+  
+  if (type->type == AST_TYPE_STRUCT) {
+    return &type->data.type_struct.fields;
+  }
+  
+  if (type->type == AST_TYPE_NAME) {
+    symbol_entry_t* entry = symtable_lookup(sroa->globals, type->data.type_name.name, false);
+    if (entry != NULL && symtable_get_kind(entry) == SYMBOL_TYPE) {
+      return &symtable_get_node(entry)->data.type_def.fields;
+    }
+  }
+  
+  return NULL;
+}
+
+/**
+ * @brief Count the elements of an aggregate type.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param type The type.
+ * @return The number of fields or array elements, 0 if the type is not a
+ *         sized aggregate.
+ */
+static size_t element_count(const sroa_t* sroa, const ast_node_t* type) {
+  const ast_node_list_t* fields = struct_fields(sroa, type);
+  if (fields != NULL) {
+    return fields->count;
+  }
+  
+  if (type != NULL && type->type == AST_TYPE_ARRAY) {
+    return type->data.type_array.size;
+  }
+  
+  return 0;
+}
+
+/**
+ * @brief Get the type of an element of an aggregate type.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param type The aggregate type.
+ * @param element The element position.
+ * @return The element type.
+ */
+static ast_node_t* element_type(const sroa_t* sroa, const ast_node_t* type, size_t element) {
+  const ast_node_list_t* fields = struct_fields(sroa, type);
+  if (fields != NULL) {
+    return fields->nodes[element]->data.field.type;
+  }
+  
+  return type->data.type_array.element_type;
+}
+
+/**
+ * @brief Find the variable an expression names.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param expr The expression.
+ * @return The variable number, or -1 if the expression is not a variable.
+ */
+static int32_t named_var(const sroa_t* sroa, const ast_node_t* expr) {
+  if (expr->type != AST_EXPR_IDENTIFIER) {
+    return -1;
+  }
+  
+  return ir_var_table_find(sroa->vars, expr->data.expr_identifier.name);
+}
+
+/**
+ * @brief Check whether an expression reads one element of a variable.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param expr The expression.
+ * @param element Where to store the element position.
+ * @return The variable number, or -1 if the expression is not such a read.
+ */
+static int32_t element_read(const sroa_t* sroa, const ast_node_t* expr, size_t* element) {
+  if (expr->type == AST_EXPR_FIELD && !expr->data.expr_field.is_address) {
+    *element = expr->data.expr_field.index;
+    return named_var(sroa, expr->data.expr_field.object);
+  }
+  
+  if (expr->type == AST_EXPR_INDEX && !expr->data.expr_index.is_address) {
+    const ast_node_t* index = expr->data.expr_index.index;
+    if (index->type != AST_EXPR_INTEGER || index->data.expr_integer.value < 0) {
+      return -1;
+    }
+    *element = (size_t)index->data.expr_integer.value;
+    return named_var(sroa, expr->data.expr_index.array);
+  }
+  
+  return -1;
+}
+
+/**
+ * @brief Use visitor that counts the uses of a variable.
+ * 
+ * @param use Slot holding the identifier expression.
+ * @param data The scalar replacement state.
+ */
+static void count_use(ast_node_t** use, void* data) {
+  sroa_t* sroa = (sroa_t*)data;
+  int32_t id = named_var(sroa, *use);
+  if (id >= 0) {
+    sroa->info[id].uses++;
+  }
+}
+
+/**
+ * @brief Check whether an expression uses a variable.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param expr The expression.
+ * @param id The variable number.
+ * @return true if the variable appears in the expression.
+ */
+static bool uses_var(const sroa_t* sroa, const ast_node_t* expr, int32_t id) {
+  if (expr == NULL) {
+    return false;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_IDENTIFIER:
+      return named_var(sroa, expr) == id;
+    
+    case AST_EXPR_FIELD:
+      return uses_var(sroa, expr->data.expr_field.object, id);
+    
+    case AST_EXPR_INDEX:
+      return uses_var(sroa, expr->data.expr_index.array, id) ||
+             uses_var(sroa, expr->data.expr_index.index, id);
+    
+    case AST_EXPR_CALL:
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        if (uses_var(sroa, expr->data.expr_call.arguments.nodes[i], id)) {
+          return true;
+        }
+      }
+      return uses_var(sroa, expr->data.expr_call.function, id);
+    
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Record the element reads in an expression.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param expr The expression.
+ */
+static void scan_expr(sroa_t* sroa, const ast_node_t* expr) {
+  if (expr == NULL) {
+    return;
+  }
+  
+  size_t element;
+  int32_t id = element_read(sroa, expr, &element);
+  if (id >= 0) {
+    sroa_var_t* var = &sroa->info[id];
+    if (element < SROA_MAX_ELEMENTS) {
+      var->accesses++;
+      var->needed |= UINT32_C(1) << element;
+    } else {
+      var->rejected = true;
+    }
+    return;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_FIELD:
+      scan_expr(sroa, expr->data.expr_field.object);
+      break;
+    
+    case AST_EXPR_INDEX:
+      scan_expr(sroa, expr->data.expr_index.array);
+      scan_expr(sroa, expr->data.expr_index.index);
+      break;
+    
+    case AST_EXPR_CALL:
+      scan_expr(sroa, expr->data.expr_call.function);
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        scan_expr(sroa, expr->data.expr_call.arguments.nodes[i]);
+      }
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Get the variable a statement loads whole from memory.
+ * 
+ * Accesses asserting an alignment are not split, since the elements would
+ * not share it.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param stmt The statement.
+ * @return The variable number, or -1 if the statement is not such a load.
+ */
+static int32_t whole_load(const sroa_t* sroa, ast_node_t* stmt) {
+  const char* def = ir_get_def(stmt);
+  if (def == NULL || ir_get_opcode(stmt) != OPCODE_LOAD ||
+      ir_get_instruction(stmt)->data.stmt_instruction.operands.count != 1 ||
+      ir_get_instruction(stmt)->data.stmt_instruction.alignment != 0) {
+    return -1;
+  }
+  
+  return ir_var_table_find(sroa->vars, def);
+}
+
+/**
+ * @brief Get the variable a statement stores whole to memory.
+ * 
+ * Like loads, stores asserting an alignment are not split.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param stmt The statement.
+ * @return The variable number, or -1 if the statement is not such a store.
+ */
+static int32_t whole_store(const sroa_t* sroa, ast_node_t* stmt) {
+  if (stmt->type != AST_STMT_INSTRUCTION || ir_get_opcode(stmt) != OPCODE_STORE ||
+      stmt->data.stmt_instruction.operands.count != 2 ||
+      stmt->data.stmt_instruction.alignment != 0) {
+    return -1;
+  }
+  
+  return named_var(sroa, stmt->data.stmt_instruction.operands.nodes[1]);
+}
+
+/**
+ * @brief Record the definitions and uses of one statement.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param stmt The statement.
+ */
+static void scan_statement(sroa_t* sroa, ast_node_t* stmt) {
+  ir_visit_uses(stmt, count_use, sroa);
+  
+  const char* def = ir_get_def(stmt);
+  int32_t id = def != NULL ? ir_var_table_find(sroa->vars, def) : -1;
+  if (id >= 0) {
+    sroa_var_t* var = &sroa->info[id];
+    var->defs++;
+    if (whole_load(sroa, stmt) != id) {
+      var->rejected = true;
+    } else if (var->type == NULL) {
+      var->type = stmt->data.stmt_assign.target_type;
+      var->def = stmt;
+      var->element_count = element_count(sroa, var->type);
+    }
+  }
+  
+  /* The address of a whole load or store must not depend on the aggregate */
+  int32_t stored = whole_store(sroa, stmt);
+  int32_t moved = stored >= 0 ? stored : whole_load(sroa, stmt);
+  if (moved >= 0 &&
+      uses_var(sroa, ir_get_instruction(stmt)->data.stmt_instruction.operands.nodes[0], moved)) {
+    sroa->info[moved].rejected = true;
+  }
+  
+  if (stored >= 0) {
+    sroa->info[stored].stores++;
+    sroa->info[stored].accesses++;
+  }
+  
+  switch (stmt->type) {
+    case AST_STMT_BRANCH:
+      scan_expr(sroa, stmt->data.stmt_branch.condition);
+      break;
+    
+    case AST_STMT_RETURN:
+      scan_expr(sroa, stmt->data.stmt_return.value);
+      break;
+    
+    default: {
+      ast_node_t* instruction = ir_get_instruction(stmt);
+      for (size_t i = 0; instruction != NULL &&
+                         i < instruction->data.stmt_instruction.operands.count; i++) {
+        scan_expr(sroa, instruction->data.stmt_instruction.operands.nodes[i]);
+      }
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Count the set bits of an element mask.
+ * 
+ * @param mask The mask.
+ * @return The number of elements in the mask.
+ */
+static size_t mask_count(uint32_t mask) {
+  size_t count = 0;
+  for (; mask != 0; mask &= mask - 1) {
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief Decide whether a variable is split, and name its elements if so.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param id The variable number.
+ * @return true if the variable is split.
+ */
+static bool choose_split(sroa_t* sroa, int32_t id) {
+  sroa_var_t* var = &sroa->info[id];
+  if (var->rejected || var->type == NULL || var->element_count == 0 ||
+      var->element_count > SROA_MAX_ELEMENTS || (var->needed >> var->element_count) != 0 ||
+      var->uses != var->accesses || var->accesses == 0) {
+    return false;
+  }
+  
+  /* Whole stores write every element */
+  if (var->stores > 0) {
+    var->needed = (uint32_t)((UINT64_C(1) << var->element_count) - 1);
+  }
+  
+  size_t needed = mask_count(var->needed);
+  if (sroa->size_only && var->defs * needed + var->stores * var->element_count >
+                         var->defs + var->stores) {
+    return false;
+  }
+  
+  var->split = true;
+  for (size_t e = 0; e < var->element_count; e++) {
+    if ((var->needed & (UINT32_C(1) << e)) == 0) {
+      continue;
+    }
+    
+    char buffer[64];
+    do {
+      snprintf(buffer, sizeof(buffer), SROA_PREFIX "%zu", sroa->next_id++);
+    } while (ir_var_table_find(sroa->vars, buffer) >= 0 ||
+             symtable_lookup(sroa->globals, buffer, false) != NULL);
+    
+    var->elements[e] = strdup(buffer);
+    if (var->elements[e] == NULL) {
+      sroa->failed = true;
+      return false;
+    }
+  }
+  
+  optimize_remark(sroa->context, HOILC_REMARK_PASSED, sroa->function, var->def, "Split",
+                  "split aggregate '%s' into %zu scalars", ir_var_table_name(sroa->vars, id),
+                  needed);
+  return true;
+}
+
+/**
+ * @brief Explain why an aggregate was not split.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param id The variable number.
+ */
+static void remark_kept(sroa_t* sroa, int32_t id) {
+  const sroa_var_t* var = &sroa->info[id];
+  if (var->type == NULL || var->element_count == 0) {
+    return;
+  }
+  
+  const char* reason = "splitting would add statements";
+  if (var->element_count > SROA_MAX_ELEMENTS) {
+    reason = "it has too many elements";
+  } else if (var->rejected || (var->needed >> var->element_count) != 0 ||
+             var->uses != var->accesses || var->accesses == 0) {
+    reason = "it is accessed other than by whole loads and stores and constant element reads";
+  }
+  
+  optimize_remark(sroa->context, HOILC_REMARK_MISSED, sroa->function, var->def, "NotSplit",
+                  "aggregate '%s' not split: %s", ir_var_table_name(sroa->vars, id), reason);
+}
+
+/**
+ * @brief Replace the element reads of split variables in an expression.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param slot Slot holding the expression.
+ */
+static void rewrite_expr(sroa_t* sroa, ast_node_t** slot) {
+  ast_node_t* expr = *slot;
+  if (expr == NULL || sroa->failed) {
+    return;
+  }
+  
+  size_t element;
+  int32_t id = element_read(sroa, expr, &element);
+  if (id >= 0 && element < SROA_MAX_ELEMENTS && sroa->info[id].elements[element] != NULL) {
+    ast_node_t* scalar = ast_create_identifier(sroa->info[id].elements[element]);
+    if (scalar == NULL) {
+      sroa->failed = true;
+      return;
+    }
+    scalar->location = expr->location;
+    ast_destroy_node(expr);
+    *slot = scalar;
+    return;
+  }
+  
+  switch (expr->type) {
+    case AST_EXPR_FIELD:
+      rewrite_expr(sroa, &expr->data.expr_field.object);
+      break;
+    
+    case AST_EXPR_INDEX:
+      rewrite_expr(sroa, &expr->data.expr_index.array);
+      rewrite_expr(sroa, &expr->data.expr_index.index);
+      break;
+    
+    case AST_EXPR_CALL:
+      rewrite_expr(sroa, &expr->data.expr_call.function);
+      for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
+        rewrite_expr(sroa, &expr->data.expr_call.arguments.nodes[i]);
+      }
+      break;
+    
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Create the address of one element of an aggregate in memory.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param address The address of the aggregate (copied).
+ * @param type The aggregate type.
+ * @param element The element position.
+ * @return The address expression, or NULL if memory allocation failed.
+ */
+static ast_node_t* element_address(const sroa_t* sroa, const ast_node_t* address,
+                                   const ast_node_t* type, size_t element) {
+  const ast_node_list_t* fields = struct_fields(sroa, type);
+  ast_node_t* base = ast_clone_node(address);
+  ast_node_t* expr = ast_create_node(fields != NULL ? AST_EXPR_FIELD : AST_EXPR_INDEX);
+  if (base == NULL || expr == NULL) {
+    ast_destroy_node(base);
+    ast_destroy_node(expr);
+    return NULL;
+  }
+  expr->location = address->location;
+  
+  if (fields != NULL) {
+    expr->data.expr_field.object = base;
+    expr->data.expr_field.field = strdup(fields->nodes[element]->data.field.name);
+    expr->data.expr_field.index = (uint32_t)element;
+    expr->data.expr_field.is_address = true;
+    if (expr->data.expr_field.field == NULL) {
+      ast_destroy_node(expr);
+      return NULL;
+    }
+  } else {
+    expr->data.expr_index.array = base;
+    expr->data.expr_index.index = ast_create_integer((int64_t)element);
+    expr->data.expr_index.is_address = true;
+    if (expr->data.expr_index.index == NULL) {
+      ast_destroy_node(expr);
+      return NULL;
+    }
+  }
+  
+  return expr;
+}
+
+/**
+ * @brief Create one element load or store of a split whole load or store.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param stmt The whole load or store.
+ * @param var The split variable.
+ * @param element The element position.
+ * @return The statement, or NULL if memory allocation failed.
+ */
+static ast_node_t* split_access(const sroa_t* sroa, ast_node_t* stmt, const sroa_var_t* var,
+                                size_t element) {
+  ast_node_t* instruction = ir_get_instruction(stmt);
+  ast_node_t* address = element_address(sroa, instruction->data.stmt_instruction.operands.nodes[0],
+                                        var->type, element);
+  ast_node_t* access = ast_create_instruction(instruction->data.stmt_instruction.opcode);
+  bool success = address != NULL && access != NULL &&
+                 ast_add_node(&access->data.stmt_instruction.operands, address);
+  if (!success) {
+    ast_destroy_node(address);
+    ast_destroy_node(access);
+    return NULL;
+  }
+  access->location = instruction->location;
+  access->data.stmt_instruction.flags = instruction->data.stmt_instruction.flags;
+  
+  /* A store writes the element variable to the element address */
+  if (stmt->type == AST_STMT_INSTRUCTION) {
+    ast_node_t* value = ast_create_identifier(var->elements[element]);
+    if (value == NULL || !ast_add_node(&access->data.stmt_instruction.operands, value)) {
+      ast_destroy_node(value);
+      ast_destroy_node(access);
+      return NULL;
+    }
+    value->location = instruction->data.stmt_instruction.operands.nodes[1]->location;
+    return access;
+  }
+  
+  /* A load defines the element variable */
+  ast_node_t* assign = ast_create_assignment(var->elements[element], access);
+  if (assign == NULL) {
+    ast_destroy_node(access);
+    return NULL;
+  }
+  assign->location = stmt->location;
+  assign->data.stmt_assign.target_type = element_type(sroa, var->type, element);
+  return assign;
+}
+
+/**
+ * @brief Rewrite the statements of a block for the split variables.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param block The block AST node.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool rewrite_block(sroa_t* sroa, ast_node_t* block) {
+  ast_node_list_t* statements = &block->data.stmt_block.statements;
+  ast_node_list_t result = { NULL, 0, 0 };
+  bool success = true;
+  
+  size_t i = 0;
+  for (; i < statements->count && success; i++) {
+    ast_node_t* stmt = statements->nodes[i];
+    switch (stmt->type) {
+      case AST_STMT_BRANCH:
+        rewrite_expr(sroa, &stmt->data.stmt_branch.condition);
+        break;
+      
+      case AST_STMT_RETURN:
+        rewrite_expr(sroa, &stmt->data.stmt_return.value);
+        break;
+      
+      default: {
+        ast_node_t* instruction = ir_get_instruction(stmt);
+        for (size_t j = 0; instruction != NULL &&
+                           j < instruction->data.stmt_instruction.operands.count; j++) {
+          rewrite_expr(sroa, &instruction->data.stmt_instruction.operands.nodes[j]);
+        }
+        break;
+      }
+    }
+    
+    /* Whole loads and stores of split variables become one access per element */
+    int32_t id = whole_load(sroa, stmt);
+    id = id >= 0 ? id : whole_store(sroa, stmt);
+    const sroa_var_t* var = id >= 0 && sroa->info[id].split ? &sroa->info[id] : NULL;
+    if (var == NULL || sroa->failed) {
+      success = !sroa->failed && ast_add_node(&result, stmt);
+      if (!success) {
+        ast_destroy_node(stmt);
+      }
+      continue;
+    }
+    
+    for (size_t e = 0; e < var->element_count && success; e++) {
+      if (var->elements[e] == NULL) {
+        continue;
+      }
+      ast_node_t* access = split_access(sroa, stmt, var, e);
+      success = access != NULL && ast_add_node(&result, access);
+      if (access != NULL && !success) {
+        ast_destroy_node(access);
+      }
+    }
+    ast_destroy_node(stmt);
+  }
+  
+  /* On failure the statements not reached yet are dropped with the rest */
+  for (; i < statements->count; i++) {
+    ast_destroy_node(statements->nodes[i]);
+  }
+  free(statements->nodes);
+  *statements = result;
+  return success;
+}
+
+/**
+ * @brief Number the parameters, locals and labels of the function.
+ * 
+ * Parameters are never split; their layout belongs to the caller.
+ * 
+ * @param sroa The scalar replacement state.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool index_variables(sroa_t* sroa) {
+  ast_node_t* function = sroa->function;
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    if (ir_var_table_intern(sroa->vars,
+                            function->data.function.parameters.nodes[i]->data.parameter.name) < 0) {
+      return false;
+    }
+  }
+  
+  for (size_t b = 0; b < function->data.function.blocks.count; b++) {
+    ast_node_t* block = function->data.function.blocks.nodes[b];
+    if (ir_var_table_intern(sroa->vars, block->data.stmt_block.label) < 0) {
+      return false;
+    }
+    
+    ast_node_list_t* statements = &block->data.stmt_block.statements;
+    for (size_t i = 0; i < statements->count; i++) {
+      const char* def = ir_get_def(statements->nodes[i]);
+      if (def != NULL && symtable_lookup(sroa->globals, def, false) == NULL &&
+          ir_var_table_intern(sroa->vars, def) < 0) {
+        return false;
+      }
+    }
+  }
+  
+  size_t count = ir_var_table_count(sroa->vars);
+  sroa->info = (sroa_var_t*)calloc(count + 1, sizeof(sroa_var_t));
+  if (sroa->info == NULL) {
+    return false;
+  }
+  
+  for (size_t i = 0; i < function->data.function.parameters.count; i++) {
+    sroa->info[i].rejected = true;
+  }
+  return true;
+}
+
+/**
+ * @brief Split the aggregates of a function one nesting level deep.
+ * 
+ * @param sroa The scalar replacement state.
+ * @param changed Where to store whether anything was split.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool split_round(sroa_t* sroa, bool* changed) {
+  *changed = false;
+  sroa->vars = ir_var_table_create();
+  if (sroa->vars == NULL || !index_variables(sroa)) {
+    return false;
+  }
+  
+  ast_node_list_t* blocks = &sroa->function->data.function.blocks;
+  for (size_t b = 0; b < blocks->count; b++) {
+    ast_node_list_t* statements = &blocks->nodes[b]->data.stmt_block.statements;
+    for (size_t i = 0; i < statements->count; i++) {
+      scan_statement(sroa, statements->nodes[i]);
+    }
+  }
+  
+  size_t count = ir_var_table_count(sroa->vars);
+  for (size_t v = 0; v < count && !sroa->failed; v++) {
+    *changed = choose_split(sroa, (int32_t)v) || *changed;
+  }
+  
+  /* The last round sees every aggregate left whole */
+  for (size_t v = 0; v < count && !*changed && optimize_wants_remarks(sroa->context); v++) {
+    remark_kept(sroa, (int32_t)v);
+  }
+  
+  bool success = !sroa->failed;
+  for (size_t b = 0; b < blocks->count && success && *changed; b++) {
+    success = rewrite_block(sroa, blocks->nodes[b]);
+  }
+  
+  for (size_t v = 0; v < count; v++) {
+    for (size_t e = 0; e < SROA_MAX_ELEMENTS; e++) {
+      free(sroa->info[v].elements[e]);
+    }
+  }
+  free(sroa->info);
+  sroa->info = NULL;
+  ir_var_table_destroy(sroa->vars);
+  sroa->vars = NULL;
+  return success;
+}
+
+bool pass_sroa(optimize_context_t* context, ast_node_t* function) {
+  assert(context != NULL);
+  assert(function != NULL);
+  assert(function->type == AST_FUNCTION);
+  
+  sroa_t sroa;
+  memset(&sroa, 0, sizeof(sroa));
+  sroa.context = context;
+  sroa.globals = optimize_get_symbol_table(context);
+  sroa.function = function;
+  sroa.size_only = optimize_get_level(context) == HOILC_OPT_SIZE;
+  
+  bool success = true;
+  bool changed = true;
+  for (int round = 0; round < SROA_MAX_ROUNDS && changed && success; round++) {
+    success = split_round(&sroa, &changed);
+  }
+  
+  if (!success) {
+    error_report_at_node(optimize_get_error_context(context), HOILC_ERROR_INTERNAL,
+                         function, "Memory allocation failed");
+  }
+  
+  return success;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file remark.c
+ * @brief Implementation of optimization remarks.
+ * 
+ * This file contains the remark log and its diagnostic and JSON output.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/remark.h"
+#include "../include/util.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Remark log structure implementation.
+ */
+struct remark_log {
+  remark_t* remarks;     /**< Recorded remarks. */
+  size_t count;          /**< Number of remarks. */
+  size_t capacity;       /**< Capacity of the remarks array. */
+};
+
+remark_log_t* remark_create_log(void) {
+  remark_log_t* log = (remark_log_t*)malloc(sizeof(remark_log_t));
+  if (log == NULL) {
+    return NULL;
+  }
+  
+  log->remarks = NULL;
+  log->count = 0;
+  log->capacity = 0;
+  
+  return log;
+}
+
+/**
+ * @brief Free the strings of a remark.
+ * 
+ * @param remark The remark.
+ */
+static void release_remark(remark_t* remark) {
+  free(remark->pass);
+  free(remark->name);
+  free(remark->function);
+  free(remark->filename);
+  free(remark->message);
+}
+
+void remark_destroy_log(remark_log_t* log) {
+  if (log == NULL) {
+    return;
+  }
+  
+  for (size_t i = 0; i < log->count; i++) {
+    release_remark(&log->remarks[i]);
+  }
+  free(log->remarks);
+  free(log);
+}
+
+/**
+ * @brief Copy an optional string.
+ * 
+ * @param str The string, or NULL.
+ * @param failed Set to true if memory allocation failed.
+ * @return The copy, or NULL.
+ */
+static char* copy_string(const char* str, bool* failed) {
+  if (str == NULL) {
+    return NULL;
+  }
+  
+  char* copy = util_strdup(str);
+  if (copy == NULL) {
+    *failed = true;
+  }
+  return copy;
+}
+
+bool remark_add(remark_log_t* log, hoilc_remark_kind_t kind, const char* pass,
+                const char* name, const char* function, const source_location_t* location,
+                const char* message) {
+  assert(log != NULL);
+  assert(kind < HOILC_REMARK_COUNT);
+  assert(pass != NULL && name != NULL && message != NULL);
+  
+  if (log->count == log->capacity) {
+    size_t capacity = log->capacity == 0 ? 16 : log->capacity * 2;
+    remark_t* remarks = (remark_t*)realloc(log->remarks, capacity * sizeof(remark_t));
+    if (remarks == NULL) {
+      return false;
+    }
+    log->remarks = remarks;
+    log->capacity = capacity;
+  }
+  
+  bool failed = false;
+  remark_t* remark = &log->remarks[log->count];
+  remark->kind = kind;
+  remark->pass = copy_string(pass, &failed);
+  remark->name = copy_string(name, &failed);
+  remark->function = copy_string(function, &failed);
+  remark->filename = location != NULL ? copy_string(location->filename, &failed) : NULL;
+  remark->line = location != NULL ? location->line : 0;
+  remark->column = location != NULL ? location->column : 0;
+  remark->message = copy_string(message, &failed);
+  
+  if (failed) {
+    release_remark(remark);
+    return false;
+  }
+  
+  log->count++;
+  return true;
+}
+
+size_t remark_count(const remark_log_t* log) {
+  assert(log != NULL);
+  
+  return log->count;
+}
+
+const remark_t* remark_get(const remark_log_t* log, size_t index) {
+  assert(log != NULL);
+  assert(index < log->count);
+  
+  return &log->remarks[index];
+}
+
+const char* remark_kind_name(hoilc_remark_kind_t kind) {
+  switch (kind) {
+    case HOILC_REMARK_PASSED:
+      return "passed";
+    case HOILC_REMARK_MISSED:
+      return "missed";
+    case HOILC_REMARK_ANALYSIS:
+      return "analysis";
+    default:
+      return "unknown";
+  }
+}
+
+void remark_print(const remark_t* remark, FILE* file) {
+  assert(remark != NULL);
+  assert(file != NULL);
+  
+  static const char* const options[HOILC_REMARK_COUNT] = {
+    "-Rpass", "-Rpass-missed", "-Rpass-analysis"
+  };
+  
+  if (remark->line > 0) {
+    fprintf(file, "%s:%d:%d: ", remark->filename != NULL ? remark->filename : "<input>",
+            remark->line, remark->column);
+  }
+  fprintf(file, "remark: %s [%s=%s]\n", remark->message, options[remark->kind], remark->pass);
+}
+
+/**
+ * @brief Write a JSON string literal.
+ * 
+ * @param str The string, or NULL to write null.
+ * @param file The stream to write to.
+ */
+static void write_json_string(const char* str, FILE* file) {
+  if (str == NULL) {
+    fputs("null", file);
+    return;
+  }
+  
+  fputc('"', file);
+  for (const unsigned char* p = (const unsigned char*)str; *p != '\0'; p++) {
+    switch (*p) {
+      case '"':
+        fputs("\\\"", file);
+        break;
+      case '\\':
+        fputs("\\\\", file);
+        break;
+      case '\n':
+        fputs("\\n", file);
+        break;
+      case '\t':
+        fputs("\\t", file);
+        break;
+      default:
+        if (*p < 0x20) {
+          fprintf(file, "\\u%04x", *p);
+        } else {
+          fputc(*p, file);
+        }
+        break;
+    }
+  }
+  fputc('"', file);
+}
+
+bool remark_write_json(const remark_log_t* log, FILE* file) {
+  assert(log != NULL);
+  assert(file != NULL);
+  
+  fputs("[", file);
+  for (size_t i = 0; i < log->count; i++) {
+    const remark_t* remark = &log->remarks[i];
+    
+    fputs(i == 0 ? "\n  {" : ",\n  {", file);
+    fputs("\"kind\": ", file);
+    write_json_string(remark_kind_name(remark->kind), file);
+    fputs(", \"pass\": ", file);
+    write_json_string(remark->pass, file);
+    fputs(", \"name\": ", file);
+    write_json_string(remark->name, file);
+    fputs(", \"function\": ", file);
+    write_json_string(remark->function, file);
+    fputs(", \"location\": ", file);
+    if (remark->line > 0) {
+      fputs("{\"file\": ", file);
+      write_json_string(remark->filename, file);
+      fprintf(file, ", \"line\": %d, \"column\": %d}", remark->line, remark->column);
+    } else {
+      fputs("null", file);
+    }
+    fputs(", \"message\": ", file);
+    write_json_string(remark->message, file);
+    fputs("}", file);
+  }
+  fputs(log->count == 0 ? "]\n" : "\n]\n", file);
+  
+  return !ferror(file);
+}
@@ -9,6 +9,9 @@
  */
 
 #include "../include/typecheck.h"
+#include "../include/binary.h"
+#include "../include/machine.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
@@ -45,6 +48,50 @@ static ast_node_t* create_basic_type(ast_node_type_t type) {
   return node;
 }
 
+/**
+ * @brief Create the pointer type of a field or element address.
+ * 
+ * @param element_type The field or element type (shared, not copied).
+ * @param memory_space The memory space of the base pointer (can be NULL).
+ * @return The created type node, or NULL on allocation failure.
+ */
+static ast_node_t* create_address_type(ast_node_t* element_type, const char* memory_space) {
+  ast_node_t* node = create_basic_type(AST_TYPE_PTR);
+  if (node == NULL) {
+    return NULL;
+  }
+  
+  node->data.type_ptr.element_type = element_type;
+  if (memory_space != NULL) {
+    node->data.type_ptr.memory_space = strdup(memory_space);
+    if (node->data.type_ptr.memory_space == NULL) {
+      free(node);
+      return NULL;
+    }
+  }
+  
+  return node;
+}
+
+/**
+ * @brief Create a vector type AST node.
+ * 
+ * @param element_type The element type (shared, not copied).
+ * @param lanes The number of lanes.
+ * @return The created type node, or NULL on allocation failure.
+ */
+static ast_node_t* create_vector_type(ast_node_t* element_type, uint32_t lanes) {
+  ast_node_t* node = create_basic_type(AST_TYPE_VEC);
+  if (node == NULL) {
+    return NULL;
+  }
+  
+  node->data.type_vec.element_type = element_type;
+  node->data.type_vec.size = lanes;
+  
+  return node;
+}
+
 /**
  * @brief Forward declarations for recursive type checking functions.
  */
@@ -57,10 +104,18 @@ static bool typecheck_block(typecheck_context_t* context, ast_node_t* block, sym
 static bool typecheck_statement(typecheck_context_t* context, ast_node_t* statement, symbol_table_t* local_table);
 static bool typecheck_assignment(typecheck_context_t* context, ast_node_t* assignment, symbol_table_t* local_table);
 static bool typecheck_instruction(typecheck_context_t* context, ast_node_t* instruction, symbol_table_t* local_table);
+static ast_node_t* typecheck_instruction_type(typecheck_context_t* context, ast_node_t* instruction, symbol_table_t* local_table);
 static bool typecheck_branch(typecheck_context_t* context, ast_node_t* branch, symbol_table_t* local_table);
 static bool typecheck_return(typecheck_context_t* context, ast_node_t* ret, symbol_table_t* local_table);
 static ast_node_t* resolve_type(typecheck_context_t* context, ast_node_t* type);
 static ast_node_t* typecheck_expr(typecheck_context_t* context, ast_node_t* expr, symbol_table_t* local_table);
+static ast_node_t* typecheck_direct_call(typecheck_context_t* context, ast_node_t* call, ast_node_t* callee, symbol_table_t* local_table);
+static ast_node_t* typecheck_vector_operation(typecheck_context_t* context, ast_node_t* instruction, ast_node_t** operand_types);
+static ast_node_t* typecheck_atomic_operation(typecheck_context_t* context, ast_node_t* instruction, ast_node_t** operand_types);
+static ast_node_t* typecheck_prefetch(typecheck_context_t* context, ast_node_t* instruction, ast_node_t** operand_types);
+static ast_node_t* typecheck_bit_operation(typecheck_context_t* context, ast_node_t* instruction, ast_node_t** operand_types);
+static ast_node_t* typecheck_extended_arithmetic(typecheck_context_t* context, ast_node_t* instruction, ast_node_t** operand_types);
+static bool typecheck_access_modifiers(typecheck_context_t* context, ast_node_t* instruction, ast_node_t** operand_types);
 
 typecheck_context_t* typecheck_create_context(error_context_t* error_ctx) {
   assert(error_ctx != NULL);
@@ -114,6 +169,161 @@ void typecheck_destroy_context(typecheck_context_t* context) {
   free(context);
 }
 
+/**
+ * @brief Check that the attributes of a function do not contradict each other.
+ * 
+ * @param context The type checker context.
+ * @param decl The function or external function AST node.
+ * @param attributes The function_attribute_t flags of the declaration.
+ * @return true if the attributes are consistent, false otherwise.
+ */
+static bool typecheck_attributes(typecheck_context_t* context, ast_node_t* decl, 
+                                 uint32_t attributes) {
+  static const struct {
+    uint32_t first;
+    uint32_t second;
+    const char* names;
+  } conflicts[] = {
+    { FUNCTION_ATTRIBUTE_HOT, FUNCTION_ATTRIBUTE_COLD, "hot and cold" },
+    { FUNCTION_ATTRIBUTE_INLINE, FUNCTION_ATTRIBUTE_NOINLINE, "inline and noinline" },
+  };
+  
+  for (size_t i = 0; i < sizeof(conflicts) / sizeof(conflicts[0]); i++) {
+    if ((attributes & conflicts[i].first) != 0 && (attributes & conflicts[i].second) != 0) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, decl,
+                          "Conflicting function attributes: %s", conflicts[i].names);
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Find a target declaration by name.
+ * 
+ * Targets have their own namespace, so they are looked up among the module
+ * declarations rather than in the symbol table.
+ * 
+ * @param module The module AST node.
+ * @param name The target name.
+ * @param limit Number of declarations to search.
+ * @return The target declaration, or NULL if not found.
+ */
+static ast_node_t* find_target(ast_node_t* module, const char* name, size_t limit) {
+  for (size_t i = 0; i < limit; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type == AST_TARGET && strcmp(decl->data.target.name, name) == 0) {
+      return decl;
+    }
+  }
+  
+  return NULL;
+}
+
+/**
+ * @brief Type check a target declaration.
+ * 
+ * @param context The type checker context.
+ * @param module The module AST node.
+ * @param index The index of the target among the module declarations.
+ * @return true if the target is valid, false otherwise.
+ */
+static bool typecheck_target(typecheck_context_t* context, ast_node_t* module, size_t index) {
+  ast_node_t* target = module->data.module.declarations.nodes[index];
+  
+  if (find_target(module, target->data.target.name, index) != NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, target,
+                        "Duplicate target definition: %s", target->data.target.name);
+    return false;
+  }
+  
+  if (target->data.target.model != NULL && 
+      machine_find_model(target->data.target.model) == NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, target,
+                        "Unknown machine model: %s", target->data.target.model);
+    return false;
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Check the targets a function is versioned for.
+ * 
+ * @param context The type checker context.
+ * @param module The module AST node.
+ * @param function The function AST node.
+ * @return true if every target is declared once in the list, false otherwise.
+ */
+static bool typecheck_versions(typecheck_context_t* context, ast_node_t* module, 
+                               ast_node_t* function) {
+  ast_node_list_t* versions = &function->data.function.versions;
+  for (size_t i = 0; i < versions->count; i++) {
+    ast_node_t* version = versions->nodes[i];
+    const char* name = version->data.expr_identifier.name;
+    
+    if (find_target(module, name, module->data.module.declarations.count) == NULL) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, version,
+                          "Unknown target: %s", name);
+      return false;
+    }
+    
+    for (size_t j = 0; j < i; j++) {
+      if (strcmp(versions->nodes[j]->data.expr_identifier.name, name) == 0) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, version,
+                            "Duplicate target for function %s: %s", 
+                            function->data.function.name, name);
+        return false;
+      }
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Add a version of a checked function for one of its targets.
+ * 
+ * The version is a copy of the function named function.target, which no
+ * HOIL identifier can spell, compiled for a copy of the target.
+ * 
+ * @param context The type checker context.
+ * @param module The module AST node.
+ * @param function The function AST node.
+ * @param version The identifier of the target.
+ * @return true on success, false if memory allocation failed.
+ */
+static bool add_version(typecheck_context_t* context, ast_node_t* module, 
+                        ast_node_t* function, ast_node_t* version) {
+  const char* target_name = version->data.expr_identifier.name;
+  ast_node_t* target = find_target(module, target_name, module->data.module.declarations.count);
+  
+  size_t length = strlen(function->data.function.name) + strlen(target_name) + 2;
+  char* name = (char*)malloc(length);
+  ast_node_t* clone = ast_clone_node(function);
+  ast_node_t* target_copy = ast_clone_node(target);
+  if (name == NULL || clone == NULL || target_copy == NULL) {
+    free(name);
+    ast_destroy_node(clone);
+    ast_destroy_node(target_copy);
+    return false;
+  }
+  
+  snprintf(name, length, "%s.%s", function->data.function.name, target_name);
+  free(clone->data.function.name);
+  clone->data.function.name = name;
+  clone->data.function.target = target_copy;
+  ast_destroy_node_list(&clone->data.function.versions);
+  
+  if (!ast_add_node(&module->data.module.declarations, clone)) {
+    ast_destroy_node(clone);
+    return false;
+  }
+  
+  return symtable_add(context->global_table, name, SYMBOL_FUNCTION, clone) != NULL;
+}
+
 bool typecheck_module(typecheck_context_t* context, ast_node_t* module) {
   assert(context != NULL);
   assert(module != NULL);
@@ -192,11 +402,18 @@ bool typecheck_module(typecheck_context_t* context, ast_node_t* module) {
         break;
         
       case AST_FUNCTION:
-        success = typecheck_function(context, decl);
+        success = typecheck_function(context, decl) && 
+                  typecheck_attributes(context, decl, decl->data.function.attributes) &&
+                  typecheck_versions(context, module, decl);
         break;
         
       case AST_EXTERN_FUNCTION:
-        success = typecheck_extern_function(context, decl);
+        success = typecheck_extern_function(context, decl) &&
+                  typecheck_attributes(context, decl, decl->data.extern_function.attributes);
+        break;
+        
+      case AST_TARGET:
+        success = typecheck_target(context, module, i);
         break;
         
       default:
@@ -210,6 +427,23 @@ bool typecheck_module(typecheck_context_t* context, ast_node_t* module) {
     }
   }
   
+  /* Third pass: add the versions of multiversioned functions */
+  size_t declaration_count = module->data.module.declarations.count;
+  for (size_t i = 0; i < declaration_count; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type != AST_FUNCTION) {
+      continue;
+    }
+    
+    for (size_t j = 0; j < decl->data.function.versions.count; j++) {
+      if (!add_version(context, module, decl, decl->data.function.versions.nodes[j])) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, decl,
+                            "Memory allocation failed");
+        return false;
+      }
+    }
+  }
+  
   return true;
 }
 
@@ -254,7 +488,13 @@ bool typecheck_are_types_compatible(typecheck_context_t* context,
         return type1->data.type_float.bits == type2->data.type_float.bits;
         
       case AST_TYPE_PTR:
-        /* Pointer types are compatible if their element types are compatible */
+        /* Pointer types are compatible if their element types are compatible and */
+        /* they do not name different memory spaces; restrict does not matter */
+        if (type1->data.type_ptr.memory_space != NULL &&
+            type2->data.type_ptr.memory_space != NULL &&
+            strcmp(type1->data.type_ptr.memory_space, type2->data.type_ptr.memory_space) != 0) {
+          return false;
+        }
         return typecheck_are_types_compatible(context, 
                                              type1->data.type_ptr.element_type, 
                                              type2->data.type_ptr.element_type);
@@ -274,9 +514,11 @@ bool typecheck_are_types_compatible(typecheck_context_t* context,
                                              type2->data.type_array.element_type);
         
       case AST_TYPE_STRUCT:
-        /* Structure types are compatible if they are the same structure */
+        /* Structure types are compatible if they are the same structure; */
+        /* structures resolved from one type definition share its field list */
         /* This is a simplification; in a full implementation, structural equality should be checked */
-        return type1 == type2;
+        return type1 == type2 || 
+               type1->data.type_struct.fields.nodes == type2->data.type_struct.fields.nodes;
         
       case AST_TYPE_FUNCTION:
         /* Function types are compatible if their return types and parameter types are compatible */
@@ -333,9 +575,36 @@ bool typecheck_are_types_compatible(typecheck_context_t* context,
   return false;
 }
 
+/**
+ * @brief Check whether a value may be stored where a type is expected.
+ * 
+ * Used for call arguments and vector lanes. Integer and float literals
+ * adapt to the expected type of their kind.
+ * 
+ * @param context The type checker context.
+ * @param expected The expected type.
+ * @param operand The value operand.
+ * @param type The value type.
+ * @return true if the value fits the expected type, false otherwise.
+ */
+static bool typecheck_value_fits(typecheck_context_t* context, ast_node_t* expected,
+                                 ast_node_t* operand, ast_node_t* type) {
+  expected = resolve_type(context, expected);
+  if (expected == NULL) {
+    return false;
+  }
+  
+  return (operand->type == AST_EXPR_INTEGER && expected->type == AST_TYPE_INT) ||
+         (operand->type == AST_EXPR_FLOAT && expected->type == AST_TYPE_FLOAT) ||
+         typecheck_are_types_compatible(context, expected, type);
+}
+
 /**
  * @brief Resolve a type node to its underlying type.
  * 
+ * A resolved named type shares the fields of its definition, so it is never
+ * stored back into a declaration, which would free them twice.
+ * 
  * @param context The type checker context.
  * @param type The type node to resolve.
  * @return The resolved type node, or NULL if the type cannot be resolved.
@@ -376,6 +645,13 @@ static ast_node_t* resolve_type(typecheck_context_t* context, ast_node_t* type)
     return struct_type;
   }
   
+  if (type->type == AST_TYPE_PTR && type->data.type_ptr.memory_space != NULL &&
+      coil_lookup_memory_space(type->data.type_ptr.memory_space) < 0) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, type,
+                        "Unknown memory space: %s", type->data.type_ptr.memory_space);
+    return NULL;
+  }
+  
   return type;
 }
 
@@ -396,14 +672,10 @@ static bool typecheck_type_def(typecheck_context_t* context, ast_node_t* type_de
     ast_node_t* field = type_def->data.type_def.fields.nodes[i];
     assert(field->type == AST_FIELD);
     
-    /* Resolve the field type */
-    ast_node_t* field_type = resolve_type(context, field->data.field.type);
-    if (field_type == NULL) {
+    /* Check that the field type resolves */
+    if (resolve_type(context, field->data.field.type) == NULL) {
       return false;
     }
-    
-    /* Replace the field type with the resolved type */
-    field->data.field.type = field_type;
   }
   
   /* Mark the type as defined */
@@ -433,9 +705,6 @@ static bool typecheck_constant(typecheck_context_t* context, ast_node_t* constan
     return false;
   }
   
-  /* Replace the constant type with the resolved type */
-  constant->data.constant.type = const_type;
-  
   /* Type check the constant value */
   ast_node_t* value_type = typecheck_expr(context, constant->data.constant.value, 
                                          context->global_table);
@@ -486,9 +755,6 @@ static bool typecheck_global(typecheck_context_t* context, ast_node_t* global) {
     return false;
   }
   
-  /* Replace the global variable type with the resolved type */
-  global->data.global.type = global_type;
-  
   /* Check initializer, if present */
   if (global->data.global.initializer != NULL) {
     ast_node_t* init_type = typecheck_expr(context, global->data.global.initializer, 
@@ -541,9 +807,6 @@ static bool typecheck_function(typecheck_context_t* context, ast_node_t* functio
     return false;
   }
   
-  /* Replace the return type with the resolved type */
-  function->data.function.return_type = return_type;
-  
   /* Create a local symbol table for the function */
   symbol_table_t* function_table = symtable_create_child(context->global_table);
   if (function_table == NULL) {
@@ -564,9 +827,6 @@ static bool typecheck_function(typecheck_context_t* context, ast_node_t* functio
       return false;
     }
     
-    /* Replace the parameter type with the resolved type */
-    param->data.parameter.type = param_type;
-    
     /* Add the parameter to the function table */
     symbol_entry_t* entry = symtable_add(function_table, param->data.parameter.name, 
                                         SYMBOL_PARAMETER, param);
@@ -654,22 +914,15 @@ static bool typecheck_extern_function(typecheck_context_t* context, ast_node_t*
     return false;
   }
   
-  /* Replace the return type with the resolved type */
-  extern_function->data.extern_function.return_type = return_type;
-  
   /* Check parameter types */
   for (size_t i = 0; i < extern_function->data.extern_function.parameters.count; i++) {
     ast_node_t* param = extern_function->data.extern_function.parameters.nodes[i];
     assert(param->type == AST_PARAMETER);
     
-    /* Resolve the parameter type */
-    ast_node_t* param_type = resolve_type(context, param->data.parameter.type);
-    if (param_type == NULL) {
+    /* Check that the parameter type resolves */
+    if (resolve_type(context, param->data.parameter.type) == NULL) {
       return false;
     }
-    
-    /* Replace the parameter type with the resolved type */
-    param->data.parameter.type = param_type;
   }
   
   /* Mark the function as defined */
@@ -764,7 +1017,9 @@ static bool typecheck_assignment(typecheck_context_t* context, ast_node_t* assig
   if (entry == NULL) {
     /* If not found, create a new local variable */
     ast_node_t* value = assignment->data.stmt_assign.value;
-    ast_node_t* value_type = typecheck_expr(context, value, local_table);
+    ast_node_t* value_type = value->type == AST_STMT_INSTRUCTION ?
+      typecheck_instruction_type(context, value, local_table) :
+      typecheck_expr(context, value, local_table);
     if (value_type == NULL) {
       return false;
     }
@@ -779,6 +1034,7 @@ static bool typecheck_assignment(typecheck_context_t* context, ast_node_t* assig
     
     /* Set the variable type */
     symtable_set_type(entry, value_type);
+    assignment->data.stmt_assign.target_type = value_type;
     
     /* Mark the variable as defined */
     symtable_mark_defined(entry);
@@ -786,7 +1042,9 @@ static bool typecheck_assignment(typecheck_context_t* context, ast_node_t* assig
     /* If found, check that the value type is compatible with the variable type */
     ast_node_t* var_type = symtable_get_type(entry);
     ast_node_t* value = assignment->data.stmt_assign.value;
-    ast_node_t* value_type = typecheck_expr(context, value, local_table);
+    ast_node_t* value_type = value->type == AST_STMT_INSTRUCTION ?
+      typecheck_instruction_type(context, value, local_table) :
+      typecheck_expr(context, value, local_table);
     if (value_type == NULL) {
       return false;
     }
@@ -796,6 +1054,8 @@ static bool typecheck_assignment(typecheck_context_t* context, ast_node_t* assig
                           "Assignment value type does not match variable type");
       return false;
     }
+    
+    assignment->data.stmt_assign.target_type = var_type;
   }
   
   return true;
@@ -811,6 +1071,20 @@ static bool typecheck_assignment(typecheck_context_t* context, ast_node_t* assig
  */
 static bool typecheck_instruction(typecheck_context_t* context, ast_node_t* instruction, 
                                  symbol_table_t* local_table) {
+  return typecheck_instruction_type(context, instruction, local_table) != NULL;
+}
+
+/**
+ * @brief Type check an instruction and determine its result type.
+ * 
+ * @param context The type checker context.
+ * @param instruction The instruction to check.
+ * @param local_table The local symbol table.
+ * @return The instruction result type or NULL on error.
+ */
+static ast_node_t* typecheck_instruction_type(typecheck_context_t* context, 
+                                             ast_node_t* instruction, 
+                                             symbol_table_t* local_table) {
   assert(context != NULL);
   assert(instruction != NULL);
   assert(instruction->type == AST_STMT_INSTRUCTION);
@@ -826,7 +1100,7 @@ static bool typecheck_instruction(typecheck_context_t* context, ast_node_t* inst
     if (operand_types == NULL) {
       error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, instruction,
                           "Memory allocation failed");
-      return false;
+      return NULL;
     }
   }
   
@@ -835,19 +1109,553 @@ static bool typecheck_instruction(typecheck_context_t* context, ast_node_t* inst
     operand_types[i] = typecheck_expr(context, operand, local_table);
     if (operand_types[i] == NULL) {
       free(operand_types);
-      return false;
+      return NULL;
     }
   }
   
-  /* Check that the operand types are valid for the instruction */
-  /* This is a simplified version; a full implementation would check specific requirements */
-  /* for each instruction */
+  /* Derive the result type from the opcode and operand types */
+  const char* opcode = instruction->data.stmt_instruction.opcode;
+  ast_node_t* result_type;
+  if (strcmp(opcode, "SPLAT") == 0 || strcmp(opcode, "EXTRACT") == 0 ||
+      strcmp(opcode, "INSERT") == 0 || strcmp(opcode, "SHUFFLE") == 0 ||
+      strncmp(opcode, "REDUCE_", 7) == 0) {
+    result_type = typecheck_vector_operation(context, instruction, operand_types);
+  } else if (strncmp(opcode, "ATOMIC_", 7) == 0 || strcmp(opcode, "CMPXCHG") == 0 ||
+             strcmp(opcode, "FENCE") == 0) {
+    result_type = typecheck_atomic_operation(context, instruction, operand_types);
+  } else if (strcmp(opcode, "PREFETCH") == 0) {
+    result_type = typecheck_prefetch(context, instruction, operand_types);
+  } else if (strcmp(opcode, "POPCNT") == 0 || strcmp(opcode, "CLZ") == 0 ||
+             strcmp(opcode, "CTZ") == 0 || strcmp(opcode, "BSWAP") == 0 ||
+             strncmp(opcode, "ROT", 3) == 0) {
+    result_type = typecheck_bit_operation(context, instruction, operand_types);
+  } else if (strcmp(opcode, "MULH") == 0 || strstr(opcode, "_WIDE") != NULL ||
+             strstr(opcode, "_SAT") != NULL) {
+    result_type = typecheck_extended_arithmetic(context, instruction, operand_types);
+  } else if (!typecheck_access_modifiers(context, instruction, operand_types)) {
+    result_type = NULL;
+  } else {
+    result_type = typecheck_operation(context, opcode, operand_types,
+                                      instruction->data.stmt_instruction.operands.count);
+  }
   
   /* Clean up */
   if (operand_types != NULL) {
     free(operand_types);
   }
   
+  return result_type;
+}
+
+/**
+ * @brief Get an immediate lane operand of a vector instruction.
+ * 
+ * Lanes and shuffle mask entries are encoded as immediates, so they must
+ * be integer literals.
+ * 
+ * @param context The type checker context.
+ * @param instruction The vector instruction.
+ * @param index The operand index.
+ * @param limit The number of valid lane values.
+ * @param lane Pointer to store the lane.
+ * @return true if the operand is a literal below the limit, false otherwise.
+ */
+static bool typecheck_lane(typecheck_context_t* context, ast_node_t* instruction,
+                           size_t index, uint32_t limit, uint32_t* lane) {
+  ast_node_t* operand = instruction->data.stmt_instruction.operands.nodes[index];
+  if (operand->type != AST_EXPR_INTEGER) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, operand,
+                        "%s lane operand must be an integer literal",
+                        instruction->data.stmt_instruction.opcode);
+    return false;
+  }
+  
+  int64_t value = operand->data.expr_integer.value;
+  if (value < 0 || value >= (int64_t)limit) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, operand,
+                        "%s lane %lld is out of range for %u lanes",
+                        instruction->data.stmt_instruction.opcode, (long long)value, limit);
+    return false;
+  }
+  
+  *lane = (uint32_t)value;
+  return true;
+}
+
+/**
+ * @brief Get a vector operand type of a vector instruction.
+ * 
+ * @param context The type checker context.
+ * @param instruction The vector instruction.
+ * @param type The operand type.
+ * @param index The operand index.
+ * @return The resolved vector type, or NULL on error.
+ */
+static ast_node_t* typecheck_vector_operand(typecheck_context_t* context, ast_node_t* instruction,
+                                           ast_node_t* type, size_t index) {
+  type = resolve_type(context, type);
+  if (type == NULL) {
+    return NULL;
+  }
+  
+  if (type->type != AST_TYPE_VEC) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "Operand %zu of %s must be a vector", index + 1,
+                        instruction->data.stmt_instruction.opcode);
+    return NULL;
+  }
+  
+  /* Lane counts are encoded in one byte */
+  if (type->data.type_vec.size == 0 || type->data.type_vec.size > 0xFF) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "Vector operations support 1 to 255 lanes, not %u",
+                        type->data.type_vec.size);
+    return NULL;
+  }
+  
+  return type;
+}
+
+/**
+ * @brief Type check a vector instruction and determine its result type.
+ * 
+ * SPLAT takes a scalar and a lane count, EXTRACT a vector and a lane,
+ * INSERT a vector, a value and a lane, SHUFFLE two vectors of the same
+ * type and one mask entry per lane, each selecting a lane of the first
+ * vector or, from the lane count on, of the second. The reductions take
+ * a vector of integers or floats.
+ * 
+ * @param context The type checker context.
+ * @param instruction The vector instruction.
+ * @param operand_types The operand types.
+ * @return The instruction result type or NULL on error.
+ */
+static ast_node_t* typecheck_vector_operation(typecheck_context_t* context,
+                                             ast_node_t* instruction,
+                                             ast_node_t** operand_types) {
+  const char* opcode = instruction->data.stmt_instruction.opcode;
+  ast_node_t** operands = instruction->data.stmt_instruction.operands.nodes;
+  size_t count = instruction->data.stmt_instruction.operands.count;
+  
+  size_t expected = strcmp(opcode, "SPLAT") == 0 || strcmp(opcode, "EXTRACT") == 0 ? 2 :
+                    strcmp(opcode, "INSERT") == 0 ? 3 :
+                    strcmp(opcode, "SHUFFLE") == 0 ? 2 : 1;
+  if (strcmp(opcode, "SHUFFLE") == 0 ? count < expected : count != expected) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "%s expects %s%zu operands, got %zu", opcode,
+                        strcmp(opcode, "SHUFFLE") == 0 ? "at least " : "", expected, count);
+    return NULL;
+  }
+  
+  uint32_t lane;
+  if (strcmp(opcode, "SPLAT") == 0) {
+    ast_node_t* element_type = resolve_type(context, operand_types[0]);
+    if (element_type == NULL) {
+      return NULL;
+    }
+    
+    if (element_type->type != AST_TYPE_INT && element_type->type != AST_TYPE_FLOAT &&
+        element_type->type != AST_TYPE_BOOL && element_type->type != AST_TYPE_PTR) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                          "SPLAT value must be a scalar");
+      return NULL;
+    }
+    
+    /* The lane count is checked as the last lane of a 256-lane vector */
+    if (!typecheck_lane(context, instruction, 1, 0x100, &lane)) {
+      return NULL;
+    }
+    if (lane == 0) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, operands[1],
+                          "SPLAT lane count must be positive");
+      return NULL;
+    }
+    
+    ast_node_t* vector_type = create_vector_type(element_type, lane);
+    if (vector_type == NULL) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, instruction,
+                          "Memory allocation failed");
+    }
+    return vector_type;
+  }
+  
+  ast_node_t* vector_type = typecheck_vector_operand(context, instruction, operand_types[0], 0);
+  if (vector_type == NULL) {
+    return NULL;
+  }
+  
+  uint32_t lanes = vector_type->data.type_vec.size;
+  ast_node_t* element_type = vector_type->data.type_vec.element_type;
+  
+  if (strcmp(opcode, "EXTRACT") == 0) {
+    return typecheck_lane(context, instruction, 1, lanes, &lane) ? element_type : NULL;
+  }
+  
+  if (strcmp(opcode, "INSERT") == 0) {
+    if (!typecheck_value_fits(context, element_type, operands[1], operand_types[1])) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                          "INSERT value does not match the vector element type");
+      return NULL;
+    }
+    return typecheck_lane(context, instruction, 2, lanes, &lane) ? vector_type : NULL;
+  }
+  
+  if (strcmp(opcode, "SHUFFLE") == 0) {
+    if (typecheck_vector_operand(context, instruction, operand_types[1], 1) == NULL) {
+      return NULL;
+    }
+    
+    if (!typecheck_are_types_compatible(context, vector_type, operand_types[1])) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                          "SHUFFLE operands must have the same vector type");
+      return NULL;
+    }
+    
+    if (count != 2 + lanes) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                          "SHUFFLE mask has %zu entries for %u lanes", count - 2, lanes);
+      return NULL;
+    }
+    
+    for (size_t i = 2; i < count; i++) {
+      if (!typecheck_lane(context, instruction, i, 2 * lanes, &lane)) {
+        return NULL;
+      }
+    }
+    return vector_type;
+  }
+  
+  /* Reductions */
+  ast_node_t* resolved = resolve_type(context, element_type);
+  if (resolved == NULL) {
+    return NULL;
+  }
+  
+  if (resolved->type != AST_TYPE_INT && resolved->type != AST_TYPE_FLOAT) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "%s requires a vector of integers or floats", opcode);
+    return NULL;
+  }
+  
+  return element_type;
+}
+
+/**
+ * @brief Check whether a value may be stored in atomically accessed memory.
+ * 
+ * @param context The type checker context.
+ * @param element_type The resolved element type.
+ * @param operand The value operand.
+ * @param type The value type.
+ * @return true if the value matches the element type, false otherwise.
+ */
+static bool typecheck_atomic_value(typecheck_context_t* context, ast_node_t* element_type,
+                                   ast_node_t* operand, ast_node_t* type) {
+  return (operand->type == AST_EXPR_INTEGER && element_type->type == AST_TYPE_INT) ||
+         typecheck_are_types_compatible(context, element_type, type);
+}
+
+/**
+ * @brief Type check an atomic instruction or fence and determine its result type.
+ * 
+ * ATOMIC_LOAD takes a pointer, ATOMIC_STORE and ATOMIC_RMW a pointer and a
+ * value, CMPXCHG a pointer, the expected and the desired value, and FENCE
+ * nothing; the parser has already moved the ordering and the operation
+ * into the flags. Accesses must be to an integer, boolean or pointer, and
+ * ATOMIC_RMW other than xchg to an integer. Loads cannot release, stores
+ * cannot acquire, and a fence must order something.
+ * 
+ * @param context The type checker context.
+ * @param instruction The atomic instruction.
+ * @param operand_types The operand types.
+ * @return The instruction result type or NULL on error.
+ */
+static ast_node_t* typecheck_atomic_operation(typecheck_context_t* context,
+                                             ast_node_t* instruction,
+                                             ast_node_t** operand_types) {
+  const char* opcode = instruction->data.stmt_instruction.opcode;
+  ast_node_t** operands = instruction->data.stmt_instruction.operands.nodes;
+  size_t count = instruction->data.stmt_instruction.operands.count;
+  uint8_t order = instruction->data.stmt_instruction.flags & INSTRUCTION_ORDER_MASK;
+  uint8_t op = instruction->data.stmt_instruction.flags >> INSTRUCTION_RMW_SHIFT;
+  
+  bool load = strcmp(opcode, "ATOMIC_LOAD") == 0;
+  bool store = strcmp(opcode, "ATOMIC_STORE") == 0;
+  bool fence = strcmp(opcode, "FENCE") == 0;
+  bool cmpxchg = strcmp(opcode, "CMPXCHG") == 0;
+  
+  size_t expected = fence ? 0 : load ? 1 : cmpxchg ? 3 : 2;
+  if (count != expected) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "%s expects %zu operands, got %zu", opcode, expected, count);
+    return NULL;
+  }
+  
+  if ((load && (order == ORDER_RELEASE || order == ORDER_ACQ_REL)) ||
+      (store && (order == ORDER_ACQUIRE || order == ORDER_ACQ_REL)) ||
+      (fence && order == ORDER_RELAXED)) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "Invalid memory ordering for %s", opcode);
+    return NULL;
+  }
+  
+  if (fence) {
+    return context->void_type;
+  }
+  
+  ast_node_t* pointer_type = resolve_type(context, operand_types[0]);
+  if (pointer_type == NULL) {
+    return NULL;
+  }
+  
+  ast_node_t* element_type = pointer_type->type == AST_TYPE_PTR ?
+    resolve_type(context, pointer_type->data.type_ptr.element_type) : NULL;
+  if (element_type == NULL ||
+      (element_type->type != AST_TYPE_INT && element_type->type != AST_TYPE_BOOL &&
+       element_type->type != AST_TYPE_PTR)) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "%s requires a pointer to an integer, boolean or pointer", opcode);
+    return NULL;
+  }
+  
+  if (strcmp(opcode, "ATOMIC_RMW") == 0 && op != ATOMIC_RMW_XCHG &&
+      element_type->type != AST_TYPE_INT) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "ATOMIC_RMW arithmetic requires a pointer to an integer");
+    return NULL;
+  }
+  
+  for (size_t i = 1; i < count; i++) {
+    if (!typecheck_atomic_value(context, element_type, operands[i], operand_types[i])) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                          "Operand %zu of %s does not match the pointed-to type", i + 1, opcode);
+      return NULL;
+    }
+  }
+  
+  return store ? context->void_type : pointer_type->data.type_ptr.element_type;
+}
+
+/**
+ * @brief Type check a prefetch and determine its result type.
+ * 
+ * PREFETCH takes a pointer and an immediate locality from 0 to 3; the
+ * parser has already moved the read or write access into the flags.
+ * 
+ * @param context The type checker context.
+ * @param instruction The prefetch instruction.
+ * @param operand_types The operand types.
+ * @return The void type, or NULL on error.
+ */
+static ast_node_t* typecheck_prefetch(typecheck_context_t* context, ast_node_t* instruction,
+                                     ast_node_t** operand_types) {
+  size_t count = instruction->data.stmt_instruction.operands.count;
+  if (count != 2) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "PREFETCH expects 2 operands, got %zu", count);
+    return NULL;
+  }
+  
+  ast_node_t* pointer_type = resolve_type(context, operand_types[0]);
+  if (pointer_type == NULL) {
+    return NULL;
+  }
+  if (pointer_type->type != AST_TYPE_PTR) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "PREFETCH requires a pointer");
+    return NULL;
+  }
+  
+  ast_node_t* locality = instruction->data.stmt_instruction.operands.nodes[1];
+  if (locality->type != AST_EXPR_INTEGER || locality->data.expr_integer.value < 0 ||
+      locality->data.expr_integer.value > 3) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, locality,
+                        "PREFETCH locality must be an integer literal from 0 to 3");
+    return NULL;
+  }
+  
+  return context->void_type;
+}
+
+/**
+ * @brief Type check a bit manipulation instruction and determine its result type.
+ * 
+ * POPCNT, CLZ, CTZ and BSWAP take one integer and ROTL and ROTR an integer
+ * and an integer amount; the result has the type of the first operand.
+ * BSWAP swaps whole bytes in pairs, so its width must be a multiple of 16.
+ * 
+ * @param context The type checker context.
+ * @param instruction The instruction.
+ * @param operand_types The operand types.
+ * @return The result type, or NULL on error.
+ */
+static ast_node_t* typecheck_bit_operation(typecheck_context_t* context, ast_node_t* instruction,
+                                          ast_node_t** operand_types) {
+  const char* opcode = instruction->data.stmt_instruction.opcode;
+  size_t count = instruction->data.stmt_instruction.operands.count;
+  size_t expected = strncmp(opcode, "ROT", 3) == 0 ? 2 : 1;
+  if (count != expected) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "%s expects %zu operands, got %zu", opcode, expected, count);
+    return NULL;
+  }
+  
+  ast_node_t* value_type = NULL;
+  for (size_t i = 0; i < count; i++) {
+    ast_node_t* type = resolve_type(context, operand_types[i]);
+    if (type == NULL) {
+      return NULL;
+    }
+    if (type->type != AST_TYPE_INT) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                          "Operand %zu of %s must be an integer", i + 1, opcode);
+      return NULL;
+    }
+    if (i == 0) {
+      value_type = type;
+    }
+  }
+  
+  if (strcmp(opcode, "BSWAP") == 0 && value_type->data.type_int.bits % 16 != 0) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "BSWAP requires a width that is a multiple of 16 bits, got %u",
+                        (unsigned)value_type->data.type_int.bits);
+    return NULL;
+  }
+  
+  return operand_types[0];
+}
+
+/**
+ * @brief Get the integer type of a scalar or the elements of a vector.
+ * 
+ * @param context The type checker context.
+ * @param type The type.
+ * @return The resolved integer type, or NULL if the type is not an integer
+ *         or a vector of integers.
+ */
+static ast_node_t* integer_element_type(typecheck_context_t* context, ast_node_t* type) {
+  if (type->type == AST_TYPE_VEC) {
+    type = resolve_type(context, type->data.type_vec.element_type);
+  }
+  return type != NULL && type->type == AST_TYPE_INT ? type : NULL;
+}
+
+/**
+ * @brief Type check a high, widening or saturating arithmetic instruction.
+ * 
+ * MULH, ADD_WIDE, MUL_WIDE, ADD_SAT and SUB_SAT take two integers or two
+ * integer vectors of the same type, or an integer and an integer literal.
+ * MULH and the saturating operations produce the operand type; the
+ * widening operations produce integers twice as wide with the same
+ * signedness, so their operands have at most 32 bits.
+ * 
+ * @param context The type checker context.
+ * @param instruction The instruction.
+ * @param operand_types The operand types.
+ * @return The result type, or NULL on error.
+ */
+static ast_node_t* typecheck_extended_arithmetic(typecheck_context_t* context,
+                                                ast_node_t* instruction,
+                                                ast_node_t** operand_types) {
+  const char* opcode = instruction->data.stmt_instruction.opcode;
+  size_t count = instruction->data.stmt_instruction.operands.count;
+  if (count != 2) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "%s expects 2 operands, got %zu", opcode, count);
+    return NULL;
+  }
+  
+  ast_node_t* first = resolve_type(context, operand_types[0]);
+  ast_node_t* second = resolve_type(context, operand_types[1]);
+  if (first == NULL || second == NULL) {
+    return NULL;
+  }
+  
+  ast_node_t* element = integer_element_type(context, first);
+  ast_node_t* other = integer_element_type(context, second);
+  if (element == NULL || other == NULL) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "Operands of %s must be integers or integer vectors", opcode);
+    return NULL;
+  }
+  
+  bool literal = first->type == AST_TYPE_INT &&
+                 instruction->data.stmt_instruction.operands.nodes[1]->type == AST_EXPR_INTEGER;
+  bool same = first->type == second->type &&
+              (first->type != AST_TYPE_VEC || first->data.type_vec.size == second->data.type_vec.size) &&
+              element->data.type_int.bits == other->data.type_int.bits &&
+              element->data.type_int.is_signed == other->data.type_int.is_signed;
+  if (!literal && !same) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "Operands of %s must have the same type", opcode);
+    return NULL;
+  }
+  
+  if (strstr(opcode, "_WIDE") == NULL) {
+    return operand_types[0];
+  }
+  
+  if (element->data.type_int.bits > 32) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "%s requires integers of at most 32 bits, got %u", opcode,
+                        (unsigned)element->data.type_int.bits);
+    return NULL;
+  }
+  
+  ast_node_t* wide = create_basic_type(AST_TYPE_INT);
+  ast_node_t* result = wide;
+  if (wide != NULL) {
+    wide->data.type_int.bits = (uint8_t)(element->data.type_int.bits * 2);
+    wide->data.type_int.is_signed = element->data.type_int.is_signed;
+    if (first->type == AST_TYPE_VEC) {
+      result = create_vector_type(wide, first->data.type_vec.size);
+    }
+  }
+  if (result == NULL) {
+    ast_destroy_node(wide);
+    error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, instruction,
+                        "Memory allocation failed");
+  }
+  return result;
+}
+
+/**
+ * @brief Type check the access modifiers of a LOAD or STORE.
+ * 
+ * The modifiers describe a memory access, so they require a pointer
+ * address, and an asserted alignment must be a power of two that the flags
+ * byte can encode.
+ * 
+ * @param context The type checker context.
+ * @param instruction The instruction.
+ * @param operand_types The operand types.
+ * @return true if the modifiers are valid or absent, false otherwise.
+ */
+static bool typecheck_access_modifiers(typecheck_context_t* context, ast_node_t* instruction,
+                                       ast_node_t** operand_types) {
+  const char* opcode = instruction->data.stmt_instruction.opcode;
+  uint32_t alignment = instruction->data.stmt_instruction.alignment;
+  if ((strcmp(opcode, "LOAD") != 0 && strcmp(opcode, "STORE") != 0) ||
+      (alignment == 0 && (instruction->data.stmt_instruction.flags & INSTRUCTION_NONTEMPORAL) == 0)) {
+    return true;
+  }
+  
+  if (alignment != 0 && ((alignment & (alignment - 1)) != 0 || alignment > INSTRUCTION_ALIGN_MAX)) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "Alignment %u is not a power of two up to %d", alignment,
+                        INSTRUCTION_ALIGN_MAX);
+    return false;
+  }
+  
+  ast_node_t* address = instruction->data.stmt_instruction.operands.count > 0 ?
+    resolve_type(context, operand_types[0]) : NULL;
+  if (address == NULL || address->type != AST_TYPE_PTR) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, instruction,
+                        "Access modifiers of %s require a pointer address", opcode);
+    return false;
+  }
+  
   return true;
 }
 
@@ -1040,8 +1848,19 @@ static ast_node_t* typecheck_expr(typecheck_context_t* context, ast_node_t* expr
         return NULL;
       }
       
+      /* A field of a structure behind a pointer is accessed by address */
+      bool is_address = obj_type->type == AST_TYPE_PTR && 
+                        obj_type->data.type_ptr.element_type != NULL;
+      ast_node_t* struct_type = is_address ? obj_type->data.type_ptr.element_type : obj_type;
+      if (struct_type->type == AST_TYPE_NAME) {
+        struct_type = resolve_type(context, struct_type);
+        if (struct_type == NULL) {
+          return NULL;
+        }
+      }
+      
       /* Make sure the object is a structure */
-      if (obj_type->type != AST_TYPE_STRUCT) {
+      if (struct_type->type != AST_TYPE_STRUCT) {
         error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, expr,
                             "Field access on non-structure type");
         return NULL;
@@ -1049,12 +1868,24 @@ static ast_node_t* typecheck_expr(typecheck_context_t* context, ast_node_t* expr
       
       /* Find the field in the structure */
       const char* field_name = expr->data.expr_field.field;
-      for (size_t i = 0; i < obj_type->data.type_struct.fields.count; i++) {
-        ast_node_t* field = obj_type->data.type_struct.fields.nodes[i];
+      for (size_t i = 0; i < struct_type->data.type_struct.fields.count; i++) {
+        ast_node_t* field = struct_type->data.type_struct.fields.nodes[i];
         assert(field->type == AST_FIELD);
         
         if (strcmp(field->data.field.name, field_name) == 0) {
-          return field->data.field.type;
+          expr->data.expr_field.index = (uint32_t)i;
+          expr->data.expr_field.is_address = is_address;
+          if (!is_address) {
+            return field->data.field.type;
+          }
+          
+          ast_node_t* address_type = create_address_type(field->data.field.type, 
+                                                        obj_type->data.type_ptr.memory_space);
+          if (address_type == NULL) {
+            error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
+                                "Memory allocation failed");
+          }
+          return address_type;
         }
       }
       
@@ -1062,8 +1893,74 @@ static ast_node_t* typecheck_expr(typecheck_context_t* context, ast_node_t* expr
                           "Unknown field: %s", field_name);
       return NULL;
     }
+    
+    case AST_EXPR_INDEX: {
+      /* Type check the array and index expressions */
+      ast_node_t* obj_type = typecheck_expr(context, expr->data.expr_index.array, local_table);
+      if (obj_type == NULL) {
+        return NULL;
+      }
+      
+      ast_node_t* index_type = typecheck_expr(context, expr->data.expr_index.index, local_table);
+      if (index_type == NULL) {
+        return NULL;
+      }
+      
+      if (index_type->type != AST_TYPE_INT) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, expr,
+                            "Array index must be an integer");
+        return NULL;
+      }
+      
+      /* An element of an array behind a pointer is accessed by address */
+      bool is_address = obj_type->type == AST_TYPE_PTR && 
+                        obj_type->data.type_ptr.element_type != NULL;
+      ast_node_t* array_type = is_address ? obj_type->data.type_ptr.element_type : obj_type;
+      
+      /* Make sure the object is an array */
+      if (array_type->type != AST_TYPE_ARRAY) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, expr,
+                            "Element access on non-array type");
+        return NULL;
+      }
+      
+      /* Constant indices into sized arrays are checked here */
+      ast_node_t* index = expr->data.expr_index.index;
+      uint32_t size = array_type->data.type_array.size;
+      if (index->type == AST_EXPR_INTEGER && size > 0 && 
+          (index->data.expr_integer.value < 0 || index->data.expr_integer.value >= size)) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_SEMANTIC, expr,
+                            "Array index out of range");
+        return NULL;
+      }
+      
+      expr->data.expr_index.is_address = is_address;
+      if (!is_address) {
+        return array_type->data.type_array.element_type;
+      }
+      
+      ast_node_t* address_type = create_address_type(array_type->data.type_array.element_type, 
+                                                    obj_type->data.type_ptr.memory_space);
+      if (address_type == NULL) {
+        error_report_at_node(context->error_ctx, HOILC_ERROR_INTERNAL, expr,
+                            "Memory allocation failed");
+      }
+      return address_type;
+    }
       
     case AST_EXPR_CALL: {
+      /* Calls naming a declared function are checked against its signature */
+      ast_node_t* callee = expr->data.expr_call.function;
+      if (callee->type == AST_EXPR_IDENTIFIER) {
+        symbol_entry_t* callee_entry = symtable_lookup(local_table, 
+                                                      callee->data.expr_identifier.name, 
+                                                      true);
+        if (callee_entry != NULL && symtable_get_kind(callee_entry) == SYMBOL_FUNCTION) {
+          return typecheck_direct_call(context, expr, symtable_get_node(callee_entry), 
+                                      local_table);
+        }
+      }
+      
       /* Type check the function expression */
       ast_node_t* func_type = typecheck_expr(context, expr->data.expr_call.function, local_table);
       if (func_type == NULL) {
@@ -1112,7 +2009,8 @@ static ast_node_t* typecheck_expr(typecheck_context_t* context, ast_node_t* expr
       /* Check that each argument type is compatible with the corresponding parameter type */
       for (size_t i = 0; i < expr->data.expr_call.arguments.count; i++) {
         ast_node_t* param_type = func_type->data.type_function.parameter_types.nodes[i];
-        if (!typecheck_are_types_compatible(context, param_type, arg_types[i])) {
+        if (!typecheck_value_fits(context, param_type, expr->data.expr_call.arguments.nodes[i],
+                                  arg_types[i])) {
           error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, expr,
                               "Argument type does not match parameter type");
           free(arg_types);
@@ -1136,6 +2034,64 @@ static ast_node_t* typecheck_expr(typecheck_context_t* context, ast_node_t* expr
   }
 }
 
+/**
+ * @brief Type check a direct call to a declared function.
+ * 
+ * @param context The type checker context.
+ * @param call The call expression.
+ * @param callee The FUNCTION or EXTERN declaration being called.
+ * @param local_table The local symbol table.
+ * @return The function return type or NULL on error.
+ */
+static ast_node_t* typecheck_direct_call(typecheck_context_t* context, ast_node_t* call,
+                                        ast_node_t* callee, symbol_table_t* local_table) {
+  assert(context != NULL);
+  assert(call != NULL && call->type == AST_EXPR_CALL);
+  assert(callee != NULL);
+  
+  ast_node_list_t* parameters;
+  ast_node_t* return_type;
+  if (callee->type == AST_FUNCTION) {
+    parameters = &callee->data.function.parameters;
+    return_type = callee->data.function.return_type;
+  } else {
+    assert(callee->type == AST_EXTERN_FUNCTION);
+    parameters = &callee->data.extern_function.parameters;
+    return_type = callee->data.extern_function.return_type;
+  }
+  
+  /* Check that the argument count matches */
+  if (call->data.expr_call.arguments.count != parameters->count) {
+    error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, call,
+                        "Argument count does not match parameter count");
+    return NULL;
+  }
+  
+  /* Check that each argument type is compatible with the corresponding parameter type */
+  for (size_t i = 0; i < call->data.expr_call.arguments.count; i++) {
+    ast_node_t* arg_type = typecheck_expr(context, call->data.expr_call.arguments.nodes[i], 
+                                         local_table);
+    if (arg_type == NULL) {
+      return NULL;
+    }
+    
+    ast_node_t* param_type = resolve_type(context, parameters->nodes[i]->data.parameter.type);
+    if (param_type == NULL) {
+      return NULL;
+    }
+    
+    if (!typecheck_value_fits(context, param_type, call->data.expr_call.arguments.nodes[i],
+                              arg_type)) {
+      error_report_at_node(context->error_ctx, HOILC_ERROR_TYPE, call,
+                          "Argument type does not match parameter type");
+      return NULL;
+    }
+  }
+  
+  /* The callee may not have been checked yet, so resolve its return type here */
+  return resolve_type(context, return_type);
+}
+
 ast_node_t* typecheck_expression(typecheck_context_t* context, ast_node_t* expr, 
                                 symbol_table_t* symtable) {
   return typecheck_expr(context, expr, symtable);
@@ -1150,7 +2106,24 @@ ast_node_t* typecheck_operation(typecheck_context_t* context, const char* opcode
   /* This is a simplified version; a full implementation would check specific requirements */
   /* for each operation type */
   
-  /* For now, just return the type of the first operand */
+  /* Comparisons always produce a boolean */
+  if (strncmp(opcode, "CMP_", 4) == 0) {
+    return context->bool_type;
+  }
+  
+  /* Stores produce no value */
+  if (strcmp(opcode, "STORE") == 0) {
+    return context->void_type;
+  }
+  
+  /* Loads through a pointer produce the element type */
+  if (strcmp(opcode, "LOAD") == 0 && operand_count > 0 && 
+      operand_types[0]->type == AST_TYPE_PTR &&
+      operand_types[0]->data.type_ptr.element_type != NULL) {
+    return operand_types[0]->data.type_ptr.element_type;
+  }
+  
+  /* Otherwise, return the type of the first operand */
   if (operand_count > 0) {
     return operand_types[0];
   } else {
@@ -0,0 +1,215 @@
+/**
+ * @file test_callgraph.c
+ * @brief Tests for the call graph.
+ * 
+ * This file contains tests for call resolution, strongly connected
+ * components and their bottom-up order, and the dependency waves.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/lexer.h"
+#include "../include/parser.h"
+#include "../include/callgraph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/**
+ * @brief Parse a source string into a module.
+ * 
+ * @param source The source code.
+ * @return The module AST node, or NULL on failure.
+ */
+static ast_node_t* parse_module(const char* source) {
+  lexer_t* lexer = lexer_create(source, strlen(source));
+  parser_t* parser = parser_create(lexer, "test.hoil");
+  ast_node_t* module = parser_parse_module(parser);
+  if (module != NULL && parser_has_error(parser)) {
+    ast_destroy_node(module);
+    module = NULL;
+  }
+  parser_destroy(parser);
+  lexer_destroy(lexer);
+  
+  if (module == NULL) {
+    fprintf(stderr, "Failed to parse test module\n");
+  }
+  return module;
+}
+
+/**
+ * @brief Get the number of a function that must exist.
+ * 
+ * @param cg The call graph.
+ * @param name The function name.
+ * @return The function number.
+ */
+static size_t function_number(const callgraph_t* cg, const char* name) {
+  int32_t function = callgraph_find(cg, name);
+  return function >= 0 ? (size_t)function : callgraph_function_count(cg);
+}
+
+/**
+ * @brief Test call resolution and the components of a graph with recursion.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_components(void) {
+  /* even and odd recurse into each other, main calls them through leaf */
+  const char* source =
+    "MODULE \"test\";\n"
+    "EXTERN FUNCTION puts(s: ptr<u8>) -> i32;\n"
+    "FUNCTION leaf(n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL even(n);\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION even(n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL odd(n);\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION odd(n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL even(n);\n"
+    "    s = CALL puts(r);\n"
+    "    RET s;\n"
+    "}\n"
+    "FUNCTION main(f: ptr<u8>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    a = CALL leaf(1);\n"
+    "    b = CALL leaf(a);\n"
+    "    c = CALL f(b);\n"
+    "    d = ADD odd, 0;\n"
+    "    RET c;\n"
+    "}\n";
+  
+  ast_node_t* module = parse_module(source);
+  callgraph_t* cg = module != NULL ? callgraph_build(module) : NULL;
+  if (cg == NULL) {
+    ast_destroy_node(module);
+    return false;
+  }
+  
+  size_t puts = function_number(cg, "puts");
+  size_t leaf = function_number(cg, "leaf");
+  size_t even = function_number(cg, "even");
+  size_t odd = function_number(cg, "odd");
+  size_t main_fn = function_number(cg, "main");
+  
+  /* Functions follow declaration order; the call through f is indirect */
+  bool success = callgraph_function_count(cg) == 5 && puts == 0 && main_fn == 4 &&
+                 callgraph_callee_count(cg, main_fn) == 1 &&
+                 callgraph_get_callee(cg, main_fn, 0) == leaf &&
+                 callgraph_has_indirect_calls(cg, main_fn) &&
+                 !callgraph_has_indirect_calls(cg, odd) &&
+                 callgraph_address_taken(cg, odd) && !callgraph_address_taken(cg, even) &&
+                 callgraph_caller_count(cg, even) == 2 && callgraph_caller_count(cg, puts) == 1;
+  if (!success) {
+    fprintf(stderr, "Unexpected call edges\n");
+  }
+  
+  /* even and odd form one recursive component, ordered below its callers */
+  success = success && callgraph_scc_count(cg) == 4 &&
+            callgraph_function_scc(cg, even) == callgraph_function_scc(cg, odd) &&
+            callgraph_scc_size(cg, callgraph_function_scc(cg, even)) == 2 &&
+            callgraph_scc_is_recursive(cg, callgraph_function_scc(cg, even)) &&
+            !callgraph_scc_is_recursive(cg, callgraph_function_scc(cg, leaf)) &&
+            callgraph_function_scc(cg, puts) < callgraph_function_scc(cg, odd) &&
+            callgraph_function_scc(cg, odd) < callgraph_function_scc(cg, leaf) &&
+            callgraph_function_scc(cg, leaf) < callgraph_function_scc(cg, main_fn);
+  if (!success) {
+    fprintf(stderr, "Unexpected components\n");
+  }
+  
+  callgraph_destroy(cg);
+  ast_destroy_node(module);
+  return success;
+}
+
+/**
+ * @brief Test that independent components share a wave.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_waves(void) {
+  /* a and b only call c, so they can be processed together after it */
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION c() -> i32 {\n"
+    "  ENTRY:\n"
+    "    RET 1;\n"
+    "}\n"
+    "FUNCTION a() -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL c();\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION b() -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL c();\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION top() -> i32 {\n"
+    "  ENTRY:\n"
+    "    x = CALL a();\n"
+    "    y = CALL b();\n"
+    "    z = ADD x, y;\n"
+    "    RET z;\n"
+    "}\n";
+  
+  ast_node_t* module = parse_module(source);
+  callgraph_t* cg = module != NULL ? callgraph_build(module) : NULL;
+  if (cg == NULL) {
+    ast_destroy_node(module);
+    return false;
+  }
+  
+  size_t wave_a = callgraph_scc_wave(cg, callgraph_function_scc(cg, function_number(cg, "a")));
+  size_t wave_b = callgraph_scc_wave(cg, callgraph_function_scc(cg, function_number(cg, "b")));
+  size_t wave_c = callgraph_scc_wave(cg, callgraph_function_scc(cg, function_number(cg, "c")));
+  size_t wave_top = callgraph_scc_wave(cg,
+                                       callgraph_function_scc(cg, function_number(cg, "top")));
+  bool success = callgraph_wave_count(cg) == 3 && wave_c == 0 && wave_a == 1 && wave_b == 1 &&
+                 wave_top == 2 && callgraph_wave_size(cg, 1) == 2;
+  
+  /* Every component is listed in its wave */
+  for (size_t w = 0; w < callgraph_wave_count(cg) && success; w++) {
+    for (size_t i = 0; i < callgraph_wave_size(cg, w) && success; i++) {
+      success = callgraph_scc_wave(cg, callgraph_get_wave_scc(cg, w, i)) == w;
+    }
+  }
+  if (!success) {
+    fprintf(stderr, "Unexpected waves\n");
+  }
+  
+  callgraph_destroy(cg);
+  ast_destroy_node(module);
+  return success;
+}
+
+/**
+ * @brief Run all call graph tests.
+ * 
+ * @return 0 if all tests pass, non-zero otherwise.
+ */
+int test_callgraph(void) {
+  bool result = true;
+  
+  printf("Testing call graph components...\n");
+  result = result && test_components();
+  
+  printf("Testing call graph waves...\n");
+  result = result && test_waves();
+  
+  if (result) {
+    printf("All call graph tests passed!\n");
+    return 0;
+  } else {
+    printf("Some call graph tests failed!\n");
+    return 1;
+  }
+}
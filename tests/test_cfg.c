@@ -0,0 +1,281 @@
+/**
+ * @file test_cfg.c
+ * @brief Tests for the control flow graph analyses.
+ * 
+ * This file contains tests for dominators, dominance frontiers, the
+ * loop-nest forest and incremental edge updates.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/cfg.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/**
+ * @brief Create a graph from an edge list.
+ * 
+ * @param block_count The number of blocks.
+ * @param edges Pairs of source and target blocks.
+ * @param edge_count The number of pairs.
+ * @return The graph with dominators computed, or NULL on failure.
+ */
+static cfg_t* create_graph(size_t block_count, const size_t (*edges)[2], size_t edge_count) {
+  cfg_t* cfg = cfg_create(block_count);
+  bool success = cfg != NULL;
+  
+  for (size_t i = 0; i < edge_count && success; i++) {
+    success = cfg_insert_edge(cfg, edges[i][0], edges[i][1]);
+  }
+  if (!success || !cfg_compute_dominators(cfg)) {
+    fprintf(stderr, "Failed to create graph\n");
+    cfg_destroy(cfg);
+    return NULL;
+  }
+  
+  return cfg;
+}
+
+/**
+ * @brief Check that a block's dominance frontier is a given set.
+ * 
+ * @param cfg The graph, with frontiers computed.
+ * @param block The block number.
+ * @param expected The expected frontier blocks.
+ * @param count The number of expected blocks.
+ * @return true if the frontier matches, false otherwise.
+ */
+static bool check_frontier(const cfg_t* cfg, size_t block, const size_t* expected, size_t count) {
+  if (cfg_frontier_count(cfg, block) != count) {
+    fprintf(stderr, "Block %zu has %zu frontier blocks, expected %zu\n",
+            block, cfg_frontier_count(cfg, block), count);
+    return false;
+  }
+  
+  for (size_t i = 0; i < count; i++) {
+    bool found = false;
+    for (size_t j = 0; j < count; j++) {
+      found = found || cfg_get_frontier(cfg, block, j) == expected[i];
+    }
+    if (!found) {
+      fprintf(stderr, "Block %zu is missing %zu from its frontier\n", block, expected[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Test dominators and frontiers of a branch followed by a loop.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_dominators_and_frontiers(void) {
+  /* 0 branches to 1 and 2, which join at the loop 3-4; 6 is unreachable */
+  const size_t edges[][2] = {
+    {0, 1}, {0, 2}, {1, 3}, {2, 3}, {3, 4}, {4, 3}, {4, 5}, {6, 5}
+  };
+  cfg_t* cfg = create_graph(7, edges, sizeof(edges) / sizeof(edges[0]));
+  if (cfg == NULL) {
+    return false;
+  }
+  
+  const int32_t idoms[] = { -1, 0, 0, 0, 3, 4, -1 };
+  bool success = true;
+  for (size_t i = 0; i < 7 && success; i++) {
+    success = cfg_immediate_dominator(cfg, i) == idoms[i];
+    if (!success) {
+      fprintf(stderr, "Block %zu has immediate dominator %d, expected %d\n",
+              i, (int)cfg_immediate_dominator(cfg, i), (int)idoms[i]);
+    }
+  }
+  
+  success = success && !cfg_is_reachable(cfg, 6) && cfg_dominates(cfg, 3, 5) &&
+            !cfg_dominates(cfg, 1, 3) && cfg_common_dominator(cfg, 1, 5) == 0 &&
+            cfg_dominator_depth(cfg, 5) == 3;
+  if (!success) {
+    fprintf(stderr, "Unexpected dominance queries\n");
+  }
+  
+  const size_t join[] = { 3 };
+  success = success && cfg_compute_frontiers(cfg) &&
+            check_frontier(cfg, 0, NULL, 0) &&
+            check_frontier(cfg, 1, join, 1) &&
+            check_frontier(cfg, 2, join, 1) &&
+            check_frontier(cfg, 3, join, 1) &&
+            check_frontier(cfg, 4, join, 1) &&
+            check_frontier(cfg, 5, NULL, 0);
+  
+  cfg_destroy(cfg);
+  return success;
+}
+
+/**
+ * @brief Test the loop-nest forest of two nested loops.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_loop_forest(void) {
+  /* Outer loop 1-4 around inner loop 2-3, with a self loop at 6 after them */
+  const size_t edges[][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 2}, {3, 4}, {4, 1}, {4, 5}, {5, 6}, {6, 6}, {6, 7}
+  };
+  cfg_t* cfg = create_graph(8, edges, sizeof(edges) / sizeof(edges[0]));
+  if (cfg == NULL) {
+    return false;
+  }
+  
+  bool success = cfg_compute_loops(cfg) && cfg_loop_count(cfg) == 3;
+  if (!success) {
+    fprintf(stderr, "Expected three loops\n");
+    cfg_destroy(cfg);
+    return false;
+  }
+  
+  int32_t inner = cfg_block_loop(cfg, 3);
+  int32_t outer = cfg_block_loop(cfg, 4);
+  int32_t self = cfg_block_loop(cfg, 6);
+  success = inner >= 0 && outer >= 0 && self >= 0 &&
+            cfg_loop_header(cfg, (size_t)inner) == 2 &&
+            cfg_loop_header(cfg, (size_t)outer) == 1 &&
+            cfg_loop_header(cfg, (size_t)self) == 6 &&
+            cfg_loop_parent(cfg, (size_t)inner) == outer &&
+            cfg_loop_parent(cfg, (size_t)outer) == -1 &&
+            cfg_loop_depth(cfg, (size_t)inner) == 2 &&
+            cfg_loop_depth(cfg, (size_t)self) == 1 &&
+            inner < outer &&
+            cfg_loop_contains(cfg, (size_t)outer, 3) &&
+            !cfg_loop_contains(cfg, (size_t)inner, 4) &&
+            cfg_block_loop(cfg, 0) == -1 && cfg_block_loop(cfg, 5) == -1;
+  if (!success) {
+    fprintf(stderr, "Unexpected loop nest\n");
+  }
+  
+  cfg_destroy(cfg);
+  return success;
+}
+
+/**
+ * @brief Check dominance by definition: b is unreachable once a is removed.
+ * 
+ * @param cfg The graph.
+ * @param a The dominating block.
+ * @param b The dominated block.
+ * @param seen Scratch array with one entry per block.
+ * @param stack Scratch array with one entry per block.
+ * @return true if every path from the entry to b passes through a.
+ */
+static bool dominates_by_search(const cfg_t* cfg, size_t a, size_t b, bool* seen, size_t* stack) {
+  size_t count = cfg_block_count(cfg);
+  memset(seen, 0, count * sizeof(bool));
+  size_t top = 0;
+  seen[0] = true;
+  stack[top++] = 0;
+  
+  /* Reachability of b itself, then reachability avoiding a */
+  for (int pass = 0; pass < 2; pass++) {
+    while (top > 0) {
+      size_t block = stack[--top];
+      for (size_t s = 0; s < cfg_successor_count(cfg, block); s++) {
+        size_t succ = cfg_get_successor(cfg, block, s);
+        if (!seen[succ] && (pass == 0 || succ != a)) {
+          seen[succ] = true;
+          stack[top++] = succ;
+        }
+      }
+    }
+    
+    if (pass == 0 && !seen[b]) {
+      return false;
+    }
+    if (pass == 0) {
+      if (a == 0 || a == b) {
+        return true;
+      }
+      memset(seen, 0, count * sizeof(bool));
+      seen[0] = true;
+      stack[top++] = 0;
+    }
+  }
+  return !seen[b];
+}
+
+/**
+ * @brief Test that incremental updates keep dominance exact on random edits.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_incremental_dominators(void) {
+  const size_t count = 24;
+  cfg_t* cfg = cfg_create(count);
+  bool* seen = (bool*)malloc(count * sizeof(bool));
+  size_t* stack = (size_t*)malloc(count * sizeof(size_t));
+  bool success = cfg != NULL && seen != NULL && stack != NULL;
+  
+  /* A chain keeps most blocks reachable to start with */
+  for (size_t i = 0; i + 1 < count && success; i++) {
+    success = cfg_insert_edge(cfg, i, i + 1);
+  }
+  success = success && cfg_compute_dominators(cfg);
+  
+  uint32_t seed = 12345;
+  for (size_t step = 0; step < 400 && success; step++) {
+    seed = seed * 1103515245u + 12345u;
+    size_t from = (seed >> 8) % count;
+    seed = seed * 1103515245u + 12345u;
+    size_t to = (seed >> 8) % count;
+    
+    bool present = false;
+    for (size_t s = 0; s < cfg_successor_count(cfg, from); s++) {
+      present = present || cfg_get_successor(cfg, from, s) == to;
+    }
+    if (present) {
+      success = cfg_remove_edge(cfg, from, to);
+    } else if (cfg_successor_count(cfg, from) < 2) {
+      success = cfg_insert_edge(cfg, from, to);
+    }
+    
+    for (size_t a = 0; a < count && success; a++) {
+      for (size_t b = 0; b < count && success; b++) {
+        success = cfg_dominates(cfg, a, b) == dominates_by_search(cfg, a, b, seen, stack);
+        if (!success) {
+          fprintf(stderr, "Step %zu: dominance of %zu over %zu is wrong\n", step, a, b);
+        }
+      }
+    }
+  }
+  
+  free(seen);
+  free(stack);
+  cfg_destroy(cfg);
+  return success;
+}
+
+/**
+ * @brief Run all control flow graph tests.
+ * 
+ * @return 0 if all tests pass, non-zero otherwise.
+ */
+int test_cfg(void) {
+  bool result = true;
+  
+  printf("Testing dominators and frontiers...\n");
+  result = result && test_dominators_and_frontiers();
+  
+  printf("Testing loop forest...\n");
+  result = result && test_loop_forest();
+  
+  printf("Testing incremental dominators...\n");
+  result = result && test_incremental_dominators();
+  
+  if (result) {
+    printf("All CFG tests passed!\n");
+    return 0;
+  } else {
+    printf("Some CFG tests failed!\n");
+    return 1;
+  }
+}
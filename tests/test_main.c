@@ -25,6 +25,27 @@ extern int test_lexer(void);
  */
 extern int test_parser(void);
 
+/**
+ * @brief Run all control flow graph tests.
+ * 
+ * @return 0 if all tests pass, non-zero otherwise.
+ */
+extern int test_cfg(void);
+
+/**
+ * @brief Run all call graph tests.
+ * 
+ * @return 0 if all tests pass, non-zero otherwise.
+ */
+extern int test_callgraph(void);
+
+/**
+ * @brief Run all optimizer tests.
+ * 
+ * @return 0 if all tests pass, non-zero otherwise.
+ */
+extern int test_optimize(void);
+
 /**
  * @brief Run all tests.
  * 
@@ -39,6 +60,15 @@ int main(void) {
   printf("\n===== Running Parser Tests =====\n");
   result |= test_parser();
   
+  printf("\n===== Running CFG Tests =====\n");
+  result |= test_cfg();
+  
+  printf("\n===== Running Call Graph Tests =====\n");
+  result |= test_callgraph();
+  
+  printf("\n===== Running Optimizer Tests =====\n");
+  result |= test_optimize();
+  
   if (result == 0) {
     printf("\n===== All Tests Passed =====\n");
   } else {
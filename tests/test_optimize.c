@@ -0,0 +1,2430 @@
+/**
+ * @file test_optimize.c
+ * @brief Tests for the optimizer.
+ * 
+ * This file contains tests for the optimization passes.
+ * 
+ * @author HOILC Team
+ * @date 2025
+ */
+
+#include "../include/lexer.h"
+#include "../include/parser.h"
+#include "../include/ast.h"
+#include "../include/typecheck.h"
+#include "../include/optimize.h"
+#include "../include/callgraph.h"
+#include "../include/effects.h"
+#include "../include/alias.h"
+#include "../include/ir.h"
+#include "../include/binary.h"
+#include "../include/codegen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/**
+ * @brief Compiled test module.
+ */
+typedef struct {
+  error_context_t* error_ctx;          /**< Error context. */
+  typecheck_context_t* typecheck_ctx;  /**< Type checker context. */
+  ast_node_t* module;                  /**< Optimized module. */
+} test_module_t;
+
+/**
+ * @brief Release a compiled test module.
+ * 
+ * @param test The test module.
+ */
+static void release_module(test_module_t* test) {
+  typecheck_destroy_context(test->typecheck_ctx);
+  ast_destroy_node(test->module);
+  error_destroy_context(test->error_ctx);
+}
+
+/**
+ * @brief Parse, type check and optimize a source string.
+ * 
+ * @param source The source code.
+ * @param level The optimization level.
+ * @param test Pointer to store the compiled module.
+ * @return true on success, false otherwise.
+ */
+static bool compile_module(const char* source, hoilc_opt_level_t level, test_module_t* test) {
+  test->error_ctx = error_create_context();
+  test->typecheck_ctx = NULL;
+  test->module = NULL;
+  
+  lexer_t* lexer = lexer_create(source, strlen(source));
+  parser_t* parser = parser_create(lexer, "test.hoil");
+  test->module = parser_parse_module(parser);
+  bool success = test->module != NULL && !parser_has_error(parser);
+  parser_destroy(parser);
+  lexer_destroy(lexer);
+  
+  if (!success) {
+    fprintf(stderr, "Failed to parse test module\n");
+    return false;
+  }
+  
+  test->typecheck_ctx = typecheck_create_context(test->error_ctx);
+  if (!typecheck_module(test->typecheck_ctx, test->module)) {
+    fprintf(stderr, "Type error: %s\n", error_get_message(test->error_ctx));
+    return false;
+  }
+  
+  optimize_context_t* optimize_ctx = optimize_create_context(
+    test->error_ctx, typecheck_get_symbol_table(test->typecheck_ctx)
+  );
+  optimize_set_level(optimize_ctx, level);
+  success = optimize_module(optimize_ctx, test->module);
+  optimize_destroy_context(optimize_ctx);
+  
+  if (!success) {
+    fprintf(stderr, "Optimizer error: %s\n", error_get_message(test->error_ctx));
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Find a block of a function in a module.
+ * 
+ * @param module The module.
+ * @param function The function name.
+ * @param label The block label.
+ * @return The block node, or NULL if not found.
+ */
+static ast_node_t* find_block(ast_node_t* module, const char* function, const char* label) {
+  for (size_t i = 0; i < module->data.module.declarations.count; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type != AST_FUNCTION || strcmp(decl->data.function.name, function) != 0) {
+      continue;
+    }
+    
+    for (size_t j = 0; j < decl->data.function.blocks.count; j++) {
+      ast_node_t* block = decl->data.function.blocks.nodes[j];
+      if (strcmp(block->data.stmt_block.label, label) == 0) {
+        return block;
+      }
+    }
+  }
+  
+  return NULL;
+}
+
+/**
+ * @brief Find a function in a module.
+ * 
+ * @param module The module.
+ * @param name The function name.
+ * @return The function node, or NULL if not found.
+ */
+static ast_node_t* find_function(ast_node_t* module, const char* name) {
+  for (size_t i = 0; i < module->data.module.declarations.count; i++) {
+    ast_node_t* decl = module->data.module.declarations.nodes[i];
+    if (decl->type == AST_FUNCTION && strcmp(decl->data.function.name, name) == 0) {
+      return decl;
+    }
+  }
+  
+  return NULL;
+}
+
+/**
+ * @brief Check the assignment targets of the leading statements of a block.
+ * 
+ * @param block The block.
+ * @param targets The expected targets, NULL for a non-assignment statement.
+ * @param count The number of statements to check.
+ * @return true if the statements match, false otherwise.
+ */
+static bool check_targets(ast_node_t* block, const char** targets, size_t count) {
+  if (block == NULL || block->data.stmt_block.statements.count < count) {
+    fprintf(stderr, "Block is missing or too short\n");
+    return false;
+  }
+  
+  for (size_t i = 0; i < count; i++) {
+    ast_node_t* stmt = block->data.stmt_block.statements.nodes[i];
+    const char* target = stmt->type == AST_STMT_ASSIGN ? stmt->data.stmt_assign.target : NULL;
+    
+    bool match = (target == NULL && targets[i] == NULL) ||
+                 (target != NULL && targets[i] != NULL && strcmp(target, targets[i]) == 0);
+    if (!match) {
+      fprintf(stderr, "Statement %zu: expected %s, got %s\n", i,
+              targets[i] ? targets[i] : "(none)", target ? target : "(none)");
+      return false;
+    }
+  }
+  
+  return true;
+}
+
+/**
+ * @brief Test that independent work is scheduled between a DIV and its use.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_schedule_latency(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION f(a: i32, b: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    q = DIV a, b;\n"
+    "    r = ADD q, 1;\n"
+    "    m = MUL a, 3;\n"
+    "    s = ADD m, b;\n"
+    "    t = ADD r, s;\n"
+    "    RET t;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  if (success) {
+    const char* expected[] = { "q", "m", "s", "r", "t" };
+    success = check_targets(find_block(test.module, "f", "ENTRY"), expected, 5);
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that scheduling keeps loads, stores and trapping instructions ordered.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_schedule_memory_order(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION g(p: ptr<i32>, a: i32, b: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    x = LOAD p;\n"
+    "    y = ADD x, 1;\n"
+    "    STORE p, y;\n"
+    "    w = DIV a, b;\n"
+    "    z = LOAD p;\n"
+    "    v = ADD z, w;\n"
+    "    RET v;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  if (success) {
+    const char* expected[] = { "x", "y", NULL, "w", "z", "v" };
+    success = check_targets(find_block(test.module, "g", "ENTRY"), expected, 6);
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that scheduling keeps writes to globals ordered with loads.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_schedule_global_order(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "GLOBAL g: i32 = 0;\n"
+    "FUNCTION f(p: ptr<i32>, q: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    t = DIV q, 3;\n"
+    "    g = ADD t, 1;\n"
+    "    a = LOAD p;\n"
+    "    b = MUL a, a;\n"
+    "    RET b;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  if (success) {
+    const char* expected[] = { "t", "g", "a", "b" };
+    success = check_targets(find_block(test.module, "f", "ENTRY"), expected, 4);
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that literal call arguments adapt to integer and float parameters.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_call_literal_arguments(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "CONSTANT C: i64 = wide(3, 4);\n"
+    "FUNCTION wide(a: u8, b: i64) -> i64 {\n"
+    "  ENTRY:\n"
+    "    r = MUL b, 2;\n"
+    "    RET r;\n"
+    "}\n"
+    "EXTERN FUNCTION put(x: u32, y: f32) -> i32;\n"
+    "FUNCTION main() -> i32 {\n"
+    "  ENTRY:\n"
+    "    w = CALL wide(255, 7);\n"
+    "    s = CALL put(1, 1.5);\n"
+    "    RET s;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_NONE, &test);
+  release_module(&test);
+  if (!success) {
+    fprintf(stderr, "Literal arguments rejected for non-i32 parameters\n");
+    return false;
+  }
+  
+  /* Only literals adapt; a variable of another width does not */
+  const char* narrow_variable =
+    "MODULE \"test\";\n"
+    "EXTERN FUNCTION put(x: i64) -> i32;\n"
+    "FUNCTION main(v: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    s = CALL put(v);\n"
+    "    RET s;\n"
+    "}\n";
+  
+  success = !compile_module(narrow_variable, HOILC_OPT_NONE, &test) &&
+            strstr(error_get_message(test.error_ctx), "Argument type does not match") != NULL;
+  release_module(&test);
+  if (!success) {
+    fprintf(stderr, "Argument of another width accepted\n");
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test that a sequence repeated across functions is outlined at -Os.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_outline_repeated_sequence(void) {
+  const char* body =
+    "    %s1 = MUL %s, %s;\n"
+    "    %s2 = ADD %s1, %s;\n"
+    "    %s3 = SUB %s2, %s;\n"
+    "    %s4 = MUL %s3, %s3;\n"
+    "    %s5 = XOR %s4, %s;\n"
+    "    %s6 = ADD %s5, 7;\n"
+    "    %s7 = AND %s6, 255;\n";
+  const char* names[][3] = { { "f", "a", "b" }, { "g", "c", "d" }, { "h", "e", "k" } };
+  
+  char source[4096];
+  size_t length = (size_t)snprintf(source, sizeof(source), "MODULE \"test\";\n");
+  for (size_t i = 0; i < 3; i++) {
+    const char* t = names[i][0];
+    const char* x = names[i][1];
+    const char* y = names[i][2];
+    length += (size_t)snprintf(source + length, sizeof(source) - length,
+                               "FUNCTION %s(%s: i32, %s: i32) -> i32 {\n  ENTRY:\n", t, x, y);
+    length += (size_t)snprintf(source + length, sizeof(source) - length, body,
+                               t, x, y, t, t, x, t, t, y, t, t, t, t, t, x, t, t, t, t);
+    length += (size_t)snprintf(source + length, sizeof(source) - length,
+                               "    r = ADD %s7, %zu;\n    RET r;\n}\n", t, i);
+  }
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_SIZE, &test);
+  if (success && test.module->data.module.declarations.count != 4) {
+    fprintf(stderr, "Expected one outlined function\n");
+    success = false;
+  }
+  
+  if (success) {
+    ast_node_t* outlined = test.module->data.module.declarations.nodes[3];
+    success = outlined->type == AST_FUNCTION &&
+              strcmp(outlined->data.function.name, "__hoilc_outlined_0") == 0 &&
+              outlined->data.function.parameters.count == 2;
+    if (!success) {
+      fprintf(stderr, "Unexpected outlined function\n");
+    }
+  }
+  
+  for (size_t i = 0; i < 3 && success; i++) {
+    char target[8];
+    snprintf(target, sizeof(target), "%s7", names[i][0]);
+    
+    const char* expected[] = { target, "r" };
+    ast_node_t* block = find_block(test.module, names[i][0], "ENTRY");
+    success = check_targets(block, expected, 2) &&
+              block->data.stmt_block.statements.count == 3;
+    if (success) {
+      ast_node_t* value = block->data.stmt_block.statements.nodes[0]->data.stmt_assign.value;
+      success = value->type == AST_STMT_INSTRUCTION &&
+                strcmp(value->data.stmt_instruction.opcode, "CALL") == 0;
+    }
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that functions differing only in local names are folded.
+ * 
+ * Functions whose attributes differ are kept apart.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_fold_identical_functions(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION f(a: i32, b: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    x = ADD a, b;\n"
+    "    c = CMP_GT x, 10;\n"
+    "    BR c, BIG, SMALL;\n"
+    "  BIG:\n"
+    "    RET x;\n"
+    "  SMALL:\n"
+    "    y = MUL x, 2;\n"
+    "    RET y;\n"
+    "}\n"
+    "FUNCTION g(p: i32, q: i32) -> i32 {\n"
+    "  START:\n"
+    "    s = ADD p, q;\n"
+    "    t = CMP_GT s, 10;\n"
+    "    BR t, HIGH, LOW;\n"
+    "  HIGH:\n"
+    "    RET s;\n"
+    "  LOW:\n"
+    "    u = MUL s, 2;\n"
+    "    RET u;\n"
+    "}\n"
+    "FUNCTION h(a: i32, b: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    x = ADD a, b;\n"
+    "    c = CMP_GT x, 10;\n"
+    "    BR c, BIG, SMALL;\n"
+    "  BIG:\n"
+    "    RET x;\n"
+    "  SMALL:\n"
+    "    y = MUL x, 3;\n"
+    "    RET y;\n"
+    "}\n"
+    "FUNCTION k(a: i32, b: i32) -> i32 [cold] {\n"
+    "  ENTRY:\n"
+    "    x = ADD a, b;\n"
+    "    c = CMP_GT x, 10;\n"
+    "    BR c, BIG, SMALL;\n"
+    "  BIG:\n"
+    "    RET x;\n"
+    "  SMALL:\n"
+    "    y = MUL x, 2;\n"
+    "    RET y;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_BASIC, &test);
+  if (success) {
+    ast_node_t* f = test.module->data.module.declarations.nodes[0];
+    ast_node_t* g = test.module->data.module.declarations.nodes[1];
+    ast_node_t* h = test.module->data.module.declarations.nodes[2];
+    ast_node_t* k = test.module->data.module.declarations.nodes[3];
+    
+    if (f->data.function.alias != NULL || f->data.function.blocks.count != 3) {
+      fprintf(stderr, "Expected f to keep its body\n");
+      success = false;
+    } else if (g->data.function.alias == NULL ||
+               strcmp(g->data.function.alias, "f") != 0 ||
+               g->data.function.blocks.count != 0) {
+      fprintf(stderr, "Expected g to become an alias of f\n");
+      success = false;
+    } else if (h->data.function.alias != NULL || h->data.function.blocks.count != 3) {
+      fprintf(stderr, "Expected h to keep its body\n");
+      success = false;
+    } else if (k->data.function.alias != NULL || k->data.function.blocks.count != 3) {
+      fprintf(stderr, "Expected the cold copy k to keep its body\n");
+      success = false;
+    }
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that a shared constant argument tuple gets a specialized clone.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_specialize_constant_arguments(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION dispatch(mode: i32, x: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    is_mode_one = CMP_EQ mode, 1;\n"
+    "    BR is_mode_one, INCREMENT, TWICE;\n"
+    "  INCREMENT:\n"
+    "    r = ADD x, 1;\n"
+    "    RET r;\n"
+    "  TWICE:\n"
+    "    d = MUL x, 2;\n"
+    "    RET d;\n"
+    "}\n"
+    "FUNCTION main(v: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    a = CALL dispatch(1, v);\n"
+    "    b = CALL dispatch(1, a);\n"
+    "    c = CALL dispatch(2, b);\n"
+    "    RET c;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  if (success && test.module->data.module.declarations.count != 3) {
+    fprintf(stderr, "Expected one specialized function\n");
+    success = false;
+  }
+  
+  /* The mode test folds away and only the taken path is left */
+  if (success) {
+    ast_node_t* clone = test.module->data.module.declarations.nodes[2];
+    success = strcmp(clone->data.function.name, "__hoilc_specialized_0") == 0 &&
+              clone->data.function.parameters.count == 1 &&
+              clone->data.function.blocks.count == 2 &&
+              find_block(test.module, "__hoilc_specialized_0", "INCREMENT") != NULL;
+    if (!success) {
+      fprintf(stderr, "Unexpected specialized function\n");
+    }
+  }
+  
+  const char* callees[] = { "__hoilc_specialized_0", "__hoilc_specialized_0", "dispatch" };
+  const size_t arg_counts[] = { 1, 1, 2 };
+  ast_node_t* block = success ? find_block(test.module, "main", "ENTRY") : NULL;
+  for (size_t i = 0; i < 3 && success; i++) {
+    ast_node_t* value = block->data.stmt_block.statements.nodes[i]->data.stmt_assign.value;
+    ast_node_t* call = value->data.stmt_instruction.operands.nodes[0];
+    success = strcmp(call->data.expr_call.function->data.expr_identifier.name, callees[i]) == 0 &&
+              call->data.expr_call.arguments.count == arg_counts[i];
+    if (!success) {
+      fprintf(stderr, "Call %zu was not redirected as expected\n", i);
+    }
+  }
+  release_module(&test);
+  
+  /* The bound literal is converted to the unsigned parameter type */
+  const char* unsigned_source =
+    "MODULE \"test\";\n"
+    "FUNCTION f(x: u32, y: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    c = CMP_GT x, 5;\n"
+    "    BR c, A, Z;\n"
+    "  A:\n"
+    "    r = ADD y, 1;\n"
+    "    RET r;\n"
+    "  Z:\n"
+    "    RET y;\n"
+    "}\n"
+    "FUNCTION main(a: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    b = CALL f(-1, a);\n"
+    "    c = CALL f(-1, b);\n"
+    "    RET c;\n"
+    "}\n";
+  
+  if (success) {
+    success = compile_module(unsigned_source, HOILC_OPT_FULL, &test) &&
+              find_block(test.module, "__hoilc_specialized_0", "A") != NULL &&
+              find_block(test.module, "__hoilc_specialized_0", "Z") == NULL;
+    if (!success) {
+      fprintf(stderr, "Unsigned constant argument specialized with the wrong value\n");
+    }
+    release_module(&test);
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test that folded comparisons honor the signedness of their operands.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_fold_unsigned_comparisons(void) {
+  static const struct {
+    uint8_t opcode;
+    uint8_t bits;
+    bool is_signed;
+    int64_t operands[2];
+    int64_t expected;
+  } folds[] = {
+    { OPCODE_CMP_GT, 64, false, { -1, 5 }, 1 },
+    { OPCODE_CMP_LT, 64, false, { -1, 5 }, 0 },
+    { OPCODE_CMP_GE, 64, false, { INT64_MIN, INT64_MAX }, 1 },
+    { OPCODE_CMP_GT, 64, true, { -1, 5 }, 0 },
+    { OPCODE_CMP_EQ, 8, false, { -1, 255 }, 1 },
+    { OPCODE_CMP_LE, 8, false, { 255, 1 }, 0 },
+  };
+  
+  bool success = true;
+  for (size_t i = 0; success && i < sizeof(folds) / sizeof(folds[0]); i++) {
+    ast_node_t* type = ast_create_node(AST_TYPE_INT);
+    int64_t value;
+    if (type == NULL) {
+      return false;
+    }
+    type->data.type_int.bits = folds[i].bits;
+    type->data.type_int.is_signed = folds[i].is_signed;
+    success = ir_fold_integer(folds[i].opcode, type, folds[i].operands, 2, &value) &&
+              value == folds[i].expected;
+    ast_destroy_node(type);
+    if (!success) {
+      fprintf(stderr, "Comparison fold %zu is wrong\n", i);
+    }
+  }
+  
+  /* Without a type, literals compare by value */
+  int64_t literals[2] = { -1, 5 };
+  int64_t value;
+  if (success && (!ir_fold_integer(OPCODE_CMP_GT, NULL, literals, 2, &value) || value != 0)) {
+    fprintf(stderr, "Literal comparison fold is wrong\n");
+    success = false;
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test compile-time evaluation of pure calls and constant initializers.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_evaluate_pure_calls(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "CONSTANT G: i32 = gcd(48, 18);\n"
+    "CONSTANT K: i32 = wraps(0);\n"
+    "GLOBAL counter: i32 = 0;\n"
+    "FUNCTION gcd(a: i32, b: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    is_b_zero = CMP_EQ b, 0;\n"
+    "    BR is_b_zero, DONE, LOOP;\n"
+    "  LOOP:\n"
+    "    remainder = REM a, b;\n"
+    "    a = ADD b, 0;\n"
+    "    b = ADD remainder, 0;\n"
+    "    is_b_zero = CMP_EQ b, 0;\n"
+    "    BR is_b_zero, DONE, LOOP;\n"
+    "  DONE:\n"
+    "    RET a;\n"
+    "}\n"
+    "FUNCTION wraps(x: u64) -> i32 {\n"
+    "  ENTRY:\n"
+    "    a = SUB x, 1;\n"
+    "    c = CMP_GT a, 5;\n"
+    "    BR c, ABOVE, BELOW;\n"
+    "  ABOVE:\n"
+    "    RET 1;\n"
+    "  BELOW:\n"
+    "    RET 0;\n"
+    "}\n"
+    "FUNCTION spin(n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    BR ALWAYS, ENTRY;\n"
+    "}\n"
+    "FUNCTION bump(n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    old = LOAD counter;\n"
+    "    r = ADD old, n;\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION main() -> i32 {\n"
+    "  ENTRY:\n"
+    "    x = CALL gcd(G, 18);\n"
+    "    y = CALL spin(1);\n"
+    "    z = CALL bump(1);\n"
+    "    RET x;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_BASIC, &test);
+  
+  if (success) {
+    ast_node_t* constant = test.module->data.module.declarations.nodes[0];
+    success = constant->data.constant.value->type == AST_EXPR_INTEGER &&
+              constant->data.constant.value->data.expr_integer.value == 6;
+    if (!success) {
+      fprintf(stderr, "Expected the constant initializer to fold to 6\n");
+    }
+  }
+  
+  /* 0 - 1 wraps to the largest u64, which is above 5 */
+  if (success) {
+    ast_node_t* constant = test.module->data.module.declarations.nodes[1];
+    success = constant->data.constant.value->type == AST_EXPR_INTEGER &&
+              constant->data.constant.value->data.expr_integer.value == 1;
+    if (!success) {
+      fprintf(stderr, "Expected the unsigned comparison to fold to 1\n");
+    }
+  }
+  
+  /* Only the pure call that terminates within the limits is replaced */
+  const char* opcodes[] = { "ADD", "CALL", "CALL" };
+  ast_node_t* block = success ? find_block(test.module, "main", "ENTRY") : NULL;
+  for (size_t i = 0; i < 3 && success; i++) {
+    ast_node_t* value = block->data.stmt_block.statements.nodes[i]->data.stmt_assign.value;
+    success = strcmp(value->data.stmt_instruction.opcode, opcodes[i]) == 0;
+    if (success && i == 0) {
+      ast_node_t* operand = value->data.stmt_instruction.operands.nodes[0];
+      success = operand->type == AST_EXPR_INTEGER && operand->data.expr_integer.value == 6;
+    }
+    if (!success) {
+      fprintf(stderr, "Unexpected result for call %zu\n", i);
+    }
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that calls writing a global are neither evaluated nor removed.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_evaluate_global_writes(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "GLOBAL g: i32 = 0;\n"
+    "FUNCTION setg(v: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    g = ADD v, 0;\n"
+    "    RET v;\n"
+    "}\n"
+    "FUNCTION main() -> i32 {\n"
+    "  ENTRY:\n"
+    "    s = CALL setg(5);\n"
+    "    RET 0;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  
+  ast_node_t* block = success ? find_block(test.module, "main", "ENTRY") : NULL;
+  bool found = false;
+  for (size_t i = 0; block != NULL && i < block->data.stmt_block.statements.count; i++) {
+    ast_node_t* stmt = block->data.stmt_block.statements.nodes[i];
+    found = found || (ir_get_opcode(stmt) == OPCODE_CALL && strcmp(ir_get_def(stmt), "s") == 0);
+  }
+  success = block != NULL && found;
+  if (block != NULL && !success) {
+    fprintf(stderr, "Call writing a global was evaluated\n");
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that loop multiples become recurrences and the exit test moves to them.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_reduce_induction_variables(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION sum(base: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    i = ADD 0, 0;\n"
+    "    total = ADD 0, 0;\n"
+    "    BR ALWAYS, LOOP;\n"
+    "  LOOP:\n"
+    "    off = MUL i, 4;\n"
+    "    addr = ADD base, off;\n"
+    "    v = LOAD addr;\n"
+    "    total = ADD total, v;\n"
+    "    i = ADD i, 1;\n"
+    "    more = CMP_LT i, 100;\n"
+    "    BR more, LOOP, DONE;\n"
+    "  DONE:\n"
+    "    RET total;\n"
+    "}\n"
+    "FUNCTION bounded(base: i32, n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    i = ADD 0, 0;\n"
+    "    total = ADD 0, 0;\n"
+    "    BR ALWAYS, LOOP;\n"
+    "  LOOP:\n"
+    "    off = MUL i, 4;\n"
+    "    addr = ADD base, off;\n"
+    "    v = LOAD addr;\n"
+    "    total = ADD total, v;\n"
+    "    i = ADD i, 1;\n"
+    "    more = CMP_LT i, n;\n"
+    "    BR more, LOOP, DONE;\n"
+    "  DONE:\n"
+    "    RET total;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  
+  /* The multiply and the basic variable are gone */
+  ast_node_t* blocks[2] = { NULL, NULL };
+  if (success) {
+    blocks[0] = find_block(test.module, "sum", "ENTRY");
+    blocks[1] = find_block(test.module, "sum", "LOOP");
+    success = blocks[0] != NULL && blocks[1] != NULL;
+  }
+  
+  ast_node_t* test_value = NULL;
+  for (size_t b = 0; b < 2 && success; b++) {
+    ast_node_list_t* statements = &blocks[b]->data.stmt_block.statements;
+    for (size_t i = 0; i < statements->count && success; i++) {
+      ast_node_t* stmt = statements->nodes[i];
+      if (stmt->type != AST_STMT_ASSIGN ||
+          stmt->data.stmt_assign.value->type != AST_STMT_INSTRUCTION) {
+        continue;
+      }
+      
+      const char* opcode = stmt->data.stmt_assign.value->data.stmt_instruction.opcode;
+      success = strcmp(opcode, "MUL") != 0 && strcmp(stmt->data.stmt_assign.target, "i") != 0;
+      if (!success) {
+        fprintf(stderr, "Unexpected definition of %s\n", stmt->data.stmt_assign.target);
+      }
+      if (strcmp(stmt->data.stmt_assign.target, "more") == 0) {
+        test_value = stmt->data.stmt_assign.value;
+      }
+    }
+  }
+  
+  /* The exit test counts the scaled variable up to 4 * 100 */
+  if (success) {
+    success = test_value != NULL &&
+              test_value->data.stmt_instruction.operands.nodes[0]->type == AST_EXPR_IDENTIFIER &&
+              strncmp(test_value->data.stmt_instruction.operands.nodes[0]->data.expr_identifier.name,
+                      "__hoilc_iv_", 11) == 0 &&
+              test_value->data.stmt_instruction.operands.nodes[1]->type == AST_EXPR_INTEGER &&
+              test_value->data.stmt_instruction.operands.nodes[1]->data.expr_integer.value == 400;
+    if (!success) {
+      fprintf(stderr, "Expected the exit test on the reduced variable\n");
+    }
+  }
+  
+  /* Only the address advances when the exit test stays on i */
+  const char* functions[] = { "sum", "bounded" };
+  for (size_t f = 0; f < 2 && success; f++) {
+    ast_node_t* loop = find_block(test.module, functions[f], "LOOP");
+    success = loop != NULL && loop->data.stmt_block.statements.count == 7;
+    if (!success) {
+      fprintf(stderr, "Unexpected loop body size in %s\n", functions[f]);
+    }
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that dominating conditions decide later comparisons and branches.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_range_dominating_conditions(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION clamp(i: i32, n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    lt = CMP_LT i, n;\n"
+    "    BR lt, INSIDE, OUTSIDE;\n"
+    "  INSIDE:\n"
+    "    again = CMP_LT i, n;\n"
+    "    BR again, OK, BAD;\n"
+    "  OK:\n"
+    "    RET i;\n"
+    "  OUTSIDE:\n"
+    "    big = CMP_GT i, 100;\n"
+    "    BR big, HUGE, BAD;\n"
+    "  HUGE:\n"
+    "    pos = CMP_GT i, 0;\n"
+    "    RET 1;\n"
+    "  BAD:\n"
+    "    RET 0;\n"
+    "}\n"
+    "FUNCTION count() -> i32 {\n"
+    "  ENTRY:\n"
+    "    i = ADD 0, 0;\n"
+    "  HEAD:\n"
+    "    c = CMP_LT i, 10;\n"
+    "    BR c, BODY, DONE;\n"
+    "  BODY:\n"
+    "    i = ADD i, 1;\n"
+    "    BR ALWAYS, HEAD;\n"
+    "  DONE:\n"
+    "    RET i;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_BASIC, &test);
+  
+  /* The repeated test is true and its branch always goes to OK */
+  ast_node_t* inside = success ? find_block(test.module, "clamp", "INSIDE") : NULL;
+  if (success) {
+    ast_node_t* again = inside->data.stmt_block.statements.nodes[0];
+    ast_node_t* branch = inside->data.stmt_block.statements.nodes[1];
+    success = strcmp(again->data.stmt_assign.value->data.stmt_instruction.opcode, "ADD") == 0 &&
+              branch->data.stmt_branch.condition == NULL &&
+              strcmp(branch->data.stmt_branch.true_target, "OK") == 0;
+    if (!success) {
+      fprintf(stderr, "Expected the repeated comparison to be folded\n");
+    }
+  }
+  
+  /* i > 100 implies i > 0 */
+  if (success) {
+    ast_node_t* pos = find_block(test.module, "clamp", "HUGE")->data.stmt_block.statements.nodes[0];
+    ast_node_t* value = pos->data.stmt_assign.value;
+    success = strcmp(value->data.stmt_instruction.opcode, "ADD") == 0 &&
+              value->data.stmt_instruction.operands.nodes[0]->data.expr_integer.value == 1;
+    if (!success) {
+      fprintf(stderr, "Expected the implied comparison to be folded\n");
+    }
+  }
+  
+  /* The loop header test depends on values from the back edge */
+  if (success) {
+    ast_node_t* c = find_block(test.module, "count", "HEAD")->data.stmt_block.statements.nodes[0];
+    success = strcmp(c->data.stmt_assign.value->data.stmt_instruction.opcode, "CMP_LT") == 0;
+    if (!success) {
+      fprintf(stderr, "Expected the loop test to be kept\n");
+    }
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that unsigned 64-bit values are not described by signed intervals.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_range_unsigned_values(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION wrap(x: u64) -> i32 {\n"
+    "  ENTRY:\n"
+    "    above = CMP_GT x, 5;\n"
+    "    BR above, LOW, NO;\n"
+    "  LOW:\n"
+    "    below = CMP_LT x, 100;\n"
+    "    BR below, BODY, NO;\n"
+    "  BODY:\n"
+    "    y = SUB x, 10;\n"
+    "    e = CMP_LT y, 90;\n"
+    "    BR e, YES, NO;\n"
+    "  YES:\n"
+    "    RET 1;\n"
+    "  NO:\n"
+    "    RET 0;\n"
+    "}\n"
+    "FUNCTION narrow(x: u32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    below = CMP_LT x, 10;\n"
+    "    BR below, BODY, NO;\n"
+    "  BODY:\n"
+    "    small = CMP_LT x, 20;\n"
+    "    BR small, YES, NO;\n"
+    "  YES:\n"
+    "    RET 1;\n"
+    "  NO:\n"
+    "    RET 0;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_BASIC, &test);
+  
+  /* x = 6 gives y = 2^64 - 4, so the comparison is kept */
+  if (success) {
+    ast_node_t* e = find_block(test.module, "wrap", "BODY")->data.stmt_block.statements.nodes[1];
+    success = strcmp(e->data.stmt_assign.value->data.stmt_instruction.opcode, "CMP_LT") == 0;
+    if (!success) {
+      fprintf(stderr, "Expected the unsigned 64-bit comparison to be kept\n");
+    }
+  }
+  
+  /* Narrower unsigned values still fit the intervals */
+  if (success) {
+    ast_node_t* small = find_block(test.module, "narrow", "BODY")->data.stmt_block.statements.nodes[0];
+    success = strcmp(small->data.stmt_assign.value->data.stmt_instruction.opcode, "ADD") == 0;
+    if (!success) {
+      fprintf(stderr, "Expected the unsigned 32-bit comparison to be folded\n");
+    }
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that definitions sink to their uses but not into loops.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_sink_definitions(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION pick(a: i32, b: i32, c: bool) -> i32 {\n"
+    "  ENTRY:\n"
+    "    t = MUL a, 3;\n"
+    "    u = ADD t, b;\n"
+    "    w = ADD a, b;\n"
+    "    BR c, THEN, ELSE;\n"
+    "  THEN:\n"
+    "    RET u;\n"
+    "  ELSE:\n"
+    "    s = ADD 0, 0;\n"
+    "  LOOP:\n"
+    "    s = ADD s, w;\n"
+    "    d = CMP_LT s, 100;\n"
+    "    BR d, LOOP, DONE;\n"
+    "  DONE:\n"
+    "    RET s;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_BASIC, &test);
+  
+  /* The multiply and its user move into the arm that returns them */
+  if (success) {
+    ast_node_t* entry = find_block(test.module, "pick", "ENTRY");
+    ast_node_t* then = find_block(test.module, "pick", "THEN");
+    success = entry->data.stmt_block.statements.count == 1 &&
+              then->data.stmt_block.statements.count == 3 &&
+              strcmp(then->data.stmt_block.statements.nodes[0]->data.stmt_assign.target, "t") == 0 &&
+              strcmp(then->data.stmt_block.statements.nodes[1]->data.stmt_assign.target, "u") == 0;
+    if (!success) {
+      fprintf(stderr, "Expected t and u to sink into THEN\n");
+    }
+  }
+  
+  /* The sum used in the loop stops in front of it */
+  if (success) {
+    ast_node_t* arm = find_block(test.module, "pick", "ELSE");
+    ast_node_t* loop = find_block(test.module, "pick", "LOOP");
+    success = arm->data.stmt_block.statements.count == 2 &&
+              strcmp(arm->data.stmt_block.statements.nodes[0]->data.stmt_assign.target, "w") == 0 &&
+              loop->data.stmt_block.statements.count == 3;
+    if (!success) {
+      fprintf(stderr, "Expected w to sink into ELSE and not into LOOP\n");
+    }
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that aggregates read field by field are split into scalars.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_sroa_aggregates(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "TYPE pair { lo: i32, hi: i32 }\n"
+    "TYPE box { inner: pair, tag: i32 }\n"
+    "FUNCTION span(p: ptr<box>, q: ptr<box>, r: ptr<array<i32, 4>>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    b = LOAD p;\n"
+    "    c = SUB b.inner.hi, b.inner.lo;\n"
+    "    STORE q, b;\n"
+    "    a = LOAD r;\n"
+    "    d = ADD a[1], a[3];\n"
+    "    e = ADD c, d;\n"
+    "    RET e;\n"
+    "}\n"
+    "FUNCTION keep(p: ptr<pair>) -> pair {\n"
+    "  ENTRY:\n"
+    "    g = LOAD p;\n"
+    "    RET g;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_BASIC, &test);
+  
+  /* Three field loads, three field stores and two element loads replace b and a */
+  if (success) {
+    ast_node_t* entry = find_block(test.module, "span", "ENTRY");
+    ast_node_list_t* statements = &entry->data.stmt_block.statements;
+    success = statements->count == 12;
+    for (size_t i = 0; i < statements->count && success; i++) {
+      ast_node_t* stmt = statements->nodes[i];
+      bool store = i >= 4 && i <= 6;
+      bool load = i <= 2 || i == 7 || i == 8;
+      success = (stmt->type == AST_STMT_INSTRUCTION) == store &&
+                (!load || strncmp(stmt->data.stmt_assign.target, "__hoilc_sroa_", 13) == 0);
+    }
+    
+    ast_node_t* address = success ? 
+      statements->nodes[0]->data.stmt_assign.value->data.stmt_instruction.operands.nodes[0] : NULL;
+    success = success && address->type == AST_EXPR_FIELD && address->data.expr_field.is_address &&
+              strcmp(address->data.expr_field.field, "lo") == 0 &&
+              address->data.expr_field.object->type == AST_EXPR_FIELD;
+    if (!success) {
+      fprintf(stderr, "Expected b and a to be split into element loads and stores\n");
+    }
+  }
+  
+  /* An aggregate that is returned whole stays as it is */
+  if (success) {
+    const char* targets[] = { "g" };
+    success = check_targets(find_block(test.module, "keep", "ENTRY"), targets, 1);
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that internal functions lose unused parameters and results.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_dead_arguments(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "GLOBAL counter: i32 = 0;\n"
+    "INTERNAL FUNCTION scale(unused: i32, p: ptr<i32>, k: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    v = LOAD p;\n"
+    "    r = MUL v, k;\n"
+    "    w = LOAD p;\n"
+    "    s = ADD r, w;\n"
+    "    RET s;\n"
+    "}\n"
+    "INTERNAL FUNCTION note(x: i32, y: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    STORE counter, x;\n"
+    "    RET y;\n"
+    "}\n"
+    "FUNCTION exported(a: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    RET 1;\n"
+    "}\n"
+    "FUNCTION main(q: ptr<i32>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    a = CALL scale(7, q, 3);\n"
+    "    ignored = CALL note(a, 5);\n"
+    "    CALL note(a, 6);\n"
+    "    c = CALL exported(a);\n"
+    "    RET c;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_BASIC, &test);
+  
+  /* The pointer is passed by value and the unread parameters are gone */
+  if (success) {
+    ast_node_t* scale = find_function(test.module, "scale");
+    ast_node_t* note = find_function(test.module, "note");
+    ast_node_t* exported = find_function(test.module, "exported");
+    success = scale->data.function.parameters.count == 2 &&
+              scale->data.function.parameters.nodes[0]->data.parameter.type->type == AST_TYPE_INT &&
+              note->data.function.parameters.count == 1 &&
+              note->data.function.return_type->type == AST_TYPE_VOID &&
+              exported->data.function.parameters.count == 1;
+    if (!success) {
+      fprintf(stderr, "Unexpected signatures after argument elimination\n");
+    }
+  }
+  
+  /* The caller loads the value and drops the unused result */
+  if (success) {
+    const char* targets[] = { "__hoilc_promoted_0", "a", NULL, NULL, "c" };
+    ast_node_t* entry = find_block(test.module, "main", "ENTRY");
+    success = check_targets(entry, targets, 5);
+    
+    ast_node_t* call = success ? entry->data.stmt_block.statements.nodes[1]->
+      data.stmt_assign.value->data.stmt_instruction.operands.nodes[0] : NULL;
+    ast_node_t* first = find_block(test.module, "scale", "ENTRY")->data.stmt_block.statements.nodes[0];
+    success = success && call->data.expr_call.arguments.count == 2 &&
+              strcmp(call->data.expr_call.arguments.nodes[0]->data.expr_identifier.name,
+                     "__hoilc_promoted_0") == 0 &&
+              strcmp(first->data.stmt_assign.value->data.stmt_instruction.opcode, "ADD") == 0;
+    if (!success) {
+      fprintf(stderr, "Call sites were not rewritten as expected\n");
+    }
+  }
+  
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test the memory effects classification and the refined call flags.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_function_effects(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "GLOBAL total: i32 = 0;\n"
+    "EXTERN FUNCTION puts(s: ptr<u8>) -> i32;\n"
+    "FUNCTION square(a: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = MUL a, a;\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION peek() -> i32 {\n"
+    "  ENTRY:\n"
+    "    v = LOAD total;\n"
+    "    RET v;\n"
+    "}\n"
+    "FUNCTION bump(p: ptr<i32>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    v = LOAD p;\n"
+    "    w = CALL square(v);\n"
+    "    STORE p, w;\n"
+    "    RET w;\n"
+    "}\n"
+    "FUNCTION wrap(p: ptr<i32>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL bump(p);\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION ping(n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    c = CALL peek();\n"
+    "    r = CALL pong(c);\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION pong(n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL ping(n);\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION spill(x: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    STORE total, x;\n"
+    "    RET x;\n"
+    "}\n"
+    "FUNCTION greet(s: ptr<u8>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL puts(s);\n"
+    "    RET r;\n"
+    "}\n"
+    "FUNCTION claim(x: i32) -> i32 [pure] {\n"
+    "  ENTRY:\n"
+    "    STORE total, x;\n"
+    "    RET x;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_NONE, &test);
+  callgraph_t* cg = success ? callgraph_build(test.module) : NULL;
+  effects_t* effects = cg != NULL ? effects_analyze(test.module, cg) : NULL;
+  success = effects != NULL;
+  
+  if (success) {
+    /* The body of claim overrides its pure attribute */
+    const char* names[] = { "puts", "square", "peek", "bump", "wrap", "ping", "pong",
+                            "spill", "greet", "claim" };
+    const function_effect_t expected[] = {
+      FUNCTION_EFFECT_ANY, FUNCTION_EFFECT_READNONE, FUNCTION_EFFECT_READONLY,
+      FUNCTION_EFFECT_ARGMEM, FUNCTION_EFFECT_ARGMEM, FUNCTION_EFFECT_READONLY,
+      FUNCTION_EFFECT_READONLY, FUNCTION_EFFECT_ANY, FUNCTION_EFFECT_ANY, FUNCTION_EFFECT_ANY
+    };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]) && success; i++) {
+      int32_t function = callgraph_find(cg, names[i]);
+      success = function >= 0 && effects_get(effects, (size_t)function) == expected[i];
+      if (!success) {
+        fprintf(stderr, "Unexpected effects for %s\n", names[i]);
+      }
+    }
+  }
+  
+  /* Calls to square no longer touch memory and calls to peek only read it */
+  if (success) {
+    ast_node_t* bump = find_function(test.module, "bump");
+    ast_node_t* ping = find_function(test.module, "ping");
+    ast_node_t* wrap = find_function(test.module, "wrap");
+    uint32_t pure_call = effects_get_flags(effects, bump,
+      find_block(test.module, "bump", "ENTRY")->data.stmt_block.statements.nodes[1]);
+    uint32_t read_call = effects_get_flags(effects, ping,
+      find_block(test.module, "ping", "ENTRY")->data.stmt_block.statements.nodes[0]);
+    uint32_t write_call = effects_get_flags(effects, wrap,
+      find_block(test.module, "wrap", "ENTRY")->data.stmt_block.statements.nodes[0]);
+    success = (pure_call & (IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY)) == 0 &&
+              (read_call & (IR_FLAG_READS_MEMORY | IR_FLAG_WRITES_MEMORY)) ==
+              IR_FLAG_READS_MEMORY &&
+              (write_call & IR_FLAG_WRITES_MEMORY) != 0;
+    if (!success) {
+      fprintf(stderr, "Unexpected call flags\n");
+    }
+  }
+  
+  effects_destroy(effects);
+  callgraph_destroy(cg);
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that superlinear passes skip functions over the budget.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_optimization_budget(void) {
+  /* small has 6 statements and big 8, against a limit of 6 */
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION small(i: i32, n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    lt = CMP_LT i, n;\n"
+    "    BR lt, INSIDE, BAD;\n"
+    "  INSIDE:\n"
+    "    again = CMP_LT i, n;\n"
+    "    BR again, OK, BAD;\n"
+    "  OK:\n"
+    "    RET i;\n"
+    "  BAD:\n"
+    "    RET 0;\n"
+    "}\n"
+    "FUNCTION big(i: i32, n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    j = ADD i, 1;\n"
+    "    k = ADD j, 1;\n"
+    "    lt = CMP_LT k, n;\n"
+    "    BR lt, INSIDE, BAD;\n"
+    "  INSIDE:\n"
+    "    again = CMP_LT k, n;\n"
+    "    BR again, OK, BAD;\n"
+    "  OK:\n"
+    "    RET k;\n"
+    "  BAD:\n"
+    "    RET 0;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_NONE, &test);
+  optimize_context_t* optimize_ctx = success ? optimize_create_context(
+    test.error_ctx, typecheck_get_symbol_table(test.typecheck_ctx)
+  ) : NULL;
+  success = optimize_ctx != NULL;
+  
+  if (success) {
+    hoilc_budget_t budget = { 6, 0, 0 };
+    optimize_set_level(optimize_ctx, HOILC_OPT_BASIC);
+    optimize_set_budget(optimize_ctx, &budget);
+    success = optimize_module(optimize_ctx, test.module);
+  }
+  
+  /* Range propagation folds the repeated test of small only */
+  if (success) {
+    ast_node_t* small = find_block(test.module, "small", "INSIDE")->data.stmt_block.statements.nodes[0];
+    ast_node_t* big = find_block(test.module, "big", "INSIDE")->data.stmt_block.statements.nodes[0];
+    success = strcmp(small->data.stmt_assign.value->data.stmt_instruction.opcode, "ADD") == 0 &&
+              strcmp(big->data.stmt_assign.value->data.stmt_instruction.opcode, "CMP_LT") == 0;
+    if (!success) {
+      fprintf(stderr, "Expected only the function within the budget to be optimized\n");
+    }
+  }
+  
+  /* Every skip concerns big and the range skip is logged */
+  bool logged = false;
+  for (size_t i = 0; success && i < optimize_get_skip_count(optimize_ctx); i++) {
+    const char* skip = optimize_get_skip(optimize_ctx, i);
+    success = strstr(skip, "'big'") != NULL && strstr(skip, "8 instructions") != NULL;
+    logged = logged || strstr(skip, "'range'") != NULL;
+  }
+  if (success && !logged) {
+    fprintf(stderr, "Expected the skipped pass to be logged\n");
+    success = false;
+  }
+  
+  optimize_destroy_context(optimize_ctx);
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test that passes report what they did at the source location.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_optimization_remarks(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION clamp(i: i32, n: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    lt = CMP_LT i, n;\n"
+    "    BR lt, INSIDE, BAD;\n"
+    "  INSIDE:\n"
+    "    again = CMP_LT i, n;\n"
+    "    BR again, OK, BAD;\n"
+    "  OK:\n"
+    "    RET i;\n"
+    "  BAD:\n"
+    "    RET 0;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_NONE, &test);
+  remark_log_t* remarks = remark_create_log();
+  optimize_context_t* optimize_ctx = success ? optimize_create_context(
+    test.error_ctx, typecheck_get_symbol_table(test.typecheck_ctx)
+  ) : NULL;
+  success = optimize_ctx != NULL && remarks != NULL;
+  
+  if (success) {
+    optimize_set_level(optimize_ctx, HOILC_OPT_BASIC);
+    optimize_set_remarks(optimize_ctx, remarks);
+    success = optimize_module(optimize_ctx, test.module);
+  }
+  
+  /* The repeated comparison on line 7 and its branch are folded */
+  bool comparison = false;
+  bool branch = false;
+  for (size_t i = 0; success && i < remark_count(remarks); i++) {
+    const remark_t* remark = remark_get(remarks, i);
+    if (remark->kind != HOILC_REMARK_PASSED || strcmp(remark->pass, "range") != 0 ||
+        remark->function == NULL || strcmp(remark->function, "clamp") != 0) {
+      continue;
+    }
+    comparison = comparison || (strcmp(remark->name, "FoldedComparison") == 0 &&
+                                remark->line == 7 && remark->column == 5);
+    branch = branch || (strcmp(remark->name, "FoldedBranch") == 0 && remark->line == 8 &&
+                        remark->column == 5 && strstr(remark->message, "'OK'") != NULL);
+  }
+  if (success && (!comparison || !branch)) {
+    fprintf(stderr, "Expected remarks for the folded comparison and branch\n");
+    success = false;
+  }
+  
+  /* The record is a JSON array of remark objects */
+  FILE* file = success ? tmpfile() : NULL;
+  if (file != NULL) {
+    char buffer[4096];
+    success = remark_write_json(remarks, file);
+    rewind(file);
+    size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+    buffer[length] = '\0';
+    success = success && buffer[0] == '[' &&
+              strstr(buffer, "\"kind\": \"passed\", \"pass\": \"range\"") != NULL &&
+              strstr(buffer, "\"line\": 7, \"column\": 5") != NULL;
+    if (!success) {
+      fprintf(stderr, "Unexpected optimization record\n");
+    }
+    fclose(file);
+  }
+  
+  optimize_destroy_context(optimize_ctx);
+  remark_destroy_log(remarks);
+  release_module(&test);
+  return success;
+}
+
+/**
+ * @brief Test the peephole rules on the encoded instructions of a function.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_peephole_rules(void) {
+  coil_builder_t* builder = coil_builder_create();
+  int32_t param_type = PREDEFINED_INT32;
+  int32_t function = builder != NULL ?
+    coil_builder_add_function(builder, "f", PREDEFINED_INT32, &param_type, 1, false) : -1;
+  bool success = function >= 0 && coil_builder_set_peephole(builder, true) &&
+                 coil_builder_begin_function_code(builder, function);
+  
+  /* r5 is never read, the conditional branch has equal targets and its */
+  /* result is a branch to the next block, as is the branch of NEXT */
+  uint8_t cond_operands[] = { 0, 1, 1 };
+  uint8_t next_operands[] = { 2 };
+  uint8_t ret_operands[] = { 2 };
+  uint8_t param_operands[] = { 0 };
+  success = success &&
+            coil_builder_add_block(builder, "ENTRY") == 0 &&
+            coil_builder_add_instruction(builder, OPCODE_LOAD, 0, 5, NULL, 0) &&
+            coil_builder_add_instruction(builder, OPCODE_BR_COND, 0, 0xFF, cond_operands, 3) &&
+            coil_builder_add_instruction(builder, OPCODE_RET, 0, 0xFF, param_operands, 1) &&
+            coil_builder_add_block(builder, "NEXT") == 1 &&
+            coil_builder_add_instruction(builder, OPCODE_BR, 0, 0xFF, next_operands, 1) &&
+            coil_builder_add_block(builder, "DONE") == 2 &&
+            coil_builder_add_instruction(builder, OPCODE_LOAD, 0, 2, NULL, 0) &&
+            coil_builder_add_instruction(builder, OPCODE_RET, 0, 0xFF, ret_operands, 1) &&
+            coil_builder_end_function_code(builder);
+  
+  uint8_t* output = NULL;
+  size_t size = 0;
+  success = success && coil_builder_build(builder, &output, &size);
+  
+  /* Only the load of r2 and the return remain */
+  if (success) {
+    uint32_t offset;
+    memcpy(&offset, output + 16 + SECTION_CODE * 12 + 4, sizeof(offset));
+    offset += 8;
+    
+    const uint32_t expected_sizes[] = { 0, 0, 9 };
+    const uint8_t expected_code[] = { OPCODE_LOAD, 0, 0, 2, OPCODE_RET, 0, 1, 0xFF, 2 };
+    for (size_t i = 0; i < 3 && success; i++) {
+      uint32_t length, code_size;
+      memcpy(&length, output + offset, sizeof(length));
+      offset += 4 + length;
+      memcpy(&code_size, output + offset, sizeof(code_size));
+      offset += 4;
+      success = code_size == expected_sizes[i] &&
+                (code_size == 0 || memcmp(output + offset, expected_code, code_size) == 0);
+      offset += code_size;
+    }
+    
+    if (!success) {
+      fprintf(stderr, "Unexpected code after peephole rules\n");
+    }
+  }
+  
+  free(output);
+  coil_builder_destroy(builder);
+  return success;
+}
+
+/**
+ * @brief Test that vector instructions are type checked, optimized and encoded.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_vector_operations(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION kernel(a: vec<i32, 4>, b: vec<i32, 4>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    s = SPLAT 2, 4;\n"
+    "    m = MUL a, s;\n"
+    "    r = SHUFFLE m, b, 3, 2, 5, 4;\n"
+    "    w = INSERT r, 7, 0;\n"
+    "    x = EXTRACT w, 1;\n"
+    "    t = REDUCE_ADD w;\n"
+    "    u = ADD t, x;\n"
+    "    RET u;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  
+  /* SPLAT builds a vector of its lane count and EXTRACT yields an element */
+  ast_node_t* block = success ? find_block(test.module, "kernel", "ENTRY") : NULL;
+  success = block != NULL;
+  for (size_t i = 0; success && i < block->data.stmt_block.statements.count; i++) {
+    ast_node_t* stmt = block->data.stmt_block.statements.nodes[i];
+    const char* target = ir_get_def(stmt);
+    ast_node_t* type = target != NULL ? stmt->data.stmt_assign.target_type : NULL;
+    if (target != NULL && strcmp(target, "s") == 0) {
+      success = type->type == AST_TYPE_VEC && type->data.type_vec.size == 4 &&
+                type->data.type_vec.element_type->type == AST_TYPE_INT;
+    } else if (target != NULL && strcmp(target, "x") == 0) {
+      success = type->type == AST_TYPE_INT && type->data.type_int.bits == 32;
+    }
+  }
+  if (block != NULL && !success) {
+    fprintf(stderr, "Unexpected vector result types\n");
+  }
+  
+  /* The shuffle mask is encoded as immediates after the two vectors */
+  uint8_t* output = NULL;
+  size_t size = 0;
+  if (success) {
+    codegen_context_t* codegen_ctx = codegen_create_context(
+      test.error_ctx, typecheck_get_symbol_table(test.typecheck_ctx)
+    );
+    success = codegen_ctx != NULL && codegen_generate(codegen_ctx, test.module, &output, &size);
+    codegen_destroy_context(codegen_ctx);
+    
+    bool found = false;
+    for (size_t i = 0; success && !found && i + 10 <= size; i++) {
+      found = output[i] == OPCODE_SHUFFLE && output[i + 2] == 6 && output[i + 6] == 3 &&
+              output[i + 7] == 2 && output[i + 8] == 5 && output[i + 9] == 4;
+    }
+    success = success && found;
+    if (!success) {
+      fprintf(stderr, "Shuffle mask not encoded\n");
+    }
+  }
+  free(output);
+  release_module(&test);
+  
+  /* Lanes must exist in the vector */
+  const char* bad_lane =
+    "MODULE \"test\";\n"
+    "FUNCTION lane(a: vec<f32, 4>) -> f32 {\n"
+    "  ENTRY:\n"
+    "    x = EXTRACT a, 4;\n"
+    "    RET x;\n"
+    "}\n";
+  
+  if (success) {
+    success = !compile_module(bad_lane, HOILC_OPT_NONE, &test) &&
+              strstr(error_get_message(test.error_ctx), "out of range") != NULL;
+    release_module(&test);
+    if (!success) {
+      fprintf(stderr, "Out of range lane accepted\n");
+    }
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test that atomic instructions keep their order and encode their flags.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_atomic_operations(void) {
+  /* u is never used, but the load is still an atomic access */
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION spin(p: ptr<i32>, q: ptr<i32>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    ATOMIC_STORE q, 1, release;\n"
+    "    FENCE seq_cst;\n"
+    "    v = ATOMIC_LOAD p, acquire;\n"
+    "    old = ATOMIC_RMW xchg, p, v, seq_cst;\n"
+    "    prev = CMPXCHG p, old, 0, acq_rel;\n"
+    "    u = ATOMIC_LOAD q, relaxed;\n"
+    "    RET prev;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  
+  /* Every atomic survives in source order with its ordering */
+  static const uint8_t expected[][2] = {
+    { OPCODE_ATOMIC_STORE, ORDER_RELEASE },
+    { OPCODE_FENCE, ORDER_SEQ_CST },
+    { OPCODE_ATOMIC_LOAD, ORDER_ACQUIRE },
+    { OPCODE_ATOMIC_RMW, (ATOMIC_RMW_XCHG << INSTRUCTION_RMW_SHIFT) | ORDER_SEQ_CST },
+    { OPCODE_CMPXCHG, ORDER_ACQ_REL },
+    { OPCODE_ATOMIC_LOAD, ORDER_RELAXED },
+  };
+  size_t found = 0;
+  ast_node_t* block = success ? find_block(test.module, "spin", "ENTRY") : NULL;
+  success = block != NULL;
+  for (size_t i = 0; success && i < block->data.stmt_block.statements.count; i++) {
+    ast_node_t* stmt = block->data.stmt_block.statements.nodes[i];
+    uint8_t opcode = ir_get_opcode(stmt);
+    if (opcode == OPCODE_RET) {
+      continue;
+    }
+    success = found < 6 && opcode == expected[found][0] &&
+              ir_get_instruction(stmt)->data.stmt_instruction.flags == expected[found][1];
+    found++;
+  }
+  success = success && found == 6;
+  if (block != NULL && !success) {
+    fprintf(stderr, "Atomic operations reordered or removed\n");
+  }
+  
+  /* The operation and ordering are encoded in the flags byte */
+  uint8_t* output = NULL;
+  size_t size = 0;
+  if (success) {
+    codegen_context_t* codegen_ctx = codegen_create_context(
+      test.error_ctx, typecheck_get_symbol_table(test.typecheck_ctx)
+    );
+    success = codegen_ctx != NULL && codegen_generate(codegen_ctx, test.module, &output, &size);
+    codegen_destroy_context(codegen_ctx);
+    
+    bool encoded = false;
+    for (size_t i = 0; success && !encoded && i + 6 <= size; i++) {
+      encoded = output[i] == OPCODE_ATOMIC_RMW && output[i + 1] == expected[3][1] &&
+                output[i + 2] == 2;
+    }
+    success = success && encoded;
+    if (!success) {
+      fprintf(stderr, "Atomic flags not encoded\n");
+    }
+  }
+  free(output);
+  release_module(&test);
+  
+  /* Loads cannot release */
+  const char* bad_order =
+    "MODULE \"test\";\n"
+    "FUNCTION load(p: ptr<i32>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    v = ATOMIC_LOAD p, release;\n"
+    "    RET v;\n"
+    "}\n";
+  
+  if (success) {
+    success = !compile_module(bad_order, HOILC_OPT_NONE, &test) &&
+              strstr(error_get_message(test.error_ctx), "Invalid memory ordering") != NULL;
+    release_module(&test);
+    if (!success) {
+      fprintf(stderr, "Invalid memory ordering accepted\n");
+    }
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test alias queries and the loads and stores they let the memory pass remove.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_alias_analysis(void) {
+  /* dst is restrict, so nothing reached through src is written until b */
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION kernel(dst: ptr<i32, restrict>, src: ptr<i32>, f: ptr<f32>,\n"
+    "                s: ptr<i32, shared>, g: ptr<i32, global>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    STORE dst, 0;\n"
+    "    a = LOAD src;\n"
+    "    STORE dst, a;\n"
+    "    q = ADD dst, 4;\n"
+    "    STORE q, a;\n"
+    "    b = LOAD src;\n"
+    "    x = LOAD f;\n"
+    "    STORE s, 1;\n"
+    "    STORE g, 2;\n"
+    "    c = ADD a, b;\n"
+    "    RET c;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_NONE, &test);
+  ast_node_t* block = success ? find_block(test.module, "kernel", "ENTRY") : NULL;
+  ast_node_t* function = NULL;
+  for (size_t i = 0; block != NULL && i < test.module->data.module.declarations.count; i++) {
+    if (test.module->data.module.declarations.nodes[i]->type == AST_FUNCTION) {
+      function = test.module->data.module.declarations.nodes[i];
+    }
+  }
+  alias_t* alias = function != NULL ?
+    alias_analyze(function, typecheck_get_symbol_table(test.typecheck_ctx)) : NULL;
+  success = alias != NULL;
+  
+  /* Restrict, memory spaces and accessed types each separate accesses */
+  if (success) {
+    ast_node_t** stmts = block->data.stmt_block.statements.nodes;
+    ast_node_list_t* params = &function->data.function.parameters;
+    success = params->nodes[0]->data.parameter.type->data.type_ptr.is_restrict &&
+              strcmp(params->nodes[3]->data.parameter.type->data.type_ptr.memory_space,
+                     "shared") == 0 &&
+              !alias_may_alias(alias, stmts[1], stmts[2]) &&
+              alias_may_alias(alias, stmts[2], stmts[4]) &&
+              !alias_may_alias(alias, stmts[6], stmts[4]) &&
+              !alias_may_alias(alias, stmts[7], stmts[8]) &&
+              alias_may_alias(alias, stmts[5], stmts[8]) &&
+              alias_may_alias(alias, stmts[3], stmts[4]);
+    if (!success) {
+      fprintf(stderr, "Unexpected alias results\n");
+    }
+  }
+  alias_destroy(alias);
+  release_module(&test);
+  
+  /* The first store to dst is overwritten and b is the value already loaded */
+  if (success) {
+    success = compile_module(source, HOILC_OPT_BASIC, &test);
+    block = success ? find_block(test.module, "kernel", "ENTRY") : NULL;
+    success = block != NULL;
+    size_t stores = 0;
+    bool forwarded = false;
+    for (size_t i = 0; success && i < block->data.stmt_block.statements.count; i++) {
+      ast_node_t* stmt = block->data.stmt_block.statements.nodes[i];
+      const char* target = ir_get_def(stmt);
+      stores += ir_get_opcode(stmt) == OPCODE_STORE ? 1 : 0;
+      if (target != NULL && strcmp(target, "b") == 0) {
+        forwarded = ir_get_opcode(stmt) == OPCODE_ADD;
+      }
+    }
+    success = success && stores == 4 && forwarded;
+    if (block != NULL && !success) {
+      fprintf(stderr, "Redundant load or dead store kept\n");
+    }
+    release_module(&test);
+  }
+  
+  /* Memory spaces must be known */
+  const char* bad_space =
+    "MODULE \"test\";\n"
+    "FUNCTION load(p: ptr<i32, texture>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    v = LOAD p;\n"
+    "    RET v;\n"
+    "}\n";
+  
+  if (success) {
+    success = !compile_module(bad_space, HOILC_OPT_NONE, &test) &&
+              strstr(error_get_message(test.error_ctx), "Unknown memory space") != NULL;
+    release_module(&test);
+    if (!success) {
+      fprintf(stderr, "Unknown memory space accepted\n");
+    }
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test that functions are compiled into versions for their targets.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_function_versions(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "TARGET wide {\n"
+    "  device = \"cpu\";\n"
+    "  required = [\"avx2\"];\n"
+    "  model = \"inorder\";\n"
+    "}\n"
+    "FUNCTION twice(x: i32) -> i32 TARGET wide {\n"
+    "  ENTRY:\n"
+    "    y = ADD x, x;\n"
+    "    RET y;\n"
+    "}\n"
+    "FUNCTION caller(x: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL twice(x);\n"
+    "    RET r;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  
+  /* The version is a separate function compiled for a copy of the target */
+  ast_node_t* version = success ? find_function(test.module, "twice.wide") : NULL;
+  success = version != NULL && version->data.function.target != NULL &&
+            strcmp(version->data.function.target->data.target.name, "wide") == 0 &&
+            version->data.function.versions.count == 0;
+  if (!success) {
+    fprintf(stderr, "Function version not created\n");
+  }
+  
+  /* twice dispatches to its baseline, added last, and to the version */
+  uint8_t* output = NULL;
+  size_t size = 0;
+  if (success) {
+    codegen_context_t* codegen_ctx = codegen_create_context(
+      test.error_ctx, typecheck_get_symbol_table(test.typecheck_ctx)
+    );
+    success = codegen_ctx != NULL && codegen_generate(codegen_ctx, test.module, &output, &size);
+    codegen_destroy_context(codegen_ctx);
+    
+    const uint32_t baseline[] = { METADATA_FUNCTION_VERSION, 0, 3, COIL_NO_TARGET };
+    const uint32_t wide[] = { METADATA_FUNCTION_VERSION, 0, 2, 0 };
+    const uint8_t feature[] = { 4, 0, 0, 0, 'a', 'v', 'x', '2' };
+    bool found_baseline = false;
+    bool found_wide = false;
+    bool found_feature = false;
+    for (size_t i = 0; success && i + sizeof(baseline) <= size; i++) {
+      found_baseline = found_baseline || memcmp(output + i, baseline, sizeof(baseline)) == 0;
+      found_wide = found_wide || memcmp(output + i, wide, sizeof(wide)) == 0;
+      found_feature = found_feature || memcmp(output + i, feature, sizeof(feature)) == 0;
+    }
+    success = success && found_baseline && found_wide && found_feature;
+    if (!success) {
+      fprintf(stderr, "Function versions not recorded\n");
+    }
+  }
+  free(output);
+  release_module(&test);
+  
+  /* Versions need a declared target */
+  const char* bad_target =
+    "MODULE \"test\";\n"
+    "FUNCTION f() -> i32 TARGET missing {\n"
+    "  ENTRY:\n"
+    "    RET 0;\n"
+    "}\n";
+  
+  if (success) {
+    success = !compile_module(bad_target, HOILC_OPT_NONE, &test) &&
+              strstr(error_get_message(test.error_ctx), "Unknown target") != NULL;
+    release_module(&test);
+    if (!success) {
+      fprintf(stderr, "Unknown target accepted\n");
+    }
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test function attributes, their metadata and the code placement they select.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_function_attributes(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "EXTERN FUNCTION hash(x: i32) -> i32 [pure];\n"
+    "FUNCTION rare(x: i32) -> i32 [cold, noinline] {\n"
+    "  ENTRY:\n"
+    "    y = MUL x, 3;\n"
+    "    RET y;\n"
+    "}\n"
+    "FUNCTION fast(x: i32) -> i32 [hot] {\n"
+    "  ENTRY:\n"
+    "    a = CALL hash(x);\n"
+    "    RET a;\n"
+    "}\n"
+    "FUNCTION main(x: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    r = CALL fast(x);\n"
+    "    s = CALL rare(r);\n"
+    "    RET s;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  
+  uint8_t* output = NULL;
+  size_t size = 0;
+  if (success) {
+    codegen_context_t* codegen_ctx = codegen_create_context(
+      test.error_ctx, typecheck_get_symbol_table(test.typecheck_ctx)
+    );
+    success = codegen_ctx != NULL && codegen_generate(codegen_ctx, test.module, &output, &size);
+    codegen_destroy_context(codegen_ctx);
+  }
+  
+  /* The pure external function accesses no memory, and attributes are recorded */
+  const uint32_t pure[] = { METADATA_FUNCTION_EFFECTS, 0, FUNCTION_EFFECT_READNONE };
+  const uint32_t cold[] = { 
+    METADATA_FUNCTION_ATTRIBUTES, 1, FUNCTION_ATTRIBUTE_COLD | FUNCTION_ATTRIBUTE_NOINLINE 
+  };
+  bool found_pure = false;
+  bool found_cold = false;
+  for (size_t i = 0; success && i + sizeof(pure) <= size; i++) {
+    found_pure = found_pure || memcmp(output + i, pure, sizeof(pure)) == 0;
+    found_cold = found_cold || memcmp(output + i, cold, sizeof(cold)) == 0;
+  }
+  success = success && found_pure && found_cold;
+  if (output != NULL && !success) {
+    fprintf(stderr, "Function attributes not recorded\n");
+  }
+  
+  /* The code section holds fast, then main, then rare */
+  section_header_t code = { 0, 0, 0 };
+  for (size_t i = 0; success && i < SECTION_COUNT; i++) {
+    section_header_t header;
+    memcpy(&header, output + sizeof(coil_header_t) + i * sizeof(header), sizeof(header));
+    if (header.section_type == SECTION_CODE) {
+      code = header;
+    }
+  }
+  
+  const uint32_t expected[] = { 2, 3, 1 };
+  size_t count = 0;
+  size_t offset = code.offset;
+  while (success && offset < (size_t)code.offset + code.size) {
+    uint32_t function, block_count;
+    memcpy(&function, output + offset, sizeof(function));
+    memcpy(&block_count, output + offset + 4, sizeof(block_count));
+    offset += 8;
+    for (uint32_t b = 0; b < block_count; b++) {
+      uint32_t length;
+      memcpy(&length, output + offset, sizeof(length));
+      offset += 4 + length;
+      memcpy(&length, output + offset, sizeof(length));
+      offset += 4 + length;
+    }
+    success = count < 3 && function == expected[count];
+    count++;
+  }
+  success = success && count == 3;
+  if (output != NULL && !success) {
+    fprintf(stderr, "Hot and cold functions not placed\n");
+  }
+  free(output);
+  release_module(&test);
+  
+  /* A function cannot be both hot and cold */
+  const char* conflict =
+    "MODULE \"test\";\n"
+    "FUNCTION f() -> i32 [hot, cold] {\n"
+    "  ENTRY:\n"
+    "    RET 0;\n"
+    "}\n";
+  
+  if (success) {
+    success = !compile_module(conflict, HOILC_OPT_NONE, &test) &&
+              strstr(error_get_message(test.error_ctx), "Conflicting function attributes") != NULL;
+    release_module(&test);
+    if (!success) {
+      fprintf(stderr, "Conflicting attributes accepted\n");
+    }
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test the alignment and non-temporal access modifiers and prefetches.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_access_hints(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION stream(src: ptr<i32>, dst: ptr<i32>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    PREFETCH src, read, 3;\n"
+    "    v = LOAD src, align=64, nontemporal;\n"
+    "    w = MUL v, 2;\n"
+    "    STORE dst, w, nontemporal;\n"
+    "    PREFETCH dst, write, 0;\n"
+    "    RET w;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  
+  uint8_t* output = NULL;
+  size_t size = 0;
+  if (success) {
+    codegen_context_t* codegen_ctx = codegen_create_context(
+      test.error_ctx, typecheck_get_symbol_table(test.typecheck_ctx)
+    );
+    success = codegen_ctx != NULL && codegen_generate(codegen_ctx, test.module, &output, &size);
+    codegen_destroy_context(codegen_ctx);
+  }
+  
+  /* 64-byte alignment is encoded as 6 + 1 in the low bits of the flags */
+  bool load = false;
+  bool store = false;
+  bool read = false;
+  bool write = false;
+  for (size_t i = 0; success && i + 6 <= size; i++) {
+    load = load || (output[i] == OPCODE_LOAD && output[i + 1] == (INSTRUCTION_NONTEMPORAL | 7) &&
+                    output[i + 2] == 1);
+    store = store || (output[i] == OPCODE_STORE && output[i + 1] == INSTRUCTION_NONTEMPORAL &&
+                      output[i + 2] == 2);
+    read = read || (output[i] == OPCODE_PREFETCH && output[i + 1] == 0 &&
+                    output[i + 2] == 2 && output[i + 5] == 3);
+    write = write || (output[i] == OPCODE_PREFETCH && output[i + 1] == INSTRUCTION_PREFETCH_WRITE &&
+                      output[i + 2] == 2 && output[i + 5] == 0);
+  }
+  success = success && load && store && read && write;
+  if (!success) {
+    fprintf(stderr, "Access hints not encoded\n");
+  }
+  free(output);
+  release_module(&test);
+  
+  /* Alignments must be powers of two */
+  const char* bad_alignment =
+    "MODULE \"test\";\n"
+    "FUNCTION load(p: ptr<i32>) -> i32 {\n"
+    "  ENTRY:\n"
+    "    v = LOAD p, align=48;\n"
+    "    RET v;\n"
+    "}\n";
+  
+  if (success) {
+    success = !compile_module(bad_alignment, HOILC_OPT_NONE, &test) &&
+              strstr(error_get_message(test.error_ctx), "not a power of two") != NULL;
+    release_module(&test);
+    if (!success) {
+      fprintf(stderr, "Invalid alignment accepted\n");
+    }
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test branch probability hints, their encoding and the block layout they drive.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_branch_hints(void) {
+  /* FAIL is only reached through the unlikely edge, so it moves to the end */
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION check(x: i32) -> i32 {\n"
+    "  ENTRY:\n"
+    "    failed = CMP_LT x, 0;\n"
+    "    BR failed, FAIL, WORK !unlikely;\n"
+    "  FAIL:\n"
+    "    e = SUB 0, 1;\n"
+    "    RET e;\n"
+    "  WORK:\n"
+    "    y = MUL x, 2;\n"
+    "    big = CMP_GT y, 100;\n"
+    "    BR big, LARGE, DONE !weights(3, 1);\n"
+    "  LARGE:\n"
+    "    z = SUB y, 100;\n"
+    "    RET z;\n"
+    "  DONE:\n"
+    "    RET y;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_FULL, &test);
+  
+  static const char* const expected[] = { "ENTRY", "WORK", "LARGE", "DONE", "FAIL" };
+  ast_node_t* function = success ? find_function(test.module, "check") : NULL;
+  success = function != NULL && function->data.function.blocks.count == 5;
+  for (size_t i = 0; success && i < 5; i++) {
+    success = strcmp(function->data.function.blocks.nodes[i]->data.stmt_block.label,
+                     expected[i]) == 0;
+  }
+  if (function != NULL && !success) {
+    fprintf(stderr, "Cold block not moved out of line\n");
+  }
+  
+  /* The probability of the true target is encoded in 254ths plus one */
+  uint8_t* output = NULL;
+  size_t size = 0;
+  if (success) {
+    codegen_context_t* codegen_ctx = codegen_create_context(
+      test.error_ctx, typecheck_get_symbol_table(test.typecheck_ctx)
+    );
+    success = codegen_ctx != NULL && codegen_generate(codegen_ctx, test.module, &output, &size);
+    codegen_destroy_context(codegen_ctx);
+    
+    bool unlikely = false;
+    bool weighted = false;
+    for (size_t i = 0; success && i + 3 <= size; i++) {
+      unlikely = unlikely || (output[i] == OPCODE_BR_COND && output[i + 1] == 1 &&
+                              output[i + 2] == 3);
+      weighted = weighted || (output[i] == OPCODE_BR_COND && output[i + 1] == 192 &&
+                              output[i + 2] == 3);
+    }
+    success = success && unlikely && weighted;
+    if (!success) {
+      fprintf(stderr, "Branch hints not encoded\n");
+    }
+  }
+  free(output);
+  release_module(&test);
+  
+  return success;
+}
+
+/**
+ * @brief Test the bit manipulation instructions, their folding and rotate recognition.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_bit_manipulation(void) {
+  /* Only the unsigned pair forms rotates; the smaller amount picks the direction */
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION mix(x: u32, s: i32) -> u32 {\n"
+    "  ENTRY:\n"
+    "    hi = SHL x, 8;\n"
+    "    lo = SHR x, 24;\n"
+    "    left = OR hi, lo;\n"
+    "    a = SHR x, 4;\n"
+    "    b = SHL x, 28;\n"
+    "    right = OR b, a;\n"
+    "    c = SHL s, 8;\n"
+    "    d = SHR s, 24;\n"
+    "    e = OR c, d;\n"
+    "    r = XOR left, right;\n"
+    "    RET r;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_BASIC, &test);
+  
+  ast_node_t* block = success ? find_block(test.module, "mix", "ENTRY") : NULL;
+  size_t rotates = 0;
+  size_t shifts = 0;
+  for (size_t i = 0; block != NULL && i < block->data.stmt_block.statements.count; i++) {
+    ast_node_t* stmt = block->data.stmt_block.statements.nodes[i];
+    ast_node_t* instruction = ir_get_instruction(stmt);
+    uint8_t opcode = ir_get_opcode(stmt);
+    if (opcode == OPCODE_ROTL || opcode == OPCODE_ROTR) {
+      int64_t amount = instruction->data.stmt_instruction.operands.nodes[1]->data.expr_integer.value;
+      rotates += (opcode == OPCODE_ROTL && strcmp(ir_get_def(stmt), "left") == 0 && amount == 8) ||
+                 (opcode == OPCODE_ROTR && strcmp(ir_get_def(stmt), "right") == 0 && amount == 4);
+    }
+    shifts += opcode == OPCODE_SHL || opcode == OPCODE_SHR;
+  }
+  success = block != NULL && rotates == 2 && shifts == 2;
+  if (block != NULL && !success) {
+    fprintf(stderr, "Rotate idioms not recognized: %zu rotates, %zu shifts\n", rotates, shifts);
+  }
+  release_module(&test);
+  
+  /* Folding works on the unsigned value of the type width */
+  ast_node_t* u8 = ast_create_node(AST_TYPE_INT);
+  ast_node_t* u32 = ast_create_node(AST_TYPE_INT);
+  if (u8 == NULL || u32 == NULL) {
+    ast_destroy_node(u8);
+    ast_destroy_node(u32);
+    return false;
+  }
+  u8->data.type_int.bits = 8;
+  u32->data.type_int.bits = 32;
+  
+  static const struct {
+    uint8_t opcode;
+    bool wide;
+    int64_t operands[2];
+    size_t count;
+    int64_t expected;
+  } folds[] = {
+    { OPCODE_POPCNT, true, { 61680 }, 1, 8 },
+    { OPCODE_CLZ, true, { 1 }, 1, 31 },
+    { OPCODE_CTZ, true, { 0 }, 1, 32 },
+    { OPCODE_CTZ, false, { 40 }, 1, 3 },
+    { OPCODE_BSWAP, true, { 305419896 }, 1, 2018915346 },
+    { OPCODE_ROTL, false, { 129, 1 }, 2, 3 },
+    { OPCODE_ROTR, true, { 1, 33 }, 2, 2147483648 },
+  };
+  for (size_t i = 0; success && i < sizeof(folds) / sizeof(folds[0]); i++) {
+    int64_t value;
+    success = ir_fold_integer(folds[i].opcode, folds[i].wide ? u32 : u8, folds[i].operands,
+                              folds[i].count, &value) && value == folds[i].expected;
+    if (!success) {
+      fprintf(stderr, "Bit manipulation fold %zu is wrong\n", i);
+    }
+  }
+  
+  int64_t byte = 1;
+  int64_t swapped;
+  if (success && ir_fold_integer(OPCODE_BSWAP, u8, &byte, 1, &swapped)) {
+    fprintf(stderr, "Byte swap of a single byte folded\n");
+    success = false;
+  }
+  ast_destroy_node(u8);
+  ast_destroy_node(u32);
+  
+  const char* bad_swap =
+    "MODULE \"test\";\n"
+    "FUNCTION f(x: u8) -> u8 {\n"
+    "  ENTRY:\n"
+    "    y = BSWAP x;\n"
+    "    RET y;\n"
+    "}\n";
+  
+  if (success) {
+    success = !compile_module(bad_swap, HOILC_OPT_NONE, &test) &&
+              strstr(error_get_message(test.error_ctx), "multiple of 16") != NULL;
+    release_module(&test);
+    if (!success) {
+      fprintf(stderr, "Byte swap of a single byte accepted\n");
+    }
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Test the high, widening and saturating arithmetic instructions.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_extended_arithmetic(void) {
+  const char* source =
+    "MODULE \"test\";\n"
+    "FUNCTION kernel(a: vec<i16, 8>, b: vec<i16, 8>, x: u64, y: u64, p: u8) -> u64 {\n"
+    "  ENTRY:\n"
+    "    w = MUL_WIDE a, b;\n"
+    "    s = ADD_SAT a, b;\n"
+    "    h = MULH x, y;\n"
+    "    q = ADD_WIDE p, 1;\n"
+    "    RET h;\n"
+    "}\n";
+  
+  test_module_t test;
+  bool success = compile_module(source, HOILC_OPT_NONE, &test);
+  
+  /* Widening doubles the element width and keeps the signedness and lanes */
+  ast_node_t* block = success ? find_block(test.module, "kernel", "ENTRY") : NULL;
+  size_t checked = 0;
+  for (size_t i = 0; block != NULL && i < block->data.stmt_block.statements.count; i++) {
+    ast_node_t* stmt = block->data.stmt_block.statements.nodes[i];
+    const char* target = ir_get_def(stmt);
+    ast_node_t* type = target != NULL ? stmt->data.stmt_assign.target_type : NULL;
+    ast_node_t* element = type != NULL && type->type == AST_TYPE_VEC ?
+      type->data.type_vec.element_type : type;
+    if (element == NULL || element->type != AST_TYPE_INT) {
+      continue;
+    }
+    
+    uint8_t bits = element->data.type_int.bits;
+    bool is_signed = element->data.type_int.is_signed;
+    if (strcmp(target, "w") == 0) {
+      checked += type->type == AST_TYPE_VEC && type->data.type_vec.size == 8 && bits == 32 && is_signed;
+    } else if (strcmp(target, "s") == 0) {
+      checked += type->type == AST_TYPE_VEC && bits == 16;
+    } else if (strcmp(target, "h") == 0) {
+      checked += bits == 64 && !is_signed;
+    } else if (strcmp(target, "q") == 0) {
+      checked += bits == 16 && !is_signed;
+    }
+  }
+  success = block != NULL && checked == 4;
+  if (block != NULL && !success) {
+    fprintf(stderr, "Unexpected extended arithmetic result types\n");
+  }
+  release_module(&test);
+  
+  /* Results are folded in the result type: the high half, the clamped value or the wide value */
+  static const struct {
+    uint8_t opcode;
+    uint8_t bits;
+    bool is_signed;
+    int64_t operands[2];
+    int64_t expected;
+  } folds[] = {
+    { OPCODE_MULH, 64, false, { -1, 2 }, 1 },
+    { OPCODE_MULH, 64, true, { -1, 2 }, -1 },
+    { OPCODE_MULH, 64, true, { INT64_MIN, INT64_MIN }, INT64_C(4611686018427387904) },
+    { OPCODE_MULH, 32, true, { 65536, 65536 }, 1 },
+    { OPCODE_MULH, 8, false, { 200, 200 }, 156 },
+    { OPCODE_ADD_SAT, 8, false, { 200, 100 }, 255 },
+    { OPCODE_ADD_SAT, 8, true, { 100, 100 }, 127 },
+    { OPCODE_ADD_SAT, 64, true, { INT64_MAX, 1 }, INT64_MAX },
+    { OPCODE_SUB_SAT, 8, true, { -100, 100 }, -128 },
+    { OPCODE_SUB_SAT, 8, false, { 10, 20 }, 0 },
+    { OPCODE_SUB_SAT, 64, true, { INT64_MIN, 1 }, INT64_MIN },
+    { OPCODE_ADD_WIDE, 16, false, { 255, 255 }, 510 },
+    { OPCODE_MUL_WIDE, 16, true, { -128, -128 }, 16384 },
+  };
+  for (size_t i = 0; success && i < sizeof(folds) / sizeof(folds[0]); i++) {
+    ast_node_t* type = ast_create_node(AST_TYPE_INT);
+    int64_t value;
+    if (type == NULL) {
+      return false;
+    }
+    type->data.type_int.bits = folds[i].bits;
+    type->data.type_int.is_signed = folds[i].is_signed;
+    success = ir_fold_integer(folds[i].opcode, type, folds[i].operands, 2, &value) &&
+              value == folds[i].expected;
+    ast_destroy_node(type);
+    if (!success) {
+      fprintf(stderr, "Extended arithmetic fold %zu is wrong\n", i);
+    }
+  }
+  
+  const char* too_wide =
+    "MODULE \"test\";\n"
+    "FUNCTION f(x: u64) -> u64 {\n"
+    "  ENTRY:\n"
+    "    y = ADD_WIDE x, x;\n"
+    "    RET x;\n"
+    "}\n";
+  
+  if (success) {
+    success = !compile_module(too_wide, HOILC_OPT_NONE, &test) &&
+              strstr(error_get_message(test.error_ctx), "at most 32 bits") != NULL;
+    release_module(&test);
+    if (!success) {
+      fprintf(stderr, "Widening of a 64-bit integer accepted\n");
+    }
+  }
+  
+  return success;
+}
+
+/**
+ * @brief Run all optimizer tests.
+ * 
+ * @return 0 if all tests pass, non-zero otherwise.
+ */
+int test_optimize(void) {
+  bool result = true;
+  
+  printf("Testing latency scheduling...\n");
+  result = result && test_schedule_latency();
+  
+  printf("Testing scheduling memory order...\n");
+  result = result && test_schedule_memory_order();
+  
+  printf("Testing scheduling global order...\n");
+  result = result && test_schedule_global_order();
+  
+  printf("Testing literal call arguments...\n");
+  result = result && test_call_literal_arguments();
+  
+  printf("Testing sequence outlining...\n");
+  result = result && test_outline_repeated_sequence();
+  
+  printf("Testing identical function folding...\n");
+  result = result && test_fold_identical_functions();
+  
+  printf("Testing constant argument specialization...\n");
+  result = result && test_specialize_constant_arguments();
+  
+  printf("Testing unsigned comparison folding...\n");
+  result = result && test_fold_unsigned_comparisons();
+  
+  printf("Testing compile-time evaluation...\n");
+  result = result && test_evaluate_pure_calls();
+  result = result && test_evaluate_global_writes();
+  
+  printf("Testing induction variable strength reduction...\n");
+  result = result && test_reduce_induction_variables();
+  
+  printf("Testing value range propagation...\n");
+  result = result && test_range_dominating_conditions();
+  
+  printf("Testing range propagation on unsigned values...\n");
+  result = result && test_range_unsigned_values();
+  
+  printf("Testing code sinking...\n");
+  result = result && test_sink_definitions();
+  
+  printf("Testing scalar replacement of aggregates...\n");
+  result = result && test_sroa_aggregates();
+  
+  printf("Testing dead argument elimination...\n");
+  result = result && test_dead_arguments();
+  
+  printf("Testing function memory effects...\n");
+  result = result && test_function_effects();
+  
+  printf("Testing optimization budgets...\n");
+  result = result && test_optimization_budget();
+  
+  printf("Testing optimization remarks...\n");
+  result = result && test_optimization_remarks();
+  
+  printf("Testing peephole rules...\n");
+  result = result && test_peephole_rules();
+  
+  printf("Testing vector operations...\n");
+  result = result && test_vector_operations();
+  
+  printf("Testing atomic operations...\n");
+  result = result && test_atomic_operations();
+  
+  printf("Testing alias analysis...\n");
+  result = result && test_alias_analysis();
+  
+  printf("Testing function versions...\n");
+  result = result && test_function_versions();
+  
+  printf("Testing function attributes...\n");
+  result = result && test_function_attributes();
+  
+  printf("Testing access hints...\n");
+  result = result && test_access_hints();
+  
+  printf("Testing branch hints...\n");
+  result = result && test_branch_hints();
+  
+  printf("Testing bit manipulation...\n");
+  result = result && test_bit_manipulation();
+  
+  printf("Testing extended arithmetic...\n");
+  result = result && test_extended_arithmetic();
+  
+  if (result) {
+    printf("All optimizer tests passed!\n");
+    return 0;
+  } else {
+    printf("Some optimizer tests failed!\n");
+    return 1;
+  }
+}
@@ -139,6 +139,38 @@ static bool test_invalid_function(void) {
   return test_parse(source, false);
 }
 
+/**
+ * @brief Test parsing branch probability hints.
+ * 
+ * @return true if the test passes, false otherwise.
+ */
+static bool test_branch_hints(void) {
+  const char* source = 
+    "MODULE \"test\";\n"
+    "FUNCTION f(a: bool, b: bool) -> i32 {\n"
+    "    ENTRY:\n"
+    "        BR a, LEFT, RIGHT !likely;\n"
+    "    LEFT:\n"
+    "        BR b, RIGHT, DONE !weights(0, 7);\n"
+    "    RIGHT:\n"
+    "        BR ALWAYS, DONE;\n"
+    "    DONE:\n"
+    "        RET 0;\n"
+    "}\n";
+  
+  /* Unconditional branches have nothing to predict */
+  const char* unconditional = 
+    "MODULE \"test\";\n"
+    "FUNCTION f() -> i32 {\n"
+    "    ENTRY:\n"
+    "        BR ALWAYS, DONE !unlikely;\n"
+    "    DONE:\n"
+    "        RET 0;\n"
+    "}\n";
+  
+  return test_parse(source, true) && test_parse(unconditional, false);
+}
+
 /**
  * @brief Run all parser tests.
  * 
@@ -162,6 +194,9 @@ int test_parser(void) {
   printf("Testing invalid function...\n");
   result = result && test_invalid_function();
   
+  printf("Testing branch hints...\n");
+  result = result && test_branch_hints();
+  
   if (result) {
     printf("All parser tests passed!\n");
     return 0;
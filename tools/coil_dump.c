@@ -141,6 +141,138 @@ static void print_function_section(const uint8_t* data, uint32_t size) {
   }
 }
 
+/**
+ * @brief Display a string from a metadata record.
+ * 
+ * @param data The section data.
+ * @param size The section size.
+ * @param offset The offset of the string length, advanced past the string.
+ * @return true on success, false if the string extends beyond the section.
+ */
+static bool print_string(const uint8_t* data, uint32_t size, uint32_t* offset) {
+  uint32_t length;
+  if (*offset + sizeof(length) > size) {
+    return false;
+  }
+  memcpy(&length, data + *offset, sizeof(length));
+  *offset += sizeof(length);
+  
+  if (length > size - *offset) {
+    return false;
+  }
+  printf(" %.*s", (int)length, (const char*)data + *offset);
+  *offset += length;
+  
+  return true;
+}
+
+/**
+ * @brief Display a list of strings from a metadata record.
+ * 
+ * @param label The label printed before the list.
+ * @param data The section data.
+ * @param size The section size.
+ * @param offset The offset of the list count, advanced past the list.
+ * @return true on success, false if the list extends beyond the section.
+ */
+static bool print_string_list(const char* label, const uint8_t* data, uint32_t size,
+                              uint32_t* offset) {
+  uint32_t count;
+  if (*offset + sizeof(count) > size) {
+    return false;
+  }
+  memcpy(&count, data + *offset, sizeof(count));
+  *offset += sizeof(count);
+  
+  printf("  %s:", label);
+  for (uint32_t i = 0; i < count; i++) {
+    if (!print_string(data, size, offset)) {
+      return false;
+    }
+  }
+  printf("\n");
+  
+  return true;
+}
+
+/**
+ * @brief Display the contents of the metadata section.
+ * 
+ * @param data The section data.
+ * @param size The section size.
+ */
+static void print_metadata_section(const uint8_t* data, uint32_t size) {
+  static const char* effect_names[] = { "readnone", "readonly", "argmemonly", "any" };
+  static const char* attribute_names[] = { "hot", "cold", "inline", "noinline", "pure" };
+  
+  printf("\n=== Metadata Section ===\n");
+  
+  uint32_t offset = 0;
+  while (offset + sizeof(uint32_t) <= size) {
+    uint32_t tag;
+    memcpy(&tag, data + offset, sizeof(tag));
+    
+    if (tag == METADATA_FUNCTION_EFFECTS && offset + 3 * sizeof(uint32_t) <= size) {
+      uint32_t function, effect;
+      memcpy(&function, data + offset + 4, sizeof(function));
+      memcpy(&effect, data + offset + 8, sizeof(effect));
+      printf("Function %u effects: %s\n", function,
+             effect <= FUNCTION_EFFECT_ANY ? effect_names[effect] : "unknown");
+      offset += 3 * sizeof(uint32_t);
+      continue;
+    }
+    
+    if (tag == METADATA_FUNCTION_ATTRIBUTES && offset + 3 * sizeof(uint32_t) <= size) {
+      uint32_t function, attributes;
+      memcpy(&function, data + offset + 4, sizeof(function));
+      memcpy(&attributes, data + offset + 8, sizeof(attributes));
+      printf("Function %u attributes:", function);
+      for (uint32_t i = 0; i < sizeof(attribute_names) / sizeof(attribute_names[0]); i++) {
+        if ((attributes & (1u << i)) != 0) {
+          printf(" %s", attribute_names[i]);
+        }
+      }
+      printf("\n");
+      offset += 3 * sizeof(uint32_t);
+      continue;
+    }
+    
+    if (tag == METADATA_TARGET && offset + 2 * sizeof(uint32_t) <= size) {
+      uint32_t target;
+      memcpy(&target, data + offset + 4, sizeof(target));
+      printf("Target %u device:", target);
+      offset += 2 * sizeof(uint32_t);
+      bool printed = print_string(data, size, &offset);
+      printf("\n");
+      if (printed &&
+          print_string_list("Required", data, size, &offset) &&
+          print_string_list("Preferred", data, size, &offset)) {
+        continue;
+      }
+      printf("Truncated target record\n");
+      break;
+    }
+    
+    if (tag == METADATA_FUNCTION_VERSION && offset + 4 * sizeof(uint32_t) <= size) {
+      uint32_t dispatch, version, target;
+      memcpy(&dispatch, data + offset + 4, sizeof(dispatch));
+      memcpy(&version, data + offset + 8, sizeof(version));
+      memcpy(&target, data + offset + 12, sizeof(target));
+      if (target == COIL_NO_TARGET) {
+        printf("Function %u baseline version: function %u\n", dispatch, version);
+      } else {
+        printf("Function %u version for target %u: function %u\n", dispatch, target, version);
+      }
+      offset += 4 * sizeof(uint32_t);
+      continue;
+    }
+    
+    /* Records after an unknown tag cannot be delimited */
+    printf("Unknown metadata tag %u at offset %u\n", tag, offset);
+    break;
+  }
+}
+
 /**
  * @brief Main function.
  * 
@@ -219,6 +351,10 @@ int main(int argc, char** argv) {
         print_function_section(section_data, sections[i].size);
         break;
         
+      case SECTION_METADATA:
+        print_metadata_section(section_data, sections[i].size);
+        break;
+        
       /* Additional section types can be handled here */
       
       default: